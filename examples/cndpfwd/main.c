@@ -11,6 +11,7 @@
 #include <unistd.h>         // for getpid, sleep, gettid
 
 #include <cne_common.h>        // for __cne_unused, cne_countof
+#include <cne_cycles.h>        // for cne_rdtsc
 #include <cne_gettid.h>
 #include <cne.h>               // for cne_init, cne_on_exit, CNE_CALLED_EXIT, CNE_...
 #include <cne_log.h>           // for CNE_LOG_ERR, CNE_ERR, CNE_DEBUG, CNE_LOG_DEBUG
@@ -18,6 +19,7 @@
 #include <cne_system.h>        // for cne_lcore_id
 #include <jcfg.h>              // for jcfg_thd_t, jcfg_lport_t, jcfg_lport_by_index
 #include <idlemgr.h>
+#include <shmstats.h>          // for shmstats_destroy
 
 #include "main.h"
 
@@ -78,6 +80,14 @@ __tx_flush(struct fwd_port *pd, pkt_api_t api, pktmbuf_t **mbufs, uint16_t n_pkt
     return n_pkts;
 }
 
+/* Record the RX to TX latency of a burst once all of its packets are sent */
+static __cne_always_inline void
+__rx_tx_latency(struct fwd_port *pd, uint64_t rx_tsc, int n_pkts)
+{
+    if (n_pkts > 0 && pd->lat_rec)
+        cne_hist_record_n(pd->lat_rec, cne_rdtsc() - rx_tsc, n_pkts);
+}
+
 static int
 _drop_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 {
@@ -103,6 +113,7 @@ _fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
     struct fwd_port *pd                          = lport->priv_;
     struct create_txbuff_thd_priv_t *thd_private = pd->thd->priv_;
     txbuff_t **txbuff;
+    uint64_t rx_tsc;
     int n_pkts;
 
     if (!pd)
@@ -113,6 +124,7 @@ _fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
     n_pkts = __rx_burst(fwd->pkt_api, pd, pd->rx_mbufs, fwd->burst);
     if (n_pkts == PKTDEV_ADMIN_STATE_DOWN)
         return -1;
+    rx_tsc = cne_rdtsc();
 
     for (int i = 0; i < n_pkts; i++) {
         uint8_t dst_lport = get_dst_lport(pktmbuf_mtod(pd->rx_mbufs[i], void *));
@@ -137,47 +149,18 @@ _fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
         while (txbuff_count(txbuff[dst->lpid]) > 0)
             txbuff_flush(txbuff[dst->lpid]);
     }
+    __rx_tx_latency(pd, rx_tsc, n_pkts);
 
     return n_pkts;
 }
 
-/*
- * Adjust the checksum to reflect that the TTL had been decremented.
- *
- * Flip the bits on the checksum, decrement the high byte of the checksum,
- * fold in any carry, and then flip the bits back.  Rather than convert
- * the checksum to host byte order and then back to network byte order,
- * just convert the increment to network byte order.  Note: in 1's
- * complement arithmetic, subtracting by x is the same as adding the 1's
- * complement of x.  So, in 16 bit arithmetic, rather than subtracting by
- * (1<<8), we can add by (1<<8)^0xffff.  Since it's all constants, that
- * should be evaluated by the compiler at compile time.
- *
- * Doing the ^0xffff to initially flip the bits keeps the upper bits from
- * also being flipped. Using the ~ operation at the end doesn't matter,
- * because the upper bits get tossed when we assign it to the 16 bit sum
- * field, so let the compiler do whatever is fastest.
- */
-static inline void
-ipv4_adjust_cksum(struct cne_ipv4_hdr *hdr)
-{
-    int32_t cksum;
-
-    hdr->time_to_live--;
-
-    /* increment checksum high byte */
-    cksum = (int32_t)(hdr->hdr_checksum ^ 0xFFFF) + (int32_t)htobe16(((1 << 8) ^ 0xFFFF));
-
-    /* Fold the carry bit into the checksum */
-    hdr->hdr_checksum = ~(cksum + (cksum >> 16));
-}
-
 static int
 _l3fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 {
     struct fwd_port *pd                          = lport->priv_;
     struct create_txbuff_thd_priv_t *thd_private = pd->thd->priv_;
     txbuff_t **txbuff;
+    uint64_t rx_tsc;
     int n_pkts;
 
     if (!pd)
@@ -188,6 +171,7 @@ _l3fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
     n_pkts = __rx_burst(fwd->pkt_api, pd, pd->rx_mbufs, fwd->burst);
     if (n_pkts == PKTDEV_ADMIN_STATE_DOWN)
         return -1;
+    rx_tsc = cne_rdtsc();
 
     struct ether_addr ethaddrs[n_pkts], *eaddr = &ethaddrs[0];
     uint16_t tport[n_pkts], *tx_port           = &tport[0];
@@ -197,7 +181,7 @@ _l3fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 
         struct cne_ipv4_hdr *rx_ip_hdr =
             pktmbuf_mtod_offset(pd->rx_mbufs[i], struct cne_ipv4_hdr *, ETHER_HDR_LEN);
-        ipv4_adjust_cksum(rx_ip_hdr);
+        cne_ipv4_ttl_dec(rx_ip_hdr);
         ip_addr[i] = ntohl(rx_ip_hdr->dst_addr);
     }
 
@@ -228,6 +212,7 @@ _l3fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
         while (txbuff_count(txbuff[dst->lpid]) > 0)
             txbuff_flush(txbuff[dst->lpid]);
     }
+    __rx_tx_latency(pd, rx_tsc, n_pkts);
 
     return n_pkts;
 }
@@ -236,6 +221,7 @@ static int
 _loopback_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 {
     struct fwd_port *pd = lport->priv_;
+    uint64_t rx_tsc;
     int n_pkts, n;
 
     if (!pd)
@@ -246,6 +232,7 @@ _loopback_test(jcfg_lport_t *lport, struct fwd_info *fwd)
         return -1;
 
     if (n_pkts) {
+        rx_tsc = cne_rdtsc();
         for (int j = 0; j < n_pkts; j++)
             MAC_SWAP(pktmbuf_mtod(pd->rx_mbufs[j], void *));
 
@@ -253,6 +240,7 @@ _loopback_test(jcfg_lport_t *lport, struct fwd_info *fwd)
         if (n == PKTDEV_ADMIN_STATE_DOWN)
             return -1;
         pd->tx_overrun += n;
+        __rx_tx_latency(pd, rx_tsc, n_pkts);
     }
     return n_pkts;
 }
@@ -545,6 +533,18 @@ thread_func(void *arg)
             if (idlemgr_add(imgr, fd, 0) < 0)
                 goto leave;
         }
+
+        if (thd->umwait_timeout) {
+            volatile void *addr = NULL;
+
+            /* UMONITOR can only watch one address, use TPAUSE for multiple lports */
+            if (thd->lport_cnt == 1 && fwd->pkt_api == XSKDEV_PKT_API) {
+                pd   = thd->lports[0]->priv_;
+                addr = xskdev_rx_monitor_addr(pd->xsk);
+            }
+            if (idlemgr_set_umwait(imgr, addr, thd->umwait_timeout) < 0)
+                CNE_ERR_GOTO(leave, "failed to set umwait timeout for %s\n", thd->name);
+        }
     }
 
     for (;;) {
@@ -708,6 +708,7 @@ __on_exit(int val, void *arg, int exit_type)
             udsc_close(fwd->xdp_uds);
             metrics_destroy();
             uds_destroy(NULL);
+            shmstats_destroy();
 
             fwd->timer_quit = 1;
         }
@@ -36,6 +36,7 @@ extern "C" {
 
 #include <jcfg.h>        // for jcfg_info_t, jcfg_thd_t
 #include <jcfg_process.h>
+#include <cne_hist.h>        // for cne_hist_t, cne_hist_rec_t
 
 #include <net/cne_ip.h>        // for CNE_IPV4
 
@@ -46,6 +47,7 @@ extern "C" {
 #define BURST_SIZE     256
 #define MAX_BURST_SIZE 256
 #define DST_LPORT      5
+#define LAT_HIST_BITS  32 /**< Max RX to TX latency bits in TSC cycles */
 
 enum {
     FWD_DEBUG_STATS = (1 << 0), /**< Show debug stats */
@@ -126,6 +128,8 @@ struct fwd_port {
     uint64_t ibytes;                     /**< previous rx bytes */
     uint64_t obytes;                     /**< previous tx bytes */
     uint64_t tx_overrun;                 /**< Number of mbufs failing to flush */
+    cne_hist_t *lat_hist;                /**< RX to TX latency of the packets in TSC cycles */
+    cne_hist_rec_t *lat_rec;             /**< Recorder of lat_hist, NULL if not created */
     struct acl_fwd_stats acl_stats;      /**< ACL-related stats */
     struct acl_fwd_stats prev_acl_stats; /**< previous values for ACL stats */
 };
@@ -22,12 +22,16 @@
 #include <jcfg_process.h>        // for jcfg_process
 #include <cne_thread.h>          // for thread_create
 #include <cne_strings.h>
+#include <shmstats.h>            // for shmstats_create, shmstats_name
 
 #include "main.h"        // for fwd_info, fwd, app_options, get_app_mode
 
 #define foreach_thd_lport(_t, _lp) \
     for (int _i = 0; _i < _t->lport_cnt && (_lp = _t->lports[_i]); _i++, _lp = _t->lports[_i])
 
+/* UMEM and lport callbacks run on the jcfg bring-up threads with the -B option */
+static pthread_mutex_t setup_lock = PTHREAD_MUTEX_INITIALIZER;
+
 static int
 process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
 {
@@ -103,12 +107,14 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
 
     case JCFG_UMEM_TYPE:
         /* Default to xskdev API if not set */
+        pthread_mutex_lock(&setup_lock);
         if (f->pkt_api == UNKNOWN_PKT_API) {
             f->pkt_api = XSKDEV_PKT_API;
             cne_printf(
                 "[yellow]**** [magenta]API type defaulting to use [cyan]%s [magenta]APIs[]\n",
                 XSKDEV_API_NAME);
         }
+        pthread_mutex_unlock(&setup_lock);
 
         total_region_cnt = 0;
         for (int i = 0; i < obj.umem->region_cnt; i++) {
@@ -173,6 +179,11 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
 
             lport->priv_ = pd;
 
+            /* The lport is forwarded by a single thread, which owns the only recorder */
+            pd->lat_hist = cne_hist_create(lport->name, 0, LAT_HIST_BITS, 1);
+            if (pd->lat_hist)
+                pd->lat_rec = cne_hist_recorder(pd->lat_hist);
+
             if (lport->flags & LPORT_SKB_MODE)
                 cne_printf("[yellow]**** [green]SKB_MODE is [red]enabled[]\n");
             if (lport->flags & LPORT_BUSY_POLLING)
@@ -197,11 +208,14 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
 
             if (lport->uds_path) {
                 cne_printf("[yellow]**** [green]UDS is [red]enabled[]\n");
-                pcfg.xsk_uds = f->xdp_uds = udsc_handshake(lport->uds_path);
+                pcfg.xsk_uds = udsc_handshake(lport->uds_path);
                 if (pcfg.xsk_uds == NULL) {
                     pd->xsk = NULL;
                     CNE_ERR_RET("UDS handshake failed %s\n", strerror(errno));
                 }
+                pthread_mutex_lock(&setup_lock);
+                f->xdp_uds = pcfg.xsk_uds;
+                pthread_mutex_unlock(&setup_lock);
             }
 
             pcfg.addr = jcfg_lport_region(lport, &pcfg.bufcnt);
@@ -290,11 +304,14 @@ print_usage(char *prog_name)
                "                 The -a option overrides JSON file.\n"
                "  -b <burst>     Burst size. If not present default burst size %d max %d.\n"
                "  -c <json-file> The JSON configuration file\n"
+               "  -B             Bring up the UMEMs and lports in parallel\n"
                "  -C             Wait on unix domain socket for JSON or JSON-C file\n"
                "  -d             More debug stats are displayed\n"
                "  -D             JCFG debug decoding\n"
                "  -V             JCFG information verbose\n"
                "  -P             JCFG debug parsing\n"
+               "  -S             Export the lport stats in the shared memory segment "
+               "/dev/shm/" SHMSTATS_PREFIX ".<pid>\n"
                "  -L [level]     Enable a logging level\n"
                "  -h             Display the help information\n"
                "  --%-12s Disable color output\n",
@@ -340,6 +357,7 @@ _cleanup(jcfg_info_t *j __cne_unused, void *obj, void *arg, int idx __cne_unused
             break;
         }
 
+        cne_hist_destroy(pd->lat_hist);
         free(pd);
         lport->priv_ = NULL;
     }
@@ -372,7 +390,7 @@ parse_args(int argc, char **argv, struct fwd_info *fwd)
 
     /* Parse the input arguments. */
     for (;;) {
-        opt = getopt_long(argc, argv, "ha:b:c:dCDPVL:", lgopts, &option_index);
+        opt = getopt_long(argc, argv, "ha:b:c:dBCDPSVL:", lgopts, &option_index);
         if (opt == EOF)
             break;
 
@@ -400,6 +418,10 @@ parse_args(int argc, char **argv, struct fwd_info *fwd)
             fwd->flags |= FWD_DEBUG_STATS;
             break;
 
+        case 'B':
+            flags |= JCFG_PARALLEL_FLAG;
+            break;
+
         case 'C':
             flags |= JCFG_PARSE_SOCKET;
             break;
@@ -412,6 +434,12 @@ parse_args(int argc, char **argv, struct fwd_info *fwd)
             flags |= JCFG_DEBUG_PARSING;
             break;
 
+        case 'S':
+            if (shmstats_create(NULL, 0) < 0)
+                CNE_ERR_RET("Failed to create the statistics segment\n");
+            CNE_INFO("Statistics segment /dev/shm%s\n", shmstats_name());
+            break;
+
         case 'V':
             flags |= JCFG_INFO_VERBOSE;
             break;
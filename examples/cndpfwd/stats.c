@@ -7,10 +7,14 @@
 #include <cne_log.h>           // for CNE_ERR_RET, CNE_LOG_ERR
 #include <metrics.h>           // for metrics_append, metrics_register, metrics_cl...
 #include <stdint.h>            // for uint64_t
+#include <inttypes.h>          // for PRIu64
 #include <unistd.h>            // for gethostname
+#include <cne_system.h>        // for cne_get_timer_hz
+#include <cne_hist.h>          // for cne_hist_snapshot, cne_hist_snapshot_alloc
 
 #include <cne_lport.h>        // for lport_stats_t
 #include <jcfg.h>             // for jcfg_lport_t, jcfg_info_t, jcfg_lport_foreach
+#include <jcfg_process.h>     // for jcfg_bringup_get, jcfg_bringup_t
 
 #include "main.h"        // for fwd_info, fwd_port, FWD_DEBUG_STATS, enable_...
 
@@ -375,6 +379,74 @@ fwd_stats(metrics_client_t *c, const char *cmd __cne_unused, const char *params
     return jcfg_lport_foreach(fwd->jinfo, handle_stats, c);
 }
 
+static int
+handle_latency(jcfg_info_t *j __cne_unused, void *obj, void *arg, int idx __cne_unused)
+{
+    jcfg_lport_t *lport = obj;
+    struct fwd_port *pd = lport->priv_;
+    metrics_client_t *c = arg;
+    char name[64];
+    cne_hist_rec_t *s;
+    int ret;
+
+    if (!pd || !pd->lat_hist)
+        return 0;
+
+    s = cne_hist_snapshot_alloc(pd->lat_hist);
+    if (!s || cne_hist_snapshot(pd->lat_hist, s) < 0) {
+        cne_hist_snapshot_free(s);
+        return -1;
+    }
+
+    snprintf(name, sizeof(name), "%s_rx_tx_cycles", lport->name);
+    metrics_append(c, ",");
+    ret = metrics_hist(c, name, s);
+
+    cne_hist_snapshot_free(s);
+
+    return ret;
+}
+
+static int
+fwd_latency(metrics_client_t *c, const char *cmd __cne_unused, const char *params __cne_unused)
+{
+    struct fwd_info *fwd = (struct fwd_info *)(c->info->priv);
+
+    metrics_append(c, "\"timer_hz\":%" PRIu64, cne_get_timer_hz());
+
+    return jcfg_lport_foreach(fwd->jinfo, handle_latency, c);
+}
+
+static int
+handle_bringup(jcfg_info_t *j __cne_unused, void *obj, void *arg, int idx __cne_unused)
+{
+    jcfg_lport_t *lport = obj;
+    metrics_client_t *c = arg;
+
+    metrics_append(c, ",\"%s_bringup_us\":%u", lport->name, lport->setup_us);
+
+    return 0;
+}
+
+static int
+fwd_bringup(metrics_client_t *c, const char *cmd __cne_unused, const char *params __cne_unused)
+{
+    struct fwd_info *fwd = (struct fwd_info *)(c->info->priv);
+    jcfg_bringup_t b;
+
+    if (jcfg_bringup_get(fwd->jinfo, &b) < 0)
+        return -1;
+
+    metrics_append(c, "\"bringup_total_us\":%" PRIu64, b.total_us);
+    metrics_append(c, ",\"bringup_umem_us\":%" PRIu64, b.umem_us);
+    metrics_append(c, ",\"bringup_lport_us\":%" PRIu64, b.lport_us);
+    metrics_append(c, ",\"bringup_umem_max_us\":%u", b.umem_max_us);
+    metrics_append(c, ",\"bringup_lport_max_us\":%u", b.lport_max_us);
+    metrics_append(c, ",\"bringup_workers\":%u", b.workers);
+
+    return jcfg_lport_foreach(fwd->jinfo, handle_bringup, c);
+}
+
 int
 enable_metrics(struct fwd_info *fwd)
 {
@@ -386,6 +458,12 @@ enable_metrics(struct fwd_info *fwd)
     if (metrics_register("/port_stats", fwd_stats) < 0)
         CNE_ERR_RET("Failed to register the metric stats\n");
 
+    if (metrics_register("/bringup", fwd_bringup) < 0)
+        CNE_ERR_RET("Failed to register the bring-up metrics\n");
+
+    if (metrics_register("/latency", fwd_latency) < 0)
+        CNE_ERR_RET("Failed to register the latency metrics\n");
+
     return 0;
 }
 
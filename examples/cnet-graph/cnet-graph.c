@@ -5,6 +5,7 @@
 #include <arpa/inet.h>           // for inet_ntop
 #include <signal.h>              // for SIGINT, SIGUSR1, SIGTERM
 #include <stdint.h>              // for uint64_t, uint8_t, uint16_t, uint...
+#include <inttypes.h>            // for PRIu64
 #include <stdio.h>               // for snprintf, fflush, stdout, NULL
 #include <stdlib.h>              // for realloc
 #include <string.h>              // for memset, memcpy, strdup
@@ -12,8 +13,10 @@
 #include <unistd.h>              // for sleep, getpid
 #include <net/ethernet.h>        // for ether_addr
 #include <netinet/in.h>          // for INET6_ADDRSTRLEN, in_addr, htonl
+#include <netinet/tcp.h>         // for SOL_TCP, TCP_FASTOPEN, TCP_FASTOPEN_CONNECT
 #include <sched.h>               // for cpu_set_t
 #include <stddef.h>              // for offsetof
+#include <ctype.h>               // for isdigit
 
 #include <cne_branch_prediction.h>        // for likely
 #include <cne_common.h>                   // for __cne_unused, CNE_MAX_ETHPORTS
@@ -23,6 +26,7 @@
 #include <net/cne_ip.h>                   // for CNE_IPV4
 #include <net/cne_ether.h>                // for ether_addr_copy, ETHER_LOCAL_ADMI...
 #include <cne_timer.h>
+#include <cne_cycles.h>        // for cne_rdtsc, cne_get_timer_hz
 #include <jcfg.h>        // for jcfg_thd_t, jcfg_lport_t, jcfg_lg...
 #include <cli.h>
 #include <cli_file.h>
@@ -34,6 +38,8 @@
 #include <chnl_priv.h>
 #include <cnet_chnl_opt.h>
 #include <cnet_ifshow.h>
+#include <cnet_tcp.h>        // for cnet_tcp_rack_set, cnet_tcp_pacing_set, cnet_tcp_copy_set
+#include <dsa_copy.h>        // for dsa_copy_create, dsa_copy_destroy, dsa_copy_t
 
 #include <cne_graph.h>               // for cne_graph_cluster_stats_param
 #include <cne_graph_worker.h>        // for cne_graph_walk, cne_graph
@@ -47,6 +53,7 @@
 #include "cnet-graph.h"
 #include "cne.h"               // for cne_id, cne_init, cne_on_exit
 #include "pktdev_api.h"        // for pktdev_close, pktdev_is_valid_port
+#include "pktdev.h"            // for pktdev_buf_alloc
 
 static struct cnet_info cnet_info;
 struct cnet_info *cinfo = &cnet_info;
@@ -137,7 +144,240 @@ err:
     return -1;
 }
 
-#define RECV_NB_MBUFS 128
+#define RECV_NB_MBUFS   128
+#define RR_TIMEOUT_SECS 5
+
+static int proto_callback(int ctype, int cd);
+
+static inline rr_info_t *
+rr_info_get(void)
+{
+    int tid = cne_id();
+
+    if (tid < 0 || tid >= cne_countof(cinfo->graph_info))
+        return NULL;
+
+    return &cinfo->graph_info[tid].rr;
+}
+
+/*
+ * Setup the request/response client for a thread, when the thread has a
+ * '<thread-name>-rr' option with the 'ipaddr:port' of the server. An optional
+ * 'persist' entry keeps the connection open between transactions and a number
+ * sets the request size in bytes.
+ */
+static int
+rr_setup(jcfg_thd_t *thd, graph_info_t *gi)
+{
+    char rr_name[CNE_GRAPH_NAMESIZE + 1];
+    char addr[INET6_ADDRSTRLEN + 8];
+    obj_value_t *rr_array;
+    rr_info_t *rr = &gi->rr;
+    char *port;
+
+    rr->cd = -1;
+
+    snprintf(rr_name, sizeof(rr_name), "%s-rr", thd->name);
+
+    if (jcfg_option_array_get(cinfo->jinfo, rr_name, &rr_array) < 0 || rr_array->array_sz == 0)
+        return 0;
+
+    if (thd->lport_cnt == 0)
+        CNE_ERR_RET("Thread %s needs a lport to allocate requests\n", thd->name);
+
+    snprintf(addr, sizeof(addr), "%s", rr_array->arr[0]->str);
+    if ((port = strchr(addr, ':')) == NULL)
+        CNE_ERR_RET("Request/response address '%s' is not ipaddr:port\n", addr);
+    *port++ = '\0';
+
+    in_caddr_zero(&rr->addr);
+    if (inet_pton(AF_INET, addr, (void *)&rr->addr.cin_addr.s_addr) != 1)
+        CNE_ERR_RET("Failed to convert IP4 address %s\n", addr);
+    rr->addr.cin_family = AF_INET;
+    rr->addr.cin_len    = sizeof(struct in_addr);
+    rr->addr.cin_port   = htobe16(atoi(port));
+
+    rr->size = RR_REQUEST_SIZE;
+    for (int i = 1; i < rr_array->array_sz; i++) {
+        if (!strcasecmp(rr_array->arr[i]->str, "persist"))
+            rr->persist = true;
+        else if (isdigit(rr_array->arr[i]->str[0]))
+            rr->size = strtoul(rr_array->arr[i]->str, NULL, 10);
+    }
+    if (rr->size == 0 || rr->size > (RR_SEG_SIZE * RR_MAX_SEGS))
+        CNE_ERR_RET("Request size %u is not 1-%d bytes\n", rr->size, RR_SEG_SIZE * RR_MAX_SEGS);
+
+    rr->samples = calloc(RR_SAMPLE_COUNT, sizeof(uint64_t));
+    if (!rr->samples)
+        CNE_ERR_RET("Unable to allocate latency samples\n");
+
+    rr->lport   = thd->lports[0]->lpid;
+    rr->min     = UINT64_MAX;
+    rr->enabled = true;
+
+    return 0;
+}
+
+/*
+ * Start a new transaction when none is outstanding, using TCP Fast Open to send
+ * the request in the SYN once the server has given us a cookie. A persistent
+ * connection sends the next request on the open channel.
+ */
+static void
+rr_request(rr_info_t *rr)
+{
+    pktmbuf_t *m[RR_MAX_SEGS];
+    uint32_t opt = 1, len;
+    int cd, n;
+
+    if (rr->busy) {
+        if ((cne_rdtsc() - rr->start) < (cne_get_timer_hz() * RR_TIMEOUT_SECS))
+            return;
+
+        /* Give up on the transaction and start a new one */
+        rr->timeouts++;
+        chnl_close(rr->cd);
+        rr->cd   = -1;
+        rr->busy = false;
+    }
+
+    n = (rr->size + RR_SEG_SIZE - 1) / RR_SEG_SIZE;
+    if (pktdev_buf_alloc(rr->lport, m, n) != n)
+        return;
+
+    for (int i = 0; i < n; i++) {
+        len = CNE_MIN(rr->size - (i * RR_SEG_SIZE), (uint32_t)RR_SEG_SIZE);
+        memset(pktmbuf_mtod(m[i], char *), 'r', len);
+        pktmbuf_append(m[i], len);
+    }
+    rr->rcvd = 0;
+
+    if (rr->cd >= 0) {
+        rr->busy  = true;
+        rr->start = cne_rdtsc();
+
+        if (chnl_send(rr->cd, m, n) < 0) {
+            pktmbuf_free_bulk(m, n);
+            chnl_close(rr->cd);
+            rr->cd   = -1;
+            rr->busy = false;
+            CNE_ERR("chnl_send() failed\n");
+        }
+        return;
+    }
+
+    cd = channel(AF_INET, SOCK_STREAM, 0, proto_callback);
+    if (cd < 0) {
+        pktmbuf_free_bulk(m, n);
+        CNE_RET("channel call failed\n");
+    }
+
+    if (chnl_set_opt(cd, SOL_TCP, TCP_FASTOPEN_CONNECT, &opt, sizeof(opt)) < 0)
+        CNE_WARN("Failed to enable TCP Fast Open on %d\n", cd);
+
+    rr->cd    = cd;
+    rr->busy  = true;
+    rr->start = cne_rdtsc();
+
+    if (chnl_connect_send(cd, (struct sockaddr *)&rr->addr, sizeof(struct in_caddr), m, n) < 0) {
+        pktmbuf_free_bulk(m, n);
+        chnl_close(cd);
+        rr->cd   = -1;
+        rr->busy = false;
+        CNE_ERR("chnl_connect_send() failed\n");
+    }
+}
+
+/*
+ * Handle the response for the outstanding request, the transaction completes when
+ * all of the request has been echoed. Returns true if the channel was the request
+ * channel.
+ */
+static bool
+rr_response(int cd)
+{
+    pktmbuf_t *mbufs[RECV_NB_MBUFS];
+    rr_info_t *rr = rr_info_get();
+    uint64_t cycles;
+    int nb_mbufs;
+
+    if (!rr || !rr->enabled || rr->cd != cd)
+        return false;
+
+    while ((nb_mbufs = chnl_recv(cd, mbufs, RECV_NB_MBUFS)) > 0) {
+        for (int i = 0; i < nb_mbufs; i++)
+            rr->rcvd += pktmbuf_data_len(mbufs[i]);
+        pktmbuf_free_bulk(mbufs, nb_mbufs);
+    }
+
+    if (!rr->busy || rr->rcvd < rr->size)
+        return true;
+
+    cycles = cne_rdtsc() - rr->start;
+
+    rr->samples[rr->count % RR_SAMPLE_COUNT] = cycles;
+    rr->count++;
+    rr->total += cycles;
+    rr->min  = CNE_MIN(rr->min, cycles);
+    rr->max  = CNE_MAX(rr->max, cycles);
+    rr->busy = false;
+
+    if (rr->persist)
+        return true;
+
+    if (chnl_close(cd) < 0)
+        CNE_ERR("Failed to close request channel %d\n", cd);
+    rr->cd = -1;
+
+    return true;
+}
+
+/*
+ * UDP echo benchmark, every datagram is returned to its sender. The burst is
+ * received with chnl_recvfrom_bulk() and sent back with one chnl_sendto_bulk()
+ * call, or with a chnl_sendto() call per datagram when "udp-bulk" is false.
+ */
+static void
+udp_echo(int cd)
+{
+    chnl_mmsg_t msgs[RECV_NB_MBUFS];
+    int tid         = cne_id();
+    echo_info_t *ei = (tid >= 0 && tid < cne_countof(cinfo->graph_info))
+                          ? &cinfo->graph_info[tid].echo
+                          : NULL;
+    uint64_t start = cne_rdtsc();
+    int nb, sent = 0;
+
+    while ((nb = chnl_recvfrom_bulk(cd, msgs, RECV_NB_MBUFS)) > 0) {
+        if (cinfo->opts.no_udp_bulk) {
+            for (int i = 0; i < nb; i++) {
+                if (chnl_sendto(cd, &msgs[i].addr.sa, &msgs[i].mbuf, 1) < 0)
+                    pktmbuf_free(msgs[i].mbuf);
+                else
+                    sent++;
+            }
+            if (ei)
+                ei->calls += nb;
+        } else {
+            int n = chnl_sendto_bulk(cd, msgs, nb);
+
+            if (n < 0)
+                n = 0;
+            for (int i = n; i < nb; i++)
+                pktmbuf_free(msgs[i].mbuf);
+            sent += n;
+            if (ei)
+                ei->calls++;
+        }
+    }
+    if (nb < 0)
+        CNE_ERR("Receive packets failed\n");
+
+    if (ei && sent) {
+        ei->pkts += sent;
+        ei->cycles += cne_rdtsc() - start;
+    }
+}
 
 static int
 udp_recv(int cd)
@@ -165,6 +405,10 @@ udp_recv(int cd)
             CNE_ERR("Receive packets failed\n");
         break;
 
+    case UDP_ECHO_TEST:
+        udp_echo(cd);
+        break;
+
     default:
         break;
     }
@@ -185,6 +429,11 @@ tcp_accept(int cd)
     int ncd;
     struct sockaddr addr = {0};
     socklen_t addr_len;
+    rr_info_t *rr = rr_info_get();
+
+    /* The request channel of the rr test gets the established callback */
+    if (rr && rr->enabled && rr->cd == cd)
+        return 0;
 
     if (is_ch_dom_inet6(ch_get(cd)))
         addr_len = sizeof(struct sockaddr_in6);
@@ -230,7 +479,12 @@ tcp_recv(int cd)
         CNE_DEBUG("Drop count [cyan]%3d[] in [cyan]%3d[] loops\n", tot_cnt, cnt);
         break;
 
+    case RR_TEST:
+        if (rr_response(cd))
+            break;
+        /* FALLTHRU */
     case LOOPBACK_TEST:
+    case UDP_ECHO_TEST:
         for (;;) { /* Make sure we send all of the packets */
             nb_mbufs = chnl_recv(cd, mbufs, RECV_NB_MBUFS);
             if (nb_mbufs <= 0) {
@@ -286,8 +540,9 @@ thread_func(void *arg)
     obj_value_t *chnl_array;
     char chnl_name[CNE_GRAPH_NAMESIZE + 1];
     graph_info_t *gi;
+    dsa_copy_t *dc = NULL;
     pthread_t pid = pthread_self();
-    int tid;
+    int tid, cd;
 
     if (thd->group->lcore_cnt > 0) {
         if (pthread_setaffinity_np(pid, sizeof(cpu_set_t), &thd->group->lcore_bitmap) < 0)
@@ -303,6 +558,20 @@ thread_func(void *arg)
     if (cnet_stk_initialize(cinfo->cnet) < 0)
         CNE_RET("cnet_stk_initialize('%s') failed\n", thd->name);
 
+    cnet_tcp_rack_set(stk_get(), cinfo->opts.rack);
+#if CNET_TCP_FAULT_INJECT_ENABLED
+    cnet_tcp_tail_drop_set(stk_get(), cinfo->opts.tail_drop);
+#endif
+    cnet_tcp_pacing_set(stk_get(), cinfo->opts.pacing);
+
+    /* Copy the TCP segment data with a DSA engine owned by this thread */
+    if (cinfo->opts.dsa_wq) {
+        dc = dsa_copy_create(strcmp(cinfo->opts.dsa_wq, "sw") ? cinfo->opts.dsa_wq : NULL, 0, 0);
+        if (!dc)
+            CNE_ERR_GOTO(err, "Failed to create DSA copy engine on %s\n", cinfo->opts.dsa_wq);
+        cnet_tcp_copy_set(stk_get(), dc);
+    }
+
     if ((tid = cne_id()) < 0)
         CNE_ERR_GOTO(err, "Failed to get cne id\n");
 
@@ -313,6 +582,9 @@ thread_func(void *arg)
     if (initialize_graph(thd, gi))
         CNE_ERR_GOTO(err, "Initialize_graph() failed\n");
 
+    if (cinfo->test == RR_TEST && rr_setup(thd, gi))
+        CNE_ERR_GOTO(err, "rr_setup() failed\n");
+
     /* Construct the options key name <thread-name>-chnl */
     snprintf(chnl_name, sizeof(chnl_name), "%s-chnl", thd->name);
 
@@ -332,9 +604,18 @@ thread_func(void *arg)
 
         if (cinfo->flags & FWD_DEBUG_STATS)
             cne_printf("'[orange]%s[]'", s);
-        if (chnl_open(s, (cinfo->flags & FWD_ENABLE_UDP_CKSUM) ? CHNL_ENABLE_UDP_CHECKSUM : 0,
-                      proto_callback) < 0)
+        cd = chnl_open(s, (cinfo->flags & FWD_ENABLE_UDP_CKSUM) ? CHNL_ENABLE_UDP_CHECKSUM : 0,
+                       proto_callback);
+        if (cd < 0)
             break;
+
+        /* Allow TCP Fast Open on the listening channels of the rr test */
+        if (cinfo->test == RR_TEST && !strncasecmp("tcp", s, 3)) {
+            uint32_t opt = CNET_TCP_BACKLOG_COUNT;
+
+            if (chnl_set_opt(cd, SOL_TCP, TCP_FASTOPEN, &opt, sizeof(opt)) < 0)
+                CNE_WARN("Failed to enable TCP Fast Open on %s\n", s);
+        }
         if (cinfo->flags & FWD_DEBUG_STATS)
             cne_printf("\n%-12s", "");
     }
@@ -342,11 +623,24 @@ thread_func(void *arg)
         cne_printf("\r");
 
 skip:
-    while (likely(!thd->quit))
+    while (likely(!thd->quit)) {
         cne_graph_walk(gi->graph);
 
+        /* The TCP timers of the stack run on this thread */
+        cne_timer_manage();
+
+        if (gi->rr.enabled)
+            rr_request(&gi->rr);
+    }
+
+    cnet_tcp_copy_set(stk_get(), NULL);
+    dsa_copy_destroy(dc);
     return;
 err:
+    if (dc) {
+        cnet_tcp_copy_set(stk_get(), NULL);
+        dsa_copy_destroy(dc);
+    }
     if (pthread_barrier_wait(&cinfo->barrier))
         CNE_ERR("Barrier wait failed: %s\n", strerror(errno));
 }
@@ -396,10 +690,74 @@ _thread_quit(jcfg_info_t *j __cne_unused, void *obj, void *arg __cne_unused, int
     return 0;
 }
 
+static int
+rr_cmp(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static void
+rr_summary(struct cnet_info *ci)
+{
+    double usecs = 1000000.0 / (double)cne_get_timer_hz();
+
+    for (int i = 0; i < cne_countof(ci->graph_info); i++) {
+        rr_info_t *rr = &ci->graph_info[i].rr;
+        uint64_t n;
+
+        if (!rr->enabled || rr->count == 0)
+            continue;
+
+        cne_printf("  [magenta]RR thread [orange]%d[]: [cyan]%" PRIu64 "[] transactions, "
+                   "[cyan]%" PRIu64 "[] timeouts, latency usec avg [green]%.2f[] "
+                   "min [green]%.2f[] max [green]%.2f[]\n",
+                   i, rr->count, rr->timeouts, ((double)rr->total / rr->count) * usecs,
+                   (double)rr->min * usecs, (double)rr->max * usecs);
+
+        /* Request bytes echoed per second of transaction time */
+        cne_printf("  [magenta]RR thread [orange]%d[]: [cyan]%u[] byte requests, goodput "
+                   "[green]%.2f[] Mbits/s\n",
+                   i, rr->size, ((double)rr->count * rr->size * 8) / ((double)rr->total * usecs));
+
+        /* Percentiles of the last RR_SAMPLE_COUNT transactions */
+        n = CNE_MIN(rr->count, (uint64_t)RR_SAMPLE_COUNT);
+        qsort(rr->samples, n, sizeof(uint64_t), rr_cmp);
+
+        cne_printf("  [magenta]RR thread [orange]%d[]: latency usec p50 [green]%.2f[] "
+                   "p99 [green]%.2f[] p99.9 [green]%.2f[]\n",
+                   i, (double)rr->samples[n / 2] * usecs,
+                   (double)rr->samples[(n * 99) / 100] * usecs,
+                   (double)rr->samples[(n * 999) / 1000] * usecs);
+    }
+}
+
+static void
+echo_summary(struct cnet_info *ci)
+{
+    for (int i = 0; i < cne_countof(ci->graph_info); i++) {
+        echo_info_t *ei = &ci->graph_info[i].echo;
+
+        if (ei->pkts == 0)
+            continue;
+
+        cne_printf("  [magenta]UDP echo thread [orange]%d[]: [cyan]%" PRIu64 "[] datagrams, "
+                   "[green]%.1f[] per send call, [green]%.1f[] cycles per datagram using %s\n",
+                   i, ei->pkts, (double)ei->pkts / ei->calls, (double)ei->cycles / ei->pkts,
+                   (ci->opts.no_udp_bulk) ? "chnl_sendto()" : "chnl_sendto_bulk()");
+    }
+}
+
 static void
 my_quit(struct cnet_info *ci)
 {
     if (ci) {
+        if (ci->test == RR_TEST)
+            rr_summary(ci);
+        else if (ci->test == UDP_ECHO_TEST)
+            echo_summary(ci);
+
         jcfg_thread_foreach(ci->jinfo, _thread_quit, ci);
         metrics_destroy();
 
@@ -474,7 +832,7 @@ cli_tree(void)
 int
 main(int argc, char **argv)
 {
-    const char *tests[] = {"Unknown", "Drop", "Loopback", "Tx Only", NULL};
+    const char *tests[] = {"Unknown", "Drop", "Loopback", "Req/Resp", NULL};
     int signals[]       = {SIGINT, SIGTERM, SIGUSR1};
 
     memset(&cnet_info, 0, sizeof(struct cnet_info));
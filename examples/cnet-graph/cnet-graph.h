@@ -30,6 +30,7 @@ extern "C" {
 #include <jcfg_process.h>
 
 #include "metrics.h"        // for metrics_info_t
+#include "cne_inet.h"       // for in_caddr
 #include "pktmbuf.h"        // for pktmbuf_t
 
 #define MAX_THREADS    16
@@ -49,12 +50,16 @@ enum {
 #define MODE_RX_ONLY  "rx-only"  /**< Alias for MODE_DROP */
 #define MODE_LB       "lb"       /**< Loopback mode */
 #define MODE_LOOPBACK "loopback" /**< Alias for MODE_LB */
+#define MODE_RR       "rr"       /**< TCP request/response latency test */
+#define MODE_UDP_ECHO "udp-echo" /**< UDP echo benchmark */
 
 // clang-format off
 typedef enum {
     UNKNOWN_TEST,
     DROP_TEST,
     LOOPBACK_TEST,
+    RR_TEST,
+    UDP_ECHO_TEST,
     MAX_TESTS
 } test_t;
 
@@ -64,12 +69,19 @@ typedef enum {
         {MODE_RX_ONLY,  DROP_TEST},     \
         {MODE_LB,       LOOPBACK_TEST}, \
         {MODE_LOOPBACK, LOOPBACK_TEST}, \
+        {MODE_RR,       RR_TEST},       \
+        {MODE_UDP_ECHO, UDP_ECHO_TEST}, \
     }
 // clang-format on
 
-#define NO_METRICS_TAG "no-metrics" /**< json tag for no-metrics */
-#define NO_RESTAPI_TAG "no-restapi" /**< json tag for no-restapi */
-#define ENABLE_CLI_TAG "cli"        /**< json tag to enable/disable CLI */
+#define NO_METRICS_TAG "no-metrics"    /**< json tag for no-metrics */
+#define NO_RESTAPI_TAG "no-restapi"    /**< json tag for no-restapi */
+#define ENABLE_CLI_TAG "cli"           /**< json tag to enable/disable CLI */
+#define TCP_RACK_TAG   "tcp-rack"      /**< json tag to enable/disable TCP RACK-TLP */
+#define TAIL_DROP_TAG  "tcp-tail-drop" /**< json tag to drop every Nth TCP flight tail */
+#define TCP_PACING_TAG "tcp-pacing"    /**< json tag to enable/disable TCP send pacing */
+#define UDP_BULK_TAG   "udp-bulk"      /**< json tag to use the bulk UDP channel calls */
+#define TCP_DSA_TAG    "tcp-dsa"       /**< json tag of the DSA work queue for TCP data copies */
 
 struct fwd_port {
     int lport;                           /**< PKTDEV lport id */
@@ -81,20 +93,58 @@ struct fwd_port {
 };
 
 struct app_options {
-    bool no_metrics; /**< Enable metrics*/
-    bool no_restapi; /**< Enable REST API*/
-    bool cli;        /**< Enable Cli*/
+    bool no_metrics;    /**< Enable metrics*/
+    bool no_restapi;    /**< Enable REST API*/
+    bool cli;           /**< Enable Cli*/
+    bool rack;          /**< Enable TCP RACK-TLP loss detection */
+    bool pacing;        /**< Enable TCP send pacing */
+    bool no_udp_bulk;   /**< Send each UDP echo reply with chnl_sendto() */
+    uint32_t tail_drop; /**< Drop every Nth TCP segment ending a flight, zero disables */
+    const char *dsa_wq; /**< DSA work queue copying TCP segment data, "sw" for software */
     unsigned int node_cnt;
     unsigned int node_sz;
     const char **nodes;
 };
 
+#define RR_REQUEST_SIZE 64          /**< Default size of the request data in the rr test */
+#define RR_SEG_SIZE     1024        /**< Request data placed in each mbuf */
+#define RR_MAX_SEGS     256         /**< Maximum number of mbufs in a request */
+#define RR_SAMPLE_COUNT (64 * 1024) /**< Number of latency samples kept for percentiles */
+
+/* Request/response latency test client, one outstanding transaction per thread */
+typedef struct rr_info_s {
+    struct in_caddr addr; /**< Server address for the request */
+    bool enabled;         /**< Thread is a rr test client */
+    bool persist;         /**< Keep the connection open between transactions */
+    bool busy;            /**< A request is outstanding */
+    int cd;               /**< Channel of the outstanding request or -1 */
+    uint16_t lport;       /**< lport used to allocate request buffers */
+    uint32_t size;        /**< Request size in bytes, echoed back by the server */
+    uint32_t rcvd;        /**< Response bytes received for the outstanding request */
+    uint64_t start;       /**< Timestamp when the request was sent */
+    uint64_t count;       /**< Number of completed transactions */
+    uint64_t timeouts;    /**< Number of transactions timed out */
+    uint64_t total;       /**< Sum of the transaction latency in cycles */
+    uint64_t min;         /**< Minimum transaction latency in cycles */
+    uint64_t max;         /**< Maximum transaction latency in cycles */
+    uint64_t *samples;    /**< Last RR_SAMPLE_COUNT transaction latencies in cycles */
+} rr_info_t;
+
+/* UDP echo benchmark counters of a thread */
+typedef struct echo_info_s {
+    uint64_t pkts;   /**< Datagrams echoed */
+    uint64_t calls;  /**< Send calls made to echo the datagrams */
+    uint64_t cycles; /**< Cycles spent receiving and echoing datagrams */
+} echo_info_t;
+
 typedef struct graph_info_s {
     cne_graph_t id;
     struct cne_graph *graph;
     int cnt;
     int nb_patterns;
     const char **patterns;
+    rr_info_t rr;     /**< Request/response test client information */
+    echo_info_t echo; /**< UDP echo benchmark counters */
 } graph_info_t;
 
 #define MAX_GRAPH_COUNT 128
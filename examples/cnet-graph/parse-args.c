@@ -68,6 +68,21 @@ process_callback(jcfg_info_t *j, void *_obj, void *arg, int idx)
         } else if (!strncmp(obj.opt->name, ENABLE_CLI_TAG, nlen)) {
             if (obj.opt->val.type == BOOLEAN_OPT_TYPE)
                 ci->opts.cli = obj.opt->val.boolean;
+        } else if (!strncmp(obj.opt->name, TCP_RACK_TAG, nlen)) {
+            if (obj.opt->val.type == BOOLEAN_OPT_TYPE)
+                ci->opts.rack = obj.opt->val.boolean;
+        } else if (!strncmp(obj.opt->name, TAIL_DROP_TAG, nlen)) {
+            if (obj.opt->val.type == INTEGER_OPT_TYPE)
+                ci->opts.tail_drop = obj.opt->val.value;
+        } else if (!strncmp(obj.opt->name, TCP_PACING_TAG, nlen)) {
+            if (obj.opt->val.type == BOOLEAN_OPT_TYPE)
+                ci->opts.pacing = obj.opt->val.boolean;
+        } else if (!strncmp(obj.opt->name, UDP_BULK_TAG, nlen)) {
+            if (obj.opt->val.type == BOOLEAN_OPT_TYPE)
+                ci->opts.no_udp_bulk = !obj.opt->val.boolean;
+        } else if (!strncmp(obj.opt->name, TCP_DSA_TAG, nlen)) {
+            if (obj.opt->val.type == STRING_OPT_TYPE && obj.opt->val.str[0] != '\0')
+                ci->opts.dsa_wq = obj.opt->val.str;
         }
         break;
 
@@ -216,7 +231,7 @@ static void
 print_usage(char *prog_name)
 {
     cne_printf("Usage: %s [-h] [-c json_file] [-b burst] <mode>\n"
-               "  <mode>         Mode types [drop | rx-only] or [lb | loopback]\n"
+               "  <mode>         Mode types [drop | rx-only], [lb | loopback] or rr\n"
                "  -b <burst>     Burst size. If not present default burst size %d max %d.\n"
                "  -c <json-file> The JSON configuration file\n"
                "  -s <cmd-file>  File containing cli commands for setup\n"
@@ -0,0 +1,3 @@
+module github.com/CloudNativeDataPlane/cndp/lang/go/stats/shmstats
+
+go 1.18
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2023 Intel Corporation
+
+// Package shmstats reads the shared memory statistics segment created by a CNDP
+// application with shmstats_create(), see lib/core/shmstats/shmstats.h for the layout.
+package shmstats
+
+import (
+	"bytes"
+	"encoding/binary"
+	"fmt"
+	"os"
+	"path/filepath"
+	"sync/atomic"
+	"syscall"
+	"unsafe"
+)
+
+// Segment layout constants, must match lib/core/shmstats/shmstats.h
+const (
+	segMagic    = 0x5354415453444e43
+	segVersion  = 1
+	nameLen     = 64
+	hdrSize     = 64
+	descSize    = 128
+	blkHdrSize  = 16
+	blkActive   = 1
+	readRetries = 128
+
+	// Prefix of the default segment name /cndp_stats.<pid>
+	Prefix = "cndp_stats"
+)
+
+// Block types
+const (
+	TypeNone = iota
+	TypeLport
+	TypeGraph
+	TypeMempool
+	TypeTCP
+	TypeUser = 0x100
+)
+
+// Segment is a read-only mapping of a statistics segment
+type Segment struct {
+	Name string // shm_open() name of the segment
+	Pid  int    // Process ID of the writer
+	data []byte
+}
+
+// Block is a consistent snapshot of a block of counters
+type Block struct {
+	Name   string   // Name of the block
+	Type   uint32   // Type of the block
+	Names  []string // Names of the counters
+	Values []uint64 // Values of the counters
+}
+
+// Open maps the statistics segment read-only, name is the shm_open() name e.g. /cndp_stats.1234
+func Open(name string) (*Segment, error) {
+
+	f, err := os.Open(filepath.Join("/dev/shm", name))
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+
+	st, err := f.Stat()
+	if err != nil {
+		return nil, err
+	}
+	if st.Size() < hdrSize {
+		return nil, fmt.Errorf("segment %s is too small", name)
+	}
+
+	data, err := syscall.Mmap(int(f.Fd()), 0, int(st.Size()), syscall.PROT_READ, syscall.MAP_SHARED)
+	if err != nil {
+		return nil, err
+	}
+
+	s := &Segment{Name: name, data: data}
+
+	if atomic.LoadUint64(s.u64(0)) != segMagic {
+		s.Close()
+		return nil, fmt.Errorf("segment %s has an invalid magic value", name)
+	}
+	if v := s.le32(8); v != segVersion {
+		s.Close()
+		return nil, fmt.Errorf("segment %s version %d, expected %d", name, v, segVersion)
+	}
+	if s.le32(12) != hdrSize || s.le64(16) != uint64(len(data)) ||
+		hdrSize+uint64(s.le32(24))*descSize > uint64(len(data)) {
+		s.Close()
+		return nil, fmt.Errorf("segment %s has an invalid header", name)
+	}
+	s.Pid = int(int32(s.le32(36)))
+
+	return s, nil
+}
+
+// Close unmaps the segment
+func (s *Segment) Close() error {
+
+	if s.data == nil {
+		return nil
+	}
+	err := syscall.Munmap(s.data)
+	s.data = nil
+
+	return err
+}
+
+// Blocks returns a snapshot of all active blocks, blocks being updated too often to get a
+// consistent copy are skipped
+func (s *Segment) Blocks() []Block {
+	var blocks []Block
+
+	cnt := atomic.LoadUint32(s.u32(28))
+	if max := s.le32(24); cnt > max {
+		cnt = max
+	}
+
+	for i := uint32(0); i < cnt; i++ {
+		if b, ok := s.block(hdrSize + uint64(i)*descSize); ok {
+			blocks = append(blocks, b)
+		}
+	}
+
+	return blocks
+}
+
+func (s *Segment) block(d uint64) (Block, bool) {
+
+	if atomic.LoadUint32(s.u32(d+68)) != blkActive {
+		return Block{}, false
+	}
+
+	nb := uint64(s.le32(d + 72))
+	namesOff := s.le64(d + 80)
+	blkOff := s.le64(d + 88)
+	size := uint64(len(s.data))
+
+	if namesOff+nb*nameLen > size || blkOff+blkHdrSize+nb*8 > size || blkOff%8 != 0 {
+		return Block{}, false
+	}
+
+	b := Block{
+		Name:   cstring(s.data[d : d+nameLen]),
+		Type:   s.le32(d + 64),
+		Names:  make([]string, nb),
+		Values: make([]uint64, nb),
+	}
+	for i := uint64(0); i < nb; i++ {
+		off := namesOff + i*nameLen
+		b.Names[i] = cstring(s.data[off : off+nameLen])
+	}
+
+	// Take a copy between two equal and even values of the block sequence count
+	for try := 0; try < readRetries; try++ {
+		seq := atomic.LoadUint32(s.u32(blkOff))
+		if seq&1 != 0 {
+			continue
+		}
+		for i := uint64(0); i < nb; i++ {
+			b.Values[i] = atomic.LoadUint64(s.u64(blkOff + blkHdrSize + i*8))
+		}
+		if atomic.LoadUint32(s.u32(blkOff)) == seq {
+			return b, true
+		}
+	}
+
+	return Block{}, false
+}
+
+func (s *Segment) u32(off uint64) *uint32 {
+	return (*uint32)(unsafe.Pointer(&s.data[off]))
+}
+
+func (s *Segment) u64(off uint64) *uint64 {
+	return (*uint64)(unsafe.Pointer(&s.data[off]))
+}
+
+func (s *Segment) le32(off uint64) uint32 {
+	return binary.LittleEndian.Uint32(s.data[off:])
+}
+
+func (s *Segment) le64(off uint64) uint64 {
+	return binary.LittleEndian.Uint64(s.data[off:])
+}
+
+func cstring(b []byte) string {
+	if i := bytes.IndexByte(b, 0); i >= 0 {
+		b = b[:i]
+	}
+	return string(b)
+}
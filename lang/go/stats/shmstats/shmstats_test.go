@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2023 Intel Corporation
+
+package shmstats
+
+import (
+	"encoding/binary"
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+// writeSegment builds a segment with one block the same way shmstats_block_alloc() does
+func writeSegment(t *testing.T, name string) {
+	const size = 4096
+	le := binary.LittleEndian
+	data := make([]byte, size)
+
+	le.PutUint64(data[0:], segMagic)
+	le.PutUint32(data[8:], segVersion)
+	le.PutUint32(data[12:], hdrSize)
+	le.PutUint64(data[16:], size)
+	le.PutUint32(data[24:], 4)  // max_blocks
+	le.PutUint32(data[28:], 1)  // nb_blocks
+	le.PutUint32(data[36:], 42) // pid
+
+	d := hdrSize
+	names := hdrSize + 4*descSize
+	blk := names + 2*nameLen
+	copy(data[d:], "lport0")
+	le.PutUint32(data[d+64:], TypeLport)
+	le.PutUint32(data[d+68:], blkActive)
+	le.PutUint32(data[d+72:], 2)
+	le.PutUint64(data[d+80:], uint64(names))
+	le.PutUint64(data[d+88:], uint64(blk))
+
+	copy(data[names:], "ipackets")
+	copy(data[names+nameLen:], "ibytes")
+	le.PutUint32(data[blk:], 2) // even sequence count
+	le.PutUint32(data[blk+4:], 2)
+	le.PutUint64(data[blk+blkHdrSize:], 100)
+	le.PutUint64(data[blk+blkHdrSize+8:], 6400)
+
+	if err := os.WriteFile(filepath.Join("/dev/shm", name), data, 0644); err != nil {
+		t.Skipf("unable to create segment: %v", err)
+	}
+}
+
+func TestBlocks(t *testing.T) {
+	name := fmt.Sprintf("/%s_gotest.%d", Prefix, os.Getpid())
+
+	writeSegment(t, name)
+	defer os.Remove(filepath.Join("/dev/shm", name))
+
+	s, err := Open(name)
+	if err != nil {
+		t.Fatalf("Open(%s) failed: %v", name, err)
+	}
+	defer s.Close()
+
+	if s.Pid != 42 {
+		t.Errorf("Pid %d, expected 42", s.Pid)
+	}
+
+	blocks := s.Blocks()
+	if len(blocks) != 1 {
+		t.Fatalf("found %d blocks, expected 1", len(blocks))
+	}
+
+	b := blocks[0]
+	if b.Name != "lport0" || b.Type != TypeLport || len(b.Values) != 2 {
+		t.Fatalf("unexpected block %+v", b)
+	}
+	if b.Names[1] != "ibytes" || b.Values[0] != 100 || b.Values[1] != 6400 {
+		t.Errorf("unexpected counters %v %v", b.Names, b.Values)
+	}
+}
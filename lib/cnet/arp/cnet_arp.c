@@ -6,9 +6,9 @@
 #include <cne_hash.h>        // for cne_hash_add_key_data, cne_hash_d...
 #include <endian.h>          // for htobe16
 #ifdef CNE_MACHINE_CPUFLAG_SSE4_2
-#include <cne_hash_crc.h>        // for cne_hash_crc
+#include <cne_crc.h>        // for cne_crc32c
 
-#define DEFAULT_HASH_FUNC cne_hash_crc
+#define DEFAULT_HASH_FUNC cne_crc32c
 #else
 #include <cne_jhash.h>
 
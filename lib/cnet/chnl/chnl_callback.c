@@ -31,6 +31,8 @@
 static inline void
 __callback(struct pcb_entry *pcb)
 {
+    chnl_notify(pcb->ch);
+
     if (pcb->ch->ch_callback) {
         chnl_type_t ctype = (pcb->ip_proto == IPPROTO_TCP) ? CHNL_TCP_RECV_TYPE
                                                            : CHNL_UDP_RECV_TYPE;
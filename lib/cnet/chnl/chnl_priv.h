@@ -23,6 +23,9 @@
 #include <pthread.h>          // for pthread_mutex_t, pthread_cond_t
 #include <stdint.h>           // for uint16_t, int32_t, uint32_t, uintptr_t
 #include <sys/types.h>        // for ssize_t
+#include <unistd.h>           // for write
+#include <errno.h>            // for errno, EAGAIN
+#include <string.h>           // for strerror
 
 #include "cne_log.h"         // for CNE_LOG, CNE_LOG_DEBUG, CNE_LOG_ERR
 #include "cnet_tcp.h"        // for TCP_NORMAL_MSS
@@ -37,8 +40,9 @@ struct pcb_hd;
 extern "C" {
 #endif
 
-#define CHNL_VEC_SIZE 32                   /**< Number of initial Vectors to support for channel */
-#define _MIN_BUF_SIZE (3 * TCP_NORMAL_MSS) /**< 1460 Normal MSS size for TCP */
+#define CHNL_VEC_SIZE  32                   /**< Number of initial Vectors to support for channel */
+#define CHNL_BULK_SIZE 64                   /**< Datagrams passed to the protocol per bulk call */
+#define _MIN_BUF_SIZE  (3 * TCP_NORMAL_MSS) /**< 1460 Normal MSS size for TCP */
 
 #ifndef __CNET_CHNL_H
 /**
@@ -80,6 +84,7 @@ struct chnl {
     struct cne_node *ch_node;       /**< Next Node pointer */
     struct chnl_buf ch_rcv;         /**< Receive buffer */
     struct chnl_buf ch_snd;         /**< Transmit buffer */
+    int ch_efd;                     /**< eventfd for cthread_wait_chnl(), -1 if unused */
 };
 
 /* Used for the chnl.ch_state, bits 0-3 are Channel state value */
@@ -97,6 +102,22 @@ enum {
 
 #define _STATE_MASK 0x000f /**< Channel state mask */
 
+/**
+ * Signal a channel event to a cthread parked in cthread_wait_chnl()
+ *
+ * @param ch
+ *   The channel structure pointer
+ */
+static inline void
+chnl_notify(struct chnl *ch)
+{
+    uint64_t v = 1;
+
+    /* EAGAIN means the counter is already non-zero, the waiter will see the event */
+    if (ch && ch->ch_efd >= 0 && write(ch->ch_efd, &v, sizeof(v)) < 0 && errno != EAGAIN)
+        CNE_WARN("Channel %d eventfd write failed: %s\n", ch->ch_cd, strerror(errno));
+}
+
 /**
  * Return the current channel state value
  *
@@ -278,6 +299,7 @@ enum {
     TCP_NOOPT_FLAG      = 0x0400,
     TCP_NOPUSH_FLAG     = 0x0800,
     TCP_MAXSEG_FLAG     = 0x1000,
+    TCP_FASTOPEN_FLAG   = 0x2000, /* TCP Fast Open enabled for listen or connect */
 };
 
 /**
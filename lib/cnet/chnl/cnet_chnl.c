@@ -18,6 +18,9 @@
 #include <string.h>        // for memcpy, memset, strerror
 #include <cnet_meta.h>
 #include <cne_mutex_helper.h>
+#include <cthread_api.h>        // for cthread_wait_fd
+#include <sys/epoll.h>          // for EPOLLIN
+#include <sys/eventfd.h>        // for eventfd, EFD_NONBLOCK
 
 #include "cne_common.h"        // for __cne_unused, CNE_MIN, CNE_SET_USED
 #include "cne_log.h"           // for cne_panic
@@ -71,7 +74,8 @@ mp_init(mempool_t *mp, void *opaque_arg __cne_unused, void *_b, unsigned i __cne
     memset(ch, 0, mempool_objsz(mp));
 
     chnl_state_set(ch, _CHNL_FREE);
-    ch->ch_cd = -1;
+    ch->ch_cd  = -1;
+    ch->ch_efd = -1;
 }
 
 static inline struct chnl *
@@ -105,6 +109,9 @@ free_chnl(struct chnl *ch)
     vec_free(ch->ch_rcv.cb_vec);
     vec_free(ch->ch_snd.cb_vec);
 
+    if (ch->ch_efd >= 0)
+        close(ch->ch_efd);
+
     if (cne_mutex_destroy(&ch->ch_mutex))
         CNE_RET("Failed to destroy ch_mutex\n");
 
@@ -363,6 +370,34 @@ channel(int domain, int type, int proto, chnl_cb_t cb)
     return ch->ch_cd;
 }
 
+int
+cthread_wait_chnl(int cd, uint64_t nsecs)
+{
+    struct chnl *ch = ch_get(cd);
+    uint64_t v;
+    int ret;
+
+    if (!ch || chnl_state_tst(ch, _CHNL_FREE))
+        return __errno_set(EFAULT);
+
+    /* created on first use, the stack only signals channels with a waiter */
+    if (ch->ch_efd < 0) {
+        ch->ch_efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (ch->ch_efd < 0)
+            return -1;
+    }
+
+    ret = cthread_wait_fd(ch->ch_efd, EPOLLIN, nsecs);
+    if (ret <= 0)
+        return ret;
+
+    /* consume the events, the caller checks the channel for what happened */
+    if (read(ch->ch_efd, &v, sizeof(v)) < 0 && errno != EAGAIN)
+        return -1;
+
+    return 1;
+}
+
 int
 chnl_close(int cd)
 {
@@ -547,6 +582,79 @@ leave:
     return -1;
 }
 
+int
+chnl_connect_send(int cd, struct sockaddr *sa, int namelen, pktmbuf_t **mbufs, uint16_t nb_mbufs)
+{
+    struct chnl *ch = ch_get(cd);
+    struct chnl_buf *cb;
+    uint32_t len = 0;
+
+    if (!ch || this_stk == NULL || (nb_mbufs && !mbufs))
+        return __errno_set(EFAULT);
+
+    if (!ch->ch_proto)
+        return __errno_set(EINVAL);
+
+    /* Datagram channels just connect and send */
+    if (ch->ch_proto->type != SOCK_STREAM) {
+        if (chnl_connect(cd, sa, namelen) < 0)
+            return -1;
+        return (nb_mbufs) ? chnl_send(cd, mbufs, nb_mbufs) : 0;
+    }
+
+    if (chnl_state_tst(ch, _ISCONNECTED) || chnl_state_tst(ch, _ISCONNECTING))
+        return __errno_set(EISCONN);
+
+    cb = &ch->ch_snd;
+
+    /*
+     * Queue the data on the send buffer before the connect, which allows a
+     * TCP Fast Open SYN to carry the data. Without a cookie the data is sent
+     * after the connection is established.
+     */
+    if (nb_mbufs) {
+        if (!stk_lock())
+            return __errno_set(EINVAL);
+
+        for (int i = 0; i < nb_mbufs; i++) {
+            if (!mbufs[i]) {
+                stk_unlock();
+                CNE_ERR_RET_VAL(__errno_set(EFAULT), "pktmbuf entry is NULL\n");
+            }
+            len += pktmbuf_data_len(mbufs[i]);
+        }
+
+        if (len > cb_space(cb)) {
+            stk_unlock();
+            return __errno_set(ENOBUFS);
+        }
+
+        for (int i = 0; i < nb_mbufs; i++) {
+            pktmbuf_t *m = mbufs[i];
+
+            m->userptr = ch->ch_pcb;
+            vec_add(cb->cb_vec, m);
+            cb->cb_cc += pktmbuf_data_len(m);
+            pktmbuf_refcnt_update(m, 1);
+        }
+        stk_unlock();
+    }
+
+    if (chnl_connect(cd, sa, namelen) < 0) {
+        /* The caller still owns the mbufs on error, remove them from the send buffer */
+        if (nb_mbufs && stk_lock()) {
+            for (int i = 0; i < nb_mbufs; i++)
+                pktmbuf_refcnt_update(mbufs[i], -1);
+            vec_set_len(cb->cb_vec, 0);
+            cb->cb_cc = 0;
+            stk_unlock();
+        }
+        return -1;
+    }
+
+    return nb_mbufs;
+}
+
 /*
  * This routine enables connections to a stream chnl. After enabling
  * connections with listen(), connections are actually accepted by accept().
@@ -710,6 +818,48 @@ chnl_recv(int cd, pktmbuf_t **mbufs, size_t len)
     return ch->ch_proto->funcs->recv_func(ch, mbufs, len);
 }
 
+/* Set the foreign address of a datagram from a user sockaddr */
+static inline void
+chnl_faddr_set(struct chnl *ch, struct cnet_metadata *md, struct sockaddr *sa)
+{
+    if (is_ch_dom_inet6(ch)) {
+        struct sockaddr_in6 *addr = (struct sockaddr_in6 *)sa;
+
+        if (addr->sin6_family == AF_INET6) {
+            md->faddr.cin_family = addr->sin6_family;
+            md->faddr.cin_port   = addr->sin6_port;
+            md->faddr.cin_len    = sizeof(struct in6_addr);
+            inet6_addr_copy(&md->faddr.cin6_addr, &addr->sin6_addr);
+        }
+    } else {
+        struct sockaddr_in *addr = (struct sockaddr_in *)sa;
+
+        if (addr->sin_family == AF_INET) {
+            md->faddr.cin_family      = addr->sin_family;
+            md->faddr.cin_port        = addr->sin_port;
+            md->faddr.cin_len         = sizeof(struct in_addr);
+            md->faddr.cin_addr.s_addr = addr->sin_addr.s_addr;
+        }
+    }
+}
+
+/* Return the foreign address of a received datagram as a user sockaddr */
+static inline void
+chnl_faddr_get(struct cnet_metadata *md, chnl_mmsg_t *msg)
+{
+    if (CIN_FAMILY(&md->faddr) == AF_INET6) {
+        memset(&msg->addr.sin6, 0, sizeof(msg->addr.sin6));
+        msg->addr.sin6.sin6_family = AF_INET6;
+        msg->addr.sin6.sin6_port   = md->faddr.cin_port;
+        inet6_addr_copy(&msg->addr.sin6.sin6_addr, &md->faddr.cin6_addr);
+    } else {
+        memset(&msg->addr.sin, 0, sizeof(msg->addr.sin));
+        msg->addr.sin.sin_family      = AF_INET;
+        msg->addr.sin.sin_port        = md->faddr.cin_port;
+        msg->addr.sin.sin_addr.s_addr = md->faddr.cin_addr.s_addr;
+    }
+}
+
 static int
 sendit(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
 {
@@ -727,9 +877,6 @@ sendit(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
     if (chnl_state_tst(ch, _CHNL_FREE) || is_set(ch->ch_state, _CANTSENDMORE))
         CNE_ERR_RET_VAL(__errno_set(EPIPE), "State is free or cant sent more\n");
 
-    if (nb_mbufs == 0)
-        return 0;
-
     if (sa) {
         for (int i = 0; i < nb_mbufs; i++) {
             struct cnet_metadata *md;
@@ -741,27 +888,7 @@ sendit(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
             if (!md)
                 CNE_ERR_RET_VAL(__errno_set(EFAULT), "pktmbuf metadata is NULL\n");
 
-            if (is_ch_dom_inet6(ch)) {
-                struct sockaddr_in6 *addr;
-
-                addr = (struct sockaddr_in6 *)&sa[i];
-                if (addr->sin6_family == AF_INET6) {
-                    md->faddr.cin_family = addr->sin6_family;
-                    md->faddr.cin_port   = addr->sin6_port;
-                    md->faddr.cin_len    = sizeof(struct in6_addr);
-                    inet6_addr_copy(&md->faddr.cin6_addr, &addr->sin6_addr);
-                }
-            } else {
-                struct sockaddr_in *addr;
-
-                addr = (struct sockaddr_in *)&sa[i];
-                if (addr->sin_family == AF_INET) {
-                    md->faddr.cin_family      = addr->sin_family;
-                    md->faddr.cin_port        = addr->sin_port;
-                    md->faddr.cin_len         = sizeof(struct in_addr);
-                    md->faddr.cin_addr.s_addr = addr->sin_addr.s_addr;
-                }
-            }
+            chnl_faddr_set(ch, md, sa);
         }
     }
 
@@ -822,6 +949,99 @@ chnl_sendto(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
     return sendit(cd, sa, mbufs, nb_mbufs);
 }
 
+int
+chnl_sendto_bulk(int cd, chnl_mmsg_t *msgs, uint16_t nb_msgs)
+{
+    struct chnl *ch = ch_get(cd);
+    pktmbuf_t *mbufs[CHNL_BULK_SIZE];
+    int sent = 0;
+
+    if (nb_msgs == 0)
+        return 0;
+
+    if (this_stk == NULL)
+        return __errno_set(EINVAL);
+
+    if (!ch || !msgs)
+        return __errno_set(EFAULT);
+
+    if (ch->ch_proto->type == SOCK_STREAM)
+        return __errno_set(EOPNOTSUPP);
+
+    if (chnl_state_tst(ch, _CHNL_FREE) || is_set(ch->ch_state, _CANTSENDMORE))
+        CNE_ERR_RET_VAL(__errno_set(EPIPE), "State is free or cant sent more\n");
+
+    __errno_set(0);
+
+    while (sent < nb_msgs) {
+        uint16_t n = CNE_MIN(nb_msgs - sent, CHNL_BULK_SIZE);
+
+        for (int i = 0; i < n; i++) {
+            chnl_mmsg_t *msg = &msgs[sent + i];
+            struct cnet_metadata *md;
+
+            if (!msg->mbuf || (md = pktmbuf_metadata(msg->mbuf)) == NULL)
+                CNE_ERR_RET_VAL((sent) ? sent : __errno_set(EFAULT),
+                                "pktmbuf entry or metadata is NULL\n");
+
+            if (msg->addr.sa.sa_family == AF_UNSPEC)
+                in_caddr_copy(&md->faddr, &ch->ch_pcb->key.faddr);
+            else
+                chnl_faddr_set(ch, md, &msg->addr.sa);
+
+            /* A new datagram is sent from the address the channel is bound to */
+            if (CIN_LEN(&md->laddr) == 0)
+                in_caddr_copy(&md->laddr, &ch->ch_pcb->key.laddr);
+
+            mbufs[i] = msg->mbuf;
+        }
+
+        if (ch->ch_proto->funcs->send_func(ch, mbufs, n) < 0)
+            return (sent) ? sent : -1;
+        sent += n;
+    }
+
+    return sent;
+}
+
+int
+chnl_recvfrom_bulk(int cd, chnl_mmsg_t *msgs, uint16_t nb_msgs)
+{
+    struct chnl *ch = ch_get(cd);
+    pktmbuf_t *mbufs[CHNL_BULK_SIZE];
+    int nb, rcvd = 0;
+
+    if (nb_msgs == 0)
+        return 0;
+
+    if (!ch || this_stk == NULL || !msgs)
+        return __errno_set(EFAULT);
+
+    if (ch->ch_proto->type == SOCK_STREAM)
+        return __errno_set(EOPNOTSUPP);
+
+    if (chnl_state_tst(ch, _CHNL_FREE))
+        return __errno_set(EPIPE);
+
+    __errno_set(0);
+
+    while (rcvd < nb_msgs) {
+        nb = ch->ch_proto->funcs->recv_func(ch, mbufs, CNE_MIN(nb_msgs - rcvd, CHNL_BULK_SIZE));
+        if (nb <= 0)
+            break;
+
+        for (int i = 0; i < nb; i++) {
+            chnl_mmsg_t *msg = &msgs[rcvd + i];
+
+            msg->mbuf = mbufs[i];
+            chnl_faddr_get(pktmbuf_metadata(mbufs[i]), msg);
+        }
+        rcvd += nb;
+    }
+
+    return (rcvd == 0 && nb < 0) ? -1 : rcvd;
+}
+
 /*
  * This routine implements the bulk of the bind() function, for all chnl
  * types.  It takes an additional argument pHd, which is a pointer to a
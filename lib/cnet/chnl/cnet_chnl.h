@@ -184,6 +184,30 @@ CNDP_API int chnl_accept(int cd, struct sockaddr *sa, socklen_t *addrlen);
  */
 CNDP_API int chnl_connect(int cd, struct sockaddr *sa, int addrlen);
 
+/**
+ * @brief Connect to a channel and send data in one call.
+ *
+ * The data is queued before the connection is started. On a TCP channel with the
+ * TCP_FASTOPEN_CONNECT option set and a cached cookie for the server the data is
+ * sent in the SYN, otherwise it is sent once the connection is established. On a
+ * datagram channel this is the same as calling chnl_connect() then chnl_send().
+ *
+ * @param cd
+ *   The channel descriptor index
+ * @param sa
+ *   The sockaddr of the remote side of the connection.
+ * @param addrlen
+ *   The length of the sockaddr structure
+ * @param mbufs
+ *   The mbuf array to send multiple data buffers, can be NULL if nb_mbufs is zero
+ * @param nb_mbufs
+ *   Number of mbufs in the mbufs array
+ * @return
+ *   -1 on error or number of mbufs queued on success
+ */
+CNDP_API int chnl_connect_send(int cd, struct sockaddr *sa, int addrlen, pktmbuf_t **mbufs,
+                               uint16_t nb_mbufs);
+
 /**
  * This routine receives data from a chnl.  It is normally used with
  * connected chnls, because it does not return the source address of the
@@ -256,6 +280,52 @@ CNDP_API int chnl_send(int cd, pktmbuf_t **mbufs, uint16_t nb_mbufs);
  */
 CNDP_API int chnl_sendto(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs);
 
+/**
+ * A datagram and the remote address it was received from or is sent to, used by
+ * chnl_recvfrom_bulk() and chnl_sendto_bulk() similar to 'struct mmsghdr'.
+ */
+typedef struct chnl_mmsg {
+    pktmbuf_t *mbuf; /**< Datagram data */
+    union {
+        struct sockaddr sa;       /**< Generic address, sa_family selects the type */
+        struct sockaddr_in sin;   /**< IPv4 address */
+        struct sockaddr_in6 sin6; /**< IPv6 address */
+    } addr;                       /**< Remote address */
+} chnl_mmsg_t;
+
+/**
+ * @brief Send a burst of datagrams each with its own destination similar to 'sendmmsg()'
+ *
+ * All of the datagrams are passed to the protocol in a single call and the headers,
+ * route and ARP lookups are done for the burst by the output nodes.
+ *
+ * @param cd
+ *   The channel descriptor index of a datagram channel
+ * @param msgs
+ *   Array of mbuf and destination address pairs, a zero sa_family uses the
+ *   address the channel is connected to.
+ * @param nb_msgs
+ *   Number of entries in the msgs array
+ * @return
+ *   -1 on error or the number of datagrams sent, the mbufs of the datagrams sent
+ *   are owned by the stack.
+ */
+CNDP_API int chnl_sendto_bulk(int cd, chnl_mmsg_t *msgs, uint16_t nb_msgs);
+
+/**
+ * @brief Receive a burst of datagrams and their source addresses similar to 'recvmmsg()'
+ *
+ * @param cd
+ *   The channel descriptor index of a datagram channel
+ * @param msgs
+ *   Array of mbuf and address pairs to fill in
+ * @param nb_msgs
+ *   Number of entries in the msgs array
+ * @return
+ *   -1 on error or the number of datagrams received.
+ */
+CNDP_API int chnl_recvfrom_bulk(int cd, chnl_mmsg_t *msgs, uint16_t nb_msgs);
+
 /**
  * This routine gets the current name for the specified chnl.
  *
@@ -310,6 +380,24 @@ CNDP_API int chnl_getpeername(int cd, struct sockaddr *sa, socklen_t *salen);
  */
 CNDP_API int chnl_close(int cd);
 
+/**
+ * @brief Park the calling cthread until a channel event happens.
+ *
+ * The cthread sleeps on the scheduler epoll fd, see cthread_wait_fd(), and is
+ * woken when data is received, a connection is accepted or established, the
+ * peer closes the connection or send buffer space opens up. Events that happen
+ * before the call are not lost, the wait returns at once. The channel must not
+ * be closed while a cthread is waiting on it.
+ *
+ * @param cd
+ *   The channel descriptor index
+ * @param nsecs
+ *   Number of nsecs to wait, zero waits without a timeout
+ * @return
+ *   1 on a channel event, 0 on timeout or -1 on error
+ */
+CNDP_API int cthread_wait_chnl(int cd, uint64_t nsecs);
+
 /**
  * @brief Shutdown a channel connection similar to 'shutdown()'
  *
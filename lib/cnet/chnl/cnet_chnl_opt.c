@@ -242,6 +242,10 @@ chnl_optval_get(const void *optval, uint32_t optlen)
  * protocol data structures are reclaimed, and processes sleeping on the
  * connection are awakened with an ETIMEDOUT error.
  *
+ * SO_MAX_PACING_RATE - limit the pacing rate ('int')
+ * This option sets the maximum rate in bytes per second new data is sent on a
+ * TCP connection when pacing is enabled, zero removes the limit.
+ *
  * The following SO_CHANNEL option only applies to datagram chnls.
  *
  * SO_BROADCAST - permit sending of broadcast msgs ('int'/boolean)
@@ -354,6 +358,9 @@ chnl_set_opt(int cd, int level, int optname, const void *optval, int optlen)
                 chnl_sbreserve(((optname == SO_SNDBUF) ? &ch->ch_snd : &ch->ch_rcv), val);
                 break;
 
+            case SO_MAX_PACING_RATE: /* protocol specific */
+                goto Unknown;
+
             default:
                 CNE_ERR("Unknown option %d\n", optname);
                 goto Unknown;
@@ -484,6 +491,9 @@ leave:
  * SO_ACCEPTCONN - return true, if the chnl is listening.
  * This option only applies to a TCP connection.
  *
+ * SO_MAX_PACING_RATE - pacing rate limit ('int')
+ * This option reports the maximum pacing rate of a TCP connection.
+ *
  * The following SO_CHANNEL option only applies to datagram chnls.
  *
  * SO_BROADCAST - permit sending of broadcast msgs ('int'/boolean)
@@ -3,6 +3,7 @@
  */
 
 #include <stdio.h>        // for stdout, NULL
+#include <inttypes.h>     // for PRIu64
 #include <regex.h>
 #include <immintrin.h>             // for __m256i
 #include <cnet.h>                  // for cnet, per_thread_cnet, this_cnet, cnet_l...
@@ -698,6 +699,12 @@ cmd_ip_cksum(int argc __cne_unused, char **argv __cne_unused)
 static struct cli_map tcp_map[] = {
     {10, "tcp"},
     {11, "tcp stats"},
+    {12, "tcp burst"},
+    {20, "tcp rack %|on|off"},
+#if CNET_TCP_FAULT_INJECT_ENABLED
+    {30, "tcp tail-drop %d"},
+#endif
+    {40, "tcp pacing %|on|off"},
     {-1, NULL}
     };
 // clang-format on
@@ -707,6 +714,7 @@ cmd_tcp(int argc, char **argv)
 {
     struct cnet *cnet = this_cnet;
     struct cli_map *m;
+    stk_t *stk;
 
     m = cli_mapping(tcp_map, argc, argv);
     if (!m)
@@ -739,6 +747,43 @@ cmd_tcp(int argc, char **argv)
         _(tcp_rexmit);
         _(resets_sent);
         _(tcp_connect);
+        _(tfo_cookie_req);
+        _(tfo_syn_data);
+        _(tfo_bad_cookie);
+        _(tfo_data_sent);
+        _(rack_lost);
+        _(rack_timeout);
+        _(tlp_probe);
+        _(tlp_recovered);
+        _(tail_drop);
+        _(paced);
+        _(pace_deferred);
+        break;
+    case 12: {
+        const char *burst[TCP_PACE_BURST_BUCKETS] = {"1",    "2",     "3-4",   "5-8",
+                                                     "9-16", "17-32", "33-64", "65+"};
+
+        cne_printf("[magenta]Segments sent per tcp_output() call[]\n");
+        for (int i = 0; i < TCP_PACE_BURST_BUCKETS; i++) {
+            cne_printf("[magenta]%-16s[]: ", burst[i]);
+            vec_foreach_ptr (stk, cnet->stks)
+                cne_printf("[cyan]%8" PRIu64 "[] ", stk->tcp_stats->S_burst[i]);
+            cne_printf("\n");
+        }
+    } break;
+    case 20:
+        vec_foreach_ptr (stk, cnet->stks)
+            cnet_tcp_rack_set(stk, !strcasecmp(argv[2], "on"));
+        break;
+#if CNET_TCP_FAULT_INJECT_ENABLED
+    case 30:
+        vec_foreach_ptr (stk, cnet->stks)
+            cnet_tcp_tail_drop_set(stk, strtoul(argv[2], NULL, 10));
+        break;
+#endif
+    case 40:
+        vec_foreach_ptr (stk, cnet->stks)
+            cnet_tcp_pacing_set(stk, !strcasecmp(argv[2], "on"));
         break;
     default:
         return cli_cmd_error("Command invalid", "tcp", argc, argv);
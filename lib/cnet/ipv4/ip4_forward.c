@@ -111,22 +111,22 @@ ip4_forward_node_process(struct cne_graph *graph, struct cne_node *node, void **
 
         hdr    = pktmbuf_mtod(mbuf0, struct cne_ipv4_hdr *);
         ip4[0] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        cne_ipv4_ttl_dec(hdr);
         eth[0] = pktmbuf_adjust(mbuf0, struct cne_ether_hdr *, -mbuf0->l2_len);
 
         hdr    = pktmbuf_mtod(mbuf1, struct cne_ipv4_hdr *);
         ip4[1] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        cne_ipv4_ttl_dec(hdr);
         eth[1] = pktmbuf_adjust(mbuf1, struct cne_ether_hdr *, -mbuf1->l2_len);
 
         hdr    = pktmbuf_mtod(mbuf2, struct cne_ipv4_hdr *);
         ip4[2] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        cne_ipv4_ttl_dec(hdr);
         eth[2] = pktmbuf_adjust(mbuf2, struct cne_ether_hdr *, -mbuf2->l2_len);
 
         hdr    = pktmbuf_mtod(mbuf3, struct cne_ipv4_hdr *);
         ip4[3] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        cne_ipv4_ttl_dec(hdr);
         eth[3] = pktmbuf_adjust(mbuf3, struct cne_ether_hdr *, -mbuf3->l2_len);
 
         n0 = n1 = n2 = n3 = NODE_IP4_FORWARD_ARP_REQUEST;
@@ -275,7 +275,7 @@ ip4_forward_node_process(struct cne_graph *graph, struct cne_node *node, void **
         n_left_from -= 1;
 
         hdr = pktmbuf_mtod(mbuf0, struct cne_ipv4_hdr *);
-        ipv4_adjust_cksum(hdr);
+        cne_ipv4_ttl_dec(hdr);
         eth[0] = pktmbuf_adjust(mbuf0, struct cne_ether_hdr *, -mbuf0->l2_len);
 
         /* Look up the destination IP address in the arp_fib hash table */
@@ -62,6 +62,7 @@ ip4_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     struct cne_ipv4_hdr *ip4[4];
     uint64_t dst[4] = {0};
     uint32_t dip[4] = {0};
+    uint32_t cksum_ok;
 
     /* Speculative next */
     next_index = CNE_NODE_IP4_INPUT_NEXT_FORWARD;
@@ -119,24 +120,23 @@ ip4_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         pktmbuf_data_len(mbuf2) = be16toh(ip4[2]->total_length);
         pktmbuf_data_len(mbuf3) = be16toh(ip4[3]->total_length);
 
+        /* Validate the four IP header checksums at once */
+        cksum_ok = cne_ipv4_cksum_verify_x4(ip4);
+
         /*
          * When the total length exceeds mbuf size, the size check/checksum below will
          * detect the invalid size/packet which will be dropped as 'dip[n]' is zero.
          */
-        if (likely(pktmbuf_data_len(mbuf0) < pktmbuf_buf_len(mbuf0)) &&
-            likely(cne_ipv4_cksum(ip4[0]) == 0))
+        if (likely(pktmbuf_data_len(mbuf0) < pktmbuf_buf_len(mbuf0)) && likely(cksum_ok & 1))
             dip[0] = be32toh(ip4[0]->dst_addr);
 
-        if (likely(pktmbuf_data_len(mbuf1) < pktmbuf_buf_len(mbuf1)) &&
-            likely(cne_ipv4_cksum(ip4[1]) == 0))
+        if (likely(pktmbuf_data_len(mbuf1) < pktmbuf_buf_len(mbuf1)) && likely(cksum_ok & 2))
             dip[1] = be32toh(ip4[1]->dst_addr);
 
-        if (likely(pktmbuf_data_len(mbuf2) < pktmbuf_buf_len(mbuf2)) &&
-            likely(cne_ipv4_cksum(ip4[2]) == 0))
+        if (likely(pktmbuf_data_len(mbuf2) < pktmbuf_buf_len(mbuf2)) && likely(cksum_ok & 4))
             dip[2] = be32toh(ip4[2]->dst_addr);
 
-        if (likely(pktmbuf_data_len(mbuf3) < pktmbuf_buf_len(mbuf3)) &&
-            likely(cne_ipv4_cksum(ip4[3]) == 0))
+        if (likely(pktmbuf_data_len(mbuf3) < pktmbuf_buf_len(mbuf3)) && likely(cksum_ok & 8))
             dip[3] = be32toh(ip4[3]->dst_addr);
 
         ipv4_save_metadata(mbuf0, ip4[0]);
@@ -45,32 +45,25 @@ struct ip4_output_node_ctx {
 };
 #define IP4_OUTPUT_NODE_LAST_NEXT(ctx) (((struct ip4_output_node_ctx *)ctx)->next_index)
 
-static inline uint16_t
-ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt)
+/* Build the IPv4 header of a packet, returns NULL if the packet must be dropped */
+static inline struct cne_ipv4_hdr *
+ip4_output_ip_hdr(pktmbuf_t *m)
 {
-    struct cnet *cnet = this_cnet;
     struct pcb_entry *pcb;
     struct cne_ipv4_hdr *ip;
-    struct cne_ether_hdr *eth;
-    struct rt4_entry *rt4;
-    struct arp_entry *arp;
     struct cnet_metadata *md;
-    struct netif *nif;
-    uint32_t ipaddr;
-    void *l4;
 
     pcb = m->userptr;
 
     md = pktmbuf_metadata(m);
     if (!md)
-        return nxt;
+        return NULL;
 
     m->l3_len = sizeof(struct cne_ipv4_hdr);
 
-    l4 = pktmbuf_mtod(m, void *);
     ip = (struct cne_ipv4_hdr *)pktmbuf_prepend(m, m->l3_len);
     if (!ip)
-        return nxt;
+        return NULL;
 
     ip->version_ihl     = (IPv4_VERSION << 4) | (sizeof(struct cne_ipv4_hdr) / 4);
     ip->type_of_service = pcb->tos;
@@ -82,9 +75,20 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
     ip->dst_addr        = md->faddr.cin_addr.s_addr;
     ip->src_addr        = md->laddr.cin_addr.s_addr;
 
-    ipaddr = be32toh(ip->src_addr);
+    return ip;
+}
 
-    if (likely(fib_info_lookup(cnet->rt4_finfo, &ipaddr, (void **)&rt4, 1) > 0)) {
+/* Add the ethernet header and checksums using the route and ARP entries of the packet */
+static inline uint16_t
+ip4_output_finish(pktmbuf_t *m, struct cne_ipv4_hdr *ip, struct rt4_entry *rt4,
+                  struct arp_entry *arp, uint16_t nxt)
+{
+    struct pcb_entry *pcb = m->userptr;
+    struct cne_ether_hdr *eth;
+    struct netif *nif;
+    void *l4 = (void *)(ip + 1);
+
+    if (likely(rt4)) {
         m->l2_len = sizeof(struct cne_ether_hdr);
         eth       = (struct cne_ether_hdr *)pktmbuf_prepend(m, sizeof(struct cne_ether_hdr));
         if (!eth)
@@ -113,9 +117,8 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
         } else
             return nxt;
 
-        nxt    = IP4_OUTPUT_NEXT_ARP_REQUEST;
-        ipaddr = be32toh(ip->dst_addr);
-        if (likely(fib_info_lookup(cnet->arp_finfo, &ipaddr, (void **)&arp, 1) > 0)) {
+        nxt = IP4_OUTPUT_NEXT_ARP_REQUEST;
+        if (likely(arp)) {
             ether_addr_copy(&arp->ha, &eth->d_addr);
 
             nxt = rt4->netif_idx + IP4_OUTPUT_NEXT_MAX;
@@ -125,17 +128,53 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
     return nxt;
 }
 
+/*
+ * Build the headers for a group of packets, the route and ARP entries of the
+ * group are found with one bulk FIB lookup each instead of a lookup per packet.
+ */
+static inline void
+ip4_output_header_bulk(pktmbuf_t **pkts, cne_edge_t *nexts, uint16_t nb_pkts)
+{
+    struct cnet *cnet = this_cnet;
+    struct cne_ipv4_hdr *ip[IP4_OUTPUT_BULK_SIZE];
+    struct rt4_entry *rt4[IP4_OUTPUT_BULK_SIZE] = {0};
+    struct arp_entry *arp[IP4_OUTPUT_BULK_SIZE] = {0};
+    uint32_t src[IP4_OUTPUT_BULK_SIZE], dst[IP4_OUTPUT_BULK_SIZE];
+    uint16_t hdr_len = (sizeof(struct cne_ipv4_hdr) + sizeof(struct cne_ether_hdr));
+
+    for (int i = 0; i < CNE_MIN(nb_pkts, 4); i++)
+        cne_prefetch0(pktmbuf_mtod_offset(pkts[i], void *, -hdr_len));
+
+    for (int i = 0; i < nb_pkts; i++) {
+        if (likely((i + 4) < nb_pkts))
+            cne_prefetch0(pktmbuf_mtod_offset(pkts[i + 4], void *, -hdr_len));
+
+        ip[i]  = ip4_output_ip_hdr(pkts[i]);
+        src[i] = (ip[i]) ? be32toh(ip[i]->src_addr) : 0;
+        dst[i] = (ip[i]) ? be32toh(ip[i]->dst_addr) : 0;
+    }
+
+    fib_info_lookup(cnet->rt4_finfo, src, (void **)rt4, nb_pkts);
+    fib_info_lookup(cnet->arp_finfo, dst, (void **)arp, nb_pkts);
+
+    for (int i = 0; i < nb_pkts; i++)
+        nexts[i] = (ip[i]) ? ip4_output_finish(pkts[i], ip[i], rt4[i], arp[i],
+                                               IP4_OUTPUT_NEXT_PKT_DROP)
+                           : IP4_OUTPUT_NEXT_PKT_DROP;
+}
+
 static uint16_t
 ip4_output_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
                         uint16_t nb_objs)
 {
-    pktmbuf_t *mbuf0, *mbuf1, *mbuf2, *mbuf3, **pkts;
+    pktmbuf_t **pkts;
     cne_edge_t next0, next1, next2, next3;
-    cne_edge_t next_index;
+    cne_edge_t next_index, *nxt;
     void **to_next, **from;
     uint16_t last_spec = 0;
     uint16_t n_left_from;
-    uint16_t held = 0, hdr_len = 0;
+    uint16_t held = 0;
+    cne_edge_t nexts[nb_objs];
 
     /* Speculative next */
     next_index = IP4_OUTPUT_NODE_LAST_NEXT(node->ctx);
@@ -144,44 +183,22 @@ ip4_output_node_process(struct cne_graph *graph, struct cne_node *node, void **o
     from        = objs;
     n_left_from = nb_objs;
 
-    hdr_len = (sizeof(struct cne_ipv4_hdr) + sizeof(struct cne_ether_hdr));
-    if (n_left_from >= 4) {
-        for (int i = 0; i < 4; i++)
-            cne_prefetch0(pktmbuf_mtod_offset(pkts[i], void *, -hdr_len));
-    }
+    /* Build the headers and find the next node of all packets first */
+    for (uint16_t i = 0; i < nb_objs; i += IP4_OUTPUT_BULK_SIZE)
+        ip4_output_header_bulk(&pkts[i], &nexts[i], CNE_MIN(nb_objs - i, IP4_OUTPUT_BULK_SIZE));
+    nxt = nexts;
 
     /* Get stream for the speculated next node */
     to_next = cne_node_next_stream_get(graph, node, next_index, nb_objs);
     while (n_left_from >= 4) {
-        /* Prefetch next-next mbufs */
-        if (likely(n_left_from > 11)) {
-            cne_prefetch0(pkts[8]);
-            cne_prefetch0(pkts[9]);
-            cne_prefetch0(pkts[10]);
-            cne_prefetch0(pkts[11]);
-        }
-
-        /* Prefetch next mbuf data */
-        if (likely(n_left_from > 7)) {
-            cne_prefetch0(pktmbuf_mtod_offset(pkts[4], void *, -hdr_len));
-            cne_prefetch0(pktmbuf_mtod_offset(pkts[5], void *, -hdr_len));
-            cne_prefetch0(pktmbuf_mtod_offset(pkts[6], void *, -hdr_len));
-            cne_prefetch0(pktmbuf_mtod_offset(pkts[7], void *, -hdr_len));
-        }
+        next0 = nxt[0];
+        next1 = nxt[1];
+        next2 = nxt[2];
+        next3 = nxt[3];
 
-        mbuf0 = pkts[0];
-        mbuf1 = pkts[1];
-        mbuf2 = pkts[2];
-        mbuf3 = pkts[3];
-
-        pkts += 4;
+        nxt += 4;
         n_left_from -= 4;
 
-        next0 = ip4_output_header(node, mbuf0, IP4_OUTPUT_NEXT_PKT_DROP);
-        next1 = ip4_output_header(node, mbuf1, IP4_OUTPUT_NEXT_PKT_DROP);
-        next2 = ip4_output_header(node, mbuf2, IP4_OUTPUT_NEXT_PKT_DROP);
-        next3 = ip4_output_header(node, mbuf3, IP4_OUTPUT_NEXT_PKT_DROP);
-
         /* Enqueue four to next node */
         cne_edge_t fix_spec = (next_index ^ next0) | (next_index ^ next1) | (next_index ^ next2) |
                               (next_index ^ next3);
@@ -233,13 +250,11 @@ ip4_output_node_process(struct cne_graph *graph, struct cne_node *node, void **o
     }
 
     while (n_left_from > 0) {
-        mbuf0 = pkts[0];
+        next0 = nxt[0];
 
-        pkts += 1;
+        nxt += 1;
         n_left_from -= 1;
 
-        next0 = ip4_output_header(node, mbuf0, IP4_OUTPUT_NEXT_PKT_DROP);
-
         if (unlikely(next_index ^ next0)) {
             /* Copy things successfully speculated till now */
             memcpy(to_next, from, last_spec * sizeof(from[0]));
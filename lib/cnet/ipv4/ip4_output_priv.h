@@ -20,6 +20,8 @@
 extern "C" {
 #endif
 
+#define IP4_OUTPUT_BULK_SIZE 64 /**< Packets per bulk route and ARP lookup */
+
 /**
  * IP4 output next nodes.
  */
@@ -6,9 +6,9 @@
 #include <endian.h>          // for htobe16
 #include <mempool.h>         // for mempool_destroy, mempool_get, mem...
 #ifdef CNE_MACHINE_CPUFLAG_SSE4_2
-#include <cne_hash_crc.h>        // for cne_hash_crc
+#include <cne_crc.h>        // for cne_crc32c
 
-#define DEFAULT_HASH_FUNC cne_hash_crc
+#define DEFAULT_HASH_FUNC cne_crc32c
 #else
 #include <cne_jhash.h>
 
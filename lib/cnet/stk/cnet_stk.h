@@ -73,6 +73,8 @@ CNE_DECLARE_PER_THREAD(stk_t *, stk);
 /* Flags values for stk_entry.gflags */
 enum {
     TCP_TIMEOUT_ENABLED    = 0x00000001, /**< Enable TCP Timeouts */
+    TCP_RACK_TLP_ENABLED   = 0x00000002, /**< Enable TCP RACK-TLP loss detection */
+    TCP_PACING_ENABLED     = 0x00000004, /**< Enable TCP send pacing */
     RFC1323_TSTAMP_ENABLED = 0x00004000, /**< Enable RFC1323 Timestamp */
     RFC1323_SCALE_ENABLED  = 0x00008000, /**< Enable RFC1323 window scaling */
 };
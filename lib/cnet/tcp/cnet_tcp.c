@@ -46,12 +46,13 @@
 #include <cnet_ip_common.h>        // for ip_info
 #include <cnet_meta.h>             // for cnet_metadata
 #include <cnet_tcp_chnl.h>         // for cnet_drop_acked_data, cnet_tcp_chnl_scal...
-#include <endian.h>                // for be16toh, htobe32, htobe16, be32toh
+#include <endian.h>                // for be16toh, htobe32, htobe16, le64toh
 #include <errno.h>                 // for errno, ECONNREFUSED, ECONNRESET, ETIMEDOUT
 #include <netinet/in.h>            // for ntohs, IPPROTO_TCP, IN_CLASSD, ntohl
 #include <pthread.h>               // for pthread_cond_signal, pthread_cond_wait
 #include <stdlib.h>                // for free, calloc, rand
 #include <string.h>                // for strcat, memcpy, memset
+#include <sys/random.h>            // for getrandom
 #include "../chnl/chnl_priv.h"
 #include <cnet_chnl.h>
 
@@ -72,6 +73,12 @@
 #include <tcp_input_priv.h>
 #include <tcp_output_priv.h>
 #include <cne_mutex_helper.h>
+#include <cne_jhash.h>
+#include <cne_trace.h>
+#include <dsa_copy.h>        // for dsa_copy, dsa_copy_wait, dsa_copy_t
+
+CNE_TRACE_POINT_DEFINE(tcp_trace_state, "cnet.tcp_state", "tcb,old_state,new_state");
+CNE_TRACE_POINT_DEFINE(tcp_trace_timer, "cnet.tcp_timer", "tcb,timer,state");
 
 /* static TCP backoff shift values */
 static int32_t tcp_syn_backoff[TCP_MAXRXTSHIFT + 1] = {1, 1, 1, 1, 1, 2, 4, 8, 16, 32, 64, 64, 64};
@@ -84,6 +91,7 @@ static int tcb_cleanup(struct tcb_entry *tcb);
 static void tcp_update_acked_data(struct seg_entry *seg, struct tcb_entry *tcb);
 static int32_t tcp_send_options(struct tcb_entry *tcb, uint8_t *sp, uint8_t flags_n);
 static int tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp);
+static int tcp_output(struct tcb_entry *tcb);
 
 const char *tcb_in_states[] = TCP_INPUT_STATES;
 
@@ -327,6 +335,7 @@ cnet_tcb_new(struct pcb_entry *pcb)
 
     TAILQ_INIT(&tcb->backlog_q.head);
     TAILQ_INIT(&tcb->half_open_q.head);
+    cne_timer_init(&tcb->rack.timer);
 
     /* Enable RFC1323 (TCP Extensions for High Performance), if requested. */
     tcb->tflags = (stk->gflags & RFC1323_SCALE_ENABLED) != 0 ? TCBF_REQ_SCALE : 0;
@@ -500,6 +509,16 @@ tcp_send_segment(struct tcb_entry *tcb, struct seg_entry *seg)
         md->laddr.cin_addr.s_addr = ch->ch_pcb->key.laddr.cin_addr.s_addr;
     }
 
+#if CNET_TCP_FAULT_INJECT_ENABLED
+    /* Tail drop injection to test the loss recovery, the segment is treated as sent */
+    if (unlikely(stk->tcp->tail_drop) && seg->len && is_set(seg->flags, TCP_PSH) &&
+        (++stk->tcp->tail_cnt % stk->tcp->tail_drop) == 0) {
+        INC_TCP_STAT(tail_drop);
+        pktmbuf_free(mbuf);
+        return 0;
+    }
+#endif
+
     if (unlikely(stk->tcp_tx_node == NULL)) {
         stk->tcp_tx_node = cne_graph_get_node_by_name(stk->graph, TCP_OUTPUT_NODE_NAME);
         if (!stk->tcp_tx_node)
@@ -532,17 +551,14 @@ tcp_set_persist(struct tcb_entry *tcb)
         tcb->rxtshift++;
 }
 
-/* skip to the offset in the list and copy the data to the buffer. */
-static int
-tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
+/* skip to the offset in the list and copy the data to the buffer, large copies go to dc. */
+static uint32_t
+tcp_mbuf_copysegs(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf, dsa_copy_t *dc)
 {
     pktmbuf_t *m;
     uint32_t total = 0, cnt;
     int i          = 0;
 
-    if (!stk_lock())
-        CNE_ERR_RET("Failed to acquire mutex\n");
-
     m = vec_at_index(cb->cb_vec, i++);
 
     /* skip to the offset location */
@@ -559,7 +575,8 @@ tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
     while (m && len > 0) {
         cnt = CNE_MIN(pktmbuf_data_len(m) - off, (uint32_t)len);
 
-        memcpy(buf, pktmbuf_mtod_offset(m, char *, off), cnt);
+        if (!dc || dsa_copy(dc, buf, pktmbuf_mtod_offset(m, char *, off), cnt, NULL, NULL) < 0)
+            memcpy(buf, pktmbuf_mtod_offset(m, char *, off), cnt);
 
         total += cnt;
         len -= cnt;
@@ -568,10 +585,803 @@ tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
         m   = vec_at_index(cb->cb_vec, i++);
     }
 
+    return total;
+}
+
+static int
+tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
+{
+    dsa_copy_t *dc = this_stk->tcp->dcopy;
+    uint32_t total;
+
+    if (!stk_lock())
+        CNE_ERR_RET("Failed to acquire mutex\n");
+
+    total = tcp_mbuf_copysegs(cb, off, len, buf, dc);
+
+    /* The mbufs can be freed by an ACK once unlocked, finish the queued copies first */
+    if (dc && dsa_copy_wait(dc) != 0)
+        total = tcp_mbuf_copysegs(cb, off, len, buf, NULL);
+
     stk_unlock();
     return total;
 }
 
+/*
+ * TCP Fast Open (RFC7413) support routines.
+ *
+ * The server cookie is a MAC of the client address keyed with a per stack secret,
+ * which means the server does not need to keep any state for a cookie. The MAC is
+ * SipHash-2-4 with a 128 bit key from getrandom(), a client can not compute the
+ * cookie of another address from its own cookies. The client keeps a small direct
+ * mapped cache of cookies indexed by server address.
+ */
+static inline const void *
+tcp_tfo_addr(struct in_caddr *addr, uint32_t *len)
+{
+    if (CIN_FAMILY(addr) == AF_INET6) {
+        *len = sizeof(struct in6_addr);
+        return &addr->cin6_addr;
+    }
+    *len = sizeof(struct in_addr);
+    return &addr->cin_addr;
+}
+
+#define SIP_ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIP_ROUND(v0, v1, v2, v3) \
+    do {                          \
+        v0 += v1;                 \
+        v1 = SIP_ROTL(v1, 13);    \
+        v1 ^= v0;                 \
+        v0 = SIP_ROTL(v0, 32);    \
+        v2 += v3;                 \
+        v3 = SIP_ROTL(v3, 16);    \
+        v3 ^= v2;                 \
+        v0 += v3;                 \
+        v3 = SIP_ROTL(v3, 21);    \
+        v3 ^= v0;                 \
+        v2 += v1;                 \
+        v1 = SIP_ROTL(v1, 17);    \
+        v1 ^= v2;                 \
+        v2 = SIP_ROTL(v2, 32);    \
+    } while (0)
+
+/* SipHash-2-4 of a buffer with a 128 bit key */
+static uint64_t
+tcp_siphash(const uint64_t key[2], const uint8_t *data, uint32_t len)
+{
+    uint64_t v0 = key[0] ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = key[1] ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = key[0] ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = key[1] ^ 0x7465646279746573ULL;
+    uint64_t b  = (uint64_t)len << 56;
+    uint64_t m;
+
+    for (; len >= sizeof(m); len -= sizeof(m), data += sizeof(m)) {
+        memcpy(&m, data, sizeof(m));
+        m = le64toh(m);
+        v3 ^= m;
+        SIP_ROUND(v0, v1, v2, v3);
+        SIP_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+    for (uint32_t i = 0; i < len; i++)
+        b |= (uint64_t)data[i] << (8 * i);
+
+    v3 ^= b;
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xff;
+    for (int i = 0; i < 4; i++)
+        SIP_ROUND(v0, v1, v2, v3);
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+static void
+tcp_tfo_cookie_gen(struct tcp_entry *tcp, struct in_caddr *faddr, uint8_t *cookie)
+{
+    const void *key;
+    uint32_t len;
+    uint64_t mac;
+
+    key = tcp_tfo_addr(faddr, &len);
+    mac = tcp_siphash(tcp->tfo_key, key, len);
+
+    memcpy(cookie, &mac, sizeof(mac));
+}
+
+static struct tcp_tfo_cache *
+tcp_tfo_cache_entry(struct tcp_entry *tcp, struct in_caddr *faddr)
+{
+    const void *key;
+    uint32_t len;
+
+    key = tcp_tfo_addr(faddr, &len);
+
+    return &tcp->tfo_cache[cne_jhash(key, len, 0) & (TCP_TFO_CACHE_SIZE - 1)];
+}
+
+static struct tcp_tfo_cache *
+tcp_tfo_cache_lookup(struct tcp_entry *tcp, struct in_caddr *faddr)
+{
+    struct tcp_tfo_cache *tc = tcp_tfo_cache_entry(tcp, faddr);
+    const void *a, *b;
+    uint32_t alen, blen;
+
+    if (tc->len == 0 || CIN_FAMILY(&tc->faddr) != CIN_FAMILY(faddr))
+        return NULL;
+
+    a = tcp_tfo_addr(&tc->faddr, &alen);
+    b = tcp_tfo_addr(faddr, &blen);
+
+    return (memcmp(a, b, alen) == 0) ? tc : NULL;
+}
+
+/*
+ * Client side, save the cookie returned in the SYN-ACK from the server.
+ */
+static void
+tcp_tfo_cache_update(struct tcb_entry *tcb, struct seg_entry *seg)
+{
+    struct tcp_tfo_cache *tc;
+
+    if (is_clr(seg->sflags, SEG_TFO_PRESENT) || seg->tfo_len == 0)
+        return;
+
+    tc = tcp_tfo_cache_entry(tcb->tcp, &tcb->pcb->key.faddr);
+
+    in_caddr_copy(&tc->faddr, &tcb->pcb->key.faddr);
+    tc->mss = is_set(seg->sflags, SEG_MSS_PRESENT) ? seg->mss : 0;
+    tc->len = seg->tfo_len;
+    memcpy(tc->cookie, seg->tfo_cookie, tc->len);
+}
+
+/*
+ * Server side, validate the cookie in a SYN segment. An empty cookie is a request
+ * for a new cookie and an invalid cookie also gets a new cookie, but the data in
+ * the SYN is only accepted when the cookie is valid.
+ */
+static void
+tcp_tfo_passive_open(struct tcb_entry *tcb, struct seg_entry *seg)
+{
+    uint8_t cookie[TCP_TFO_COOKIE_LEN];
+
+    if (seg->tfo_len == 0) {
+        INC_TCP_STAT(tfo_cookie_req);
+        tcb->tflags |= TCBF_TFO_COOKIE_REQ;
+        return;
+    }
+
+    tcp_tfo_cookie_gen(tcb->tcp, &tcb->pcb->key.faddr, cookie);
+
+    if ((seg->tfo_len != TCP_TFO_COOKIE_LEN) || memcmp(cookie, seg->tfo_cookie, sizeof(cookie))) {
+        INC_TCP_STAT(tfo_bad_cookie);
+        tcb->tflags |= TCBF_TFO_COOKIE_REQ;
+        return;
+    }
+
+    if (pktmbuf_data_len(seg->mbuf))
+        tcb->tflags |= TCBF_TFO_SYN_DATA;
+}
+
+/*
+ * Server side, accept the data in a SYN with a valid cookie. The SYN-ACK is sent
+ * now to ACK the data and the data is handed to the new channel, which is marked
+ * connected to allow the application to respond before the handshake completes.
+ */
+static int
+tcp_tfo_syn_data(struct seg_entry *seg, struct tcb_entry *tcb)
+{
+    pktmbuf_t *mbuf = seg->mbuf;
+
+    tcb->rcv_nxt += pktmbuf_data_len(mbuf);
+    tcb->rcv_adv = tcb->rcv_nxt;
+
+    chnl_state_set(tcb->pcb->ch, _ISCONNECTED);
+
+    mbuf->userptr = tcb->pcb;
+    seg->mbuf     = NULL; /* Consumed the packet */
+
+    INC_TCP_STAT(tfo_syn_data);
+
+    cnet_tcp_output(tcb);
+
+    return TCP_INPUT_NEXT_CHNL_RECV;
+}
+
+/*
+ * Client side, drop the part of the SYN data acked by the SYN-ACK and pull back
+ * snd_nxt to resend any data the server did not accept.
+ */
+static void
+tcp_tfo_syn_acked(struct tcb_entry *tcb, struct chnl *ch)
+{
+    uint32_t acked = tcb->snd_una - (tcb->snd_iss + 1);
+
+    acked = CNE_MIN(acked, ch->ch_snd.cb_cc);
+    if (acked)
+        cnet_drop_acked_data(&ch->ch_snd, acked);
+
+    tcb->snd_nxt = tcb->snd_una;
+    tcb->tflags &= ~TCBF_TFO_SYN_DATA;
+}
+
+/*
+ * Add the TCP Fast Open option padded to a 4 byte boundary. The server returns
+ * a cookie in the SYN-ACK, the client sends a cached cookie or an empty cookie
+ * to request one.
+ */
+static int32_t
+tcp_tfo_options(struct tcb_entry *tcb, uint8_t *p, uint8_t flags_n)
+{
+    struct tcp_tfo_cache *tc;
+    int32_t len;
+
+    p[0] = TCP_OPT_FASTOPEN;
+    p[1] = TCP_OPT_FASTOPEN_HDRSZ;
+
+    if (is_set(flags_n, TCP_ACK)) {
+        tcp_tfo_cookie_gen(tcb->tcp, &tcb->pcb->key.faddr, &p[2]);
+        p[1] += TCP_TFO_COOKIE_LEN;
+    } else if ((tc = tcp_tfo_cache_lookup(tcb->tcp, &tcb->pcb->key.faddr)) != NULL) {
+        memcpy(&p[2], tc->cookie, tc->len);
+        p[1] += tc->len;
+    }
+
+    for (len = p[1]; len & 3; len++)
+        p[len] = TCP_OPT_NOP;
+
+    return len;
+}
+
+/* Convert milli-seconds to timer cycles used for the RACK-TLP times */
+static inline uint64_t
+tcp_rack_ms(uint64_t ms)
+{
+    return (cne_get_timer_hz() / 1000) * ms;
+}
+
+#define RACK_SEG(_r, _i) (&(_r)->segs[(_i) & (TCP_RACK_LOG_SIZE - 1)])
+
+/* RFC8985 RACK_sent_after() is segment (t1, seq1) sent after segment (t2, seq2) */
+static inline bool
+tcp_rack_sent_after(uint64_t t1, seq_t seq1, uint64_t t2, seq_t seq2)
+{
+    return (t1 > t2) || ((t1 == t2) && seqGT(seq1, seq2));
+}
+
+static void tcp_rack_timeout(struct cne_timer *tim, void *arg);
+
+static void
+tcp_rack_timer_set(struct tcb_entry *tcb, uint8_t type, uint64_t cycles)
+{
+    struct tcp_rack *rack = &tcb->rack;
+
+    rack->timer_type = type;
+    if (cne_timer_reset(&rack->timer, cycles, SINGLE, cne_id(), tcp_rack_timeout, tcb) < 0) {
+        rack->timer_type = RACK_TIMER_NONE;
+        CNE_ERR("Failed to start RACK timer\n");
+    }
+}
+
+static void
+tcp_rack_timer_stop(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+
+    if (rack->timer_type != RACK_TIMER_NONE) {
+        rack->timer_type = RACK_TIMER_NONE;
+        cne_timer_stop(&rack->timer);
+    }
+}
+
+/*
+ * Record the transmit time of a data segment, a retransmission updates the
+ * time of the logged segments it covers.
+ */
+static void
+tcp_rack_sent(struct tcb_entry *tcb, seq_t seq, int32_t len, bool rexmt)
+{
+    struct tcp_rack *rack = &tcb->rack;
+    struct tcp_rack_seg *rs;
+    uint64_t now = cne_rdtsc();
+    seq_t end    = seq + len;
+
+    if (is_clr(this_stk->gflags, TCP_RACK_TLP_ENABLED) || len <= 0)
+        return;
+
+    if (rexmt) {
+        for (uint32_t i = rack->head; i != rack->tail; i++) {
+            rs = RACK_SEG(rack, i);
+
+            if (seqGEQ(rs->start, end))
+                break;
+            if (seqGT(rs->end, seq)) {
+                rs->xmit_ts = now;
+                rs->flags   = (rs->flags | RACK_SEG_RETRANS) & ~RACK_SEG_LOST;
+            }
+        }
+        return;
+    }
+
+    /* When the log is full the segment is only covered by the retransmit timer */
+    if ((rack->tail - rack->head) < TCP_RACK_LOG_SIZE) {
+        rs          = RACK_SEG(rack, rack->tail++);
+        rs->start   = seq;
+        rs->end     = end;
+        rs->xmit_ts = now;
+        rs->flags   = 0;
+    }
+    rack->tlp_arm = true;
+}
+
+/*
+ * RFC8985 6.2 step 2, update the RACK state from a delivered segment.
+ */
+static void
+tcp_rack_update(struct tcp_rack *rack, struct tcp_rack_seg *rs, uint64_t now)
+{
+    uint64_t rtt = now - rs->xmit_ts;
+
+    /* Ignore an ACK which is most likely for the original transmission */
+    if (is_set(rs->flags, RACK_SEG_RETRANS) && rack->min_rtt && (rtt < rack->min_rtt))
+        return;
+
+    if (rack->min_rtt == 0 || rtt < rack->min_rtt)
+        rack->min_rtt = rtt;
+
+    /* Same smoothing as the srtt of the TCB, scaled by 8 */
+    if (rack->srtt == 0)
+        rack->srtt = rtt << TCP_RTT_SHIFT;
+    else
+        rack->srtt += rtt - (rack->srtt >> TCP_RTT_SHIFT);
+
+    if (tcp_rack_sent_after(rs->xmit_ts, rs->end, rack->xmit_ts, rack->end_seq)) {
+        rack->rtt     = rtt;
+        rack->xmit_ts = rs->xmit_ts;
+        rack->end_seq = rs->end;
+    }
+}
+
+/*
+ * RFC8985 6.2 step 5, mark the segments sent before the most recently delivered
+ * segment as lost when the reordering window has passed. Returns the number of
+ * cycles until the next segment can be marked lost or zero.
+ */
+static uint64_t
+tcp_rack_detect_loss(struct tcb_entry *tcb, uint64_t now, int *lost)
+{
+    struct tcp_rack *rack = &tcb->rack;
+    uint64_t reo_wnd = 0, timeout = 0;
+
+    /* Without SACK reordering can not be measured, use min_rtt/4 until DupThresh */
+    if (tcb->dupacks < TCP_RETRANSMIT_THRESHOLD)
+        reo_wnd = CNE_MIN(rack->min_rtt / 4, rack->srtt >> TCP_RTT_SHIFT);
+
+    for (uint32_t i = rack->head; i != rack->tail; i++) {
+        struct tcp_rack_seg *rs = RACK_SEG(rack, i);
+        uint64_t elapsed;
+
+        if (is_set(rs->flags, RACK_SEG_DELIVERED | RACK_SEG_LOST))
+            continue;
+        if (!tcp_rack_sent_after(rack->xmit_ts, rack->end_seq, rs->xmit_ts, rs->end))
+            continue;
+
+        elapsed = now - rs->xmit_ts;
+        if (elapsed >= (rack->rtt + reo_wnd)) {
+            rs->flags |= RACK_SEG_LOST;
+            (*lost)++;
+            INC_TCP_STAT(rack_lost);
+        } else
+            timeout = CNE_MAX(timeout, rack->rtt + reo_wnd - elapsed);
+    }
+
+    return timeout;
+}
+
+/* Reduce the congestion window the same way as the duplicate ACK recovery */
+static void
+tcp_rack_cwnd_reduce(struct tcb_entry *tcb)
+{
+    uint32_t win = CNE_MIN(tcb->snd_wnd, tcb->snd_cwnd) / 2 / tcb->max_mss;
+
+    if (win < 2)
+        win = 2;
+    tcb->snd_ssthresh = win * tcb->max_mss;
+    tcb->snd_cwnd     = tcb->snd_ssthresh;
+}
+
+/*
+ * Retransmit the segments marked lost, snd_nxt and the congestion window are
+ * moved to send only the lost segment and are restored afterwards.
+ */
+static void
+tcp_rack_retransmit(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+    seq_t onxt            = tcb->snd_nxt;
+    uint32_t cwnd         = tcb->snd_cwnd;
+
+    for (uint32_t i = rack->head; i != rack->tail; i++) {
+        struct tcp_rack_seg *rs = RACK_SEG(rack, i);
+
+        if (is_clr(rs->flags, RACK_SEG_LOST))
+            continue;
+        if (tcb->snd_wnd < (rs->end - tcb->snd_una))
+            break;
+
+        tcb->snd_nxt  = rs->start;
+        tcb->snd_cwnd = rs->end - tcb->snd_una;
+        tcb->rtt      = 0;
+        tcb->total_retrans++;
+
+        tcp_output(tcb);
+    }
+
+    tcb->snd_cwnd = cwnd;
+    if (seqGT(onxt, tcb->snd_nxt))
+        tcb->snd_nxt = onxt;
+}
+
+/*
+ * RFC8985 7.2 arm the loss probe timer when new data is in flight.
+ */
+static void
+tcp_rack_tlp_arm(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+    uint64_t pto, rto;
+
+    rack->tlp_arm = false;
+
+    if (rack->tlp_inflight || rack->in_recovery || (rack->timer_type == RACK_TIMER_REO) ||
+        (tcb->state < TCPS_ESTABLISHED) || (tcb->snd_una == tcb->snd_max))
+        return;
+
+    if (rack->srtt) {
+        pto = (rack->srtt >> TCP_RTT_SHIFT) * 2;
+
+        /* A single segment in flight can be held by the delayed ACK of the peer */
+        if ((tcb->snd_max - tcb->snd_una) <= tcb->max_mss)
+            pto += tcp_rack_ms(TCP_RACK_WCDELACK_MS);
+        pto = CNE_MAX(pto, tcp_rack_ms(TCP_RACK_MIN_PTO_MS));
+    } else
+        pto = tcp_rack_ms(MS_PER_S);
+
+    rto = tcp_rack_ms((uint64_t)tcb->rxtcur * TCP_SLOW_TIMEOUT_MS);
+
+    tcp_rack_timer_set(tcb, RACK_TIMER_TLP, CNE_MIN(pto, rto));
+}
+
+/*
+ * Detect and retransmit the lost segments, then arm the reordering timer if a
+ * segment may still be marked lost or the loss probe timer.
+ */
+static void
+tcp_rack_recover(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+    uint64_t timeout;
+    int lost = 0;
+
+    timeout = tcp_rack_detect_loss(tcb, cne_rdtsc(), &lost);
+
+    if (lost) {
+        if (!rack->in_recovery) {
+            rack->in_recovery  = true;
+            rack->recovery_end = tcb->snd_max;
+            tcp_rack_cwnd_reduce(tcb);
+        }
+        tcp_rack_retransmit(tcb);
+    }
+
+    if (timeout)
+        tcp_rack_timer_set(tcb, RACK_TIMER_REO, timeout);
+    else {
+        tcp_rack_timer_stop(tcb);
+        tcp_rack_tlp_arm(tcb);
+    }
+}
+
+/*
+ * RFC8985 7.3 send a loss probe, new data if the window allows or the last
+ * segment sent.
+ */
+static void
+tcp_rack_probe(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+    struct chnl *ch       = tcb->pcb->ch;
+    uint32_t flight       = tcb->snd_max - tcb->snd_una;
+    uint32_t cwnd         = tcb->snd_cwnd;
+    seq_t onxt            = tcb->snd_nxt;
+
+    if (!flight || rack->tlp_inflight)
+        return;
+
+    INC_TCP_STAT(tlp_probe);
+    rack->tlp_inflight = true;
+
+    if ((ch->ch_snd.cb_cc > flight) && (tcb->snd_wnd > flight)) {
+        rack->tlp_rexmit = false;
+        tcb->snd_nxt     = tcb->snd_max;
+        tcb->snd_cwnd    = flight + tcb->max_mss;
+        tcb->tflags |= TCBF_NAGLE_CREDIT;
+    } else {
+        seq_t start = tcb->snd_una;
+
+        if (rack->head != rack->tail)
+            start = RACK_SEG(rack, rack->tail - 1)->start;
+        else if (flight > tcb->max_mss)
+            start = tcb->snd_max - tcb->max_mss;
+
+        rack->tlp_rexmit = true;
+        tcb->snd_nxt     = start;
+        tcb->snd_cwnd    = flight;
+        tcb->rtt         = 0;
+        tcb->total_retrans++;
+    }
+
+    tcp_output(tcb);
+
+    rack->tlp_end_seq = tcb->snd_max;
+    tcb->snd_cwnd     = cwnd;
+    if (seqGT(onxt, tcb->snd_nxt))
+        tcb->snd_nxt = onxt;
+}
+
+static void
+tcp_rack_timeout(struct cne_timer *tim __cne_unused, void *arg)
+{
+    struct tcb_entry *tcb = arg;
+    uint8_t type          = tcb->rack.timer_type;
+
+    tcb->rack.timer_type = RACK_TIMER_NONE;
+
+    if (!tcb->pcb || !tcb->pcb->ch || (tcb->state < TCPS_ESTABLISHED))
+        return;
+
+    if (type == RACK_TIMER_REO) {
+        INC_TCP_STAT(rack_timeout);
+        tcp_rack_recover(tcb);
+    } else if (type == RACK_TIMER_TLP)
+        tcp_rack_probe(tcb);
+}
+
+/*
+ * A duplicate ACK without SACK reports one more segment beyond snd_una was
+ * delivered, credit the oldest segment not yet delivered and look for losses.
+ */
+static void
+tcp_rack_dupack(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+
+    if (is_clr(this_stk->gflags, TCP_RACK_TLP_ENABLED) || (rack->head == rack->tail))
+        return;
+
+    for (uint32_t i = rack->head + 1; i != rack->tail; i++) {
+        struct tcp_rack_seg *rs = RACK_SEG(rack, i);
+
+        if (is_clr(rs->flags, RACK_SEG_DELIVERED)) {
+            rs->flags |= RACK_SEG_DELIVERED;
+            tcp_rack_update(rack, rs, cne_rdtsc());
+            break;
+        }
+    }
+
+    tcp_rack_recover(tcb);
+}
+
+/*
+ * Remove the cumulatively acked segments from the log, finish a loss probe or
+ * recovery episode and look for losses in the remaining segments.
+ */
+static void
+tcp_rack_ack(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+    uint64_t now;
+
+    if (is_clr(this_stk->gflags, TCP_RACK_TLP_ENABLED)) {
+        rack->head         = rack->tail;
+        rack->in_recovery  = false;
+        rack->tlp_inflight = false;
+        return;
+    }
+
+    now = cne_rdtsc();
+    while (rack->head != rack->tail) {
+        struct tcp_rack_seg *rs = RACK_SEG(rack, rack->head);
+
+        if (seqGT(rs->end, tcb->snd_una))
+            break;
+        if (is_clr(rs->flags, RACK_SEG_DELIVERED))
+            tcp_rack_update(rack, rs, now);
+        rack->head++;
+    }
+
+    /*
+     * RFC8985 7.4 without DSACK the sender can not tell if the probe repaired a
+     * loss, assume it did and reduce the congestion window.
+     */
+    if (rack->tlp_inflight && seqGEQ(tcb->snd_una, rack->tlp_end_seq)) {
+        rack->tlp_inflight = false;
+        if (rack->tlp_rexmit) {
+            INC_TCP_STAT(tlp_recovered);
+            tcp_rack_cwnd_reduce(tcb);
+        }
+    }
+
+    if (rack->in_recovery && seqGEQ(tcb->snd_una, rack->recovery_end))
+        rack->in_recovery = false;
+
+    tcp_rack_recover(tcb);
+}
+
+/*
+ * The retransmit timer has expired and all outstanding data will be sent again,
+ * forget the RACK-TLP state of the segments.
+ */
+static void
+tcp_rack_rto(struct tcb_entry *tcb)
+{
+    struct tcp_rack *rack = &tcb->rack;
+
+    tcp_rack_timer_stop(tcb);
+
+    for (uint32_t i = rack->head; i != rack->tail; i++)
+        RACK_SEG(rack, i)->flags &= ~(RACK_SEG_DELIVERED | RACK_SEG_LOST);
+
+    rack->in_recovery  = false;
+    rack->tlp_inflight = false;
+}
+
+/*
+ * Pacing spreads the new data of a connection over the round trip time instead
+ * of sending up to cwnd back to back. TCBs waiting for their next send time are
+ * placed on a per stack timer wheel, the wheel timer only runs while TCBs are
+ * waiting and calls tcp_output() again when the slot of a TCB is reached.
+ */
+static void tcp_pace_timeout(struct cne_timer *tim, void *arg);
+
+/* Pacing rate in bytes per second from cwnd/srtt, zero if no RTT sample exists yet */
+static uint64_t
+tcp_pace_rate(struct tcb_entry *tcb)
+{
+    uint64_t srtt = tcb->pace_srtt >> TCP_RTT_SHIFT;
+    uint64_t rate, ratio;
+
+    if (srtt == 0)
+        return tcb->max_pacing_rate;
+
+    ratio = (tcb->snd_cwnd < tcb->snd_ssthresh) ? TCP_PACE_SS_RATIO : TCP_PACE_CA_RATIO;
+    rate  = (((uint64_t)tcb->snd_cwnd * cne_get_timer_hz()) / srtt) * ratio / 100;
+
+    if (tcb->max_pacing_rate && rate > tcb->max_pacing_rate)
+        rate = tcb->max_pacing_rate;
+
+    return rate;
+}
+
+/* Move the next send time of the TCB past the data just sent */
+static void
+tcp_pace_sent(struct tcb_entry *tcb, int32_t len, uint64_t now)
+{
+    tcb->pacing_rate = tcp_pace_rate(tcb);
+    if (tcb->pacing_rate == 0) {
+        tcb->pace_next = 0;
+        return;
+    }
+
+    tcb->pace_next =
+        CNE_MAX(tcb->pace_next, now) + ((uint64_t)len * cne_get_timer_hz()) / tcb->pacing_rate;
+    INC_TCP_STAT(paced);
+}
+
+static void
+tcp_pace_insert(struct tcp_pacer *pacer, struct tcb_entry *tcb)
+{
+    uint64_t slot = 0;
+
+    if (tcb->pace_next > pacer->slot_tsc)
+        slot = (tcb->pace_next - pacer->slot_tsc) / pacer->slot_cycles;
+
+    /* Never use the slot being processed, far away TCBs are inserted again later */
+    if (slot > (TCP_PACE_SLOTS - 2))
+        slot = TCP_PACE_SLOTS - 2;
+
+    tcb->pace_slot   = (pacer->cur + slot) & (TCP_PACE_SLOTS - 1);
+    tcb->pace_queued = true;
+    TAILQ_INSERT_TAIL(&pacer->slots[tcb->pace_slot], tcb, pace_entry);
+}
+
+/* Place the TCB on the pacing wheel, returns -1 if the wheel timer can not be started */
+static int
+tcp_pace_schedule(struct tcb_entry *tcb)
+{
+    struct tcp_pacer *pacer = &tcb->tcp->pacer;
+
+    if (tcb->pace_queued)
+        return 0;
+
+    if (!pacer->active) {
+        pacer->slot_tsc = cne_rdtsc();
+        if (cne_timer_reset(&pacer->timer, pacer->slot_cycles, PERIODICAL, cne_id(),
+                            tcp_pace_timeout, pacer) < 0)
+            CNE_ERR_RET("Failed to start TCP pacing timer\n");
+        pacer->active = true;
+    }
+
+    tcp_pace_insert(pacer, tcb);
+    pacer->cnt++;
+
+    return 0;
+}
+
+static void
+tcp_pace_remove(struct tcb_entry *tcb)
+{
+    struct tcp_pacer *pacer = &tcb->tcp->pacer;
+
+    if (tcb->pace_queued) {
+        TAILQ_REMOVE(&pacer->slots[tcb->pace_slot], tcb, pace_entry);
+        tcb->pace_queued = false;
+        pacer->cnt--;
+    }
+}
+
+/*
+ * Wheel timer callback, release the TCBs of each slot that has passed. A TCB
+ * found in a slot before its send time, after a full turn of the wheel, is
+ * inserted again.
+ */
+static void
+tcp_pace_timeout(struct cne_timer *tim __cne_unused, void *arg)
+{
+    struct tcp_pacer *pacer = arg;
+    uint64_t now            = cne_rdtsc();
+    struct tcb_entry *tcb;
+
+    /* When behind by more than a full turn every slot is due, visit each once */
+    if ((now - pacer->slot_tsc) / pacer->slot_cycles > TCP_PACE_SLOTS)
+        pacer->slot_tsc = now - (TCP_PACE_SLOTS * pacer->slot_cycles);
+
+    while (pacer->cnt && (pacer->slot_tsc + pacer->slot_cycles) <= now) {
+        uint32_t cur = pacer->cur;
+
+        pacer->cur = (cur + 1) & (TCP_PACE_SLOTS - 1);
+        pacer->slot_tsc += pacer->slot_cycles;
+
+        while ((tcb = TAILQ_FIRST(&pacer->slots[cur])) != NULL) {
+            tcp_pace_remove(tcb);
+
+            if (tcb->pace_next > now)
+                tcp_pace_schedule(tcb);
+            else
+                cnet_tcp_output(tcb);
+        }
+    }
+
+    if (pacer->cnt == 0) {
+        pacer->active = false;
+        cne_timer_stop(&pacer->timer);
+    }
+}
+
+/* Count the data segments sent by one tcp_output() call in buckets 1, 2, 3-4, 5-8, ... */
+static inline void
+tcp_pace_burst(int nsent)
+{
+    int idx = (nsent <= 1) ? 0 : (32 - __builtin_clz(nsent - 1));
+
+    this_stk->tcp_stats->S_burst[CNE_MIN(idx, TCP_PACE_BURST_BUCKETS - 1)]++;
+}
+
 /*
  * Determine if a segment of data or just a TCP header needs to be sent via
  * the tcb_send_segment routine.
@@ -581,6 +1391,7 @@ tcp_output(struct tcb_entry *tcb)
 {
     struct chnl *ch;
     bool idle, sendalot;
+    int nsent = 0;
 
     if (!tcb)
         CNE_ERR_RET("TCB pointer is NULL\n");
@@ -629,6 +1440,9 @@ tcp_output(struct tcb_entry *tcb)
         uint32_t win;
         seq_t prev_rcv_adv;
         int iphdr_len;
+        bool tfo_data = false;
+        bool pace;
+        uint64_t now;
 
         /* Send a packet we must clear the segment structure each time */
         memset(seg, 0, sizeof(struct seg_entry));
@@ -679,10 +1493,25 @@ tcp_output(struct tcb_entry *tcb)
                       ch->ch_snd.cb_cc, win, off, len, vec_len(ch->ch_snd.cb_vec));
 
             if (is_set(seg->flags, TCP_SYN)) {
+                if ((tcb->state == TCPS_SYN_RCVD) && is_set(tcb->tflags, TCBF_TFO_SYN_DATA) &&
+                    seqGT(tcb->snd_nxt, tcb->snd_una)) {
+                    /*
+                     * TCP Fast Open server has sent the SYN-ACK, send the response
+                     * data without the SYN and skip over the sequence number of the SYN.
+                     */
+                    seg->flags &= ~TCP_SYN;
+                    off--;
+                    len++;
+                    tfo_data = (len > 0);
+                } else {
+                    /* Only the first TCP Fast Open SYN with a cached cookie carries data */
+                    if (is_clr(tcb->tflags, TCBF_TFO_SYN_DATA) || is_set(seg->flags, TCP_ACK) ||
+                        tcb->rxtshift)
+                        len = 0;
 
-                /* make sure we do not send a SYN with a FIN bit. */
-                len = 0;
-                seg->flags &= ~TCP_FIN;
+                    /* make sure we do not send a SYN with a FIN bit. */
+                    seg->flags &= ~TCP_FIN;
+                }
             }
 
             if (len < 0) {
@@ -735,7 +1564,7 @@ tcp_output(struct tcb_entry *tcb)
                  * When we have credit we can send something clear NAGLE flag and
                  * go to send.
                  */
-                if (idle || (tcb->tflags & TCBF_NAGLE_CREDIT) ||
+                if (idle || tfo_data || (tcb->tflags & TCBF_NAGLE_CREDIT) ||
                     (tcb->pcb->opt_flag & TCP_NODELAY_FLAG)) {
                     tcb->tflags &= ~TCBF_NAGLE_CREDIT;
                     CNE_DEBUG("Nagle Credit or NoDelay flag or idle %d\n", idle);
@@ -832,6 +1661,25 @@ tcp_output(struct tcb_entry *tcb)
             goto leave;
         } while (/*CONSTCOND*/ 0);
 
+        /* Only new data is paced, retransmissions and window probes are sent now */
+        pace = (len > 0) && is_set(this_stk->gflags, TCP_PACING_ENABLED) &&
+               is_clr(tcb->tflags, TCBF_FORCE_TX) && is_clr(seg->flags, TCP_SYN) &&
+               seqGEQ(tcb->snd_nxt, tcb->snd_max);
+        now  = cne_rdtsc();
+
+        if (pace && tcb->pace_next > now && tcp_pace_schedule(tcb) == 0) {
+            INC_TCP_STAT(pace_deferred);
+
+            if (is_clr(tcb->tflags, TCBF_ACK_NOW))
+                goto leave;
+
+            /* Send the ACK we owe, the data waits for the pacing wheel */
+            len      = 0;
+            pace     = false;
+            sendalot = false;
+            seg->flags &= ~TCP_FIN;
+        }
+
         /* Create the options and obtain the options length */
         seg->optlen = tcp_send_options(tcb, seg->opts, seg->flags);
 
@@ -843,6 +1691,10 @@ tcp_output(struct tcb_entry *tcb)
             seg->flags &= ~TCP_FIN;
         }
 
+        /* A SYN carries at most one segment of data, the rest waits for the handshake */
+        if (is_set(seg->flags, TCP_SYN))
+            sendalot = false;
+
         if (pktdev_buf_alloc(seg->lport, &seg->mbuf, 1) <= 0) {
             CNE_WARN("pktmbuf allocation from lport %d failed id %d\n", seg->lport, cne_id());
             return -1;
@@ -867,6 +1719,9 @@ tcp_output(struct tcb_entry *tcb)
 
             pktmbuf_append(seg->mbuf, len); /* Update length */
             CNE_DEBUG("Add [orange]%4d[] bytes to the packet buffer\n", len);
+
+            if (is_set(seg->flags, TCP_SYN))
+                INC_TCP_STAT(tfo_data_sent);
         }
 
         /* Make sure if sending a FIN does not advertise a new sequence number */
@@ -914,6 +1769,10 @@ tcp_output(struct tcb_entry *tcb)
         if (is_clr(tcb->tflags, TCBF_FORCE_TX) || (tcb->timers[TCPT_PERSIST] == 0)) {
             uint32_t startseq = tcb->snd_nxt;
 
+            /* Record the transmit time of the data for RACK */
+            if (is_clr(seg->flags, TCP_SYN))
+                tcp_rack_sent(tcb, startseq, len, seqLT(startseq, tcb->snd_max));
+
             /* Count the SYN and/or FIN bits */
             tcb->snd_nxt += is_set(seg->flags, SYN_FIN) ? 1 : 0;
 
@@ -931,6 +1790,7 @@ tcp_output(struct tcb_entry *tcb)
                 if (tcb->rtt == 0) {
                     tcb->rtt    = 1;
                     tcb->rttseq = startseq;
+                    tcb->rtt_ts = cne_rdtsc();
                 }
             }
 
@@ -965,10 +1825,20 @@ tcp_output(struct tcb_entry *tcb)
             CNE_ERR_RET("TCP send segment returned error\n");
         }
 
+        if (len > 0)
+            nsent++;
+        if (pace)
+            tcp_pace_sent(tcb, len, now);
+
         CNE_DEBUG("Send a lot is [orange]%s[]\n", sendalot ? "true" : "false");
     } while (sendalot);
 
 leave:
+    if (tcb->rack.tlp_arm)
+        tcp_rack_tlp_arm(tcb);
+    if (nsent)
+        tcp_pace_burst(nsent);
+
     CNE_DEBUG("[orange]Leaving[]\n");
     return 0;
 }
@@ -1264,6 +2134,22 @@ tcp_do_options(struct seg_entry *seg, uint8_t *opts)
 
             break;
 
+        case TCP_OPT_FASTOPEN:
+            if ((opts[1] + opts) > opt_end)
+                return -1;
+
+            /* Only a SYN can carry a cookie or an empty cookie request */
+            if (is_set(seg->flags, TCP_SYN) && (opts[1] >= TCP_OPT_FASTOPEN_HDRSZ) &&
+                (opts[1] <= (TCP_OPT_FASTOPEN_HDRSZ + TCP_TFO_COOKIE_MAX))) {
+                seg->tfo_len = opts[1] - TCP_OPT_FASTOPEN_HDRSZ;
+
+                if ((seg->tfo_len == 0) || (seg->tfo_len >= TCP_TFO_COOKIE_MIN)) {
+                    memcpy(seg->tfo_cookie, &opts[2], seg->tfo_len);
+                    seg->sflags |= SEG_TFO_PRESENT;
+                }
+            }
+            break;
+
         default:
             CNE_ERR("Unknown Options %d\n", opts[0]);
             break;
@@ -1389,9 +2275,11 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
                     cnet_tcp_abort(pcb);
                     CNE_ERR("Failed to enqueue PCB to backlog queue\n");
                 }
+                chnl_notify(tcb->ppcb->ch);
                 pcb->ch->ch_callback(CHNL_TCP_ESTABLISHED_TYPE, tcb->ppcb->ch->ch_cd);
             }
         } else {
+            chnl_notify(pcb->ch);
             pcb->ch->ch_callback(CHNL_TCP_ESTABLISHED_TYPE, pcb->ch->ch_cd);
         }
 
@@ -1439,6 +2327,7 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
         break;
     }
 
+    CNE_TRACE(tcp_trace_state, (uintptr_t)tcb, tcb->state, new_state);
     tcb->state = new_state;
 }
 
@@ -1702,8 +2591,12 @@ do_passive_open(struct seg_entry *seg)
 
     tcp_do_process_options(tcb, seg, nch);
 
+    if (is_set(ppcb->opt_flag, TCP_FASTOPEN_FLAG) && is_set(seg->sflags, SEG_TFO_PRESENT))
+        tcp_tfo_passive_open(tcb, seg);
+
     /* Setup this TCB as having a parent PCB */
-    tcb->ppcb = ppcb;
+    tcb->ppcb            = ppcb;
+    tcb->max_pacing_rate = ppcb->tcb->max_pacing_rate;
 
     if (tcp_q_add(&ppcb->tcb->half_open_q, tcb->pcb))
         CNE_WARN("Failed to enqueue to half_open queue\n");
@@ -1756,9 +2649,12 @@ tcb_cleanup(struct tcb_entry *tcb)
     if (!tcb || tcb->state == TCPS_FREE || tcb->state == TCPS_CLOSED)
         return TCP_INPUT_NEXT_PKT_DROP;
 
+    CNE_TRACE(tcp_trace_state, (uintptr_t)tcb, tcb->state, TCPS_CLOSED);
     tcb->state = TCPS_CLOSED;
 
     tcb_kill_timers(tcb); /* Stop all of the timers */
+    tcp_rack_timer_stop(tcb);
+    tcp_pace_remove(tcb);
 
     /* Mark the pcb as closed, to make sure a connection is not created */
     if ((p = tcb->pcb) != NULL) {
@@ -1904,6 +2800,10 @@ do_segment_listen(struct seg_entry *seg)
 
         /* New PCB for segment as the previous was in the listen state */
         seg->pcb = pcb;
+
+        /* Accept the data in a TCP Fast Open SYN with a valid cookie */
+        if (is_set(pcb->tcb->tflags, TCBF_TFO_SYN_DATA))
+            return tcp_tfo_syn_data(seg, pcb->tcb);
     }
     CNE_DEBUG("Exit with check output and drop\n");
     return TCP_CHECK_OUTPUT_AND_DROP;
@@ -2165,6 +3065,10 @@ do_segment_syn_sent(struct seg_entry *seg)
         }
         tcb->snd_una = seg->ack;
 
+        /* Drop the TCP Fast Open data acked with the SYN and resend the rest */
+        if (is_set(tcb->tflags, TCBF_TFO_SYN_DATA))
+            tcp_tfo_syn_acked(tcb, seg->pcb->ch);
+
         if (seqLT(tcb->snd_nxt, tcb->snd_una))
             tcb->snd_nxt = tcb->snd_una;
 
@@ -2223,6 +3127,9 @@ do_segment_syn_sent(struct seg_entry *seg)
     if (is_set(seg->flags, TCP_SYN) && (acceptable || is_clr(seg->flags, TCP_ACK))) {
         tcp_do_process_options(tcb, seg, seg->pcb->ch);
 
+        if (is_set(tcb->tflags, TCBF_TFO_COOKIE_REQ))
+            tcp_tfo_cache_update(tcb, seg);
+
         tcb->timers[TCPT_REXMT] = 0;
 
         /* RCV.NXT = SEG.SEQ + 1 */
@@ -2257,6 +3164,28 @@ do_segment_syn_sent(struct seg_entry *seg)
     return TCP_INPUT_NEXT_PKT_DROP;
 }
 
+/*
+ * Sample the RTT of the segment timed by the retransmit timer estimator in cycles.
+ *
+ * The estimator below counts slow timer ticks of 500ms, which is too coarse for a
+ * pacing rate. The same timed segment is measured with the TSC and smoothed into
+ * pace_srtt, scaled by 8 as srtt, before tcp_calculate_RTT() stops the timing.
+ */
+static inline void
+tcp_pace_rtt(struct tcb_entry *tcb, seq_t ack)
+{
+    uint64_t rtt;
+
+    if (tcb->rtt == 0 || !seqGT(ack, tcb->rttseq))
+        return;
+
+    rtt = cne_rdtsc() - tcb->rtt_ts;
+    if (tcb->pace_srtt == 0)
+        tcb->pace_srtt = rtt << TCP_RTT_SHIFT;
+    else
+        tcb->pace_srtt += rtt - (tcb->pace_srtt >> TCP_RTT_SHIFT);
+}
+
 /*
  * TCP retransmit timer update and calculation code with comments from RFC6299.
  */
@@ -2741,6 +3670,10 @@ do_segment_others(struct seg_entry *seg)
          */
         if (seqLEQ(seg->ack, tcb->snd_una)) {
             if ((seg->len == 0) && (seg->wnd == tcb->snd_wnd)) {
+                /* RACK-TLP (RFC8985) detects the lost segment by time on each duplicate ACK */
+                if ((tcb->timers[TCPT_REXMT] != 0) && (seg->ack == tcb->snd_una))
+                    tcp_rack_dupack(tcb);
+
                 if ((tcb->timers[TCPT_REXMT] == 0) || (seg->ack != tcb->snd_una))
                     tcb->dupacks = 0;
 
@@ -2750,7 +3683,7 @@ do_segment_others(struct seg_entry *seg)
                  *
                  *     ssthresh = max (FlightSize / 2, 2*SMSS) (3)
                  */
-                else if (++tcb->dupacks == TCP_RETRANSMIT_THRESHOLD) {
+                else if ((++tcb->dupacks == TCP_RETRANSMIT_THRESHOLD) && !tcb->rack.in_recovery) {
                     uint32_t onxt = tcb->snd_max;
                     uint32_t win  = CNE_MIN(tcb->snd_wnd, tcb->snd_cwnd) / 2 / tcb->max_mss;
 
@@ -2849,8 +3782,10 @@ do_segment_others(struct seg_entry *seg)
          */
     case TCPS_LAST_ACK:
         if (is_set(tcb->tflags, TCBF_OUR_FIN_ACKED)) {
-            if (tcb->pcb && tcb->pcb->ch)
+            if (tcb->pcb && tcb->pcb->ch) {
+                chnl_notify(tcb->pcb->ch);
                 tcb->pcb->ch->ch_callback(CHNL_TCP_CLOSE_TYPE, tcb->pcb->ch->ch_cd);
+            }
 
             tcp_do_state_change(seg->pcb, TCPS_CLOSED);
             return TCP_INPUT_NEXT_PKT_DROP;
@@ -2897,6 +3832,8 @@ do_segment_others(struct seg_entry *seg)
         tcb_segment_update(seg, tcb);
     }
 
+    tcp_pace_rtt(tcb, seg->ack);
+
     /* Process the retransmit timer value, use timestamp if present. */
     if (is_set(seg->sflags, SEG_TS_PRESENT) && (seg->ts_ecr != 0))
         tcp_calculate_RTT(tcb, (stk_get_timer_ticks() - seg->ts_ecr) + 1);
@@ -3136,6 +4073,13 @@ tcp_update_acked_data(struct seg_entry *seg, struct tcb_entry *tcb)
     /* Figure out the number of bytes acked, could be zero if SYN was acked. */
     acked = seg->ack - tcb->snd_una;
 
+    /*
+     * The SYN takes a sequence number but no byte of the send buffer. A TCP Fast
+     * Open server can have data queued behind its SYN, which must not lose a byte.
+     */
+    if (acked && tcb->snd_una == tcb->snd_iss)
+        acked--;
+
     /*
      * If we are acking more data then what is in the send buffer we have seen
      * the FIN bit. The FIN seen flag should have been set already.
@@ -3149,9 +4093,8 @@ tcp_update_acked_data(struct seg_entry *seg, struct tcb_entry *tcb)
     }
 
     /* wakeup the writers if we have space >= low water mark */
-    if (cb_space(&ch->ch_snd) >= ch->ch_snd.cb_lowat) {
-        /* TODO: Allow the users to put more data in send buffer */
-    }
+    if (cb_space(&ch->ch_snd) >= ch->ch_snd.cb_lowat)
+        chnl_notify(ch);
 
     /* Update the send unacked variable to the current acked value */
     tcb->snd_una = seg->ack;
@@ -3162,6 +4105,8 @@ tcp_update_acked_data(struct seg_entry *seg, struct tcb_entry *tcb)
         tcb->snd_nxt = tcb->snd_una;
     }
 
+    tcp_rack_ack(tcb);
+
     switch (tcb->state) {
     /*
      * In FIN_WAIT_1 STATE in addition to the processing
@@ -3229,6 +4174,8 @@ tcp_header_prediction(struct seg_entry *seg, struct tcb_entry *tcb)
 
             INC_TCP_STAT(ack_predicted);
 
+            tcp_pace_rtt(tcb, seg->ack);
+
             /* Process the retransmit timer, use timestamp if present. */
             if (is_set(seg->sflags, SEG_TS_PRESENT))
                 tcp_calculate_RTT(tcb, stk_get_timer_ticks() - seg->ts_ecr + 1);
@@ -3584,6 +4531,8 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
     uint32_t win;
     bool state = false;
 
+    CNE_TRACE(tcp_trace_timer, (uintptr_t)t, tmr, t->state);
+
     switch (tmr) {
     case TCPT_2MSL:
         if ((t->state != TCPS_TIME_WAIT) && (t->idle <= stk->tcp->max_idle))
@@ -3644,6 +4593,7 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
         }
 
         INC_TCP_STAT(tcp_rexmit);
+        tcp_rack_rto(t);
 
         rexmt = tcpRexmtVal(t) * ((t->state == TCPS_SYN_SENT) ? tcp_syn_backoff[t->rxtshift]
                                                               : tcp_backoff[t->rxtshift]);
@@ -3776,6 +4726,14 @@ tcp_send_options(struct tcb_entry *tcb, uint8_t *opts, uint8_t flags_n)
             *p++ = TCP_OPT_NOP;
             optlen += 4;
         }
+
+        /* Add the TCP Fast Open option when requesting or returning a cookie */
+        if (is_set(tcb->tflags, TCBF_TFO_COOKIE_REQ)) {
+            int32_t len = tcp_tfo_options(tcb, p, flags_n);
+
+            p += len;
+            optlen += len;
+        }
     }
 
     CNE_DEBUG("tcb state [orange]%s[]\n", tcb_print_flags(tcb->tflags));
@@ -3874,6 +4832,20 @@ cnet_tcp_connect(struct pcb_entry *pcb)
     /* Set the new send ISS value. */
     tcp_send_seq_set(tcb, 7);
 
+    /*
+     * TCP Fast Open always sends the option, an empty cookie requests a cookie from
+     * the server. With a cached cookie the SYN can carry the data already queued.
+     */
+    if (is_set(pcb->opt_flag, TCP_FASTOPEN_FLAG)) {
+        struct tcp_tfo_cache *tc = tcp_tfo_cache_lookup(tcb->tcp, &pcb->key.faddr);
+
+        tcb->tflags |= TCBF_TFO_COOKIE_REQ;
+        if (tc) {
+            tcb->tflags |= TCBF_TFO_SYN_DATA;
+            tcp_set_MSS(tcb, tc->mss);
+        }
+    }
+
     INC_TCP_STAT(tcp_connect);
 
     tcb->tflags |= TCBF_ACK_NOW;
@@ -3971,6 +4943,46 @@ cnet_tcb_dump(void)
         cnet_tcb_list(stk, NULL);
 }
 
+void
+cnet_tcp_rack_set(stk_t *stk, bool enable)
+{
+    if (stk) {
+        if (enable)
+            stk->gflags |= TCP_RACK_TLP_ENABLED;
+        else
+            stk->gflags &= ~TCP_RACK_TLP_ENABLED;
+    }
+}
+
+#if CNET_TCP_FAULT_INJECT_ENABLED
+void
+cnet_tcp_tail_drop_set(stk_t *stk, uint32_t n)
+{
+    if (stk && stk->tcp) {
+        stk->tcp->tail_drop = n;
+        stk->tcp->tail_cnt  = 0;
+    }
+}
+#endif
+
+void
+cnet_tcp_pacing_set(stk_t *stk, bool enable)
+{
+    if (stk) {
+        if (enable)
+            stk->gflags |= TCP_PACING_ENABLED;
+        else
+            stk->gflags &= ~TCP_PACING_ENABLED;
+    }
+}
+
+void
+cnet_tcp_copy_set(stk_t *stk, dsa_copy_t *dc)
+{
+    if (stk && stk->tcp)
+        stk->tcp->dcopy = dc;
+}
+
 /*
  * Main entry point to initialize the TCP protocol.
  */
@@ -4012,6 +5024,8 @@ tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
     stk->tcp->default_MSS = TCP_NORMAL_MSS;
     stk->tcp->default_RTT = TCP_SRTTDFLT_TV; /* RFC6298 states - 1 sec */
     stk->tcp->snd_ISS     = (uint32_t)rand();
+    if (getrandom(stk->tcp->tfo_key, sizeof(stk->tcp->tfo_key), 0) != sizeof(stk->tcp->tfo_key))
+        CNE_ERR_GOTO(err_exit, "Unable to get the TCP Fast Open key: %s\n", strerror(errno));
     stk->tcp_now          = (uint32_t)cne_rdtsc();
 
     stk->tcp->tcp_hd.vec = vec_alloc(stk->tcp->tcp_hd.vec, TCP_VEC_PCB_COUNT);
@@ -4033,6 +5047,11 @@ tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
 
     cne_timer_init(&stk->tcp_timer);
 
+    cne_timer_init(&stk->tcp->pacer.timer);
+    for (int i = 0; i < TCP_PACE_SLOTS; i++)
+        TAILQ_INIT(&stk->tcp->pacer.slots[i]);
+    stk->tcp->pacer.slot_cycles = (cne_get_timer_hz() / 1000000) * TCP_PACE_SLOT_US;
+
     if (cne_timer_reset(&stk->tcp_timer, (cne_get_timer_hz() / 1000) * 10, PERIODICAL, cne_id(),
                         _process_timers, (void *)stk) < 0)
         CNE_ERR_GOTO(cleanup, "Failed to start TCP timer for instance %s\n", stk->name);
@@ -4070,6 +5089,9 @@ tcp_destroy(void *_stk __cne_unused)
 {
     stk_t *stk = _stk;
 
+    if (stk->tcp && stk->tcp->pacer.active)
+        cne_timer_stop(&stk->tcp->pacer.timer);
+
     free(stk->tcp_stats);
     free(stk->tcp);
     free(stk->tcbs);
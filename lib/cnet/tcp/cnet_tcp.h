@@ -58,10 +58,13 @@
 #include "mempool.h"           // for mempool_get, mempool_put
 #include "pktmbuf.h"           // for pktmbuf_t
 #include <cne_inet6.h>
+#include <cne_trace.h>        // for CNE_TRACE_POINT_DECLARE
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+struct dsa_copy; /**< Copy engine, see dsa_copy.h */
+
 #define CNET_TCP_REASSEMBLE_COUNT 256
 #define CNET_TCP_BACKLOG_COUNT    128
 #define CNET_TCP_HALF_OPEN_COUNT  128
@@ -197,13 +200,14 @@ enum { SEND_EVENT, PERSIST_EVENT, RETRANSMIT_EVENT, DELETE_EVENT };
 
 /* TCP Option values */
 enum {
-    TCP_OPT_EOL = 0,   /**< End of Line flag */
-    TCP_OPT_NOP,       /**< Noop type option */
-    TCP_OPT_MSS,       /**< MSS option type */
-    TCP_OPT_WSOPT,     /**< Window Scaling option */
-    TCP_OPT_SACK_OK,   /**< SACK OK option */
-    TCP_OPT_SACK,      /**< SACK option */
-    TCP_OPT_TSTAMP = 8 /**< Timestamp option */
+    TCP_OPT_EOL = 0,      /**< End of Line flag */
+    TCP_OPT_NOP,          /**< Noop type option */
+    TCP_OPT_MSS,          /**< MSS option type */
+    TCP_OPT_WSOPT,        /**< Window Scaling option */
+    TCP_OPT_SACK_OK,      /**< SACK OK option */
+    TCP_OPT_SACK,         /**< SACK option */
+    TCP_OPT_TSTAMP   = 8, /**< Timestamp option */
+    TCP_OPT_FASTOPEN = 34 /**< TCP Fast Open cookie option RFC7413 */
 };
 
 /* A few option lengths */
@@ -213,6 +217,13 @@ enum {
 #define TCP_OPT_TSTAMP_LEN 10
 #define TCP_MAX_OPTIONS    32
 
+/* TCP Fast Open (RFC7413) values */
+#define TCP_TFO_COOKIE_LEN     8  /**< Length of the cookie we generate */
+#define TCP_TFO_COOKIE_MIN     4  /**< Minimum valid cookie length */
+#define TCP_TFO_COOKIE_MAX     16 /**< Maximum valid cookie length */
+#define TCP_TFO_CACHE_SIZE     64 /**< Number of client cookie cache entries, power of 2 */
+#define TCP_OPT_FASTOPEN_HDRSZ 2  /**< Kind and length bytes of the TFO option */
+
 /* Few default values */
 #ifdef TCP_MSS
 #undef TCP_MSS
@@ -285,6 +296,18 @@ enum {
 #define TCP_MAXRXTSHIFT          12 /**< Max retransmissions */
 #define TCP_RETRANSMIT_THRESHOLD 3
 
+/* RACK-TLP (RFC8985) values */
+#define TCP_RACK_LOG_SIZE    64                  /**< Sent segments tracked per TCB, power of 2 */
+#define TCP_RACK_MIN_PTO_MS  10                  /**< Minimum Tail Loss Probe timeout */
+#define TCP_RACK_WCDELACK_MS TCP_FAST_TIMEOUT_MS /**< Worst case delayed ACK of the peer */
+
+/* Pacing values */
+#define TCP_PACE_SLOTS         256 /**< Pacing timer wheel slots, power of 2 */
+#define TCP_PACE_SLOT_US       10  /**< Time covered by a pacing wheel slot */
+#define TCP_PACE_SS_RATIO      200 /**< Percent of cwnd/srtt paced in slow start */
+#define TCP_PACE_CA_RATIO      120 /**< Percent of cwnd/srtt paced in congestion avoidance */
+#define TCP_PACE_BURST_BUCKETS 8   /**< Burst size histogram buckets 1, 2, 3-4, ... 65+ */
+
 #define MAX_TCP_RCV_SIZE (128 * 1024)
 #define MAX_TCP_SND_SIZE MAX_TCP_RCV_SIZE
 
@@ -303,25 +326,27 @@ enum {
 /* Current Segment information in host order. */
 struct seg_entry {
     TAILQ_ENTRY(seg_entry) entry;
-    pktmbuf_t *mbuf;               /**< Current Packet pointer */
-    struct pcb_entry *pcb;         /**< PCB attached to this segment */
-    uint8_t flags;                 /**< Current TCP flags tcp_hd.flags */
-    uint8_t offset;                /**< Current Segment offset in bytes */
-    uint16_t mss;                  /**< MSS option value when present */
-    uint16_t urp;                  /**< Current Segment urgent pointer */
-    uint16_t len;                  /**< Current Segment length */
-    uint16_t iplen;                /**< Total length of the IP Data */
-    uint16_t sflags;               /**< Segment flags */
-    uint16_t lport;                /**< lport id */
-    uint32_t wnd;                  /**< Current Segment Window */
-    seq_t seq;                     /**< Current Segment sequence */
-    seq_t ack;                     /**< Current Segment acknowledge */
-    uint32_t ts_val;               /**< Timestamp value */
-    uint32_t ts_ecr;               /**< Timestamp ecr */
-    void *ip;                      /**< IPv4/v6 header start. */
-    uint8_t req_scale;             /**< Requested send scale */
-    uint8_t optlen;                /**< TCP Options length */
-    uint8_t opts[TCP_MAX_OPTIONS]; /**< TCP Option bytes */
+    pktmbuf_t *mbuf;                        /**< Current Packet pointer */
+    struct pcb_entry *pcb;                  /**< PCB attached to this segment */
+    uint8_t flags;                          /**< Current TCP flags tcp_hd.flags */
+    uint8_t offset;                         /**< Current Segment offset in bytes */
+    uint16_t mss;                           /**< MSS option value when present */
+    uint16_t urp;                           /**< Current Segment urgent pointer */
+    uint16_t len;                           /**< Current Segment length */
+    uint16_t iplen;                         /**< Total length of the IP Data */
+    uint16_t sflags;                        /**< Segment flags */
+    uint16_t lport;                         /**< lport id */
+    uint32_t wnd;                           /**< Current Segment Window */
+    seq_t seq;                              /**< Current Segment sequence */
+    seq_t ack;                              /**< Current Segment acknowledge */
+    uint32_t ts_val;                        /**< Timestamp value */
+    uint32_t ts_ecr;                        /**< Timestamp ecr */
+    void *ip;                               /**< IPv4/v6 header start. */
+    uint8_t req_scale;                      /**< Requested send scale */
+    uint8_t optlen;                         /**< TCP Options length */
+    uint8_t opts[TCP_MAX_OPTIONS];          /**< TCP Option bytes */
+    uint8_t tfo_len;                        /**< TCP Fast Open cookie length, zero is a cookie request */
+    uint8_t tfo_cookie[TCP_TFO_COOKIE_MAX]; /**< TCP Fast Open cookie bytes */
 };
 
 /* seg_entry.sflags bit definitions */
@@ -329,7 +354,8 @@ enum {
     SEG_TS_PRESENT  = 0x8000, /**< Timestamp is present */
     SEG_MSS_PRESENT = 0x4000, /**< MSS option is present */
     SEG_WS_PRESENT  = 0x2000, /**< Window Scale present */
-    SEG_SACK_PERMIT = 0x1000  /**< SACK permission flag, which is not supported at this time. */
+    SEG_SACK_PERMIT = 0x1000, /**< SACK permission flag, which is not supported at this time. */
+    SEG_TFO_PRESENT = 0x0800  /**< TCP Fast Open option present */
 };
 
 enum {
@@ -346,6 +372,48 @@ struct tcp_q {
     atomic_uint_least32_t cnt;    /**< Number of entries in the list */
 };
 
+/* Sent segment information used by RACK to detect lost segments */
+struct tcp_rack_seg {
+    seq_t start;      /**< Starting sequence number of the segment */
+    seq_t end;        /**< Ending sequence number of the segment */
+    uint64_t xmit_ts; /**< Time of the last (re)transmission in cycles */
+    uint32_t flags;   /**< RACK_SEG_* flags */
+};
+
+/* tcp_rack_seg.flags values */
+enum {
+    RACK_SEG_RETRANS   = 0x0001, /**< Segment has been retransmitted */
+    RACK_SEG_DELIVERED = 0x0002, /**< Segment delivered, reported by a duplicate ACK */
+    RACK_SEG_LOST      = 0x0004, /**< Segment is marked lost and needs a retransmit */
+};
+
+/* tcp_rack.timer_type values */
+enum {
+    RACK_TIMER_NONE = 0, /**< RACK timer is not armed */
+    RACK_TIMER_REO,      /**< Reordering window timer */
+    RACK_TIMER_TLP,      /**< Tail Loss Probe timer */
+};
+
+/* RACK-TLP state, the times are in cycles and the timer is not tied to the slow tick */
+struct tcp_rack {
+    struct cne_timer timer; /**< Reordering or Tail Loss Probe timer */
+    uint64_t xmit_ts;       /**< Transmit time of the most recently delivered segment */
+    uint64_t rtt;           /**< RTT of the most recently delivered segment */
+    uint64_t min_rtt;       /**< Minimum RTT seen, zero if no sample */
+    uint64_t srtt;          /**< Smoothed RTT scaled by TCP_RTT_SCALE, zero if no sample */
+    seq_t end_seq;          /**< Ending sequence of the most recently delivered segment */
+    seq_t recovery_end;     /**< snd_max when the loss recovery started */
+    seq_t tlp_end_seq;      /**< snd_max when the loss probe was sent */
+    uint32_t head;          /**< Index of the oldest segment in segs */
+    uint32_t tail;          /**< Index of the next free entry in segs */
+    uint8_t timer_type;     /**< RACK_TIMER_* type of the armed timer */
+    bool in_recovery;       /**< Loss recovery started by RACK */
+    bool tlp_inflight;      /**< A loss probe has been sent and not acked */
+    bool tlp_rexmit;        /**< The loss probe was a retransmission */
+    bool tlp_arm;           /**< New data was sent, arm the loss probe timer */
+    struct tcp_rack_seg segs[TCP_RACK_LOG_SIZE]; /**< Sent segments in sequence order */
+};
+
 /* TCP Transmission Control Block */
 struct tcb_entry {
     TAILQ_ENTRY(tcb_entry) entry; /**< Pointer to the next free tcb_entry structure */
@@ -410,6 +478,18 @@ struct tcb_entry {
     uint16_t rttmin;     /**< Minimum value for retransmission timeout */
     int16_t rxtshift;    /**< index into tcp_backoff[] array */
     uint16_t idle;       /**< TCP Idle counter */
+
+    struct tcp_rack rack; /**< RACK-TLP loss detection state */
+
+    /* Pacing */
+    TAILQ_ENTRY(tcb_entry) pace_entry; /**< Entry on the stack pacing wheel */
+    uint64_t pace_next;                /**< Earliest time in cycles to send new data */
+    uint64_t pace_srtt;                /**< Smoothed RTT in cycles scaled by 8, sets the rate */
+    uint64_t rtt_ts;                   /**< Time in cycles the segment timed for RTT was sent */
+    uint64_t pacing_rate;              /**< Current pacing rate in bytes per second */
+    uint64_t max_pacing_rate;          /**< Pacing rate limit in bytes per second, zero no limit */
+    uint16_t pace_slot;                /**< Pacing wheel slot index */
+    bool pace_queued;                  /**< TCB is waiting on the pacing wheel */
 };
 
 /* tcb_entry.tflags values */
@@ -422,8 +502,8 @@ enum {
 
     TCBF_RFC1122_URG     = 0x01000000, /**< RFC1122 Urgent */
     TCBF_BOUND           = 0x02000000, /**< TCB is Bound */
-    TCBF_FREE_BIT_2      = 0x04000000,
-    TCBF_FREE_BIT_3      = 0x08000000,
+    TCBF_TFO_COOKIE_REQ  = 0x04000000, /**< Send or request a TCP Fast Open cookie */
+    TCBF_TFO_SYN_DATA    = 0x08000000, /**< Data was sent or accepted in the SYN */
 
     TCBF_REQ_TSTAMP      = 0x00100000, /**< Requested Timestamp option */
     TCBF_RCVD_SCALE      = 0x00200000, /**< Window Scaling received */
@@ -453,8 +533,8 @@ enum {
         "FORCE_TX",         \
         "PASSIVE_OPEN",     \
                             \
-        "Free_3",           \
-        "Free_2",           \
+        "TFO_SYN_DATA",     \
+        "TFO_COOKIE_REQ",   \
         "BOUND",            \
         "RFC1122_URG",      \
                             \
@@ -494,19 +574,46 @@ struct pcb_hd {
 };
 #endif
 
+/* Client side TCP Fast Open cookie cache entry, indexed by a hash of the server address */
+struct tcp_tfo_cache {
+    struct in_caddr faddr;              /**< Server address of the cookie */
+    uint16_t mss;                       /**< Server MSS value */
+    uint8_t len;                        /**< Cookie length, zero if entry unused */
+    uint8_t cookie[TCP_TFO_COOKIE_MAX]; /**< Cookie returned by the server */
+};
+
+/* Per stack pacing scheduler, a timer wheel of TCBs waiting to send */
+struct tcp_pacer {
+    struct cne_timer timer;                        /**< Wheel timer, runs while TCBs wait */
+    uint64_t slot_cycles;                          /**< Cycles covered by a slot */
+    uint64_t slot_tsc;                             /**< Start time of the current slot */
+    uint32_t cur;                                  /**< Current slot index */
+    uint32_t cnt;                                  /**< Number of TCBs on the wheel */
+    bool active;                                   /**< Wheel timer is running */
+    TAILQ_HEAD(, tcb_entry) slots[TCP_PACE_SLOTS]; /**< TCBs waiting to send per slot */
+};
+
 struct tcp_entry {
     TAILQ_ENTRY(tcb_entry) entry;
-    uint32_t rcv_size;  /**< TCP Receive Size */
-    uint32_t snd_size;  /**< TCP Send Size */
-    uint32_t snd_ISS;   /**< TCP Send ISS value */
-    int32_t keep_intvl; /**< TCP Keep Interval */
-    int32_t keep_idle;  /**< TCP Keep Idle */
-    int32_t keep_cnt;   /**< TCP Keep Count */
-    int32_t max_idle;   /**< TCP Max Idle */
+    uint32_t rcv_size;                                  /**< TCP Receive Size */
+    uint32_t snd_size;                                  /**< TCP Send Size */
+    uint32_t snd_ISS;                                   /**< TCP Send ISS value */
+    int32_t keep_intvl;                                 /**< TCP Keep Interval */
+    int32_t keep_idle;                                  /**< TCP Keep Idle */
+    int32_t keep_cnt;                                   /**< TCP Keep Count */
+    int32_t max_idle;                                   /**< TCP Max Idle */
     uint16_t pad0;
-    uint16_t default_MSS; /**< Default MSS value */
-    int32_t default_RTT;  /**< Default Round Trip Time */
-    struct pcb_hd tcp_hd; /**< PCB header information */
+    uint16_t default_MSS;                               /**< Default MSS value */
+    int32_t default_RTT;                                /**< Default Round Trip Time */
+    struct pcb_hd tcp_hd;                               /**< PCB header information */
+    uint64_t tfo_key[2];                                /**< SipHash key of the TCP Fast Open cookies */
+    struct tcp_tfo_cache tfo_cache[TCP_TFO_CACHE_SIZE]; /**< Client TFO cookie cache */
+#if CNET_TCP_FAULT_INJECT_ENABLED
+    uint32_t tail_drop;                                 /**< Drop every Nth flight tail */
+    uint32_t tail_cnt;                                  /**< Flight tails sent for tail_drop */
+#endif
+    struct tcp_pacer pacer;                             /**< Pacing scheduler */
+    struct dsa_copy *dcopy;                             /**< Copy engine for segment data or NULL */
 };
 
 /**
@@ -538,6 +645,19 @@ typedef struct tcp_stats {
     uint64_t S_tcp_rexmit;     /**< TCP retransmission count */
     uint64_t S_resets_sent;    /**< TCP resets count */
     uint64_t S_tcp_connect;    /**< TCP connections count */
+    uint64_t S_tfo_cookie_req; /**< TCP Fast Open cookie requests received */
+    uint64_t S_tfo_syn_data;   /**< TCP Fast Open SYN data accepted */
+    uint64_t S_tfo_bad_cookie; /**< TCP Fast Open invalid cookie received */
+    uint64_t S_tfo_data_sent;  /**< TCP Fast Open SYN data sent */
+    uint64_t S_rack_lost;      /**< Segments marked lost by RACK */
+    uint64_t S_rack_timeout;   /**< RACK reordering timer expired */
+    uint64_t S_tlp_probe;      /**< Tail Loss Probes sent */
+    uint64_t S_tlp_recovered;  /**< Tail losses repaired by a loss probe */
+    uint64_t S_tail_drop;      /**< Flight tails dropped by the tail drop injection */
+    uint64_t S_paced;          /**< Data segments sent under pacing */
+    uint64_t S_pace_deferred;  /**< Sends deferred to the pacing wheel */
+
+    uint64_t S_burst[TCP_PACE_BURST_BUCKETS]; /**< Data segments sent per tcp_output() call */
 } tcp_stats_t;
 
 #define INC_TCP_STAT(x)               \
@@ -644,6 +764,9 @@ tcp_flags_dump(const char *msg, uint8_t flags)
     } while (0)
 #endif
 
+/** Trace point of the TCB state changes, defined in cnet_tcp.c */
+CNE_TRACE_POINT_DECLARE(tcp_trace_state);
+
 /**
  * The TCP input routine
  *
@@ -738,6 +861,61 @@ CNDP_API void cnet_tcb_list(stk_t *stk, struct tcb_entry *tcb);
  */
 CNDP_API void cnet_tcb_dump(void);
 
+/**
+ * Enable or disable RACK-TLP loss detection for new and active connections.
+ *
+ * RACK-TLP is disabled by default.
+ *
+ * @param stk
+ *   The stack instance to change.
+ * @param enable
+ *   True to use RACK-TLP, false to only use duplicate ACKs and the retransmit timer.
+ */
+CNDP_API void cnet_tcp_rack_set(stk_t *stk, bool enable);
+
+#if CNET_TCP_FAULT_INJECT_ENABLED
+/**
+ * Drop every Nth TCP segment ending a flight of data, used to test tail loss recovery.
+ *
+ * Only built with the enable_tcp_fault_inject meson option.
+ *
+ * @param stk
+ *   The stack instance to change.
+ * @param n
+ *   Drop one in n segments with the PSH flag set, zero to disable.
+ */
+CNDP_API void cnet_tcp_tail_drop_set(stk_t *stk, uint32_t n);
+#endif
+
+/**
+ * Enable or disable pacing of TCP data segments on a stack instance.
+ *
+ * When enabled new data is sent at a rate of cwnd/srtt, scaled up in slow start,
+ * and limited by the SO_MAX_PACING_RATE channel option. Segments are released
+ * from a per stack timer wheel instead of being sent in one burst. Pacing is
+ * disabled by default and does not depend on RACK-TLP.
+ *
+ * @param stk
+ *   The stack instance to change.
+ * @param enable
+ *   True to pace data segments, false to send up to cwnd in a burst.
+ */
+CNDP_API void cnet_tcp_pacing_set(stk_t *stk, bool enable);
+
+/**
+ * Set the copy engine used to build TCP data segments on a stack instance.
+ *
+ * The data of a segment is copied from the channel send buffer, copies of at least
+ * the engine threshold are queued to the engine and waited for before the segment is
+ * sent. The engine must only be used by the thread of the stack instance.
+ *
+ * @param stk
+ *   The stack instance to change.
+ * @param dc
+ *   The copy engine, NULL to copy with memcpy().
+ */
+CNDP_API void cnet_tcp_copy_set(stk_t *stk, struct dsa_copy *dc);
+
 #ifdef __cplusplus
 }
 #endif
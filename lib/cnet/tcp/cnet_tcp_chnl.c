@@ -247,6 +247,7 @@ tcp_chnl_listen(struct chnl *ch, int32_t backlog)
     tcb->qLimit = ((backlog >= 0) && (backlog <= CNET_TCP_BACKLOG_COUNT)) ? backlog
                                                                           : CNET_TCP_BACKLOG_COUNT;
 
+    CNE_TRACE(tcp_trace_state, (uintptr_t)tcb, tcb->state, TCPS_LISTEN);
     tcb->state = TCPS_LISTEN;
     tcb->tflags |= TCBF_PASSIVE_OPEN;
 
@@ -391,7 +392,16 @@ tcp_chnl_opt_set(struct chnl *ch, int level, int optname, const void *optval, ui
 
     switch (level) {
     case SO_CHANNEL:
-        return __errno_set(ENOPROTOOPT);
+        switch (optname) {
+        case SO_MAX_PACING_RATE: /* Zero is no limit */
+            if (!ch->ch_pcb->tcb)
+                return __errno_set(ENOTCONN);
+            ch->ch_pcb->tcb->max_pacing_rate = val;
+            break;
+        default:
+            return __errno_set(ENOPROTOOPT);
+        }
+        break;
 
     case SOL_TCP:
         switch (optname) {
@@ -404,6 +414,10 @@ tcp_chnl_opt_set(struct chnl *ch, int level, int optname, const void *optval, ui
         case TCBF_NOPUSH:
             setsockoptBit(ch->ch_pcb->opt_flag, TCP_NOPUSH_FLAG, val);
             break;
+        case TCP_FASTOPEN:         /* Listen side, val is the queue length */
+        case TCP_FASTOPEN_CONNECT: /* Connect side */
+            setsockoptBit(ch->ch_pcb->opt_flag, TCP_FASTOPEN_FLAG, val);
+            break;
         default:
             return __errno_set(ENOPROTOOPT);
         }
@@ -438,6 +452,9 @@ tcp_chnl_opt_get(struct chnl *ch, int level, int optname, void *optval, uint32_t
             *resI = (int)((ch->ch_pcb->tcb != (struct tcb_entry *)NULL) &&
                           (ch->ch_pcb->tcb->state == TCPS_LISTEN));
             break;
+        case SO_MAX_PACING_RATE:
+            *resI = (ch->ch_pcb->tcb) ? (int)ch->ch_pcb->tcb->max_pacing_rate : 0;
+            break;
 
         default:
             return __errno_set(ENOPROTOOPT);
@@ -464,6 +481,10 @@ tcp_chnl_opt_get(struct chnl *ch, int level, int optname, void *optval, uint32_t
         case TCBF_NOPUSH:
             *resI = ch->ch_pcb->opt_flag & TCP_NOPUSH_FLAG;
             break;
+        case TCP_FASTOPEN:
+        case TCP_FASTOPEN_CONNECT:
+            *resI = ch->ch_pcb->opt_flag & TCP_FASTOPEN_FLAG;
+            break;
         case TCP_CONGESTION:
             resP = (void *)(uintptr_t) "reno";
             len  = 5;
@@ -15,7 +15,7 @@
 #include <sys/un.h>             // for sockaddr_un
 #include <sys/stat.h>           // for stat, chmod, mkdir, S_ISDIR
 #include <bsd/string.h>         // for strlcpy, strlcat
-#include <poll.h>               // for pollfd, poll, POLLIN
+#include <sys/epoll.h>          // for epoll_ctl, epoll_wait, epoll_event
 #include <cne_version.h>        // for cne_version
 #include <errno.h>              // for errno, EINVAL, ENAMETOOLONG
 #include <limits.h>             // for PATH_MAX
@@ -30,6 +30,9 @@
 
 #define UDS_EXTRA_SPACE         64
 #define UDS_MAX_BUF_LEN         (16 * 1024)
+#define UDS_MAX_BIN_LEN         (128 * 1024) /**< Max length of a binary response */
+#define UDS_MAX_EVENTS          64           /**< Max events handled per epoll_wait() */
+#define UDS_MAX_BATCH           16           /**< Max pipelined requests per client wakeup */
 #define UDS_DEFAULT_RUNTIME_DIR "/var/run/cndp"
 
 static int list_cmd(uds_client_t *c, const char *cmd, const char *params);
@@ -390,6 +393,7 @@ info_cmd(uds_client_t *c, const char *cmd, const char *params)
     uds_append(c, "\"version\":\"%s\"", cne_version());
     uds_append(c, ",\"pid\":%d", getpid());
     uds_append(c, ",\"max_output_len\":%d", UDS_MAX_BUF_LEN);
+    uds_append(c, ",\"max_binary_len\":%d", UDS_MAX_BIN_LEN);
 
     return 0;
 }
@@ -406,6 +410,38 @@ invalid_cmd(uds_client_t *c, const char *cmd, const char *params)
 }
 
 static void
+reset_response(uds_client_t *c)
+{
+    if (c->buffer)
+        c->buffer[0] = '\0';
+    c->used   = 0;
+    c->binary = 0;
+}
+
+/*
+ * Send the response of a client as one message without blocking the server thread.
+ *
+ * @return
+ *   0 when the response is sent or dropped, 1 when the socket is full and the response is
+ *   kept in the client buffer or -1 if the peer is gone.
+ */
+static int
+send_response(uds_client_t *c)
+{
+    if (c->used > 0 && send(c->s, c->buffer, c->used, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return 1;
+        snprintf(uds_log_error, sizeof(uds_log_error), "Error writing to socket: %s\n",
+                 strerror(errno));
+        if (errno == EPIPE || errno == ECONNRESET)
+            return -1;
+    }
+    reset_response(c);
+
+    return 0;
+}
+
+static int
 perform_command(uds_cb fn, uds_client_t *c)
 {
     int ret;
@@ -414,19 +450,15 @@ perform_command(uds_cb fn, uds_client_t *c)
 
     ret = fn(c, c->cmd, c->params);
 
-    if (ret == UDS_NO_OUTPUT)
-        goto leave;
-
-    uds_append(c, "}");
-    if (write(c->s, c->buffer, c->used) < 0)
-        perror("Error writing to socket");
+    if (ret == UDS_NO_OUTPUT) {
+        reset_response(c);
+        return 0;
+    }
 
-    if (ret < 0)
-        return;
+    if (!c->binary)
+        uds_append(c, "}");
 
-leave:
-    c->buffer[0] = '\0';
-    c->used      = 0;
+    return send_response(c);
 }
 
 static uds_cb
@@ -466,144 +498,283 @@ get_cb_fn(struct uds_client *c, const char **cmd)
     return invalid_cmd;
 }
 
-static void *
-client_handler(void *_c)
-{
-    uds_client_t *c = _c;
+/*
+ * A connection served by the server thread, the responses of a connection are sent in the
+ * order of its requests. When a response does not fit in the socket it stays in the client
+ * buffer and the connection is not read until the response is sent.
+ */
+struct uds_conn {
+    TAILQ_ENTRY(uds_conn) next; /**< Next connection of the server */
+    uds_client_t c;             /**< Client state given to the callbacks */
+    int pending;                /**< The response waits for the socket to drain */
     char cbuf[UDS_MAX_CMD_LEN + 1];
+    union {
+        char buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } cmsg; /**< Ancillary data of the last request */
+};
 
-    if (!c)
-        return NULL;
+struct uds_server {
+    uds_info_t *info;             /**< UDS socket served */
+    int epfd;                     /**< epoll descriptor */
+    TAILQ_HEAD(, uds_conn) conns; /**< Connections of the server */
+};
 
-    int ret = pthread_setname_np(pthread_self(), "uds-client-hdlr");
-    if (ret) {
-        snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't set socket name: %s\n",
-                 strerror(ret));
-        goto leave;
+static int
+conn_add(struct uds_server *srv, int s, int socket_client)
+{
+    struct epoll_event ev = {0};
+    struct uds_conn *conn;
+
+    conn = calloc(1, sizeof(struct uds_conn));
+    if (!conn) {
+        snprintf(uds_log_error, sizeof(uds_log_error), "Failed to allocate uds_client structure\n");
+        return -1;
     }
+    conn->c.s             = s;
+    conn->c.info          = srv->info;
+    conn->c.socket_client = socket_client;
+
+    ev.events   = EPOLLIN;
+    ev.data.ptr = conn;
+    if (epoll_ctl(srv->epfd, EPOLL_CTL_ADD, s, &ev) < 0) {
+        snprintf(uds_log_error, sizeof(uds_log_error), "Error adding socket to epoll: %s\n",
+                 strerror(errno));
+        free(conn);
+        return -1;
+    }
+    TAILQ_INSERT_TAIL(&srv->conns, conn, next);
 
-    cbuf[0] = '\0';
-    while (c->info->running > 0) {
-        int bytes, mret;
-        char cmsgbuf[CMSG_SPACE(sizeof(int))];
-        struct cmsghdr *cmsg;
-        struct msghdr msg;
-        struct iovec iov;
-        uds_cb fn;
-        char *ptr;
-
-        iov.iov_base = cbuf;
-        iov.iov_len  = sizeof(char) * UDS_MAX_CMD_LEN;
-
-        msg.msg_name       = 0;
-        msg.msg_namelen    = 0;
-        msg.msg_iov        = &iov;
-        msg.msg_iovlen     = 1;
-        msg.msg_flags      = 0;
-        msg.msg_control    = cmsgbuf;
-        msg.msg_controllen = CMSG_LEN(sizeof(cmsgbuf));
-        bytes              = recvmsg(c->s, &msg, 0);
-
-        if (bytes <= 0)
-            break;
+    return 0;
+}
 
-        /* receive data is not null terminated */
-        cbuf[bytes] = '\0';
+static void
+conn_close(struct uds_server *srv, struct uds_conn *conn)
+{
+    epoll_ctl(srv->epfd, EPOLL_CTL_DEL, conn->c.s, NULL);
+    TAILQ_REMOVE(&srv->conns, conn, next);
 
-        cmsg = CMSG_FIRSTHDR(&msg);
-        if (cmsg)
-            c->cmsg = cmsg;
+    /* The socket of uds_connect() is closed by uds_destroy() */
+    if (conn->c.s != srv->info->sock)
+        close(conn->c.s);
 
-        /* find command string */
-        c->cmd     = strtok_r(cbuf, ",", &ptr);
-        c->params  = strtok_r(NULL, ",", &ptr);
-        c->params2 = strtok_r(NULL, ",", &ptr);
+    free(conn->c.buffer);
+    free(conn);
+}
 
-        /* read-lock the lists */
-        mret = pthread_rwlock_rdlock(&lck);
-        if (mret != 0) {
-            snprintf(uds_log_error, sizeof(uds_log_error), "Mutex lock failed: %s\n",
-                     strerror(mret));
-            goto leave;
-        }
+/*
+ * Receive and perform one request of a connection.
+ *
+ * @return
+ *   1 when a request is performed, 0 when no request is queued or -1 on EOF or error.
+ */
+static int
+conn_request(struct uds_conn *conn)
+{
+    uds_client_t *c = &conn->c;
+    struct msghdr msg = {0};
+    struct iovec iov;
+    int bytes, mret, ret;
+    uds_cb fn;
+    char *ptr;
+
+    iov.iov_base = conn->cbuf;
+    iov.iov_len  = sizeof(char) * UDS_MAX_CMD_LEN;
+
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = conn->cmsg.buf;
+    msg.msg_controllen = sizeof(conn->cmsg.buf);
+
+    bytes = recvmsg(c->s, &msg, MSG_DONTWAIT);
+    if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        return 0;
+    if (bytes <= 0)
+        return -1;
 
-        /* this also updates the c->cmd pointer to point to start of command */
-        fn = get_cb_fn(c, &c->cmd);
+    /* receive data is not null terminated */
+    conn->cbuf[bytes] = '\0';
 
-        mret = pthread_rwlock_unlock(&lck);
-        if (mret != 0)
-            snprintf(uds_log_error, sizeof(uds_log_error), "Mutex unlock failed: %s\n",
-                     strerror(mret));
+    c->cmsg = CMSG_FIRSTHDR(&msg);
 
-        /* TODO: by the time we do a perform command, group and command are stale */
-        perform_command(fn, c);
+    /* find command string */
+    c->cmd     = strtok_r(conn->cbuf, ",", &ptr);
+    c->params  = strtok_r(NULL, ",", &ptr);
+    c->params2 = strtok_r(NULL, ",", &ptr);
 
-        cbuf[0] = '\0';
+    /* read-lock the lists */
+    mret = pthread_rwlock_rdlock(&lck);
+    if (mret != 0) {
+        snprintf(uds_log_error, sizeof(uds_log_error), "Mutex lock failed: %s\n", strerror(mret));
+        return -1;
     }
 
-leave:
-    close(c->s);
+    /* this also updates the c->cmd pointer to point to start of command */
+    fn = get_cb_fn(c, &c->cmd);
+
+    mret = pthread_rwlock_unlock(&lck);
+    if (mret != 0)
+        snprintf(uds_log_error, sizeof(uds_log_error), "Mutex unlock failed: %s\n", strerror(mret));
 
-    free(c->buffer);
-    free(c);
+    /* TODO: by the time we do a perform command, group and command are stale */
+    ret = perform_command(fn, c);
+    if (ret < 0)
+        return -1;
+    conn->pending = ret;
 
-    return NULL;
+    return 1;
 }
 
-static void *
-socket_listener(void *_info)
+/*
+ * Serve the pipelined requests of a connection in order, at most UDS_MAX_BATCH of them so
+ * a busy client does not starve the others. The socket is level triggered, the requests
+ * left are served on the next wakeup.
+ */
+static int
+conn_event(struct uds_server *srv, struct uds_conn *conn, uint32_t events)
 {
-    uds_info_t *info = _info;
-    uds_client_t *c;
-    struct pollfd fds = {0};
+    int pending = conn->pending;
+    int ret;
 
-    int ret = pthread_setname_np(pthread_self(), "uds-sock-listen");
-    if (ret) {
-        snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't set socket name: %s\n",
-                 strerror(ret));
-        return NULL;
+    if (conn->pending) {
+        if (!(events & (EPOLLOUT | EPOLLERR | EPOLLHUP)))
+            return 0;
+        ret = send_response(&conn->c);
+        if (ret < 0)
+            return -1;
+        conn->pending = ret;
     }
-    info->running = 1;
 
-    while (info->running > 0) {
-        pthread_t th;
-        int s;
+    for (int i = 0; !conn->pending && i < UDS_MAX_BATCH; i++) {
+        ret = conn_request(conn);
+        if (ret < 0)
+            return -1;
+        if (ret == 0)
+            break;
+    }
 
-        fds.fd      = info->sock;
-        fds.events  = POLLIN;
-        fds.revents = 0;
+    if (conn->pending != pending) {
+        struct epoll_event ev = {0};
 
-        if (poll(&fds, 1, POLL_TIMEOUT) < 0)
-            break;
+        /* Wait for the socket to drain instead of reading more requests */
+        ev.events   = (conn->pending) ? EPOLLOUT : EPOLLIN;
+        ev.data.ptr = conn;
+        if (epoll_ctl(srv->epfd, EPOLL_CTL_MOD, conn->c.s, &ev) < 0)
+            return -1;
+    }
 
-        if (fds.revents != POLLIN)
-            continue;
+    return 0;
+}
+
+static void
+server_accept(struct uds_server *srv)
+{
+    for (;;) {
+        int s = accept4(srv->info->sock, NULL, NULL, SOCK_CLOEXEC);
 
-        s = accept(info->sock, NULL, NULL);
         if (s < 0) {
-            snprintf(uds_log_error, sizeof(uds_log_error),
-                     "Error with accept, process_info thread quitting\n");
-            continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                snprintf(uds_log_error, sizeof(uds_log_error), "Error with accept: %s\n",
+                         strerror(errno));
+            return;
         }
 
-        c = calloc(1, sizeof(struct uds_client));
-        if (!c) {
-            snprintf(uds_log_error, sizeof(uds_log_error),
-                     "Failed to allocate uds_client structure\n");
+        if (conn_add(srv, s, 0) < 0)
             close(s);
-            break;
+    }
+}
+
+/*
+ * The server thread of a UDS socket, all the connections are served by a single epoll loop
+ * and the callbacks are called one at a time from this thread.
+ */
+static void
+server_run(uds_info_t *info, int socket_client)
+{
+    struct epoll_event events[UDS_MAX_EVENTS];
+    struct uds_server srv = {.info = info};
+    struct uds_conn *conn, *next;
+
+    TAILQ_INIT(&srv.conns);
+
+    srv.epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (srv.epfd < 0) {
+        snprintf(uds_log_error, sizeof(uds_log_error), "Error creating epoll: %s\n",
+                 strerror(errno));
+        goto leave;
+    }
+
+    if (socket_client) {
+        /* The connected socket is served like an accepted one */
+        if (conn_add(&srv, info->sock, 1) < 0)
+            goto leave;
+    } else {
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+
+        if (epoll_ctl(srv.epfd, EPOLL_CTL_ADD, info->sock, &ev) < 0) {
+            snprintf(uds_log_error, sizeof(uds_log_error), "Error adding socket to epoll: %s\n",
+                     strerror(errno));
+            goto leave;
         }
-        c->s             = s;
-        c->info          = info;
-        c->socket_client = 0;
+    }
 
-        int ret = pthread_create(&th, NULL, client_handler, (void *)c);
-        if (ret) {
-            snprintf(uds_log_error, sizeof(uds_log_error), "Failed to start uds_client handler\n");
+    while (info->running > 0) {
+        int n = epoll_wait(srv.epfd, events, UDS_MAX_EVENTS, POLL_TIMEOUT);
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            snprintf(uds_log_error, sizeof(uds_log_error), "Error with epoll_wait: %s\n",
+                     strerror(errno));
             break;
         }
-        pthread_detach(th);
+
+        for (int i = 0; i < n; i++) {
+            conn = events[i].data.ptr;
+
+            if (conn == NULL)
+                server_accept(&srv);
+            else if (conn_event(&srv, conn, events[i].events) < 0)
+                conn_close(&srv, conn);
+        }
     }
+
+leave:
+    TAILQ_FOREACH_SAFE (conn, &srv.conns, next, next)
+        conn_close(&srv, conn);
+    if (srv.epfd >= 0)
+        close(srv.epfd);
+}
+
+static void *
+socket_listener(void *_info)
+{
+    uds_info_t *info = _info;
+
+    int ret = pthread_setname_np(pthread_self(), "uds-sock-listen");
+    if (ret)
+        snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't set socket name: %s\n",
+                 strerror(ret));
+
+    server_run(info, 0);
+
+    info->running = -1; /* signal the listener has stopped */
+
+    return NULL;
+}
+
+static void *
+socket_client(void *_info)
+{
+    uds_info_t *info = _info;
+
+    int ret = pthread_setname_np(pthread_self(), "uds-sock-client");
+    if (ret)
+        snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't set socket name: %s\n",
+                 strerror(ret));
+
+    server_run(info, 1);
+
     info->running = -1; /* signal the listener has stopped */
 
     return NULL;
@@ -702,7 +873,8 @@ uds_create(const char *runtime_dir, const char *uds_name, const char **err_str,
 
     info->priv = priv;
 
-    info->sock = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    /* The listener is non-blocking, the server thread accepts until the queue is empty */
+    info->sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (info->sock < 0) {
         snprintf(uds_log_error, sizeof(uds_log_error), "Error with socket creation, %s",
                  strerror(errno));
@@ -753,18 +925,22 @@ uds_create(const char *runtime_dir, const char *uds_name, const char **err_str,
         goto error;
     }
 
-    if (listen(info->sock, 1) < 0) {
+    if (listen(info->sock, SOMAXCONN) < 0) {
         snprintf(uds_log_error, sizeof(uds_log_error), "Error calling listen for socket: %s",
                  strerror(errno));
         goto error;
     }
 
-    int ret = pthread_create(&th, NULL, socket_listener, info);
+    /* Set before the thread starts so uds_destroy() always waits for it */
+    info->running = 1;
+    int ret       = pthread_create(&th, NULL, socket_listener, info);
     if (ret) {
+        info->running = 0;
         snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't create thread: %s\n",
                  strerror(ret));
         goto error;
     }
+    pthread_detach(th);
 
     return info;
 
@@ -775,55 +951,6 @@ error:
     return NULL;
 }
 
-static void *
-socket_client(void *_info)
-{
-    uds_info_t *info = _info;
-    uds_client_t *c;
-    struct pollfd fds = {0};
-
-    int ret = pthread_setname_np(pthread_self(), "uds-sock-client");
-    if (ret) {
-        snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't set socket name: %s\n",
-                 strerror(ret));
-        return NULL;
-    }
-    info->running = 1;
-
-    while (info->running > 0) {
-        pthread_t th;
-
-        fds.fd      = info->sock;
-        fds.events  = POLLIN;
-        fds.revents = 0;
-
-        if (poll(&fds, 1, POLL_TIMEOUT) < 0)
-            break;
-
-        if (fds.revents != POLLIN)
-            continue;
-
-        c = calloc(1, sizeof(struct uds_client));
-        if (!c)
-            break;
-
-        c->s             = info->sock;
-        c->info          = info;
-        c->socket_client = 1;
-
-        int ret = pthread_create(&th, NULL, client_handler, (void *)c);
-        if (ret) {
-            snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't create thread: %s\n",
-                     strerror(ret));
-            break;
-        }
-        pthread_detach(th);
-    }
-    info->running = -1; /* signal the listener has stopped */
-
-    return NULL;
-}
-
 const uds_group_t *
 uds_get_group_by_name(const uds_info_t *info, const char *name)
 {
@@ -891,7 +1018,7 @@ uds_connect(const char *uds_name, const char **err_str, void *priv)
 
     info->priv = priv;
 
-    info->sock = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    info->sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
     if (info->sock < 0) {
         snprintf(uds_log_error, sizeof(uds_log_error), "Error with socket creation, %s",
                  strerror(errno));
@@ -908,12 +1035,15 @@ uds_connect(const char *uds_name, const char **err_str, void *priv)
         goto error;
     }
 
-    int ret = pthread_create(&th, NULL, socket_client, info);
+    info->running = 1;
+    int ret       = pthread_create(&th, NULL, socket_client, info);
     if (ret) {
+        info->running = 0;
         snprintf(uds_log_error, sizeof(uds_log_error), "Error Couldn't create thread: %s\n",
                  strerror(ret));
         goto error;
     }
+    pthread_detach(th);
 
     return info;
 
@@ -1024,17 +1154,12 @@ uds_destroy(uds_info_t *_info)
     free(info);
 }
 
-__attribute__((__format__(__printf__, 2, 0))) int
-uds_append(uds_client_t *_c, const char *format, ...)
+/* Make room for len more bytes plus some extra space in the output buffer */
+static int
+uds_reserve(struct uds_client *c, int len)
 {
-    struct uds_client *c = _c;
-    va_list ap;
-    char str[PATH_MAX];
-    int ret, nbytes;
-
-    va_start(ap, format);
-    ret = vsnprintf(str, sizeof(str), format, ap);
-    va_end(ap);
+    int max = (c->binary) ? UDS_MAX_BIN_LEN : UDS_MAX_BUF_LEN;
+    int nbytes;
 
     /* First time just allocate some memory to use for buffer */
     if (c->buffer == NULL) {
@@ -1048,14 +1173,20 @@ uds_append(uds_client_t *_c, const char *format, ...)
         c->used    = 0;
     }
 
-    nbytes = (ret + c->used) + UDS_EXTRA_SPACE;
+    nbytes = (len + c->used) + UDS_EXTRA_SPACE;
+
+    /*
+     * Check the cap on every append, the buffer kept from a binary response is larger
+     * than a text response is allowed to be.
+     */
+    if (nbytes > max)
+        return -1;
 
     /* Increase size of buffer if required */
     if (nbytes > c->buf_len) {
-
-        /* Make sure the max length is capped to a max size */
-        if (nbytes > UDS_MAX_BUF_LEN)
-            return -1;
+        /* Double the buffer so a large response does not realloc on every append */
+        if (nbytes < (2 * c->buf_len))
+            nbytes = CNE_MIN(2 * c->buf_len, max);
 
         /* expand the buffer space */
         char *p = realloc(c->buffer, nbytes);
@@ -1067,8 +1198,59 @@ uds_append(uds_client_t *_c, const char *format, ...)
         c->buf_len = nbytes;
     }
 
+    return 0;
+}
+
+__attribute__((__format__(__printf__, 2, 0))) int
+uds_append(uds_client_t *_c, const char *format, ...)
+{
+    struct uds_client *c = _c;
+    va_list ap;
+    char str[PATH_MAX];
+    int ret;
+
+    va_start(ap, format);
+    ret = vsnprintf(str, sizeof(str), format, ap);
+    va_end(ap);
+
+    if (ret < 0)
+        return -1;
+    if (ret >= (int)sizeof(str))
+        ret = sizeof(str) - 1;
+
+    if (uds_reserve(c, ret) < 0)
+        return -1;
+
     /* Add the new string data to the buffer */
-    c->used = strlcat(c->buffer, str, c->buf_len);
+    memcpy(&c->buffer[c->used], str, ret + 1);
+    c->used += ret;
+
+    return 0;
+}
+
+int
+uds_append_binary(uds_client_t *_c, const void *data, int len)
+{
+    struct uds_client *c = _c;
+
+    if (!c || len < 0 || (!data && len)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    /* The first binary data replaces the text of the response, i.e. the opening brace */
+    if (!c->binary) {
+        c->binary = 1;
+        c->used   = 0;
+    }
+
+    if (uds_reserve(c, len) < 0)
+        return -1;
+
+    if (len) {
+        memcpy(&c->buffer[c->used], data, len);
+        c->used += len;
+    }
 
     return 0;
 }
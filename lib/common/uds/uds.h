@@ -6,6 +6,12 @@
  * @file
  *
  * uds-related utility functions
+ *
+ * Each UDS socket is served by a single thread using epoll, the callbacks of a socket are
+ * called one at a time from this thread. A client can send several requests without
+ * waiting for the responses, the responses are sent in the order of the requests. The
+ * response of a request is one message, a JSON object built with uds_append() or raw
+ * bytes built with uds_append_binary().
  */
 
 #ifndef _UDS_H_
@@ -49,6 +55,7 @@ typedef struct uds_client {
     struct cmsghdr *cmsg;          /**< pointer to ancillary data, if present */
     const struct uds_group *group; /**< Pointer to group info */
     int socket_client;             /**< set to 1 - client, 0 - listener */
+    int binary;                    /**< set to 1 when the response is binary data */
 } uds_client_t;
 
 typedef struct uds_info {
@@ -90,6 +97,9 @@ enum {
  * callback returns json data in buffer, up to buf_len long.
  * returns 0 on success, UDS_NO_OUTPUT on success and to indicate that UDS should not send
  * any output in its buffer, or an otherwise negative value indicate failure.
+ *
+ * The callback runs on the server thread of the socket and delays the requests of every
+ * client until it returns, it must not block for long.
  */
 typedef int (*uds_cb)(uds_client_t *client, const char *cmd, const char *params);
 
@@ -206,6 +216,24 @@ CNDP_API void uds_destroy(uds_info_t *info);
  */
 CNDP_API int uds_append(uds_client_t *client, const char *format, ...);
 
+/**
+ * Append binary data to the output buffer, used for bulk data like statistics tables.
+ *
+ * The first call turns the response into raw bytes, the JSON braces and the text appended
+ * before are dropped. The response is sent as one message of up to the max_binary_len
+ * reported by the /info command.
+ *
+ * @param client
+ *   The client pointer that holds the buffer to append the data.
+ * @param data
+ *   The data to append
+ * @param len
+ *   The number of bytes to append
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int uds_append_binary(uds_client_t *client, const void *data, int len);
+
 /**
  * Return the command string pointer
  *
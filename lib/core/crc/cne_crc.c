@@ -0,0 +1,596 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2019-2023 Intel Corporation
+ */
+
+#include <stdint.h>                       // for uint32_t, uint8_t, uint16_t, uint64_t
+#include <string.h>                       // for memcpy, memset
+#include <x86intrin.h>                    // for _mm_crc32_u64, _mm_clmulepi64_si128
+#include <cne_common.h>                   // for CNE_INIT_PRIO, __cne_always_inline
+#include <cne_branch_prediction.h>        // for likely, unlikely
+#include <cne_cpuflags.h>                 // for cne_cpu_get_flag_enabled, CNE_CPUFLAG_...
+
+#include "cne_crc.h"
+
+/** CRC polynomials */
+#define CRC32_ETH_POLYNOMIAL   0x04c11db7UL
+#define CRC16_CCITT_POLYNOMIAL 0x1021U
+#define CRC32C_POLYNOMIAL      0x82f63b78UL /* reflected */
+
+#define CRC_LUT_SIZE 256
+
+/* Block sizes of the three CRC32C streams, the shift tables only handle powers of 2 */
+#define CRC32C_LONG  8192
+#define CRC32C_SHORT (CNE_CRC32C_INTERLEAVE_MIN / 3)
+
+/* Unaligned words, avoiding the strict-aliasing warnings */
+typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) crc_u64_t;
+typedef uint32_t __attribute__((__may_alias__, __aligned__(1))) crc_u32_t;
+typedef uint16_t __attribute__((__may_alias__, __aligned__(1))) crc_u16_t;
+
+#define crc_ld64(p) (*(const crc_u64_t *)(uintptr_t)(p))
+#define crc_ld32(p) (*(const crc_u32_t *)(uintptr_t)(p))
+#define crc_ld16(p) (*(const crc_u16_t *)(uintptr_t)(p))
+
+/* crc tables */
+static uint32_t crc32_eth_lut[CRC_LUT_SIZE];
+static uint32_t crc16_ccitt_lut[CRC_LUT_SIZE];
+
+/* Operators appending CRC32C_LONG and CRC32C_SHORT zero bytes to a CRC32C register */
+static uint32_t crc32c_long[4][CRC_LUT_SIZE];
+static uint32_t crc32c_short[4][CRC_LUT_SIZE];
+
+/** PCLMULQDQ CRC computation context structure */
+struct crc_pclmulqdq_ctx {
+    __m128i rk1_rk2; /**< Fold by 16 bytes */
+    __m128i rk3_rk4; /**< Fold by 64 bytes */
+    __m128i rk5_rk6;
+    __m128i rk7_rk8;
+};
+
+static struct crc_pclmulqdq_ctx crc32_eth_pclmulqdq __cne_aligned(16);
+static struct crc_pclmulqdq_ctx crc16_ccitt_pclmulqdq __cne_aligned(16);
+
+static enum cne_crc_alg crc_alg = CNE_CRC_SCALAR;
+
+/**
+ * Reflect a 32-bit value, bit 0 becomes bit 31.
+ */
+static uint32_t
+reflect_32bits(uint32_t val)
+{
+    uint32_t i, res = 0;
+
+    for (i = 0; i < 32; i++)
+        if ((val & (1U << i)) != 0)
+            res |= (uint32_t)(1U << (31 - i));
+
+    return res;
+}
+
+static void
+crc32_eth_init_lut(uint32_t poly, uint32_t *lut)
+{
+    uint32_t i, j;
+
+    for (i = 0; i < CRC_LUT_SIZE; i++) {
+        uint32_t crc = reflect_32bits(i);
+
+        for (j = 0; j < 8; j++) {
+            if (crc & 0x80000000L)
+                crc = (crc << 1) ^ poly;
+            else
+                crc <<= 1;
+        }
+        lut[i] = reflect_32bits(crc);
+    }
+}
+
+static __cne_always_inline uint32_t
+crc32_eth_calc_lut(const uint8_t *data, uint32_t data_len, uint32_t crc, const uint32_t *lut)
+{
+    while (data_len--)
+        crc = lut[(crc ^ *data++) & 0xffL] ^ (crc >> 8);
+
+    return crc;
+}
+
+/* Multiply the 32x32 GF(2) matrix mat by the vector vec */
+static uint32_t
+gf2_matrix_times(const uint32_t *mat, uint32_t vec)
+{
+    uint32_t sum = 0;
+
+    for (; vec; vec >>= 1, mat++)
+        if (vec & 1)
+            sum ^= *mat;
+
+    return sum;
+}
+
+static void
+gf2_matrix_square(uint32_t *square, const uint32_t *mat)
+{
+    for (int n = 0; n < 32; n++)
+        square[n] = gf2_matrix_times(mat, mat[n]);
+}
+
+/**
+ * Build the tables shifting a CRC32C register by len zero bytes, len must be a power of 2.
+ *
+ * The register of a buffer A followed by a buffer B is the shifted register of A xor the
+ * register of B computed from 0, which combines the streams of the interleaved CRC32C.
+ */
+static void
+crc32c_zeros_init(uint32_t zeros[][CRC_LUT_SIZE], uint32_t len)
+{
+    uint32_t even[32], odd[32], *op = even;
+    uint32_t row = 1;
+
+    /* Operator for one zero bit */
+    odd[0] = CRC32C_POLYNOMIAL;
+    for (int n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    gf2_matrix_square(even, odd); /* 2 zero bits */
+    gf2_matrix_square(odd, even); /* 4 zero bits */
+
+    /* The first square is the operator for one zero byte, each next one doubles the length */
+    for (;;) {
+        gf2_matrix_square(even, odd);
+        op = even;
+        len >>= 1;
+        if (len == 0)
+            break;
+        gf2_matrix_square(odd, even);
+        op = odd;
+        len >>= 1;
+        if (len == 0)
+            break;
+    }
+
+    for (uint32_t n = 0; n < CRC_LUT_SIZE; n++) {
+        zeros[0][n] = gf2_matrix_times(op, n);
+        zeros[1][n] = gf2_matrix_times(op, n << 8);
+        zeros[2][n] = gf2_matrix_times(op, n << 16);
+        zeros[3][n] = gf2_matrix_times(op, n << 24);
+    }
+}
+
+static __cne_always_inline uint32_t
+crc32c_shift(const uint32_t zeros[][CRC_LUT_SIZE], uint32_t crc)
+{
+    return zeros[0][crc & 0xff] ^ zeros[1][(crc >> 8) & 0xff] ^ zeros[2][(crc >> 16) & 0xff] ^
+           zeros[3][crc >> 24];
+}
+
+static __cne_always_inline uint32_t
+crc32c_sse42(const uint8_t *p, uint32_t len, uint32_t crc)
+{
+    uint64_t crc64 = crc;
+
+    for (; len >= 8; len -= 8, p += 8)
+        crc64 = _mm_crc32_u64(crc64, crc_ld64(p));
+    crc = (uint32_t)crc64;
+
+    if (len & 4) {
+        crc = _mm_crc32_u32(crc, crc_ld32(p));
+        p += 4;
+    }
+    if (len & 2) {
+        crc = _mm_crc32_u16(crc, crc_ld16(p));
+        p += 2;
+    }
+    if (len & 1)
+        crc = _mm_crc32_u8(crc, *p);
+
+    return crc;
+}
+
+/**
+ * Compute the CRC32C of the blocks of 3 * blk bytes with three independent streams.
+ *
+ * The crc32 instruction has a latency of 3 cycles and a throughput of 1 per cycle, the
+ * streams of the three thirds of a block run in parallel and are combined at the end.
+ */
+static __cne_always_inline uint32_t
+crc32c_3way(const uint8_t **pp, uint32_t *plen, uint32_t crc, uint32_t blk,
+            const uint32_t zeros[][CRC_LUT_SIZE])
+{
+    const uint8_t *p = *pp;
+    uint32_t len     = *plen;
+
+    for (; len >= 3 * blk; len -= 3 * blk, p += 2 * blk) {
+        const uint8_t *end = p + blk;
+        uint64_t crc0 = crc, crc1 = 0, crc2 = 0;
+
+        do {
+            crc0 = _mm_crc32_u64(crc0, crc_ld64(p));
+            crc1 = _mm_crc32_u64(crc1, crc_ld64(p + blk));
+            crc2 = _mm_crc32_u64(crc2, crc_ld64(p + 2 * blk));
+            p += 8;
+        } while (p < end);
+
+        crc = crc32c_shift(zeros, (uint32_t)crc0) ^ (uint32_t)crc1;
+        crc = crc32c_shift(zeros, crc) ^ (uint32_t)crc2;
+    }
+    *pp   = p;
+    *plen = len;
+
+    return crc;
+}
+
+uint32_t
+cne_crc32c(const void *data, uint32_t len, uint32_t init)
+{
+    const uint8_t *p = data;
+    uint32_t crc     = init;
+
+    if (len >= CNE_CRC32C_INTERLEAVE_MIN) {
+        crc = crc32c_3way(&p, &len, crc, CRC32C_LONG, crc32c_long);
+        crc = crc32c_3way(&p, &len, crc, CRC32C_SHORT, crc32c_short);
+    }
+
+    return crc32c_sse42(p, len, crc);
+}
+
+void
+cne_crc32c_bulk(const void *const keys[], uint32_t len, uint32_t init, uint32_t crcs[],
+                uint32_t nb_keys)
+{
+    uint32_t i = 0;
+
+    /* Four keys at a time, the crc32 instructions of the keys do not depend on each other */
+    for (; i + 4 <= nb_keys; i += 4) {
+        const uint8_t *k0 = keys[i], *k1 = keys[i + 1], *k2 = keys[i + 2], *k3 = keys[i + 3];
+        uint64_t c0 = init, c1 = init, c2 = init, c3 = init;
+        uint32_t off = 0;
+
+        for (; off + 8 <= len; off += 8) {
+            c0 = _mm_crc32_u64(c0, crc_ld64(k0 + off));
+            c1 = _mm_crc32_u64(c1, crc_ld64(k1 + off));
+            c2 = _mm_crc32_u64(c2, crc_ld64(k2 + off));
+            c3 = _mm_crc32_u64(c3, crc_ld64(k3 + off));
+        }
+        if (len & 4) {
+            c0 = _mm_crc32_u32((uint32_t)c0, crc_ld32(k0 + off));
+            c1 = _mm_crc32_u32((uint32_t)c1, crc_ld32(k1 + off));
+            c2 = _mm_crc32_u32((uint32_t)c2, crc_ld32(k2 + off));
+            c3 = _mm_crc32_u32((uint32_t)c3, crc_ld32(k3 + off));
+            off += 4;
+        }
+        if (len & 2) {
+            c0 = _mm_crc32_u16((uint32_t)c0, crc_ld16(k0 + off));
+            c1 = _mm_crc32_u16((uint32_t)c1, crc_ld16(k1 + off));
+            c2 = _mm_crc32_u16((uint32_t)c2, crc_ld16(k2 + off));
+            c3 = _mm_crc32_u16((uint32_t)c3, crc_ld16(k3 + off));
+            off += 2;
+        }
+        if (len & 1) {
+            c0 = _mm_crc32_u8((uint32_t)c0, k0[off]);
+            c1 = _mm_crc32_u8((uint32_t)c1, k1[off]);
+            c2 = _mm_crc32_u8((uint32_t)c2, k2[off]);
+            c3 = _mm_crc32_u8((uint32_t)c3, k3[off]);
+        }
+
+        crcs[i]     = (uint32_t)c0;
+        crcs[i + 1] = (uint32_t)c1;
+        crcs[i + 2] = (uint32_t)c2;
+        crcs[i + 3] = (uint32_t)c3;
+    }
+
+    for (; i < nb_keys; i++)
+        crcs[i] = cne_crc32c(keys[i], len, init);
+}
+
+#define __crc_pclmul __attribute__((target("pclmul")))
+
+/**
+ * @brief Performs one folding round
+ *
+ * Logically function operates as follows:
+ *     DATA = READ_NEXT_16BYTES();
+ *     F1 = LSB8(FOLD)
+ *     F2 = MSB8(FOLD)
+ *     T1 = CLMUL(F1, RK1)
+ *     T2 = CLMUL(F2, RK2)
+ *     FOLD = XOR(T1, T2, DATA)
+ *
+ * @param data_block
+ *   16 byte data block
+ * @param precomp
+ *   Precomputed rk1 constant
+ * @param fold
+ *   Current16 byte folded data
+ *
+ * @return
+ *   New 16 byte folded data
+ */
+static __cne_always_inline __crc_pclmul __m128i
+crcr32_folding_round(__m128i data_block, __m128i precomp, __m128i fold)
+{
+    __m128i tmp0 = _mm_clmulepi64_si128(fold, precomp, 0x01);
+    __m128i tmp1 = _mm_clmulepi64_si128(fold, precomp, 0x10);
+
+    return _mm_xor_si128(tmp1, _mm_xor_si128(data_block, tmp0));
+}
+
+/**
+ * Performs reduction from 128 bits to 64 bits
+ *
+ * @param data128
+ *   128 bits data to be reduced
+ * @param precomp
+ *   precomputed constants rk5, rk6
+ *
+ * @return
+ *  64 bits reduced data
+ */
+static __cne_always_inline __crc_pclmul __m128i
+crcr32_reduce_128_to_64(__m128i data128, __m128i precomp)
+{
+    __m128i tmp0, tmp1, tmp2;
+
+    /* 64b fold */
+    tmp0 = _mm_clmulepi64_si128(data128, precomp, 0x00);
+    tmp1 = _mm_srli_si128(data128, 8);
+    tmp0 = _mm_xor_si128(tmp0, tmp1);
+
+    /* 32b fold */
+    tmp2 = _mm_slli_si128(tmp0, 4);
+    tmp1 = _mm_clmulepi64_si128(tmp2, precomp, 0x10);
+
+    return _mm_xor_si128(tmp1, tmp0);
+}
+
+/**
+ * Performs Barret's reduction from 64 bits to 32 bits
+ *
+ * @param data64
+ *   64 bits data to be reduced
+ * @param precomp
+ *   rk7 precomputed constant
+ *
+ * @return
+ *   reduced 32 bits data
+ */
+static __cne_always_inline __crc_pclmul uint32_t
+crcr32_reduce_64_to_32(__m128i data64, __m128i precomp)
+{
+    static const uint32_t mask1[4] __cne_aligned(16) = {0xffffffff, 0xffffffff, 0x00000000,
+                                                        0x00000000};
+
+    static const uint32_t mask2[4] __cne_aligned(16) = {0x00000000, 0xffffffff, 0xffffffff,
+                                                        0xffffffff};
+    __m128i tmp0, tmp1, tmp2;
+
+    tmp0 = _mm_and_si128(data64, _mm_load_si128((const __m128i *)mask2));
+
+    tmp1 = _mm_clmulepi64_si128(tmp0, precomp, 0x00);
+    tmp1 = _mm_xor_si128(tmp1, tmp0);
+    tmp1 = _mm_and_si128(tmp1, _mm_load_si128((const __m128i *)mask1));
+
+    tmp2 = _mm_clmulepi64_si128(tmp1, precomp, 0x10);
+    tmp2 = _mm_xor_si128(tmp2, tmp1);
+    tmp2 = _mm_xor_si128(tmp2, tmp0);
+
+    return _mm_extract_epi32(tmp2, 2);
+}
+
+static const uint8_t crc_xmm_shift_tab[48] __cne_aligned(16) = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+/**
+ * Shifts left 128 bit register by specified number of bytes
+ *
+ * @param reg
+ *   128 bit value
+ * @param num
+ *   number of bytes to shift left reg by (0-16)
+ *
+ * @return
+ *   reg << (num * 8)
+ */
+static __cne_always_inline __m128i
+xmm_shift_left(__m128i reg, const unsigned int num)
+{
+    const __m128i *p = (const __m128i *)(crc_xmm_shift_tab + 16 - num);
+
+    return _mm_shuffle_epi8(reg, _mm_loadu_si128(p));
+}
+
+static __crc_pclmul uint32_t
+crc32_eth_calc_pclmulqdq(const uint8_t *data, uint32_t data_len, uint32_t crc,
+                         const struct crc_pclmulqdq_ctx *params)
+{
+    __m128i temp, fold, k;
+    uint32_t n;
+
+    /* Get CRC init value */
+    temp = _mm_insert_epi32(_mm_setzero_si128(), crc, 0);
+
+    /**
+     * Folding all data into single 16 byte data block
+     * Assumes: fold holds first 16 bytes of data
+     */
+
+    if (unlikely(data_len < 32)) {
+        if (unlikely(data_len == 16)) {
+            /* 16 bytes */
+            fold = _mm_loadu_si128((const __m128i *)data);
+            fold = _mm_xor_si128(fold, temp);
+            goto reduction_128_64;
+        }
+
+        if (unlikely(data_len < 16)) {
+            /* 0 to 15 bytes */
+            uint8_t buffer[16] __cne_aligned(16);
+
+            memset(buffer, 0, sizeof(buffer));
+            memcpy(buffer, data, data_len);
+
+            fold = _mm_load_si128((const __m128i *)buffer);
+            fold = _mm_xor_si128(fold, temp);
+            if (unlikely(data_len < 4)) {
+                fold = xmm_shift_left(fold, 8 - data_len);
+                goto barret_reduction;
+            }
+            fold = xmm_shift_left(fold, 16 - data_len);
+            goto reduction_128_64;
+        }
+        /* 17 to 31 bytes */
+        fold = _mm_loadu_si128((const __m128i *)data);
+        fold = _mm_xor_si128(fold, temp);
+        n    = 16;
+        k    = params->rk1_rk2;
+        goto partial_bytes;
+    }
+
+    /** At least 32 bytes in the buffer */
+    /** Apply CRC initial value */
+    fold = _mm_loadu_si128((const __m128i *)data);
+    fold = _mm_xor_si128(fold, temp);
+    n    = 16;
+
+    /**
+     * Fold four independent 16 byte blocks by 64 bytes to hide the latency of the
+     * multiplications, then fold them into a single block.
+     */
+    if (data_len >= 128) {
+        __m128i fold1 = _mm_loadu_si128((const __m128i *)&data[16]);
+        __m128i fold2 = _mm_loadu_si128((const __m128i *)&data[32]);
+        __m128i fold3 = _mm_loadu_si128((const __m128i *)&data[48]);
+
+        k = params->rk3_rk4;
+        for (n = 64; (n + 64) <= data_len; n += 64) {
+            fold  = crcr32_folding_round(_mm_loadu_si128((const __m128i *)&data[n]), k, fold);
+            fold1 = crcr32_folding_round(_mm_loadu_si128((const __m128i *)&data[n + 16]), k, fold1);
+            fold2 = crcr32_folding_round(_mm_loadu_si128((const __m128i *)&data[n + 32]), k, fold2);
+            fold3 = crcr32_folding_round(_mm_loadu_si128((const __m128i *)&data[n + 48]), k, fold3);
+        }
+
+        k    = params->rk1_rk2;
+        fold = crcr32_folding_round(fold1, k, fold);
+        fold = crcr32_folding_round(fold2, k, fold);
+        fold = crcr32_folding_round(fold3, k, fold);
+    }
+
+    /** Main folding loop - the last 16 bytes is processed separately */
+    k = params->rk1_rk2;
+    for (; (n + 16) <= data_len; n += 16) {
+        temp = _mm_loadu_si128((const __m128i *)&data[n]);
+        fold = crcr32_folding_round(temp, k, fold);
+    }
+
+partial_bytes:
+    if (likely(n < data_len)) {
+
+        const uint32_t mask3[4] __cne_aligned(16) = {0x80808080, 0x80808080, 0x80808080,
+                                                     0x80808080};
+
+        const uint8_t shf_table[32] __cne_aligned(16) = {
+            0x00, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a,
+            0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+            0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+
+        __m128i last16, a, b;
+
+        last16 = _mm_loadu_si128((const __m128i *)&data[data_len - 16]);
+
+        temp = _mm_loadu_si128((const __m128i *)&shf_table[data_len & 15]);
+        a    = _mm_shuffle_epi8(fold, temp);
+
+        temp = _mm_xor_si128(temp, _mm_load_si128((const __m128i *)mask3));
+        b    = _mm_shuffle_epi8(fold, temp);
+        b    = _mm_blendv_epi8(b, last16, temp);
+
+        /* k = rk1 & rk2 */
+        temp = _mm_clmulepi64_si128(a, k, 0x01);
+        fold = _mm_clmulepi64_si128(a, k, 0x10);
+
+        fold = _mm_xor_si128(fold, temp);
+        fold = _mm_xor_si128(fold, b);
+    }
+
+    /** Reduction 128 -> 32 Assumes: fold holds 128bit folded data */
+reduction_128_64:
+    k    = params->rk5_rk6;
+    fold = crcr32_reduce_128_to_64(fold, k);
+
+barret_reduction:
+    k = params->rk7_rk8;
+    n = crcr32_reduce_64_to_32(fold, k);
+
+    return n;
+}
+
+static void
+crc_pclmulqdq_init(void)
+{
+    /**
+     * The folding constants are (x^n mod P) reflected and shifted left by one bit, where n
+     * is the distance of the fold in bits plus or minus 32, and P is x^16 times the CRC16
+     * polynomial for CRC16.
+     */
+    crc16_ccitt_pclmulqdq.rk1_rk2 = _mm_set_epi64x(0x8e10, 0x189ae);
+    crc16_ccitt_pclmulqdq.rk3_rk4 = _mm_set_epi64x(0x19a3c, 0x14ff2);
+    crc16_ccitt_pclmulqdq.rk5_rk6 = _mm_set_epi64x(0x114aa, 0x189ae);
+    crc16_ccitt_pclmulqdq.rk7_rk8 = _mm_set_epi64x(0x10811, 0x11c581910);
+
+    crc32_eth_pclmulqdq.rk1_rk2 = _mm_set_epi64x(0x1751997d0, 0xccaa009e);
+    crc32_eth_pclmulqdq.rk3_rk4 = _mm_set_epi64x(0x154442bd4, 0x1c6e41596);
+    crc32_eth_pclmulqdq.rk5_rk6 = _mm_set_epi64x(0x163cd6124, 0xccaa009e);
+    crc32_eth_pclmulqdq.rk7_rk8 = _mm_set_epi64x(0x1db710641, 0x1f7011640);
+}
+
+uint32_t
+cne_crc32_eth(const void *data, uint32_t len)
+{
+    if (likely(crc_alg == CNE_CRC_PCLMULQDQ))
+        return ~crc32_eth_calc_pclmulqdq(data, len, 0xffffffffUL, &crc32_eth_pclmulqdq);
+
+    return ~crc32_eth_calc_lut(data, len, 0xffffffffUL, crc32_eth_lut);
+}
+
+uint16_t
+cne_crc16_ccitt(const void *data, uint32_t len)
+{
+    if (likely(crc_alg == CNE_CRC_PCLMULQDQ))
+        return (uint16_t)~crc32_eth_calc_pclmulqdq(data, len, 0xffff, &crc16_ccitt_pclmulqdq);
+
+    return (uint16_t)~crc32_eth_calc_lut(data, len, 0xffff, crc16_ccitt_lut);
+}
+
+int
+cne_crc_set_alg(enum cne_crc_alg alg)
+{
+    switch (alg) {
+    case CNE_CRC_PCLMULQDQ:
+        if (cne_cpu_get_flag_enabled(CNE_CPUFLAG_PCLMULQDQ) != 1)
+            return -1;
+        /* fall-through */
+    case CNE_CRC_SCALAR:
+        crc_alg = alg;
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+/* Build the tables and select the highest available crc algorithm */
+CNE_INIT_PRIO(cne_crc_init, INIT)
+{
+    crc32_eth_init_lut(CRC32_ETH_POLYNOMIAL, crc32_eth_lut);
+    crc32_eth_init_lut(CRC16_CCITT_POLYNOMIAL << 16, crc16_ccitt_lut);
+
+    crc32c_zeros_init(crc32c_long, CRC32C_LONG);
+    crc32c_zeros_init(crc32c_short, CRC32C_SHORT);
+
+    crc_pclmulqdq_init();
+
+    if (cne_crc_set_alg(CNE_CRC_PCLMULQDQ) < 0)
+        cne_crc_set_alg(CNE_CRC_SCALAR);
+}
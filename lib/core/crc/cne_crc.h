@@ -0,0 +1,115 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2019-2023 Intel Corporation
+ */
+
+#ifndef _CNE_CRC_H_
+#define _CNE_CRC_H_
+
+/**
+ * @file
+ *
+ * CRC routines shared by the CNDP libraries and applications.
+ *
+ * cne_crc32c() computes the CRC32C (Castagnoli) register with the SSE4.2 crc32 instruction,
+ * which every CNDP build requires. Buffers of CNE_CRC32C_INTERLEAVE_MIN bytes or more are
+ * split in three streams to hide the latency of the instruction. cne_crc32c_bulk() hashes a
+ * burst of keys of the same length together for the same reason, and is used by the bulk
+ * lookups of cne_hash tables created with the default hash function.
+ *
+ * cne_crc32_eth() and cne_crc16_ccitt() fold the buffer with the PCLMULQDQ instruction when
+ * the CPU has it, or use a lookup table.
+ */
+
+#include <stdint.h>            // for uint32_t, uint16_t
+#include <cne_common.h>        // for CNDP_API
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_CRC32C_INTERLEAVE_MIN 768 /**< Smaller buffers are a single crc32 stream */
+
+/** CRC compute algorithm of cne_crc32_eth() and cne_crc16_ccitt() */
+enum cne_crc_alg {
+    CNE_CRC_SCALAR = 0, /**< Lookup table */
+    CNE_CRC_PCLMULQDQ,  /**< Carry-less multiplication folding */
+};
+
+/**
+ * Compute the CRC32C of a buffer
+ *
+ * The value is the CRC register without the final inversion, which is the same value as
+ * cne_hash_crc() and makes the function usable as a cne_hash_function. The CRC32C checksum
+ * of iSCSI or SCTP is ~cne_crc32c(data, len, 0xffffffff).
+ *
+ * @param data
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer in bytes.
+ * @param init
+ *   Initial value of the CRC register, e.g. the value returned for the previous part.
+ * @return
+ *   The CRC32C register value.
+ */
+CNDP_API uint32_t cne_crc32c(const void *data, uint32_t len, uint32_t init);
+
+/**
+ * Compute the CRC32C of a burst of keys of the same length
+ *
+ * The result of each key is the same as cne_crc32c(keys[i], len, init).
+ *
+ * @param keys
+ *   Array of pointers to the keys.
+ * @param len
+ *   Length of every key in bytes.
+ * @param init
+ *   Initial value of the CRC register.
+ * @param crcs
+ *   Array to store the CRC32C of each key.
+ * @param nb_keys
+ *   Number of keys in the burst.
+ */
+CNDP_API void cne_crc32c_bulk(const void *const keys[], uint32_t len, uint32_t init,
+                              uint32_t crcs[], uint32_t nb_keys);
+
+/**
+ * Compute the Ethernet CRC32 of a buffer, e.g. the FCS of a frame
+ *
+ * @param data
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer in bytes.
+ * @return
+ *   The CRC32.
+ */
+CNDP_API uint32_t cne_crc32_eth(const void *data, uint32_t len);
+
+/**
+ * Compute the CRC16 CCITT of a buffer
+ *
+ * @param data
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer in bytes.
+ * @return
+ *   The CRC16.
+ */
+CNDP_API uint16_t cne_crc16_ccitt(const void *data, uint32_t len);
+
+/**
+ * Select the algorithm of cne_crc32_eth() and cne_crc16_ccitt()
+ *
+ * The fastest algorithm of the CPU is selected at startup.
+ *
+ * @param alg
+ *   The algorithm to use.
+ * @return
+ *   0 on success or -1 if the CPU does not support the algorithm.
+ */
+CNDP_API int cne_crc_set_alg(enum cne_crc_alg alg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_CRC_H_ */
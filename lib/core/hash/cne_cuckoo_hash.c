@@ -19,8 +19,8 @@
 
 #include "cne_hash.h"        // for cne_hash_parameters, CNE_HASH_LOO...
 #include "cne_cuckoo_hash.h"
-#include "cne_hash_crc.h"        // for cne_hash_crc
 #include "cne_jhash.h"           // for cne_jhash
+#include "cne_crc.h"             // for cne_crc32c, cne_crc32c_bulk
 #include "cne_ring_api.h"        // for cne_ring_enqueue_elem, cne_ring_free
 
 /* Mask of all flags supported by this version */
@@ -260,8 +260,8 @@ cne_hash_create(const struct cne_hash_parameters *params)
         h->cmp_jump_table_idx = KEY_OTHER_BYTES;
     }
 
-    /* Default hash function */
-    default_hash_func = (cne_hash_function)cne_hash_crc;
+    /* Default hash function, same value as cne_hash_crc() and hashes bulk lookups together */
+    default_hash_func = (cne_hash_function)cne_crc32c;
 
     /* Setup hash context */
     strlcpy(h->name, (params->name) ? params->name : "", sizeof(h->name));
@@ -1649,6 +1649,27 @@ __bulk_lookup_prefetching_loop(const struct cne_hash *h, const void **keys, int3
     uint32_t prim_index[CNE_HASH_LOOKUP_BULK_MAX];
     uint32_t sec_index[CNE_HASH_LOOKUP_BULK_MAX];
 
+    /* The CRC32C of the keys is computed together, prefetch all the keys first */
+    if (h->hash_func == cne_crc32c) {
+        for (i = 0; i < num_keys; i++)
+            cne_prefetch0(keys[i]);
+
+        cne_crc32c_bulk(keys, h->key_len, h->hash_func_init_val, prim_hash, num_keys);
+
+        for (i = 0; i < num_keys; i++) {
+            sig[i]        = get_short_sig(prim_hash[i]);
+            prim_index[i] = get_prim_bucket_index(h, prim_hash[i]);
+            sec_index[i]  = get_alt_bucket_index(h, prim_index[i], sig[i]);
+
+            primary_bkt[i]   = &h->buckets[prim_index[i]];
+            secondary_bkt[i] = &h->buckets[sec_index[i]];
+
+            cne_prefetch0(primary_bkt[i]);
+            cne_prefetch0(secondary_bkt[i]);
+        }
+        return;
+    }
+
     /* Prefetch first keys */
     for (i = 0; i < PREFETCH_OFFSET && i < num_keys; i++)
         cne_prefetch0(keys[i]);
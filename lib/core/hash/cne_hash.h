@@ -71,7 +71,7 @@ struct cne_hash_parameters {
     uint32_t entries;            /**< Total hash table entries. */
     uint32_t reserved;           /**< Unused field. Should be set to 0 */
     uint32_t key_len;            /**< Length of hash key. */
-    cne_hash_function hash_func; /**< Primary Hash function used to calculate hash. */
+    cne_hash_function hash_func; /**< Primary Hash function, NULL for cne_crc32c(). */
     uint32_t hash_func_init_val; /**< Init value used by hash_func. */
     int socket_id;               /**< NUMA Socket ID for memory. */
     uint8_t extra_flag;          /**< Indicate if additional parameters are present. */
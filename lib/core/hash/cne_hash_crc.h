@@ -531,6 +531,8 @@ cne_hash_crc_8byte(uint64_t data, uint32_t init_val)
 /**
  * Calculate CRC32 hash on user-supplied byte array.
  *
+ * cne_crc32c() returns the same value and is the default hash function of cne_hash tables.
+ *
  * @param data
  *   Data to perform hash on.
  * @param data_len
@@ -3,6 +3,7 @@
  */
 
 #include <stdint.h>           // for uint32_t, uint8_t
+#include <inttypes.h>         // for PRIu64
 #include <stdlib.h>           // for free, NULL, calloc
 #include <pthread.h>          // for pthread_create, pthread_detach, pthread_yield
 #include <sys/queue.h>        // for TAILQ_FOREACH, TAILQ_REMOVE, TAILQ_FIRST
@@ -13,6 +14,8 @@
 #include <cne_log.h>           // for CNE_LOG_ERR, CNE_LOG_WARNING, CNE_WARN
 #include <cne_mutex_helper.h>
 #include <cne_cycles.h>
+#include <cne_cpuflags.h>        // for cne_cpu_waitpkg_is_supported
+#include <cne_isa.h>             // for cne_umonitor, cne_umwait, cne_tpause
 
 #include "idlemgr_priv.h"
 
@@ -95,6 +98,7 @@ idlemgr_create(const char *name, uint16_t max_fds, uint32_t idle_timeout, uint32
     imgr->epoll_fd     = -1;
     imgr->idle_timeout = idle_timeout;
     imgr->intr_timeout = intr_timeout;
+    imgr->start_tsc    = cne_rdtsc();
 
     if (cne_mutex_create(&imgr->mutex, PTHREAD_MUTEX_RECURSIVE) < 0)
         CNE_ERR_GOTO(err_leave, "mutex init(hmap->mutex) failed: %s\n", strerror(errno));
@@ -185,6 +189,67 @@ idlemgr_get_timeouts(idlemgr_t *_imgr, uint32_t *idle, uint32_t *intr)
     return -1;
 }
 
+int
+idlemgr_set_umwait(idlemgr_t *_imgr, volatile void *addr, uint32_t umwait_timeout)
+{
+    imgr_t *imgr = _imgr;
+
+    if (!imgr || umwait_timeout > IDLE_MGR_MAX_UMWAIT_TIMEOUT)
+        CNE_ERR_RET("invalid arguments or umwait timeout %u > %u us\n", umwait_timeout,
+                    IDLE_MGR_MAX_UMWAIT_TIMEOUT);
+
+    if (umwait_timeout && !cne_cpu_waitpkg_is_supported())
+        CNE_INFO("%s: WAITPKG not supported, UMWAIT/TPAUSE state disabled\n", imgr->name);
+
+    if (imgr_lock(imgr)) {
+        imgr->monitor_addr    = addr;
+        imgr->umwait_timeout  = umwait_timeout;
+        imgr->umwait_deadline = 0;
+        imgr_unlock(imgr);
+        return 0;
+    }
+
+    return -1;
+}
+
+/*
+ * Wait in the C0.2 state until the monitor address is written, the state deadline
+ * expires or, without a monitor address, a TPAUSE slice has passed.
+ */
+static inline void
+imgr_umwait(imgr_t *imgr, uint64_t tstamp)
+{
+    uint64_t now;
+
+    imgr->stats.called_umwait++;
+
+    if (imgr->monitor_addr) {
+        volatile uint32_t *addr = imgr->monitor_addr;
+
+        cne_umonitor(addr);
+
+        /* the address changed since the last wait, the caller has work to do */
+        if (*addr != imgr->monitor_val) {
+            imgr->monitor_val = *addr;
+            imgr->stats.umwait_woken++;
+            return;
+        }
+        cne_umwait(imgr->umwait_deadline);
+
+        if (*addr != imgr->monitor_val) {
+            imgr->monitor_val = *addr;
+            imgr->stats.umwait_woken++;
+        }
+    } else {
+        uint64_t slice = (cne_get_timer_hz() * IDLE_MGR_TPAUSE_SLICE_NS) / NS_PER_S;
+
+        cne_tpause(CNE_MIN(tstamp + slice, imgr->umwait_deadline));
+    }
+
+    now = cne_rdtsc();
+    imgr->stats.umwait_cycles += now - tstamp;
+}
+
 int
 idlemgr_add(idlemgr_t *_imgr, int fd, uint32_t eflags)
 {
@@ -265,8 +330,25 @@ idlemgr_process(idlemgr_t *_imgr, int active)
         }
 
         if (imgr->idle_timestamp && (tstamp > imgr->idle_timestamp)) {
+            /* intermediate C0.2 state before giving up the CPU in epoll_wait() */
+            if (imgr->umwait_timeout && cne_cpu_waitpkg_is_supported()) {
+                if (imgr->umwait_deadline == 0) {
+                    imgr->umwait_deadline =
+                        tstamp + ((cne_get_timer_hz() / US_PER_S) * imgr->umwait_timeout);
+                    if (imgr->monitor_addr)
+                        imgr->monitor_val = *(volatile uint32_t *)imgr->monitor_addr;
+                }
+                if (tstamp < imgr->umwait_deadline) {
+                    imgr_umwait(imgr, tstamp);
+                    return 0;
+                }
+                imgr->stats.umwait_timedout++;
+                imgr->umwait_deadline = 0;
+            }
+
             imgr->stats.called_epoll++;
             nfds = epoll_wait(imgr->epoll_fd, imgr->events, imgr->nb_fds, imgr->intr_timeout);
+            imgr->stats.epoll_cycles += cne_rdtsc() - tstamp;
             imgr->idle_timestamp = 0;
             if (nfds == 0)
                 imgr->stats.intr_timedout++;
@@ -276,7 +358,8 @@ idlemgr_process(idlemgr_t *_imgr, int active)
                 imgr->stats.epoll_wait_failed++;
         }
     } else {
-        imgr->idle_timestamp = 0;
+        imgr->idle_timestamp  = 0;
+        imgr->umwait_deadline = 0;
         if (imgr->idle_timeout)
             imgr->stats.stop_idle_timo++;
     }
@@ -324,6 +407,12 @@ idlemgr_stats(idlemgr_t *_imgr, idlemgr_stats_t *stats)
     stats->intr_found_work   = imgr->stats.intr_found_work;
     stats->intr_timedout     = imgr->stats.intr_timedout;
     stats->epoll_wait_failed = imgr->stats.epoll_wait_failed;
+    stats->called_umwait     = imgr->stats.called_umwait;
+    stats->umwait_woken      = imgr->stats.umwait_woken;
+    stats->umwait_timedout   = imgr->stats.umwait_timedout;
+    stats->umwait_cycles     = imgr->stats.umwait_cycles;
+    stats->epoll_cycles      = imgr->stats.epoll_cycles;
+    stats->total_cycles      = cne_rdtsc() - imgr->start_tsc;
 
     return 0;
 }
@@ -340,17 +429,44 @@ idlemgr_dump(idlemgr_t *_imgr)
         cne_printf("  [yellow]%s [magenta]epoll fd [orange]%d[]\n", imgr->name, imgr->epoll_fd);
         cne_printf("     [magenta]idle_timeout      []: [cyan]%u[] ms\n", imgr->idle_timeout);
         cne_printf("     [magenta]intr_timeout      []: [cyan]%u[] ms\n", imgr->intr_timeout);
-        cne_printf("     [magenta]start_idle_timo   []: [cyan]%lu[]\n",
+        cne_printf("     [magenta]start_idle_timo   []: [cyan]%" PRIu64 "[]\n",
                    imgr->stats.start_idle_timo);
-        cne_printf("     [magenta]stop_idle_timo    []: [cyan]%lu[]\n", imgr->stats.stop_idle_timo);
-        cne_printf("     [magenta]called epoll      []: [cyan]%lu[]\n", imgr->stats.called_epoll);
-        cne_printf("     [magenta]intr_found_work   []: [cyan]%lu[]\n",
+        cne_printf("     [magenta]stop_idle_timo    []: [cyan]%" PRIu64 "[]\n",
+                   imgr->stats.stop_idle_timo);
+        cne_printf("     [magenta]called epoll      []: [cyan]%" PRIu64 "[]\n",
+                   imgr->stats.called_epoll);
+        cne_printf("     [magenta]intr_found_work   []: [cyan]%" PRIu64 "[]\n",
                    imgr->stats.intr_found_work);
-        cne_printf("     [magenta]intr_timedout     []: [cyan]%lu[]\n", imgr->stats.intr_timedout);
-        cne_printf("     [magenta]epoll wait failed []: [cyan]%lu[]\n",
+        cne_printf("     [magenta]intr_timedout     []: [cyan]%" PRIu64 "[]\n",
+                   imgr->stats.intr_timedout);
+        cne_printf("     [magenta]epoll wait failed []: [cyan]%" PRIu64 "[]\n",
                    imgr->stats.epoll_wait_failed);
         cne_printf("     [magenta]nb_fds/max_fds    []: [cyan]%3d /%3d[]\n", imgr->nb_fds,
                    imgr->max_fds);
+        if (imgr->umwait_timeout) {
+            uint64_t total = cne_rdtsc() - imgr->start_tsc;
+            uint64_t hz    = cne_get_timer_hz();
+
+            cne_printf("     [magenta]umwait_timeout    []: [cyan]%u[] us, [cyan]%s[]\n",
+                       imgr->umwait_timeout,
+                       cne_cpu_waitpkg_is_supported()
+                           ? ((imgr->monitor_addr) ? "UMWAIT" : "TPAUSE")
+                           : "WAITPKG not supported");
+            cne_printf("     [magenta]called umwait     []: [cyan]%" PRIu64 "[]\n",
+                       imgr->stats.called_umwait);
+            cne_printf("     [magenta]umwait woken      []: [cyan]%" PRIu64 "[]\n",
+                       imgr->stats.umwait_woken);
+            cne_printf("     [magenta]umwait timedout   []: [cyan]%" PRIu64 "[]\n",
+                       imgr->stats.umwait_timedout);
+            cne_printf("     [magenta]time in C0.2      []: [cyan]%" PRIu64 "[] ms\n",
+                       (imgr->stats.umwait_cycles * MS_PER_S) / hz);
+            cne_printf("     [magenta]time in epoll     []: [cyan]%" PRIu64 "[] ms\n",
+                       (imgr->stats.epoll_cycles * MS_PER_S) / hz);
+            if (total)
+                cne_printf("     [magenta]busy polling      []: [cyan]%" PRIu64 "[]%%\n",
+                           100 - (((imgr->stats.umwait_cycles + imgr->stats.epoll_cycles) * 100) /
+                                  total));
+        }
         imgr_unlock(imgr);
     }
 }
@@ -34,6 +34,13 @@
  * set to a non zero value will enable interrupt mode. The intr_timeout value
  * is only used if idle_timeout is non-zero and will be used in the poll() call
  * as the timeout value. Each of these values are in milliseconds.
+ *
+ * On CPUs with WAITPKG an intermediate state can be enabled with idlemgr_set_umwait(),
+ * the thread first waits in the C0.2 power state using UMONITOR/UMWAIT on an address
+ * written when RX packets arrive (the AF_XDP RX ring producer index) or using short
+ * TPAUSE slices when no address is given. The wake-up takes well under a microsecond
+ * compared to an interrupt and context switch for epoll_wait(). Only when no traffic
+ * arrives within umwait_timeout microseconds does the thread fall back to epoll_wait().
  */
 
 #ifndef _IDLE_MGR_H_
@@ -47,10 +54,12 @@ extern "C" {
 
 typedef void idlemgr_t; /**< void pointer to internal idlemgr structure */
 
-#define IDLE_MGR_MAX_NAME_SIZE    32  /**< Maximum size of the idle manager name string */
-#define IDLE_MGR_MAX_FDS          512 /**< Maximum number of the idle manager file descriptors */
-#define IDLE_MGR_MAX_IDLE_TIMEOUT ((5 * 60) * MS_PER_S) /**< 5 minutes in milliseconds */
-#define IDLE_MGR_MAX_INTR_TIMEOUT ((1 * 60) * MS_PER_S) /**< 1 minute in milliseconds */
+#define IDLE_MGR_MAX_NAME_SIZE      32  /**< Maximum size of the idle manager name string */
+#define IDLE_MGR_MAX_FDS            512 /**< Maximum number of the idle manager file descriptors */
+#define IDLE_MGR_MAX_IDLE_TIMEOUT   ((5 * 60) * MS_PER_S) /**< 5 minutes in milliseconds */
+#define IDLE_MGR_MAX_INTR_TIMEOUT   ((1 * 60) * MS_PER_S) /**< 1 minute in milliseconds */
+#define IDLE_MGR_MAX_UMWAIT_TIMEOUT (100 * MS_PER_S)      /**< 100 milliseconds in microseconds */
+#define IDLE_MGR_TPAUSE_SLICE_NS    500 /**< TPAUSE slice when no monitor address is set */
 
 typedef struct idlemgr_stats {
     uint64_t start_idle_timo;   /**< How many times did we start timeout */
@@ -59,6 +68,12 @@ typedef struct idlemgr_stats {
     uint64_t intr_timedout;     /**< How many times did we timeout */
     uint64_t intr_found_work;   /**< How many times did epoll_wait() return fds */
     uint64_t epoll_wait_failed; /**< How many times did epoll_wait() return error */
+    uint64_t called_umwait;     /**< How many times did we UMWAIT or TPAUSE */
+    uint64_t umwait_woken;      /**< How many times did a write to the monitor address wake us */
+    uint64_t umwait_timedout;   /**< How many times did the UMWAIT state time out to epoll */
+    uint64_t umwait_cycles;     /**< Cycles spent in UMWAIT/TPAUSE (C0.2 state) */
+    uint64_t epoll_cycles;      /**< Cycles spent blocked in epoll_wait() */
+    uint64_t total_cycles;      /**< Cycles since the idlemgr instance was created */
 } idlemgr_stats_t;
 
 /**
@@ -116,6 +131,26 @@ CNDP_API int idlemgr_set_timeouts(idlemgr_t *imgr, uint32_t idle, uint32_t intr)
  */
 CNDP_API int idlemgr_get_timeouts(idlemgr_t *imgr, uint32_t *idle, uint32_t *intr);
 
+/**
+ * Enable the UMWAIT/TPAUSE idle state between idle_timeout and epoll_wait().
+ *
+ * After idle_timeout expires each idlemgr_process() call waits in the C0.2 state and
+ * returns, so the caller polls its RX rings again. When *addr* is given UMONITOR is armed
+ * on it and UMWAIT returns as soon as the address is written, otherwise TPAUSE waits for
+ * IDLE_MGR_TPAUSE_SLICE_NS. Once *umwait_timeout* microseconds pass without activity the
+ * thread falls back to epoll_wait(). Ignored when the CPU does not support WAITPKG.
+ *
+ * @param imgr
+ *   The idlemgr_t pointer to the idlemgr instance
+ * @param addr
+ *   The address to monitor, e.g. the AF_XDP RX ring producer index, or NULL to use TPAUSE.
+ * @param umwait_timeout
+ *   Microseconds to stay in the UMWAIT/TPAUSE state, zero disables the state.
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int idlemgr_set_umwait(idlemgr_t *imgr, volatile void *addr, uint32_t umwait_timeout);
+
 /**
  * Add a file descriptor to the idlemgr instance
  *
@@ -28,6 +28,11 @@ typedef struct imgr_s {
     uint32_t idle_timeout;             /**< Idle timeout in milliseconds to start waiting */
     uint32_t intr_timeout;             /**< Interrupt timeout value in milliseconds */
     uint64_t idle_timestamp;           /**< Rx idle timestamp value in CPU ticks */
+    volatile void *monitor_addr;       /**< Address to UMONITOR or NULL to use TPAUSE */
+    uint32_t monitor_val;              /**< Last value seen at monitor_addr */
+    uint32_t umwait_timeout;           /**< UMWAIT/TPAUSE state timeout in microseconds */
+    uint64_t umwait_deadline;          /**< End of the UMWAIT/TPAUSE state in CPU ticks */
+    uint64_t start_tsc;                /**< CPU ticks when the instance was created */
     idlemgr_stats_t stats;             /**< Stats for idlemgr */
 } imgr_t;
 
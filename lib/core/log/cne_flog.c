@@ -0,0 +1,441 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>          // for snprintf, fputs, FILE
+#include <stdlib.h>         // for posix_memalign, free
+#include <string.h>         // for memcpy, strnlen, strchr
+#include <pthread.h>        // for pthread_mutex_lock, pthread_create, pthread_join
+#include <unistd.h>         // for usleep
+#include <cne_common.h>
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_system.h>        // for cne_get_timer_hz
+
+#include "cne_log.h"
+#include "cne_flog.h"
+
+#define FLOG_LINE_SIZE 1024 /**< Max size of a formatted message */
+#define FLOG_SPEC_SIZE 32   /**< Max size of a single conversion specification */
+
+/* A log record, the string arguments are stored at the offset given in vals[] */
+struct flog_rec {
+    struct cne_flog_site *site; /**< Call site descriptor */
+    uint64_t tsc;               /**< TSC of the CNE_FLOG() call */
+    uint32_t suppressed;        /**< Messages suppressed by the rate limit before this one */
+    uint16_t nargs;             /**< Number of arguments */
+    uint16_t slen;              /**< Bytes used in str[] */
+    uint8_t types[CNE_FLOG_MAX_ARGS];
+    uint64_t vals[CNE_FLOG_MAX_ARGS];
+    char str[CNE_FLOG_STR_SIZE];
+};
+
+_Static_assert(sizeof(struct flog_rec) == CNE_FLOG_REC_SIZE, "flog_rec size mismatch");
+
+/* Single producer single consumer ring owned by a logging thread */
+struct flog_ring {
+    uint64_t head;    /**< Next record to write, only written by the owning thread */
+    uint64_t records; /**< Number of records written */
+    uint64_t dropped; /**< Number of records dropped on a full ring */
+    int owned;        /**< A live thread is writing the ring */
+
+    /* Next record to format, only written by the consumer */
+    uint64_t tail __cne_cache_aligned;
+
+    struct flog_rec recs[CNE_FLOG_RING_SIZE] __cne_cache_aligned;
+};
+
+static __thread struct flog_ring *flog_ring;
+static pthread_key_t flog_key;
+static int flog_key_ok;
+
+static struct flog_ring *flog_rings[CNE_FLOG_MAX_RINGS];
+static uint32_t flog_nb_rings;
+static pthread_mutex_t flog_ring_lock  = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t flog_drain_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t flog_thread;
+static int flog_running;
+static uint64_t flog_printed;
+static uint64_t flog_start_tsc;
+static uint64_t flog_hz;
+
+/* Thread exit, hand the ring to the next thread. The consumer still drains its records */
+static void
+flog_ring_release(void *arg)
+{
+    struct flog_ring *r = arg;
+
+    flog_ring = (struct flog_ring *)-1;
+    __atomic_store_n(&r->owned, 0, __ATOMIC_RELEASE);
+}
+
+CNE_INIT(flog_key_init)
+{
+    flog_key_ok = (pthread_key_create(&flog_key, flog_ring_release) == 0);
+}
+
+static struct flog_ring *
+flog_ring_create(void)
+{
+    struct flog_ring *r = NULL;
+
+    pthread_mutex_lock(&flog_ring_lock);
+
+    /*
+     * Reuse the ring of an exited thread. Its head and tail are left as is, the new owner
+     * is the only producer and continues after the records the consumer has not drained.
+     */
+    for (uint32_t i = 0; i < flog_nb_rings; i++) {
+        if (!__atomic_load_n(&flog_rings[i]->owned, __ATOMIC_ACQUIRE)) {
+            r = flog_rings[i];
+            goto found;
+        }
+    }
+
+    if (flog_nb_rings >= CNE_FLOG_MAX_RINGS)
+        goto leave;
+
+    if (posix_memalign((void **)&r, CNE_CACHE_LINE_SIZE, sizeof(*r))) {
+        r = NULL;
+        goto leave;
+    }
+    memset(r, 0, offsetof(struct flog_ring, recs));
+
+    if (flog_start_tsc == 0) {
+        flog_hz        = cne_get_timer_hz();
+        flog_start_tsc = cne_rdtsc();
+    }
+
+    /* Publish the ring after it is initialized, the consumer does not take the lock */
+    flog_rings[flog_nb_rings] = r;
+    __atomic_store_n(&flog_nb_rings, flog_nb_rings + 1, __ATOMIC_RELEASE);
+
+found:
+    r->owned = 1;
+    if (flog_key_ok)
+        pthread_setspecific(flog_key, r);
+leave:
+    pthread_mutex_unlock(&flog_ring_lock);
+
+    /* Do not retry on every call when the ring can not be created */
+    flog_ring = (r) ? r : (struct flog_ring *)-1;
+    return r;
+}
+
+void
+__cne_flog(struct cne_flog_site *site, uint32_t nargs, const uint8_t *types,
+           const uint64_t *vals)
+{
+    struct flog_ring *r = flog_ring;
+    struct flog_rec *rec;
+    uint64_t head;
+    uint32_t slen = 0;
+
+    if (unlikely(r == NULL))
+        r = flog_ring_create();
+    if (unlikely(r == NULL || r == (struct flog_ring *)-1))
+        return;
+
+    head = r->head;
+    if (unlikely(head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) >= CNE_FLOG_RING_SIZE)) {
+        r->dropped++;
+        return;
+    }
+
+    rec             = &r->recs[head & (CNE_FLOG_RING_SIZE - 1)];
+    rec->site       = site;
+    rec->tsc        = cne_rdtsc();
+    rec->nargs      = nargs;
+    rec->suppressed = 0;
+
+    /* The rate limit state of a site is shared by all threads calling it */
+    if (__atomic_load_n(&site->interval, __ATOMIC_RELAXED))
+        rec->suppressed = __atomic_exchange_n(&site->suppressed, 0, __ATOMIC_RELAXED);
+
+    for (uint32_t i = 0; i < nargs; i++) {
+        rec->types[i] = types[i];
+
+        if (types[i] == CNE_FLOG_ARG_STR) {
+            const char *s = (const char *)(uintptr_t)vals[i];
+            size_t len    = 0;
+
+            if (s && slen < CNE_FLOG_STR_SIZE) {
+                len = strnlen(s, CNE_FLOG_STR_SIZE - slen - 1);
+                memcpy(&rec->str[slen], s, len);
+                rec->str[slen + len] = '\0';
+            }
+            rec->vals[i] = (s) ? slen : UINT64_MAX;
+            slen += len + 1;
+            if (slen > CNE_FLOG_STR_SIZE)
+                slen = CNE_FLOG_STR_SIZE;
+        } else
+            rec->vals[i] = vals[i];
+    }
+    rec->slen = slen;
+    r->records++;
+
+    __atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+}
+
+int
+__cne_flog_ratelimit(struct cne_flog_site *site, uint32_t ms)
+{
+    uint64_t now = cne_rdtsc();
+    uint64_t interval;
+
+    interval = __atomic_load_n(&site->interval, __ATOMIC_RELAXED);
+    if (unlikely(interval == 0)) {
+        interval = ((cne_get_timer_hz() / 1000) * ms) ?: 1;
+        __atomic_store_n(&site->interval, interval, __ATOMIC_RELAXED);
+    }
+
+    if (now < __atomic_load_n(&site->next, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&site->suppressed, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    __atomic_store_n(&site->next, now + interval, __ATOMIC_RELAXED);
+
+    return 1;
+}
+
+/* Convert a raw value to the type selected by the length modifier, as printf would */
+static uint64_t
+flog_int_arg(uint64_t v, const char *len, int is_signed)
+{
+    if (!strcmp(len, "hh"))
+        return is_signed ? (uint64_t)(int64_t)(signed char)v : (unsigned char)v;
+    if (!strcmp(len, "h"))
+        return is_signed ? (uint64_t)(int64_t)(short)v : (unsigned short)v;
+    if (len[0] == '\0')
+        return is_signed ? (uint64_t)(int64_t)(int)v : (unsigned int)v;
+    return v;
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+
+/* Format one conversion, spec holds the flags, width and precision */
+static int
+flog_conv(char *out, size_t sz, const char *spec, const char *len, char conv,
+          const struct flog_rec *rec, uint32_t arg)
+{
+    char fmt[FLOG_SPEC_SIZE + 4];
+    uint8_t type = rec->types[arg];
+    uint64_t v   = rec->vals[arg];
+
+    switch (conv) {
+    case 'd':
+    case 'i':
+        snprintf(fmt, sizeof(fmt), "%%%sll%c", spec, conv);
+        return snprintf(out, sz, fmt, (long long)flog_int_arg(v, len, 1));
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+        snprintf(fmt, sizeof(fmt), "%%%sll%c", spec, conv);
+        return snprintf(out, sz, fmt, (unsigned long long)flog_int_arg(v, len, 0));
+    case 'c':
+        snprintf(fmt, sizeof(fmt), "%%%sc", spec);
+        return snprintf(out, sz, fmt, (int)v);
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A': {
+        union {
+            uint64_t u;
+            double d;
+        } x = {.u = v};
+
+        if (type != CNE_FLOG_ARG_DBL)
+            x.d = (type == CNE_FLOG_ARG_INT) ? (double)(int64_t)v : (double)v;
+        snprintf(fmt, sizeof(fmt), "%%%s%c", spec, conv);
+        return snprintf(out, sz, fmt, x.d);
+    }
+    case 's':
+        snprintf(fmt, sizeof(fmt), "%%%ss", spec);
+        if (type != CNE_FLOG_ARG_STR)
+            return snprintf(out, sz, fmt, "<?>");
+        return snprintf(out, sz, fmt, (v < rec->slen) ? &rec->str[v] : "(null)");
+    case 'p':
+        snprintf(fmt, sizeof(fmt), "%%%sp", spec);
+        return snprintf(out, sz, fmt, (void *)(uintptr_t)v);
+    default:
+        return 0;
+    }
+}
+
+#pragma GCC diagnostic pop
+
+/* Format a record into buf, the format is parsed here since the arguments are not a va_list */
+static int
+flog_format(char *buf, size_t sz, const struct flog_rec *rec)
+{
+    const char *f = rec->site->fmt;
+    uint32_t arg  = 0;
+    size_t n      = 0;
+
+    while (*f && n < sz - 1) {
+        char spec[FLOG_SPEC_SIZE], len[3] = {0};
+        const char *start;
+        size_t sl = 0, ll = 0;
+        int ret;
+
+        if (*f != '%') {
+            buf[n++] = *f++;
+            continue;
+        }
+        start = f++;
+        if (*f == '%') {
+            buf[n++] = *f++;
+            continue;
+        }
+
+        /* Flags, width and precision, a '*' takes its value from the next argument */
+        while (*f && strchr("-+ #0'.123456789*", *f) && sl < sizeof(spec) - 12) {
+            if (*f == '*') {
+                int w = (arg < rec->nargs) ? (int)rec->vals[arg++] : 0;
+
+                sl += snprintf(&spec[sl], sizeof(spec) - sl, "%d", w);
+                f++;
+            } else
+                spec[sl++] = *f++;
+        }
+        spec[sl] = '\0';
+
+        while (*f && strchr("hlLqjzt", *f)) {
+            if (ll < sizeof(len) - 1)
+                len[ll++] = *f;
+            f++;
+        }
+
+        if (*f == '\0' || *f == 'n' || arg >= rec->nargs) {
+            /* Missing argument or %n, copy the specification as is */
+            size_t cnt = (*f) ? (size_t)(f - start + 1) : (size_t)(f - start);
+
+            if (cnt > sz - 1 - n)
+                cnt = sz - 1 - n;
+            if (*f != 'n') {
+                memcpy(&buf[n], start, cnt);
+                n += cnt;
+            } else
+                arg++;
+            if (*f)
+                f++;
+            continue;
+        }
+
+        ret = flog_conv(&buf[n], sz - n, spec, len, *f++, rec, arg++);
+        if (ret > 0)
+            n = ((size_t)ret < sz - n) ? n + ret : sz - 1;
+    }
+    buf[n] = '\0';
+
+    return n;
+}
+
+static int
+flog_drain(void)
+{
+    char line[FLOG_LINE_SIZE];
+    uint32_t cnt;
+    int total = 0;
+
+    pthread_mutex_lock(&flog_drain_lock);
+
+    cnt = __atomic_load_n(&flog_nb_rings, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < cnt; i++) {
+        struct flog_ring *r = flog_rings[i];
+        uint64_t tail       = r->tail;
+        uint64_t head       = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+        FILE *f             = cne_log_get_file();
+
+        for (; tail != head; tail++) {
+            const struct flog_rec *rec = &r->recs[tail & (CNE_FLOG_RING_SIZE - 1)];
+            double secs = (double)(rec->tsc - flog_start_tsc) / (double)(flog_hz ?: 1);
+
+            flog_format(line, sizeof(line), rec);
+            fprintf(f, "[%12.6f] (%-24s:%4u) %s", secs, rec->site->func, rec->site->line,
+                    line);
+            if (rec->suppressed)
+                fprintf(f, "  (%u messages suppressed)\n", rec->suppressed);
+            total++;
+        }
+
+        /* Free the records only after they have been formatted */
+        __atomic_store_n(&r->tail, tail, __ATOMIC_RELEASE);
+    }
+    if (total)
+        fflush(cne_log_get_file());
+    flog_printed += total;
+
+    pthread_mutex_unlock(&flog_drain_lock);
+
+    return total;
+}
+
+static void *
+flog_thread_main(void *arg __cne_unused)
+{
+    while (__atomic_load_n(&flog_running, __ATOMIC_ACQUIRE)) {
+        if (flog_drain() == 0)
+            usleep(CNE_FLOG_POLL_US);
+    }
+    flog_drain();
+
+    return NULL;
+}
+
+int
+cne_flog_start(void)
+{
+    int running = 0;
+
+    if (!__atomic_compare_exchange_n(&flog_running, &running, 1, 0, __ATOMIC_ACQ_REL,
+                                     __ATOMIC_ACQUIRE))
+        CNE_ERR_RET("Fast log thread is already running\n");
+
+    if (pthread_create(&flog_thread, NULL, flog_thread_main, NULL)) {
+        __atomic_store_n(&flog_running, 0, __ATOMIC_RELEASE);
+        CNE_ERR_RET("Failed to start the fast log thread\n");
+    }
+
+    return 0;
+}
+
+void
+cne_flog_stop(void)
+{
+    if (!__atomic_exchange_n(&flog_running, 0, __ATOMIC_ACQ_REL))
+        return;
+
+    pthread_join(flog_thread, NULL);
+}
+
+int
+cne_flog_flush(void)
+{
+    return flog_drain();
+}
+
+void
+cne_flog_stats_get(cne_flog_stats_t *stats)
+{
+    uint32_t cnt;
+
+    if (!stats)
+        return;
+
+    memset(stats, 0, sizeof(*stats));
+
+    cnt = __atomic_load_n(&flog_nb_rings, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < cnt; i++) {
+        stats->records += flog_rings[i]->records;
+        stats->dropped += flog_rings[i]->dropped;
+    }
+    stats->rings   = cnt;
+    stats->printed = __atomic_load_n(&flog_printed, __ATOMIC_RELAXED);
+}
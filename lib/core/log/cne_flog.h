@@ -0,0 +1,270 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_FLOG_H_
+#define _CNE_FLOG_H_
+
+/**
+ * @file
+ *
+ * CNE fast binary log API
+ *
+ * CNE_LOG() formats the message and writes it on the calling thread, which is too slow
+ * to leave enabled on a data-plane thread. CNE_FLOG() only records a pointer to a static
+ * descriptor of the call site, a TSC timestamp and the raw arguments in a ring owned by
+ * the calling thread. The records are formatted later by a background thread started
+ * with cne_flog_start(), or by any thread calling cne_flog_flush().
+ *
+ * Each thread gets its own single producer, single consumer ring on the first CNE_FLOG()
+ * call, so logging takes no locks and no atomic read-modify-write operations. When the
+ * ring is full the record is dropped and counted, a logging thread never waits. The ring
+ * of an exited thread is reused by the next thread calling CNE_FLOG().
+ *
+ * Limitations compared to CNE_LOG():
+ *  - At most CNE_FLOG_MAX_ARGS arguments, the format must be a string literal.
+ *  - char pointer arguments are copied into the record, all of them share
+ *    CNE_FLOG_STR_SIZE bytes and longer strings are truncated.
+ *  - long double arguments are stored as double and %n is ignored.
+ *  - The level is checked at the call site, the message is written with the level
+ *    in effect then, even if the level changes before it is formatted.
+ */
+
+#include <stdint.h>            // for uint64_t, uint32_t, uint8_t
+#include <cne_common.h>        // for CNDP_API
+#include <cne_log.h>           // for CNE_LOG_XXX, cne_log_get_level
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_FLOG_MAX_ARGS  8    /**< Max number of arguments of a CNE_FLOG() call */
+#define CNE_FLOG_REC_SIZE  256  /**< Size of a log record in bytes */
+#define CNE_FLOG_RING_SIZE 1024 /**< Number of records in a thread ring, power of 2 */
+#define CNE_FLOG_MAX_RINGS 256  /**< Max number of live threads using CNE_FLOG() */
+#define CNE_FLOG_POLL_US   1000 /**< Sleep time of the background thread when idle */
+
+/** Bytes of a record left for copies of the string arguments */
+#define CNE_FLOG_STR_SIZE (CNE_FLOG_REC_SIZE - 32 - (CNE_FLOG_MAX_ARGS * sizeof(uint64_t)))
+
+/**
+ * Argument types recorded with each value
+ */
+enum {
+    CNE_FLOG_ARG_INT,  /**< Signed integer */
+    CNE_FLOG_ARG_UINT, /**< Unsigned integer */
+    CNE_FLOG_ARG_DBL,  /**< Floating point value stored as a double */
+    CNE_FLOG_ARG_PTR,  /**< Pointer value */
+    CNE_FLOG_ARG_STR,  /**< String copied into the record */
+};
+
+/**
+ * Static descriptor of a CNE_FLOG() call site, the record only points at it
+ */
+struct cne_flog_site {
+    const char *fmt;     /**< The format string including the level prefix */
+    const char *func;    /**< Function name */
+    uint32_t line;       /**< Line number */
+    uint32_t level;      /**< CNE_LOG_XXX level */
+    uint64_t interval;   /**< Rate limit interval in TSC cycles, 0 until first used */
+    uint64_t next;       /**< TSC the rate limited site can log again */
+    uint64_t suppressed; /**< Messages suppressed by the rate limit since the last one */
+};
+
+/**
+ * Fast log statistics
+ */
+typedef struct cne_flog_stats {
+    uint64_t records; /**< Number of records written */
+    uint64_t dropped; /**< Number of records dropped because a ring was full */
+    uint64_t printed; /**< Number of records formatted and written to the log file */
+    uint32_t rings;   /**< Number of thread rings */
+} cne_flog_stats_t;
+
+/**
+ * Start the background thread formatting the records of all threads
+ *
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int cne_flog_start(void);
+
+/**
+ * Stop the background thread after writing all pending records
+ */
+CNDP_API void cne_flog_stop(void);
+
+/**
+ * Format and write the pending records of all threads on the calling thread
+ *
+ * @return
+ *   The number of records written
+ */
+CNDP_API int cne_flog_flush(void);
+
+/**
+ * Return the fast log statistics
+ *
+ * @param stats
+ *   The location to store the statistics
+ */
+CNDP_API void cne_flog_stats_get(cne_flog_stats_t *stats);
+
+/**
+ * Record a log message, use the CNE_FLOG() macros and not this function directly
+ *
+ * @param site
+ *   The call site descriptor
+ * @param nargs
+ *   The number of arguments
+ * @param types
+ *   The CNE_FLOG_ARG_XXX type of each argument
+ * @param vals
+ *   The raw value of each argument
+ */
+CNDP_API void __cne_flog(struct cne_flog_site *site, uint32_t nargs, const uint8_t *types,
+                         const uint64_t *vals);
+
+/**
+ * Check the rate limit of a call site, use the CNE_FLOG_RL() macro and not this function
+ *
+ * @param site
+ *   The call site descriptor
+ * @param ms
+ *   The minimum time between two messages of the site in milliseconds
+ * @return
+ *   1 if the message can be logged or 0 if it is suppressed
+ */
+CNDP_API int __cne_flog_ratelimit(struct cne_flog_site *site, uint32_t ms);
+
+/* Only used to let the compiler check the format string and arguments */
+static inline void __attribute__((format(printf, 1, 2)))
+__cne_flog_check(const char *fmt __cne_unused, ...)
+{
+}
+
+static inline uint64_t
+__cne_flog_i64(int64_t v)
+{
+    return (uint64_t)v;
+}
+
+static inline uint64_t
+__cne_flog_u64(uint64_t v)
+{
+    return v;
+}
+
+static inline uint64_t
+__cne_flog_dbl(double v)
+{
+    union {
+        double d;
+        uint64_t u;
+    } x = {.d = v};
+
+    return x.u;
+}
+
+static inline uint64_t
+__cne_flog_ptr(const void *v)
+{
+    return (uint64_t)(uintptr_t)v;
+}
+
+/* clang-format off */
+#define __CNE_FLOG_CLASS(x, s, u, d, c, p) _Generic((x),                               \
+    _Bool: u, char: s, signed char: s, unsigned char: u, short: s, unsigned short: u,  \
+    int: s, unsigned int: u, long: s, unsigned long: u, long long: s,                  \
+    unsigned long long: u, float: d, double: d, long double: d,                        \
+    char *: c, const char *: c, default: p)
+
+#define __CNE_FLOG_TYPE(x) __CNE_FLOG_CLASS(x, CNE_FLOG_ARG_INT, CNE_FLOG_ARG_UINT,    \
+    CNE_FLOG_ARG_DBL, CNE_FLOG_ARG_STR, CNE_FLOG_ARG_PTR)
+#define __CNE_FLOG_VAL(x) __CNE_FLOG_CLASS(x, __cne_flog_i64, __cne_flog_u64,          \
+    __cne_flog_dbl, __cne_flog_ptr, __cne_flog_ptr)(x)
+
+#define __CNE_FLOG_NARGS(...) __CNE_FLOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define __CNE_FLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+
+#define __CNE_FLOG_CAT(a, b)  __CNE_FLOG_CAT_(a, b)
+#define __CNE_FLOG_CAT_(a, b) a##b
+
+/* Apply m() to each argument, each result is preceded by a comma */
+#define __CNE_FLOG_MAP(m, ...) \
+    __CNE_FLOG_CAT(__CNE_FLOG_MAP_, __CNE_FLOG_NARGS(__VA_ARGS__))(m, ##__VA_ARGS__)
+#define __CNE_FLOG_MAP_0(m)
+#define __CNE_FLOG_MAP_1(m, a)      , m(a)
+#define __CNE_FLOG_MAP_2(m, a, ...) , m(a) __CNE_FLOG_MAP_1(m, __VA_ARGS__)
+#define __CNE_FLOG_MAP_3(m, a, ...) , m(a) __CNE_FLOG_MAP_2(m, __VA_ARGS__)
+#define __CNE_FLOG_MAP_4(m, a, ...) , m(a) __CNE_FLOG_MAP_3(m, __VA_ARGS__)
+#define __CNE_FLOG_MAP_5(m, a, ...) , m(a) __CNE_FLOG_MAP_4(m, __VA_ARGS__)
+#define __CNE_FLOG_MAP_6(m, a, ...) , m(a) __CNE_FLOG_MAP_5(m, __VA_ARGS__)
+#define __CNE_FLOG_MAP_7(m, a, ...) , m(a) __CNE_FLOG_MAP_6(m, __VA_ARGS__)
+#define __CNE_FLOG_MAP_8(m, a, ...) , m(a) __CNE_FLOG_MAP_7(m, __VA_ARGS__)
+
+/* The arrays start with a dummy entry so a call without arguments is valid C */
+#define __CNE_FLOG_WRITE(_site, ...)                                                    \
+    __cne_flog(&(_site), __CNE_FLOG_NARGS(__VA_ARGS__),                                 \
+               &((const uint8_t[]){0 __CNE_FLOG_MAP(__CNE_FLOG_TYPE, ##__VA_ARGS__)})[1], \
+               &((const uint64_t[]){0 __CNE_FLOG_MAP(__CNE_FLOG_VAL, ##__VA_ARGS__)})[1])
+/* clang-format on */
+
+/**
+ * Record a log message to be formatted later
+ *
+ * @param lvl
+ *   Log level, the short name e.g. DEBUG, expanded by the macro
+ * @param fmt
+ *   The format string literal, as in printf(3)
+ * @param ...
+ *   Up to CNE_FLOG_MAX_ARGS arguments required by the format
+ */
+#define CNE_FLOG(lvl, fmt, ...)                                                        \
+    do {                                                                               \
+        static struct cne_flog_site __cne_flog_site = {                                \
+            #lvl ": " fmt, __func__, __LINE__, CNE_LOG_##lvl, 0, 0, 0};                \
+        if (0)                                                                         \
+            __cne_flog_check(fmt, ##__VA_ARGS__);                                      \
+        if (CNE_LOG_##lvl <= cne_log_get_level())                                      \
+            __CNE_FLOG_WRITE(__cne_flog_site, ##__VA_ARGS__);                          \
+    } while ((0))
+
+/**
+ * Record a log message at most once per interval, the next message of the call site
+ * reports how many were suppressed
+ *
+ * @param lvl
+ *   Log level, the short name e.g. DEBUG, expanded by the macro
+ * @param ms
+ *   The minimum time between two messages of the call site in milliseconds
+ * @param fmt
+ *   The format string literal, as in printf(3)
+ * @param ...
+ *   Up to CNE_FLOG_MAX_ARGS arguments required by the format
+ */
+#define CNE_FLOG_RL(lvl, ms, fmt, ...)                                                 \
+    do {                                                                               \
+        static struct cne_flog_site __cne_flog_site = {                                \
+            #lvl ": " fmt, __func__, __LINE__, CNE_LOG_##lvl, 0, 0, 0};                \
+        if (0)                                                                         \
+            __cne_flog_check(fmt, ##__VA_ARGS__);                                      \
+        if (CNE_LOG_##lvl <= cne_log_get_level() &&                                    \
+            __cne_flog_ratelimit(&__cne_flog_site, ms))                                \
+            __CNE_FLOG_WRITE(__cne_flog_site, ##__VA_ARGS__);                          \
+    } while ((0))
+
+/**
+ * Macros for the normal cases with CNE_FLOG() levels
+ */
+#define CNE_FLOG_ERR(...)    CNE_FLOG(ERR, __VA_ARGS__)
+#define CNE_FLOG_WARN(...)   CNE_FLOG(WARNING, __VA_ARGS__)
+#define CNE_FLOG_NOTICE(...) CNE_FLOG(NOTICE, __VA_ARGS__)
+#define CNE_FLOG_INFO(...)   CNE_FLOG(INFO, __VA_ARGS__)
+#define CNE_FLOG_DEBUG(...)  CNE_FLOG(DEBUG, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_FLOG_H_ */
@@ -11,6 +11,7 @@
 #include <cne_common.h>                   // for MEMPOOL_CACHE_MAX_SIZE, __cne_unused
 #include <cne_log.h>                      // for CNE_LOG_ERR, CNE_NULL_RET, CNE_ER...
 #include <cne_branch_prediction.h>        // for unlikely
+#include <cne_trace.h>                    // for CNE_TRACE, CNE_TRACE_POINT_DEFINE
 #include <stdlib.h>                       // for calloc, free
 
 #include "mempool.h"
@@ -22,6 +23,11 @@
 #define CACHE_FLUSHTHRESH_MULTIPLIER 1.5
 #define CALC_CACHE_FLUSHTHRESH(c)    ((typeof(c))((c)*CACHE_FLUSHTHRESH_MULTIPLIER))
 
+/* Cache misses go to the backing ring, a get failure means the mempool is empty */
+CNE_TRACE_POINT_DEFINE(mempool_trace_put_flush, "mempool.put_flush", "mp,n");
+CNE_TRACE_POINT_DEFINE(mempool_trace_get_refill, "mempool.get_refill", "mp,n");
+CNE_TRACE_POINT_DEFINE(mempool_trace_get_fail, "mempool.get_fail", "mp,n");
+
 static void
 mempool_add_elem(struct cne_mempool *mp, __cne_unused void *opaque, void *obj __cne_unused)
 {
@@ -264,6 +270,7 @@ __mempool_generic_put(mempool_t *_mp, void *const *obj_table, unsigned int n,
     cache->len += n;
 
     if (cache->len >= cache->flushthresh) {
+        CNE_TRACE(mempool_trace_put_flush, (uintptr_t)mp, cache->len - cache->size);
         mempool_ring_enqueue(mp, &cache->objs[cache->size], cache->len - cache->size);
         cache->len = cache->size;
     }
@@ -336,6 +343,8 @@ __mempool_generic_get(struct cne_mempool *mp, void **obj_table, unsigned int n,
         /* No. Backfill the cache first, and then fill from it */
         uint32_t req = n + (cache->size - cache->len);
 
+        CNE_TRACE(mempool_trace_get_refill, (uintptr_t)mp, req);
+
         /* How many do we require i.e. number to fill the cache + the request */
         ret = mempool_ring_dequeue(mp, &cache->objs[cache->len], req);
         if (unlikely(ret < 0)) {
@@ -366,10 +375,12 @@ ring_dequeue:
     /* get remaining objects from ring */
     ret = mempool_ring_dequeue(mp, obj_table, n);
 
-    if (ret < 0)
+    if (ret < 0) {
         __MEMPOOL_STAT_ADD(mp, get_fail, n);
-    else
+        CNE_TRACE(mempool_trace_get_fail, (uintptr_t)mp, n);
+    } else {
         __MEMPOOL_STAT_ADD(mp, get_success, n);
+    }
 
     return ret;
 }
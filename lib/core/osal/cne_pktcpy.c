@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint8_t, uintptr_t, SIZE_MAX
+#include <stdio.h>               // for fopen, fscanf, fclose
+#include <unistd.h>              // for sysconf, _SC_LEVEL3_CACHE_SIZE
+#include <immintrin.h>           // for _mm512_loadu_si512, _mm512_storeu_si512
+#include <cne_common.h>          // for CNE_INIT
+#include <cne_cpuflags.h>        // for cne_cpu_get_flag_enabled, CNE_CPUFLAG_AVX512F
+#include <cne_pktcpy.h>          // for cne_pktcpy_nt_threshold, CNE_PKTCPY_NT_LLC_PCT
+
+#define LLC_SYSFS "/sys/devices/system/cpu/cpu0/cache/index%d/size"
+
+static size_t llc_size;
+static size_t nt_threshold = CNE_PKTCPY_NT_DEFAULT;
+static int avx512_enabled;
+
+size_t
+cne_pktcpy_llc_size(void)
+{
+    return llc_size;
+}
+
+size_t
+cne_pktcpy_nt_threshold(void)
+{
+    return nt_threshold;
+}
+
+int
+cne_pktcpy_nt_threshold_set(unsigned int llc_pct)
+{
+    if (llc_pct > 1000)
+        return -1;
+
+    if (llc_pct == 0)
+        nt_threshold = SIZE_MAX;
+    else if (llc_size == 0)
+        nt_threshold = CNE_PKTCPY_NT_DEFAULT;
+    else
+        nt_threshold = (llc_size / 100) * llc_pct;
+
+    return 0;
+}
+
+/* The largest cache reported in sysfs is the last level cache */
+static size_t
+llc_size_sysfs(void)
+{
+    char path[128], unit = 0;
+    size_t size = 0, sz;
+    FILE *f;
+
+    for (int i = 0; i < 8; i++) {
+        snprintf(path, sizeof(path), LLC_SYSFS, i);
+        f = fopen(path, "r");
+        if (!f)
+            break;
+        if (fscanf(f, "%zu%c", &sz, &unit) >= 1) {
+            if (unit == 'K')
+                sz *= 1024;
+            else if (unit == 'M')
+                sz *= 1024 * 1024;
+            if (sz > size)
+                size = sz;
+        }
+        fclose(f);
+    }
+
+    return size;
+}
+
+void *__attribute__((target("avx512f")))
+cne_pktcpy_avx512(void *dst, const void *src, size_t n)
+{
+    const uint8_t *s = src;
+    uint8_t *d       = dst;
+    size_t off;
+
+    if (!avx512_enabled || n < 64)
+        return NULL;
+
+    /* Align the stores on a cache line, the first 64 bytes are copied twice */
+    off = (64 - ((uintptr_t)d & 0x3F)) & 0x3F;
+    if (off) {
+        _mm512_storeu_si512((void *)d, _mm512_loadu_si512((const void *)s));
+        d += off;
+        s += off;
+        n -= off;
+    }
+
+    for (; n >= 256; n -= 256, d += 256, s += 256) {
+        __m512i zmm0, zmm1, zmm2, zmm3;
+
+        zmm0 = _mm512_loadu_si512((const void *)(s + 0 * 64));
+        zmm1 = _mm512_loadu_si512((const void *)(s + 1 * 64));
+        zmm2 = _mm512_loadu_si512((const void *)(s + 2 * 64));
+        zmm3 = _mm512_loadu_si512((const void *)(s + 3 * 64));
+        _mm512_store_si512((void *)(d + 0 * 64), zmm0);
+        _mm512_store_si512((void *)(d + 1 * 64), zmm1);
+        _mm512_store_si512((void *)(d + 2 * 64), zmm2);
+        _mm512_store_si512((void *)(d + 3 * 64), zmm3);
+    }
+
+    for (; n >= 64; n -= 64, d += 64, s += 64)
+        _mm512_store_si512((void *)d, _mm512_loadu_si512((const void *)s));
+
+    /* Copy whatever left with the last 64 bytes of the buffer */
+    if (n)
+        _mm512_storeu_si512((void *)(d - 64 + n), _mm512_loadu_si512((const void *)(s - 64 + n)));
+
+    return dst;
+}
+
+CNE_INIT(cne_pktcpy_init)
+{
+    long sz = sysconf(_SC_LEVEL3_CACHE_SIZE);
+
+    llc_size = (sz > 0) ? (size_t)sz : llc_size_sysfs();
+    cne_pktcpy_nt_threshold_set(CNE_PKTCPY_NT_LLC_PCT);
+
+    avx512_enabled = cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX512F) == 1;
+}
@@ -15,6 +15,7 @@
 #include <stddef.h>            // for NULL, size_t
 #include <stdlib.h>            // for calloc
 #include <unistd.h>            // for usleep
+#include <pthread.h>           // for pthread_mutex_lock, pthread_mutex_unlock
 
 #include "pktdev.h"
 #include "pktdev_driver.h"        // for pktdev_allocate, pktdev_allocated, pktdev...
@@ -24,6 +25,9 @@
 struct cne_pktdev pktdev_devices[CNE_MAX_ETHPORTS];
 static struct pktdev_data pktdev_data[CNE_MAX_ETHPORTS];
 
+/* Serialize lport allocation, lports can be probed from more than one thread */
+static pthread_mutex_t pktdev_lock = PTHREAD_MUTEX_INITIALIZER;
+
 #define CALL_PMD(fn, ...) (fn) ? (fn)(__VA_ARGS__) : -ENOTSUP
 
 struct cne_pktdev *
@@ -83,12 +87,17 @@ pktdev_allocate(const char *name, const char *ifname)
     if ((name_len + 1) >= PKTDEV_NAME_MAX_LEN)        // Need space for terminating char
         CNE_NULL_RET("Ethernet device name is too long\n");
 
-    if (pktdev_allocated(name) != NULL)
+    pthread_mutex_lock(&pktdev_lock);
+    if (pktdev_allocated(name) != NULL) {
+        pthread_mutex_unlock(&pktdev_lock);
         CNE_NULL_RET("Device with name %s already allocated\n", name);
+    }
 
     lport_id = pktdev_find_free_port();
-    if (lport_id >= CNE_MAX_ETHPORTS)
+    if (lport_id >= CNE_MAX_ETHPORTS) {
+        pthread_mutex_unlock(&pktdev_lock);
         CNE_NULL_RET("Reached maximum number of lports\n");
+    }
 
     dev       = &pktdev_devices[lport_id];
     dev->data = &pktdev_data[lport_id];
@@ -97,9 +106,14 @@ pktdev_allocate(const char *name, const char *ifname)
     if (strncmp(dev->data->name, name, name_len) != 0) {
         dev->state = PKTDEV_UNUSED;
         dev->data  = NULL;
+        pthread_mutex_unlock(&pktdev_lock);
         CNE_NULL_RET("Setting the pkt_dev name failed\n");
     }
 
+    /* Reserve the lport until pktdev_port_setup() marks it active */
+    dev->state = PKTDEV_ATTACHED;
+    pthread_mutex_unlock(&pktdev_lock);
+
     if (ifname && ifname[0] != '\0')
         strlcpy(dev->data->ifname, ifname, sizeof(dev->data->ifname));
 
@@ -327,7 +341,10 @@ pktdev_release_port(struct cne_pktdev *dev)
     if (dev == NULL)
         return;
 
+    /* Return the lport to the free pool, also used when a probe fails */
+    pthread_mutex_lock(&pktdev_lock);
     memset(dev, 0, sizeof(struct cne_pktdev));
+    pthread_mutex_unlock(&pktdev_lock);
 }
 
 int
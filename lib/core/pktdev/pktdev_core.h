@@ -155,6 +155,7 @@ typedef int (*eth_pkt_alloc)(struct cne_pktdev *dev, pktmbuf_t **bufs, uint16_t
 enum pktdev_state {
     PKTDEV_UNUSED = 0, /** Device is unused before being probed. */
     PKTDEV_ACTIVE,     /** Device is active when allocated. */
+    PKTDEV_ATTACHED,   /** Device is reserved by pktdev_allocate() and being probed. */
 };
 
 /**
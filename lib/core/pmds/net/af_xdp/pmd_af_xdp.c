@@ -180,7 +180,7 @@ static struct cne_pktdev *
 init_lport(lport_cfg_t *c)
 {
     struct pmd_lport *lport;
-    struct cne_pktdev *dev;
+    struct cne_pktdev *dev = NULL;
     int ret;
 
     CNE_LOG(DEBUG, "Init %s\n", c->ifname);
@@ -228,6 +228,7 @@ init_lport(lport_cfg_t *c)
     return dev;
 
 err_exit:
+    pktdev_release_port(dev);
     free(lport);
     return NULL;
 }
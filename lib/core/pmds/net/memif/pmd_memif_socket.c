@@ -20,6 +20,7 @@
 #include <pktdev_driver.h>        // for pktdev_allocate, pktdev_allocated, pkt...
 #include <cne_lport.h>            // for lport_cfg_t, lport_stats_t
 #include <cne_mmap.h>             // for mmap_alloc
+#include <cne_pktcpy.h>           // for cne_pktcpy_large
 
 #include "pmd_memif_socket.h"
 
@@ -565,8 +566,8 @@ cne_pmd_memif_socket_rx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
             if (mbuf != mbuf_head)
                 pktmbuf_buf_len(mbuf_head) += cp_len;
 
-            memcpy(pktmbuf_mtod_offset(mbuf, void *, dst_off),
-                   (uint8_t *)memif_get_buffer(proc_private, d0) + src_off, cp_len);
+            cne_pktcpy_large(pktmbuf_mtod_offset(mbuf, void *, dst_off),
+                             (uint8_t *)memif_get_buffer(proc_private, d0) + src_off, cp_len);
 
             src_off += cp_len;
             dst_off += cp_len;
@@ -624,9 +625,12 @@ cne_pmd_memif_socket_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
     uint16_t src_len, src_off, dst_len, dst_off, cp_len;
     cne_memif_ring_type_t type = mq->type;
     cne_memif_desc_t *d0;
+    lport_copy_ops_t *ops = &pmd->copy_ops;
+    pktmbuf_t **sent      = bufs;
     pktmbuf_t *mbuf, *mbuf_head;
     uint64_t a;
     ssize_t size;
+    void *dst;
 
     if (unlikely((pmd->flags & CNE_ETH_MEMIF_FLAG_CONNECTED) == 0))
         return 0;
@@ -685,8 +689,17 @@ cne_pmd_memif_socket_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
             }
             cp_len = CNE_MIN(dst_len, src_len);
 
-            memcpy((uint8_t *)memif_get_buffer(proc_private, d0) + dst_off,
-                   pktmbuf_mtod_offset(mbuf, void *, src_off), cp_len);
+            dst = (uint8_t *)memif_get_buffer(proc_private, d0) + dst_off;
+            if (ops->copy_start) {
+                /* Large copies are queued and completed before the slots are published */
+                if (unlikely(ops->copy_start(ops->copy_arg, dst,
+                                             pktmbuf_mtod_offset(mbuf, void *, src_off),
+                                             cp_len) < 0)) {
+                    slot = saved_slot;
+                    goto no_free_slots;
+                }
+            } else
+                cne_pktcpy_large(dst, pktmbuf_mtod_offset(mbuf, void *, src_off), cp_len);
 
             mq->n_bytes += cp_len;
             src_off += cp_len;
@@ -702,10 +715,18 @@ cne_pmd_memif_socket_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
         n_tx_pkts++;
         slot++;
         n_free--;
-        pktmbuf_free(mbuf_head);
     }
 
 no_free_slots:
+    /* The packet data must be in the buffers before the peer sees the slots */
+    if (ops->copy_start && unlikely(ops->copy_wait(ops->copy_arg) != 0)) {
+        MIF_LOG(WARNING, "Failed to copy packets to the memif buffers");
+        slot      = (type == CNE_MEMIF_RING_C2S) ? __atomic_load_n(&ring->head, __ATOMIC_RELAXED)
+                                                 : __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+        n_tx_pkts = 0;
+    }
+    pktmbuf_free_bulk(sent, n_tx_pkts);
+
     if (type == CNE_MEMIF_RING_C2S)
         __atomic_store_n(&ring->head, slot, __ATOMIC_RELEASE);
     else
@@ -926,6 +947,11 @@ cne_pmd_memif_socket_probe(lport_cfg_t *c)
     /* create interface */
     ret = cne_memif_create(dev, role, id, flags, socket_filename, log2_ring_size, pkt_buffer_size,
                            secret, c->pi);
+    if (ret == 0) {
+        struct pmd_internals *pmd = dev->data->dev_private;
+
+        pmd->copy_ops = c->copy_ops;
+    }
 
     cne_memif_queue_init(dev);
 
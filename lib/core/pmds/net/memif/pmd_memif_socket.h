@@ -95,6 +95,8 @@ struct pmd_internals {
     /**< local disconnect reason */
     char remote_disc_string[CNE_ETH_MEMIF_DISC_STRING_SIZE];
     /**< remote disconnect reason */
+
+    lport_copy_ops_t copy_ops; /**< TX copy offload, NULL copy_start for cne_pktcpy_large */
 };
 
 struct cne_memif_queue {
@@ -0,0 +1,440 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>             // for snprintf, fprintf
+#include <stdlib.h>            // for calloc, free
+#include <inttypes.h>          // for PRIu64
+#include <string.h>            // for memset, memcpy, strerror
+#include <errno.h>             // for errno, EAGAIN, EINVAL
+#include <fcntl.h>             // for O_CREAT, O_RDWR, O_RDONLY
+#include <unistd.h>            // for ftruncate, close, getpid, getpagesize
+#include <pthread.h>           // for pthread_mutex_lock, pthread_mutex_unlock
+#include <sys/mman.h>          // for mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h>          // for fstat
+#include <bsd/string.h>        // for strlcpy
+#include <cne_common.h>        // for CNE_ALIGN_CEIL, CNE_CACHE_LINE_SIZE
+#include <cne_log.h>           // for CNE_ERR_RET, CNE_NULL_RET, CNE_ERR_GOTO
+#include <cne_pause.h>         // for cne_pause
+
+#include "shmstats.h"
+
+struct shmstats {
+    char name[SHMSTATS_NAME_LEN]; /**< shm_open() name of the segment */
+    shmstats_hdr_t *hdr;          /**< Mapped segment */
+    size_t size;                  /**< Size of the mapping */
+};
+
+static struct shmstats shm_self; /**< The segment written by this process */
+static pthread_mutex_t shm_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static inline void *
+seg_ptr(shmstats_hdr_t *hdr, uint64_t off)
+{
+    return (char *)hdr + off;
+}
+
+static inline shmstats_desc_t *
+desc_table(shmstats_hdr_t *hdr)
+{
+    return seg_ptr(hdr, hdr->hdr_size);
+}
+
+static inline size_t
+blk_size(uint32_t nb_counters)
+{
+    return CNE_ALIGN_CEIL(sizeof(shmstats_blk_t) + (nb_counters * sizeof(uint64_t)),
+                          CNE_CACHE_LINE_SIZE);
+}
+
+static inline size_t
+names_size(uint32_t nb_counters)
+{
+    return CNE_ALIGN_CEIL(nb_counters * SHMSTATS_NAME_LEN, CNE_CACHE_LINE_SIZE);
+}
+
+int
+shmstats_create(const char *name, size_t size)
+{
+    shmstats_hdr_t *hdr;
+    size_t table;
+    int fd;
+
+    pthread_mutex_lock(&shm_mutex);
+
+    if (shm_self.hdr) {
+        pthread_mutex_unlock(&shm_mutex);
+        CNE_ERR_RET("Statistics segment %s already created\n", shm_self.name);
+    }
+
+    if (name)
+        strlcpy(shm_self.name, name, sizeof(shm_self.name));
+    else
+        snprintf(shm_self.name, sizeof(shm_self.name), "/%s.%d", SHMSTATS_PREFIX, getpid());
+
+    table = CNE_ALIGN_CEIL(sizeof(shmstats_hdr_t) + (SHMSTATS_MAX_BLOCKS * sizeof(shmstats_desc_t)),
+                           CNE_CACHE_LINE_SIZE);
+    if (size == 0)
+        size = SHMSTATS_DEFAULT_SIZE;
+    size = CNE_ALIGN_CEIL(size, (size_t)getpagesize());
+    if (size <= table)
+        CNE_ERR_GOTO(err, "Segment size %zu too small, must be larger than %zu\n", size, table);
+
+    fd = shm_open(shm_self.name, O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0)
+        CNE_ERR_GOTO(err, "shm_open(%s) failed: %s\n", shm_self.name, strerror(errno));
+
+    if (ftruncate(fd, size) < 0) {
+        close(fd);
+        CNE_ERR_GOTO(unlink, "ftruncate(%s) failed: %s\n", shm_self.name, strerror(errno));
+    }
+
+    hdr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (hdr == MAP_FAILED)
+        CNE_ERR_GOTO(unlink, "mmap(%s) failed: %s\n", shm_self.name, strerror(errno));
+
+    hdr->version    = SHMSTATS_VERSION;
+    hdr->hdr_size   = sizeof(shmstats_hdr_t);
+    hdr->size       = size;
+    hdr->max_blocks = SHMSTATS_MAX_BLOCKS;
+    hdr->pid        = getpid();
+    hdr->used       = table;
+
+    /* Readers check the magic value last, only set it once the header is complete */
+    __atomic_store_n(&hdr->magic, SHMSTATS_MAGIC, __ATOMIC_RELEASE);
+
+    shm_self.hdr  = hdr;
+    shm_self.size = size;
+
+    pthread_mutex_unlock(&shm_mutex);
+    return 0;
+
+unlink:
+    shm_unlink(shm_self.name);
+err:
+    memset(&shm_self, 0, sizeof(shm_self));
+    pthread_mutex_unlock(&shm_mutex);
+    return -1;
+}
+
+void
+shmstats_destroy(void)
+{
+    pthread_mutex_lock(&shm_mutex);
+    if (shm_self.hdr) {
+        munmap(shm_self.hdr, shm_self.size);
+        shm_unlink(shm_self.name);
+    }
+    memset(&shm_self, 0, sizeof(shm_self));
+    pthread_mutex_unlock(&shm_mutex);
+}
+
+const char *
+shmstats_name(void)
+{
+    return (shm_self.hdr) ? shm_self.name : NULL;
+}
+
+shmstats_blk_t *
+shmstats_block_alloc(const char *name, uint32_t type, const char *const *names,
+                     uint32_t nb_counters)
+{
+    shmstats_hdr_t *hdr;
+    shmstats_desc_t *d = NULL;
+    shmstats_blk_t *blk;
+    char *cnames;
+
+    if (nb_counters == 0)
+        CNE_NULL_RET("Number of counters must be non zero\n");
+
+    pthread_mutex_lock(&shm_mutex);
+
+    hdr = shm_self.hdr;
+    if (!hdr)
+        goto err;
+
+    /* Reuse a freed entry of the same size before taking more of the segment */
+    for (uint32_t i = 0; i < hdr->nb_blocks; i++) {
+        shmstats_desc_t *f = &desc_table(hdr)[i];
+
+        if (f->state == SHMSTATS_BLK_FREE && f->nb_counters == nb_counters) {
+            d = f;
+            break;
+        }
+    }
+
+    if (d) {
+        blk = seg_ptr(hdr, d->blk_off);
+
+        /* A reader can still be looking at the old block, move the count on */
+        shmstats_write_begin(blk);
+        memset(blk->counters, 0, nb_counters * sizeof(uint64_t));
+        shmstats_write_end(blk);
+    } else {
+        size_t need = names_size(nb_counters) + blk_size(nb_counters);
+
+        if (hdr->nb_blocks >= hdr->max_blocks)
+            CNE_ERR_GOTO(err, "Statistics segment block table is full\n");
+        if (hdr->used + need > hdr->size)
+            CNE_ERR_GOTO(err, "Statistics segment has no room for %u counters\n", nb_counters);
+
+        d            = &desc_table(hdr)[hdr->nb_blocks];
+        d->names_off = hdr->used;
+        d->blk_off   = hdr->used + names_size(nb_counters);
+        hdr->used += need;
+
+        blk              = seg_ptr(hdr, d->blk_off);
+        blk->nb_counters = nb_counters;
+    }
+
+    cnames = seg_ptr(hdr, d->names_off);
+    memset(cnames, 0, nb_counters * SHMSTATS_NAME_LEN);
+    for (uint32_t i = 0; names && i < nb_counters; i++) {
+        if (names[i])
+            strlcpy(&cnames[i * SHMSTATS_NAME_LEN], names[i], SHMSTATS_NAME_LEN);
+    }
+
+    strlcpy(d->name, (name) ? name : "", sizeof(d->name));
+    d->type        = type;
+    d->nb_counters = nb_counters;
+    __atomic_store_n(&d->state, SHMSTATS_BLK_ACTIVE, __ATOMIC_RELEASE);
+
+    if (d == &desc_table(hdr)[hdr->nb_blocks])
+        __atomic_store_n(&hdr->nb_blocks, hdr->nb_blocks + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&hdr->gen, hdr->gen + 1, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&shm_mutex);
+    return blk;
+
+err:
+    pthread_mutex_unlock(&shm_mutex);
+    return NULL;
+}
+
+void
+shmstats_block_free(shmstats_blk_t *blk)
+{
+    shmstats_hdr_t *hdr;
+    uint64_t off;
+
+    if (!blk)
+        return;
+
+    pthread_mutex_lock(&shm_mutex);
+
+    hdr = shm_self.hdr;
+    if (hdr) {
+        off = (uint64_t)((char *)blk - (char *)hdr);
+
+        for (uint32_t i = 0; i < hdr->nb_blocks; i++) {
+            shmstats_desc_t *d = &desc_table(hdr)[i];
+
+            if (d->blk_off == off && d->state == SHMSTATS_BLK_ACTIVE) {
+                __atomic_store_n(&d->state, SHMSTATS_BLK_FREE, __ATOMIC_RELEASE);
+                __atomic_store_n(&hdr->gen, hdr->gen + 1, __ATOMIC_RELEASE);
+                break;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&shm_mutex);
+}
+
+shmstats_t *
+shmstats_open(const char *name)
+{
+    shmstats_t *s = NULL;
+    shmstats_hdr_t *hdr;
+    struct stat st;
+    int fd;
+
+    if (!name)
+        CNE_NULL_RET("Segment name is NULL\n");
+
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+        CNE_NULL_RET("shm_open(%s) failed: %s\n", name, strerror(errno));
+
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(shmstats_hdr_t)) {
+        close(fd);
+        CNE_NULL_RET("Segment %s is not a statistics segment\n", name);
+    }
+
+    hdr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (hdr == MAP_FAILED)
+        CNE_NULL_RET("mmap(%s) failed: %s\n", name, strerror(errno));
+
+    if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != SHMSTATS_MAGIC)
+        CNE_ERR_GOTO(err, "Segment %s has an invalid magic value\n", name);
+    if (hdr->version != SHMSTATS_VERSION)
+        CNE_ERR_GOTO(err, "Segment %s version %u, expected %u\n", name, hdr->version,
+                     SHMSTATS_VERSION);
+    if (hdr->hdr_size != sizeof(shmstats_hdr_t) || hdr->size != (uint64_t)st.st_size ||
+        hdr->hdr_size + (hdr->max_blocks * sizeof(shmstats_desc_t)) > hdr->size)
+        CNE_ERR_GOTO(err, "Segment %s has an invalid header\n", name);
+
+    s = calloc(1, sizeof(shmstats_t));
+    if (!s)
+        CNE_ERR_GOTO(err, "Failed to allocate shmstats_t\n");
+
+    strlcpy(s->name, name, sizeof(s->name));
+    s->hdr  = hdr;
+    s->size = st.st_size;
+
+    return s;
+err:
+    munmap(hdr, st.st_size);
+    return NULL;
+}
+
+void
+shmstats_close(shmstats_t *s)
+{
+    if (s) {
+        munmap(s->hdr, s->size);
+        free(s);
+    }
+}
+
+int
+shmstats_block_count(shmstats_t *s)
+{
+    uint32_t cnt;
+
+    if (!s)
+        return -1;
+
+    cnt = __atomic_load_n(&s->hdr->nb_blocks, __ATOMIC_ACQUIRE);
+
+    return (cnt > s->hdr->max_blocks) ? (int)s->hdr->max_blocks : (int)cnt;
+}
+
+/* Return the block table entry if it is active and fits in the mapping */
+static shmstats_desc_t *
+desc_get(shmstats_t *s, int idx)
+{
+    shmstats_desc_t *d;
+
+    if (!s || idx < 0 || idx >= shmstats_block_count(s))
+        return NULL;
+
+    d = &desc_table(s->hdr)[idx];
+    if (__atomic_load_n(&d->state, __ATOMIC_ACQUIRE) != SHMSTATS_BLK_ACTIVE)
+        return NULL;
+
+    if (d->names_off + ((uint64_t)d->nb_counters * SHMSTATS_NAME_LEN) > s->size ||
+        d->blk_off + sizeof(shmstats_blk_t) + ((uint64_t)d->nb_counters * sizeof(uint64_t)) >
+            s->size)
+        return NULL;
+
+    return d;
+}
+
+int
+shmstats_block_info(shmstats_t *s, int idx, shmstats_info_t *info)
+{
+    shmstats_desc_t *d = desc_get(s, idx);
+
+    if (!d || !info)
+        return -1;
+
+    memcpy(info->name, d->name, sizeof(info->name));
+    info->name[sizeof(info->name) - 1] = '\0';
+    info->type                         = d->type;
+    info->nb_counters                  = d->nb_counters;
+
+    return 0;
+}
+
+const char *
+shmstats_counter_name(shmstats_t *s, int idx, uint32_t cidx)
+{
+    shmstats_desc_t *d = desc_get(s, idx);
+    const char *name;
+
+    if (!d || cidx >= d->nb_counters)
+        return NULL;
+
+    name = seg_ptr(s->hdr, d->names_off + (cidx * SHMSTATS_NAME_LEN));
+
+    return (memchr(name, '\0', SHMSTATS_NAME_LEN)) ? name : "";
+}
+
+int
+shmstats_block_read(shmstats_t *s, int idx, uint64_t *vals, uint32_t nb_vals)
+{
+    shmstats_desc_t *d = desc_get(s, idx);
+    shmstats_blk_t *blk;
+    uint32_t nb;
+
+    if (!d || !vals)
+        return -1;
+
+    blk = seg_ptr(s->hdr, d->blk_off);
+    nb  = (nb_vals < d->nb_counters) ? nb_vals : d->nb_counters;
+
+    for (int i = 0; i < SHMSTATS_READ_RETRIES; i++) {
+        uint32_t seq = __atomic_load_n(&blk->seq, __ATOMIC_ACQUIRE);
+
+        if (seq & 1) {
+            cne_pause();
+            continue;
+        }
+
+        memcpy(vals, blk->counters, nb * sizeof(uint64_t));
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&blk->seq, __ATOMIC_RELAXED) == seq)
+            return nb;
+    }
+
+    errno = EAGAIN;
+    return -1;
+}
+
+void
+shmstats_dump(FILE *f, shmstats_t *s)
+{
+    uint64_t *vals;
+    int cnt;
+
+    if (!s)
+        return;
+    if (!f)
+        f = stdout;
+
+    cnt = shmstats_block_count(s);
+
+    fprintf(f,
+            ">>> Statistics segment '%s' pid %d, blocks %d, used %" PRIu64 " of %" PRIu64
+            " bytes\n",
+            s->name, s->hdr->pid, cnt, s->hdr->used, s->hdr->size);
+
+    for (int i = 0; i < cnt; i++) {
+        shmstats_info_t info;
+        int n;
+
+        if (shmstats_block_info(s, i, &info) < 0)
+            continue;
+
+        vals = calloc(info.nb_counters, sizeof(uint64_t));
+        if (!vals)
+            return;
+
+        n = shmstats_block_read(s, i, vals, info.nb_counters);
+        if (n < 0)
+            fprintf(f, "  %-32s type %u, no consistent snapshot\n", info.name, info.type);
+        else {
+            fprintf(f, "  %-32s type %u, counters %u\n", info.name, info.type, info.nb_counters);
+            for (int j = 0; j < n; j++) {
+                const char *cname = shmstats_counter_name(s, i, j);
+
+                fprintf(f, "    %-32s %20" PRIu64 "\n", (cname && cname[0]) ? cname : "-",
+                        vals[j]);
+            }
+        }
+        free(vals);
+    }
+}
@@ -0,0 +1,288 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _SHMSTATS_H_
+#define _SHMSTATS_H_
+
+/**
+ * @file
+ * CNE shared memory statistics segment
+ *
+ * A process creates one POSIX shared memory segment, /dev/shm/cndp_stats.<pid> by default,
+ * and subsystems allocate blocks of 64 bit counters in it. The thread owning a block
+ * updates the counters in place with normal loads and stores, only wrapping a burst of
+ * updates in shmstats_write_begin() and shmstats_write_end(). External monitors mmap the
+ * segment read-only and take a consistent copy of a block with shmstats_block_read(),
+ * without a socket round trip or any work in the writer process.
+ *
+ * Each block has its own sequence count used as a seqlock. The count is odd while the
+ * writer is updating the block, a reader copies the counters and retries when the count
+ * was odd or changed during the copy. A block is meant to have a single writer, when two
+ * threads update the same block the count always returns to even but a reader can see
+ * a copy with counters from both updates.
+ *
+ * The segment layout is versioned and described by the structures below so readers in
+ * other languages can decode it:
+ *
+ *   shmstats_hdr_t | shmstats_desc_t[max_blocks] | counter names and blocks ...
+ *
+ * Every block starts on a cache line so blocks of different threads do not share lines.
+ */
+
+#include <stdio.h>             // for FILE
+#include <stdint.h>            // for uint64_t, uint32_t
+#include <cne_common.h>        // for CNDP_API, __cne_cache_aligned
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHMSTATS_MAGIC        0x5354415453444e43ULL /**< "CNDSTATS" in little endian */
+#define SHMSTATS_VERSION      1                     /**< Version of the segment layout */
+#define SHMSTATS_NAME_LEN     64                    /**< Max length of block or counter names */
+#define SHMSTATS_MAX_BLOCKS   1024                  /**< Number of block table entries */
+#define SHMSTATS_DEFAULT_SIZE (4 * 1024 * 1024)     /**< Default segment size in bytes */
+#define SHMSTATS_PREFIX       "cndp_stats"          /**< Default segment is /cndp_stats.<pid> */
+#define SHMSTATS_READ_RETRIES 128                   /**< Copy attempts for one block snapshot */
+
+/**
+ * Block types, lets a reader decode a block without looking at the counter names
+ */
+enum {
+    SHMSTATS_TYPE_NONE,         /**< Generic counters */
+    SHMSTATS_TYPE_LPORT,        /**< lport_stats_t counters */
+    SHMSTATS_TYPE_GRAPH,        /**< Graph node counters */
+    SHMSTATS_TYPE_MEMPOOL,      /**< Mempool counters */
+    SHMSTATS_TYPE_TCP,          /**< TCP counters */
+    SHMSTATS_TYPE_USER = 0x100, /**< First application defined type */
+};
+
+/**
+ * Block table entry states
+ */
+enum {
+    SHMSTATS_BLK_FREE,   /**< Entry was freed, the block data can be reused */
+    SHMSTATS_BLK_ACTIVE, /**< Block is allocated and being updated */
+};
+
+/**
+ * Segment header at offset zero
+ */
+typedef struct shmstats_hdr {
+    uint64_t magic;      /**< SHMSTATS_MAGIC */
+    uint32_t version;    /**< SHMSTATS_VERSION */
+    uint32_t hdr_size;   /**< Size of this header, the block table follows it */
+    uint64_t size;       /**< Size of the segment in bytes */
+    uint32_t max_blocks; /**< Number of entries in the block table */
+    uint32_t nb_blocks;  /**< Number of block table entries ever used */
+    uint32_t gen;        /**< Incremented each time a block is allocated or freed */
+    int32_t pid;         /**< Process ID of the writer */
+    uint64_t used;       /**< Bytes of the segment allocated so far */
+} __cne_cache_aligned shmstats_hdr_t;
+
+/**
+ * Block table entry describing one block of counters
+ */
+typedef struct shmstats_desc {
+    char name[SHMSTATS_NAME_LEN]; /**< Name of the block, e.g. the lport name */
+    uint32_t type;                /**< SHMSTATS_TYPE_XXX value */
+    uint32_t state;               /**< SHMSTATS_BLK_XXX state */
+    uint32_t nb_counters;         /**< Number of counters in the block */
+    uint32_t reserved;            /**< Reserved */
+    uint64_t names_off;           /**< Offset of nb_counters names of SHMSTATS_NAME_LEN bytes */
+    uint64_t blk_off;             /**< Offset of the shmstats_blk_t */
+} __cne_cache_aligned shmstats_desc_t;
+
+/**
+ * A block of counters as written by its owner
+ */
+typedef struct shmstats_blk {
+    uint32_t seq;         /**< Sequence count, odd while the counters are being updated */
+    uint32_t nb_counters; /**< Number of counters */
+    uint64_t reserved;    /**< Reserved */
+    uint64_t counters[];  /**< The counters */
+} shmstats_blk_t;
+
+/**
+ * Block information returned to a reader
+ */
+typedef struct shmstats_info {
+    char name[SHMSTATS_NAME_LEN]; /**< Name of the block */
+    uint32_t type;                /**< SHMSTATS_TYPE_XXX value */
+    uint32_t nb_counters;         /**< Number of counters in the block */
+} shmstats_info_t;
+
+typedef struct shmstats shmstats_t; /**< Opaque structure of a reader mapping */
+
+/**
+ * Create the shared memory statistics segment of this process
+ *
+ * Blocks can only be allocated once the segment exists, subsystems fall back to private
+ * counters when shmstats_block_alloc() returns NULL.
+ *
+ * @param name
+ *   The shm_open() name of the segment or NULL for /cndp_stats.<pid>
+ * @param size
+ *   The size of the segment in bytes or 0 for SHMSTATS_DEFAULT_SIZE
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int shmstats_create(const char *name, size_t size);
+
+/**
+ * Unmap and unlink the statistics segment of this process
+ *
+ * All blocks are released, the caller must make sure no thread still updates them.
+ */
+CNDP_API void shmstats_destroy(void);
+
+/**
+ * Return the name of the statistics segment of this process
+ *
+ * @return
+ *   NULL if the segment was not created or the shm_open() name
+ */
+CNDP_API const char *shmstats_name(void);
+
+/**
+ * Allocate a block of counters in the statistics segment
+ *
+ * @param name
+ *   The name of the block
+ * @param type
+ *   The SHMSTATS_TYPE_XXX value of the block
+ * @param names
+ *   Array of nb_counters counter names or NULL to leave the names empty
+ * @param nb_counters
+ *   The number of 64 bit counters in the block
+ * @return
+ *   NULL if the segment does not exist or is full, otherwise the zeroed block
+ */
+CNDP_API shmstats_blk_t *shmstats_block_alloc(const char *name, uint32_t type,
+                                              const char *const *names, uint32_t nb_counters);
+
+/**
+ * Free a block allocated by shmstats_block_alloc()
+ *
+ * @param blk
+ *   The block to free, can be NULL
+ */
+CNDP_API void shmstats_block_free(shmstats_blk_t *blk);
+
+/**
+ * Start updating the counters of a block, called by the thread owning the block
+ *
+ * @param blk
+ *   The block pointer, can be NULL
+ */
+static inline void
+shmstats_write_begin(shmstats_blk_t *blk)
+{
+    if (blk) {
+        __atomic_store_n(&blk->seq, blk->seq | 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * Finish updating the counters of a block and let readers take a snapshot
+ *
+ * @param blk
+ *   The block pointer, can be NULL
+ */
+static inline void
+shmstats_write_end(shmstats_blk_t *blk)
+{
+    if (blk)
+        __atomic_store_n(&blk->seq, (blk->seq | 1) + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Map the statistics segment of a process read-only
+ *
+ * @param name
+ *   The shm_open() name of the segment, e.g. /cndp_stats.1234
+ * @return
+ *   NULL on error or the reader mapping
+ */
+CNDP_API shmstats_t *shmstats_open(const char *name);
+
+/**
+ * Unmap a segment opened with shmstats_open()
+ *
+ * @param s
+ *   The reader mapping, can be NULL
+ */
+CNDP_API void shmstats_close(shmstats_t *s);
+
+/**
+ * Return the number of block table entries to scan
+ *
+ * @param s
+ *   The reader mapping
+ * @return
+ *   -1 on error or the number of block table entries used, some can be free
+ */
+CNDP_API int shmstats_block_count(shmstats_t *s);
+
+/**
+ * Return the information of a block
+ *
+ * @param s
+ *   The reader mapping
+ * @param idx
+ *   The block table index, 0 to shmstats_block_count() - 1
+ * @param info
+ *   The location to store the block information
+ * @return
+ *   0 on success or -1 if the entry is free or invalid
+ */
+CNDP_API int shmstats_block_info(shmstats_t *s, int idx, shmstats_info_t *info);
+
+/**
+ * Return the name of a counter in a block
+ *
+ * @param s
+ *   The reader mapping
+ * @param idx
+ *   The block table index
+ * @param cidx
+ *   The counter index in the block
+ * @return
+ *   NULL on error or the counter name, can be an empty string
+ */
+CNDP_API const char *shmstats_counter_name(shmstats_t *s, int idx, uint32_t cidx);
+
+/**
+ * Take a consistent copy of the counters of a block
+ *
+ * @param s
+ *   The reader mapping
+ * @param idx
+ *   The block table index
+ * @param vals
+ *   The array to copy the counters into
+ * @param nb_vals
+ *   The number of entries in vals, fewer counters than the block has can be read
+ * @return
+ *   The number of counters copied or -1 on error, errno is EAGAIN when a consistent
+ *   copy could not be taken in SHMSTATS_READ_RETRIES attempts
+ */
+CNDP_API int shmstats_block_read(shmstats_t *s, int idx, uint64_t *vals, uint32_t nb_vals);
+
+/**
+ * Dump out all blocks and counters of a segment
+ *
+ * @param f
+ *   The file pointer to write the text output or NULL if stdout
+ * @param s
+ *   The reader mapping
+ */
+CNDP_API void shmstats_dump(FILE *f, shmstats_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SHMSTATS_H_ */
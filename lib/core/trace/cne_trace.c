@@ -0,0 +1,359 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>             // for fprintf, fopen, fclose, FILE
+#include <errno.h>             // for program_invocation_short_name
+#include <stdlib.h>            // for posix_memalign, malloc, free
+#include <inttypes.h>          // for PRIu64
+#include <string.h>            // for memcpy, memset, strcmp, strchr
+#include <fnmatch.h>           // for fnmatch
+#include <pthread.h>           // for pthread_mutex_lock, pthread_getname_np
+#include <unistd.h>            // for getpid, gettid
+#include <cne_common.h>
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_gettid.h>        // for gettid
+#include <cne_system.h>        // for cne_get_timer_hz
+#include <cne_log.h>
+
+#include "cne_trace.h"
+
+#define TRACE_THREAD_NAME_LEN 16
+
+/* Per-thread ring of records, written by the owning thread only */
+struct trace_ring {
+    uint64_t head;                    /**< Index of the next record to write */
+    uint64_t start;                   /**< Records before this index were cleared */
+    int tid;                          /**< Thread ID of the owning thread */
+    char name[TRACE_THREAD_NAME_LEN]; /**< Name of the owning thread */
+    cne_trace_rec_t recs[CNE_TRACE_RING_SIZE] __cne_cache_aligned;
+};
+
+static cne_trace_point_t *trace_points[CNE_TRACE_MAX_POINTS];
+static uint32_t trace_nb_points;
+
+static __thread struct trace_ring *trace_ring;
+
+static struct trace_ring *trace_rings[CNE_TRACE_MAX_RINGS];
+static uint32_t trace_nb_rings;
+static uint64_t trace_start_tsc;
+
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+int
+cne_trace_point_register(cne_trace_point_t *tp)
+{
+    const char *p;
+
+    if (!tp || !tp->name)
+        return -1;
+
+    pthread_mutex_lock(&trace_lock);
+
+    if (trace_nb_points >= CNE_TRACE_MAX_POINTS) {
+        pthread_mutex_unlock(&trace_lock);
+        CNE_ERR_RET("Too many trace points to register %s\n", tp->name);
+    }
+
+    tp->nargs = 0;
+    if (tp->args && tp->args[0] != '\0')
+        for (tp->nargs = 1, p = tp->args; (p = strchr(p, ',')) != NULL; p++)
+            tp->nargs++;
+
+    tp->id                          = trace_nb_points;
+    trace_points[trace_nb_points++] = tp;
+
+    pthread_mutex_unlock(&trace_lock);
+
+    return 0;
+}
+
+static int
+trace_set(const char *pattern, uint32_t enable)
+{
+    int cnt = 0;
+
+    if (!pattern)
+        return -1;
+
+    pthread_mutex_lock(&trace_lock);
+    for (uint32_t i = 0; i < trace_nb_points; i++) {
+        if (fnmatch(pattern, trace_points[i]->name, 0) == 0) {
+            __atomic_store_n(&trace_points[i]->enabled, enable, __ATOMIC_RELAXED);
+            cnt++;
+        }
+    }
+    pthread_mutex_unlock(&trace_lock);
+
+    return cnt;
+}
+
+int
+cne_trace_enable(const char *pattern)
+{
+    return trace_set(pattern, 1);
+}
+
+int
+cne_trace_disable(const char *pattern)
+{
+    return trace_set(pattern, 0);
+}
+
+int
+cne_trace_is_enabled(const char *name)
+{
+    int ret = -1;
+
+    if (!name)
+        return -1;
+
+    pthread_mutex_lock(&trace_lock);
+    for (uint32_t i = 0; i < trace_nb_points; i++) {
+        if (!strcmp(name, trace_points[i]->name)) {
+            ret = __atomic_load_n(&trace_points[i]->enabled, __ATOMIC_RELAXED) ? 1 : 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&trace_lock);
+
+    return ret;
+}
+
+static struct trace_ring *
+trace_ring_create(void)
+{
+    struct trace_ring *r = NULL;
+
+    pthread_mutex_lock(&trace_lock);
+
+    if (trace_nb_rings >= CNE_TRACE_MAX_RINGS)
+        goto leave;
+
+    if (posix_memalign((void **)&r, CNE_CACHE_LINE_SIZE, sizeof(*r))) {
+        r = NULL;
+        goto leave;
+    }
+    memset(r, 0, offsetof(struct trace_ring, recs));
+
+    r->tid = gettid();
+    if (pthread_getname_np(pthread_self(), r->name, sizeof(r->name)))
+        snprintf(r->name, sizeof(r->name), "tid-%d", r->tid);
+
+    if (trace_start_tsc == 0)
+        trace_start_tsc = cne_rdtsc();
+
+    /* Publish the ring after it is initialized, cne_trace_dump() reads it */
+    trace_rings[trace_nb_rings] = r;
+    __atomic_store_n(&trace_nb_rings, trace_nb_rings + 1, __ATOMIC_RELEASE);
+
+leave:
+    pthread_mutex_unlock(&trace_lock);
+
+    /* Do not retry on every event when the ring can not be created */
+    trace_ring = (r) ? r : (struct trace_ring *)-1;
+    return r;
+}
+
+void
+__cne_trace_emit(cne_trace_point_t *tp, const uint64_t *args, uint32_t nargs)
+{
+    struct trace_ring *r = trace_ring;
+    cne_trace_rec_t *rec;
+    uint64_t head;
+
+    if (unlikely(r == NULL))
+        r = trace_ring_create();
+    if (unlikely(r == NULL || r == (struct trace_ring *)-1))
+        return;
+
+    if (nargs > CNE_TRACE_MAX_ARGS)
+        nargs = CNE_TRACE_MAX_ARGS;
+
+    head       = r->head;
+    rec        = &r->recs[head & (CNE_TRACE_RING_SIZE - 1)];
+    rec->tsc   = cne_rdtsc();
+    rec->id    = tp->id;
+    rec->nargs = nargs;
+    memcpy(rec->args, args, nargs * sizeof(uint64_t));
+
+    __atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void
+cne_trace_clear(void)
+{
+    uint32_t cnt = __atomic_load_n(&trace_nb_rings, __ATOMIC_ACQUIRE);
+
+    for (uint32_t i = 0; i < cnt; i++) {
+        struct trace_ring *r = trace_rings[i];
+
+        __atomic_store_n(&r->start, __atomic_load_n(&r->head, __ATOMIC_ACQUIRE),
+                         __ATOMIC_RELAXED);
+    }
+}
+
+void
+cne_trace_list(FILE *f)
+{
+    if (!f)
+        f = stdout;
+
+    pthread_mutex_lock(&trace_lock);
+    fprintf(f, "%-32s %-8s %s\n", "Trace point", "State", "Arguments");
+    for (uint32_t i = 0; i < trace_nb_points; i++) {
+        cne_trace_point_t *tp = trace_points[i];
+
+        fprintf(f, "%-32s %-8s %s\n", tp->name,
+                __atomic_load_n(&tp->enabled, __ATOMIC_RELAXED) ? "enabled" : "disabled",
+                tp->args ? tp->args : "");
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+/*
+ * Copy the valid records of a ring, the owning thread keeps writing. A record is kept only
+ * if the writer could not have started to overwrite it before the copy was finished.
+ */
+static uint32_t
+trace_ring_copy(struct trace_ring *r, cne_trace_rec_t *recs)
+{
+    uint64_t head, start, lo;
+    uint32_t n = 0;
+
+    head  = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    start = __atomic_load_n(&r->start, __ATOMIC_RELAXED);
+    lo    = (head > CNE_TRACE_RING_SIZE) ? head - CNE_TRACE_RING_SIZE : 0;
+    if (lo < start)
+        lo = start;
+
+    for (uint64_t i = lo; i < head; i++)
+        recs[n++] = r->recs[i & (CNE_TRACE_RING_SIZE - 1)];
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    /* Records at or below the index being written by the writer now may be torn */
+    head = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+    if (head + 1 > lo + CNE_TRACE_RING_SIZE) {
+        uint64_t skip = head + 1 - CNE_TRACE_RING_SIZE - lo;
+
+        if (skip > n)
+            skip = n;
+        memmove(recs, &recs[skip], (n - skip) * sizeof(cne_trace_rec_t));
+        n -= skip;
+    }
+
+    return n;
+}
+
+static void
+trace_json_str(FILE *f, const char *s)
+{
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fputc('\\', f);
+        if ((unsigned char)*s >= ' ')
+            fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void
+trace_json_event(FILE *f, int pid, int tid, const cne_trace_rec_t *rec, double us)
+{
+    cne_trace_point_t *tp = trace_points[rec->id];
+    const char *a         = tp->args ? tp->args : "";
+    const char *dot       = strchr(tp->name, '.');
+    int cat_len           = dot ? (int)(dot - tp->name) : (int)strlen(tp->name);
+
+    fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"%.*s\",\"ph\":\"i\",\"s\":\"t\",", tp->name,
+            cat_len, tp->name);
+    fprintf(f, "\"ts\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{", us, pid, tid);
+
+    for (uint32_t j = 0; j < rec->nargs; j++) {
+        const char *end = (*a) ? strchr(a, ',') : NULL;
+        int len         = end ? (int)(end - a) : (int)strlen(a);
+
+        if (len)
+            fprintf(f, "%s\"%.*s\":%" PRIu64, j ? "," : "", len, a, rec->args[j]);
+        else
+            fprintf(f, "%s\"arg%u\":%" PRIu64, j ? "," : "", j, rec->args[j]);
+        a = end ? end + 1 : a + len;
+    }
+    fprintf(f, "}}");
+}
+
+int
+cne_trace_dump(FILE *f)
+{
+    cne_trace_rec_t *recs;
+    uint32_t cnt;
+    uint64_t hz = cne_get_timer_hz();
+    int pid     = getpid();
+    int total   = 0;
+
+    if (!f)
+        f = stdout;
+    if (hz == 0)
+        hz = 1;
+
+    recs = malloc(CNE_TRACE_RING_SIZE * sizeof(cne_trace_rec_t));
+    if (!recs)
+        CNE_ERR_RET("Unable to allocate trace records\n");
+
+    /* The first event names the process, the others start with a comma */
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":", pid);
+    trace_json_str(f, program_invocation_short_name);
+    fprintf(f, "}}");
+
+    cnt = __atomic_load_n(&trace_nb_rings, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < cnt; i++) {
+        struct trace_ring *r = trace_rings[i];
+        uint32_t n;
+
+        fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,", pid,
+                r->tid);
+        fprintf(f, "\"args\":{\"name\":");
+        trace_json_str(f, r->name);
+        fprintf(f, "}}");
+
+        n = trace_ring_copy(r, recs);
+        for (uint32_t j = 0; j < n; j++) {
+            double us;
+
+            if (recs[j].id >= trace_nb_points)
+                continue;
+            us = (double)(recs[j].tsc - trace_start_tsc) * 1e6 / (double)hz;
+
+            trace_json_event(f, pid, r->tid, &recs[j], us);
+        }
+        total += n;
+    }
+    fprintf(f, "\n]}\n");
+    fflush(f);
+
+    free(recs);
+
+    return total;
+}
+
+int
+cne_trace_save(const char *path)
+{
+    FILE *f;
+    int ret;
+
+    if (!path)
+        return -1;
+
+    f = fopen(path, "w");
+    if (!f)
+        CNE_ERR_RET("Unable to create trace file %s\n", path);
+
+    ret = cne_trace_dump(f);
+    fclose(f);
+
+    return ret;
+}
@@ -0,0 +1,191 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_TRACE_H_
+#define _CNE_TRACE_H_
+
+/**
+ * @file
+ *
+ * CNE static trace points
+ *
+ * A trace point is declared at compile time with CNE_TRACE_POINT_DEFINE() and is disabled
+ * until a pattern matching its name is given to cne_trace_enable(). A disabled trace point
+ * costs a load and a predicted branch. An enabled trace point writes a 64 byte record with
+ * the TSC and up to CNE_TRACE_MAX_ARGS integer arguments to a ring owned by the calling
+ * thread, overwriting the oldest record when the ring is full.
+ *
+ * cne_trace_save() writes the records of all threads in the JSON trace event format,
+ * which is read by the Perfetto UI (ui.perfetto.dev) and chrome://tracing.
+ *
+ * Trace point names are <library>.<event>, the library is used as the event category.
+ */
+
+#include <stdio.h>             // for FILE
+#include <stdint.h>            // for uint64_t, uint32_t, uint16_t
+#include <cne_common.h>        // for CNDP_API, CNE_INIT
+#include <cne_branch_prediction.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_TRACE_MAX_ARGS   6    /**< Max number of arguments of a trace point */
+#define CNE_TRACE_RING_SIZE  4096 /**< Number of records in a thread ring, power of 2 */
+#define CNE_TRACE_MAX_RINGS  256  /**< Max number of threads recording trace events */
+#define CNE_TRACE_MAX_POINTS 256  /**< Max number of trace points */
+
+/**
+ * Trace point descriptor, defined with CNE_TRACE_POINT_DEFINE()
+ */
+typedef struct cne_trace_point {
+    uint32_t enabled; /**< Non-zero when the trace point records events */
+    uint16_t id;      /**< Index of the trace point, set when registered */
+    uint16_t nargs;   /**< Number of names in args */
+    const char *name; /**< Name of the trace point, e.g. xskdev.rx_burst */
+    const char *args; /**< Comma separated names of the arguments, e.g. "ifindex,nb_pkts" */
+} cne_trace_point_t;
+
+/**
+ * Trace record, one cache line
+ */
+typedef struct cne_trace_rec {
+    uint64_t tsc;                      /**< TSC of the event */
+    uint16_t id;                       /**< Trace point index */
+    uint16_t nargs;                    /**< Number of valid arguments */
+    uint32_t reserved;                 /**< Reserved */
+    uint64_t args[CNE_TRACE_MAX_ARGS]; /**< Arguments of the event */
+} cne_trace_rec_t;
+
+/**
+ * Define and register a trace point, must be used at file scope
+ *
+ * @param tp
+ *   The name of the cne_trace_point_t variable to define
+ * @param _name
+ *   The trace point name string, e.g. "mempool.get_fail"
+ * @param _args
+ *   The comma separated names of the arguments string, e.g. "mp,n"
+ */
+#define CNE_TRACE_POINT_DEFINE(tp, _name, _args)                    \
+    CNDP_API cne_trace_point_t tp = {.name = _name, .args = _args}; \
+    CNE_INIT(tp##_register)                                         \
+    {                                                               \
+        cne_trace_point_register(&tp);                              \
+    }
+
+/**
+ * Declare a trace point defined in another file
+ */
+#define CNE_TRACE_POINT_DECLARE(tp) extern CNDP_API cne_trace_point_t tp
+
+/**
+ * Record a trace event if the trace point is enabled
+ *
+ * @param tp
+ *   The cne_trace_point_t variable of the trace point
+ * @param ...
+ *   One to CNE_TRACE_MAX_ARGS integer arguments, pointers must be cast to uintptr_t
+ */
+#define CNE_TRACE(tp, ...)                                                                \
+    do {                                                                                  \
+        if (unlikely(__atomic_load_n(&(tp).enabled, __ATOMIC_RELAXED)))                   \
+            __cne_trace_emit(&(tp), (const uint64_t[]){__VA_ARGS__},                      \
+                             sizeof((const uint64_t[]){__VA_ARGS__}) / sizeof(uint64_t)); \
+    } while ((0))
+
+/**
+ * Register a trace point, called by the constructor of CNE_TRACE_POINT_DEFINE()
+ *
+ * @param tp
+ *   The trace point to register
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int cne_trace_point_register(cne_trace_point_t *tp);
+
+/**
+ * Enable the trace points with a name matching a pattern
+ *
+ * @param pattern
+ *   A fnmatch(3) pattern, e.g. "xskdev.*" or "*"
+ * @return
+ *   The number of trace points matching the pattern or -1 on error
+ */
+CNDP_API int cne_trace_enable(const char *pattern);
+
+/**
+ * Disable the trace points with a name matching a pattern
+ *
+ * @param pattern
+ *   A fnmatch(3) pattern, e.g. "xskdev.*" or "*"
+ * @return
+ *   The number of trace points matching the pattern or -1 on error
+ */
+CNDP_API int cne_trace_disable(const char *pattern);
+
+/**
+ * Test if a trace point is enabled
+ *
+ * @param name
+ *   The name of the trace point
+ * @return
+ *   1 if enabled, 0 if disabled or -1 if the trace point does not exist
+ */
+CNDP_API int cne_trace_is_enabled(const char *name);
+
+/**
+ * Forget the records recorded so far by all threads
+ */
+CNDP_API void cne_trace_clear(void);
+
+/**
+ * Write the trace points and their state
+ *
+ * @param f
+ *   The file to write to or NULL for stdout
+ */
+CNDP_API void cne_trace_list(FILE *f);
+
+/**
+ * Write the records of all threads in the JSON trace event format
+ *
+ * The records of a thread are copied without stopping it. The records the thread could
+ * have overwritten while they were copied are skipped, including the oldest record of a
+ * full ring.
+ *
+ * @param f
+ *   The file to write to or NULL for stdout
+ * @return
+ *   The number of events written or -1 on error
+ */
+CNDP_API int cne_trace_dump(FILE *f);
+
+/**
+ * Write the records of all threads in the JSON trace event format to a file
+ *
+ * @param path
+ *   The path of the file to create
+ * @return
+ *   The number of events written or -1 on error
+ */
+CNDP_API int cne_trace_save(const char *path);
+
+/**
+ * Record a trace event, use CNE_TRACE() and not this function directly
+ *
+ * @param tp
+ *   The trace point
+ * @param args
+ *   The arguments of the event
+ * @param nargs
+ *   The number of arguments
+ */
+CNDP_API void __cne_trace_emit(cne_trace_point_t *tp, const uint64_t *args, uint32_t nargs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_TRACE_H_ */
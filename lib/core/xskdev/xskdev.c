@@ -5,6 +5,7 @@
 // IWYU pragma: no_include <asm/int-ll64.h>
 #include <unistd.h>               // for close
 #include <errno.h>                // for errno, EAGAIN, EOPNOTSUPP, EBUSY, EINTR
+#include <stdio.h>                // for snprintf
 #include <stdlib.h>               // for calloc, free, exit, EXIT_FAILURE
 #include <string.h>               // for strerror, memset, memcpy
 #include <sys/socket.h>           // for getsockopt, send, socket, AF_INET, MSG...
@@ -24,6 +25,7 @@
 #include <linux/sched.h>          // for sched_yield
 #include <netdev_funcs.h>         // for netdev_get_ring_params
 #include <cne_mutex_helper.h>
+#include <cne_trace.h>            // for CNE_TRACE, CNE_TRACE_POINT_DEFINE
 #include <dirent.h>
 #include <limits.h>        // for PATH_MAX
 #include <bpf/bpf.h>
@@ -38,6 +40,47 @@
 
 static bool xskdev_use_tx_lock = true;
 
+CNE_TRACE_POINT_DEFINE(xskdev_trace_rx, "xskdev.rx_burst", "ifindex,nb_pkts,rcvd");
+CNE_TRACE_POINT_DEFINE(xskdev_trace_tx, "xskdev.tx_burst", "ifindex,nb_pkts,sent");
+CNE_TRACE_POINT_DEFINE(xskdev_trace_fq_alloc, "xskdev.fq_alloc_fail", "ifindex,nb_bufs");
+
+/* Names of the lport_stats_t counters in the shmstats segment, in structure order */
+static const char *const lport_stats_names[] = {
+    "ipackets",
+    "opackets",
+    "ibytes",
+    "obytes",
+    "ierrors",
+    "oerrors",
+    "imissed",
+    "odropped",
+    "rx_invalid",
+    "tx_invalid",
+    "rx_ring_empty",
+    "rx_buf_alloc",
+    "rx_busypoll_wakeup",
+    "rx_poll_wakeup",
+    "rx_rcvd_count",
+    "rx_burst_called",
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 9, 0)
+    "rx_ring_full",
+    "rx_fill_ring_empty",
+    "tx_ring_empty",
+#endif
+    "fq_add_called",
+    "fq_add_count",
+    "fq_full",
+    "fq_alloc_zero",
+    "fq_reserve_failed",
+    "tx_kicks",
+    "tx_kick_failed",
+    "tx_kick_again",
+    "tx_ring_full",
+    "tx_copied",
+    "cq_empty",
+    "cq_buf_freed",
+};
+
 static TAILQ_HEAD(cne_xskdev_list, xskdev_info) xskdev_list;
 static pthread_mutex_t xskdev_list_mutex;
 
@@ -201,6 +244,21 @@ xsk_ring_prod__cancel(struct xsk_ring_prod *prod, __u32 nb)
     prod->cached_prod -= nb;
 }
 
+/*
+ * Start a burst of stats updates. The Rx and Tx paths each own a block of stats, the Tx
+ * block is shared by the threads sending under tx_lock. xskdev_stats_reset() only asks for
+ * a reset, the writer clears its own block here so counters are never written by two threads.
+ */
+static __cne_always_inline void
+stats_write_begin(shmstats_blk_t *blk, lport_stats_t *stats, uint32_t *reset)
+{
+    shmstats_write_begin(blk);
+
+    if (unlikely(__atomic_load_n(reset, __ATOMIC_RELAXED)) &&
+        __atomic_exchange_n(reset, 0, __ATOMIC_ACQUIRE))
+        memset(stats, 0, sizeof(lport_stats_t));
+}
+
 static void
 fq_add(xskdev_info_t *xi, int times)
 {
@@ -210,21 +268,22 @@ fq_add(xskdev_info_t *xi, int times)
     uint32_t nb_bufs;
     uint32_t pos = 0;
 
-    xi->stats.fq_add_called++;
+    xi->rx_stats->fq_add_called++;
 
     for (int i = 0; i < times; i++) {
         if (xsk_ring_prod__reserve(fq, FQ_ADD_BURST_COUNT, &pos) != FQ_ADD_BURST_COUNT) {
-            xi->stats.fq_reserve_failed++;
+            xi->rx_stats->fq_reserve_failed++;
             break;
         }
 
         nb_bufs = xskdev_buf_alloc(xi, (void **)bufs, FQ_ADD_BURST_COUNT);
         if (nb_bufs != FQ_ADD_BURST_COUNT) {
-            xi->stats.fq_alloc_zero++;
+            xi->rx_stats->fq_alloc_zero++;
+            CNE_TRACE(xskdev_trace_fq_alloc, xi->if_index, nb_bufs);
             xsk_ring_prod__cancel(fq, nb_bufs);
             break;
         }
-        xi->stats.rx_buf_alloc += nb_bufs;
+        xi->rx_stats->rx_buf_alloc += nb_bufs;
 
         for (uint32_t i = 0; i < nb_bufs; i++) {
             void *buf       = bufs[i];
@@ -237,7 +296,7 @@ fq_add(xskdev_info_t *xi, int times)
         }
 
         xsk_ring_prod__submit(fq, nb_bufs);
-        xi->stats.fq_add_count += nb_bufs;
+        xi->rx_stats->fq_add_count += nb_bufs;
     }
 }
 
@@ -318,26 +377,31 @@ xskdev_rx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
         return 0;
     rx = &rxq->rx;
 
-    xi->stats.rx_burst_called++;
+    stats_write_begin(xi->rx_stats_blk, xi->rx_stats, &xi->rx_stats_reset);
+
+    xi->rx_stats->rx_burst_called++;
 
     idx_rx = 0;
     rcvd   = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
     if (!rcvd) {
-        xi->stats.rx_ring_empty++;
+        xi->rx_stats->rx_ring_empty++;
         /*
          * Assuming a kernel >= 5.11 is used and busy_polling is enabled,
          * we can use the recvfrom() syscall for AF_XDP sockets.
          */
         if (xi->busy_polling) {
-            xi->stats.rx_busypoll_wakeup++;
+            xi->rx_stats->rx_busypoll_wakeup++;
             (void)recvfrom(xsk_socket__fd(rxq->xsk), NULL, 0, MSG_DONTWAIT, NULL, NULL);
         } else if (xi->needs_wakeup || xsk_ring_prod__needs_wakeup(&ux->fq)) {
-            xi->stats.rx_poll_wakeup++;
+            xi->rx_stats->rx_poll_wakeup++;
             (void)poll(&rxq->fds, 1, POLL_TIMEOUT);
         }
+        shmstats_write_end(xi->rx_stats_blk);
         return 0;
     } else
-        xi->stats.rx_rcvd_count += rcvd;
+        xi->rx_stats->rx_rcvd_count += rcvd;
+
+    CNE_TRACE(xskdev_trace_rx, xi->if_index, nb_pkts, rcvd);
 
     umem_addr = ux->umem_addr;
 
@@ -369,13 +433,15 @@ xskdev_rx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
         break;
     }
 
-    xi->stats.ipackets += rcvd;
-    xi->stats.ibytes += rx_bytes;
+    xi->rx_stats->ipackets += rcvd;
+    xi->rx_stats->ibytes += rx_bytes;
 
     xsk_ring_cons__release(rx, rcvd);
 
     fq_add(xi, 2); /* Attempt to keep the FQ as full as possible */
 
+    shmstats_write_end(xi->rx_stats_blk);
+
     return (uint16_t)rcvd;
 }
 
@@ -385,17 +451,17 @@ kick_tx(xskdev_info_t *xi)
     xskdev_txq_t *txq = &xi->txq;
 
     if (xi->needs_wakeup || xsk_ring_prod__needs_wakeup(&txq->tx)) {
-        xi->stats.tx_kicks++;
+        xi->tx_stats->tx_kicks++;
 
         if (unlikely(sendto(xsk_socket__fd(txq->xsk), NULL, 0, MSG_DONTWAIT, NULL, 0) < 0)) {
 
             if (errno == EAGAIN) {
-                xi->stats.tx_kick_again++;
+                xi->tx_stats->tx_kick_again++;
 
                 if (sendto(xsk_socket__fd(txq->xsk), NULL, 0, MSG_DONTWAIT, NULL, 0) < 0)
-                    xi->stats.tx_kick_failed++;
+                    xi->tx_stats->tx_kick_failed++;
             } else
-                xi->stats.tx_kick_failed++;
+                xi->tx_stats->tx_kick_failed++;
         }
     }
 }
@@ -433,7 +499,7 @@ pull_umem_cq(xskdev_info_t *xi)
 
     n = xsk_ring_cons__peek(cq, mbuf_cnt, &idx_cq);
     if (unlikely(n == 0)) {
-        xi->stats.cq_empty++;
+        xi->tx_stats->cq_empty++;
         return;
     }
 
@@ -448,7 +514,7 @@ pull_umem_cq(xskdev_info_t *xi)
 
     xskdev_buf_free(xi, mbufs, n);
 
-    xi->stats.cq_buf_freed += n;
+    xi->tx_stats->cq_buf_freed += n;
 }
 
 static __cne_always_inline uint64_t
@@ -489,6 +555,8 @@ xskdev_tx_burst_locked(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts)
 
     umem_addr = (uint64_t)ux->umem_addr;
 
+    stats_write_begin(xi->tx_stats_blk, xi->tx_stats, &xi->tx_stats_reset);
+
     nb_free = xsk_ring_prod__reserve(&txq->tx, nb_pkts, &idx_tx);
 
     for (uint32_t j = 0; j < nb_free; j++) {
@@ -502,10 +570,14 @@ xskdev_tx_burst_locked(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts)
 
     xsk_ring_prod__submit(&txq->tx, nb_free);
 
+    CNE_TRACE(xskdev_trace_tx, xi->if_index, nb_pkts, nb_free);
+
     pull_umem_cq(xi);
 
-    xi->stats.opackets += nb_free;
-    xi->stats.obytes += tx_bytes;
+    xi->tx_stats->opackets += nb_free;
+    xi->tx_stats->obytes += tx_bytes;
+
+    shmstats_write_end(xi->tx_stats_blk);
 
     return nb_free;
 }
@@ -720,6 +792,18 @@ xskdev_buf_set_buf_mgmt_ops(lport_buf_mgmt_t *dst, lport_buf_mgmt_t *src)
         memcpy(dst, src, sizeof(lport_buf_mgmt_t));
 }
 
+/* Allocate the <name>:rx or <name>:tx stats block, the reader adds the two blocks */
+static shmstats_blk_t *
+stats_blk_alloc(const char *name, const char *dir)
+{
+    char bname[SHMSTATS_NAME_LEN];
+
+    snprintf(bname, sizeof(bname), "%s:%s", name, dir);
+
+    return shmstats_block_alloc(bname, SHMSTATS_TYPE_LPORT, lport_stats_names,
+                                cne_countof(lport_stats_names));
+}
+
 xskdev_info_t *
 xskdev_socket_create(struct lport_cfg *c)
 {
@@ -739,6 +823,17 @@ xskdev_socket_create(struct lport_cfg *c)
     strlcpy(xi->ifname, c->ifname, sizeof(xi->ifname));
     xi->xsk_map_fd = -1;
 
+    /* Place the stats in the shmstats segment when the application created one */
+    CNE_BUILD_BUG_ON(cne_countof(lport_stats_names) * sizeof(uint64_t) != sizeof(lport_stats_t));
+    xi->rx_stats     = &xi->rx_stats_mem;
+    xi->tx_stats     = &xi->tx_stats_mem;
+    xi->rx_stats_blk = stats_blk_alloc((c->name[0]) ? c->name : c->ifname, "rx");
+    xi->tx_stats_blk = stats_blk_alloc((c->name[0]) ? c->name : c->ifname, "tx");
+    if (xi->rx_stats_blk)
+        xi->rx_stats = (lport_stats_t *)xi->rx_stats_blk->counters;
+    if (xi->tx_stats_blk)
+        xi->tx_stats = (lport_stats_t *)xi->tx_stats_blk->counters;
+
     if (c->flags & LPORT_UNPRIVILEGED) {
         if (c->xsk_uds) {
             /* If UDS is set then call xskdev_recv_xsk_fd to setup a UDS client
@@ -974,10 +1069,26 @@ xskdev_socket_destroy(xskdev_info_t *xi)
                 TAILQ_REMOVE(&xskdev_list, xi, next);
             xskdev_list_unlock();
         }
+        shmstats_block_free(xi->rx_stats_blk);
+        shmstats_block_free(xi->tx_stats_blk);
         free(xi);
     }
 }
 
+/* Add the counters of one writer, a block waiting for a reset already counts as zero */
+static void
+stats_add(lport_stats_t *dst, const lport_stats_t *src, uint32_t *reset)
+{
+    uint64_t *d       = (uint64_t *)dst;
+    const uint64_t *v = (const uint64_t *)src;
+
+    if (__atomic_load_n(reset, __ATOMIC_ACQUIRE))
+        return;
+
+    for (size_t i = 0; i < sizeof(lport_stats_t) / sizeof(uint64_t); i++)
+        d[i] += v[i];
+}
+
 int
 xskdev_stats_get(xskdev_info_t *xi, lport_stats_t *stats)
 {
@@ -985,7 +1096,9 @@ xskdev_stats_get(xskdev_info_t *xi, lport_stats_t *stats)
     socklen_t optlen                = sizeof(struct xdp_statistics);
     int ret, fd;
 
-    memcpy(stats, &xi->stats, sizeof(lport_stats_t));
+    memset(stats, 0, sizeof(lport_stats_t));
+    stats_add(stats, xi->rx_stats, &xi->rx_stats_reset);
+    stats_add(stats, xi->tx_stats, &xi->tx_stats_reset);
 
     fd  = xsk_socket__fd(xi->rxq.xsk);
     ret = getsockopt(fd, SOL_XDP, XDP_STATISTICS, &xdp_stats, &optlen);
@@ -1015,7 +1128,9 @@ xskdev_stats_reset(xskdev_info_t *xi)
     if (!xi)
         return -1;
 
-    memset(&xi->stats, 0, sizeof(lport_stats_t));
+    /* The Rx and Tx paths clear their own stats at the start of their next burst */
+    __atomic_store_n(&xi->rx_stats_reset, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&xi->tx_stats_reset, 1, __ATOMIC_RELEASE);
 
     /* Grab the new set of XDP stats to simulate a reset of the stats */
     fd  = xsk_socket__fd(xi->rxq.xsk);
@@ -28,6 +28,7 @@
 #include <cne_lport.h>         // for lport_stats_t, buf_alloc_t, buf_free_t
 #include <pktmbuf.h>           // for pktmbuf_t
 #include <uds.h>
+#include <shmstats.h>          // for shmstats_blk_t
 
 #ifdef __cplusplus
 extern "C" {
@@ -111,7 +112,14 @@ typedef struct xskdev_info {
     pktmbuf_info_t *pi;            /**< The pktmbuf information structure pointer */
     xskdev_rxq_t rxq;              /**< RX queue */
     xskdev_txq_t txq;              /**< TX queue */
-    lport_stats_t stats;           /**< Stats for the lport interface */
+    lport_stats_t *rx_stats;       /**< Stats written by the Rx path, rx_stats_mem or shmstats */
+    lport_stats_t *tx_stats;       /**< Stats written by the Tx path, tx_stats_mem or shmstats */
+    lport_stats_t rx_stats_mem;    /**< Rx stats storage when no shmstats segment exists */
+    lport_stats_t tx_stats_mem;    /**< Tx stats storage when no shmstats segment exists */
+    shmstats_blk_t *rx_stats_blk;  /**< Rx stats block in the shmstats segment or NULL */
+    shmstats_blk_t *tx_stats_blk;  /**< Tx stats block in the shmstats segment or NULL */
+    uint32_t rx_stats_reset;       /**< Reset requested, the Rx path clears its stats */
+    uint32_t tx_stats_reset;       /**< Reset requested, the Tx path clears its stats */
     pthread_mutex_t tx_lock;       /**< Ensure mutual exclusion to Tx resources */
     int xdp_flags;                 /**< Copy of the configuration flags */
     uint32_t busy_timeout;         /**< Busy polling timeout value */
@@ -256,6 +264,23 @@ xskdev_arg_get(xskdev_info_t *xi)
     return xi->buf_mgmt.buf_arg;
 }
 
+/**
+ * Return the address of the RX ring producer index.
+ *
+ * The kernel writes the producer index when packets are placed on the RX ring,
+ * which makes it the address to give idlemgr_set_umwait() for UMONITOR.
+ *
+ * @param xi
+ *   The xskdev_info_t structure pointer.
+ * @return
+ *   The address of the RX producer index or NULL on error.
+ */
+CNDP_API __cne_always_inline volatile void *
+xskdev_rx_monitor_addr(xskdev_info_t *xi)
+{
+    return (xi) ? (volatile void *)xi->rxq.rx.producer : NULL;
+}
+
 /**
  * Allocate the number of buffers requested.
  *
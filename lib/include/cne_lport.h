@@ -67,6 +67,15 @@ typedef struct lport_buf_mgmt {
     bool unaligned_buff;                 /**< Unaligned buffer support */
 } lport_buf_mgmt_t;
 
+typedef int (*copy_start_t)(void *arg, void *dst, const void *src, uint32_t len);
+typedef int (*copy_wait_t)(void *arg);
+
+typedef struct lport_copy_ops {
+    copy_start_t copy_start; /**< Copy or queue a copy, returns 0 done, 1 queued or -1 */
+    copy_wait_t copy_wait;   /**< Wait for the queued copies, returns -1 on error */
+    void *copy_arg;          /**< Argument for the copy routines, e.g. a dsa_copy_t */
+} lport_copy_ops_t;
+
 typedef struct lport_cfg {
     char name[LPORT_NAME_LEN];     /**< logical port name */
     char ifname[LPORT_NAME_LEN];   /**< Interface name or netdev name */
@@ -87,6 +96,7 @@ typedef struct lport_cfg {
     void *xsk_uds;                 /**< The UDS to connect to get xsk FDs */
     char *xsk_map_path;            /**< The pinned map to get xsk FD */
     lport_buf_mgmt_t buf_mgmt;     /**< Buffer management functions */
+    lport_copy_ops_t copy_ops;     /**< Packet data copy offload, NULL copy_start for memcpy */
 } lport_cfg_t;
 
 /**< lport_cfg.flags configuration bits */
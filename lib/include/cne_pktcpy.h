@@ -10,6 +10,11 @@
  *
  * Functions for SSE/AVX/AVX2/AVX512 implementation of memcpy() suitable
  * for copying large packets.
+ *
+ * cne_pktcpy() is tuned for packet sized copies. Bulk copies of several KB or
+ * more should use cne_pktcpy_large(), which uses AVX512 when the CPU has it,
+ * prefetches the source and switches to non-temporal stores for copies larger
+ * than a fraction of the last level cache, see cne_pktcpy_nt_threshold_set().
  */
 
 #include <stdio.h>
@@ -17,6 +22,7 @@
 #include <string.h>
 #include <cne_vect.h>
 #include <cne_common.h>
+#include <cne_prefetch.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -94,6 +100,69 @@ static __cne_always_inline void cne_mov256(uint8_t *dst, const uint8_t *src);
  */
 static __cne_always_inline void *cne_pktcpy(void *dst, const void *src, size_t n);
 
+/**
+ * Copy 64 bytes to a 64 byte aligned destination with non-temporal stores.
+ * The locations should not overlap and the stores must be ordered with
+ * _mm_sfence() before the data is handed to another thread.
+ *
+ * @param dst
+ *   Pointer to the destination of the data, aligned on 64 bytes.
+ * @param src
+ *   Pointer to the source data.
+ */
+static __cne_always_inline void cne_mov64_nt(uint8_t *dst, const uint8_t *src);
+
+#define CNE_PKTCPY_LARGE_MIN  256               /**< Smaller copies use cne_pktcpy() */
+#define CNE_PKTCPY_AVX512_MAX (16 * 1024)       /**< Largest copy of the AVX512 routine */
+#define CNE_PKTCPY_PREFETCH   (8 * 64)          /**< Distance of the source prefetch */
+#define CNE_PKTCPY_CHUNK      (4 * 1024)        /**< Bytes copied between source prefetches */
+#define CNE_PKTCPY_NT_LLC_PCT 50                /**< Default NT threshold in % of the LLC */
+#define CNE_PKTCPY_NT_DEFAULT (4 * 1024 * 1024) /**< NT threshold when the LLC is unknown */
+
+/**
+ * Return the size above which cne_pktcpy_large() uses non-temporal stores
+ *
+ * @return
+ *   The threshold in bytes, SIZE_MAX when the non-temporal stores are disabled.
+ */
+CNDP_API size_t cne_pktcpy_nt_threshold(void);
+
+/**
+ * Set the non-temporal threshold of cne_pktcpy_large() as a fraction of the LLC
+ *
+ * @param llc_pct
+ *   The threshold in percent of the last level cache size, 0 disables the
+ *   non-temporal stores. The default is CNE_PKTCPY_NT_LLC_PCT.
+ * @return
+ *   0 on success or -1 if llc_pct is larger than 1000.
+ */
+CNDP_API int cne_pktcpy_nt_threshold_set(unsigned int llc_pct);
+
+/**
+ * Return the size of the last level cache
+ *
+ * @return
+ *   The size in bytes or 0 when it is not known.
+ */
+CNDP_API size_t cne_pktcpy_llc_size(void);
+
+/**
+ * Copy bytes with AVX512 instructions when the CPU supports them
+ *
+ * Used by cne_pktcpy_large() when CNDP is not built for AVX512. The locations
+ * must not overlap.
+ *
+ * @param dst
+ *   Pointer to the destination of the data.
+ * @param src
+ *   Pointer to the source data.
+ * @param n
+ *   Number of bytes to copy, at least 64.
+ * @return
+ *   Pointer to the destination data or NULL if the CPU has no AVX512.
+ */
+CNDP_API void *cne_pktcpy_avx512(void *dst, const void *src, size_t n);
+
 #ifdef CNE_MACHINE_CPUFLAG_AVX512F
 
 #define ALIGNMENT_MASK 0x3F
@@ -165,6 +234,19 @@ cne_mov256(uint8_t *dst, const uint8_t *src)
     cne_mov64(dst + 3 * 64, src + 3 * 64);
 }
 
+/**
+ * Copy 64 bytes to an aligned destination with non-temporal stores,
+ * locations should not overlap.
+ */
+static __cne_always_inline void
+cne_mov64_nt(uint8_t *dst, const uint8_t *src)
+{
+    __m512i zmm0;
+
+    zmm0 = _mm512_loadu_si512((const void *)src);
+    _mm512_stream_si512((void *)dst, zmm0);
+}
+
 /**
  * Copy 128-byte blocks from one location to another,
  * locations should not overlap.
@@ -424,6 +506,21 @@ cne_mov256(uint8_t *dst, const uint8_t *src)
     cne_mov128(dst + 1 * 128, src + 1 * 128);
 }
 
+/**
+ * Copy 64 bytes to an aligned destination with non-temporal stores,
+ * locations should not overlap.
+ */
+static __cne_always_inline void
+cne_mov64_nt(uint8_t *dst, const uint8_t *src)
+{
+    __m256i ymm0, ymm1;
+
+    ymm0 = _mm256_loadu_si256((const __m256i *)(const void *)(src + 0 * 32));
+    ymm1 = _mm256_loadu_si256((const __m256i *)(const void *)(src + 1 * 32));
+    _mm256_stream_si256((__m256i *)(void *)(dst + 0 * 32), ymm0);
+    _mm256_stream_si256((__m256i *)(void *)(dst + 1 * 32), ymm1);
+}
+
 /**
  * Generic packet copy routine for the given addresses and size.
  *
@@ -631,6 +728,25 @@ cne_mov256(uint8_t *dst, const uint8_t *src)
     cne_mov16((uint8_t *)dst + 15 * 16, (const uint8_t *)src + 15 * 16);
 }
 
+/**
+ * Copy 64 bytes to an aligned destination with non-temporal stores,
+ * locations should not overlap.
+ */
+static __cne_always_inline void
+cne_mov64_nt(uint8_t *dst, const uint8_t *src)
+{
+    __m128i xmm0, xmm1, xmm2, xmm3;
+
+    xmm0 = _mm_loadu_si128((const __m128i *)(const void *)(src + 0 * 16));
+    xmm1 = _mm_loadu_si128((const __m128i *)(const void *)(src + 1 * 16));
+    xmm2 = _mm_loadu_si128((const __m128i *)(const void *)(src + 2 * 16));
+    xmm3 = _mm_loadu_si128((const __m128i *)(const void *)(src + 3 * 16));
+    _mm_stream_si128((__m128i *)(void *)(dst + 0 * 16), xmm0);
+    _mm_stream_si128((__m128i *)(void *)(dst + 1 * 16), xmm1);
+    _mm_stream_si128((__m128i *)(void *)(dst + 2 * 16), xmm2);
+    _mm_stream_si128((__m128i *)(void *)(dst + 3 * 16), xmm3);
+}
+
 /**
  * Macro for copying unaligned block from one location to another with constant load offset,
  * 47 bytes leftover maximum,
@@ -967,6 +1083,102 @@ cne_pktcpy(void *dst, const void *src, size_t n)
         return cne_pktcpy_generic(dst, src, n);
 }
 
+/**
+ * Copy bytes with non-temporal stores, bypassing the caches for the destination.
+ *
+ * Used for large copies whose destination is not read soon, e.g. a capture
+ * buffer. The source is prefetched with a non-temporal hint and the stores are
+ * ordered with _mm_sfence() before returning. The locations must not overlap.
+ *
+ * @param dst
+ *   Pointer to the destination of the data.
+ * @param src
+ *   Pointer to the source data.
+ * @param n
+ *   Number of bytes to copy.
+ * @return
+ *   Pointer to the destination data.
+ */
+static inline void *
+cne_pktcpy_nt(void *dst, const void *src, size_t n)
+{
+    const uint8_t *s = src;
+    uint8_t *d       = dst;
+    size_t off;
+
+    if (n < CNE_PKTCPY_LARGE_MIN)
+        return cne_pktcpy(dst, src, n);
+
+    /* Align the stores on a cache line */
+    off = (64 - ((uintptr_t)d & 0x3F)) & 0x3F;
+    if (off) {
+        cne_mov64(d, s);
+        d += off;
+        s += off;
+        n -= off;
+    }
+
+    for (; n >= 64; n -= 64, d += 64, s += 64) {
+        cne_prefetch_non_temporal(s + CNE_PKTCPY_PREFETCH);
+        cne_mov64_nt(d, s);
+    }
+
+    /* Copy whatever left, the last 64 bytes may overlap the streamed data */
+    if (n)
+        cne_mov64(d - 64 + n, s - 64 + n);
+    _mm_sfence();
+
+    return dst;
+}
+
+/**
+ * Copy a large buffer, selecting the copy routine from the size.
+ *
+ * Copies smaller than CNE_PKTCPY_LARGE_MIN use cne_pktcpy(). Copies up to
+ * CNE_PKTCPY_AVX512_MAX use AVX512 instructions when the CPU has them, even
+ * when CNDP is built for an older CPU. Copies of at least
+ * cne_pktcpy_nt_threshold() bytes use cne_pktcpy_nt() so they do not evict the
+ * working set from the caches. Other copies are done in CNE_PKTCPY_CHUNK blocks
+ * with the start of the next block prefetched. The locations must not overlap.
+ *
+ * @param dst
+ *   Pointer to the destination of the data.
+ * @param src
+ *   Pointer to the source data.
+ * @param n
+ *   Number of bytes to copy.
+ * @return
+ *   Pointer to the destination data.
+ */
+static inline void *
+cne_pktcpy_large(void *dst, const void *src, size_t n)
+{
+    const uint8_t *s = src;
+    uint8_t *d       = dst;
+
+    if (n < CNE_PKTCPY_LARGE_MIN)
+        return cne_pktcpy(dst, src, n);
+
+    if (n >= cne_pktcpy_nt_threshold())
+        return cne_pktcpy_nt(dst, src, n);
+
+#ifndef CNE_MACHINE_CPUFLAG_AVX512F
+    if (n <= CNE_PKTCPY_AVX512_MAX && cne_pktcpy_avx512(dst, src, n))
+        return dst;
+#endif
+
+    for (; n > CNE_PKTCPY_CHUNK; n -= CNE_PKTCPY_CHUNK) {
+        for (int i = 0; i < CNE_PKTCPY_PREFETCH; i += 64)
+            cne_prefetch0(s + CNE_PKTCPY_CHUNK + i);
+        cne_pktcpy(d, s, CNE_PKTCPY_CHUNK);
+        d += CNE_PKTCPY_CHUNK;
+        s += CNE_PKTCPY_CHUNK;
+    }
+    cne_pktcpy(d, s, n);
+
+    return dst;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,288 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation.
+ */
+
+#ifndef _CNE_CKSUM_H_
+#define _CNE_CKSUM_H_
+
+/**
+ * @file
+ *
+ * One's complement (Internet) checksum kernels, see RFC 1071 and RFC 1624.
+ *
+ * The sum of a buffer is done on 32 bit words into 64 bit accumulators, which is equal to
+ * the sum of its 16 bit words once folded. Buffers of CNE_CKSUM_VEC_MIN bytes or more are
+ * summed with AVX512, AVX2 or SSE instructions, selected when CNDP is built like
+ * cne_pktcpy(). The incremental update helpers change a checksum for a modified field
+ * without summing the whole header or packet again, e.g. for a TTL decrement or NAT.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cne_common.h>
+#include <cne_vect.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_CKSUM_VEC_MIN 128 /**< Smaller buffers are summed with scalar code */
+
+/** @internal Unaligned 32 and 16 bit words, avoiding the strict-aliasing warnings */
+typedef uint32_t __attribute__((__may_alias__, __aligned__(1))) __cne_cksum_u32_t;
+typedef uint16_t __attribute__((__may_alias__, __aligned__(1))) __cne_cksum_u16_t;
+
+/**
+ * @internal Sum a buffer with scalar code.
+ *
+ * @param p
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer.
+ * @param sum
+ *   Initial value of the sum.
+ * @return
+ *   sum += Sum of all 32 bit words in the buffer, the odd bytes are added as 16 bit words.
+ */
+static __cne_always_inline uint64_t
+__cne_cksum_add_scalar(const uint8_t *p, size_t len, uint64_t sum)
+{
+    const __cne_cksum_u32_t *w = (const __cne_cksum_u32_t *)(uintptr_t)p;
+
+    for (; len >= 16; len -= 16, w += 4)
+        sum += (uint64_t)w[0] + w[1] + w[2] + w[3];
+    for (; len >= 4; len -= 4, w++)
+        sum += *w;
+
+    p = (const uint8_t *)(uintptr_t)w;
+    if (len >= 2) {
+        sum += *(const __cne_cksum_u16_t *)(uintptr_t)p;
+        p += 2;
+        len -= 2;
+    }
+
+    /* if length is in odd bytes */
+    if (len == 1) {
+        uint16_t left     = 0;
+        *(uint8_t *)&left = *p;
+        sum += left;
+    }
+
+    return sum;
+}
+
+#if defined(CNE_MACHINE_CPUFLAG_AVX512F)
+
+/**
+ * @internal Sum the 64 byte blocks of a buffer, each 32 bit word is zero extended and added
+ * to 64 bit lanes.
+ */
+static __cne_always_inline uint64_t
+__cne_cksum_add_vec(const uint8_t **pp, size_t *plen, uint64_t sum)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i acc0 = zero, acc1 = zero;
+    const uint8_t *p = *pp;
+    size_t len       = *plen;
+
+    for (; len >= 128; len -= 128, p += 128) {
+        __m512i a = _mm512_loadu_si512((const void *)p);
+        __m512i b = _mm512_loadu_si512((const void *)(p + 64));
+
+        acc0 = _mm512_add_epi64(acc0, _mm512_unpacklo_epi32(a, zero));
+        acc1 = _mm512_add_epi64(acc1, _mm512_unpackhi_epi32(a, zero));
+        acc0 = _mm512_add_epi64(acc0, _mm512_unpacklo_epi32(b, zero));
+        acc1 = _mm512_add_epi64(acc1, _mm512_unpackhi_epi32(b, zero));
+    }
+    for (; len >= 64; len -= 64, p += 64) {
+        __m512i a = _mm512_loadu_si512((const void *)p);
+
+        acc0 = _mm512_add_epi64(acc0, _mm512_unpacklo_epi32(a, zero));
+        acc1 = _mm512_add_epi64(acc1, _mm512_unpackhi_epi32(a, zero));
+    }
+    *pp   = p;
+    *plen = len;
+
+    return sum + _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+}
+
+#elif defined(CNE_MACHINE_CPUFLAG_AVX2)
+
+/**
+ * @internal Sum the 64 byte blocks of a buffer, each 32 bit word is zero extended and added
+ * to 64 bit lanes.
+ */
+static __cne_always_inline uint64_t
+__cne_cksum_add_vec(const uint8_t **pp, size_t *plen, uint64_t sum)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero, acc1 = zero;
+    const uint8_t *p = *pp;
+    size_t len       = *plen;
+    uint64_t lanes[4];
+
+    for (; len >= 64; len -= 64, p += 64) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)p);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(p + 32));
+
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(a, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(a, zero));
+        acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(b, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(b, zero));
+    }
+    *pp   = p;
+    *plen = len;
+
+    _mm256_storeu_si256((__m256i *)(void *)lanes, _mm256_add_epi64(acc0, acc1));
+
+    return sum + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+#else /* SSE implementation */
+
+/**
+ * @internal Sum the 64 byte blocks of a buffer, each 32 bit word is zero extended and added
+ * to 64 bit lanes.
+ */
+static __cne_always_inline uint64_t
+__cne_cksum_add_vec(const uint8_t **pp, size_t *plen, uint64_t sum)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0 = zero, acc1 = zero;
+    const uint8_t *p = *pp;
+    size_t len       = *plen;
+
+    for (; len >= 64; len -= 64, p += 64) {
+        for (int i = 0; i < 64; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i *)(const void *)(p + i));
+
+            acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(a, zero));
+            acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(a, zero));
+        }
+    }
+    *pp   = p;
+    *plen = len;
+
+    acc0 = _mm_add_epi64(acc0, acc1);
+
+    return sum + (uint64_t)_mm_cvtsi128_si64(acc0) +
+           (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc0, acc0));
+}
+
+#endif
+
+/**
+ * Add the words of a buffer to a checksum sum.
+ *
+ * The sum is not folded, use cne_cksum_fold() to get the 16 bit checksum. A buffer may be
+ * summed in several parts, all parts but the last one must have an even length.
+ *
+ * @param buf
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer.
+ * @param sum
+ *   Initial value of the sum, 0 or the sum of the previous parts.
+ * @return
+ *   The sum of the buffer added to sum.
+ */
+static inline uint64_t
+cne_cksum_add(const void *buf, size_t len, uint64_t sum)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+
+    if (len >= CNE_CKSUM_VEC_MIN)
+        sum = __cne_cksum_add_vec(&p, &len, sum);
+
+    return __cne_cksum_add_scalar(p, len, sum);
+}
+
+/**
+ * Fold a checksum sum to the 16 bit non-complemented checksum.
+ *
+ * @param sum
+ *   The sum returned by cne_cksum_add() plus any other 16 or 32 bit words.
+ * @return
+ *   The non-complemented checksum.
+ */
+static inline uint16_t
+cne_cksum_fold(uint64_t sum)
+{
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+
+    return (uint16_t)sum;
+}
+
+/**
+ * Update a checksum for a 16 bit word changed from one value to another, see RFC 1624.
+ *
+ * @param cksum
+ *   The complemented checksum covering the word, as stored in the packet.
+ * @param from
+ *   The previous value of the word, as stored in the packet.
+ * @param to
+ *   The new value of the word, as stored in the packet.
+ * @return
+ *   The updated complemented checksum.
+ */
+static inline uint16_t
+cne_cksum_adjust16(uint16_t cksum, uint16_t from, uint16_t to)
+{
+    uint32_t sum = (uint16_t)~cksum + (uint32_t)(uint16_t)~from + to;
+
+    return (uint16_t)~cne_cksum_fold(sum);
+}
+
+/**
+ * Update a checksum for a 32 bit word changed from one value to another, e.g. an IPv4 address.
+ *
+ * @param cksum
+ *   The complemented checksum covering the word, as stored in the packet.
+ * @param from
+ *   The previous value of the word, as stored in the packet.
+ * @param to
+ *   The new value of the word, as stored in the packet.
+ * @return
+ *   The updated complemented checksum.
+ */
+static inline uint16_t
+cne_cksum_adjust32(uint16_t cksum, uint32_t from, uint32_t to)
+{
+    uint64_t sum = (uint16_t)~cksum + (uint64_t)(uint32_t)~from + to;
+
+    return (uint16_t)~cne_cksum_fold(sum);
+}
+
+/**
+ * Update a checksum for a field changed from one value to another, e.g. an IPv6 address.
+ *
+ * @param cksum
+ *   The complemented checksum covering the field, as stored in the packet.
+ * @param from
+ *   Pointer to the previous value of the field.
+ * @param to
+ *   Pointer to the new value of the field.
+ * @param len
+ *   The length of the field, an even number of bytes.
+ * @return
+ *   The updated complemented checksum.
+ */
+static inline uint16_t
+cne_cksum_adjust(uint16_t cksum, const void *from, const void *to, size_t len)
+{
+    uint64_t sum = (uint16_t)~cksum;
+
+    sum += (uint16_t)~cne_cksum_fold(cne_cksum_add(from, len, 0));
+    sum = cne_cksum_add(to, len, sum);
+
+    return (uint16_t)~cne_cksum_fold(sum);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_CKSUM_H_ */
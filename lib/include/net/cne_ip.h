@@ -16,14 +16,20 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <sys/types.h>
 #include <netinet/in.h>
 #include <netinet/ip.h>
 #include <arpa/inet.h>
 
 #include <cne_byteorder.h>
+#include <cne_branch_prediction.h>
 #include <pktmbuf_offload.h>
 
+#include "cne_cksum.h"
+#include "cne_tcp.h"
+#include "cne_udp.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -131,33 +137,13 @@ cne_ipv4_hdr_len(const struct cne_ipv4_hdr *ipv4_hdr)
 static inline uint32_t
 __cne_raw_cksum(const void *buf, size_t len, uint32_t sum)
 {
-    /* workaround gcc strict-aliasing warning */
-    uintptr_t ptr = (uintptr_t)buf;
-    typedef uint16_t __attribute__((__may_alias__)) u16_p;
-    const u16_p *u16_buf = (const u16_p *)ptr;
-
-    while (len >= (sizeof(*u16_buf) * 4)) {
-        sum += u16_buf[0];
-        sum += u16_buf[1];
-        sum += u16_buf[2];
-        sum += u16_buf[3];
-        len -= sizeof(*u16_buf) * 4;
-        u16_buf += 4;
-    }
-    while (len >= sizeof(*u16_buf)) {
-        sum += *u16_buf;
-        len -= sizeof(*u16_buf);
-        u16_buf += 1;
-    }
+    uint64_t s = cne_cksum_add(buf, len, sum);
 
-    /* if length is in odd bytes */
-    if (len == 1) {
-        uint16_t left     = 0;
-        *(uint8_t *)&left = *(const uint8_t *)u16_buf;
-        sum += left;
-    }
+    /* Fold the 64 bit sum in 32 bits, the callers fold it again in 16 bits */
+    s = (s & 0xffffffff) + (s >> 32);
+    s = (s & 0xffffffff) + (s >> 32);
 
-    return sum;
+    return (uint32_t)s;
 }
 
 /**
@@ -214,6 +200,145 @@ cne_ipv4_cksum(const struct cne_ipv4_hdr *ipv4_hdr)
     return (uint16_t)~cksum;
 }
 
+/**
+ * @internal Sum the 16 bit words of four 20 byte IPv4 headers, one header per 32 bit lane.
+ */
+static __cne_always_inline __m128i
+__cne_ipv4_hdr_sum_x4(struct cne_ipv4_hdr *const ip[4])
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v[4], sum, last;
+
+    /* The first 16 bytes of each header as 32 bit lanes of 16 bit words */
+    for (int i = 0; i < 4; i++) {
+        __m128i h = _mm_loadu_si128((const __m128i *)(const void *)ip[i]);
+
+        v[i] = _mm_add_epi32(_mm_unpacklo_epi16(h, zero), _mm_unpackhi_epi16(h, zero));
+    }
+    sum = _mm_hadd_epi32(_mm_hadd_epi32(v[0], v[1]), _mm_hadd_epi32(v[2], v[3]));
+
+    /* The destination address is the last 4 bytes of a header without options */
+    last = _mm_set_epi32(ip[3]->dst_addr, ip[2]->dst_addr, ip[1]->dst_addr, ip[0]->dst_addr);
+    sum  = _mm_add_epi32(sum, _mm_and_si128(last, _mm_set1_epi32(0xffff)));
+    return _mm_add_epi32(sum, _mm_srli_epi32(last, 16));
+}
+
+/**
+ * @internal Return the mask of the lanes of a header sum which fold to 0xffff.
+ */
+static __cne_always_inline uint32_t
+__cne_ipv4_hdr_sum_ok_x4(__m128i sum)
+{
+    const __m128i mask = _mm_set1_epi32(0xffff);
+
+    sum = _mm_add_epi32(_mm_and_si128(sum, mask), _mm_srli_epi32(sum, 16));
+    sum = _mm_add_epi32(_mm_and_si128(sum, mask), _mm_srli_epi32(sum, 16));
+
+    return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(sum, mask)));
+}
+
+/**
+ * @internal Check the headers with options, which are not summed by the vector code.
+ */
+static __cne_always_inline uint32_t
+__cne_ipv4_cksum_fixup(struct cne_ipv4_hdr *const ip[], uint32_t nb, uint32_t ok)
+{
+    for (uint32_t i = 0; i < nb; i++) {
+        if (unlikely((ip[i]->version_ihl & CNE_IPV4_HDR_IHL_MASK) != 5)) {
+            ok &= ~(1U << i);
+            if (cne_ipv4_cksum(ip[i]) == 0)
+                ok |= 1U << i;
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * Validate the checksum of four IPv4 headers at once.
+ *
+ * @param ip
+ *   The pointers to the four contiguous IPv4 headers.
+ * @return
+ *   A mask with bit n set when the checksum of ip[n] is correct.
+ */
+static inline uint32_t
+cne_ipv4_cksum_verify_x4(struct cne_ipv4_hdr *const ip[4])
+{
+    return __cne_ipv4_cksum_fixup(ip, 4, __cne_ipv4_hdr_sum_ok_x4(__cne_ipv4_hdr_sum_x4(ip)));
+}
+
+/**
+ * Validate the checksum of eight IPv4 headers at once.
+ *
+ * @param ip
+ *   The pointers to the eight contiguous IPv4 headers.
+ * @return
+ *   A mask with bit n set when the checksum of ip[n] is correct.
+ */
+static inline uint32_t
+cne_ipv4_cksum_verify_x8(struct cne_ipv4_hdr *const ip[8])
+{
+#ifdef CNE_MACHINE_CPUFLAG_AVX2
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+    __m256i v[4], sum, last;
+    uint32_t ok;
+
+    /* Header n in the low 128 bits and header n + 4 in the high 128 bits */
+    for (int i = 0; i < 4; i++) {
+        __m256i h = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)ip[i])),
+            _mm_loadu_si128((const __m128i *)(const void *)ip[i + 4]), 1);
+
+        v[i] = _mm256_add_epi32(_mm256_unpacklo_epi16(h, zero), _mm256_unpackhi_epi16(h, zero));
+    }
+    sum = _mm256_hadd_epi32(_mm256_hadd_epi32(v[0], v[1]), _mm256_hadd_epi32(v[2], v[3]));
+
+    last = _mm256_set_epi32(ip[7]->dst_addr, ip[6]->dst_addr, ip[5]->dst_addr, ip[4]->dst_addr,
+                            ip[3]->dst_addr, ip[2]->dst_addr, ip[1]->dst_addr, ip[0]->dst_addr);
+    sum  = _mm256_add_epi32(sum, _mm256_and_si256(last, mask));
+    sum  = _mm256_add_epi32(sum, _mm256_srli_epi32(last, 16));
+
+    sum = _mm256_add_epi32(_mm256_and_si256(sum, mask), _mm256_srli_epi32(sum, 16));
+    sum = _mm256_add_epi32(_mm256_and_si256(sum, mask), _mm256_srli_epi32(sum, 16));
+    ok  = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, mask)));
+
+    return __cne_ipv4_cksum_fixup(ip, 8, ok);
+#else
+    return cne_ipv4_cksum_verify_x4(ip) | (cne_ipv4_cksum_verify_x4(ip + 4) << 4);
+#endif
+}
+
+/**
+ * Validate the checksum of a burst of IPv4 headers.
+ *
+ * @param ip
+ *   The pointers to the contiguous IPv4 headers.
+ * @param nb
+ *   The number of headers, up to 64.
+ * @return
+ *   A mask with bit n set when the checksum of ip[n] is correct.
+ */
+static inline uint64_t
+cne_ipv4_cksum_verify_bulk(struct cne_ipv4_hdr *const ip[], uint32_t nb)
+{
+    uint64_t ok = 0;
+    uint32_t i  = 0;
+
+    if (nb > 64)
+        nb = 64;
+
+    for (; (i + 8) <= nb; i += 8)
+        ok |= (uint64_t)cne_ipv4_cksum_verify_x8(&ip[i]) << i;
+    for (; (i + 4) <= nb; i += 4)
+        ok |= (uint64_t)cne_ipv4_cksum_verify_x4(&ip[i]) << i;
+    for (; i < nb; i++)
+        ok |= (uint64_t)(cne_ipv4_cksum(ip[i]) == 0) << i;
+
+    return ok;
+}
+
 /**
  * Process the pseudo-header checksum of an IPv4 header.
  *
@@ -275,7 +400,7 @@ cne_ipv4_phdr_cksum(const struct cne_ipv4_hdr *ipv4_hdr, uint64_t ol_flags)
 static inline uint16_t
 __ipv4_udptcp_cksum(const struct cne_ipv4_hdr *ipv4_hdr, const void *l4_hdr)
 {
-    uint32_t cksum;
+    uint64_t cksum;
     uint32_t l3_len, l4_len;
     uint8_t ip_hdr_len;
 
@@ -286,12 +411,12 @@ __ipv4_udptcp_cksum(const struct cne_ipv4_hdr *ipv4_hdr, const void *l4_hdr)
 
     l4_len = l3_len - ip_hdr_len;
 
-    cksum = cne_raw_cksum(l4_hdr, l4_len);
-    cksum += cne_ipv4_phdr_cksum(ipv4_hdr, 0);
-
-    cksum = ((cksum & 0xffff0000) >> 16) + (cksum & 0xffff);
+    /* Sum the pseudo-header and the L4 data in one pass before folding */
+    cksum = (uint64_t)ipv4_hdr->src_addr + ipv4_hdr->dst_addr;
+    cksum += htobe16((uint16_t)l4_len) + htobe16((uint16_t)ipv4_hdr->next_proto_id);
+    cksum = cne_cksum_add(l4_hdr, l4_len, cksum);
 
-    return (uint16_t)cksum;
+    return cne_cksum_fold(cksum);
 }
 
 /**
@@ -348,6 +473,63 @@ cne_ipv4_udptcp_cksum_verify(const struct cne_ipv4_hdr *ipv4_hdr, const void *l4
     return 0;
 }
 
+/**
+ * Decrement the TTL of an IPv4 header and update its checksum.
+ *
+ * @param ipv4_hdr
+ *   The pointer to the contiguous IPv4 header.
+ */
+static inline void
+cne_ipv4_ttl_dec(struct cne_ipv4_hdr *ipv4_hdr)
+{
+    uint16_t from = htobe16((uint16_t)ipv4_hdr->time_to_live << 8);
+
+    ipv4_hdr->time_to_live--;
+    ipv4_hdr->hdr_checksum = cne_cksum_adjust16(
+        ipv4_hdr->hdr_checksum, from, htobe16((uint16_t)ipv4_hdr->time_to_live << 8));
+}
+
+/**
+ * Change the source or destination address of an IPv4 packet, as done by NAT.
+ *
+ * The IPv4 checksum and the UDP or TCP checksum are updated for the new address, a UDP
+ * checksum of 0 (no checksum) is left unchanged.
+ *
+ * @param ipv4_hdr
+ *   The pointer to the contiguous IPv4 header.
+ * @param l4_hdr
+ *   The pointer to the beginning of the L4 header, NULL to only update the IPv4 header.
+ * @param dst
+ *   Change the destination address when true, else the source address.
+ * @param addr
+ *   The new address in network byte order.
+ */
+static inline void
+cne_ipv4_addr_update(struct cne_ipv4_hdr *ipv4_hdr, void *l4_hdr, bool dst, cne_be32_t addr)
+{
+    cne_be32_t from = (dst) ? ipv4_hdr->dst_addr : ipv4_hdr->src_addr;
+
+    if (l4_hdr && ipv4_hdr->next_proto_id == IPPROTO_TCP) {
+        struct cne_tcp_hdr *tcp = (struct cne_tcp_hdr *)l4_hdr;
+
+        tcp->cksum = cne_cksum_adjust32(tcp->cksum, from, addr);
+    } else if (l4_hdr && ipv4_hdr->next_proto_id == IPPROTO_UDP) {
+        struct cne_udp_hdr *udp = (struct cne_udp_hdr *)l4_hdr;
+
+        if (udp->dgram_cksum) {
+            udp->dgram_cksum = cne_cksum_adjust32(udp->dgram_cksum, from, addr);
+            if (udp->dgram_cksum == 0)
+                udp->dgram_cksum = 0xffff;
+        }
+    }
+
+    ipv4_hdr->hdr_checksum = cne_cksum_adjust32(ipv4_hdr->hdr_checksum, from, addr);
+    if (dst)
+        ipv4_hdr->dst_addr = addr;
+    else
+        ipv4_hdr->src_addr = addr;
+}
+
 /**
  * IPv6 Header
  */
@@ -421,16 +603,18 @@ cne_ipv6_phdr_cksum(const struct cne_ipv6_hdr *ipv6_hdr, uint64_t ol_flags __cne
 static inline uint16_t
 cne_ipv6_udptcp_cksum(const struct cne_ipv6_hdr *ipv6_hdr, const void *l4_hdr)
 {
-    uint32_t cksum;
+    uint64_t cksum;
     uint32_t l4_len;
 
     l4_len = be16toh(ipv6_hdr->payload_len);
 
-    cksum = cne_raw_cksum(l4_hdr, l4_len);
-    cksum += cne_ipv6_phdr_cksum(ipv6_hdr, 0);
+    /* Sum the pseudo-header and the L4 data in one pass before folding */
+    cksum = cne_cksum_add(ipv6_hdr->src_addr,
+                          sizeof(ipv6_hdr->src_addr) + sizeof(ipv6_hdr->dst_addr), 0);
+    cksum += ipv6_hdr->payload_len + htobe16((uint16_t)ipv6_hdr->proto);
+    cksum = cne_cksum_add(l4_hdr, l4_len, cksum);
 
-    cksum = ((cksum & 0xffff0000) >> 16) + (cksum & 0xffff);
-    cksum = (~cksum) & 0xffff;
+    cksum = (uint16_t)~cne_cksum_fold(cksum);
     if (cksum == 0)
         cksum = 0xffff;
 
@@ -14,7 +14,8 @@
 #include <limits.h>             // for INT_MAX
 #include <sys/queue.h>          // for TAILQ_FOREACH
 #include <uds.h>
-#include <xskdev.h>        // for xskdev_dump_all
+#include <xskdev.h>           // for xskdev_dump_all
+#include <cne_trace.h>        // for cne_trace_enable, cne_trace_save
 
 #include "cli.h"              // for cli_node, c_cmd, cli_usage, is_directory
 #include "cli_input.h"        // for cli_clear_screen, cli_pause
@@ -758,6 +759,52 @@ pktmbuf_cmd(int argc __cne_unused, char **argv __cne_unused)
     return 0;
 }
 
+// clang-format off
+static struct cli_map trace_map[] = {
+    {10, "trace"},
+    {10, "trace list"},
+    {20, "trace enable %s"},
+    {30, "trace disable %s"},
+    {40, "trace save %s"},
+    {50, "trace clear"},
+    {-1, NULL}
+    };
+// clang-format on
+static int
+trace_cmd(int argc, char **argv)
+{
+    struct cli_map *m;
+    int ret;
+
+    m = cli_mapping(trace_map, argc, argv);
+    if (!m)
+        return cli_cmd_error("command is invalid", "trace", argc, argv);
+
+    switch (m->index) {
+    case 10:
+        cne_trace_list(stdout);
+        break;
+    case 20:
+    case 30:
+        ret = (m->index == 20) ? cne_trace_enable(argv[2]) : cne_trace_disable(argv[2]);
+        cne_printf("%d trace points %s\n", ret, (m->index == 20) ? "enabled" : "disabled");
+        break;
+    case 40:
+        ret = cne_trace_save(argv[2]);
+        if (ret < 0)
+            return -1;
+        cne_printf("%d trace events written to %s\n", ret, argv[2]);
+        break;
+    case 50:
+        cne_trace_clear();
+        break;
+    default:
+        return cli_cmd_error("Command invalid", "trace", argc, argv);
+    }
+
+    return 0;
+}
+
 // clang-format off
 static struct cli_tree cli_default_tree[] = {
     c_file("copyright",    copyright_file,      "CNDP copyright information"),
@@ -790,6 +837,7 @@ static struct cli_tree cli_default_tree[] = {
     c_cmd("env",        env_cmd,        "Show/del/get/set environment variables"),
     c_cmd("xsk",        xsk_cmd,        "xskdev information [stats|queues|all]"),
     c_cmd("pktmbuf",    pktmbuf_cmd,    "dump all pktmbuf information structures"),
+    c_cmd("trace",      trace_cmd,      "trace points [list|enable|disable|save|clear]"),
 
     /* The following are environment variables */
     c_str("SHELL",      NULL,           "CLI shell"),
@@ -439,6 +439,7 @@ jcfg_destroy(jcfg_info_t *jinfo)
             _foreach(data, lgroups);
             _foreach(data, threads);
             _foreach(data, users);
+            jcfg_placement_free(cfg);
             free(cfg);
         }
         free(jinfo);
@@ -51,6 +51,11 @@ struct json_object;
 #define LPORT_GROUP_TAG "lport-groups"
 #define USER_TAG        "users"
 
+/**
+ * Section name for the optional placement settings, not an object type in jcfg_cb_type_t.
+ */
+#define PLACEMENT_TAG "placement"
+
 /**
  * Macro to initialize a const char *tags[] type array for indexing with jcfg_tag_t.
  *
@@ -154,6 +159,7 @@ typedef struct jcfg_umem {
     uint16_t shared_umem;       /**< Enable shared umem support */
     uint16_t region_cnt;        /**< Number of regions defined */
     region_info_t *rinfo;       /**< Region information data */
+    uint32_t setup_us;          /**< Time spent in the jcfg_process() callback in usecs */
 } jcfg_umem_t;
 
 /**
@@ -174,6 +180,7 @@ typedef struct jcfg_lport {
     uint16_t flags;     /**< Flags to configure lport in lport_cfg_t.flags in cne_lport.h */
     char *xsk_map_path; /**< The path to the pinned xsk_map for this port */
     char *uds_path;     /**< The path to the pinned xsk_map for this port */
+    uint32_t setup_us;  /**< Time spent in the jcfg_process() callback in usecs */
 } jcfg_lport_t;
 
 /** JCFG lport configuration names */
@@ -201,6 +208,23 @@ typedef struct jcfg_lgroup {
     cpu_set_t lcore_bitmap;       /**< Bitmap of lcores used for affinity */
 } jcfg_lgroup_t;
 
+/**
+ * Thread lcore group name asking jcfg to select the lcore for the thread.
+ *
+ * The lcore is picked from the CPU topology in sysfs and the NUMA node of the netdevs used
+ * by the thread lports. Threads with lports get their own physical core on the NIC NUMA node
+ * when possible, threads without lports fill the remaining lcores. Threads using a named
+ * lcore group keep it and the lcores in the group are not given to other threads.
+ */
+#define JCFG_AUTO_GROUP_NAME "auto"
+
+/** JCFG placement configuration names */
+#define JCFG_PLACEMENT_LCORE_GROUP_NAME  "lcore-group"
+#define JCFG_PLACEMENT_SMT_NAME          "smt"
+#define JCFG_PLACEMENT_UMEM_SPLIT_NAME   "umem-split"
+#define JCFG_PLACEMENT_PRINT_NAME        "print"
+#define JCFG_PLACEMENT_NETDEV_NODES_NAME "netdev-nodes"
+
 /**
  * JCFG Thread information
  */
@@ -219,6 +243,7 @@ typedef struct jcfg_thd {
     volatile uint16_t pause;   /**< Set to non-zero to pause thread */
     uint32_t idle_timeout;     /**< Idle timeout value in milliseconds */
     uint32_t intr_timeout;     /**< Interrupt timeout value in milliseconds */
+    uint32_t umwait_timeout;   /**< UMWAIT/TPAUSE idle state timeout in microseconds */
 } jcfg_thd_t;
 
 /**
@@ -353,6 +378,7 @@ enum {
     JCFG_PARSE_FILE       = (1 << 4), /**< Get JSON text from a file */
     JCFG_PARSE_SOCKET     = (1 << 5), /**< Get the JSON text from a socket or local domain socket */
     JCFG_PARSE_STRING     = (1 << 6), /**< Use the string as the JSON text data */
+    JCFG_PARALLEL_FLAG    = (1 << 7), /**< Process UMEM and lport objects in parallel */
 };
 
 /**
@@ -835,6 +861,16 @@ CNDP_API int jcfg_dump_at(jcfg_info_t *jinfo, const char *key);
  */
 CNDP_API int jcfg_dump(jcfg_info_t *jinfo);
 
+/**
+ * Print the lcore, NUMA node and UMEM placement of the threads and lports.
+ *
+ * @param jinfo
+ *   The jcfg_info_t pointer for the JCFG configuration
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int jcfg_placement_dump(jcfg_info_t *jinfo);
+
 /**
  * Dump out some information about jcfg structures
  */
@@ -299,10 +299,13 @@ _decode_sections_end(jcfg_info_t *jinfo, void *arg)
         }
     }
     STAILQ_FOREACH (thd, &data->threads, next) {
-        thd->group = jcfg_lookup_lgroup(jinfo, thd->group_name);
-        if (!thd->group) {
-            CNE_ERR("Group '%s' not found\n", thd->group_name);
-            return -1;
+        /* Threads in the auto lcore group get a group from jcfg_placement_end() */
+        if (strcmp(thd->group_name, JCFG_AUTO_GROUP_NAME)) {
+            thd->group = jcfg_lookup_lgroup(jinfo, thd->group_name);
+            if (!thd->group) {
+                CNE_ERR("Group '%s' not found\n", thd->group_name);
+                return -1;
+            }
         }
         for (int i = 0; i < thd->lport_cnt; i++) {
             thd->lports[i] = jcfg_lookup_lport(jinfo, thd->lport_names[i]);
@@ -313,7 +316,10 @@ _decode_sections_end(jcfg_info_t *jinfo, void *arg)
         }
     }
 
-    return jcfg_decode_lport_groups_end(jinfo, arg);
+    if (jcfg_decode_lport_groups_end(jinfo, arg) < 0)
+        return -1;
+
+    return jcfg_placement_end(jinfo);
 }
 
 int
@@ -427,4 +433,5 @@ CNE_INIT_PRIO(jcfg_initialize, STATE)
     jcfg_add_decoder(LGROUP_TAG, _decode_lgroups);
     jcfg_add_decoder(THREAD_TAG, _decode_threads);
     jcfg_add_decoder(LPORT_GROUP_TAG, _decode_lport_groups);
+    jcfg_add_decoder(PLACEMENT_TAG, _decode_placement);
 }
@@ -80,6 +80,8 @@ int _decode_application(struct json_object *obj, int flags, struct json_object *
                         const char *key, size_t *index, void *arg);
 int _decode_options(struct json_object *obj, int flags, struct json_object *parent, const char *key,
                     size_t *index, void *arg);
+int _decode_placement(struct json_object *obj, int flags, struct json_object *parent,
+                      const char *key, size_t *index, void *arg);
 
 /** Finish lport_group decoding after all sections have been decoded
  *
@@ -25,9 +25,6 @@
 #include "cne_lport.h"
 #include "netdev_funcs.h"
 
-/* The name of the umem used by default for all lport groups */
-#define LPORT_GROUP_UMEM_NAME "lport-group"
-
 /* Wrap strtol to parse null-terminated string as u16 decimal value */
 static int
 parse_u16(const char *str, char **endp, uint16_t *value)
@@ -0,0 +1,705 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2019-2023 Intel Corporation.
+ */
+
+// IWYU pragma: no_include <json-c/json_types.h>
+
+#include <string.h>                    // for strcmp, strdup
+#include <json-c/json_object.h>        // for json_object_get_type, json_object_get...
+#include <json-c/json_visit.h>         // for json_c_visit, JSON_C_VISIT_RETURN_CO...
+#include <sched.h>                     // for CPU_SET, CPU_ISSET, sched_getaffinity
+#include <dirent.h>                    // for opendir, readdir, closedir
+#include <stdio.h>                     // for snprintf, fopen, fscanf
+#include <stdlib.h>                    // for calloc, free, realloc
+#include <strings.h>                   // for strcasecmp
+#include <sys/queue.h>                 // for STAILQ_FOREACH, STAILQ_INSERT_TAIL
+#include <sys/sysinfo.h>               // for get_nprocs_conf
+#include <cne_system.h>                // for cne_socket_id
+
+#include "jcfg.h"                // for jcfg_thd_t, jcfg_info_t, jcfg_data_t
+#include "jcfg_private.h"        // for jcfg, jcfg_placement, jcfg_cpu
+#include "jcfg_decode.h"         // for jcfg_list_add, _decode_placement
+#include "cne_common.h"          // for __cne_unused
+#include "cne_log.h"             // for CNE_ERR, CNE_WARN, CNE_ERR_RET
+
+struct json_object;
+
+#define SYS_CPU_TOPOLOGY "/sys/devices/system/cpu/cpu%d/topology/%s"
+#define NIC_NUMA_NODE    "/sys/class/net/%s/device/numa_node"
+#define NIC_QUEUES       "/sys/class/net/%s/queues"
+
+/*
+ * Penalties used to score an lcore for a thread, the lowest score wins. Sharing an lcore
+ * is always the last choice, a thread with lports would rather cross a NUMA node than
+ * share a physical core unless SMT sharing is allowed by the placement section.
+ */
+#define SCORE_CPU_SHARED   1000 /**< lcore already has a thread, per thread */
+#define SCORE_SMT_HOT      300  /**< Sibling lcore has a thread with lports */
+#define SCORE_SMT_HOT_OK   10   /**< Sibling lcore has a thread with lports, smt allowed */
+#define SCORE_CROSS_NODE   200  /**< lcore is not on the NUMA node of the thread lports */
+#define SCORE_SMT_COLD     20   /**< Sibling lcore has a thread without lports */
+#define SCORE_LCORE_ZERO   3    /**< lcore 0 handles most of the housekeeping work */
+#define SCORE_COLD_ON_HOT  50   /**< Thread without lports next to a thread with lports */
+#define SCORE_COLD_ON_FREE 5    /**< Thread without lports on an unused physical core */
+
+static struct jcfg_placement *
+placement_get(struct jcfg *cfg)
+{
+    if (!cfg->placement) {
+        cfg->placement = calloc(1, sizeof(struct jcfg_placement));
+        if (!cfg->placement)
+            CNE_NULL_RET("Failed to allocate placement structure\n");
+        cfg->placement->umem_split = 1;
+    }
+    return cfg->placement;
+}
+
+void
+jcfg_placement_free(struct jcfg *cfg)
+{
+    struct jcfg_placement *pl;
+
+    if (!cfg || !(pl = cfg->placement))
+        return;
+
+    for (int i = 0; i < pl->node_cnt; i++)
+        free(pl->nodes[i].netdev);
+    free(pl->nodes);
+    free(pl->lgroup_name);
+    free(pl->cpus);
+    free(pl->places);
+    free(pl);
+    cfg->placement = NULL;
+}
+
+/* Read a single integer from a sysfs file, return -1 if not found */
+static int
+sysfs_int(const char *path)
+{
+    FILE *f;
+    int val = -1;
+
+    f = fopen(path, "r");
+    if (!f)
+        return -1;
+    if (fscanf(f, "%d", &val) != 1)
+        val = -1;
+    fclose(f);
+
+    return val;
+}
+
+static int
+cpu_topology(int cpu, const char *file)
+{
+    char path[256];
+
+    snprintf(path, sizeof(path), SYS_CPU_TOPOLOGY, cpu, file);
+
+    return sysfs_int(path);
+}
+
+/*
+ * Return the NUMA node of a netdev or -1 for virtual devices or no NUMA support, a node
+ * given for the netdev in the placement section is used before sysfs.
+ */
+static int
+netdev_node(struct jcfg_placement *pl, const char *netdev)
+{
+    char path[256];
+
+    if (!netdev)
+        return -1;
+    for (int i = 0; i < pl->node_cnt; i++)
+        if (!strcmp(pl->nodes[i].netdev, netdev))
+            return pl->nodes[i].node;
+    snprintf(path, sizeof(path), NIC_NUMA_NODE, netdev);
+
+    return sysfs_int(path);
+}
+
+/* Return the number of Rx queues of a netdev or -1 if the netdev is not found */
+static int
+netdev_rx_queues(const char *netdev)
+{
+    char path[256];
+    struct dirent *entry;
+    DIR *dir;
+    int cnt = 0;
+
+    snprintf(path, sizeof(path), NIC_QUEUES, netdev);
+
+    dir = opendir(path);
+    if (!dir)
+        return -1;
+
+    while ((entry = readdir(dir)))
+        if (!strncmp(entry->d_name, "rx-", 3))
+            cnt++;
+    closedir(dir);
+
+    return cnt;
+}
+
+static struct jcfg_cpu *
+cpu_find(struct jcfg_placement *pl, int cpu)
+{
+    for (int i = 0; i < pl->cpu_cnt; i++)
+        if (pl->cpus[i].cpu == cpu)
+            return &pl->cpus[i];
+    return NULL;
+}
+
+/* Count the threads with and without lports on the other lcores of the physical core */
+static void
+cpu_siblings(struct jcfg_placement *pl, struct jcfg_cpu *c, int *hot, int *users)
+{
+    *hot = *users = 0;
+
+    for (int i = 0; i < pl->cpu_cnt; i++) {
+        struct jcfg_cpu *s = &pl->cpus[i];
+
+        if (s != c && s->core == c->core) {
+            *hot += s->hot;
+            *users += s->users;
+        }
+    }
+}
+
+/*
+ * Read the topology of all online lcores, the lcores in the lcore-group of the placement
+ * section or the process affinity are the lcores given to threads in the auto group.
+ */
+static int
+cpu_table_create(jcfg_info_t *jinfo, struct jcfg_placement *pl)
+{
+    cpu_set_t pool;
+    int nprocs = get_nprocs_conf();
+
+    CPU_ZERO(&pool);
+    if (pl->lgroup_name) {
+        jcfg_lgroup_t *lg = jcfg_lookup_lgroup(jinfo, pl->lgroup_name);
+
+        if (!lg)
+            CNE_ERR_RET("Placement lcore-group '%s' not found\n", pl->lgroup_name);
+        CPU_OR(&pool, &pool, &lg->lcore_bitmap);
+    } else if (sched_getaffinity(0, sizeof(pool), &pool) < 0)
+        CNE_ERR_RET("Unable to get the process affinity\n");
+
+    pl->cpus = calloc(nprocs, sizeof(struct jcfg_cpu));
+    if (!pl->cpus)
+        CNE_ERR_RET("Failed to allocate lcore table\n");
+
+    for (int cpu = 0; cpu < nprocs && cpu < CPU_SETSIZE; cpu++) {
+        struct jcfg_cpu *c = &pl->cpus[pl->cpu_cnt];
+        int core, pkg;
+
+        /* Offline lcores have no topology directory */
+        core = cpu_topology(cpu, "core_id");
+        if (core < 0)
+            continue;
+        pkg = cpu_topology(cpu, "physical_package_id");
+
+        c->cpu     = cpu;
+        c->node    = cne_socket_id(cpu);
+        c->core    = ((pkg < 0 ? 0 : pkg) << 16) | (core & 0xFFFF);
+        c->in_pool = CPU_ISSET(cpu, &pool) ? 1 : 0;
+        pl->cpu_cnt++;
+    }
+
+    for (int i = 0; i < pl->cpu_cnt; i++)
+        if (pl->cpus[i].in_pool)
+            return 0;
+
+    CNE_ERR_RET("No lcores available for placement\n");
+}
+
+/* Find the NUMA node used by most of the thread lports */
+static int
+thread_nic_node(struct jcfg_placement *pl, jcfg_thd_t *thd, uint16_t *flags)
+{
+    int nodes[CPU_SETSIZE / 8] = {0};
+    int node = -1, found = -1;
+
+    for (int i = 0; i < thd->lport_cnt; i++) {
+        jcfg_lport_t *lport = thd->lports[i];
+        int n;
+
+        if (!lport)
+            continue;
+        n = netdev_node(pl, lport->netdev);
+        if (n < 0 || n >= (int)cne_countof(nodes))
+            continue;
+
+        if (found >= 0 && found != n)
+            *flags |= JCFG_PLACE_MIXED_NODES;
+        found = n;
+
+        if (++nodes[n] > ((node < 0) ? 0 : nodes[node]))
+            node = n;
+    }
+
+    return node;
+}
+
+static int
+cpu_score(struct jcfg_placement *pl, struct jcfg_cpu *c, int hot, int nic_node)
+{
+    int score = c->users * SCORE_CPU_SHARED;
+    int sib_hot, sib_users;
+
+    cpu_siblings(pl, c, &sib_hot, &sib_users);
+
+    if (hot) {
+        if (sib_hot)
+            score += (pl->smt) ? SCORE_SMT_HOT_OK : SCORE_SMT_HOT;
+        else if (sib_users)
+            score += SCORE_SMT_COLD;
+        if (nic_node >= 0 && c->node != nic_node)
+            score += SCORE_CROSS_NODE;
+        if (c->cpu == 0)
+            score += SCORE_LCORE_ZERO;
+    } else {
+        /* Keep whole physical cores free for the threads with lports */
+        if (sib_hot)
+            score += SCORE_COLD_ON_HOT;
+        else if (!sib_users)
+            score += SCORE_COLD_ON_FREE;
+    }
+
+    return score;
+}
+
+static int
+thread_place(jcfg_info_t *jinfo, struct jcfg_placement *pl, struct jcfg_place *p)
+{
+    jcfg_data_t *data  = &((struct jcfg *)jinfo->cfg)->data;
+    jcfg_thd_t *thd    = p->thd;
+    struct jcfg_cpu *c = NULL;
+    jcfg_lgroup_t *lg;
+    int best = 0;
+    char name[JCFG_MAX_STRING_SIZE];
+
+    for (int i = 0; i < pl->cpu_cnt; i++) {
+        struct jcfg_cpu *t = &pl->cpus[i];
+        int score;
+
+        if (!t->in_pool)
+            continue;
+
+        score = cpu_score(pl, t, thd->lport_cnt > 0, p->nic_node);
+        if (!c || score < best) {
+            c    = t;
+            best = score;
+        }
+    }
+    if (!c)
+        CNE_ERR_RET("No lcore found for thread '%s'\n", thd->name);
+
+    c->users++;
+    if (thd->lport_cnt)
+        c->hot++;
+    p->cpu  = c->cpu;
+    p->node = c->node;
+    p->flags |= JCFG_PLACE_AUTO;
+
+    /* Give the thread a lcore group of its own holding the selected lcore */
+    lg = calloc(1, sizeof(jcfg_lgroup_t));
+    if (!lg)
+        CNE_ERR_RET("Failed to allocate lcore group\n");
+
+    snprintf(name, sizeof(name), "%s:%s", JCFG_AUTO_GROUP_NAME, thd->name);
+    lg->cbtype    = JCFG_LGROUP_TYPE;
+    lg->name      = strdup(name);
+    lg->lcore_cnt = 1;
+    CPU_ZERO(&lg->lcore_bitmap);
+    CPU_SET(c->cpu, &lg->lcore_bitmap);
+
+    STAILQ_INSERT_TAIL(&data->lgroups, lg, next);
+    data->lgroup_count++;
+
+    free(thd->group_name);
+    thd->group_name = strdup(name);
+    thd->group      = lg;
+
+    return 0;
+}
+
+/* Account for the lcores of the threads with a named lcore group */
+static void
+thread_reserve(struct jcfg_placement *pl, struct jcfg_place *p)
+{
+    jcfg_lgroup_t *lg = p->thd->group;
+
+    for (int i = 0; i < pl->cpu_cnt; i++) {
+        struct jcfg_cpu *c = &pl->cpus[i];
+
+        if (!CPU_ISSET(c->cpu, &lg->lcore_bitmap))
+            continue;
+
+        c->users++;
+        if (p->thd->lport_cnt)
+            c->hot++;
+        if (lg->lcore_cnt == 1) {
+            p->cpu  = c->cpu;
+            p->node = c->node;
+        }
+    }
+}
+
+/* Set the warning flags once every thread has an lcore */
+static void
+thread_check(struct jcfg_placement *pl, struct jcfg_place *p)
+{
+    struct jcfg_cpu *c = cpu_find(pl, p->cpu);
+    int sib_hot, sib_users;
+
+    if (!c)
+        return;
+
+    if (c->users > 1)
+        p->flags |= JCFG_PLACE_CPU_SHARED;
+    if (p->nic_node >= 0 && p->node >= 0 && p->node != p->nic_node)
+        p->flags |= JCFG_PLACE_CROSS_NODE;
+
+    cpu_siblings(pl, c, &sib_hot, &sib_users);
+    if (p->thd->lport_cnt && sib_hot)
+        p->flags |= JCFG_PLACE_SMT_SHARED;
+}
+
+/*
+ * Split the common lport group UMEM so the lports on each NUMA node have a UMEM of their
+ * own, the buffers are divided by the number of lports on each node. Lports on a netdev
+ * without a NUMA node stay in the original UMEM.
+ */
+static int
+umem_split(jcfg_info_t *jinfo, struct jcfg_placement *pl)
+{
+    jcfg_data_t *data = &((struct jcfg *)jinfo->cfg)->data;
+    int nodes[CPU_SETSIZE / 8] = {0};
+    uint32_t total = 0, bufcnt;
+    jcfg_lport_t *lport;
+    jcfg_umem_t *umem, *nu;
+    int keep = -1, idx;
+    char name[JCFG_MAX_STRING_SIZE];
+
+    umem = jcfg_lookup_umem(jinfo, LPORT_GROUP_UMEM_NAME);
+    if (!umem || umem->region_cnt != 1)
+        return 0;
+
+    STAILQ_FOREACH (lport, &data->lports, next) {
+        int n;
+
+        if (lport->umem != umem)
+            continue;
+        total++;
+        n = netdev_node(pl, lport->netdev);
+        if (n < 0 || n >= (int)cne_countof(nodes))
+            continue;
+        nodes[n]++;
+        if (keep < 0 || nodes[n] > nodes[keep])
+            keep = n;
+    }
+    if (keep < 0 || nodes[keep] == (int)total)
+        return 0;
+
+    bufcnt = umem->bufcnt;
+    for (int n = 0; n < (int)cne_countof(nodes); n++) {
+        if (n == keep || !nodes[n])
+            continue;
+
+        nu = calloc(1, sizeof(jcfg_umem_t));
+        if (!nu)
+            CNE_ERR_RET("Out of memory\n");
+        nu->rinfo = calloc(1, sizeof(region_info_t));
+        if (!nu->rinfo) {
+            free(nu);
+            CNE_ERR_RET("Out of memory\n");
+        }
+
+        snprintf(name, sizeof(name), "%s:%d", LPORT_GROUP_UMEM_NAME, n);
+        nu->cbtype            = JCFG_UMEM_TYPE;
+        nu->name              = strdup(name);
+        nu->bufsz             = umem->bufsz;
+        nu->mtype             = umem->mtype;
+        nu->rxdesc            = umem->rxdesc;
+        nu->txdesc            = umem->txdesc;
+        nu->shared_umem       = umem->shared_umem;
+        nu->bufcnt            = ((uint64_t)bufcnt * nodes[n]) / total;
+        nu->region_cnt        = 1;
+        nu->rinfo[0].bufcnt   = nu->bufcnt;
+        umem->rinfo[0].bufcnt = umem->bufcnt - nu->bufcnt;
+        umem->bufcnt          = umem->rinfo[0].bufcnt;
+
+        idx = jcfg_list_add(&data->umem_list, nu);
+        if (idx < 0) {
+            free(nu->rinfo);
+            free(nu->name);
+            free(nu);
+            CNE_ERR_RET("Out of memory\n");
+        }
+        nu->idx = idx;
+
+        STAILQ_INSERT_TAIL(&data->umems, nu, next);
+        data->umem_count++;
+
+        STAILQ_FOREACH (lport, &data->lports, next) {
+            if (lport->umem != umem || netdev_node(pl, lport->netdev) != n)
+                continue;
+            free(lport->umem_name);
+            lport->umem_name = strdup(nu->name);
+            lport->umem      = nu;
+        }
+    }
+
+    return 0;
+}
+
+int
+jcfg_placement_end(jcfg_info_t *jinfo)
+{
+    struct jcfg *cfg  = jinfo->cfg;
+    jcfg_data_t *data = &cfg->data;
+    struct jcfg_placement *pl;
+    jcfg_thd_t *thd;
+    int autos = 0;
+
+    STAILQ_FOREACH (thd, &data->threads, next)
+        if (!thd->group)
+            autos++;
+
+    /* Nothing to do without a placement section or a thread in the auto lcore group */
+    if (!autos && !cfg->placement)
+        return 0;
+
+    pl = placement_get(cfg);
+    if (!pl)
+        return -1;
+
+    if (cpu_table_create(jinfo, pl) < 0)
+        return -1;
+
+    pl->places = calloc(data->thread_count, sizeof(struct jcfg_place));
+    if (!pl->places)
+        CNE_ERR_RET("Failed to allocate placement table\n");
+
+    STAILQ_FOREACH (thd, &data->threads, next) {
+        struct jcfg_place *p = &pl->places[pl->place_cnt++];
+
+        p->thd      = thd;
+        p->cpu      = -1;
+        p->node     = -1;
+        p->nic_node = thread_nic_node(pl, thd, &p->flags);
+
+        if (thd->group)
+            thread_reserve(pl, p);
+    }
+
+    /* Threads with lports select first, the others use the lcores left over */
+    for (int hot = 1; hot >= 0; hot--) {
+        for (int i = 0; i < pl->place_cnt; i++) {
+            struct jcfg_place *p = &pl->places[i];
+
+            if (p->thd->group || (p->thd->lport_cnt > 0) != hot)
+                continue;
+            if (thread_place(jinfo, pl, p) < 0)
+                return -1;
+        }
+    }
+
+    for (int i = 0; i < pl->place_cnt; i++) {
+        struct jcfg_place *p = &pl->places[i];
+
+        thread_check(pl, p);
+
+        if (!p->thd->lport_cnt)
+            continue;
+        if (p->flags & JCFG_PLACE_CPU_SHARED)
+            CNE_WARN("Thread '%s' shares lcore %d with another thread\n", p->thd->name, p->cpu);
+        if (p->flags & JCFG_PLACE_SMT_SHARED)
+            CNE_WARN("Thread '%s' shares a physical core with another thread with lports\n",
+                     p->thd->name);
+        if (p->flags & JCFG_PLACE_CROSS_NODE)
+            CNE_WARN("Thread '%s' runs on node %d, its lports are on node %d\n", p->thd->name,
+                     p->node, p->nic_node);
+        if (p->flags & JCFG_PLACE_MIXED_NODES)
+            CNE_WARN("Thread '%s' has lports on netdevs in different NUMA nodes\n",
+                     p->thd->name);
+    }
+
+    if (pl->umem_split && umem_split(jinfo, pl) < 0)
+        return -1;
+
+    if (pl->print || (jinfo->flags & JCFG_INFO_VERBOSE))
+        jcfg_placement_dump(jinfo);
+
+    return 0;
+}
+
+int
+jcfg_placement_dump(jcfg_info_t *jinfo)
+{
+    struct jcfg_placement *pl;
+    struct jcfg *cfg;
+    jcfg_umem_t *umem;
+    jcfg_lport_t *lport;
+
+    if (!jinfo || !(cfg = jinfo->cfg) || !(pl = cfg->placement) || !pl->places)
+        return -1;
+
+    cne_printf("[magenta]Placement[]: [green]lcore-group[] '[magenta]%s[]', [green]smt[] "
+               "[magenta]%s[], [green]umem-split[] [magenta]%s[]\n",
+               pl->lgroup_name ? pl->lgroup_name : "affinity", pl->smt ? "true" : "false",
+               pl->umem_split ? "true" : "false");
+
+    cne_printf("   [cyan]%-16s %-20s %5s %4s %5s %4s  %s[]\n", "Thread", "Group", "lcore", "Node",
+               "Core", "NIC", "lports");
+    for (int i = 0; i < pl->place_cnt; i++) {
+        struct jcfg_place *p = &pl->places[i];
+        struct jcfg_cpu *c   = cpu_find(pl, p->cpu);
+
+        cne_printf("   %-16s %-20s ", p->thd->name, p->thd->group_name);
+        if (c)
+            cne_printf("%5d %4d %5d ", c->cpu, c->node, c->core & 0xFFFF);
+        else
+            cne_printf("%5s %4s %5s ", "-", "-", "-");
+        if (p->nic_node >= 0)
+            cne_printf("%4d ", p->nic_node);
+        else
+            cne_printf("%4s ", "-");
+
+        for (int j = 0; j < p->thd->lport_cnt; j++) {
+            jcfg_lport_t *lp = p->thd->lports[j];
+            int nq           = (lp) ? netdev_rx_queues(lp->netdev) : -1;
+
+            if (!lp)
+                continue;
+            /* A queue ID past the netdev Rx queues is flagged in red */
+            cne_printf(" %s%s[]", (nq >= 0 && lp->qid >= nq) ? "[red]" : "", lp->name);
+        }
+
+        if (p->flags & JCFG_PLACE_CPU_SHARED)
+            cne_printf(" [red]lcore-shared[]");
+        if (p->flags & JCFG_PLACE_SMT_SHARED)
+            cne_printf(" [red]smt-shared[]");
+        if (p->flags & JCFG_PLACE_CROSS_NODE)
+            cne_printf(" [red]cross-node[]");
+        if (p->flags & JCFG_PLACE_MIXED_NODES)
+            cne_printf(" [yellow]mixed-nodes[]");
+        cne_printf("\n");
+    }
+
+    cne_printf("   [cyan]%-16s %-20s %5s[]\n", "UMEM", "bufcnt", "Node");
+    STAILQ_FOREACH (umem, &cfg->data.umems, next) {
+        int node = -2;
+
+        /* The node is the node of its lports or -1 if they are not on the same node */
+        STAILQ_FOREACH (lport, &cfg->data.lports, next) {
+            int n;
+
+            if (lport->umem != umem)
+                continue;
+            n    = netdev_node(pl, lport->netdev);
+            node = (node == -2 || node == n) ? n : -1;
+        }
+
+        cne_printf("   %-16s %-20u ", umem->name, umem->bufcnt);
+        if (node >= 0)
+            cne_printf("%5d\n", node);
+        else
+            cne_printf("%5s\n", (node == -1) ? "mixed" : "-");
+    }
+
+    return 0;
+}
+
+/* Add the NUMA node of a netdev from the netdev-nodes object */
+static int
+_netdev_node(struct json_object *obj, int flags, struct json_object *parent __cne_unused,
+             const char *key, size_t *index __cne_unused, void *arg)
+{
+    struct jcfg_placement *pl = arg;
+    struct jcfg_netdev_node *nodes;
+
+    if (!key || flags == JSON_C_VISIT_SECOND)
+        return JSON_C_VISIT_RETURN_CONTINUE;
+
+    if (!json_object_is_type(obj, json_type_int))
+        CNE_ERR_RET_VAL(JSON_C_VISIT_RETURN_ERROR, "NUMA node of netdev %s is not a number\n",
+                        key);
+
+    nodes = realloc(pl->nodes, (pl->node_cnt + 1) * sizeof(struct jcfg_netdev_node));
+    if (!nodes)
+        CNE_ERR_RET_VAL(JSON_C_VISIT_RETURN_ERROR, "Failed to allocate netdev nodes\n");
+    pl->nodes = nodes;
+
+    nodes[pl->node_cnt].netdev = strdup(key);
+    if (!nodes[pl->node_cnt].netdev)
+        CNE_ERR_RET_VAL(JSON_C_VISIT_RETURN_ERROR, "Failed to allocate netdev name\n");
+    nodes[pl->node_cnt++].node = json_object_get_int(obj);
+
+    return JSON_C_VISIT_RETURN_CONTINUE;
+}
+
+static int
+_placement(struct json_object *obj, int flags, struct json_object *parent __cne_unused,
+           const char *key, size_t *index __cne_unused, void *arg)
+{
+    struct jcfg_placement *pl = arg;
+
+    if (key && flags != JSON_C_VISIT_SECOND &&
+        !strcasecmp(key, JCFG_PLACEMENT_NETDEV_NODES_NAME)) {
+        if (!json_object_is_type(obj, json_type_object) ||
+            json_c_visit(obj, 0, _netdev_node, pl) == JSON_C_VISIT_RETURN_ERROR)
+            return JSON_C_VISIT_RETURN_ERROR;
+        return JSON_C_VISIT_RETURN_SKIP;
+    }
+
+    if (!key || flags == JSON_C_VISIT_SECOND || json_object_is_type(obj, json_type_object))
+        return JSON_C_VISIT_RETURN_CONTINUE;
+
+    if (!strcasecmp(key, JCFG_PLACEMENT_LCORE_GROUP_NAME)) {
+        free(pl->lgroup_name);
+        pl->lgroup_name = strdup(json_object_get_string(obj));
+    } else if (!strcasecmp(key, JCFG_PLACEMENT_SMT_NAME))
+        pl->smt = json_object_get_boolean(obj) ? 1 : 0;
+    else if (!strcasecmp(key, JCFG_PLACEMENT_UMEM_SPLIT_NAME))
+        pl->umem_split = json_object_get_boolean(obj) ? 1 : 0;
+    else if (!strcasecmp(key, JCFG_PLACEMENT_PRINT_NAME))
+        pl->print = json_object_get_boolean(obj) ? 1 : 0;
+    else
+        CNE_WARN("Unknown placement key (%s)\n", key);
+
+    return JSON_C_VISIT_RETURN_CONTINUE;
+}
+
+int
+_decode_placement(struct json_object *obj, int flags, struct json_object *parent __cne_unused,
+                  const char *key, size_t *index __cne_unused, void *arg)
+{
+    jcfg_info_t *jinfo = arg;
+    struct jcfg_placement *pl;
+    int ret;
+
+    if (flags == JSON_C_VISIT_SECOND)
+        return JSON_C_VISIT_RETURN_CONTINUE;
+
+    if (json_object_get_type(obj) != json_type_object)
+        return JSON_C_VISIT_RETURN_ERROR;
+
+    pl = placement_get(jinfo->cfg);
+    if (!pl)
+        return JSON_C_VISIT_RETURN_ERROR;
+
+    if (jinfo->flags & JCFG_DEBUG_DECODING)
+        cne_printf("[magenta]%s[]: {\n", key);
+
+    ret = json_c_visit(obj, 0, _placement, pl);
+    if (ret == JSON_C_VISIT_RETURN_ERROR)
+        CNE_ERR("Parsing placement failed\n");
+
+    if (jinfo->flags & JCFG_DEBUG_DECODING)
+        cne_printf("}\n");
+
+    return ret ? ret : JSON_C_VISIT_RETURN_SKIP;
+}
@@ -14,6 +14,8 @@
 #include <json-c/json_visit.h>
 #include <json-c/linkhash.h>
 
+#include "jcfg_process.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,14 +29,77 @@ typedef struct jcfg_client_s {
     pthread_barrier_t barrier; /**< A barrier to sync up threads being started */
 } jcfg_client_t;
 
+/* The name of the umem used by default for all lport groups */
+#define LPORT_GROUP_UMEM_NAME "lport-group"
+
+/**
+ * Topology information for a CPU used by the placement code.
+ */
+struct jcfg_cpu {
+    int16_t cpu;      /**< The lcore ID */
+    int16_t node;     /**< NUMA node of the lcore */
+    int32_t core;     /**< Physical core key, (package id << 16) | core id */
+    uint16_t users;   /**< Number of threads using the lcore */
+    uint16_t hot;     /**< Number of threads with lports using the lcore */
+    uint16_t in_pool; /**< lcore can be given to a thread in the auto lcore group */
+};
+
+/**
+ * Flags used for jcfg_place.flags value
+ */
+enum {
+    JCFG_PLACE_AUTO        = (1 << 0), /**< lcore was selected by the placement code */
+    JCFG_PLACE_SMT_SHARED  = (1 << 1), /**< Physical core is shared with a thread with lports */
+    JCFG_PLACE_CPU_SHARED  = (1 << 2), /**< lcore is shared with another thread */
+    JCFG_PLACE_CROSS_NODE  = (1 << 3), /**< lcore is not on the NUMA node of the lports */
+    JCFG_PLACE_MIXED_NODES = (1 << 4), /**< lports are on netdevs in different NUMA nodes */
+};
+
+/**
+ * Placement information for a thread.
+ */
+struct jcfg_place {
+    jcfg_thd_t *thd;  /**< The thread placed */
+    int16_t cpu;      /**< The lcore for the thread, -1 for a multi lcore group */
+    int16_t node;     /**< NUMA node of the lcore, -1 if unknown */
+    int16_t nic_node; /**< NUMA node of most of the thread lports, -1 if unknown */
+    uint16_t flags;   /**< JCFG_PLACE_XXX flags */
+};
+
+/**
+ * NUMA node of a netdev given in the placement section.
+ */
+struct jcfg_netdev_node {
+    char *netdev; /**< The netdev name */
+    int node;     /**< NUMA node used for the netdev */
+};
+
+/**
+ * The placement section settings and the resulting plan.
+ */
+struct jcfg_placement {
+    char *lgroup_name;              /**< lcore group of the lcore pool, NULL for affinity */
+    int smt;                        /**< Allow threads with lports to share a physical core */
+    int umem_split;                 /**< Split the common lport group UMEM by NUMA node */
+    int print;                      /**< Print the placement after decoding */
+    int node_cnt;                   /**< Number of entries in nodes */
+    struct jcfg_netdev_node *nodes; /**< NUMA nodes of netdevs overriding sysfs */
+    int cpu_cnt;                    /**< Number of entries in cpus */
+    struct jcfg_cpu *cpus;          /**< Topology of the lcores in the pool */
+    int place_cnt;                  /**< Number of entries in places */
+    struct jcfg_place *places;      /**< Placement of each thread */
+};
+
 /**
  * Primary JCFG structure an internal structure.
  */
 struct jcfg {
-    struct jcfg_data data;    /**< Pointer to data section of jcfg */
-    char *str;                /**< allocated string pointing to json or jsonc text */
-    struct json_object *root; /**< JSON root object */
-    struct json_tokener *tok; /**< pointer to tokener structure */
+    struct jcfg_data data;            /**< Pointer to data section of jcfg */
+    char *str;                        /**< allocated string pointing to json or jsonc text */
+    struct json_object *root;         /**< JSON root object */
+    struct json_tokener *tok;         /**< pointer to tokener structure */
+    struct jcfg_placement *placement; /**< Placement settings and plan, can be NULL */
+    jcfg_bringup_t bringup;           /**< Timing of the last jcfg_process() call */
 };
 
 /**
@@ -98,6 +163,26 @@ jcfg_get_json_token(struct jcfg *cfg)
  */
 void jcfg_umem_free(jcfg_hdr_t *hdr);
 
+/**
+ * Place the threads using the "auto" lcore group, called after all sections are decoded.
+ * @internal
+ *
+ * @param jinfo
+ *   The jcfg information structure pointer
+ * @return
+ *   0 on success or -1 on error
+ */
+int jcfg_placement_end(jcfg_info_t *jinfo);
+
+/**
+ * Free the placement settings and plan.
+ * @internal
+ *
+ * @param cfg
+ *   The jcfg structure pointer
+ */
+void jcfg_placement_free(struct jcfg *cfg);
+
 #ifdef __cplusplus
 }
 #endif
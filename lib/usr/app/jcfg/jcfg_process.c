@@ -3,10 +3,18 @@
  */
 
 #include <stdio.h>             // for NULL
+#include <stdlib.h>            // for calloc, free
+#include <inttypes.h>          // for PRIu64
+#include <string.h>            // for strcmp, memcpy, memset
+#include <pthread.h>           // for pthread_mutex_lock, pthread_cond_wait
+#include <sys/sysinfo.h>       // for get_nprocs
 #include <cne_common.h>        // for cne_countof
+#include <cne_cycles.h>        // for cne_rdtsc, US_PER_S
+#include <cne_system.h>        // for cne_get_timer_hz
 
 #include "jcfg.h"        // for jcfg_info_t, JCFG_DEBUG_PARSING, jcfg_opt_t
 #include "jcfg_process.h"
+#include "jcfg_private.h"      // for jcfg
 #include "jcfg_print.h"        // for __print_lgroup, __print_lport, __print_thread
 #include "cne_log.h"           // for CNE_ERR_RET, CNE_LOG_ERR
 
@@ -126,6 +134,264 @@ process_lport_group(jcfg_info_t *j, void *obj, void *arg, int idx)
     return 0;
 }
 
+static int
+time_umem(jcfg_info_t *j, void *obj, void *arg, int idx)
+{
+    jcfg_umem_t *umem = obj;
+    uint64_t start    = cne_rdtsc();
+    int ret;
+
+    ret            = process_umem(j, obj, arg, idx);
+    umem->setup_us = ((cne_rdtsc() - start) * US_PER_S) / cne_get_timer_hz();
+
+    return ret;
+}
+
+static int
+time_lport(jcfg_info_t *j, void *obj, void *arg, int idx)
+{
+    jcfg_lport_t *lport = obj;
+    uint64_t start      = cne_rdtsc();
+    int ret;
+
+    ret             = process_lport(j, obj, arg, idx);
+    lport->setup_us = ((cne_rdtsc() - start) * US_PER_S) / cne_get_timer_hz();
+
+    return ret;
+}
+
+#define BRINGUP_MAX_DEPS 3 /**< UMEM, first lport of the netdev and previous shared UMEM lport */
+
+/* A UMEM or lport object to bring up and the jobs that must be done before it */
+struct bringup_job {
+    jcfg_hdr_t *obj;            /**< The jcfg UMEM or lport object */
+    jcfg_cb_t *pfunc;           /**< time_umem() or time_lport() */
+    int idx;                    /**< Index of the object in its section */
+    int deps[BRINGUP_MAX_DEPS]; /**< Jobs to wait for, -1 if unused */
+    int done;                   /**< Set when the callback returned */
+    uint64_t stop;              /**< TSC when the callback returned */
+};
+
+struct bringup {
+    jcfg_info_t *jinfo;       /**< The jcfg information pointer */
+    void *arg;                /**< The callback argument */
+    pthread_mutex_t mutex;    /**< Protects the fields below */
+    pthread_cond_t cond;      /**< Signaled when a job is done */
+    int next;                 /**< Next job to start */
+    int failed;               /**< Set when a callback fails, stops the remaining jobs */
+    int cnt;                  /**< Number of jobs */
+    struct bringup_job *jobs; /**< The list of jobs, a job only depends on earlier jobs */
+};
+
+static int
+bringup_add(struct bringup *b, jcfg_cb_t *pfunc, void *obj, int idx)
+{
+    struct bringup_job *job = &b->jobs[b->cnt];
+
+    job->obj   = obj;
+    job->pfunc = pfunc;
+    job->idx   = idx;
+    for (int i = 0; i < BRINGUP_MAX_DEPS; i++)
+        job->deps[i] = -1;
+
+    return b->cnt++;
+}
+
+/* Build the job list, UMEMs first followed by the lports in the order of the sections */
+static int
+bringup_jobs(jcfg_info_t *jinfo, struct bringup *b)
+{
+    jcfg_data_t *data = &((struct jcfg *)jinfo->cfg)->data;
+    jcfg_umem_t *umem;
+    jcfg_lport_t *lport;
+    int idx = 0;
+
+    if ((data->umem_count + data->lport_count) == 0)
+        return 0;
+
+    b->jobs = calloc(data->umem_count + data->lport_count, sizeof(struct bringup_job));
+    if (!b->jobs)
+        CNE_ERR_RET("Failed to allocate bring-up jobs\n");
+
+    STAILQ_FOREACH (umem, &data->umems, next)
+        bringup_add(b, time_umem, umem, idx++);
+
+    idx = 0;
+    STAILQ_FOREACH (lport, &data->lports, next) {
+        int id                  = bringup_add(b, time_lport, lport, idx++);
+        struct bringup_job *job = &b->jobs[id];
+        int first = -1, shared = -1;
+
+        for (int i = 0; i < id; i++) {
+            jcfg_hdr_t *obj = b->jobs[i].obj;
+            jcfg_lport_t *lp;
+
+            if (obj == (jcfg_hdr_t *)lport->umem) {
+                job->deps[0] = i;
+                continue;
+            }
+            if (obj->cbtype != JCFG_LPORT_TYPE)
+                continue;
+            lp = (jcfg_lport_t *)obj;
+
+            /* The first lport of a netdev attaches the XDP program used by the others */
+            if (first < 0 && lp->netdev && lport->netdev && !strcmp(lp->netdev, lport->netdev))
+                first = i;
+            if (lp->umem == lport->umem && lport->umem && lport->umem->shared_umem)
+                shared = i;
+        }
+        job->deps[1] = first;
+        job->deps[2] = shared;
+    }
+
+    return 0;
+}
+
+static int
+bringup_ready(struct bringup *b, struct bringup_job *job)
+{
+    for (int i = 0; i < BRINGUP_MAX_DEPS; i++)
+        if (job->deps[i] >= 0 && !b->jobs[job->deps[i]].done)
+            return 0;
+    return 1;
+}
+
+static void *
+bringup_worker(void *arg)
+{
+    struct bringup *b = arg;
+
+    pthread_mutex_lock(&b->mutex);
+    while (!b->failed && b->next < b->cnt) {
+        struct bringup_job *job = &b->jobs[b->next++];
+        int ret;
+
+        /* Jobs only depend on earlier jobs already taken by a worker, so this always ends */
+        while (!b->failed && !bringup_ready(b, job))
+            pthread_cond_wait(&b->cond, &b->mutex);
+        if (b->failed)
+            break;
+        pthread_mutex_unlock(&b->mutex);
+
+        ret       = job->pfunc(b->jinfo, job->obj, b->arg, job->idx);
+        job->stop = cne_rdtsc();
+
+        pthread_mutex_lock(&b->mutex);
+        if (ret < 0) {
+            CNE_ERR("Bring-up of %s failed\n", job->obj->name);
+            b->failed = 1;
+        }
+        job->done = 1;
+        pthread_cond_broadcast(&b->cond);
+    }
+    pthread_mutex_unlock(&b->mutex);
+
+    return NULL;
+}
+
+static int
+bringup_workers(jcfg_info_t *jinfo, int jobs)
+{
+    uint32_t workers = 0;
+
+    if (jcfg_default_get_u32(jinfo, "bringup", &workers) || workers == 0)
+        workers = get_nprocs();
+    if (workers > (uint32_t)jobs)
+        workers = jobs;
+    if (workers > JCFG_MAX_BRINGUP_WORKERS)
+        workers = JCFG_MAX_BRINGUP_WORKERS;
+
+    return (workers) ? workers : 1;
+}
+
+/*
+ * Call the UMEM and lport callbacks from a pool of threads honoring the job dependencies,
+ * the end of each phase is the time the last callback of the phase returned.
+ */
+static int
+bringup_parallel(jcfg_info_t *jinfo, void *cb_arg, uint16_t *workers, uint64_t *umem_end,
+                 uint64_t *lport_end)
+{
+    struct bringup b = {.jinfo = jinfo, .arg = cb_arg};
+    pthread_t tids[JCFG_MAX_BRINGUP_WORKERS];
+    int nb_workers, started = 0, ret = -1;
+
+    if (bringup_jobs(jinfo, &b) < 0)
+        return -1;
+    if (b.cnt == 0)
+        return 0;
+
+    pthread_mutex_init(&b.mutex, NULL);
+    pthread_cond_init(&b.cond, NULL);
+
+    nb_workers = bringup_workers(jinfo, b.cnt);
+    for (; started < nb_workers; started++) {
+        if (pthread_create(&tids[started], NULL, bringup_worker, &b)) {
+            if (started == 0)
+                CNE_ERR_GOTO(leave, "Failed to create a bring-up thread\n");
+            break;
+        }
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(tids[i], NULL);
+    *workers = started;
+
+    for (int i = 0; i < b.cnt; i++) {
+        uint64_t *end = (b.jobs[i].obj->cbtype == JCFG_UMEM_TYPE) ? umem_end : lport_end;
+
+        if (b.jobs[i].stop > *end)
+            *end = b.jobs[i].stop;
+    }
+
+    ret = (b.failed) ? -1 : 0;
+leave:
+    pthread_cond_destroy(&b.cond);
+    pthread_mutex_destroy(&b.mutex);
+    free(b.jobs);
+
+    return ret;
+}
+
+/* Collect the timing of each UMEM and lport, the callbacks recorded their own time */
+static void
+bringup_stats(jcfg_info_t *jinfo, uint64_t start, uint64_t umem_end, uint64_t lport_end)
+{
+    struct jcfg *cfg   = jinfo->cfg;
+    jcfg_bringup_t *st = &cfg->bringup;
+    uint64_t hz        = cne_get_timer_hz();
+    jcfg_umem_t *umem;
+    jcfg_lport_t *lport;
+
+    st->umem_cnt     = cfg->data.umem_count;
+    st->lport_cnt    = cfg->data.lport_count;
+    st->umem_us      = (umem_end > start) ? ((umem_end - start) * US_PER_S) / hz : 0;
+    st->lport_us     = (lport_end > start) ? ((lport_end - start) * US_PER_S) / hz : 0;
+    st->umem_max_us  = 0;
+    st->lport_max_us = 0;
+
+    STAILQ_FOREACH (umem, &cfg->data.umems, next) {
+        CNE_DEBUG("UMEM %s bring-up %u us\n", umem->name, umem->setup_us);
+        if (umem->setup_us > st->umem_max_us)
+            st->umem_max_us = umem->setup_us;
+    }
+    STAILQ_FOREACH (lport, &cfg->data.lports, next) {
+        CNE_DEBUG("lport %s bring-up %u us\n", lport->name, lport->setup_us);
+        if (lport->setup_us > st->lport_max_us)
+            st->lport_max_us = lport->setup_us;
+    }
+}
+
+int
+jcfg_bringup_get(jcfg_info_t *jinfo, jcfg_bringup_t *bringup)
+{
+    if (!jinfo || !jinfo->cfg || !bringup)
+        return -1;
+
+    memcpy(bringup, &((struct jcfg *)jinfo->cfg)->bringup, sizeof(jcfg_bringup_t));
+
+    return 0;
+}
+
 int
 jcfg_process(jcfg_info_t *jinfo, int flags, jcfg_parse_cb_t *cb, void *cb_arg)
 {
@@ -138,21 +404,27 @@ jcfg_process(jcfg_info_t *jinfo, int flags, jcfg_parse_cb_t *cb, void *cb_arg)
         { JCFG_APPLICATION_TYPE,   process_application },
         { JCFG_DEFAULT_TYPE,       process_defaults },
         { JCFG_OPTION_TYPE,        process_option },
-        { JCFG_UMEM_TYPE,          process_umem },
-        { JCFG_LPORT_TYPE,         process_lport },
+        { JCFG_UMEM_TYPE,          time_umem },
+        { JCFG_LPORT_TYPE,         time_lport },
         { JCFG_LGROUP_TYPE,        process_lgroup },
         { JCFG_THREAD_TYPE,        process_thread },
         { JCFG_LPORT_GROUP_TYPE,   process_lport_group },
         { JCFG_USER_TYPE,          process_user }
     };
     // clang-format on
+    jcfg_bringup_t *st;
+    uint64_t start, umem_end = 0, lport_end = 0;
 
-    if (!jinfo)
+    if (!jinfo || !jinfo->cfg)
         return -1;
 
     jinfo->cb    = cb;
     jinfo->flags = flags;
 
+    st = &((struct jcfg *)jinfo->cfg)->bringup;
+    memset(st, 0, sizeof(jcfg_bringup_t));
+    start = cne_rdtsc();
+
     if (flags & JCFG_DEBUG_PARSING)
         cne_printf("[yellow]>>>>> [green]Process JCFG sections[]\n");
 
@@ -165,12 +437,34 @@ jcfg_process(jcfg_info_t *jinfo, int flags, jcfg_parse_cb_t *cb, void *cb_arg)
         if (flags & JCFG_DEBUG_PARSING)
             cne_printf("[yellow]=== [green]%s[]:\n", tags[cbtype]);
 
-        if (jcfg_object_foreach(jinfo, cbtype, process[i].pfunc, cb_arg)) {
-            cne_printf(" [red]*** %s: Error ***[]\n", __func__);
-            return -1;
+        /* Both UMEM and lport objects are brought up by the workers in the UMEM step */
+        if ((flags & JCFG_PARALLEL_FLAG) && cbtype == JCFG_UMEM_TYPE) {
+            if (bringup_parallel(jinfo, cb_arg, &st->workers, &umem_end, &lport_end)) {
+                cne_printf(" [red]*** %s: Error ***[]\n", __func__);
+                return -1;
+            }
+        } else if (!(flags & JCFG_PARALLEL_FLAG) || cbtype != JCFG_LPORT_TYPE) {
+            if (jcfg_object_foreach(jinfo, cbtype, process[i].pfunc, cb_arg)) {
+                cne_printf(" [red]*** %s: Error ***[]\n", __func__);
+                return -1;
+            }
         }
+
+        if (flags & JCFG_PARALLEL_FLAG)
+            continue;
+        if (cbtype == JCFG_UMEM_TYPE)
+            umem_end = cne_rdtsc();
+        else if (cbtype == JCFG_LPORT_TYPE)
+            lport_end = cne_rdtsc();
     }
 
+    bringup_stats(jinfo, start, umem_end, lport_end);
+    st->total_us = ((cne_rdtsc() - start) * US_PER_S) / cne_get_timer_hz();
+
+    CNE_INFO("Bring-up of %u UMEMs and %u lports took %" PRIu64 " us, %u worker(s), "
+             "total %" PRIu64 " us\n",
+             st->umem_cnt, st->lport_cnt, st->lport_us, st->workers, st->total_us);
+
     if (flags & JCFG_DEBUG_PARSING)
         cne_printf("[yellow]>>>>> [green]Done Processing sections[]\n\n");
 
@@ -5,7 +5,8 @@
 #ifndef _JCFG_PROCESS_H_
 #define _JCFG_PROCESS_H_
 
-#include <jcfg.h>        // for jcfg_parse_cb_t, jcfg_info_t
+#include <stdint.h>        // for uint64_t, uint32_t, uint16_t
+#include <jcfg.h>          // for jcfg_parse_cb_t, jcfg_info_t
 
 #include "cne_common.h"        // for CNDP_API
 
@@ -21,9 +22,37 @@
 extern "C" {
 #endif
 
+#define JCFG_MAX_BRINGUP_WORKERS 16 /**< Max number of threads used to bring up objects */
+
+/**
+ * Timing of the UMEM and lport bring-up done by jcfg_process().
+ *
+ * The UMEM and lport phases overlap when the objects are processed in parallel, an lport
+ * only waits for its own UMEM. The phase times are from the start of jcfg_process() to the
+ * end of the last callback of the phase.
+ */
+typedef struct jcfg_bringup {
+    uint64_t total_us;     /**< Time spent in jcfg_process() */
+    uint64_t umem_us;      /**< Time until the last UMEM callback returned */
+    uint64_t lport_us;     /**< Time until the last lport callback returned */
+    uint32_t umem_max_us;  /**< Longest UMEM callback */
+    uint32_t lport_max_us; /**< Longest lport callback */
+    uint16_t umem_cnt;     /**< Number of UMEM objects processed */
+    uint16_t lport_cnt;    /**< Number of lport objects processed */
+    uint16_t workers;      /**< Number of threads used, 0 when processed in order */
+} jcfg_bringup_t;
+
 /**
  * Process the json configuration information and callback user routine.
  *
+ * With JCFG_PARALLEL_FLAG set the UMEM and lport objects are handed to a pool of worker
+ * threads, the callback must be thread safe for these two object types. An lport is not
+ * started until its UMEM is done, the first lport of a netdev is done before the other
+ * lports of the netdev and lports sharing a UMEM with shared_umem set are done one at a
+ * time. The number of workers is the 'bringup' value of the defaults section or the number
+ * of UMEM and lport objects, limited to JCFG_MAX_BRINGUP_WORKERS. All other objects are
+ * processed in order on the calling thread.
+ *
  * @param jinfo
  *   The jcfg_info_t pointer
  * @param flags
@@ -37,6 +66,18 @@ extern "C" {
  */
 CNDP_API int jcfg_process(jcfg_info_t *jinfo, int flags, jcfg_parse_cb_t *cb, void *cb_arg);
 
+/**
+ * Return the bring-up timing of the last jcfg_process() call.
+ *
+ * @param jinfo
+ *   The jcfg_info_t pointer
+ * @param bringup
+ *   The location to copy the timing information
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int jcfg_bringup_get(jcfg_info_t *jinfo, jcfg_bringup_t *bringup);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,9 +4,11 @@
 
 #include <stdio.h>        // for NULL
 #include <errno.h>        // for ENODEV, errno
+#include <inttypes.h>     // for PRIu64
 #include <pthread.h>
 
 #include <cne_mutex_helper.h>
+#include <cne_hist.h>        // for cne_hist_percentile, cne_hist_mean
 #include "metrics.h"
 
 static uds_info_t *default_info;
@@ -142,6 +144,24 @@ metrics_port_stats(metrics_client_t *c, char *name, lport_stats_t *s)
     return 0;
 }
 
+int
+metrics_hist(metrics_client_t *c, const char *name, const struct cne_hist_rec *s)
+{
+    if (!c || !name || !s)
+        return -1;
+
+    metrics_append(c, "\"%s_count\":%" PRIu64, name, s->count);
+    metrics_append(c, ",\"%s_min\":%" PRIu64, name, s->count ? s->min : 0);
+    metrics_append(c, ",\"%s_mean\":%.1f", name, cne_hist_mean(s));
+    metrics_append(c, ",\"%s_p50\":%" PRIu64, name, cne_hist_percentile(s, 50.0));
+    metrics_append(c, ",\"%s_p90\":%" PRIu64, name, cne_hist_percentile(s, 90.0));
+    metrics_append(c, ",\"%s_p99\":%" PRIu64, name, cne_hist_percentile(s, 99.0));
+    metrics_append(c, ",\"%s_p999\":%" PRIu64, name, cne_hist_percentile(s, 99.9));
+    metrics_append(c, ",\"%s_max\":%" PRIu64, name, s->max);
+
+    return 0;
+}
+
 CNE_INIT_PRIO(metrics_constructor, INIT)
 {
     if (cne_mutex_create(&metrics_mutex, PTHREAD_MUTEX_RECURSIVE) < 0)
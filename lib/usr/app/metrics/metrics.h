@@ -24,6 +24,8 @@ extern "C" {
 typedef uds_info_t metrics_info_t;
 typedef uds_client_t metrics_client_t;
 
+struct cne_hist_rec; /**< Histogram snapshot, see cne_hist.h */
+
 /* callback returns json data in buffer, up to buf_len long.
  * returns length of buffer used on success, negative on error.
  */
@@ -76,6 +78,20 @@ CNDP_API int metrics_destroy(void);
         uds_append((uds_client_t *)c, (const char *)fmt, ##__VA_ARGS__); \
     } while (0)
 
+/**
+ * Add binary data to the output buffer, the response is sent as raw bytes and not JSON.
+ *
+ * @param c
+ *   The client pointer that holds the buffer to append the data.
+ * @param data
+ *   The data to append
+ * @param len
+ *   The number of bytes to append
+ * @return
+ *   0 on success or -1 on error
+ */
+#define metrics_append_binary(c, data, len) uds_append_binary((uds_client_t *)c, data, len)
+
 /**
  * Return the command string pointer
  *
@@ -110,6 +126,20 @@ CNDP_API const char *metrics_params(metrics_client_t *client);
  */
 CNDP_API int metrics_port_stats(metrics_client_t *c, char *name, lport_stats_t *s);
 
+/**
+ * Add the count, mean and percentiles of a histogram snapshot to the metrics buffer
+ *
+ * @param c
+ *   The metric_client_t structure pointer
+ * @param name
+ *   The name of the histogram as a prefix to the stats names.
+ * @param s
+ *   The histogram snapshot, taken with cne_hist_snapshot()
+ * @return
+ *   -1 on error, 0 on success
+ */
+CNDP_API int metrics_hist(metrics_client_t *c, const char *name, const struct cne_hist_rec *s);
+
 #ifdef __cplusplus
 }
 #endif
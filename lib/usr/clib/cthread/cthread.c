@@ -42,6 +42,8 @@
 #include <fcntl.h>
 #include <sys/time.h>
 #include <sys/mman.h>
+#include <sys/epoll.h>
+#include <errno.h>
 
 #include <cne.h>
 #include <cne_prefetch.h>
@@ -163,24 +165,116 @@ _cthread_free(struct cthread *ct)
     _cthread_objcache_free(ct->tls->sched->tls_cache, ct->tls);
 
     /* free the stack */
-    _cthread_objcache_free(ct->stack_container->sched->stack_cache, ct->stack_container);
+    _stack_free(ct->stack_container);
 
-    cne_spinlock_recursive_lock(&THIS_SCHED->lock);
+    /* the thread list and ID belong to the scheduler the thread was created on */
+    cne_spinlock_recursive_lock(&ct->home->lock);
 
     /* find out tailq entry */
-    STAILQ_FOREACH (d, &THIS_SCHED->threads, next) {
+    STAILQ_FOREACH (d, &ct->home->threads, next) {
         if (d == (void *)ct) {
-            STAILQ_REMOVE(&THIS_SCHED->threads, d, cthread, next);
+            STAILQ_REMOVE(&ct->home->threads, d, cthread, next);
             break;
         }
     }
 
-    uid_free(THIS_SCHED->uid_pool, ct->cthread_id);
+    uid_free(ct->home->uid_pool, ct->cthread_id);
 
-    cne_spinlock_recursive_unlock(&THIS_SCHED->lock);
+    cne_spinlock_recursive_unlock(&ct->home->lock);
+
+    /* now free the thread, a stolen thread goes back to the cache it came from */
+    _cthread_objcache_free(ct->home->cthread_cache, ct);
+}
+
+/*
+ * Reserve a stack with mmap, a PROT_NONE guard page sits below the stack and
+ * the stack header is placed at the top so an overflow faults instead of
+ * corrupting it. Pages are only committed when the stack touches them.
+ */
+static struct cthread_stack *
+_stack_mmap_alloc(struct cthread_sched *sched, size_t reserve)
+{
+    size_t page = (size_t)getpagesize();
+    struct cthread_stack *s;
+    size_t map_size;
+    void *map;
+
+    /* reuse a cached reservation of the same size */
+    while ((s = _cthread_queue_remove(sched->stack_free)) != NULL) {
+        atomic_fetch_sub(&sched->nb_stack_free, 1);
+        if (s->map_size == CNE_ALIGN_CEIL(reserve, page) + page)
+            return s;
+        munmap(s->map, s->map_size);
+    }
+
+    map_size = CNE_ALIGN_CEIL(reserve, page) + page;
+    map      = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (map == MAP_FAILED)
+        CNE_NULL_RET("mmap of %zu byte stack failed: %s\n", map_size, strerror(errno));
+
+    if (mprotect(map, page, PROT_NONE) < 0) {
+        munmap(map, map_size);
+        CNE_NULL_RET("mprotect of stack guard page failed: %s\n", strerror(errno));
+    }
+
+    s = CNE_PTR_ALIGN_FLOOR((struct cthread_stack *)((char *)map + map_size - sizeof(*s)),
+                            CNE_CACHE_LINE_SIZE);
+    s->sched      = sched;
+    s->map        = map;
+    s->map_size   = map_size;
+    s->base       = (char *)map + page;
+    s->stack_size = (uintptr_t)s - (uintptr_t)s->base;
+
+    sched->stacks_mapped++;
+
+    return s;
+}
+
+/*
+ * Record the deepest use of a stack in the owning scheduler. Untouched mmap
+ * pages are not resident and unused objcache stack memory is still zero, so
+ * the lowest resident page or non-zero word marks the high water mark.
+ */
+static void
+_stack_hwm_update(struct cthread_stack *s)
+{
+    uintptr_t top = (uintptr_t)s->base + s->stack_size;
+    uintptr_t low = top;
+    uint64_t hwm, cur;
+
+    if (s->map) {
+        size_t page   = (size_t)getpagesize();
+        size_t npages = (CNE_ALIGN_FLOOR(top, page) - (uintptr_t)s->base) / page;
+        unsigned char vec[64];
+
+        for (size_t i = 0; i < npages; i += sizeof(vec)) {
+            size_t n = CNE_MIN(npages - i, sizeof(vec));
+
+            if (mincore((char *)s->base + (i * page), n * page, vec) < 0)
+                return;
+            for (size_t j = 0; j < n; j++) {
+                if (vec[j] & 1) {
+                    low = (uintptr_t)s->base + ((i + j) * page);
+                    goto done;
+                }
+            }
+        }
+    } else {
+        uint64_t *p = s->base;
 
-    /* now free the thread */
-    _cthread_objcache_free(ct->sched->cthread_cache, ct);
+        for (; (uintptr_t)p < top; p++) {
+            if (*p) {
+                low = (uintptr_t)p;
+                break;
+            }
+        }
+    }
+done:
+    hwm = top - low;
+    cur = atomic_load(&s->sched->stack_hwm);
+    while (hwm > cur && !atomic_compare_exchange_weak(&s->sched->stack_hwm, &cur, hwm))
+        ;
 }
 
 /*
@@ -189,22 +283,55 @@ _cthread_free(struct cthread *ct)
 struct cthread_stack *
 _stack_alloc(void)
 {
+    size_t reserve = cthread_sched_stack_mmap_size();
     struct cthread_stack *s;
 
+    if (reserve)
+        return _stack_mmap_alloc(THIS_SCHED, reserve);
+
     s = _cthread_objcache_alloc((THIS_SCHED)->stack_cache);
     if (!s)
         CNE_NULL_RET("objcache stack_cache is empty\n");
 
     s->sched      = THIS_SCHED;
     s->stack_size = cthread_sched_stack_size() - sizeof(struct cthread_stack);
+    s->base       = &s->stack_start[0];
+    s->map        = NULL;
 
     return s;
 }
 
+/*
+ * Free a stack to the scheduler owning it, which may not be this scheduler
+ * when the cthread was stolen or migrated.
+ */
 void
 _stack_free(struct cthread_stack *s)
 {
-    _cthread_objcache_free((THIS_SCHED)->stack_cache, s);
+    struct cthread_sched *sched = s->sched;
+
+    if (_sched_stack_hwm)
+        _stack_hwm_update(s);
+
+    if (!s->map) {
+        _cthread_objcache_free(sched->stack_cache, s);
+        return;
+    }
+
+    /* above the watermark keep the reservation, but give the memory back */
+    if (atomic_load(&sched->nb_stack_free) >= cthread_sched_stack_watermark()) {
+        size_t page = (size_t)getpagesize();
+        size_t len  = CNE_ALIGN_FLOOR((uintptr_t)s, page) - (uintptr_t)s->base;
+
+        if (madvise(s->base, len, MADV_DONTNEED) == 0)
+            atomic_fetch_add(&sched->stacks_released, 1);
+    }
+
+    atomic_fetch_add(&sched->nb_stack_free, 1);
+    if (_cthread_queue_insert_mp(sched->stack_free, s) == NULL) {
+        atomic_fetch_sub(&sched->nb_stack_free, 1);
+        munmap(s->map, s->map_size);
+    }
 }
 
 /*
@@ -256,6 +383,7 @@ cthread_create(const char *name, cthread_func_t fun, void *arg)
 
     bzero(ct, sizeof(struct cthread));
     ct->sched = THIS_SCHED;
+    ct->home  = THIS_SCHED;
 
     /* set the function args and exit handlder */
     _cthread_init(ct, name, fun, arg, _cthread_exit_handler);
@@ -266,7 +394,7 @@ cthread_create(const char *name, cthread_func_t fun, void *arg)
     cne_spinlock_recursive_unlock(&THIS_SCHED->lock);
 
     cne_compiler_barrier();
-    _ready_queue_insert(THIS_SCHED, ct);
+    _steal_queue_insert(ct);
 
     return ct;
 }
@@ -494,17 +622,54 @@ cthread_sleep_msec(uint64_t ms)
     _cthread_sched_sleep(ct, ms * 1000000UL);
 }
 
+/*
+ * Park the current cthread on the scheduler epoll fd until the fd is ready
+ * or the timeout expires.
+ */
+int
+cthread_wait_fd(int fd, uint32_t events, uint64_t nsecs)
+{
+    struct cthread *ct          = THIS_CTHREAD;
+    struct cthread_sched *sched = THIS_SCHED;
+    struct epoll_event ev       = {0};
+    uint64_t clks;
+
+    if (!ct || fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ev.events   = events | EPOLLONESHOT;
+    ev.data.ptr = ct;
+    if (epoll_ctl(sched->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+        return -1;
+
+    ct->revents = 0;
+    clks        = _ns_to_clks(nsecs);
+    if (clks)
+        _timer_start(ct, clks);
+
+    /* a blocked cthread is never stolen, so it resumes on this scheduler */
+    sched->nb_fd_waiters++;
+    _suspend();
+    sched->nb_fd_waiters--;
+
+    _timer_stop(ct);
+
+    /* the fd may have been closed by another cthread while this one was parked */
+    if (epoll_ctl(sched->epoll_fd, EPOLL_CTL_DEL, fd, NULL) < 0 && errno != EBADF)
+        CNE_WARN("Unable to remove fd %d from the scheduler epoll: %s\n", fd, strerror(errno));
+
+    return (int)ct->revents;
+}
+
 /*
  * Requeue the current thread to the back of the ready queue
  */
 void
 cthread_yield(void)
 {
-    struct cthread *ct = THIS_CTHREAD;
-
-    _ready_queue_insert(THIS_SCHED, ct);
-
-    cthread_switch(&(THIS_SCHED)->ctx, &ct->ctx);
+    _reschedule();
 }
 
 /*
@@ -559,7 +724,7 @@ cthread_exit(void *ptr)
     /* detach it so its resources can be released */
     c->state |= (BIT(CT_STATE_DETACH) | BIT(CT_STATE_EXITED));
 
-    atomic_fetch_sub(&THIS_SCHED->thread_count, 1);
+    atomic_fetch_sub(&c->home->thread_count, 1);
 }
 
 /*
@@ -264,6 +264,43 @@ CNDP_API void cthread_sched_stack_size_set(size_t stack_size);
  */
 CNDP_API size_t cthread_sched_stack_size(void);
 
+/**
+ * Default number of free mmap stacks a scheduler keeps backed by memory.
+ */
+#define CTHREAD_STACK_WATERMARK 64
+
+/**
+ * Allocate cthread stacks from mmap reservations instead of the stack cache.
+ *
+ * Each stack is a private anonymous mapping of reserve_size bytes with a guard
+ * page below it, memory is only committed as the stack is touched. A freed
+ * stack is cached for reuse, once more than watermark stacks are cached the
+ * freed stack has its memory returned with MADV_DONTNEED and keeps only the
+ * virtual reservation. Affects stacks allocated after the call.
+ *
+ * @param reserve_size
+ *   Bytes of virtual address space per stack, zero returns to the stack cache.
+ * @param watermark
+ *   Number of free stacks to keep backed by memory, zero for the default.
+ */
+CNDP_API void cthread_sched_stack_mmap_set(size_t reserve_size, uint32_t watermark);
+
+/**
+ * Get the mmap stack reservation size.
+ *
+ * @return
+ *   The bytes reserved per mmap stack or zero if mmap stacks are disabled.
+ */
+CNDP_API size_t cthread_sched_stack_mmap_size(void);
+
+/**
+ * Get the number of free mmap stacks a scheduler keeps backed by memory.
+ *
+ * @return
+ *   The free stack cache watermark.
+ */
+CNDP_API uint32_t cthread_sched_stack_watermark(void);
+
 /**
  * Start a scehduler on the current thread.
  *
@@ -421,6 +458,30 @@ CNDP_API void cthread_sleep_clks(uint64_t clks);
  */
 CNDP_API void cthread_sleep_nsecs(uint64_t nsecs);
 
+/**
+ * Park the current cthread until a file descriptor is ready
+ *
+ *  The cthread is suspended on the scheduler's epoll fd instead of polling
+ *  with cthread_yield(). When a scheduler has nothing else to run it blocks
+ *  in epoll_wait() until an fd is ready, a timer is due or a peer scheduler
+ *  queues a cthread to it. Any number of cthreads of a scheduler may wait at
+ *  the same time, each on a different fd; a fd already waited on by another
+ *  cthread of the same scheduler fails with EEXIST.
+ *
+ *	 Execution will switch to the next cthread that is ready to run
+ *
+ * @param fd
+ *  The file descriptor to wait on, UDS, tap, eventfd or any epoll capable fd
+ * @param events
+ *  The epoll events to wait for, EPOLLIN, EPOLLOUT, ...
+ * @param nsecs
+ *  Number of nsecs to wait, zero waits without a timeout
+ *
+ * @return
+ *  The epoll events seen on the fd, 0 on timeout or -1 on error with errno set
+ */
+CNDP_API int cthread_wait_fd(int fd, uint32_t events, uint64_t nsecs);
+
 /**
  * Return the state of the expired flag
  *
@@ -458,6 +519,102 @@ CNDP_API void cthread_yield(void);
  */
 CNDP_API int cthread_set_affinity(int thread);
 
+/**
+ * Enable or disable work stealing between schedulers
+ *
+ *  When enabled a scheduler with nothing to run takes ready cthreads from
+ *  the scheduler with the most queued work and runs them itself. A stolen
+ *  cthread stays on the new scheduler until stolen again or migrated with
+ *  cthread_set_affinity(). Stealing is disabled by default.
+ *
+ *  Schedulers should be started with cthread_num_schedulers_set() so an idle
+ *  scheduler does not exit before its peers have started.
+ *
+ * @param enable
+ *   Non-zero to enable stealing or zero to disable it.
+ */
+CNDP_API void cthread_work_steal_set(int enable);
+
+/**
+ * Return the work stealing state
+ *
+ * @return
+ *   1 if work stealing is enabled or 0 if disabled
+ */
+CNDP_API int cthread_work_steal_get(void);
+
+/**
+ * Enable or disable the stack high water mark of the schedulers
+ *
+ *  When enabled the stack of each exiting cthread is scanned for the deepest
+ *  page or word it used, which is reported as stack_hwm by
+ *  cthread_sched_stats(). The scan costs a walk of the stack on every cthread
+ *  exit, so it is meant for sizing stacks and is disabled by default.
+ *
+ * @param enable
+ *   Non-zero to enable the high water mark or zero to disable it.
+ */
+CNDP_API void cthread_stack_hwm_set(int enable);
+
+/**
+ * Return the stack high water mark state
+ *
+ * @return
+ *   1 if the stack high water mark is enabled or 0 if disabled
+ */
+CNDP_API int cthread_stack_hwm_get(void);
+
+/**
+ * Pin or unpin a cthread to the scheduler it is running on
+ *
+ *  A pinned cthread is never stolen by another scheduler, use this for
+ *  cthreads owning per core resources like a stack instance or an lport.
+ *  cthread_set_affinity() still moves a pinned cthread.
+ *
+ * @param c
+ *   The cthread structure pointer, if NULL use the current cthread.
+ * @param pinned
+ *   Non-zero to pin the cthread or zero to allow it to be stolen.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cthread_set_pinned(struct cthread *c, int pinned);
+
+/**
+ * Return true if the cthread is pinned
+ *
+ * @param c
+ *   The cthread structure pointer, if NULL use the current cthread.
+ * @return
+ *   1 if pinned or 0 if not pinned
+ */
+CNDP_API int cthread_is_pinned(struct cthread *c);
+
+/**
+ * Work stealing, migration and stack counters for a scheduler
+ */
+struct cthread_sched_stats {
+    uint64_t steals;          /**< cthreads this scheduler stole from peers */
+    uint64_t stolen;          /**< cthreads peers stole from this scheduler */
+    uint64_t steal_misses;    /**< idle steal passes that found no work */
+    uint64_t migrations;      /**< cthreads moved away with cthread_set_affinity() */
+    uint64_t stacks_mapped;   /**< mmap stack reservations created */
+    uint64_t stacks_released; /**< freed stacks returned to the kernel with MADV_DONTNEED */
+    uint64_t stack_hwm;       /**< deepest stack use seen, see cthread_stack_hwm_set() */
+};
+
+/**
+ * Return the work stealing, migration and stack counters of a scheduler
+ *
+ * @param s
+ *   The scheduler structure pointer, if NULL use the current scheduler.
+ * @param st
+ *   The structure to fill in with the counters.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cthread_sched_stats(struct cthread_sched *s, struct cthread_sched_stats *st);
+
 /**
  * Return the current cthread
  *
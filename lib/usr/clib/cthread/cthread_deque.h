@@ -0,0 +1,180 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2019-2023 Intel Corporation
+ */
+
+#ifndef _CTHREAD_DEQUE_H_
+#define _CTHREAD_DEQUE_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <cne_common.h>
+#include <cne_atomic.h>
+
+#include "cthread_int.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * This file implements a bounded lock free work stealing deque in the style
+ * of Chase-Lev, used to hold the cthreads a scheduler is willing to give away.
+ *
+ * Only the owning scheduler pushes onto the bottom of the deque, any scheduler
+ * (including the owner) takes from the top with a single compare and swap.
+ * The owner taking from the top keeps cthread_yield() round robin, a LIFO pop
+ * from the bottom would resume the thread that just yielded.
+ *
+ * The deque is a ring of cthread pointers, a push fails when the ring is full
+ * and the caller falls back to the local ready queue.
+ */
+
+#define CTHREAD_DEQUE_SIZE 1024 /**< Number of entries in a deque, power of 2 */
+
+/*
+ * define a deque of cthread pointers
+ */
+struct cthread_deque {
+    CNE_ATOMIC(int_least64_t) top;                        /**< Next entry to take */
+    CNE_ATOMIC(int_least64_t) bottom __cne_cache_aligned; /**< Next entry to push */
+    int64_t mask;                                         /**< Ring size - 1 */
+    CNE_ATOMIC(uintptr_t) ring[0] __cne_cache_aligned;    /**< Ring of cthread pointers */
+} __cne_cache_aligned;
+
+/**
+ * Create a work stealing deque
+ *
+ * @return
+ *   NULL on error or pointer to the deque
+ */
+static inline struct cthread_deque *
+_cthread_deque_create(void)
+{
+    struct cthread_deque *dq;
+
+    dq = calloc(1, sizeof(struct cthread_deque) + (CTHREAD_DEQUE_SIZE * sizeof(uintptr_t)));
+    if (!dq)
+        return NULL;
+
+    dq->mask = CTHREAD_DEQUE_SIZE - 1;
+    atomic_init(&dq->top, 0);
+    atomic_init(&dq->bottom, 0);
+
+    return dq;
+}
+
+/**
+ * Return the number of cthreads in the deque, only a hint when read by a peer
+ *
+ * @param dq
+ *   The deque pointer
+ * @return
+ *   The number of entries in the deque
+ */
+static __attribute__((always_inline)) inline int64_t
+_cthread_deque_count(struct cthread_deque *dq)
+{
+    int64_t t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    int64_t b = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+
+    return (b > t) ? (b - t) : 0;
+}
+
+/**
+ * Return true if the deque is empty
+ *
+ * @param dq
+ *   The deque pointer
+ * @return
+ *   true is empty or false if not empty
+ */
+static __attribute__((always_inline)) inline int
+_cthread_deque_empty(struct cthread_deque *dq)
+{
+    return _cthread_deque_count(dq) == 0;
+}
+
+/**
+ * Destroy a deque, fails if the deque is not empty
+ *
+ * @param dq
+ *   The deque pointer
+ * @return
+ *   0 on success or -1 on error
+ */
+static inline int
+_cthread_deque_destroy(struct cthread_deque *dq)
+{
+    if (!dq)
+        return 0;
+
+    if (!_cthread_deque_empty(dq))
+        return -1;
+
+    free(dq);
+    return 0;
+}
+
+/**
+ * Push a cthread on the bottom of the deque, only called by the owning scheduler
+ *
+ * @param dq
+ *   The deque pointer
+ * @param ct
+ *   The cthread pointer to push
+ * @return
+ *   0 on success or -1 if the deque is full
+ */
+static __attribute__((always_inline)) inline int
+_cthread_deque_push(struct cthread_deque *dq, struct cthread *ct)
+{
+    int64_t b = atomic_load_explicit(&dq->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&dq->top, memory_order_acquire);
+
+    if ((b - t) > dq->mask)
+        return -1;
+
+    atomic_store_explicit(&dq->ring[b & dq->mask], (uintptr_t)ct, memory_order_relaxed);
+
+    /* publish the entry before moving bottom */
+    atomic_store_explicit(&dq->bottom, b + 1, memory_order_release);
+
+    return 0;
+}
+
+/**
+ * Take a cthread from the top of the deque, safe for any scheduler to call
+ *
+ * A slot is only reused by the owner after top has moved past it, so losing
+ * the compare and swap means the entry read was already taken by someone else.
+ *
+ * @param dq
+ *   The deque pointer
+ * @return
+ *   NULL if empty or lost the race, otherwise the cthread pointer
+ */
+static __attribute__((always_inline)) inline struct cthread *
+_cthread_deque_take(struct cthread_deque *dq)
+{
+    int64_t t = atomic_load_explicit(&dq->top, memory_order_acquire);
+    int64_t b = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+    uintptr_t ct;
+
+    if (t >= b)
+        return NULL;
+
+    ct = atomic_load_explicit(&dq->ring[t & dq->mask], memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&dq->top, &t, t + 1, memory_order_acq_rel,
+                                                 memory_order_relaxed))
+        return NULL;
+
+    return (struct cthread *)ct;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CTHREAD_DEQUE_H_ */
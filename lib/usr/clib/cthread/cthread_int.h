@@ -55,6 +55,7 @@ struct qnode;
 struct qnode_pool;
 struct cthread_sched;
 struct cthread_tls;
+struct cthread_deque;
 
 #define BIT(x) (1ULL << (x))
 
@@ -95,8 +96,37 @@ struct cthread_sched {
     struct qnode_pool *qnode_pool;              /**< pool of queue nodes */
     struct key_pool *key_pool;                  /**< pool of free TLS keys */
     size_t stack_size;                          /**< Size of the stack per thread */
+    struct cthread_deque *steal;                /**< cthreads peers are allowed to steal */
+    int running;                                /**< scheduler is inside cthread_run() */
+    uint64_t steals;                            /**< cthreads stolen from peers */
+    CNE_ATOMIC(uint_least64_t) stolen;          /**< cthreads stolen by peers */
+    uint64_t steal_misses;                      /**< idle steal passes finding no work */
+    uint64_t migrations;                        /**< cthreads moved by cthread_set_affinity */
+    int epoll_fd;                               /**< epoll fd for cthread_wait_fd(), -1 if unused */
+    int event_fd;                               /**< eventfd used to wake an idle scheduler */
+    uint32_t nb_fd_waiters;                     /**< cthreads parked in cthread_wait_fd() */
+    CNE_ATOMIC(uint_least32_t) sleeping;        /**< scheduler is blocked in epoll_wait() */
+    struct cthread_queue *stack_free;           /**< free mmap stacks owned by this scheduler */
+    CNE_ATOMIC(uint_least32_t) nb_stack_free;   /**< stacks in the stack_free queue */
+    uint64_t stacks_mapped;                     /**< mmap stack reservations created */
+    CNE_ATOMIC(uint_least64_t) stacks_released; /**< stacks freed with MADV_DONTNEED */
+    CNE_ATOMIC(uint_least64_t) stack_hwm;       /**< deepest stack use seen in bytes */
 } __cne_cache_aligned;
 
+/* Set when idle schedulers are allowed to steal ready cthreads from peers */
+extern int _sched_work_steal;
+
+/* Set when exiting cthreads update the stack high water mark of their scheduler */
+extern int _sched_stack_hwm;
+
+/**
+ * Flags for a cthread, kept apart from the state bits
+ */
+enum {
+    CT_FLAG_PINNED      = 0x0001, /**< cthread must not be stolen by a peer scheduler */
+    CT_FLAG_STEAL_DEFER = 0x0002, /**< push to the steal deque once the context is saved */
+};
+
 CNE_DECLARE_PER_THREAD(struct cthread_sched *, this_sched);
 
 /**
@@ -148,9 +178,12 @@ enum join_st {
  * defnition of an cthread stack object
  */
 struct cthread_stack {
-    struct cthread_sched *sched;
-    size_t stack_size;
-    uint8_t stack_start[0];
+    struct cthread_sched *sched; /**< scheduler owning the stack */
+    size_t stack_size;           /**< usable bytes from base to the top of the stack */
+    void *base;                  /**< lowest usable address of the stack */
+    void *map;                   /**< mmap reservation or NULL for an objcache stack */
+    size_t map_size;             /**< size of the mmap reservation */
+    uint8_t stack_start[0] __cne_cache_aligned; /**< keeps the top of the stack 16 byte aligned */
 } __cne_cache_aligned;
 
 /**
@@ -160,6 +193,8 @@ struct cthread {
     struct ctx ctx;                         /**< cpu context */
     int cthread_id;                         /**< thread id value */
     uint64_t state;                         /**< current cthread state */
+    uint32_t flags;                         /**< CT_FLAG_* values */
+    uint32_t revents;                       /**< epoll events seen by cthread_wait_fd() */
     void *private_data;                     /**< Thread private data set by thread */
     void *stack;                            /**< ptr to actual stack */
     size_t stack_size;                      /**< current stack_size */
@@ -173,7 +208,8 @@ struct cthread {
     struct cthread *dt_join;                /**< cthread to join on */
     CNE_ATOMIC(uint_least64_t) join;        /**< state for joining */
     void **dt_exit_ptr;                     /**< exit ptr for cthread_join */
-    struct cthread_sched *sched;            /**< thread was created here*/
+    struct cthread_sched *sched;            /**< thread is running here */
+    struct cthread_sched *home;             /**< thread was created here */
     struct queue_node *qnode;               /**< node when in a queue */
     struct cne_timer tim;                   /**< sleep timer */
     struct cthread_tls *tls;                /**< keys in use by the thread */
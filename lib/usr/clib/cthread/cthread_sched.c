@@ -42,6 +42,8 @@
 #include <fcntl.h>
 #include <sys/time.h>
 #include <sys/mman.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sched.h>
 
 #include <cne.h>
@@ -82,6 +84,10 @@ static cne_spinlock_recursive_t sched_lock;
 static atomic_uint_least16_t num_schedulers;
 static atomic_uint_least16_t active_schedulers;
 static size_t sched_stack_size = CTHREAD_DEFAULT_STACK_SIZE;
+static size_t stack_mmap_size;
+static uint32_t stack_watermark = CTHREAD_STACK_WATERMARK;
+int _sched_work_steal;
+int _sched_stack_hwm;
 
 /* one scheduler per thread */
 CNE_DEFINE_PER_THREAD(struct cthread_sched *, this_sched) = NULL;
@@ -100,6 +106,9 @@ enum sched_alloc_phase {
     SCHED_ALLOC_MUTEX_CACHE,
     SCHED_ALLOC_ONCE_CACHE,
     SCHED_ALLOC_BARRIER_CACHE,
+    SCHED_ALLOC_STEAL_DEQUE,
+    SCHED_ALLOC_POLL,
+    SCHED_ALLOC_STACK_FREE_QUEUE,
 };
 
 void
@@ -116,6 +125,25 @@ cthread_sched_stack_size(void)
     return sched_stack_size;
 }
 
+void
+cthread_sched_stack_mmap_set(size_t reserve_size, uint32_t watermark)
+{
+    stack_mmap_size = reserve_size;
+    stack_watermark = (watermark == 0) ? CTHREAD_STACK_WATERMARK : watermark;
+}
+
+size_t
+cthread_sched_stack_mmap_size(void)
+{
+    return stack_mmap_size;
+}
+
+uint32_t
+cthread_sched_stack_watermark(void)
+{
+    return stack_watermark;
+}
+
 struct cthread_sched *
 cthread_sched_find(int schedid)
 {
@@ -194,6 +222,39 @@ _cthread_set_stack(struct cthread *ct, void *stack, size_t stack_size)
     ct->ctx.rip = (void *)_cthread_exec;
 }
 
+/*
+ * Create the epoll fd used by cthread_wait_fd() and the eventfd peers use to
+ * wake the scheduler when it blocks with nothing to run.
+ */
+static int
+_cthread_poll_init(struct cthread_sched *sched)
+{
+    struct epoll_event ev = {0};
+
+    sched->event_fd = -1;
+    sched->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (sched->epoll_fd < 0)
+        return -1;
+
+    sched->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (sched->event_fd < 0)
+        goto err;
+
+    /* a NULL data pointer marks the wakeup event */
+    ev.events   = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(sched->epoll_fd, EPOLL_CTL_ADD, sched->event_fd, &ev) < 0)
+        goto err;
+
+    return 0;
+err:
+    if (sched->event_fd >= 0)
+        close(sched->event_fd);
+    close(sched->epoll_fd);
+    sched->event_fd = sched->epoll_fd = -1;
+    return -1;
+}
+
 static int
 __sched_alloc_resources(struct cthread_sched *new_sched)
 {
@@ -284,11 +345,38 @@ __sched_alloc_resources(struct cthread_sched *new_sched)
         if (new_sched->once_cache == NULL)
             break;
 
+        /* Initialize per scheduler work stealing deque */
+        alloc_status     = SCHED_ALLOC_STEAL_DEQUE;
+        new_sched->steal = _cthread_deque_create();
+        if (new_sched->steal == NULL)
+            break;
+
+        /* Initialize per scheduler epoll and wakeup eventfd */
+        alloc_status = SCHED_ALLOC_POLL;
+        if (_cthread_poll_init(new_sched) < 0)
+            break;
+
+        /* Initialize per scheduler free mmap stack queue */
+        alloc_status          = SCHED_ALLOC_STACK_FREE_QUEUE;
+        new_sched->stack_free = _cthread_queue_create("stack free queue");
+        if (new_sched->stack_free == NULL)
+            break;
+
         alloc_status = SCHED_ALLOC_OK;
     } while (0);
 
     /* roll back on any failure */
     switch (alloc_status) {
+    case SCHED_ALLOC_STACK_FREE_QUEUE:
+        close(new_sched->event_fd);
+        close(new_sched->epoll_fd);
+    /* fall through */
+    case SCHED_ALLOC_POLL:
+        _cthread_deque_destroy(new_sched->steal);
+    /* fall through */
+    case SCHED_ALLOC_STEAL_DEQUE:
+        _cthread_objcache_destroy(new_sched->once_cache);
+    /* fall through */
     case SCHED_ALLOC_ONCE_CACHE:
         _cthread_objcache_destroy(new_sched->mutex_cache);
     /* fall through */
@@ -330,6 +418,13 @@ __sched_alloc_resources(struct cthread_sched *new_sched)
     return alloc_status;
 }
 
+/* Timer wakeup callback, called by the thread arming a timer on this scheduler */
+static void
+_sched_timer_wakeup(void *arg)
+{
+    _sched_wakeup(arg);
+}
+
 /*
  * Create a scheduler on the current thread
  */
@@ -382,6 +477,9 @@ cthread_sched_create(size_t stack_size)
 
     cne_spinlock_recursive_unlock(&sched_lock);
 
+    /* a timer armed by another thread must wake us up from _cthread_poll() */
+    cne_timer_wakeup_set(_sched_timer_wakeup, new_sched);
+
     cne_compiler_barrier();
 
     return schedid;
@@ -414,8 +512,10 @@ cthread_scheduler_shutdown(int threadid)
 {
     struct cthread_sched *sched = cthread_sched_find(threadid);
 
-    if (sched)
+    if (sched) {
         sched->run_flag = 0;
+        _sched_wakeup(sched);
+    }
 }
 
 /**
@@ -438,6 +538,7 @@ cthread_scheduler_shutdown_all(void)
     cne_spinlock_recursive_lock(&sched_lock);
     STAILQ_FOREACH (sched, &sched_head, next) {
         sched->run_flag = 0;
+        _sched_wakeup(sched);
     }
     cne_spinlock_recursive_unlock(&sched_lock);
 }
@@ -479,7 +580,7 @@ _cthread_resume(struct cthread *ct)
         }
 
         ct->stack_container = s;
-        _cthread_set_stack(ct, &s->stack_start[0], s->stack_size);
+        _cthread_set_stack(ct, s->base, s->stack_size);
 
         ct->state = BIT(CT_STATE_READY);
     }
@@ -499,6 +600,13 @@ _cthread_resume(struct cthread *ct)
 
         /* queue the current thread to the specified queue */
         _cthread_queue_insert_mp(dest, ct);
+        _sched_wakeup(ct->sched);
+    }
+
+    /* the thread yielded and can now be offered to peer schedulers */
+    if (ct->flags & CT_FLAG_STEAL_DEFER) {
+        ct->flags &= ~CT_FLAG_STEAL_DEFER;
+        _steal_queue_insert(ct);
     }
 
     sched->current_cthread = NULL;
@@ -530,13 +638,93 @@ _sched_timer_cb(struct cne_timer *tim, void *arg)
 /*
  * Returns 0 if there is a pending job in scheduler or 1 if done and can exit.
  */
+static inline int
+_cthread_sched_idle(struct cthread_sched *sched)
+{
+    return (_cthread_queue_empty(sched->ready) && _cthread_queue_empty(sched->pready) &&
+            _cthread_deque_empty(sched->steal) && (sched->nb_blocked_threads == 0));
+}
+
+/*
+ * Returns true if a peer scheduler is running and still has cthreads to run.
+ */
+static int
+_cthread_sched_peer_busy(struct cthread_sched *sched)
+{
+    struct cthread_sched *s;
+    int busy = 0;
+
+    /* assume busy when the list is locked, check again on the next pass */
+    if (!cne_spinlock_recursive_trylock(&sched_lock))
+        return 1;
+
+    STAILQ_FOREACH (s, &sched_head, next) {
+        if (s != sched && s->running && (s->current_cthread || !_cthread_sched_idle(s))) {
+            busy = 1;
+            break;
+        }
+    }
+    cne_spinlock_recursive_unlock(&sched_lock);
+
+    return busy;
+}
+
 static inline int
 _cthread_sched_isdone(struct cthread_sched *sched)
 {
     if (sched->run_flag == 0)
         return 1;
-    return (_cthread_queue_empty(sched->ready) && _cthread_queue_empty(sched->pready) &&
-            (sched->nb_blocked_threads == 0));
+    if (!_cthread_sched_idle(sched))
+        return 0;
+
+    /* an idle scheduler stays around to steal while peers have work */
+    return !_sched_work_steal || !_cthread_sched_peer_busy(sched);
+}
+
+/*
+ * Steal one ready cthread from the peer scheduler with the most queued cthreads.
+ * Pinned cthreads found on a peer deque are handed back to that peer.
+ * Returns 0 if no peer had a cthread to steal, 1 otherwise.
+ */
+static int
+_cthread_steal(struct cthread_sched *sched)
+{
+    struct cthread_sched *s, *victim = NULL;
+    struct cthread *ct;
+    int64_t cnt, max = 0;
+
+    /* do not spin on the list lock, try again on the next pass */
+    if (!cne_spinlock_recursive_trylock(&sched_lock))
+        return 1;
+
+    STAILQ_FOREACH (s, &sched_head, next) {
+        if (s == sched || !s->running)
+            continue;
+        cnt = _cthread_deque_count(s->steal);
+        if (cnt > max) {
+            max    = cnt;
+            victim = s;
+        }
+    }
+    cne_spinlock_recursive_unlock(&sched_lock);
+
+    if (!victim || (ct = _cthread_deque_take(victim->steal)) == NULL) {
+        sched->steal_misses++;
+        return 0;
+    }
+
+    if (ct->flags & CT_FLAG_PINNED) {
+        _cthread_queue_insert_mp(victim->pready, ct);
+        _sched_wakeup(victim);
+        return 1;
+    }
+
+    atomic_fetch_add(&victim->stolen, 1);
+    sched->steals++;
+
+    ct->sched = sched;
+    _cthread_resume(ct);
+    return 1;
 }
 
 /*
@@ -574,6 +762,80 @@ _cthread_schedulers_sync_stop(void)
         sched_yield();
 }
 
+/*
+ * Returns true if the scheduler has cthreads ready to run.
+ */
+static inline int
+_cthread_sched_runnable(struct cthread_sched *sched)
+{
+    return !(_cthread_queue_empty(sched->ready) && _cthread_queue_empty(sched->pready) &&
+             _cthread_deque_empty(sched->steal));
+}
+
+#define POLL_EVENTS_MAX 32
+#define STEAL_PARK_MS   1 /* Max sleep of an idle scheduler before stealing again */
+/*
+ * Poll the scheduler epoll fd and resume the cthreads whose fds are ready.
+ * With block set the scheduler has nothing to run and sleeps in epoll_wait()
+ * until an fd is ready, a peer queues a cthread or the next timer is due.
+ * A max_ms of zero or more limits the sleep, peers do not wake a scheduler
+ * when they offer cthreads to be stolen.
+ */
+static void
+_cthread_poll(struct cthread_sched *sched, int block, int max_ms)
+{
+    struct epoll_event events[POLL_EVENTS_MAX];
+    int timeout = 0, n;
+    uint64_t v;
+
+    if (block) {
+        uint64_t ms_ticks = cne_get_timer_hz() / 1000;
+        int64_t ticks;
+
+        atomic_store(&sched->sleeping, 1);
+
+        /*
+         * pairs with _sched_wakeup(), check the peer queue and the timers after
+         * sleeping is set so a cthread or timer a peer adds now wakes us up.
+         */
+        atomic_thread_fence(memory_order_seq_cst);
+        ticks = cne_timer_next_ticks();
+
+        /* wake up early rather than late, spin for the last millisecond */
+        if (ticks < 0)
+            timeout = -1;
+        else if (ms_ticks && (uint64_t)ticks >= ms_ticks)
+            timeout = (int)CNE_MIN((uint64_t)ticks / ms_ticks, (uint64_t)INT_MAX);
+
+        if (max_ms >= 0 && (timeout < 0 || timeout > max_ms))
+            timeout = max_ms;
+
+        if (!_cthread_queue_empty(sched->pready) || !sched->run_flag)
+            timeout = 0;
+    }
+
+    n = epoll_wait(sched->epoll_fd, events, POLL_EVENTS_MAX, timeout);
+
+    if (block)
+        atomic_store(&sched->sleeping, 0);
+
+    for (int i = 0; i < n; i++) {
+        struct cthread *ct = events[i].data.ptr;
+
+        if (!ct) {
+            if (read(sched->event_fd, &v, sizeof(v)) < 0) {
+                /* eventfd already drained */
+            }
+            continue;
+        }
+
+        /* stop the timeout timer before the cthread runs again */
+        _timer_stop(ct);
+        ct->revents = events[i].events;
+        _cthread_resume(ct);
+    }
+}
+
 #define POLL_TIMER_VALUE 512
 /*
  * Run the cthread scheduler
@@ -588,6 +850,8 @@ cthread_run(void)
     if (!sched)
         return;
 
+    sched->running = 1;
+
     /* if more than one, wait for all schedulers to start */
     _cthread_schedulers_sync_start();
 
@@ -603,16 +867,42 @@ cthread_run(void)
      */
     cnt = POLL_TIMER_VALUE;
     while (!_cthread_sched_isdone(sched)) {
+        struct cthread *ct;
+
         if (--cnt == 0) {
             cne_timer_manage();
+            if (sched->nb_fd_waiters)
+                _cthread_poll(sched, 0, -1);
             cnt = POLL_TIMER_VALUE;
         }
 
         _cthread_resume(_cthread_queue_poll(sched->ready));
 
         _cthread_resume(_cthread_queue_poll(sched->pready));
+
+        /* the owner takes from its own deque the same way a peer does */
+        ct = _cthread_deque_take(sched->steal);
+        if (ct)
+            _cthread_resume(ct);
+        else if (!_cthread_sched_runnable(sched)) {
+            if (_sched_work_steal) {
+                /* nothing found to steal, park for a short time instead of spinning */
+                if (!_cthread_steal(sched)) {
+                    cne_timer_manage();
+                    if (!_cthread_sched_runnable(sched))
+                        _cthread_poll(sched, 1, STEAL_PARK_MS);
+                }
+            } else if (sched->nb_blocked_threads) {
+                /* nothing to run, run due timers and sleep until woken */
+                cne_timer_manage();
+                if (!_cthread_sched_runnable(sched))
+                    _cthread_poll(sched, 1, -1);
+            }
+        }
     }
 
+    sched->running = 0;
+
     /* if more than one wait for all schedulers to stop */
     _cthread_schedulers_sync_stop();
 
@@ -633,6 +923,7 @@ cthread_set_affinity(int threadid)
         return POSIX_ERRNO(EINVAL);
 
     if (likely(dest_sched != THIS_SCHED)) {
+        (THIS_SCHED)->migrations++;
         ct->sched            = dest_sched;
         ct->pending_wr_queue = dest_sched->pready;
         _affinitize();
@@ -641,6 +932,85 @@ cthread_set_affinity(int threadid)
     return 0;
 }
 
+/*
+ * Enable or disable work stealing between schedulers
+ */
+void
+cthread_work_steal_set(int enable)
+{
+    _sched_work_steal = !!enable;
+}
+
+int
+cthread_work_steal_get(void)
+{
+    return _sched_work_steal;
+}
+
+/*
+ * Enable or disable the stack high water mark scan on cthread exit
+ */
+void
+cthread_stack_hwm_set(int enable)
+{
+    _sched_stack_hwm = !!enable;
+}
+
+int
+cthread_stack_hwm_get(void)
+{
+    return _sched_stack_hwm;
+}
+
+/*
+ * Pin or unpin a cthread to the scheduler it is running on
+ */
+int
+cthread_set_pinned(struct cthread *c, int pinned)
+{
+    if (!c)
+        c = THIS_CTHREAD;
+    if (!c)
+        return -1;
+
+    if (pinned)
+        c->flags |= CT_FLAG_PINNED;
+    else
+        c->flags &= ~CT_FLAG_PINNED;
+    return 0;
+}
+
+int
+cthread_is_pinned(struct cthread *c)
+{
+    if (!c)
+        c = THIS_CTHREAD;
+    return (c) ? !!(c->flags & CT_FLAG_PINNED) : 0;
+}
+
+/*
+ * Return the work stealing, migration and stack counters of a scheduler
+ */
+int
+cthread_sched_stats(struct cthread_sched *s, struct cthread_sched_stats *st)
+{
+    if (!s)
+        s = THIS_SCHED;
+    if (!s || !st)
+        return -1;
+
+    st->steals       = s->steals;
+    st->stolen       = atomic_load(&s->stolen);
+    st->steal_misses = s->steal_misses;
+    st->migrations   = s->migrations;
+
+    st->stacks_mapped   = s->stacks_mapped;
+    st->stacks_released = atomic_load(&s->stacks_released);
+    st->stack_hwm       = atomic_load(&s->stack_hwm);
+
+    return 0;
+}
+
 /* constructor */
 CNE_INIT_PRIO(_sched_ctor, THREAD)
 {
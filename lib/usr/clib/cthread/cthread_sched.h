@@ -33,10 +33,35 @@
 #ifndef _CTHREAD_SCHED_H_
 #define _CTHREAD_SCHED_H_
 
+#include <unistd.h>
+
+#include "cthread_deque.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Wake up a scheduler blocked in epoll_wait() waiting for work
+ *
+ * @param sched
+ *   The scheduler pointer
+ */
+static inline void
+_sched_wakeup(struct cthread_sched *sched)
+{
+    uint64_t v = 1;
+
+    /* pairs with the fence in _cthread_poll() between setting sleeping and
+     * checking the queues, one side always sees the other.
+     */
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&sched->sleeping, memory_order_relaxed) &&
+        write(sched->event_fd, &v, sizeof(v)) < 0) {
+        /* the eventfd counter is already non-zero */
+    }
+}
+
 /**
  * insert an cthread into a queue
  *
@@ -50,8 +75,38 @@ _ready_queue_insert(struct cthread_sched *sched, struct cthread *ct)
 {
     if (sched == THIS_SCHED)
         _cthread_queue_insert_sp((THIS_SCHED)->ready, ct);
-    else
+    else {
         _cthread_queue_insert_mp(sched->pready, ct);
+        _sched_wakeup(sched);
+    }
+}
+
+/**
+ * Return true if the cthread can be handed to the steal deque
+ *
+ * @param ct
+ *   The cthread pointer
+ * @return
+ *   true if peers are allowed to steal the thread or false if not
+ */
+static inline int
+_stealable(struct cthread *ct)
+{
+    return _sched_work_steal && !(ct->flags & CT_FLAG_PINNED);
+}
+
+/**
+ * insert a cthread that is not running into the current scheduler's steal deque,
+ * the local ready queue is used when stealing is off or the deque is full.
+ *
+ * @param ct
+ *   The cthread pointer to insert
+ */
+static inline void
+_steal_queue_insert(struct cthread *ct)
+{
+    if (!_stealable(ct) || _cthread_deque_push((THIS_SCHED)->steal, ct) < 0)
+        _cthread_queue_insert_sp((THIS_SCHED)->ready, ct);
 }
 
 /**
@@ -121,7 +176,13 @@ static inline void __attribute__((always_inline)) _reschedule(void)
 {
     struct cthread *ct = THIS_CTHREAD;
 
-    _ready_queue_insert(THIS_SCHED, ct);
+    /* a peer could resume the thread before its context is saved,
+     * so the push to the steal deque is deferred to _cthread_resume()
+     */
+    if (_stealable(ct))
+        ct->flags |= CT_FLAG_STEAL_DEFER;
+    else
+        _ready_queue_insert(THIS_SCHED, ct);
     cthread_switch(&(THIS_SCHED)->ctx, &ct->ctx);
 }
 
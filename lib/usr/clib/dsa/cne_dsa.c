@@ -16,6 +16,7 @@
 #include <limits.h>                       // for PATH_MAX
 #include <stdlib.h>                       // for free, calloc, aligned_alloc
 #include <unistd.h>                       // for close
+#include <emmintrin.h>                    // for _mm_cmpeq_epi16, _mm_movemask_epi8
 #include <xmmintrin.h>                    // IWYU pragma: keep
 
 #include "cne_dsa.h"
@@ -28,14 +29,12 @@ static pthread_mutex_t dsa_devs_lock = PTHREAD_MUTEX_INITIALIZER;
 
 #define DSA_DEV(i) ((i) < MAX_DSA_DEVICES ? dsa_devs[i] : NULL)
 
-uint16_t
-dsa_burst_capacity(uint16_t dev)
+#define DSA_HDL_SCAN 8 /* handle flags checked at once by dsa_completed_ops() */
+
+static inline uint16_t
+__idxd_burst_capacity(struct dsa *idxd)
 {
     uint16_t write_idx, used_space, free_space;
-    struct dsa *idxd = DSA_DEV(dev);
-
-    if (!idxd)
-        return 0;
 
     write_idx = idxd->batch_start + idxd->batch_size;
 
@@ -58,28 +57,31 @@ dsa_burst_capacity(uint16_t dev)
     return free_space - 2;
 }
 
+uint16_t
+dsa_burst_capacity(uint16_t dev)
+{
+    struct dsa *idxd = DSA_DEV(dev);
+
+    if (!idxd)
+        return 0;
+
+    return __idxd_burst_capacity(idxd);
+}
+
 static inline uint64_t
 __desc_idx_to_iova(struct dsa *idxd, uint16_t n)
 {
     return idxd->desc_iova + (n * sizeof(struct idxd_hw_desc));
 }
 
-static inline int
-__idxd_write_desc(struct dsa *idxd, const uint32_t op_flags, const uint64_t src, const uint64_t dst,
-                  const uint32_t size, const struct dsa_user_hdl *hdl)
+/* Write a descriptor, the caller checked the rings have space for it */
+static inline void
+__idxd_fill_desc(struct dsa *idxd, const uint32_t op_flags, const uint64_t src, const uint64_t dst,
+                 const uint32_t size, const struct dsa_user_hdl *hdl, const uint16_t hdl_flag)
 {
     uint16_t write_idx = idxd->batch_start + idxd->batch_size;
     uint16_t mask      = idxd->desc_ring_mask;
 
-    /* first check batch ring space then desc ring space */
-    if ((idxd->batch_idx_read == 0 && idxd->batch_idx_write == idxd->max_batches) ||
-        idxd->batch_idx_write + 1 == idxd->batch_idx_read)
-        goto failed;
-
-    /* for descriptor ring, we always need a slot for batch completion */
-    if (((write_idx + 2) & mask) == idxd->hdls_read || ((write_idx + 1) & mask) == idxd->hdls_read)
-        goto failed;
-
     /* write desc and handle. Note, descriptors don't wrap */
     idxd->desc_ring[write_idx].pasid      = 0;
     idxd->desc_ring[write_idx].op_flags   = op_flags | IDXD_FLAG_COMPLETION_ADDR_VALID;
@@ -89,7 +91,7 @@ __idxd_write_desc(struct dsa *idxd, const uint32_t op_flags, const uint64_t src,
     idxd->desc_ring[write_idx].size       = size;
 
     if (!hdl)
-        idxd->hdl_ring_flags[write_idx & mask] = DSA_HDL_INVALID;
+        idxd->hdl_ring_flags[write_idx & mask] = hdl_flag;
     else
         idxd->hdl_ring[write_idx & mask] = *hdl;
     idxd->batch_size++;
@@ -97,6 +99,25 @@ __idxd_write_desc(struct dsa *idxd, const uint32_t op_flags, const uint64_t src,
     idxd->stats.enqueued++;
 
     cne_prefetch0(&idxd->desc_ring[write_idx + 1]);
+}
+
+static inline int
+__idxd_write_desc(struct dsa *idxd, const uint32_t op_flags, const uint64_t src, const uint64_t dst,
+                  const uint32_t size, const struct dsa_user_hdl *hdl)
+{
+    uint16_t write_idx = idxd->batch_start + idxd->batch_size;
+    uint16_t mask      = idxd->desc_ring_mask;
+
+    /* first check batch ring space then desc ring space */
+    if ((idxd->batch_idx_read == 0 && idxd->batch_idx_write == idxd->max_batches) ||
+        idxd->batch_idx_write + 1 == idxd->batch_idx_read)
+        goto failed;
+
+    /* for descriptor ring, we always need a slot for batch completion */
+    if (((write_idx + 2) & mask) == idxd->hdls_read || ((write_idx + 1) & mask) == idxd->hdls_read)
+        goto failed;
+
+    __idxd_fill_desc(idxd, op_flags, src, dst, size, hdl, DSA_HDL_INVALID);
     return 1;
 
 failed:
@@ -137,6 +158,92 @@ dsa_enqueue_copy(uint16_t dev, phys_addr_t src, phys_addr_t dst, uint32_t length
                              src, dst, length, &hdl);
 }
 
+uint16_t
+dsa_enqueue_copy_burst(uint16_t dev, const struct dsa_burst_op *ops, uint16_t nb_ops)
+{
+    struct dsa *idxd = DSA_DEV(dev);
+    uint16_t i, n;
+
+    if (!idxd) {
+        errno = ENODEV;
+        return 0;
+    }
+
+    if (!ops) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    n = CNE_MIN(nb_ops, __idxd_burst_capacity(idxd));
+    for (i = 0; i < n; i++) {
+        const struct dsa_user_hdl hdl = {.src = ops[i].src_hdl, .dst = ops[i].dst_hdl};
+
+        __idxd_fill_desc(idxd, (idxd_op_memmove << IDXD_CMD_OP_SHIFT) | IDXD_FLAG_CACHE_CONTROL,
+                         ops[i].src, ops[i].dst, ops[i].length, &hdl, DSA_HDL_NORMAL);
+    }
+
+    if (n < nb_ops) {
+        idxd->stats.enqueue_failed += nb_ops - n;
+        errno = ENOSPC;
+    }
+    return n;
+}
+
+/* Copy between a buffer and the data of the mbufs, only the last descriptor has the handles */
+static int
+__idxd_write_mbufs(uint16_t dev, pktmbuf_t **mbufs, uint16_t nb_mbufs, phys_addr_t buf,
+                   bool gather, const struct dsa_user_hdl *hdl)
+{
+    struct dsa *idxd = DSA_DEV(dev);
+    uint16_t i;
+
+    if (!idxd) {
+        errno = ENODEV;
+        return 0;
+    }
+
+    if (!mbufs || nb_mbufs == 0) {
+        errno = EINVAL;
+        return 0;
+    }
+
+    if (__idxd_burst_capacity(idxd) < nb_mbufs) {
+        idxd->stats.enqueue_failed++;
+        errno = ENOSPC;
+        return 0;
+    }
+
+    for (i = 0; i < nb_mbufs; i++) {
+        uint64_t data = pktmbuf_mtod(mbufs[i], uintptr_t);
+        uint32_t len  = pktmbuf_data_len(mbufs[i]);
+
+        __idxd_fill_desc(idxd, (idxd_op_memmove << IDXD_CMD_OP_SHIFT) | IDXD_FLAG_CACHE_CONTROL,
+                         gather ? data : buf, gather ? buf : data, len,
+                         (i == nb_mbufs - 1) ? hdl : NULL, DSA_HDL_GROUP);
+        buf += len;
+    }
+
+    return 1;
+}
+
+int
+dsa_enqueue_gather(uint16_t dev, pktmbuf_t **mbufs, uint16_t nb_mbufs, phys_addr_t dst,
+                   uintptr_t src_hdl, uintptr_t dst_hdl)
+{
+    const struct dsa_user_hdl hdl = {.src = src_hdl, .dst = dst_hdl};
+
+    return __idxd_write_mbufs(dev, mbufs, nb_mbufs, dst, true, &hdl);
+}
+
+int
+dsa_enqueue_scatter(uint16_t dev, phys_addr_t src, pktmbuf_t **mbufs, uint16_t nb_mbufs,
+                    uintptr_t src_hdl, uintptr_t dst_hdl)
+{
+    const struct dsa_user_hdl hdl = {.src = src_hdl, .dst = dst_hdl};
+
+    return __idxd_write_mbufs(dev, mbufs, nb_mbufs, src, false, &hdl);
+}
+
 /* Used by dsa_fence() and dsa_perform_ops() after validating dsa param */
 static inline int
 __idxd_fence(struct dsa *idxd)
@@ -213,7 +320,8 @@ dsa_completed_ops(uint16_t dev, uint8_t max_ops, uint32_t *status, uint8_t *num_
                   uintptr_t *src_hdls, uintptr_t *dst_hdls)
 {
     struct dsa *idxd = DSA_DEV(dev);
-    uint16_t n, h_idx;
+    uint16_t n, h_idx, contig;
+    uint8_t grp_err;
 
     if (!idxd) {
         errno = ENODEV;
@@ -243,15 +351,28 @@ dsa_completed_ops(uint16_t dev, uint8_t max_ops, uint32_t *status, uint8_t *num_
                 batch_end += idxd->desc_ring_mask + 1;
 
             /* go through each batch entry and see status */
-            for (n = 0; n < desc_count; n++) {
+            for (n = 0, grp_err = 0; n < desc_count; n++) {
                 uint16_t idx = (batch_start + n) & idxd->desc_ring_mask;
                 volatile struct idxd_completion *comp =
                     (struct idxd_completion *)&idxd->desc_ring[idx];
+                uint16_t flag = idxd->hdl_ring_flags[idx];
+                uint8_t err   = comp->status;
+
+                comp->status = 0; /* clear error for next time */
 
-                if (comp->status != 0 && idxd->hdl_ring_flags[idx] == DSA_HDL_NORMAL) {
+                /* an error in a gather or scatter fails the op holding its handles */
+                if (flag == DSA_HDL_GROUP) {
+                    if (!grp_err)
+                        grp_err = err;
+                    continue;
+                }
+                if (!err)
+                    err = grp_err;
+                grp_err = 0;
+
+                if (err && flag == DSA_HDL_NORMAL) {
                     idxd->hdl_ring_flags[idx] = DSA_HDL_OP_FAILED;
-                    idxd->hdl_ring_flags[idx] |= (comp->status << 8);
-                    comp->status = 0; /* clear error for next time */
+                    idxd->hdl_ring_flags[idx] |= (err << 8);
                 }
             }
 
@@ -273,10 +394,30 @@ dsa_completed_ops(uint16_t dev, uint8_t max_ops, uint32_t *status, uint8_t *num_
 
     n     = 0;
     h_idx = idxd->hdls_read;
-    while (h_idx != idxd->hdls_avail) {
-        uint16_t flag = idxd->hdl_ring_flags[h_idx];
+    while (h_idx != idxd->hdls_avail && n < max_ops) {
+        uint16_t flag;
+
+        /* Fast path, when the flags of the next handles are all normal the ops succeeded */
+        contig = (idxd->hdls_avail > h_idx) ? idxd->hdls_avail - h_idx
+                                            : idxd->desc_ring_mask + 1 - h_idx;
+        if (contig >= DSA_HDL_SCAN && n + DSA_HDL_SCAN <= max_ops) {
+            __m128i flags = _mm_loadu_si128((const __m128i *)&idxd->hdl_ring_flags[h_idx]);
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(flags, _mm_setzero_si128())) == 0xFFFF) {
+                for (int i = 0; i < DSA_HDL_SCAN; i++) {
+                    if (src_hdls)
+                        src_hdls[n + i] = idxd->hdl_ring[h_idx + i].src;
+                    if (dst_hdls)
+                        dst_hdls[n + i] = idxd->hdl_ring[h_idx + i].dst;
+                }
+                n += DSA_HDL_SCAN;
+                h_idx = (h_idx + DSA_HDL_SCAN) & idxd->desc_ring_mask;
+                continue;
+            }
+        }
 
-        if (flag != DSA_HDL_INVALID) {
+        flag = idxd->hdl_ring_flags[h_idx];
+        if (flag != DSA_HDL_INVALID && flag != DSA_HDL_GROUP) {
             if (src_hdls)
                 src_hdls[n] = idxd->hdl_ring[h_idx].src;
 
@@ -300,8 +441,6 @@ dsa_completed_ops(uint16_t dev, uint8_t max_ops, uint32_t *status, uint8_t *num_
         idxd->hdl_ring_flags[h_idx] = DSA_HDL_NORMAL;
         if (++h_idx > idxd->desc_ring_mask)
             h_idx = 0;
-        if (n >= max_ops)
-            break;
     }
 
     /* skip over any remaining blank elements, e.g. batch completion */
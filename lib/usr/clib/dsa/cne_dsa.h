@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 #include <cne_common.h>
+#include <pktmbuf.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,6 +30,15 @@ extern "C" {
 #define DSA_OP_INVALID_LEN      0x13 /**< Invalid/too big length field passed */
 #define DSA_OP_OVERLAPPING_BUFS 0x16 /**< Overlapping buffers error */
 
+/** A copy operation of a burst, see dsa_enqueue_copy_burst() */
+struct dsa_burst_op {
+    phys_addr_t src;   /**< The address of the source buffer */
+    phys_addr_t dst;   /**< The address of the destination buffer */
+    uint32_t length;   /**< The length of the data to copy */
+    uintptr_t src_hdl; /**< Source handle returned by dsa_completed_ops() */
+    uintptr_t dst_hdl; /**< Destination handle returned by dsa_completed_ops() */
+};
+
 /** The structure populated by dsa_get_stats() function. */
 struct dsa_stats {
     uint64_t enqueue_failed; /**< failed enqueue operations */
@@ -128,6 +138,78 @@ CNDP_API int dsa_enqueue_fill(uint16_t dev, uint64_t pattern, phys_addr_t dst, u
 CNDP_API int dsa_enqueue_copy(uint16_t dev, phys_addr_t src, phys_addr_t dst, uint32_t length,
                               uintptr_t src_hdl, uintptr_t dst_hdl);
 
+/**
+ * Enqueue a burst of copy operations onto the device
+ *
+ * The descriptors are written after a single check of the ring space, which is cheaper
+ * than calling dsa_enqueue_copy() for each copy. Like the other enqueue functions the
+ * hardware is not triggered, the copies are part of the batch submitted by the next
+ * dsa_perform_ops() call.
+ *
+ * @param dev
+ *   The dsa device id returned by dsa_open()
+ * @param ops
+ *   The array of copy operations
+ * @param nb_ops
+ *   The number of operations in the array
+ * @return
+ *   Number of operations enqueued, which is less than nb_ops when the ring is full
+ */
+CNDP_API uint16_t dsa_enqueue_copy_burst(uint16_t dev, const struct dsa_burst_op *ops,
+                                         uint16_t nb_ops);
+
+/**
+ * Enqueue the copy of the data of several mbufs into a contiguous buffer
+ *
+ * One descriptor is written per mbuf, with the data of the mbufs copied back to back
+ * into dst. The whole gather is reported as one operation by dsa_completed_ops(), with
+ * the given handles, and fails if any of its copies fails.
+ *
+ * @param dev
+ *   The dsa device id returned by dsa_open()
+ * @param mbufs
+ *   The array of mbufs to copy the data from
+ * @param nb_mbufs
+ *   The number of mbufs in the array
+ * @param dst
+ *   The address of the destination buffer, large enough for the data of all the mbufs
+ * @param src_hdl
+ *   An opaque handle returned when the gather has been completed
+ * @param dst_hdl
+ *   An opaque handle returned when the gather has been completed
+ * @return
+ *   Number of operations enqueued, either 0 or 1. Nothing is enqueued if the ring does
+ *   not have a descriptor for each mbuf.
+ */
+CNDP_API int dsa_enqueue_gather(uint16_t dev, pktmbuf_t **mbufs, uint16_t nb_mbufs,
+                                phys_addr_t dst, uintptr_t src_hdl, uintptr_t dst_hdl);
+
+/**
+ * Enqueue the copy of a contiguous buffer into the data of several mbufs
+ *
+ * The data length of each mbuf gives the number of bytes copied into it, the mbufs are
+ * filled in order from src. The whole scatter is reported as one operation by
+ * dsa_completed_ops(), with the given handles, and fails if any of its copies fails.
+ *
+ * @param dev
+ *   The dsa device id returned by dsa_open()
+ * @param src
+ *   The address of the source buffer
+ * @param mbufs
+ *   The array of mbufs to copy the data to
+ * @param nb_mbufs
+ *   The number of mbufs in the array
+ * @param src_hdl
+ *   An opaque handle returned when the scatter has been completed
+ * @param dst_hdl
+ *   An opaque handle returned when the scatter has been completed
+ * @return
+ *   Number of operations enqueued, either 0 or 1. Nothing is enqueued if the ring does
+ *   not have a descriptor for each mbuf.
+ */
+CNDP_API int dsa_enqueue_scatter(uint16_t dev, phys_addr_t src, pktmbuf_t **mbufs,
+                                 uint16_t nb_mbufs, uintptr_t src_hdl, uintptr_t dst_hdl);
+
 /**
  * Add a fence to force ordering between operations
  *
@@ -149,7 +231,9 @@ CNDP_API int dsa_fence(uint16_t dev);
  * Trigger hardware to begin performing enqueued operations
  *
  * This API is used to write the "doorbell" to the hardware to trigger it
- * to begin the operations previously enqueued by dsa_enqueue_*()
+ * to begin the operations previously enqueued by dsa_enqueue_*(). All the
+ * operations enqueued since the last call are submitted as one batch
+ * descriptor, i.e. a single write to the work queue portal.
  *
  * @param dev
  *   The dsa device id returned by dsa_open()
@@ -0,0 +1,258 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <errno.h>                        // for errno, EINVAL
+#include <stdint.h>                       // for uint32_t, uint16_t, uintptr_t
+#include <stdlib.h>                       // for calloc, free
+#include <string.h>                       // for memcpy
+#include <cne_common.h>                   // for CNE_MIN
+#include <cne_branch_prediction.h>        // for unlikely
+#include <cne_log.h>                      // for CNE_NULL_RET, CNE_ERR_RET
+#include <cne_pause.h>                    // for cne_pause
+#include <pktmbuf.h>                      // for pktmbuf_alloc, pktmbuf_mtod
+
+#include "cne_dsa.h"
+#include "dsa_copy.h"
+
+struct dsa_copy {
+    int16_t dev;                 /**< DSA device id */
+    uint16_t burst;              /**< Copies queued before ringing the doorbell */
+    uint16_t batched;            /**< Copies queued since the last submit */
+    uint32_t threshold;          /**< Smaller copies are done by the CPU */
+    uint32_t pending;            /**< Queued copies not completed */
+    struct dsa_copy_stats stats; /**< Counters of the engine */
+};
+
+dsa_copy_t *
+dsa_copy_create(const char *name, uint32_t threshold, uint16_t burst)
+{
+    dsa_copy_t *dc;
+
+    dc = calloc(1, sizeof(dsa_copy_t));
+    if (!dc)
+        CNE_NULL_RET("Unable to allocate copy engine\n");
+
+    dc->dev = dsa_open(name);
+    if (dc->dev < 0) {
+        free(dc);
+        CNE_NULL_RET("Unable to open DSA device %s\n", name ? name : "(software)");
+    }
+
+    dc->threshold = (threshold) ? threshold : DSA_COPY_DEFAULT_THRESHOLD;
+    dc->burst     = (burst) ? burst : DSA_COPY_DEFAULT_BURST;
+
+    return dc;
+}
+
+void
+dsa_copy_destroy(dsa_copy_t *dc)
+{
+    if (!dc)
+        return;
+
+    dsa_copy_wait(dc);
+    dsa_close(dc->dev);
+    free(dc);
+}
+
+int
+dsa_copy_submit(dsa_copy_t *dc)
+{
+    if (!dc)
+        CNE_ERR_RET("Copy engine is NULL\n");
+
+    if (dc->batched == 0)
+        return 0;
+
+    if (dsa_perform_ops(dc->dev) < 0)
+        CNE_ERR_RET("dsa_perform_ops() failed\n");
+    dc->batched = 0;
+    dc->stats.batches++;
+
+    return 0;
+}
+
+int
+dsa_copy_poll(dsa_copy_t *dc, uint16_t max)
+{
+    uint32_t status[DSA_COPY_POLL_MAX] = {0};
+    uintptr_t cbs[DSA_COPY_POLL_MAX], args[DSA_COPY_POLL_MAX];
+    uint8_t nb_failed;
+    int n;
+
+    if (!dc)
+        CNE_ERR_RET("Copy engine is NULL\n");
+
+    if (dc->pending == 0)
+        return 0;
+
+    /* The handles of a copy are its callback and argument */
+    n = dsa_completed_ops(dc->dev, CNE_MIN(max, DSA_COPY_POLL_MAX), status, &nb_failed, cbs,
+                          args);
+    if (n <= 0)
+        return n;
+
+    dc->pending -= n;
+    dc->stats.failed += nb_failed;
+
+    for (int i = 0; i < n; i++) {
+        dsa_copy_cb cb = (dsa_copy_cb)cbs[i];
+
+        if (cb)
+            cb((void *)args[i], status[i]);
+    }
+
+    return n;
+}
+
+int
+dsa_copy_wait(dsa_copy_t *dc)
+{
+    uint64_t failed;
+
+    if (!dc)
+        CNE_ERR_RET("Copy engine is NULL\n");
+
+    failed = dc->stats.failed;
+
+    if (dsa_copy_submit(dc) < 0)
+        return -1;
+
+    while (dc->pending) {
+        if (dsa_copy_poll(dc, DSA_COPY_POLL_MAX) < 0)
+            return -1;
+        cne_pause();
+    }
+
+    return (int)(dc->stats.failed - failed);
+}
+
+int
+dsa_copy(dsa_copy_t *dc, void *dst, const void *src, uint32_t len, dsa_copy_cb cb, void *arg)
+{
+    if (unlikely(!dc || !dst || !src))
+        CNE_ERR_RET("Invalid copy engine or buffers\n");
+
+    if (len < dc->threshold) {
+        memcpy(dst, src, len);
+        dc->stats.cpu_copies++;
+        dc->stats.cpu_bytes += len;
+        return 0;
+    }
+
+    /* Apply back-pressure when the ring is full, the copies stay in order */
+    if (unlikely(dsa_burst_capacity(dc->dev) == 0)) {
+        dc->stats.full++;
+        if (dsa_copy_wait(dc) < 0)
+            return -1;
+    }
+
+    if (dsa_enqueue_copy(dc->dev, (uintptr_t)src, (uintptr_t)dst, len, (uintptr_t)cb,
+                         (uintptr_t)arg) != 1)
+        CNE_ERR_RET("dsa_enqueue_copy() failed\n");
+
+    dc->pending++;
+    dc->stats.dev_copies++;
+    dc->stats.dev_bytes += len;
+
+    if (++dc->batched >= dc->burst && dsa_copy_submit(dc) < 0)
+        return -1;
+
+    return 1;
+}
+
+int
+dsa_copy_fence(dsa_copy_t *dc)
+{
+    if (!dc)
+        CNE_ERR_RET("Copy engine is NULL\n");
+
+    /* Nothing queued, the copies done so far are completed */
+    if (dc->pending == 0)
+        return 0;
+
+    if (dsa_fence(dc->dev) != 1)
+        CNE_ERR_RET("dsa_fence() failed\n");
+    dc->batched++;
+    dc->stats.fences++;
+
+    return 0;
+}
+
+uint32_t
+dsa_copy_pending(dsa_copy_t *dc)
+{
+    return (dc) ? dc->pending : 0;
+}
+
+int
+dsa_copy_stats_get(dsa_copy_t *dc, struct dsa_copy_stats *stats)
+{
+    if (!dc || !stats)
+        CNE_ERR_RET("Invalid copy engine or stats pointer\n");
+
+    *stats = dc->stats;
+
+    return 0;
+}
+
+static int
+lport_copy_start(void *arg, void *dst, const void *src, uint32_t len)
+{
+    return dsa_copy(arg, dst, src, len, NULL, NULL);
+}
+
+static int
+lport_copy_wait(void *arg)
+{
+    return dsa_copy_wait(arg);
+}
+
+int
+dsa_copy_lport_ops(dsa_copy_t *dc, lport_copy_ops_t *ops)
+{
+    if (!dc || !ops)
+        CNE_ERR_RET("Invalid copy engine or ops pointer\n");
+
+    ops->copy_start = lport_copy_start;
+    ops->copy_wait  = lport_copy_wait;
+    ops->copy_arg   = dc;
+
+    return 0;
+}
+
+int
+dsa_copy_pktmbuf(dsa_copy_t *dc, const pktmbuf_t *m, pktmbuf_info_t *pi, uint32_t off,
+                 uint32_t len, pktmbuf_t **mc, dsa_copy_cb cb, void *arg)
+{
+    pktmbuf_t *n;
+    int ret;
+
+    if (!dc || !m || !mc)
+        CNE_ERR_RET("Invalid copy engine or mbuf pointers\n");
+
+    if (unlikely(off > pktmbuf_data_len(m)))
+        CNE_ERR_RET("Offset %u is past the data of the mbuf\n", off);
+
+    n = pktmbuf_alloc(pi);
+    if (unlikely(n == NULL))
+        return -1;
+
+    __pktmbuf_copy_hdr(n, m);
+
+    /* truncate requested length to the data and the room of the new mbuf */
+    len = CNE_MIN(len, (uint32_t)pktmbuf_data_len(m) - off);
+    len = CNE_MIN(len, (uint32_t)pktmbuf_tailroom(n));
+
+    ret = dsa_copy(dc, pktmbuf_mtod(n, void *), pktmbuf_mtod_offset(m, void *, off), len, cb,
+                   arg);
+    if (ret < 0) {
+        pktmbuf_free(n);
+        return -1;
+    }
+    pktmbuf_data_len(n) = len;
+    *mc                 = n;
+
+    return ret;
+}
@@ -0,0 +1,219 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _DSA_COPY_H_
+#define _DSA_COPY_H_
+
+/**
+ * @file
+ *
+ * Asynchronous copy engine on top of a DSA device.
+ *
+ * Copies smaller than the threshold of the engine are done by the CPU with memcpy(), larger
+ * copies are queued to the device and the doorbell is rung every burst copies or when the
+ * copies are submitted. The completion of a queued copy is reported by dsa_copy_poll() to
+ * the callback given with the copy, in the order the copies were queued.
+ *
+ * When no DSA work queue can be opened the software emulation of the DSA library does the
+ * queued copies, so the users of the engine work and are testable on any system.
+ *
+ * An engine must only be used by one thread at a time.
+ */
+
+#include <stdint.h>            // for uint32_t, uint16_t, uint64_t
+#include <cne_common.h>        // for CNDP_API
+#include <cne_lport.h>         // for lport_copy_ops_t
+#include <pktmbuf.h>           // for pktmbuf_t, pktmbuf_info_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DSA_COPY_DEFAULT_THRESHOLD 4096 /**< Copies of this size or more are offloaded */
+#define DSA_COPY_DEFAULT_BURST     32   /**< Copies queued before ringing the doorbell */
+#define DSA_COPY_POLL_MAX          64   /**< Max completions handled by a dsa_copy_poll() */
+
+typedef struct dsa_copy dsa_copy_t; /**< Opaque copy engine */
+
+/**
+ * Completion callback of a queued copy
+ *
+ * @param arg
+ *   The argument given with the copy
+ * @param status
+ *   DSA_OP_SUCCESS or the DSA_OP_* error code of the copy
+ */
+typedef void (*dsa_copy_cb)(void *arg, uint32_t status);
+
+/** Counters of a copy engine, see dsa_copy_stats_get() */
+struct dsa_copy_stats {
+    uint64_t cpu_copies; /**< Copies done by the CPU */
+    uint64_t cpu_bytes;  /**< Bytes copied by the CPU */
+    uint64_t dev_copies; /**< Copies queued to the device */
+    uint64_t dev_bytes;  /**< Bytes queued to the device */
+    uint64_t batches;    /**< Batches submitted to the device */
+    uint64_t fences;     /**< Fences queued */
+    uint64_t failed;     /**< Queued copies completed with an error */
+    uint64_t full;       /**< Times the device ring was full and the engine waited */
+};
+
+/**
+ * Create a copy engine
+ *
+ * @param name
+ *   The DSA work queue name in /dev/dsa, e.g. "wq0.0", or NULL for the software device
+ * @param threshold
+ *   Copies smaller than this are done by the CPU, 0 for DSA_COPY_DEFAULT_THRESHOLD
+ * @param burst
+ *   Number of copies queued before the doorbell is rung, 0 for DSA_COPY_DEFAULT_BURST
+ * @return
+ *   The copy engine or NULL on error
+ */
+CNDP_API dsa_copy_t *dsa_copy_create(const char *name, uint32_t threshold, uint16_t burst);
+
+/**
+ * Wait for the copies in flight and destroy a copy engine
+ *
+ * @param dc
+ *   The copy engine, can be NULL
+ */
+CNDP_API void dsa_copy_destroy(dsa_copy_t *dc);
+
+/**
+ * Copy or queue a copy of a buffer
+ *
+ * The copies done by the CPU are not ordered with the copies in flight, call
+ * dsa_copy_wait() first when they depend on each other.
+ *
+ * @param dc
+ *   The copy engine
+ * @param dst
+ *   The destination buffer
+ * @param src
+ *   The source buffer, it must not change until the copy is completed
+ * @param len
+ *   The number of bytes to copy
+ * @param cb
+ *   The function called when a queued copy is completed, can be NULL
+ * @param arg
+ *   The argument of the callback
+ * @return
+ *   0 when the copy is done and the callback is not called, 1 when the copy is queued or
+ *   -1 on error
+ */
+CNDP_API int dsa_copy(dsa_copy_t *dc, void *dst, const void *src, uint32_t len, dsa_copy_cb cb,
+                      void *arg);
+
+/**
+ * Order the copies, the copies queued after the fence start when the ones before it are done
+ *
+ * @param dc
+ *   The copy engine
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int dsa_copy_fence(dsa_copy_t *dc);
+
+/**
+ * Ring the doorbell for the copies queued since the last submit
+ *
+ * @param dc
+ *   The copy engine
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int dsa_copy_submit(dsa_copy_t *dc);
+
+/**
+ * Call the callbacks of the completed copies
+ *
+ * @param dc
+ *   The copy engine
+ * @param max
+ *   The max number of completions to handle, up to DSA_COPY_POLL_MAX
+ * @return
+ *   The number of completions handled or -1 on error
+ */
+CNDP_API int dsa_copy_poll(dsa_copy_t *dc, uint16_t max);
+
+/**
+ * Submit the queued copies and poll until all the copies in flight are completed
+ *
+ * @param dc
+ *   The copy engine
+ * @return
+ *   The number of copies completed with an error or -1 on error
+ */
+CNDP_API int dsa_copy_wait(dsa_copy_t *dc);
+
+/**
+ * Return the number of copies in flight
+ *
+ * @param dc
+ *   The copy engine
+ * @return
+ *   The number of queued copies not completed yet
+ */
+CNDP_API uint32_t dsa_copy_pending(dsa_copy_t *dc);
+
+/**
+ * Get the counters of a copy engine
+ *
+ * @param dc
+ *   The copy engine
+ * @param stats
+ *   The structure to fill
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int dsa_copy_stats_get(dsa_copy_t *dc, struct dsa_copy_stats *stats);
+
+/**
+ * Fill the copy routines of an lport configuration to use a copy engine
+ *
+ * The PMDs copying packet data, e.g. net_memif, queue their large copies to the engine and
+ * wait for them before the packets are handed to the peer.
+ *
+ * @param dc
+ *   The copy engine, owned by the thread calling the PMD
+ * @param ops
+ *   The copy routines to fill, usually &lport_cfg.copy_ops
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int dsa_copy_lport_ops(dsa_copy_t *dc, lport_copy_ops_t *ops);
+
+/**
+ * Asynchronous version of pktmbuf_copy(), copy the data of an mbuf to a new mbuf
+ *
+ * The header of the mbuf is copied at once, the data is valid when the callback is called
+ * or when the function returns 0.
+ *
+ * @param dc
+ *   The copy engine
+ * @param m
+ *   The mbuf to copy, it must not be freed until the copy is completed
+ * @param pi
+ *   The pktmbuf pool of the new mbuf
+ * @param off
+ *   The offset of the data to copy in the mbuf
+ * @param len
+ *   The number of bytes to copy, truncated to the data of the mbuf
+ * @param mc
+ *   The location to store the new mbuf
+ * @param cb
+ *   The function called when a queued copy is completed, can be NULL
+ * @param arg
+ *   The argument of the callback
+ * @return
+ *   0 when the copy is done, 1 when the data copy is queued or -1 on error
+ */
+CNDP_API int dsa_copy_pktmbuf(dsa_copy_t *dc, const pktmbuf_t *m, pktmbuf_info_t *pi, uint32_t off,
+                              uint32_t len, pktmbuf_t **mc, dsa_copy_cb cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DSA_COPY_H_ */
@@ -122,6 +122,7 @@ struct dsa {
 #define DSA_HDL_INVALID    (1 << 0) /* no handle stored for this element */
 #define DSA_HDL_OP_FAILED  (1 << 1) /* return failure for this one */
 #define DSA_HDL_OP_SKIPPED (1 << 2) /* this op was skipped */
+#define DSA_HDL_GROUP      (1 << 3) /* part of the op using the next handle */
 
 /**
  * DSA device software emulator
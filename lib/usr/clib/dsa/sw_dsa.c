@@ -108,13 +108,20 @@ __dsa_perform_op_unsupported(struct idxd_hw_desc *desc)
 void
 dsa_perform_ops_in_software(struct dsa *idxd, const struct idxd_hw_desc *batch_desc)
 {
-    bool success = true, fence = false;
+    struct idxd_hw_desc *list = (struct idxd_hw_desc *)(uintptr_t)batch_desc->desc_addr;
+    bool success              = true;
     struct idxd_hw_desc *desc;
-    uint16_t i;
+    uint32_t i;
     int err;
 
-    for (i = idxd->batch_start; i < idxd->batch_start + idxd->batch_size; i++) {
-        desc = &idxd->desc_ring[i];
+    CNE_SET_USED(idxd);
+
+    /* Walk the batch list like the device, a fence after a failure abandons the rest */
+    for (i = 0; i < batch_desc->size; i++) {
+        desc = &list[i];
+        if ((desc->op_flags & IDXD_FLAG_FENCE) && !success)
+            break;
+
         switch (desc->op_flags >> IDXD_CMD_OP_SHIFT) {
         case idxd_op_nop:
             err = __dsa_perform_op_nop(desc);
@@ -129,13 +136,9 @@ dsa_perform_ops_in_software(struct dsa *idxd, const struct idxd_hw_desc *batch_d
             err = __dsa_perform_op_unsupported(desc);
             break;
         }
-        if (desc->op_flags & IDXD_FLAG_FENCE)
-            fence = true;
         if (err)
             success = false;
-        if (fence && !success)
-            break;
     }
 
-    __dsa_perform_op_batch(batch_desc, i - idxd->batch_start, success);
+    __dsa_perform_op_batch(batch_desc, i, success);
 }
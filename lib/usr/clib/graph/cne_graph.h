@@ -180,6 +180,10 @@ struct cne_graph_cluster_node_stats {
     cne_node_t id;                /**< Node identifier of stats. */
     uint64_t hz;                  /**< Cycles per seconds. */
     char name[CNE_NODE_NAMESIZE]; /**< Name of the node. */
+
+    uint64_t cycles_p50; /**< Median cycles per call since the previous stats. */
+    uint64_t cycles_p99; /**< 99th percentile cycles per call since the previous stats. */
+    uint64_t cycles_max; /**< Max cycles per call since the previous stats. */
 } __cne_cache_aligned;
 
 /**
@@ -18,6 +18,8 @@
 #include <cne_prefetch.h>
 #include <cne_branch_prediction.h>
 #include <cne_log.h>
+#include <cne_trace.h>
+#include <cne_hist.h>
 
 #include "cne_graph.h"
 
@@ -58,6 +60,8 @@ struct cne_node {
 
     char parent[CNE_NODE_NAMESIZE]; /**< Parent node name. */
     char name[CNE_NODE_NAMESIZE];   /**< Name of the node. */
+    cne_hist_t *hist;               /**< Histogram of the cycles per process call. */
+    cne_hist_rec_t *hist_rec;       /**< Recorder of the graph walking this node. */
 
     /* Fast path area */
 #define CNE_NODE_CTX_SZ 16
@@ -112,6 +116,9 @@ void __cne_node_stream_alloc(struct cne_graph *graph, struct cne_node *node);
 void __cne_node_stream_alloc_size(struct cne_graph *graph, struct cne_node *node,
                                   uint16_t req_size);
 
+/** Trace point of a node process call in cne_graph_walk(), defined in graph.c */
+CNE_TRACE_POINT_DECLARE(cne_graph_trace_node);
+
 /**
  * Perform graph walk on the circular buffer and invoke the process function
  * of the nodes and collect the stats.
@@ -128,7 +135,7 @@ cne_graph_walk(struct cne_graph *graph)
     const cne_node_t mask            = graph->cir_mask;
     uint32_t head                    = graph->head;
     struct cne_node *node;
-    uint64_t start;
+    uint64_t start, cycles;
     uint16_t rc;
     void **objs;
 
@@ -153,12 +160,17 @@ cne_graph_walk(struct cne_graph *graph)
         objs = node->objs;
         cne_prefetch0(objs);
 
+        CNE_TRACE(cne_graph_trace_node, graph->id, node->id, node->idx);
+
         if (cne_graph_has_stats_feature()) {
             start = cne_rdtsc();
-            rc    = node->process(graph, node, objs, node->idx);
-            node->total_cycles += cne_rdtsc() - start;
+            rc     = node->process(graph, node, objs, node->idx);
+            cycles = cne_rdtsc() - start;
+            node->total_cycles += cycles;
             node->total_calls++;
             node->total_objs += rc;
+            if (likely(node->hist_rec != NULL))
+                cne_hist_record(node->hist_rec, cycles);
         } else
             node->process(graph, node, objs, node->idx);
         node->idx = 0;
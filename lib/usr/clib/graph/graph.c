@@ -12,6 +12,7 @@
 #include <stdlib.h>            // for NULL, free, calloc, realloc, size_t
 #include <string.h>            // for strncmp, strcmp
 #include <sys/queue.h>         // for STAILQ_FOREACH, STAILQ_FIRST, STAILQ_I...
+#include <cne_trace.h>         // for CNE_TRACE_POINT_DEFINE
 #include <cne_spinlock.h>
 
 #include "graph_private.h"           // for graph, graph_node, node, graph::(anony...
@@ -25,6 +26,8 @@ static cne_graph_t graph_id;
 
 #define GRAPH_ID_CHECK(id) ID_CHECK(id, graph_id)
 
+CNE_TRACE_POINT_DEFINE(cne_graph_trace_node, "graph.node", "graph,node,nb_objs");
+
 /* Private functions */
 struct graph_head *
 graph_list_head_get(void)
@@ -104,6 +104,13 @@ graph_nodes_populate(struct graph *_graph)
         off        = CNE_ALIGN(off, CNE_CACHE_LINE_SIZE);
         node->next = off;
         __cne_node_stream_alloc(graph, node);
+
+        /* The stats still work without the histogram, the node does not record then */
+        if (cne_graph_has_stats_feature()) {
+            node->hist = cne_hist_create(node->name, GRAPH_HIST_SUB_BITS, GRAPH_HIST_MAX_BITS, 1);
+            if (node->hist)
+                node->hist_rec = cne_hist_recorder(node->hist);
+        }
     }
 }
 
@@ -227,7 +234,13 @@ graph_nodes_mem_destroy(struct cne_graph *graph)
     if (graph == NULL)
         return;
 
-    cne_graph_foreach_node(count, off, graph, node) free(node->objs);
+    cne_graph_foreach_node(count, off, graph, node)
+    {
+        free(node->objs);
+        cne_hist_destroy(node->hist);
+        node->hist     = NULL;
+        node->hist_rec = NULL;
+    }
 }
 
 int
@@ -19,6 +19,7 @@
 #include "cne_cycles.h"                   // for cne_rdtsc
 #include "cne_graph.h"                    // for cne_graph_cluster_node_stats, cne...
 #include "cne_graph_worker.h"             // for cne_node, cne_graph
+#include "cne_hist.h"                     // for cne_hist_snapshot, cne_hist_percentile
 #include "cne_log.h"                      // for CNE_LOG_ERR
 #include "cne_stdio.h"                    // for cne_printf
 
@@ -33,6 +34,9 @@ struct cluster {
 /* Capture same node ID across cluster  */
 struct cluster_node {
     struct cne_graph_cluster_node_stats stat;
+    cne_hist_rec_t *hist;      /* Cycles per call of the node in all graphs */
+    cne_hist_rec_t *prev_hist; /* hist at the previous stats */
+    cne_hist_rec_t *tmp_hist;  /* Snapshot of one node, then the interval */
     cne_node_t nb_nodes;
 
     struct cne_node *nodes[];
@@ -51,15 +55,17 @@ struct cne_graph_cluster_stats {
 
 #define border()                                                      \
     cne_printf("[yellow]+------------------+---------------+--------" \
-               "-------+--------+--------+----------+------------+[]\n")
+               "-------+--------+--------+----------+------------+"   \
+               "------------+[]\n")
 
 static inline void
 print_banner(void)
 {
     border();
     cne_printf("[yellow]|[green]%-18s[yellow]|[green]%15s[yellow]|[green]%15s[yellow]|[green]%"
-               "8s[yellow]|[green]%8s[yellow]|[green]%10s[yellow]|[green]%12s[yellow]|[]\n",
-               "Node", "Calls", "Objects", "Realloc", "Objs/c", "KObjs/c", "Cycles/c");
+               "8s[yellow]|[green]%8s[yellow]|[green]%10s[yellow]|[green]%12s[yellow]|[green]%12s"
+               "[yellow]|[]\n",
+               "Node", "Calls", "Objects", "Realloc", "Objs/c", "KObjs/c", "Cycles/c", "P99 Cyc/c");
     border();
 }
 
@@ -83,9 +89,10 @@ print_node(const struct cne_graph_cluster_node_stats *stat)
 
     cne_printf("[yellow]|[magenta]%-18s[yellow]|[cyan]%'15" PRIu64 "[yellow]|[cyan]%'15" PRIu64
                "[yellow]|[cyan]%'8" PRIu64
-               "[yellow]|[cyan]%'8.1f[yellow]|[orange]%'10.1f[yellow]|[orange]%'12.1f[yellow]|[]\n",
+               "[yellow]|[cyan]%'8.1f[yellow]|[orange]%'10.1f[yellow]|[orange]%'12.1f[yellow]|"
+               "[orange]%'12" PRIu64 "[yellow]|[]\n",
                stat->name, calls, objs, stat->realloc_count, objs_per_call, objs_per_sec,
-               cycles_per_call);
+               cycles_per_call, stat->cycles_p99);
 }
 
 static int
@@ -174,6 +181,13 @@ stats_mem_populate(struct cne_graph_cluster_stats **stats_in, struct cne_graph *
                     graph->name);
     cluster->nodes[cluster->nb_nodes++] = node;
 
+    /* All the clones of a node have the same histogram layout */
+    if (node->hist) {
+        cluster->hist      = cne_hist_snapshot_alloc(node->hist);
+        cluster->prev_hist = cne_hist_snapshot_alloc(node->hist);
+        cluster->tmp_hist  = cne_hist_snapshot_alloc(node->hist);
+    }
+
     stats->sz += stats->cluster_node_size;
     stats->max_nodes++;
 
@@ -188,6 +202,19 @@ stats_mem_fini(struct cne_graph_cluster_stats *stats)
     free(stats);
 }
 
+static void
+stats_hist_free(struct cne_graph_cluster_stats *stats)
+{
+    struct cluster_node *cluster = stats->clusters;
+
+    for (cne_node_t count = 0; count < stats->max_nodes; count++) {
+        cne_hist_snapshot_free(cluster->hist);
+        cne_hist_snapshot_free(cluster->prev_hist);
+        cne_hist_snapshot_free(cluster->tmp_hist);
+        cluster = CNE_PTR_ADD(cluster, stats->cluster_node_size);
+    }
+}
+
 static void
 cluster_init(struct cluster *cluster)
 {
@@ -306,6 +333,8 @@ cne_graph_cluster_stats_create(const struct cne_graph_cluster_stats_param *prm)
         SET_ERR_JMP(ENOMEM, realloc_fail, "calloc failed");
 
 realloc_fail:
+    if (rc == NULL)
+        stats_hist_free(stats);
     stats_mem_fini(stats);
 bad_pattern:
     graph_spinlock_unlock();
@@ -317,9 +346,35 @@ fail:
 void
 cne_graph_cluster_stats_destroy(struct cne_graph_cluster_stats *stat)
 {
+    if (stat)
+        stats_hist_free(stat);
     return free(stat);
 }
 
+static inline void
+cluster_node_aggregate_hist(struct cluster_node *cluster)
+{
+    struct cne_graph_cluster_node_stats *stat = &cluster->stat;
+    cne_node_t count;
+
+    if (!cluster->hist || !cluster->prev_hist || !cluster->tmp_hist)
+        return;
+
+    cne_hist_snapshot_clear(cluster->hist);
+    for (count = 0; count < cluster->nb_nodes; count++) {
+        struct cne_node *node = cluster->nodes[count];
+
+        if (node->hist && cne_hist_snapshot(node->hist, cluster->tmp_hist) == 0)
+            cne_hist_merge(cluster->hist, cluster->tmp_hist);
+    }
+
+    /* Only the calls made since the previous stats */
+    cne_hist_sub(cluster->tmp_hist, cluster->hist, cluster->prev_hist);
+    stat->cycles_p50 = cne_hist_percentile(cluster->tmp_hist, 50.0);
+    stat->cycles_p99 = cne_hist_percentile(cluster->tmp_hist, 99.0);
+    stat->cycles_max = cne_hist_percentile(cluster->tmp_hist, 100.0);
+}
+
 static inline void
 cluster_node_arregate_stats(struct cluster_node *cluster)
 {
@@ -342,17 +397,23 @@ cluster_node_arregate_stats(struct cluster_node *cluster)
     stat->cycles        = cycles;
     stat->ts            = cne_rdtsc();
     stat->realloc_count = realloc_count;
+
+    cluster_node_aggregate_hist(cluster);
 }
 
 static inline void
 cluster_node_store_prev_stats(struct cluster_node *cluster)
 {
     struct cne_graph_cluster_node_stats *stat = &cluster->stat;
+    cne_hist_rec_t *hist                      = cluster->hist;
 
     stat->prev_ts     = stat->ts;
     stat->prev_calls  = stat->calls;
     stat->prev_objs   = stat->objs;
     stat->prev_cycles = stat->cycles;
+
+    cluster->hist      = cluster->prev_hist;
+    cluster->prev_hist = hist;
 }
 
 void
@@ -401,6 +462,10 @@ cne_graph_cluster_stats_reset(struct cne_graph_cluster_stats *stat)
         node->prev_objs     = 0;
         node->prev_cycles   = 0;
         node->realloc_count = 0;
-        cluster             = CNE_PTR_ADD(cluster, stat->cluster_node_size);
+        node->cycles_p50    = 0;
+        node->cycles_p99    = 0;
+        node->cycles_max    = 0;
+        cne_hist_snapshot_clear(cluster->prev_hist);
+        cluster = CNE_PTR_ADD(cluster, stat->cluster_node_size);
     }
 }
@@ -0,0 +1,304 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdlib.h>            // for posix_memalign, calloc, free
+#include <string.h>            // for memset
+#include <bsd/string.h>        // for strlcpy
+#include <cne_common.h>        // for CNE_CACHE_LINE_SIZE
+#include <cne_log.h>           // for CNE_NULL_RET, CNE_ERR_RET
+
+#include "cne_hist.h"
+
+struct cne_hist {
+    char name[CNE_HIST_NAME_LEN]; /**< Name of the histogram */
+    uint32_t sub_bits;            /**< Number of sub-bucket bits */
+    uint32_t nb_buckets;          /**< Number of buckets of a recorder */
+    uint64_t max_value;           /**< Largest value counted */
+    size_t rec_size;              /**< Size of a recorder in bytes */
+    uint32_t nb_recs;             /**< Number of recorders */
+    uint32_t nb_used;             /**< Number of recorders claimed */
+    cne_hist_rec_t *recs[];       /**< Recorders, each one on its own cache lines */
+};
+
+static void
+hist_rec_clear(cne_hist_rec_t *r)
+{
+    memset(r->buckets, 0, r->nb_buckets * sizeof(uint64_t));
+    r->count = 0;
+    r->sum   = 0;
+    r->min   = UINT64_MAX;
+    r->max   = 0;
+}
+
+static cne_hist_rec_t *
+hist_rec_alloc(cne_hist_t *h)
+{
+    cne_hist_rec_t *r;
+
+    if (posix_memalign((void **)&r, CNE_CACHE_LINE_SIZE, h->rec_size))
+        return NULL;
+    memset(r, 0, h->rec_size);
+
+    r->min        = UINT64_MAX;
+    r->max_value  = h->max_value;
+    r->sub_bits   = h->sub_bits;
+    r->nb_buckets = h->nb_buckets;
+
+    return r;
+}
+
+cne_hist_t *
+cne_hist_create(const char *name, uint32_t sub_bits, uint32_t max_bits, uint32_t nb_recorders)
+{
+    cne_hist_t *h;
+
+    if (!name)
+        CNE_NULL_RET("Histogram name is NULL\n");
+
+    if (sub_bits == 0)
+        sub_bits = CNE_HIST_DEFAULT_SUB;
+    if (max_bits == 0)
+        max_bits = CNE_HIST_DEFAULT_MAX;
+
+    if (sub_bits > CNE_HIST_MAX_SUB_BITS || max_bits <= sub_bits || max_bits > 64)
+        CNE_NULL_RET("Invalid histogram %s sub_bits %u max_bits %u\n", name, sub_bits, max_bits);
+    if (nb_recorders == 0 || nb_recorders > CNE_HIST_MAX_RECORDERS)
+        CNE_NULL_RET("Invalid number of recorders %u for histogram %s\n", nb_recorders, name);
+
+    h = calloc(1, sizeof(cne_hist_t) + nb_recorders * sizeof(cne_hist_rec_t *));
+    if (!h)
+        CNE_NULL_RET("Unable to allocate histogram %s\n", name);
+
+    strlcpy(h->name, name, sizeof(h->name));
+    h->sub_bits   = sub_bits;
+    h->max_value  = (max_bits == 64) ? UINT64_MAX : (1ULL << max_bits) - 1;
+    h->nb_buckets = cne_hist_index(sub_bits, h->max_value) + 1;
+    h->rec_size   = sizeof(cne_hist_rec_t) + h->nb_buckets * sizeof(uint64_t);
+    h->rec_size   = CNE_ALIGN(h->rec_size, CNE_CACHE_LINE_SIZE);
+    h->nb_recs    = nb_recorders;
+
+    for (uint32_t i = 0; i < nb_recorders; i++) {
+        h->recs[i] = hist_rec_alloc(h);
+        if (!h->recs[i]) {
+            cne_hist_destroy(h);
+            CNE_NULL_RET("Unable to allocate recorders of histogram %s\n", name);
+        }
+    }
+
+    return h;
+}
+
+void
+cne_hist_destroy(cne_hist_t *h)
+{
+    if (!h)
+        return;
+
+    for (uint32_t i = 0; i < h->nb_recs; i++)
+        free(h->recs[i]);
+    free(h);
+}
+
+const char *
+cne_hist_name(cne_hist_t *h)
+{
+    return (h) ? h->name : NULL;
+}
+
+cne_hist_rec_t *
+cne_hist_recorder(cne_hist_t *h)
+{
+    uint32_t idx;
+
+    if (!h)
+        return NULL;
+
+    idx = __atomic_fetch_add(&h->nb_used, 1, __ATOMIC_RELAXED);
+    if (idx >= h->nb_recs) {
+        __atomic_fetch_sub(&h->nb_used, 1, __ATOMIC_RELAXED);
+        CNE_NULL_RET("All %u recorders of histogram %s are claimed\n", h->nb_recs, h->name);
+    }
+
+    return h->recs[idx];
+}
+
+void
+cne_hist_reset(cne_hist_t *h)
+{
+    if (!h)
+        return;
+
+    for (uint32_t i = 0; i < h->nb_recs; i++)
+        hist_rec_clear(h->recs[i]);
+}
+
+cne_hist_rec_t *
+cne_hist_snapshot_alloc(cne_hist_t *h)
+{
+    if (!h)
+        return NULL;
+
+    return hist_rec_alloc(h);
+}
+
+void
+cne_hist_snapshot_free(cne_hist_rec_t *s)
+{
+    free(s);
+}
+
+void
+cne_hist_snapshot_clear(cne_hist_rec_t *s)
+{
+    if (s)
+        hist_rec_clear(s);
+}
+
+static inline int
+hist_same_layout(const cne_hist_rec_t *a, const cne_hist_rec_t *b)
+{
+    return a->sub_bits == b->sub_bits && a->nb_buckets == b->nb_buckets;
+}
+
+/* min and max follow the buckets, which may hold values newer than the recorder min/max */
+static void
+hist_bounds(cne_hist_rec_t *s)
+{
+    uint32_t lo = 0, hi = s->nb_buckets;
+
+    while (lo < s->nb_buckets && s->buckets[lo] == 0)
+        lo++;
+    while (hi > lo && s->buckets[hi - 1] == 0)
+        hi--;
+
+    if (lo == s->nb_buckets) {
+        s->min = UINT64_MAX;
+        s->max = 0;
+        return;
+    }
+
+    if (s->min < cne_hist_bucket_low(s->sub_bits, lo) ||
+        s->min > cne_hist_bucket_high(s->sub_bits, lo))
+        s->min = cne_hist_bucket_low(s->sub_bits, lo);
+    if (s->max < cne_hist_bucket_low(s->sub_bits, hi - 1) ||
+        s->max > cne_hist_bucket_high(s->sub_bits, hi - 1))
+        s->max = cne_hist_bucket_high(s->sub_bits, hi - 1);
+}
+
+int
+cne_hist_snapshot(cne_hist_t *h, cne_hist_rec_t *s)
+{
+    uint32_t used;
+
+    if (!h || !s || s->sub_bits != h->sub_bits || s->nb_buckets != h->nb_buckets)
+        CNE_ERR_RET("Invalid histogram snapshot\n");
+
+    hist_rec_clear(s);
+
+    used = __atomic_load_n(&h->nb_used, __ATOMIC_RELAXED);
+    if (used > h->nb_recs)
+        used = h->nb_recs;
+
+    for (uint32_t i = 0; i < used; i++) {
+        const cne_hist_rec_t *r = h->recs[i];
+        uint64_t v;
+
+        for (uint32_t j = 0; j < s->nb_buckets; j++) {
+            v = __atomic_load_n(&r->buckets[j], __ATOMIC_RELAXED);
+            s->buckets[j] += v;
+            s->count += v;
+        }
+        s->sum += __atomic_load_n(&r->sum, __ATOMIC_RELAXED);
+
+        v = __atomic_load_n(&r->min, __ATOMIC_RELAXED);
+        if (v < s->min)
+            s->min = v;
+        v = __atomic_load_n(&r->max, __ATOMIC_RELAXED);
+        if (v > s->max)
+            s->max = v;
+    }
+    hist_bounds(s);
+
+    return 0;
+}
+
+int
+cne_hist_merge(cne_hist_rec_t *dst, const cne_hist_rec_t *src)
+{
+    if (!dst || !src || !hist_same_layout(dst, src))
+        CNE_ERR_RET("Histogram snapshots have different layouts\n");
+
+    for (uint32_t i = 0; i < dst->nb_buckets; i++)
+        dst->buckets[i] += src->buckets[i];
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+
+    return 0;
+}
+
+int
+cne_hist_sub(cne_hist_rec_t *dst, const cne_hist_rec_t *cur, const cne_hist_rec_t *prev)
+{
+    if (!dst || !cur || !prev || !hist_same_layout(dst, cur) || !hist_same_layout(cur, prev))
+        CNE_ERR_RET("Histogram snapshots have different layouts\n");
+
+    dst->count = 0;
+    for (uint32_t i = 0; i < dst->nb_buckets; i++) {
+        uint64_t v = cur->buckets[i];
+
+        /* A reset histogram has counts smaller than the previous snapshot */
+        v               = (v >= prev->buckets[i]) ? v - prev->buckets[i] : v;
+        dst->buckets[i] = v;
+        dst->count += v;
+    }
+    dst->sum = (cur->sum >= prev->sum) ? cur->sum - prev->sum : cur->sum;
+    dst->min = cur->min;
+    dst->max = cur->max;
+    hist_bounds(dst);
+
+    return 0;
+}
+
+uint64_t
+cne_hist_percentile(const cne_hist_rec_t *s, double pct)
+{
+    uint64_t target, total = 0;
+
+    if (!s || s->count == 0)
+        return 0;
+
+    if (pct < 0.0)
+        pct = 0.0;
+    if (pct > 100.0)
+        pct = 100.0;
+
+    /* The rank of the value at the percentile, counting from 1 */
+    target = (uint64_t)((pct / 100.0) * (double)s->count + 0.5);
+    if (target == 0)
+        target = 1;
+
+    for (uint32_t i = 0; i < s->nb_buckets; i++) {
+        total += s->buckets[i];
+        if (total >= target) {
+            uint64_t v = cne_hist_bucket_high(s->sub_bits, i);
+
+            return (v > s->max) ? s->max : v;
+        }
+    }
+
+    return s->max;
+}
+
+double
+cne_hist_mean(const cne_hist_rec_t *s)
+{
+    if (!s || s->count == 0)
+        return 0.0;
+
+    return (double)s->sum / (double)s->count;
+}
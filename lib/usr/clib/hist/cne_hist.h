@@ -0,0 +1,314 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_HIST_H_
+#define _CNE_HIST_H_
+
+/**
+ * @file
+ *
+ * CNE log-linear (HDR style) histograms
+ *
+ * A histogram counts values in buckets, each power of two range of values is split in
+ * 2^(sub_bits - 1) buckets of equal width, so the relative error of a reported value is
+ * less than 2^-(sub_bits - 1). Values below 2^sub_bits have a bucket of their own. The
+ * memory of a histogram is fixed when it is created, values above 2^max_bits - 1 are
+ * counted as 2^max_bits - 1.
+ *
+ * A histogram has a fixed number of recorders, a recorder must only be written by one
+ * thread at a time. Recording a value is a few plain loads and stores to the recorder,
+ * with no locks and no atomic read-modify-write instruction.
+ *
+ * Readers merge all recorders into a snapshot with cne_hist_snapshot() while the writers
+ * keep recording. The percentiles, min, max and mean are computed from a snapshot.
+ */
+
+#include <stdint.h>            // for uint64_t, uint32_t
+#include <cne_common.h>        // for CNDP_API, cne_fls_u64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_HIST_NAME_LEN      32  /**< Max length of a histogram name */
+#define CNE_HIST_MAX_SUB_BITS  16  /**< Max precision, the number of sub-bucket bits */
+#define CNE_HIST_DEFAULT_SUB   7   /**< Default sub-bucket bits, less than 1.6% error */
+#define CNE_HIST_DEFAULT_MAX   40  /**< Default max value bits */
+#define CNE_HIST_MAX_RECORDERS 256 /**< Max number of recorders of a histogram */
+
+typedef struct cne_hist cne_hist_t; /**< Opaque histogram */
+
+/**
+ * Bucket counts of a recorder or of a snapshot of a histogram
+ */
+typedef struct cne_hist_rec {
+    uint64_t count;      /**< Number of values recorded */
+    uint64_t sum;        /**< Sum of the values recorded */
+    uint64_t min;        /**< Smallest value recorded, UINT64_MAX when empty */
+    uint64_t max;        /**< Largest value recorded */
+    uint64_t max_value;  /**< Largest value the histogram can count */
+    uint32_t sub_bits;   /**< Number of sub-bucket bits */
+    uint32_t nb_buckets; /**< Number of buckets */
+    uint64_t buckets[] __cne_cache_aligned; /**< Count of each bucket */
+} cne_hist_rec_t;
+
+/**
+ * Create a histogram
+ *
+ * @param name
+ *   The name of the histogram
+ * @param sub_bits
+ *   The number of sub-bucket bits, 1 to CNE_HIST_MAX_SUB_BITS or 0 for CNE_HIST_DEFAULT_SUB
+ * @param max_bits
+ *   The number of bits of the largest value, sub_bits + 1 to 64 or 0 for CNE_HIST_DEFAULT_MAX
+ * @param nb_recorders
+ *   The number of recorders, 1 to CNE_HIST_MAX_RECORDERS
+ * @return
+ *   The histogram or NULL on error
+ */
+CNDP_API cne_hist_t *cne_hist_create(const char *name, uint32_t sub_bits, uint32_t max_bits,
+                                     uint32_t nb_recorders);
+
+/**
+ * Destroy a histogram and free its recorders, the snapshots are freed separately
+ *
+ * @param h
+ *   The histogram, can be NULL
+ */
+CNDP_API void cne_hist_destroy(cne_hist_t *h);
+
+/**
+ * Return the name of a histogram
+ *
+ * @param h
+ *   The histogram
+ * @return
+ *   The name of the histogram or NULL on error
+ */
+CNDP_API const char *cne_hist_name(cne_hist_t *h);
+
+/**
+ * Claim a recorder of a histogram for the calling thread
+ *
+ * @param h
+ *   The histogram
+ * @return
+ *   The recorder or NULL when all the recorders are claimed
+ */
+CNDP_API cne_hist_rec_t *cne_hist_recorder(cne_hist_t *h);
+
+/**
+ * Clear the counts of all the recorders, no value must be recorded meanwhile
+ *
+ * @param h
+ *   The histogram
+ */
+CNDP_API void cne_hist_reset(cne_hist_t *h);
+
+/**
+ * Allocate an empty snapshot with the bucket layout of a histogram
+ *
+ * @param h
+ *   The histogram
+ * @return
+ *   The snapshot to release with cne_hist_snapshot_free() or NULL on error
+ */
+CNDP_API cne_hist_rec_t *cne_hist_snapshot_alloc(cne_hist_t *h);
+
+/**
+ * Free a snapshot
+ *
+ * @param s
+ *   The snapshot, can be NULL
+ */
+CNDP_API void cne_hist_snapshot_free(cne_hist_rec_t *s);
+
+/**
+ * Clear the counts of a snapshot
+ *
+ * @param s
+ *   The snapshot
+ */
+CNDP_API void cne_hist_snapshot_clear(cne_hist_rec_t *s);
+
+/**
+ * Merge the recorders of a histogram into a snapshot, the writers are not stopped
+ *
+ * The count of the snapshot is the sum of its buckets, the values recorded while the
+ * snapshot is taken may be in the snapshot or not.
+ *
+ * @param h
+ *   The histogram
+ * @param s
+ *   The snapshot to fill, allocated by cne_hist_snapshot_alloc()
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int cne_hist_snapshot(cne_hist_t *h, cne_hist_rec_t *s);
+
+/**
+ * Add the counts of a snapshot to another snapshot with the same bucket layout
+ *
+ * @param dst
+ *   The snapshot to add to
+ * @param src
+ *   The snapshot to add
+ * @return
+ *   0 on success or -1 if the layouts are different
+ */
+CNDP_API int cne_hist_merge(cne_hist_rec_t *dst, const cne_hist_rec_t *src);
+
+/**
+ * Compute the values recorded between two snapshots of the same histogram
+ *
+ * @param dst
+ *   The snapshot to store cur - prev in, can be cur
+ * @param cur
+ *   The latest snapshot
+ * @param prev
+ *   An older snapshot of the same histogram
+ * @return
+ *   0 on success or -1 if the layouts are different
+ */
+CNDP_API int cne_hist_sub(cne_hist_rec_t *dst, const cne_hist_rec_t *cur,
+                          const cne_hist_rec_t *prev);
+
+/**
+ * Return the value at a percentile of a snapshot
+ *
+ * @param s
+ *   The snapshot
+ * @param pct
+ *   The percentile, 0.0 to 100.0
+ * @return
+ *   The largest value of the bucket holding the percentile, never more than the max
+ *   recorded, or 0 when the snapshot is empty
+ */
+CNDP_API uint64_t cne_hist_percentile(const cne_hist_rec_t *s, double pct);
+
+/**
+ * Return the mean of the values of a snapshot
+ *
+ * @param s
+ *   The snapshot
+ * @return
+ *   The mean or 0.0 when the snapshot is empty
+ */
+CNDP_API double cne_hist_mean(const cne_hist_rec_t *s);
+
+/**
+ * Return the index of the bucket counting a value
+ *
+ * @param sub_bits
+ *   The number of sub-bucket bits
+ * @param v
+ *   The value, not larger than the max value of the histogram
+ * @return
+ *   The index of the bucket
+ */
+static inline uint32_t
+cne_hist_index(uint32_t sub_bits, uint64_t v)
+{
+    uint32_t shift;
+
+    if (v < (1ULL << sub_bits))
+        return (uint32_t)v;
+
+    /* The sub_bits most significant bits of v select the bucket within its power of two */
+    shift = cne_fls_u64(v) - sub_bits;
+    return (shift << (sub_bits - 1)) + (uint32_t)(v >> shift);
+}
+
+/**
+ * Return the smallest value counted by a bucket
+ *
+ * @param sub_bits
+ *   The number of sub-bucket bits
+ * @param idx
+ *   The index of the bucket
+ * @return
+ *   The smallest value of the bucket
+ */
+static inline uint64_t
+cne_hist_bucket_low(uint32_t sub_bits, uint32_t idx)
+{
+    uint32_t half = 1U << (sub_bits - 1);
+    uint32_t shift;
+
+    if (idx < (1U << sub_bits))
+        return idx;
+
+    shift = (idx >> (sub_bits - 1)) - 1;
+    return (uint64_t)((idx & (half - 1)) | half) << shift;
+}
+
+/**
+ * Return the largest value counted by a bucket
+ *
+ * @param sub_bits
+ *   The number of sub-bucket bits
+ * @param idx
+ *   The index of the bucket
+ * @return
+ *   The largest value of the bucket
+ */
+static inline uint64_t
+cne_hist_bucket_high(uint32_t sub_bits, uint32_t idx)
+{
+    if (idx < (1U << sub_bits))
+        return idx;
+
+    return cne_hist_bucket_low(sub_bits, idx) + ((1ULL << ((idx >> (sub_bits - 1)) - 1)) - 1);
+}
+
+/* Only the owner of the recorder writes, readers load the counters atomically */
+#define __CNE_HIST_SET(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+
+/**
+ * Record a value several times
+ *
+ * @param r
+ *   The recorder owned by the calling thread
+ * @param v
+ *   The value to record
+ * @param n
+ *   The number of times to record the value
+ */
+static inline void
+cne_hist_record_n(cne_hist_rec_t *r, uint64_t v, uint64_t n)
+{
+    uint32_t idx;
+
+    if (v > r->max_value)
+        v = r->max_value;
+    idx = cne_hist_index(r->sub_bits, v);
+
+    __CNE_HIST_SET(&r->buckets[idx], r->buckets[idx] + n);
+    __CNE_HIST_SET(&r->count, r->count + n);
+    __CNE_HIST_SET(&r->sum, r->sum + v * n);
+    if (v < r->min)
+        __CNE_HIST_SET(&r->min, v);
+    if (v > r->max)
+        __CNE_HIST_SET(&r->max, v);
+}
+
+/**
+ * Record a value
+ *
+ * @param r
+ *   The recorder owned by the calling thread
+ * @param v
+ *   The value to record
+ */
+static inline void
+cne_hist_record(cne_hist_rec_t *r, uint64_t v)
+{
+    cne_hist_record_n(r, v, 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_HIST_H_ */
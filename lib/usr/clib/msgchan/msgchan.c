@@ -17,6 +17,7 @@
 #include <cne_spinlock.h>
 #include <cne_cycles.h>
 #include <cne_mutex_helper.h>
+#include <cne_trace.h>
 
 #include "msgchan_priv.h"
 #include "msgchan.h"
@@ -26,6 +27,10 @@ TAILQ_HEAD(msgchan_list, msg_chan);
 static struct msgchan_list mc_list_head = TAILQ_HEAD_INITIALIZER(mc_list_head);
 static pthread_mutex_t mc_list_mutex;
 
+CNE_TRACE_POINT_DEFINE(mc_trace_send, "msgchan.send", "mc,count,sent");
+CNE_TRACE_POINT_DEFINE(mc_trace_recv, "msgchan.recv", "mc,count,rcvd");
+CNE_TRACE_POINT_DEFINE(mc_trace_full, "msgchan.full", "mc,dropped");
+
 #ifdef MC_ENABLE_LOCK_DEBUG
 #define MC_LIST_LOCK()                                \
     do {                                              \
@@ -251,6 +256,10 @@ __recv(msg_chan_t *mc, void **objs, int count, uint64_t msec)
     } else
         nb_objs = cne_ring_dequeue_burst(r, objs, count, NULL);
 
+    /* Empty polls are not traced, they would overwrite the useful records */
+    if (nb_objs > 0)
+        CNE_TRACE(mc_trace_recv, (uintptr_t)mc, count, nb_objs);
+
     mc->recv_cnt += nb_objs;
     return nb_objs;
 }
@@ -270,6 +279,10 @@ __send(msgchan_t *_mc, void **objs, int count)
     if (nb_objs < 0)
         CNE_ERR_RET("[orange]Sending to msgchan failed[]\n");
 
+    CNE_TRACE(mc_trace_send, (uintptr_t)mc, count, nb_objs);
+    if (nb_objs < count)
+        CNE_TRACE(mc_trace_full, (uintptr_t)mc, count - nb_objs);
+
     mc->send_cnt += nb_objs;
     return nb_objs;
 }
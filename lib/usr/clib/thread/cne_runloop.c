@@ -0,0 +1,337 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <string.h>              // for memset
+#include <stdlib.h>              // for calloc, free
+#include <inttypes.h>            // for PRIu64
+#include <bsd/string.h>          // for strlcpy
+#include <cne_cycles.h>          // for cne_rdtsc, US_PER_S
+#include <cne_system.h>          // for cne_get_timer_hz
+#include <cne_log.h>             // for CNE_ERR_RET, CNE_NULL_RET
+
+#include "cne_runloop.h"
+#include "cne_thread.h"        // for thread_running
+
+/*
+ * Minimum virtual runtime charged for a slice, stops a task doing nothing from winning
+ * every selection because its slices are too short to measure.
+ */
+#define RUNLOOP_MIN_CHARGE 64
+
+struct runloop_task {
+    char name[RUNLOOP_NAME_LEN]; /**< Name of the task */
+    runloop_func_t func;         /**< Poll function, NULL if the entry is free */
+    void *arg;                   /**< Poll function argument */
+    uint16_t weight;             /**< Share of the thread */
+    uint16_t flags;              /**< RUNLOOP_TASK_XXX flags */
+    uint16_t idle;               /**< Last call returned no work */
+    uint64_t budget;             /**< Slice budget in TSC cycles, 0 for a single call */
+    uint64_t period;             /**< Period in TSC cycles, 0 for a weighted task */
+    uint64_t deadline;           /**< TSC the next periodic run is due */
+    uint64_t vruntime;           /**< Virtual runtime of a weighted task */
+    runloop_stats_t stats;       /**< Task statistics */
+};
+
+struct runloop {
+    char name[RUNLOOP_NAME_LEN];                  /**< Name of the run-loop */
+    volatile int stop;                            /**< Set to stop runloop_run() */
+    uint16_t cnt;                                 /**< Number of tasks */
+    uint16_t last;                                /**< Highest task ID in use plus one */
+    uint64_t hz;                                  /**< TSC frequency */
+    uint64_t start;                               /**< TSC of the last statistics reset */
+    uint64_t loops;                               /**< Number of slices */
+    uint64_t vclock;                              /**< Virtual runtime of the last fair task */
+    struct runloop_task tasks[RUNLOOP_MAX_TASKS]; /**< Task table indexed by task ID */
+};
+
+static inline struct runloop_task *
+task_get(runloop_t *rl, int tid)
+{
+    if (!rl || tid < 0 || tid >= RUNLOOP_MAX_TASKS || !rl->tasks[tid].func)
+        return NULL;
+    return &rl->tasks[tid];
+}
+
+/* Return 1 if the last call of every task, other than idle tasks, returned no work */
+static inline int
+all_idle(runloop_t *rl)
+{
+    for (int i = 0; i < rl->last; i++) {
+        struct runloop_task *t = &rl->tasks[i];
+
+        if (t->func && !(t->flags & RUNLOOP_TASK_IDLE) && !t->idle)
+            return 0;
+    }
+    return 1;
+}
+
+/* Smallest virtual runtime of the weighted tasks, used to start new tasks */
+static uint64_t
+min_vruntime(runloop_t *rl)
+{
+    uint64_t vr = UINT64_MAX;
+
+    for (int i = 0; i < rl->last; i++) {
+        struct runloop_task *t = &rl->tasks[i];
+
+        if (t->func && !t->period && t->vruntime < vr)
+            vr = t->vruntime;
+    }
+    return (vr == UINT64_MAX) ? 0 : vr;
+}
+
+/*
+ * An expired periodic task with the earliest deadline runs first, otherwise the weighted
+ * task with the smallest virtual runtime. Idle tasks are skipped while any task has work,
+ * their virtual runtime follows the run-loop so they do not own the thread once eligible.
+ */
+static struct runloop_task *
+task_select(runloop_t *rl, uint64_t now)
+{
+    struct runloop_task *edf = NULL, *fair = NULL;
+    int idle = all_idle(rl);
+
+    for (int i = 0; i < rl->last; i++) {
+        struct runloop_task *t = &rl->tasks[i];
+
+        if (!t->func)
+            continue;
+        if ((t->flags & RUNLOOP_TASK_IDLE) && !idle) {
+            if (t->vruntime < rl->vclock)
+                t->vruntime = rl->vclock;
+            continue;
+        }
+
+        if (t->period) {
+            if (now >= t->deadline && (!edf || t->deadline < edf->deadline))
+                edf = t;
+        } else if (!fair || t->vruntime < fair->vruntime)
+            fair = t;
+    }
+
+    if (edf)
+        return edf;
+    if (fair && fair->vruntime > rl->vclock)
+        rl->vclock = fair->vruntime;
+    return fair;
+}
+
+runloop_t *
+runloop_create(const char *name)
+{
+    runloop_t *rl;
+
+    rl = calloc(1, sizeof(runloop_t));
+    if (!rl)
+        CNE_NULL_RET("Failed to allocate run-loop\n");
+
+    strlcpy(rl->name, (name) ? name : "runloop", sizeof(rl->name));
+    rl->hz    = cne_get_timer_hz();
+    rl->start = cne_rdtsc();
+
+    return rl;
+}
+
+void
+runloop_destroy(runloop_t *rl)
+{
+    free(rl);
+}
+
+int
+runloop_task_add(runloop_t *rl, const char *name, runloop_func_t func, void *arg,
+                 const runloop_task_cfg_t *cfg)
+{
+    runloop_task_cfg_t dflt = {0};
+    struct runloop_task *t  = NULL;
+    int tid;
+
+    if (!rl || !func)
+        CNE_ERR_RET("Invalid run-loop or function pointer\n");
+    if (!cfg)
+        cfg = &dflt;
+    if (cfg->weight > RUNLOOP_WEIGHT_MAX)
+        CNE_ERR_RET("Task weight %u > %u\n", cfg->weight, RUNLOOP_WEIGHT_MAX);
+
+    for (tid = 0; tid < RUNLOOP_MAX_TASKS; tid++) {
+        if (!rl->tasks[tid].func) {
+            t = &rl->tasks[tid];
+            break;
+        }
+    }
+    if (!t)
+        CNE_ERR_RET("Run-loop %s has no free task entries\n", rl->name);
+
+    memset(t, 0, sizeof(struct runloop_task));
+    strlcpy(t->name, (name) ? name : "task", sizeof(t->name));
+    t->arg      = arg;
+    t->weight   = (cfg->weight) ? cfg->weight : RUNLOOP_WEIGHT_DEFAULT;
+    t->flags    = cfg->flags;
+    t->budget   = ((uint64_t)cfg->budget_us * rl->hz) / US_PER_S;
+    t->period   = ((uint64_t)cfg->period_us * rl->hz) / US_PER_S;
+    t->deadline = cne_rdtsc();
+    t->vruntime = min_vruntime(rl);
+    t->func     = func;
+
+    if (tid >= rl->last)
+        rl->last = tid + 1;
+    rl->cnt++;
+
+    return tid;
+}
+
+int
+runloop_task_del(runloop_t *rl, int tid)
+{
+    struct runloop_task *t = task_get(rl, tid);
+
+    if (!t)
+        return -1;
+
+    t->func = NULL;
+    rl->cnt--;
+    while (rl->last > 0 && !rl->tasks[rl->last - 1].func)
+        rl->last--;
+
+    return 0;
+}
+
+int
+runloop_run_once(runloop_t *rl)
+{
+    struct runloop_task *t;
+    uint64_t start, end, elapsed;
+    int ret, work = 0;
+
+    if (!rl)
+        return -1;
+
+    start = cne_rdtsc();
+    t     = task_select(rl, start);
+    if (!t)
+        return 0;
+
+    if (t->period && (start - t->deadline) >= t->period)
+        t->stats.late++;
+
+    /* Keep calling the task while it has work and the slice budget is not used up */
+    do {
+        ret = t->func(t->arg);
+        end = cne_rdtsc();
+
+        t->stats.calls++;
+        if (ret > 0)
+            work += ret;
+        else
+            t->stats.idle++;
+    } while (ret > 0 && t->func && t->budget && (end - start) < t->budget);
+
+    elapsed = end - start;
+
+    t->idle = (work == 0);
+    t->stats.slices++;
+    t->stats.work += work;
+    t->stats.cycles += elapsed;
+    if (elapsed > t->stats.max)
+        t->stats.max = elapsed;
+    if (t->budget && elapsed > t->budget)
+        t->stats.overruns++;
+
+    if (t->period) {
+        t->deadline += t->period;
+        /* Do not try to catch up on missed periods */
+        if (t->deadline <= end)
+            t->deadline = end + t->period;
+    } else {
+        if (elapsed < RUNLOOP_MIN_CHARGE)
+            elapsed = RUNLOOP_MIN_CHARGE;
+        t->vruntime += (elapsed * RUNLOOP_WEIGHT_DEFAULT) / t->weight;
+    }
+    rl->loops++;
+
+    if (ret < 0)
+        runloop_task_del(rl, t - rl->tasks);
+
+    return work;
+}
+
+int
+runloop_run(runloop_t *rl)
+{
+    if (!rl)
+        return -1;
+
+    rl->stop = 0;
+    while (!rl->stop && thread_running(-1) != 0) {
+        if (rl->cnt == 0)
+            break;
+        runloop_run_once(rl);
+    }
+
+    return 0;
+}
+
+void
+runloop_stop(runloop_t *rl)
+{
+    if (rl)
+        rl->stop = 1;
+}
+
+int
+runloop_stats_get(runloop_t *rl, int tid, runloop_stats_t *stats)
+{
+    struct runloop_task *t = task_get(rl, tid);
+    uint64_t total;
+
+    if (!t || !stats)
+        return -1;
+
+    *stats = t->stats;
+
+    total       = cne_rdtsc() - rl->start;
+    stats->util = (total) ? ((double)t->stats.cycles * 100.0) / (double)total : 0.0;
+
+    return 0;
+}
+
+void
+runloop_stats_reset(runloop_t *rl)
+{
+    if (!rl)
+        return;
+
+    for (int i = 0; i < RUNLOOP_MAX_TASKS; i++)
+        memset(&rl->tasks[i].stats, 0, sizeof(runloop_stats_t));
+    rl->loops = 0;
+    rl->start = cne_rdtsc();
+}
+
+void
+runloop_dump(FILE *f, runloop_t *rl)
+{
+    if (!rl)
+        return;
+    if (!f)
+        f = stdout;
+
+    fprintf(f, ">>> Run-loop '%s' tasks %u, slices %" PRIu64 "\n", rl->name, rl->cnt, rl->loops);
+    fprintf(f, "  %3s %-20s %6s %8s %14s %14s %10s %8s %8s %6s\n", "ID", "Name", "Weight",
+            "Period", "Calls", "Work", "Max(us)", "Overrun", "Late", "Util%");
+
+    for (int i = 0; i < rl->last; i++) {
+        struct runloop_task *t = &rl->tasks[i];
+        runloop_stats_t st;
+
+        if (runloop_stats_get(rl, i, &st) < 0)
+            continue;
+
+        fprintf(f,
+                "  %3d %-20s %6u %8" PRIu64 " %14" PRIu64 " %14" PRIu64 " %10" PRIu64 " %8" PRIu64
+                " %8" PRIu64 " %6.2f%s\n",
+                i, t->name, t->weight, (t->period * US_PER_S) / rl->hz, st.calls, st.work,
+                (st.max * US_PER_S) / rl->hz, st.overruns, st.late, st.util,
+                (t->flags & RUNLOOP_TASK_IDLE) ? " idle" : "");
+    }
+}
@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_RUNLOOP_H_
+#define _CNE_RUNLOOP_H_
+
+/**
+ * @file
+ * CNE Run-loop
+ *
+ * A per thread scheduler for the poll functions a thread runs in its main loop, e.g.
+ * graph walks, timer manage, msgchan drain or an idlemgr wait.
+ *
+ * Tasks without a period share the thread by weight. Each task has a virtual runtime
+ * advanced by the TSC cycles it used divided by its weight, the task with the smallest
+ * virtual runtime runs next. A task is called again in the same slice while it reports
+ * work and its time budget is not used up, so one busy graph can not hold the thread.
+ *
+ * Tasks with a period run once per period. When the period has expired the task with
+ * the earliest deadline runs before any weighted task.
+ *
+ * A task with the RUNLOOP_TASK_IDLE flag only runs when the last call of every other
+ * task found no work, which is where an idlemgr wait belongs.
+ *
+ * A run-loop is owned by a single thread, none of the functions are thread safe.
+ */
+
+#include <stdio.h>             // for FILE
+#include <stdint.h>            // for uint64_t, uint32_t, uint16_t
+#include <cne_common.h>        // for CNDP_API
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RUNLOOP_MAX_TASKS      16   /**< Max number of tasks in a run-loop */
+#define RUNLOOP_NAME_LEN       32   /**< Max length of a run-loop or task name */
+#define RUNLOOP_WEIGHT_DEFAULT 16   /**< Default task weight */
+#define RUNLOOP_WEIGHT_MAX     1024 /**< Max task weight */
+
+/**
+ * Flags used in runloop_task_cfg_t.flags value
+ */
+enum {
+    RUNLOOP_TASK_IDLE = (1 << 0), /**< Only run when all other tasks have no work */
+};
+
+/**
+ * The poll function of a task.
+ *
+ * @param arg
+ *   The argument given to runloop_task_add()
+ * @return
+ *   The amount of work done, e.g. packets or events, 0 when idle or -1 to remove the task
+ */
+typedef int (*runloop_func_t)(void *arg);
+
+/**
+ * Task scheduling configuration, a zeroed structure is a weighted task with the default
+ * weight called once per slice.
+ */
+typedef struct runloop_task_cfg {
+    uint16_t weight;    /**< Share of the thread, 0 for RUNLOOP_WEIGHT_DEFAULT */
+    uint16_t flags;     /**< RUNLOOP_TASK_XXX flags */
+    uint32_t budget_us; /**< Time a slice can keep calling the task while it has work */
+    uint32_t period_us; /**< Run the task once per period, 0 for a weighted task */
+} runloop_task_cfg_t;
+
+/**
+ * Task statistics
+ */
+typedef struct runloop_stats {
+    uint64_t calls;    /**< Number of calls to the poll function */
+    uint64_t slices;   /**< Number of times the task was selected */
+    uint64_t idle;     /**< Number of calls returning no work */
+    uint64_t work;     /**< Sum of the work returned by the poll function */
+    uint64_t cycles;   /**< TSC cycles spent in the poll function */
+    uint64_t max;      /**< Longest slice in TSC cycles */
+    uint64_t overruns; /**< Slices longer than the budget */
+    uint64_t late;     /**< Periodic runs started a period or more after the deadline */
+    double util;       /**< Percent of the run-loop time spent in the task */
+} runloop_stats_t;
+
+typedef struct runloop runloop_t; /**< Opaque run-loop structure */
+
+/**
+ * Create a run-loop
+ *
+ * @param name
+ *   The name of the run-loop
+ * @return
+ *   NULL on error or the run-loop pointer
+ */
+CNDP_API runloop_t *runloop_create(const char *name);
+
+/**
+ * Destroy a run-loop
+ *
+ * @param rl
+ *   The run-loop pointer, can be NULL
+ */
+CNDP_API void runloop_destroy(runloop_t *rl);
+
+/**
+ * Add a task to a run-loop
+ *
+ * @param rl
+ *   The run-loop pointer
+ * @param name
+ *   The name of the task
+ * @param func
+ *   The poll function to call
+ * @param arg
+ *   The argument passed to the poll function
+ * @param cfg
+ *   The task configuration or NULL for the defaults
+ * @return
+ *   -1 on error or the task ID
+ */
+CNDP_API int runloop_task_add(runloop_t *rl, const char *name, runloop_func_t func, void *arg,
+                              const runloop_task_cfg_t *cfg);
+
+/**
+ * Remove a task from a run-loop, can be called from a poll function
+ *
+ * @param rl
+ *   The run-loop pointer
+ * @param tid
+ *   The task ID returned by runloop_task_add()
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int runloop_task_del(runloop_t *rl, int tid);
+
+/**
+ * Select and run a single task slice
+ *
+ * @param rl
+ *   The run-loop pointer
+ * @return
+ *   -1 on error or the work done by the task
+ */
+CNDP_API int runloop_run_once(runloop_t *rl);
+
+/**
+ * Run the tasks until runloop_stop() is called or the thread is asked to stop with
+ * thread_stop_running().
+ *
+ * @param rl
+ *   The run-loop pointer
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int runloop_run(runloop_t *rl);
+
+/**
+ * Stop runloop_run() after the current slice, can be called from a poll function
+ *
+ * @param rl
+ *   The run-loop pointer
+ */
+CNDP_API void runloop_stop(runloop_t *rl);
+
+/**
+ * Return the statistics of a task
+ *
+ * @param rl
+ *   The run-loop pointer
+ * @param tid
+ *   The task ID returned by runloop_task_add()
+ * @param stats
+ *   The location to copy the statistics
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int runloop_stats_get(runloop_t *rl, int tid, runloop_stats_t *stats);
+
+/**
+ * Reset the statistics of all tasks and the run-loop utilisation time base
+ *
+ * @param rl
+ *   The run-loop pointer
+ */
+CNDP_API void runloop_stats_reset(runloop_t *rl);
+
+/**
+ * Dump out the tasks and statistics of a run-loop
+ *
+ * @param f
+ *   The file pointer to write the text output or NULL if stdout
+ * @param rl
+ *   The run-loop pointer
+ */
+CNDP_API void runloop_dump(FILE *f, runloop_t *rl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_RUNLOOP_H_ */
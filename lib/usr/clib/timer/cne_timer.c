@@ -14,12 +14,75 @@
 #include <cne_branch_prediction.h>        // for likely
 #include <cne_spinlock.h>                 // for cne_spinlock_unlock, cne_spinlock...
 #include <cne_pause.h>                    // for cne_pause
+#include <cne_system.h>                   // for cne_get_timer_hz
+#include <cne_log.h>                      // for CNE_ERR
 #include <stddef.h>                       // for NULL
 
 #include "cne_timer.h"
 
+#define TIMER_WHEEL_BITS     8                         /**< Bits of tick per wheel level */
+#define TIMER_WHEEL_SIZE     (1U << TIMER_WHEEL_BITS)  /**< Slots per wheel level */
+#define TIMER_WHEEL_MASK     (TIMER_WHEEL_SIZE - 1)    /**< Slot index mask */
+#define TIMER_WHEEL_LEVELS   4                         /**< Number of wheel levels */
+#define TIMER_WHEEL_WORDS    (TIMER_WHEEL_SIZE / 64)   /**< Bitmap words per level */
+#define TIMER_WHEEL_TICK_HZ  1000000                   /**< Wanted wheel ticks per second */
+#define TIMER_WHEEL_SHIFT(l) ((l) * TIMER_WHEEL_BITS) /**< Tick shift of a level */
+
+/*
+ * Hierarchical timing wheel, level 0 holds the timers expiring in the next 256
+ * ticks, each higher level slot covers a whole rotation of the level below it.
+ * When level 0 wraps the matching slot of the next level is cascaded down,
+ * re-hashing its timers with the same insert routine. Timers beyond the reach
+ * of the last level are parked in its furthest slot and re-hashed on cascade.
+ */
+struct timer_wheel {
+    uint64_t now;                                                 /**< Last tick processed */
+    uint64_t count;                                               /**< Timers in the wheel */
+    uint64_t map[TIMER_WHEEL_LEVELS][TIMER_WHEEL_WORDS];          /**< Non-empty slots */
+    struct cne_timer *slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SIZE]; /**< Slot list heads */
+};
+
+/*
+ * The wheel backend does not use the skiplist, a timer in the wheel keeps its
+ * slot links in the first sl_next entries: the next timer of the slot, the
+ * previous next pointer and the level and slot index holding the timer.
+ */
+#define wh_next sl_next[0]
+
+static inline struct cne_timer **
+timer_wh_pprev(struct cne_timer *tim)
+{
+    return (struct cne_timer **)(void *)tim->sl_next[1];
+}
+
+static inline void
+timer_wh_pprev_set(struct cne_timer *tim, struct cne_timer **pprev)
+{
+    tim->sl_next[1] = (struct cne_timer *)(void *)pprev;
+}
+
+static inline unsigned
+timer_wh_slot(struct cne_timer *tim)
+{
+    return (unsigned)(uintptr_t)tim->sl_next[2];
+}
+
+static inline void
+timer_wh_slot_set(struct cne_timer *tim, unsigned slot)
+{
+    tim->sl_next[2] = (struct cne_timer *)(uintptr_t)slot;
+}
+
+/* remote request operations and states, kept in cne_timer.mq_op */
+#define TIMER_REQ_DEL     0x01 /**< Remove the timer from the list of the queue owner */
+#define TIMER_REQ_ADD     0x02 /**< Add the timer to the list of mq_thread */
+#define TIMER_REQ_QUEUED  0x04 /**< Request is on a queue and can still be updated */
+#define TIMER_REQ_BUSY    0x08 /**< Request is being updated by the requesting thread */
+#define TIMER_REQ_CLAIMED 0x10 /**< Request is being applied by the queue owner */
+
 struct priv_timer {
     struct cne_timer pending_head; /**< dummy timer instance to head up list */
+    struct timer_wheel *wheel;     /**< timing wheel when using the wheel backend */
     cne_spinlock_t list_lock;      /**< lock to protect list access */
 
     /** per-core variable that true if a timer was updated on this
@@ -36,11 +99,23 @@ struct priv_timer {
 
     /** per-thread statistics */
     struct cne_timer_debug_stats stats;
+
+    cne_timer_wakeup_cb_t wakeup; /**< wakes up the thread when a peer arms a timer on it */
+    void *wakeup_arg;             /**< argument to the wakeup function */
+
+    /** MPSC stack of timer requests from other threads, drained by cne_timer_manage() */
+    CNE_ATOMIC(uintptr_t) remote_head __cne_cache_aligned;
 } __cne_cache_aligned;
 
 /** per-thread private info for timers */
 static struct priv_timer *priv_timer;
 
+/** timer list backend used by all threads */
+static enum cne_timer_backend timer_backend = CNE_TIMER_BACKEND_SKIPLIST;
+
+/** TSC cycles to wheel tick shift */
+static uint32_t wheel_shift;
+
 /* when debug is enabled, store some statistics */
 #define __TIMER_STAT_ADD(name, n)                \
     do {                                         \
@@ -49,22 +124,78 @@ static struct priv_timer *priv_timer;
             priv_timer[__tid].stats.name += (n); \
     } while (0)
 
-/* Init the timer library. */
+/* Release the timer library resources */
 void
-cne_timer_subsystem_init(void)
+cne_timer_subsystem_fini(void)
 {
-    if (priv_timer)
+    if (!priv_timer)
         return;
 
+    for (int tid = 0; tid < cne_max_threads(); tid++)
+        free(priv_timer[tid].wheel);
+
+    free(priv_timer);
+    priv_timer    = NULL;
+    timer_backend = CNE_TIMER_BACKEND_SKIPLIST;
+}
+
+/* Init the timer library with the given timer list backend. */
+int
+cne_timer_subsystem_init_backend(enum cne_timer_backend backend)
+{
+    uint64_t hz, now;
+
+    if (backend != CNE_TIMER_BACKEND_SKIPLIST && backend != CNE_TIMER_BACKEND_WHEEL)
+        return -1;
+
+    if (priv_timer)
+        return (backend == timer_backend) ? 0 : -1;
+
     priv_timer = calloc(cne_max_threads(), sizeof(struct priv_timer));
     if (!priv_timer)
-        return;
+        return -1;
+
+    /* use the largest power of 2 tick that is not longer than a microsecond */
+    hz          = cne_get_timer_hz();
+    wheel_shift = 0;
+    while ((hz >> (wheel_shift + 1)) >= TIMER_WHEEL_TICK_HZ)
+        wheel_shift++;
+    now = cne_rdtsc() >> wheel_shift;
 
     /* since priv_timer is static, it's zeroed by default, so only init some fields. */
     for (int tid = 0; tid < cne_max_threads(); tid++) {
         cne_spinlock_init(&priv_timer[tid].list_lock);
         priv_timer[tid].prev_thread = tid;
+
+        if (backend == CNE_TIMER_BACKEND_WHEEL) {
+            priv_timer[tid].wheel = calloc(1, sizeof(struct timer_wheel));
+            if (!priv_timer[tid].wheel) {
+                cne_timer_subsystem_fini();
+                return -1;
+            }
+            priv_timer[tid].wheel->now = now;
+        }
     }
+    timer_backend = backend;
+
+    return 0;
+}
+
+/* Init the timer library. */
+void
+cne_timer_subsystem_init(void)
+{
+    if (priv_timer)
+        return;
+
+    (void)cne_timer_subsystem_init_backend(CNE_TIMER_BACKEND_SKIPLIST);
+}
+
+/* Return the timer list backend in use */
+enum cne_timer_backend
+cne_timer_backend_get(void)
+{
+    return timer_backend;
 }
 
 /* Initialize the timer handle tim for use */
@@ -156,6 +287,181 @@ timer_set_running_state(struct cne_timer *tim)
     return 0;
 }
 
+/* Return the wheel tick of an expire time, rounded up so a timer never fires early */
+static inline uint64_t
+timer_wheel_tick(uint64_t expire)
+{
+    return (expire >> wheel_shift) + ((expire & ((1ULL << wheel_shift) - 1)) != 0);
+}
+
+/*
+ * Hash a timer into the wheel, base is the first tick not yet processed.
+ * Call with lock held as necessary.
+ */
+static void
+timer_wheel_insert(struct timer_wheel *w, struct cne_timer *tim, uint64_t base)
+{
+    uint64_t t = timer_wheel_tick(tim->expire);
+    struct cne_timer **head;
+    unsigned lvl, idx;
+
+    if (t < base)
+        t = base;
+
+    /* find the lowest level where the tick is within one rotation of base */
+    for (lvl = 0; lvl < TIMER_WHEEL_LEVELS; lvl++)
+        if (((t >> TIMER_WHEEL_SHIFT(lvl)) - (base >> TIMER_WHEEL_SHIFT(lvl))) < TIMER_WHEEL_SIZE)
+            break;
+
+    if (lvl == TIMER_WHEEL_LEVELS) {
+        /* too far out, park it in the furthest slot of the last level */
+        lvl = TIMER_WHEEL_LEVELS - 1;
+        idx = ((base >> TIMER_WHEEL_SHIFT(lvl)) + TIMER_WHEEL_MASK) & TIMER_WHEEL_MASK;
+    } else
+        idx = (t >> TIMER_WHEEL_SHIFT(lvl)) & TIMER_WHEEL_MASK;
+
+    head         = &w->slot[lvl][idx];
+    tim->wh_next = *head;
+    timer_wh_pprev_set(tim, head);
+    timer_wh_slot_set(tim, (lvl << TIMER_WHEEL_BITS) | idx);
+    if (*head)
+        timer_wh_pprev_set(*head, &tim->wh_next);
+    *head = tim;
+
+    w->map[lvl][idx / 64] |= (1ULL << (idx % 64));
+    w->count++;
+}
+
+/*
+ * Unlink a timer from its wheel slot, a timer already taken off the wheel by
+ * cne_timer_manage() has a NULL previous next pointer and is left alone.
+ * Call with lock held as necessary.
+ */
+static void
+timer_wheel_remove(struct timer_wheel *w, struct cne_timer *tim)
+{
+    struct cne_timer **pprev = timer_wh_pprev(tim);
+    unsigned lvl             = timer_wh_slot(tim) >> TIMER_WHEEL_BITS;
+    unsigned idx             = timer_wh_slot(tim) & TIMER_WHEEL_MASK;
+
+    if (pprev == NULL)
+        return;
+
+    *pprev = tim->wh_next;
+    if (tim->wh_next)
+        timer_wh_pprev_set(tim->wh_next, pprev);
+    timer_wh_pprev_set(tim, NULL);
+
+    if (w->slot[lvl][idx] == NULL)
+        w->map[lvl][idx / 64] &= ~(1ULL << (idx % 64));
+    w->count--;
+}
+
+/* Detach the whole list of a wheel slot, timers keep their wh_next links */
+static struct cne_timer *
+timer_wheel_take(struct timer_wheel *w, unsigned lvl, unsigned idx)
+{
+    struct cne_timer *list = w->slot[lvl][idx];
+
+    w->slot[lvl][idx] = NULL;
+    w->map[lvl][idx / 64] &= ~(1ULL << (idx % 64));
+
+    return list;
+}
+
+/* Re-hash the higher level slots that come due at tick n, highest level first */
+static void
+timer_wheel_cascade(struct timer_wheel *w, uint64_t n)
+{
+    struct cne_timer *tim, *next;
+    unsigned lvl = 1;
+
+    while (lvl < TIMER_WHEEL_LEVELS - 1 &&
+           ((n >> TIMER_WHEEL_SHIFT(lvl)) & TIMER_WHEEL_MASK) == 0)
+        lvl++;
+
+    for (; lvl > 0; lvl--) {
+        tim = timer_wheel_take(w, lvl, (n >> TIMER_WHEEL_SHIFT(lvl)) & TIMER_WHEEL_MASK);
+        for (; tim != NULL; tim = next) {
+            next = tim->wh_next;
+            w->count--;
+            timer_wheel_insert(w, tim, n);
+        }
+    }
+}
+
+/*
+ * Return the first tick in [n, last] with a non-empty level 0 slot, where last
+ * is the end of the level 0 rotation holding n or limit whichever is lower.
+ * Returns last when all slots in the range are empty.
+ */
+static uint64_t
+timer_wheel_next_slot(struct timer_wheel *w, uint64_t n, uint64_t limit)
+{
+    uint64_t last = n | TIMER_WHEEL_MASK;
+    unsigned idx  = n & TIMER_WHEEL_MASK;
+    uint64_t bits;
+
+    if (last > limit)
+        last = limit;
+
+    for (unsigned word = idx / 64; word < TIMER_WHEEL_WORDS; word++) {
+        bits = w->map[0][word];
+        if (word == idx / 64)
+            bits &= ~0ULL << (idx % 64);
+        if (bits) {
+            uint64_t m = (n & ~(uint64_t)TIMER_WHEEL_MASK) + (word * 64) + cne_bsf64(bits);
+
+            return (m < last) ? m : last;
+        }
+    }
+
+    return last;
+}
+
+/*
+ * Advance the wheel of a thread up to cur_time, returning the expired timers
+ * linked by wh_next (sl_next[0]). Empty level 0 slots are skipped using the
+ * slot bitmap, so the cost is bound by the number of non-empty slots and
+ * level 0 rotations rather than elapsed ticks.
+ * Call with lock held.
+ */
+static struct cne_timer *
+timer_wheel_expire(struct timer_wheel *w, uint64_t cur_time)
+{
+    uint64_t cur                    = cur_time >> wheel_shift;
+    struct cne_timer *run_first_tim = NULL, **tail = &run_first_tim;
+    struct cne_timer *tim;
+    uint64_t n;
+
+    while (w->now < cur) {
+        if (w->count == 0) {
+            w->now = cur;
+            break;
+        }
+
+        n = w->now + 1;
+        if ((n & TIMER_WHEEL_MASK) == 0)
+            timer_wheel_cascade(w, n);
+
+        n      = timer_wheel_next_slot(w, n, cur);
+        w->now = n;
+
+        /* bulk expiry, splice the whole slot onto the run list */
+        tim = timer_wheel_take(w, 0, n & TIMER_WHEEL_MASK);
+        if (tim == NULL)
+            continue;
+        *tail = tim;
+        for (; tim != NULL; tim = tim->wh_next) {
+            timer_wh_pprev_set(tim, NULL);
+            tail = &tim->wh_next;
+            w->count--;
+        }
+    }
+
+    return run_first_tim;
+}
+
 /*
  * Return a skiplist level for a new entry.
  * This probabilistically gives a level with p=1/4 that an entry at level n
@@ -229,6 +535,13 @@ timer_add(struct cne_timer *tim, unsigned int tim_thread)
     unsigned lvl;
     struct cne_timer *prev[MAX_SKIPLIST_DEPTH + 1] = {0};
 
+    if (timer_backend == CNE_TIMER_BACKEND_WHEEL) {
+        struct timer_wheel *w = priv_timer[tim_thread].wheel;
+
+        timer_wheel_insert(w, tim, w->now + 1);
+        return;
+    }
+
     /* find where exactly this element goes in the list of elements
      * for each depth. */
     timer_get_prev_entries(tim->expire, tim_thread, prev);
@@ -254,23 +567,20 @@ timer_add(struct cne_timer *tim, unsigned int tim_thread)
 }
 
 /*
- * del from list, lock if needed
+ * del from the list of a thread, call with the list lock of the thread held
  * timer must be in config state
  * timer must be in a list
  */
 static void
-timer_del(struct cne_timer *tim, union cne_timer_status prev_status, int local_is_locked)
+timer_del_locked(struct cne_timer *tim, unsigned prev_owner)
 {
-    unsigned tid        = cne_id();
-    unsigned prev_owner = prev_status.owner;
     int i;
     struct cne_timer *prev[MAX_SKIPLIST_DEPTH + 1] = {0};
 
-    /* if timer needs is pending another core, we need to lock the
-     * list; if it is on local core, we need to lock if we are not
-     * called from cne_timer_manage() */
-    if (prev_owner != tid || !local_is_locked)
-        cne_spinlock_lock(&priv_timer[prev_owner].list_lock);
+    if (timer_backend == CNE_TIMER_BACKEND_WHEEL) {
+        timer_wheel_remove(priv_timer[prev_owner].wheel, tim);
+        return;
+    }
 
     /* save the lowest list entry into the expire field of the dummy hdr.
      * NOTE: this is not atomic on 32-bit */
@@ -291,15 +601,203 @@ timer_del(struct cne_timer *tim, union cne_timer_status prev_status, int local_i
             priv_timer[prev_owner].curr_skiplist_depth--;
         else
             break;
+}
+
+/*
+ * del from list, lock if needed
+ * timer must be in config state
+ * timer must be in a list
+ */
+static void
+timer_del(struct cne_timer *tim, union cne_timer_status prev_status, int local_is_locked)
+{
+    unsigned tid        = cne_id();
+    unsigned prev_owner = prev_status.owner;
+
+    /* if timer needs is pending another core, we need to lock the
+     * list; if it is on local core, we need to lock if we are not
+     * called from cne_timer_manage() */
+    if (prev_owner != tid || !local_is_locked)
+        cne_spinlock_lock(&priv_timer[prev_owner].list_lock);
+
+    timer_del_locked(tim, prev_owner);
 
     if (prev_owner != tid || !local_is_locked)
         cne_spinlock_unlock(&priv_timer[prev_owner].list_lock);
 }
 
+/* Wake up another thread that may be blocked until a later timer than the one just armed */
+static inline void
+timer_wakeup(unsigned tim_thread)
+{
+    cne_timer_wakeup_cb_t fn = priv_timer[tim_thread].wakeup;
+
+    if (fn && tim_thread != (unsigned)cne_id())
+        fn(priv_timer[tim_thread].wakeup_arg);
+}
+
+/* Push a timer on the remote request queue of a thread, safe for any thread to call */
+static void
+timer_remote_push(struct cne_timer *tim, unsigned tim_thread)
+{
+    uintptr_t head =
+        atomic_load_explicit(&priv_timer[tim_thread].remote_head, memory_order_relaxed);
+
+    do {
+        tim->mq_next = (struct cne_timer *)head;
+    } while (!atomic_compare_exchange_weak_explicit(&priv_timer[tim_thread].remote_head, &head,
+                                                    (uintptr_t)tim, memory_order_release,
+                                                    memory_order_relaxed));
+    __TIMER_STAT_ADD(remote, 1);
+
+    /* the push onto a non-empty queue already had its wakeup */
+    if (head == 0)
+        timer_wakeup(tim_thread);
+}
+
+/*
+ * Queue a request for a timer to a thread.
+ * timer must be in config state owned by the caller or claimed by a queue owner
+ */
+static void
+timer_remote_request(struct cne_timer *tim, uint32_t op, unsigned queue_thread)
+{
+    atomic_store_explicit(&tim->mq_op, op | TIMER_REQ_QUEUED, memory_order_relaxed);
+    timer_remote_push(tim, queue_thread);
+}
+
+/*
+ * Update the request this thread has queued for a timer in place, the timer
+ * stays on the same queue and only the operation and parameters change.
+ * Returns -1 when the timer has no request queued by this thread.
+ */
+static int
+timer_remote_update(struct cne_timer *tim, uint64_t expire, uint64_t period, unsigned tim_thread,
+                    cne_timer_cb_t fct, void *arg, int add)
+{
+    union cne_timer_status status;
+    uint32_t op;
+
+    status.u32 = tim->status.u32;
+    if (status.state != CNE_TIMER_CONFIG || status.owner != (int16_t)cne_id())
+        return -1;
+
+    for (;;) {
+        op = atomic_load_explicit(&tim->mq_op, memory_order_acquire);
+        if (!(op & (TIMER_REQ_QUEUED | TIMER_REQ_CLAIMED)))
+            return -1;
+
+        /* wait for the queue owner to apply or forward the request */
+        if (op & TIMER_REQ_CLAIMED) {
+            cne_pause();
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&tim->mq_op, &op, TIMER_REQ_BUSY,
+                                                  memory_order_acquire, memory_order_relaxed))
+            break;
+    }
+
+    if (add) {
+        tim->period    = period;
+        tim->f         = fct;
+        tim->arg       = arg;
+        tim->mq_expire = expire;
+        tim->mq_thread = (uint16_t)tim_thread;
+        if (!(op & TIMER_REQ_ADD))
+            __TIMER_STAT_ADD(pending, 1);
+    } else if (op & TIMER_REQ_ADD)
+        __TIMER_STAT_ADD(pending, -1);
+
+    /* a removal is still needed if the timer is on the list of the queue owner */
+    op = TIMER_REQ_QUEUED | (op & TIMER_REQ_DEL) | (add ? TIMER_REQ_ADD : 0);
+    atomic_store_explicit(&tim->mq_op, op, memory_order_release);
+
+    return 0;
+}
+
+/*
+ * Apply the requests other threads queued for a thread. Normally called by the
+ * owner of the queue, but any thread may apply them as the list of the owner
+ * is only changed under its lock. A timer has at most one request in flight,
+ * so the order the requests are applied in does not matter.
+ */
+static void
+timer_remote_drain(unsigned tid)
+{
+    union cne_timer_status status;
+    struct cne_timer *tim, *next;
+    uint32_t op;
+
+    tim = (struct cne_timer *)atomic_exchange_explicit(&priv_timer[tid].remote_head, 0,
+                                                       memory_order_acquire);
+
+    for (; tim != NULL; tim = next) {
+        next = tim->mq_next;
+
+        /* claim the request, waiting out an update by the requesting thread */
+        for (;;) {
+            op = atomic_load_explicit(&tim->mq_op, memory_order_acquire);
+            if (op & TIMER_REQ_BUSY) {
+                cne_pause();
+                continue;
+            }
+            if (atomic_compare_exchange_weak_explicit(&tim->mq_op, &op, TIMER_REQ_CLAIMED,
+                                                      memory_order_acquire, memory_order_relaxed))
+                break;
+        }
+
+        cne_spinlock_lock(&priv_timer[tid].list_lock);
+
+        if (op & TIMER_REQ_DEL)
+            timer_del_locked(tim, tid);
+
+        /* the timer moves to another thread, forward the arm request */
+        if ((op & TIMER_REQ_ADD) && tim->mq_thread != tid) {
+            cne_spinlock_unlock(&priv_timer[tid].list_lock);
+            timer_remote_request(tim, TIMER_REQ_ADD, tim->mq_thread);
+            continue;
+        }
+
+        if (op & TIMER_REQ_ADD) {
+            tim->expire = tim->mq_expire;
+            timer_add(tim, tid);
+            status.state = CNE_TIMER_PENDING;
+            status.owner = (int16_t)tid;
+        } else {
+            status.state = CNE_TIMER_STOP;
+            status.owner = CNE_TIMER_NO_OWNER;
+        }
+
+        /*
+         * The request is done, clear it before the new status is published. Once
+         * the status leaves CONFIG any thread may queue a new request for the timer,
+         * which a later clear would wipe out.
+         */
+        op = TIMER_REQ_CLAIMED;
+        if (!atomic_compare_exchange_strong_explicit(&tim->mq_op, &op, 0, memory_order_release,
+                                                     memory_order_relaxed))
+            CNE_ERR("Timer %p request changed while claimed 0x%x\n", tim, op);
+
+        cne_compiler_barrier();
+        tim->status.u32 = status.u32;
+
+        cne_spinlock_unlock(&priv_timer[tid].list_lock);
+    }
+}
+
+/* Apply the requests queued to every thread, a queued timer may wait on any of them */
+static void
+timer_remote_drain_all(void)
+{
+    for (int tid = 0; tid < cne_max_threads(); tid++)
+        if (atomic_load_explicit(&priv_timer[tid].remote_head, memory_order_relaxed) != 0)
+            timer_remote_drain(tid);
+}
+
 /* Reset and start the timer associated with the timer handle (private func) */
 static int
 __cne_timer_reset(struct cne_timer *tim, uint64_t expire, uint64_t period, unsigned tim_thread,
-                  cne_timer_cb_t fct, void *arg, int local_is_locked)
+                  cne_timer_cb_t fct, void *arg, int local_is_locked, int async)
 {
     union cne_timer_status prev_status, status;
     int ret;
@@ -311,6 +809,12 @@ __cne_timer_reset(struct cne_timer *tim, uint64_t expire, uint64_t period, unsig
         priv_timer[tid].prev_thread = tim_thread;
     }
 
+    /* a request this thread already queued for the timer is updated in place */
+    if (async && timer_remote_update(tim, expire, period, tim_thread, fct, arg, 1) == 0) {
+        __TIMER_STAT_ADD(reset, 1);
+        return 0;
+    }
+
     /* wait that the timer is in correct status before update,
      * and mark it as being configured */
     ret = timer_set_config_state(tim, &prev_status);
@@ -321,16 +825,34 @@ __cne_timer_reset(struct cne_timer *tim, uint64_t expire, uint64_t period, unsig
     if (prev_status.state == CNE_TIMER_RUNNING)
         priv_timer[tid].updated = 1;
 
+    tim->period = period;
+    tim->f      = fct;
+    tim->arg    = arg;
+
+    /* the timer is on the list of another thread, let that thread move it */
+    if (async && prev_status.state == CNE_TIMER_PENDING && prev_status.owner != (int16_t)tid) {
+        tim->mq_expire = expire;
+        tim->mq_thread = (uint16_t)tim_thread;
+        timer_remote_request(tim, TIMER_REQ_DEL | TIMER_REQ_ADD, prev_status.owner);
+        return 0;
+    }
+
     /* remove it from list */
     if (prev_status.state == CNE_TIMER_PENDING) {
         timer_del(tim, prev_status, local_is_locked);
         __TIMER_STAT_ADD(pending, -1);
     }
 
-    tim->period = period;
     tim->expire = expire;
-    tim->f      = fct;
-    tim->arg    = arg;
+
+    /* let the destination thread add it to its list without taking its lock */
+    if (async && tim_thread != tid) {
+        __TIMER_STAT_ADD(pending, 1);
+        tim->mq_expire = expire;
+        tim->mq_thread = (uint16_t)tim_thread;
+        timer_remote_request(tim, TIMER_REQ_ADD, tim_thread);
+        return 0;
+    }
 
     /* if timer needs to be scheduled on another core, we need to
      * lock the destination list; if it is on local core, we need to lock if
@@ -352,6 +874,9 @@ __cne_timer_reset(struct cne_timer *tim, uint64_t expire, uint64_t period, unsig
     if (tim_thread != tid || !local_is_locked)
         cne_spinlock_unlock(&priv_timer[tim_thread].list_lock);
 
+    if (tim_thread != tid)
+        timer_wakeup(tim_thread);
+
     return 0;
 }
 
@@ -366,21 +891,26 @@ cne_timer_reset(struct cne_timer *tim, uint64_t ticks, enum cne_timer_type type,
     cur_time = cne_rdtsc();
     period   = (type == PERIODICAL) ? ticks : 0;
 
-    return __cne_timer_reset(tim, cur_time + ticks, period, tim_thread, fct, arg, 0);
+    return __cne_timer_reset(tim, cur_time + ticks, period, tim_thread, fct, arg, 0, 1);
 }
 
-/* loop until cne_timer_reset() succeed */
+/* loop until the timer is reset, updating the other thread's list under its lock */
 void
 cne_timer_reset_sync(struct cne_timer *tim, uint64_t ticks, enum cne_timer_type type,
                      unsigned tim_thread, cne_timer_cb_t fct, void *arg)
 {
-    while (cne_timer_reset(tim, ticks, type, tim_thread, fct, arg) != 0)
+    uint64_t period = (type == PERIODICAL) ? ticks : 0;
+
+    while (__cne_timer_reset(tim, cne_rdtsc() + ticks, period, tim_thread, fct, arg, 0, 0) != 0) {
+        /* the timer may be waiting on a request queued to a thread not calling manage */
+        timer_remote_drain_all();
         cne_pause();
+    }
 }
 
-/* Stop the timer associated with the timer handle tim */
-int
-cne_timer_stop(struct cne_timer *tim)
+/* Stop the timer associated with the timer handle tim (private func) */
+static int
+__cne_timer_stop(struct cne_timer *tim, int async)
 {
     union cne_timer_status prev_status, status;
     unsigned tid = cne_id();
@@ -389,20 +919,30 @@ cne_timer_stop(struct cne_timer *tim)
     if (!tim)
         return -1;
 
+    /* a request this thread already queued for the timer is turned into a stop,
+     * the timer is not stopped until the queue owner has applied it */
+    if (async && timer_remote_update(tim, 0, 0, 0, NULL, NULL, 0) == 0)
+        return -1;
+
     /* wait that the timer is in correct status before update,
      * and mark it as being configured */
     ret = timer_set_config_state(tim, &prev_status);
     if (ret < 0)
         return -1;
 
-    __TIMER_STAT_ADD(stop, 1);
     if (prev_status.state == CNE_TIMER_RUNNING)
         priv_timer[tid].updated = 1;
 
     /* remove it from list */
     if (prev_status.state == CNE_TIMER_PENDING) {
-        timer_del(tim, prev_status, 0);
         __TIMER_STAT_ADD(pending, -1);
+
+        /* the owner removes it from its list and marks it stopped */
+        if (async && prev_status.owner != (int16_t)tid) {
+            timer_remote_request(tim, TIMER_REQ_DEL, prev_status.owner);
+            return -1;
+        }
+        timer_del(tim, prev_status, 0);
     }
 
     /* mark timer as stopped */
@@ -411,15 +951,39 @@ cne_timer_stop(struct cne_timer *tim)
     status.owner    = CNE_TIMER_NO_OWNER;
     tim->status.u32 = status.u32;
 
+    __TIMER_STAT_ADD(stop, 1);
     return 0;
 }
 
-/* loop until cne_timer_stop() succeed */
+/* Stop the timer associated with the timer handle tim */
+int
+cne_timer_stop(struct cne_timer *tim)
+{
+    return __cne_timer_stop(tim, 1);
+}
+
+/* loop until the timer is stopped, updating the other thread's list under its lock */
 void
 cne_timer_stop_sync(struct cne_timer *tim)
 {
-    while (cne_timer_stop(tim) != 0)
+    while (__cne_timer_stop(tim, 0) != 0) {
+        /* the timer may be waiting on a request queued to a thread not calling manage */
+        timer_remote_drain_all();
         cne_pause();
+    }
+}
+
+/* Apply the requests queued to a thread on behalf of that thread */
+int
+cne_timer_drain(unsigned tim_thread)
+{
+    if (!priv_timer || tim_thread >= (unsigned)cne_max_threads())
+        return -1;
+
+    if (atomic_load_explicit(&priv_timer[tim_thread].remote_head, memory_order_acquire) != 0)
+        timer_remote_drain(tim_thread);
+
+    return 0;
 }
 
 /* Test the PENDING status of the timer handle tim */
@@ -429,39 +993,75 @@ cne_timer_pending(struct cne_timer *tim)
     return tim->status.state == CNE_TIMER_PENDING;
 }
 
-/* must be called periodically, run all timer that expired */
-void
-cne_timer_manage(void)
+/* return the ticks until the first pending timer of this thread expires */
+int64_t
+cne_timer_next_ticks(void)
 {
-    union cne_timer_status status;
-    struct cne_timer *tim, *next_tim;
-    struct cne_timer *run_first_tim, **pprev;
-    unsigned tid                                   = cne_id();
-    struct cne_timer *prev[MAX_SKIPLIST_DEPTH + 1] = {0};
-    uint64_t cur_time;
-    int i, ret;
+    unsigned tid = cne_id();
+    uint64_t cur_time, expire = 0;
+    int pending;
+
+    /* queued requests may arm a timer, cne_timer_manage() must apply them first */
+    if (atomic_load_explicit(&priv_timer[tid].remote_head, memory_order_acquire) != 0)
+        return 0;
+
+    /* other threads add timers to this list under the lock */
+    cne_spinlock_lock(&priv_timer[tid].list_lock);
+    if (timer_backend == CNE_TIMER_BACKEND_WHEEL) {
+        struct timer_wheel *w = priv_timer[tid].wheel;
+
+        /* the next non-empty level 0 slot or the next cascade, which may be early */
+        pending = (w->count != 0);
+        if (pending)
+            expire = timer_wheel_next_slot(w, w->now + 1, UINT64_MAX) << wheel_shift;
+    } else {
+        /* the cached expire of the dummy head is the earliest pending timer */
+        pending = (priv_timer[tid].pending_head.sl_next[0] != NULL);
+        expire  = priv_timer[tid].pending_head.expire;
+    }
+    cne_spinlock_unlock(&priv_timer[tid].list_lock);
+
+    if (!pending)
+        return -1;
 
-    __TIMER_STAT_ADD(manage, 1);
-    /* optimize for the case where per-thread list is empty */
-    if (priv_timer[tid].pending_head.sl_next[0] == NULL)
-        return;
     cur_time = cne_rdtsc();
 
-    /* on 64-bit the value cached in the pending_head.expired will be
-     * updated atomically, so we can consult that for a quick check here
-     * outside the lock */
-    if (likely(priv_timer[tid].pending_head.expire > cur_time))
-        return;
+    return (expire > cur_time) ? (int64_t)(expire - cur_time) : 0;
+}
+
+/* set the function waking up this thread when another thread arms a timer on it */
+int
+cne_timer_wakeup_set(cne_timer_wakeup_cb_t fn, void *arg)
+{
+    unsigned tid = cne_id();
+
+    if (!priv_timer || tid >= (unsigned)cne_max_threads())
+        return -1;
 
-    /* browse ordered list, add expired timers in 'expired' list */
     cne_spinlock_lock(&priv_timer[tid].list_lock);
+    priv_timer[tid].wakeup_arg = arg;
+    priv_timer[tid].wakeup     = fn;
+    cne_spinlock_unlock(&priv_timer[tid].list_lock);
 
-    /* if nothing to do just unlock and return */
+    return 0;
+}
+
+/*
+ * Break the skiplist of a thread at cur_time, returning the expired timers
+ * linked by sl_next[0].
+ * Call with lock held.
+ */
+static struct cne_timer *
+timer_skiplist_expire(unsigned tid, uint64_t cur_time)
+{
+    struct cne_timer *prev[MAX_SKIPLIST_DEPTH + 1] = {0};
+    struct cne_timer *tim;
+    int i;
+
+    /* if nothing to do just return */
     if (priv_timer[tid].pending_head.sl_next[0] == NULL ||
-        priv_timer[tid].pending_head.sl_next[0]->expire > cur_time) {
-        cne_spinlock_unlock(&priv_timer[tid].list_lock);
-        return;
-    }
+        priv_timer[tid].pending_head.sl_next[0]->expire > cur_time)
+        return NULL;
 
     /* save start of list of expired timers */
     tim = priv_timer[tid].pending_head.sl_next[0];
@@ -477,6 +1077,66 @@ cne_timer_manage(void)
         prev[i]->sl_next[i] = NULL;
     }
 
+    /* update the next to expire timer value */
+    priv_timer[tid].pending_head.expire = (priv_timer[tid].pending_head.sl_next[0] == NULL)
+                                              ? 0
+                                              : priv_timer[tid].pending_head.sl_next[0]->expire;
+
+    return tim;
+}
+
+/* must be called periodically, run all timer that expired */
+void
+cne_timer_manage(void)
+{
+    union cne_timer_status status;
+    struct cne_timer *tim, *next_tim;
+    struct cne_timer *run_first_tim, **pprev;
+    unsigned tid = cne_id();
+    uint64_t cur_time;
+    int ret;
+
+    __TIMER_STAT_ADD(manage, 1);
+
+    /* apply the arm and stop requests other threads queued for us */
+    if (atomic_load_explicit(&priv_timer[tid].remote_head, memory_order_relaxed) != 0)
+        timer_remote_drain(tid);
+
+    if (timer_backend == CNE_TIMER_BACKEND_WHEEL) {
+        struct timer_wheel *w = priv_timer[tid].wheel;
+
+        /* optimize for the case where the wheel is empty or the tick has not moved */
+        if (w->count == 0)
+            return;
+        cur_time = cne_rdtsc();
+        if (likely((cur_time >> wheel_shift) <= w->now))
+            return;
+
+        cne_spinlock_lock(&priv_timer[tid].list_lock);
+        tim = timer_wheel_expire(w, cur_time);
+    } else {
+        /* optimize for the case where per-thread list is empty */
+        if (priv_timer[tid].pending_head.sl_next[0] == NULL)
+            return;
+        cur_time = cne_rdtsc();
+
+        /* on 64-bit the value cached in the pending_head.expired will be
+         * updated atomically, so we can consult that for a quick check here
+         * outside the lock */
+        if (likely(priv_timer[tid].pending_head.expire > cur_time))
+            return;
+
+        /* browse ordered list, add expired timers in 'expired' list */
+        cne_spinlock_lock(&priv_timer[tid].list_lock);
+        tim = timer_skiplist_expire(tid, cur_time);
+    }
+
+    /* if nothing to do just unlock and return */
+    if (tim == NULL) {
+        cne_spinlock_unlock(&priv_timer[tid].list_lock);
+        return;
+    }
+
     /* transition run-list from PENDING to RUNNING */
     run_first_tim = tim;
     pprev         = &run_first_tim;
@@ -495,11 +1155,6 @@ cne_timer_manage(void)
         }
     }
 
-    /* update the next to expire timer value */
-    priv_timer[tid].pending_head.expire = (priv_timer[tid].pending_head.sl_next[0] == NULL)
-                                              ? 0
-                                              : priv_timer[tid].pending_head.sl_next[0]->expire;
-
     cne_spinlock_unlock(&priv_timer[tid].list_lock);
 
     /* now scan expired list and call callbacks */
@@ -532,7 +1187,7 @@ cne_timer_manage(void)
             cne_compiler_barrier();
             tim->status.u32 = status.u32;
             __cne_timer_reset(tim, tim->expire + tim->period, tim->period, tid, tim->f, tim->arg,
-                              1);
+                              1, 0);
             cne_spinlock_unlock(&priv_timer[tid].list_lock);
         }
     }
@@ -555,10 +1210,12 @@ cne_timer_dump_stats(FILE *f)
         sum.stop += priv_timer[tid].stats.stop;
         sum.manage += priv_timer[tid].stats.manage;
         sum.pending += priv_timer[tid].stats.pending;
+        sum.remote += priv_timer[tid].stats.remote;
     }
     fprintf(f, "Timer statistics:\n");
     fprintf(f, "  reset = %" PRIu64 "\n", sum.reset);
     fprintf(f, "  stop = %" PRIu64 "\n", sum.stop);
     fprintf(f, "  manage = %" PRIu64 "\n", sum.manage);
     fprintf(f, "  pending = %" PRIu64 "\n", sum.pending);
+    fprintf(f, "  remote = %" PRIu64 "\n", sum.remote);
 }
@@ -72,6 +72,7 @@ struct cne_timer_debug_stats {
     uint64_t stop;    /**< Number of success calls to cne_timer_stop(). */
     uint64_t manage;  /**< Number of calls to cne_timer_manage(). */
     uint64_t pending; /**< Number of pending/running timers. */
+    uint64_t remote;  /**< Number of requests queued to another thread. */
 };
 
 struct cne_timer;
@@ -81,18 +82,39 @@ struct cne_timer;
  */
 typedef void (*cne_timer_cb_t)(struct cne_timer *, void *);
 
+/**
+ * Callback function type to wake up a thread blocked until its next timer.
+ */
+typedef void (*cne_timer_wakeup_cb_t)(void *);
+
 #define MAX_SKIPLIST_DEPTH 10
 
+/**
+ * Timer list implementation used by the per-thread pending lists.
+ */
+enum cne_timer_backend {
+    CNE_TIMER_BACKEND_SKIPLIST, /**< Ordered skiplist, O(log n) arm/cancel (default) */
+    CNE_TIMER_BACKEND_WHEEL,    /**< Hierarchical timing wheel, O(1) arm/cancel */
+};
+
 /**
  * A structure describing a timer in CNE.
+ *
+ * The mq_* fields hold the request queued to another thread by cne_timer_reset()
+ * and cne_timer_stop(). They grew the structure in this release, which is an ABI
+ * change: code embedding a struct cne_timer must be rebuilt against this header.
  */
 struct cne_timer {
     uint64_t expire;                               /**< Time when timer expire. */
-    struct cne_timer *sl_next[MAX_SKIPLIST_DEPTH]; /**< Skiplist for timers */
+    struct cne_timer *sl_next[MAX_SKIPLIST_DEPTH]; /**< Skiplist or wheel slot links */
     volatile union cne_timer_status status;        /**< Status of timer. */
     uint64_t period;                               /**< Period of timer (0 if not periodic). */
     cne_timer_cb_t f;                              /**< Callback function. */
     void *arg;                                     /**< Argument to callback function. */
+    struct cne_timer *mq_next;                     /**< Next timer in a remote request queue */
+    uint64_t mq_expire;                            /**< Expire time of a queued remote arm */
+    CNE_ATOMIC(uint_least32_t) mq_op;              /**< Queued remote request, 0 when none */
+    uint16_t mq_thread;                            /**< Thread a queued remote arm runs on */
 };
 
 #ifdef __cplusplus
@@ -124,6 +146,39 @@ struct cne_timer {
  */
 void cne_timer_subsystem_init(void);
 
+/**
+ * Initialize the timer library with a given timer list backend.
+ *
+ * The skiplist keeps every thread's timers sorted by expire time, arming and
+ * cancelling a timer is O(log n). The hierarchical timing wheel hashes timers
+ * into 4 levels of 256 slots using a tick of about one microsecond, arming and
+ * cancelling are O(1) and a whole slot of expired timers is taken at once. A
+ * timer on the wheel never fires early, but can fire up to one tick late.
+ *
+ * The backend can only be changed after cne_timer_subsystem_fini().
+ *
+ * @param backend
+ *   The timer list backend to use for all threads.
+ * @return
+ *   0 on success or -1 on error, already initialized with another backend.
+ */
+int cne_timer_subsystem_init_backend(enum cne_timer_backend backend);
+
+/**
+ * Release the resources of the timer library.
+ *
+ * All timers must be stopped or expired before calling this function.
+ */
+void cne_timer_subsystem_fini(void);
+
+/**
+ * Return the timer list backend in use.
+ *
+ * @return
+ *   The backend selected at cne_timer_subsystem_init_backend() time.
+ */
+enum cne_timer_backend cne_timer_backend_get(void);
+
 /**
  * Initialize a timer handle.
  *
@@ -155,6 +210,13 @@ void cne_timer_init(struct cne_timer *tim);
  * If the timer is pending or stopped, it will be rescheduled with the
  * new parameters.
  *
+ * When the timer has to be added to or removed from the list of another
+ * thread, the request is put on that thread's lock free queue and applied at
+ * the start of its next cne_timer_manage() call. Until then the timer stays in
+ * the CONFIG state, further calls from the same thread update the queued
+ * request and calls from other threads fail. When that thread may not call
+ * cne_timer_manage() again, apply the request with cne_timer_drain().
+ *
  * @param tim
  *   The timer handle.
  * @param ticks
@@ -186,6 +248,9 @@ int cne_timer_reset(struct cne_timer *tim, uint64_t ticks, enum cne_timer_type t
  * Reset and start the timer associated with the timer handle. Always
  * succeed. See cne_timer_reset() for details.
  *
+ * The timer lists of other threads are updated directly under their lock,
+ * the timer is PENDING on *tim_thread* when this function returns.
+ *
  * @param tim
  *   The timer handle.
  * @param ticks
@@ -225,11 +290,18 @@ void cne_timer_reset_sync(struct cne_timer *tim, uint64_t ticks, enum cne_timer_
  * and the timer structure can be freed (even in the callback
  * function).
  *
+ * When the timer is pending on another thread the stop is queued to that
+ * thread and the timer stays in the CONFIG state until it is applied. The
+ * callback will not run, but the function returns -1 until that thread has
+ * removed the timer, call it again, cne_timer_drain() or cne_timer_stop_sync()
+ * before the structure is freed.
+ *
  * @param tim
  *   The timer handle.
  * @return
  *   - 0: Success; the timer is stopped.
- *   - (-1): The timer is in the RUNNING or CONFIG state.
+ *   - (-1): The timer is in the RUNNING or CONFIG state, or the stop is
+ *     queued to the thread owning the timer.
  */
 int cne_timer_stop(struct cne_timer *tim);
 
@@ -237,13 +309,32 @@ int cne_timer_stop(struct cne_timer *tim);
  * Loop until cne_timer_stop() succeeds.
  *
  * After a call to this function, the timer identified by *tim* is
- * stopped. See cne_timer_stop() for details.
+ * stopped and no longer referenced by any thread's timer list. See
+ * cne_timer_stop() for details. Requests queued to threads that do not
+ * call cne_timer_manage() are applied by the calling thread.
  *
  * @param tim
  *   The timer handle.
  */
 void cne_timer_stop_sync(struct cne_timer *tim);
 
+/**
+ * Apply the timer requests queued to a thread.
+ *
+ * A reset or stop of a timer owned by another thread is queued to that thread
+ * and the timer stays in the CONFIG state until the thread next calls
+ * cne_timer_manage(). A thread that is blocked or exiting may never call it,
+ * any thread can apply the requests on its behalf with this function. The
+ * timer list of *tim_thread* is only changed under its lock.
+ *
+ * @param tim_thread
+ *   The ID of the thread whose queued requests are applied.
+ * @return
+ *   0 on success or -1 if the timer subsystem is not initialized or
+ *   *tim_thread* is not a valid thread ID.
+ */
+int cne_timer_drain(unsigned tim_thread);
+
 /**
  * Test if a timer is pending.
  *
@@ -263,8 +354,8 @@ int cne_timer_pending(struct cne_timer *tim);
  * Manage the timer list and execute callback functions.
  *
  * This function must be called periodically from CNE threads
- * main_loop(). It browses the list of pending timers and runs all
- * timers that are expired.
+ * main_loop(). It applies the requests queued by other threads, then
+ * browses the list of pending timers and runs all timers that are expired.
  *
  * The precision of the timer depends on the call frequency of this
  * function. However, the more often the function is called, the more
@@ -272,6 +363,34 @@ int cne_timer_pending(struct cne_timer *tim);
  */
 void cne_timer_manage(void);
 
+/**
+ * Return the number of ticks until the next timer on this thread expires.
+ *
+ * Used by threads that want to block while idle without delaying a timer.
+ *
+ * @return
+ *   -1 if no timer is pending, 0 if a timer has already expired or the number
+ *   of timer ticks until the earliest pending timer expires.
+ */
+int64_t cne_timer_next_ticks(void);
+
+/**
+ * Set the function that wakes up this thread when another thread arms a timer on it.
+ *
+ * A thread sleeping until the time returned by cne_timer_next_ticks() does not
+ * see a timer another thread arms on it. The callback is called by the arming
+ * thread once the new timer is seen by cne_timer_next_ticks(), so it must be
+ * safe to call from any thread. Set it before the thread first blocks.
+ *
+ * @param fn
+ *   The wake up function or NULL to remove it.
+ * @param arg
+ *   The argument passed to the wake up function.
+ * @return
+ *   0 on success or -1 if the timer subsystem is not initialized.
+ */
+int cne_timer_wakeup_set(cne_timer_wakeup_cb_t fn, void *arg);
+
 /**
  * Dump statistics about timers.
  *
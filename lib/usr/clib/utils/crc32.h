@@ -35,38 +35,38 @@
 #ifndef _CRC32_H_
 #define _CRC32_H_
 
-#include <stdint.h>        // for uint32_t, uint8_t
+/**
+ * @file
+ *
+ * BSD names of the CRC routines, the CRCs are computed by the cne_crc library.
+ */
+
+#include <stdint.h>         // for uint32_t
 #include <sys/cdefs.h>
 #include <sys/types.h>
-#include <stddef.h>        // for size_t
-
-extern const uint32_t crc32_tab[];
+#include <stddef.h>         // for size_t
+#include <cne_crc.h>        // for cne_crc32_eth, cne_crc32c
 
 #define rounddown(x, y)  (((x) / (y)) * (y))
 #define rounddown2(x, y) ((x) & (~((y)-1)))             /* if y is power of two */
 #define roundup2(x, y)   (((x) + ((y)-1)) & (~((y)-1))) /* if y is power of two */
 
 static __inline uint32_t
-crc32_raw(const void *buf, size_t size, uint32_t crc)
+crc32(const void *buf, size_t size)
 {
-    const uint8_t *p = (const uint8_t *)buf;
-
-    while (size--)
-        crc = crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
-    return (crc);
+    return cne_crc32_eth(buf, (uint32_t)size);
 }
 
 static __inline uint32_t
-crc32(const void *buf, size_t size)
+calculate_crc32c(uint32_t crc32c, const unsigned char *buffer, unsigned int length)
 {
-    uint32_t crc;
-
-    crc = crc32_raw(buf, size, ~0U);
-    return (crc ^ ~0U);
+    return cne_crc32c(buffer, length, crc32c);
 }
 
-uint32_t calculate_crc32c(uint32_t crc32c, const unsigned char *buffer, unsigned int length);
-
-uint32_t sse42_crc32c(uint32_t, const unsigned char *, unsigned);
+static __inline uint32_t
+sse42_crc32c(uint32_t crc32c, const unsigned char *buffer, unsigned int length)
+{
+    return cne_crc32c(buffer, length, crc32c);
+}
 
 #endif /* _CRC32_H_ */
@@ -13,10 +13,14 @@
 #include <bsd/string.h>
 #include <pthread.h>
 #include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <cne_pause.h>
 
 #include "ibroker.h"
 #include "ibroker_private.h"
 #include "ibroker_uintr.h"
+#include "ibroker_soft.h"
 
 static pthread_spinlock_t ibroker_lock;
 static struct ibroker *ibrokers[IBROKER_MAX_COUNT];
@@ -77,9 +81,17 @@ __create(const char *name)
             srv->enabled  = false;
         }
 
-        ibroker->tid = gettid();
+        ibroker->tid     = gettid();
+        ibroker->efd     = -1;
+        ibroker->backend = IBROKER_BACKEND_UINTR;
 
+#ifdef HAS_UINTR_SUPPORT
         if (uintr_register_handler(uintr_handler, 0) < 0)
+            ibroker->backend = IBROKER_BACKEND_SOFT;
+#else
+        ibroker->backend = IBROKER_BACKEND_SOFT;
+#endif
+        if (ibroker->backend == IBROKER_BACKEND_SOFT && soft_doorbell_init(ibroker) < 0)
             goto err;
     }
 
@@ -111,7 +123,8 @@ ibroker_create(const char *name)
                 ibrokers[bid] = ibroker;
                 this_ibroker  = ibroker;
 
-                uintr_start();
+                if (ibroker->backend == IBROKER_BACKEND_UINTR)
+                    uintr_start();
             }
 
             (void)pthread_spin_unlock(&ibroker_lock);
@@ -126,6 +139,11 @@ ibroker_create(const char *name)
 static int
 __destroy(struct ibroker *ibroker)
 {
+    if (ibroker->backend == IBROKER_BACKEND_SOFT) {
+        soft_doorbell_fini(ibroker);
+        goto done;
+    }
+
     for (int i = 0; i < IBROKER_MAX_SERVICES; i++) {
         struct ibroker_srv *srv = &ibroker->services[i];
 
@@ -138,6 +156,7 @@ __destroy(struct ibroker *ibroker)
     if (uintr_unregister_handler(0) < 0)
         return -1;
 
+done:
     this_ibroker = NULL;
     free(ibroker);
 
@@ -174,9 +193,19 @@ ibroker_send(broker_id_t bid, service_id_t sid)
                 struct ibroker_srv *srv = &ibroker->services[sid];
 
                 if (srv->enabled) {
-                    _senduipi(srv->uipi_index);
+                    bool kick = false;
+                    int ret   = 0;
+
+                    if (ibroker->backend == IBROKER_BACKEND_SOFT)
+                        kick = soft_doorbell_ring(ibroker, sid);
+                    else
+                        ret = uintr_senduipi(ibroker, sid);
                     (void)pthread_spin_unlock(&ibroker_lock);
-                    return 0;
+
+                    /* Wake the receiver without holding the lock shared by all brokers */
+                    if (kick)
+                        ret = soft_doorbell_kick(ibroker);
+                    return ret;
                 }
             }
             (void)pthread_spin_unlock(&ibroker_lock);
@@ -185,6 +214,108 @@ ibroker_send(broker_id_t bid, service_id_t sid)
     return -1;
 }
 
+static struct ibroker *
+__receiver(broker_id_t bid)
+{
+    struct ibroker *ibroker;
+
+    if (!BROKER_IS_VALID(bid))
+        return NULL;
+
+    /* services must only be called on the thread owning the broker */
+    ibroker = ibrokers[bid];
+    if (!ibroker || ibroker != this_ibroker)
+        return NULL;
+
+    return ibroker;
+}
+
+int
+ibroker_poll(broker_id_t bid)
+{
+    struct ibroker *ibroker = __receiver(bid);
+
+    if (!ibroker)
+        return -1;
+
+    if (ibroker->backend == IBROKER_BACKEND_UINTR)
+        return 0;
+
+    return soft_doorbell_drain(ibroker);
+}
+
+static uint64_t
+__now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+int
+ibroker_wait(broker_id_t bid, int timeout_ms)
+{
+    struct ibroker *ibroker = __receiver(bid);
+    struct pollfd pfd;
+    uint64_t val, stop;
+    int cnt;
+
+    if (!ibroker)
+        return -1;
+
+    if (ibroker->backend == IBROKER_BACKEND_UINTR)
+        return (poll(NULL, 0, timeout_ms) < 0 && errno != EINTR) ? -1 : 0;
+
+    /* A zero timeout is a non-blocking check, do not spin */
+    if (timeout_ms == 0)
+        return soft_doorbell_drain(ibroker);
+
+    /* Busy receiver, the sender only touches the doorbell cacheline */
+    stop = __now_ns() + IBROKER_SPIN_NS;
+    do {
+        for (int i = 0; i < 64; i++) {
+            if ((cnt = soft_doorbell_drain(ibroker)) > 0)
+                return cnt;
+            cne_pause();
+        }
+    } while (__now_ns() < stop);
+
+    /* Sleeping receiver, announce it and check the doorbell again before blocking */
+    atomic_store(&ibroker->sleeping, 1);
+
+    if (!atomic_load(&ibroker->doorbell)) {
+        pfd.fd      = ibroker->efd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+
+        ibroker->wakeups++;
+        if (poll(&pfd, 1, timeout_ms) < 0 && errno != EINTR) {
+            atomic_store(&ibroker->sleeping, 0);
+            return -1;
+        }
+    }
+    atomic_store(&ibroker->sleeping, 0);
+
+    /* Clear the eventfd counter, the doorbell bits tell us which services to call */
+    if (read(ibroker->efd, &val, sizeof(val)) < 0 && errno != EAGAIN)
+        return -1;
+
+    return soft_doorbell_drain(ibroker);
+}
+
+int
+ibroker_backend(broker_id_t bid)
+{
+    struct ibroker *ibroker = NULL;
+
+    if (BROKER_IS_VALID(bid))
+        ibroker = ibrokers[bid];
+
+    return (ibroker) ? (int)ibroker->backend : -1;
+}
+
 service_id_t
 ibroker_add_service(broker_id_t bid, const char *name, service_id_t sid, ibroker_func_t func,
                     void *arg)
@@ -206,7 +337,11 @@ ibroker_add_service(broker_id_t bid, const char *name, service_id_t sid, ibroker
         if (srv->enabled || srv->uintr_fd != -1)
             goto err;
 
-        uintr_fd = uintr_create_fd(sid, 0);
+        /* Software doorbells share the broker eventfd between all services */
+        if (ibroker->backend == IBROKER_BACKEND_SOFT)
+            uintr_fd = ibroker->efd;
+        else
+            uintr_fd = uintr_create_fd(sid, 0);
 
         if (uintr_fd < 0)
             goto err;
@@ -237,7 +372,7 @@ ibroker_del_service(broker_id_t bid, service_id_t sid)
                 if (SERVICE_IS_VALID(sid)) {
                     struct ibroker_srv *srv = &ibroker->services[sid];
 
-                    if (srv->enabled) {
+                    if (srv->enabled && ibroker->backend == IBROKER_BACKEND_UINTR) {
                         if (uintr_unregister_sender(srv->uintr_fd, 0) < 0) {
                             printf("%s: uintr_unregister_sender(%d, %d, %d) failed: %s\n", __func__,
                                    bid, sid, srv->uintr_fd, strerror(errno));
@@ -245,6 +380,9 @@ ibroker_del_service(broker_id_t bid, service_id_t sid)
                         }
 
                         close(srv->uintr_fd);
+                    }
+
+                    if (srv->enabled) {
                         srv->uintr_fd = -1;
                         srv->enabled  = false;
                         (void)pthread_spin_unlock(&ibroker_lock);
@@ -279,7 +417,10 @@ ibroker_register_sender(broker_id_t bid, service_id_t sid)
             if (!srv->enabled)
                 goto err;
 
-            if ((ret = uintr_register_sender(srv->uintr_fd, 0)) < 0)
+            /* No sender state is needed to ring a software doorbell */
+            if (ibroker->backend == IBROKER_BACKEND_SOFT)
+                ret = 0;
+            else if ((ret = uintr_register_sender(srv->uintr_fd, 0)) < 0)
                 goto err;
 
             srv->uipi_index = ret;
@@ -425,9 +566,11 @@ ibroker_info(broker_id_t bid, ibroker_info_t *info)
     memset(info, 0, sizeof(*info));
 
     strlcpy(info->name, ibroker->name, sizeof(info->name));
-    info->tid   = ibroker->tid;
-    info->intrs = ibroker->intrs;
-    info->bid   = ibroker->bid;
+    info->tid     = ibroker->tid;
+    info->intrs   = ibroker->intrs;
+    info->bid     = ibroker->bid;
+    info->backend = ibroker->backend;
+    info->wakeups = ibroker->wakeups;
 
     for (int i = 0; i < IBROKER_MAX_SERVICES; i++) {
         struct ibroker_srv *srv    = &ibroker->services[i];
@@ -13,6 +13,12 @@
  * abstract as much as possible to give the developer an opportunity to use UIPI features.
  *
  * Giving the developer an easy to use interface to the UIPI or interrupt based services.
+ *
+ * When the CPU or kernel does not support UINTR the broker falls back to software doorbells
+ * in shared memory. A sender sets the service bit in the broker doorbell and the receiver
+ * thread calls the services from ibroker_poll() or ibroker_wait(). A receiver spinning in
+ * ibroker_wait() sees the doorbell directly, once it goes to sleep the sender also kicks an
+ * eventfd to wake it up. The backend is selected by ibroker_create() at runtime.
  */
 
 #include <cne_atomic.h>
@@ -33,6 +39,13 @@ extern "C" {
 typedef int32_t broker_id_t;  /**< Broker ID */
 typedef int32_t service_id_t; /**< Service ID */
 
+#define IBROKER_SPIN_NS 20000 /**< Time ibroker_wait() polls the doorbell before sleeping */
+
+typedef enum {
+    IBROKER_BACKEND_UINTR, /**< Hardware user interrupts via senduipi */
+    IBROKER_BACKEND_SOFT,  /**< Software doorbells with eventfd wakeup */
+} ibroker_backend_t;
+
 /**
  * Function prototype for ibroker walk callback
  */
@@ -57,7 +70,9 @@ typedef struct ibroker_info {
     char name[IBROKER_NAME_SIZE];                       /**< Name of this ibroker instance */
     int tid;                                            /**< Task ID value */
     broker_id_t bid;                                    /**< ibroker ID */
+    ibroker_backend_t backend;                          /**< Backend used to signal the broker */
     uint64_t intrs;                                     /**< Interrupts statistice counter */
+    uint64_t wakeups;                                   /**< Number of sleeps on the eventfd */
     uint64_t invalid_service;                           /**< Invalid service counter */
     struct service_info services[IBROKER_MAX_SERVICES]; /**< Array of all services possible */
 } ibroker_info_t;
@@ -126,6 +141,9 @@ IBROKER_API int ibroker_del_service(broker_id_t bid, service_id_t sid);
 /**
  * Send a UIPI interrupt to the given broker and vector
  *
+ * With the software backend the service bit is set in the broker doorbell and the
+ * broker eventfd is kicked when the receiver is sleeping in ibroker_wait().
+ *
  * @param bid
  *   The broker ID to use for the senduipi() operation
  * @param sid
@@ -135,6 +153,47 @@ IBROKER_API int ibroker_del_service(broker_id_t bid, service_id_t sid);
  */
 IBROKER_API int ibroker_send(broker_id_t bid, service_id_t sid);
 
+/**
+ * Call the services with a pending software doorbell, does not block.
+ *
+ * Must be called from the thread which created the broker. With the UINTR backend
+ * the services are called from the interrupt handler and this function returns 0.
+ *
+ * @param bid
+ *   The broker ID value
+ * @return
+ *   -1 on error or the number of services called
+ */
+IBROKER_API int ibroker_poll(broker_id_t bid);
+
+/**
+ * Wait for a software doorbell and call the pending services.
+ *
+ * The receiver polls the doorbell for IBROKER_SPIN_NS and then sleeps on the broker
+ * eventfd until a sender rings the doorbell or the timeout expires. Must be called
+ * from the thread which created the broker. With the UINTR backend the services are
+ * called from the interrupt handler and this function only sleeps for the timeout.
+ *
+ * @param bid
+ *   The broker ID value
+ * @param timeout_ms
+ *   The number of milliseconds to wait, -1 to wait forever or 0 to only check the
+ *   doorbell without spinning
+ * @return
+ *   -1 on error, 0 on timeout or the number of services called
+ */
+IBROKER_API int ibroker_wait(broker_id_t bid, int timeout_ms);
+
+/**
+ * Return the backend used by a broker.
+ *
+ * @param bid
+ *   The broker ID value
+ * @return
+ *   -1 on error or the ibroker_backend_t value
+ */
+IBROKER_API int ibroker_backend(broker_id_t bid);
+
 /**
  * Find the ibroker by name.
  *
@@ -177,7 +236,7 @@ IBROKER_API int ibroker_register_sender(broker_id_t bid, service_id_t sid);
  * @param sid
  *   The server ID value to use for selecting the correct service
  * @return
- *   -1 on error or the server uintr_fd value
+ *   -1 on error or the server uintr_fd value, with software doorbells the broker eventfd
  */
 IBROKER_API int ibroker_service_fd(broker_id_t bid, service_id_t sid);
 
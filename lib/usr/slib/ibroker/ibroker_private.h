@@ -58,11 +58,18 @@ struct ibroker {
     broker_id_t bid;              /**< Broker ID */
     char name[IBROKER_NAME_SIZE]; /**< Name of this ibroker instance */
     int tid;                      /**< Thread ID value from gettid() */
+    ibroker_backend_t backend;    /**< UINTR or software doorbells */
+    int efd;                      /**< eventfd to wake a sleeping receiver, software backend */
 
     struct ibroker_srv services[IBROKER_MAX_SERVICES]; /**< Service list */
 
     uint64_t intrs;           /**< Number of interrupts */
     uint64_t invalid_service; /**< Invalid service number */
+    uint64_t wakeups;         /**< Number of times the receiver slept on the eventfd */
+
+    atomic_uint_least64_t doorbell; /**< Bitmap of services signaled by a sender */
+    atomic_int sleeping;            /**< Receiver is blocked on the eventfd */
+    atomic_int kicks;               /**< Senders writing the eventfd outside of the lock */
 };
 
 /**
@@ -0,0 +1,169 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2021-2023 Intel Corporation
+ */
+
+#ifndef _IBROKER_SOFT_H_
+#define _IBROKER_SOFT_H_
+
+/**
+ * @file
+ * CNE UIPI-Broker software doorbell functions
+ *
+ * Used in place of UINTR when the CPU or kernel does not support user interrupts. Each
+ * broker has a doorbell bitmap with one bit per service and an eventfd. A sender sets the
+ * service bit and only writes the eventfd when the receiver has said it is going to sleep.
+ * Both sides use sequentially consistent operations on the doorbell and the sleeping flag,
+ * so either the sender sees the flag and kicks the eventfd or the receiver sees the bit
+ * when it checks the doorbell again before blocking.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include <cne_pause.h>
+#include "ibroker_private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+_Static_assert(IBROKER_MAX_SERVICES <= 64, "IBROKER_MAX_SERVICES must fit in the doorbell");
+
+/**
+ * Setup the software doorbell for a broker
+ *
+ * @param ibroker
+ *   The broker to initialize
+ * @return
+ *   0 on success or -1 on error.
+ */
+static inline int
+soft_doorbell_init(struct ibroker *ibroker)
+{
+    ibroker->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ibroker->efd < 0)
+        return -1;
+
+    atomic_init(&ibroker->doorbell, 0);
+    atomic_init(&ibroker->sleeping, 0);
+    atomic_init(&ibroker->kicks, 0);
+
+    return 0;
+}
+
+/**
+ * Release the software doorbell resources of a broker
+ *
+ * Called with the broker lock held, so no new kick can start. Wait for the senders
+ * already past the lock before closing the eventfd they are writing.
+ *
+ * @param ibroker
+ *   The broker to release
+ */
+static inline void
+soft_doorbell_fini(struct ibroker *ibroker)
+{
+    while (atomic_load(&ibroker->kicks))
+        cne_pause();
+
+    if (ibroker->efd >= 0)
+        close(ibroker->efd);
+    ibroker->efd = -1;
+}
+
+/**
+ * Ring the doorbell of a service
+ *
+ * Only sets the service bit, called with the broker lock held. When this returns true the
+ * caller has taken a kick reference and must call soft_doorbell_kick() after dropping the
+ * lock, so the system call is not made while holding it.
+ *
+ * @param ibroker
+ *   The broker to signal
+ * @param sid
+ *   The service id to signal
+ * @return
+ *   true if the receiver is sleeping and needs a kick or false otherwise
+ */
+static inline bool
+soft_doorbell_ring(struct ibroker *ibroker, service_id_t sid)
+{
+    atomic_fetch_or(&ibroker->doorbell, 1ULL << sid);
+
+    if (!atomic_load(&ibroker->sleeping))
+        return false;
+
+    atomic_fetch_add(&ibroker->kicks, 1);
+    return true;
+}
+
+/**
+ * Wake a sleeping receiver and drop the kick reference taken by soft_doorbell_ring()
+ *
+ * @param ibroker
+ *   The broker to wake
+ * @return
+ *   0 on success or -1 on error
+ */
+static inline int
+soft_doorbell_kick(struct ibroker *ibroker)
+{
+    uint64_t val = 1;
+    int ret      = 0;
+
+    /* EAGAIN means the counter is saturated and the receiver is awake anyway */
+    if (write(ibroker->efd, &val, sizeof(val)) < 0 && errno != EAGAIN)
+        ret = -1;
+
+    atomic_fetch_sub(&ibroker->kicks, 1);
+    return ret;
+}
+
+/**
+ * Call the services with a pending doorbell, called on the receiver thread
+ *
+ * Multiple rings of the same service before the receiver runs are collapsed into a
+ * single call, the same as a UINTR vector posted more than once.
+ *
+ * @param ibroker
+ *   The broker to process
+ * @return
+ *   The number of services called
+ */
+static inline int
+soft_doorbell_drain(struct ibroker *ibroker)
+{
+    uint64_t bits;
+    int cnt = 0;
+
+    if (!atomic_load_explicit(&ibroker->doorbell, memory_order_relaxed))
+        return 0;
+
+    bits = atomic_exchange_explicit(&ibroker->doorbell, 0, memory_order_acquire);
+
+    while (bits) {
+        int vector              = __builtin_ctzll(bits);
+        struct ibroker_srv *srv = &ibroker->services[vector];
+
+        bits &= bits - 1;
+
+        ibroker->intrs++;
+        if (srv->enabled && srv->func) {
+            srv->call_cnt++;
+            if (srv->func(vector, srv->arg) != 0)
+                srv->err_cnt++;
+            cnt++;
+        } else
+            ibroker->invalid_service++;
+    }
+
+    return cnt;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IBROKER_SOFT_H_ */
@@ -15,9 +15,11 @@
 extern "C" {
 #endif
 
-#include <x86gprintrin.h>
 #include "ibroker_private.h"
 
+#ifdef HAS_UINTR_SUPPORT
+#include <x86gprintrin.h>
+
 /**
  * Internal function definition for UIPI interrupt handler.
  */
@@ -164,6 +166,66 @@ uintr_senduipi(struct ibroker *ibroker, service_id_t sid)
     return -1;
 }
 
+#else /* HAS_UINTR_SUPPORT */
+
+/*
+ * The compiler or assembler does not support UINTR, the stubs below fail the same way
+ * as a kernel without the UINTR syscalls and the broker uses software doorbells.
+ */
+#include <errno.h>
+
+static inline int
+uintr_unregister_handler(unsigned int flags __ibroker_unused)
+{
+    errno = ENOSYS;
+    return -1;
+}
+
+static inline int
+uintr_create_fd(service_id_t sid __ibroker_unused, unsigned int flags __ibroker_unused)
+{
+    errno = ENOSYS;
+    return -1;
+}
+
+static inline int
+uintr_register_sender(int uintr_fd __ibroker_unused, unsigned int flags __ibroker_unused)
+{
+    errno = ENOSYS;
+    return -1;
+}
+
+static inline int
+uintr_unregister_sender(int uintr_fd __ibroker_unused, unsigned int flags __ibroker_unused)
+{
+    errno = ENOSYS;
+    return -1;
+}
+
+static inline void
+uintr_start(void)
+{
+}
+
+static inline void
+uintr_clear(void)
+{
+}
+
+static inline int
+uintr_test(void)
+{
+    return 0;
+}
+
+static inline int
+uintr_senduipi(struct ibroker *ibroker __ibroker_unused, service_id_t sid __ibroker_unused)
+{
+    return -1;
+}
+
+#endif /* HAS_UINTR_SUPPORT */
+
 #ifdef __cplusplus
 }
 #endif
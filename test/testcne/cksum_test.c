@@ -0,0 +1,294 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint64_t, uint32_t, uint16_t, uint8_t
+#include <stdlib.h>              // for rand, srand
+#include <string.h>              // for memset, memcpy
+#include <tst_info.h>            // for tst_end, tst_start, tst_info, TST_PASSED
+#include <cne_common.h>          // for cne_countof, CNE_SET_USED
+#include <cne_cycles.h>          // for cne_rdtsc_precise
+#include <net/cne_ip.h>          // for cne_ipv4_hdr, cne_ipv4_cksum_verify_bulk
+#include <net/cne_cksum.h>       // for cne_cksum_add, cne_cksum_fold, cne_cksum_adjust
+
+#include "cksum_test.h"
+#include "cne_log.h"        // for CNE_ERR_RET
+
+#define TST_FUNC(lb, name, f)              \
+    do {                                   \
+        tst_info_t *tst = tst_start(name); \
+        int t;                             \
+        if (tst == NULL)                   \
+            return -1;                     \
+        t = f;                             \
+        tst_end(tst, t);                   \
+        if (t == TST_FAILED)               \
+            goto lb;                       \
+    } while ((0))
+
+#define BUF_SIZE   (64 * 1024 + 64)
+#define NB_HDRS    64
+#define BENCH_LOOP 20000
+
+static uint8_t buf[BUF_SIZE];
+
+/* The RFC 1071 sum of 16 bit words, as computed by the scalar code before the kernels */
+static uint16_t
+ref_cksum(const uint8_t *p, size_t len)
+{
+    uint32_t sum = 0;
+
+    for (; len >= 2; len -= 2, p += 2)
+        sum += (uint16_t)(p[0] | (p[1] << 8));
+    if (len)
+        sum += p[0];
+
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+
+    return (uint16_t)sum;
+}
+
+static int
+test1(void)
+{
+    const size_t big[] = {1500, 9000, 9001, 65535, 64 * 1024};
+
+    for (size_t len = 0; len <= 2048; len++) {
+        for (int off = 0; off < 4; off++) {
+            uint16_t ref = ref_cksum(buf + off, len);
+
+            if (cne_cksum_fold(cne_cksum_add(buf + off, len, 0)) != ref)
+                CNE_ERR_RET("cne_cksum_add() length %zu offset %d is wrong\n", len, off);
+            if (cne_raw_cksum(buf + off, len) != ref)
+                CNE_ERR_RET("cne_raw_cksum() length %zu offset %d is wrong\n", len, off);
+        }
+    }
+
+    for (size_t i = 0; i < cne_countof(big); i++) {
+        uint64_t sum;
+
+        if (cne_cksum_fold(cne_cksum_add(buf, big[i], 0)) != ref_cksum(buf, big[i]))
+            CNE_ERR_RET("cne_cksum_add() length %zu is wrong\n", big[i]);
+
+        /* Sum the buffer in two parts, the first one with an even length */
+        sum = cne_cksum_add(buf, 1000, 0);
+        sum = cne_cksum_add(buf + 1000, big[i] - 1000, sum);
+        if (cne_cksum_fold(sum) != ref_cksum(buf, big[i]))
+            CNE_ERR_RET("Partial sums of length %zu are wrong\n", big[i]);
+    }
+
+    /* All ones must not overflow the accumulators */
+    memset(buf, 0xff, BUF_SIZE);
+    if (cne_cksum_fold(cne_cksum_add(buf, BUF_SIZE, 0)) != ref_cksum(buf, BUF_SIZE))
+        CNE_ERR_RET("Sum of all ones is wrong\n");
+    for (size_t i = 0; i < BUF_SIZE; i++)
+        buf[i] = rand();
+
+    return 0;
+}
+
+static void
+ipv4_hdr_init(struct cne_ipv4_hdr *ip, int ihl)
+{
+    uint8_t *p = (uint8_t *)ip;
+
+    for (int i = 0; i < ihl * 4; i++)
+        p[i] = rand();
+    ip->version_ihl  = 0x40 | ihl;
+    ip->hdr_checksum = 0;
+    ip->hdr_checksum = cne_ipv4_cksum(ip);
+}
+
+static int
+test2(void)
+{
+    struct cne_ipv4_hdr *ip[NB_HDRS];
+    uint64_t expect = 0, ok;
+
+    for (int i = 0; i < NB_HDRS; i++) {
+        /* Some headers have options, which are not handled by the vector code */
+        ip[i] = (struct cne_ipv4_hdr *)(buf + i * 64 + (i & 3));
+        ipv4_hdr_init(ip[i], (i % 7) ? 5 : 5 + (i % 11));
+        if (cne_ipv4_cksum(ip[i]) != 0)
+            CNE_ERR_RET("Header %d checksum is wrong\n", i);
+
+        /* Corrupt every third header */
+        if ((i % 3) == 0)
+            ip[i]->time_to_live ^= 0x10;
+        else
+            expect |= 1ULL << i;
+    }
+
+    ok = cne_ipv4_cksum_verify_bulk(ip, NB_HDRS);
+    if (ok != expect)
+        CNE_ERR_RET("Bulk mask %016lx expected %016lx\n", ok, expect);
+
+    for (int i = 0; i < NB_HDRS; i += 8) {
+        if (cne_ipv4_cksum_verify_x8(&ip[i]) != ((expect >> i) & 0xff))
+            CNE_ERR_RET("x8 mask of headers %d-%d is wrong\n", i, i + 7);
+        if (cne_ipv4_cksum_verify_x4(&ip[i]) != ((expect >> i) & 0xf))
+            CNE_ERR_RET("x4 mask of headers %d-%d is wrong\n", i, i + 3);
+    }
+
+    /* Odd burst sizes use the x8, x4 and scalar paths */
+    for (uint32_t n = 0; n < NB_HDRS; n++) {
+        uint64_t mask = (1ULL << n) - 1;
+
+        if (cne_ipv4_cksum_verify_bulk(ip, n) != (expect & mask))
+            CNE_ERR_RET("Bulk mask of %u headers is wrong\n", n);
+    }
+
+    return 0;
+}
+
+struct test_pkt {
+    struct cne_ipv4_hdr ip;
+    union {
+        struct cne_udp_hdr udp;
+        struct cne_tcp_hdr tcp;
+    };
+    uint8_t data[333];
+} __cne_packed;
+
+static void
+pkt_init(struct test_pkt *pkt, uint8_t proto)
+{
+    memset(pkt, 0, sizeof(*pkt));
+    for (size_t i = 0; i < sizeof(pkt->data); i++)
+        pkt->data[i] = rand();
+
+    pkt->ip.version_ihl   = 0x45;
+    pkt->ip.total_length  = htobe16(sizeof(*pkt));
+    pkt->ip.time_to_live  = 64;
+    pkt->ip.next_proto_id = proto;
+    pkt->ip.src_addr      = rand();
+    pkt->ip.dst_addr      = rand();
+    pkt->ip.hdr_checksum  = cne_ipv4_cksum(&pkt->ip);
+    pkt->udp.src_port     = rand();
+    pkt->udp.dst_port     = rand();
+
+    if (proto == IPPROTO_UDP) {
+        pkt->udp.dgram_len   = htobe16(sizeof(*pkt) - sizeof(pkt->ip));
+        pkt->udp.dgram_cksum = cne_ipv4_udptcp_cksum(&pkt->ip, &pkt->udp);
+    } else
+        pkt->tcp.cksum = cne_ipv4_udptcp_cksum(&pkt->ip, &pkt->tcp);
+}
+
+static int
+test3(void)
+{
+    struct test_pkt pkt;
+    uint8_t protos[] = {IPPROTO_UDP, IPPROTO_TCP};
+
+    for (int n = 0; n < 1000; n++) {
+        uint8_t proto = protos[n & 1];
+
+        pkt_init(&pkt, proto);
+
+        cne_ipv4_ttl_dec(&pkt.ip);
+        if (pkt.ip.time_to_live != 63 || cne_ipv4_cksum(&pkt.ip) != 0)
+            CNE_ERR_RET("cne_ipv4_ttl_dec() checksum is wrong\n");
+
+        cne_ipv4_addr_update(&pkt.ip, &pkt.udp, n & 2, rand());
+        if (cne_ipv4_cksum(&pkt.ip) != 0)
+            CNE_ERR_RET("cne_ipv4_addr_update() IPv4 checksum is wrong\n");
+        if (cne_ipv4_udptcp_cksum_verify(&pkt.ip, &pkt.udp) != 0)
+            CNE_ERR_RET("cne_ipv4_addr_update() %s checksum is wrong\n",
+                        (proto == IPPROTO_UDP) ? "UDP" : "TCP");
+    }
+
+    /* A UDP packet without checksum keeps it off */
+    pkt_init(&pkt, IPPROTO_UDP);
+    pkt.udp.dgram_cksum = 0;
+    cne_ipv4_addr_update(&pkt.ip, &pkt.udp, true, rand());
+    if (pkt.udp.dgram_cksum != 0)
+        CNE_ERR_RET("UDP checksum of 0 was changed\n");
+
+    /* Change a 16 byte field, e.g. an IPv6 address */
+    for (int n = 0; n < 1000; n++) {
+        uint8_t to[16];
+        uint16_t cksum, expect;
+
+        for (size_t i = 0; i < sizeof(to); i++)
+            to[i] = rand();
+
+        cksum = cne_cksum_adjust(~cne_raw_cksum(buf, 256), buf + 64, to, sizeof(to));
+        memcpy(buf + 64, to, sizeof(to));
+        expect = ~cne_raw_cksum(buf, 256);
+        if (cksum != expect)
+            CNE_ERR_RET("cne_cksum_adjust() checksum is wrong\n");
+    }
+
+    return 0;
+}
+
+static int
+test4(void)
+{
+    const size_t sizes[] = {20, 64, 256, 1500, 9000};
+    struct cne_ipv4_hdr *ip[NB_HDRS];
+    volatile uint64_t sink = 0;
+    uint64_t start, ref, vec;
+
+    tst_info("%6s %14s %14s\n", "bytes", "scalar cycles", "kernel cycles");
+    for (size_t i = 0; i < cne_countof(sizes); i++) {
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP; n++)
+            sink += ref_cksum(buf + (n & 63), sizes[i]);
+        ref = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP; n++)
+            sink += cne_raw_cksum(buf + (n & 63), sizes[i]);
+        vec = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+
+        tst_info("%6zu %14lu %14lu\n", sizes[i], ref, vec);
+    }
+
+    for (int i = 0; i < NB_HDRS; i++) {
+        ip[i] = (struct cne_ipv4_hdr *)(buf + i * 64);
+        ipv4_hdr_init(ip[i], 5);
+    }
+
+    start = cne_rdtsc_precise();
+    for (int n = 0; n < BENCH_LOOP; n++) {
+        uint64_t ok = 0;
+
+        for (int i = 0; i < NB_HDRS; i++)
+            ok |= (uint64_t)(cne_ipv4_cksum(ip[i]) == 0) << i;
+        sink += ok;
+    }
+    ref = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+
+    start = cne_rdtsc_precise();
+    for (int n = 0; n < BENCH_LOOP; n++)
+        sink += cne_ipv4_cksum_verify_bulk(ip, NB_HDRS);
+    vec = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+
+    tst_info("Validate %d IPv4 headers: %lu cycles per header one by one, %lu.%02lu in bulk\n",
+             NB_HDRS, ref / NB_HDRS, vec / NB_HDRS, ((vec % NB_HDRS) * 100) / NB_HDRS);
+
+    return (sink == 0) ? -1 : 0;
+}
+
+int
+cksum_main(int argc, char **argv)
+{
+    CNE_SET_USED(argc);
+    CNE_SET_USED(argv);
+
+    srand(0x1071);
+    for (size_t i = 0; i < BUF_SIZE; i++)
+        buf[i] = rand();
+
+    TST_FUNC(err, "1 - Checksum of buffers", test1() < 0 ? TST_FAILED : TST_PASSED);
+    TST_FUNC(err, "2 - Bulk IPv4 header checksum validation",
+             test2() < 0 ? TST_FAILED : TST_PASSED);
+    TST_FUNC(err, "3 - Incremental checksum updates", test3() < 0 ? TST_FAILED : TST_PASSED);
+    TST_FUNC(err, "4 - Checksum performance", test4() < 0 ? TST_FAILED : TST_PASSED);
+
+    return 0;
+err:
+    return -1;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CKSUM_TEST_H_
+#define _CKSUM_TEST_H_
+
+/**
+ * @file
+ * Checksum testing functions
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int cksum_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CKSUM_TEST_H_ */
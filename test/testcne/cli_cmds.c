@@ -40,16 +40,20 @@
 #include "netdev_funcs.h"             // for netdev_link
 #include "log_test.h"                 // for log_main
 #include "hash_test.h"                // for hash_main, hash_perf_main
+#include "hist_test.h"                // for hist_main
+#include "cksum_test.h"               // for cksum_main
+#include "crc_test.h"                 // for crc_main
 #include "rib_test.h"                 // for rib_main, rib6_main
 #include "fib_test.h"                 // for fib_main, fib_perf_main, fib6_main, fib6_perf_main
-#ifdef HAS_UINTR_SUPPORT
 #include "ibroker_test.h"        // for ibroker_main
-#endif
 #include "meter_test.h"        // for meter_main
 #include "vec_test.h"          // for vec_main
 #include "msgchan_test.h"
 #include "tailqs_test.h"
 #include "idlemgr_test.h"
+#include "shmstats_test.h"
+#include "trace_test.h"
+#include "uds_test.h"
 
 struct struct_sizes {
     const char *name;
@@ -102,7 +106,9 @@ static int
 all_tests(int argc, char **argv)
 {
     acl_main(argc, argv);
+    cksum_main(argc, argv);
     cne_register_main(argc, argv);
+    crc_main(argc, argv);
     cthread_main(argc, argv);
     dsa_main(argc, argv);
     fib_main(argc, argv);
@@ -113,11 +119,10 @@ all_tests(int argc, char **argv)
     graph_perf_main(argc, argv);
     hash_main(argc, argv);
     hash_perf_main(argc, argv);
+    hist_main(argc, argv);
     hmap_main(argc, argv);
     idlemgr_main(argc, argv);
-#ifdef HAS_UINTR_SUPPORT
     ibroker_main(argc, argv);
-#endif
     jcfg_main(argc, argv);
     kvargs_main(argc, argv);
     log_main(argc, argv);
@@ -135,9 +140,12 @@ all_tests(int argc, char **argv)
     ring_api_main(argc, argv);
     ring_main(argc, argv);
     ring_profile(argc, argv);
+    shmstats_main(argc, argv);
     tailqs_main(argc, argv);
     thread_main(argc, argv);
     timer_main(argc, argv);
+    trace_main(argc, argv);
+    uds_main(argc, argv);
     uid_main(argc, argv);
     vec_main(argc, argv);
     xskdev_main(argc, argv);
@@ -151,7 +159,9 @@ static struct cli_tree default_tree[] = {
 
     c_cmd("acl", acl_main, "Run the ACL tests"),
     c_cmd("all", all_tests, "Run all tests"),
+    c_cmd("cksum", cksum_main, "Run the checksum test"),
     c_cmd("cne", cne_register_main, "Run the CNE registration tests"),
+    c_cmd("crc", crc_main, "Run the CRC test"),
     c_cmd("cthread", cthread_main, "Run the cthread API test"),
     c_cmd("dsa", dsa_main, "Run the dsa API test"),
     c_cmd("fib", fib_main, "Run the FIB test"),
@@ -162,11 +172,10 @@ static struct cli_tree default_tree[] = {
     c_cmd("graph", graph_main, "Run the graph test"),
     c_cmd("hash_perf", hash_perf_main, "Run the hash perf test"),
     c_cmd("hash", hash_main, "Run the hash test"),
+    c_cmd("hist", hist_main, "Run the histogram test"),
     c_cmd("hmap", hmap_main, "Run the HashMap CFG file tests"),
     c_cmd("idlemgr", idlemgr_main, "Run the idlemgr test"),
-#ifdef HAS_UINTR_SUPPORT
     c_cmd("ibroker", ibroker_main, "Run the ibroker tests"),
-#endif
     c_cmd("jcfg", jcfg_main, "Run the JSON CFG file tests"),
     c_cmd("kvargs", kvargs_main, "Run the KVARGS tests"),
     c_cmd("log", log_main, "Run log test"),
@@ -185,10 +194,13 @@ static struct cli_tree default_tree[] = {
     c_cmd("ring_api", ring_api_main, "Run RING api tests"),
     c_cmd("ring_profile", ring_profile, "Run RING profile test"),
     c_cmd("ring", ring_main, "Run RING test"),
+    c_cmd("shmstats", shmstats_main, "Run shared memory stats test"),
     c_cmd("tailqs", tailqs_main, "Run TailQ test"),
     c_cmd("sizeof", sizeof_cmd, "Size of structures"),
     c_cmd("thread", thread_main, "Run the Thread test"),
     c_cmd("timer", timer_main, "Run the Timer test"),
+    c_cmd("trace", trace_main, "Run the trace point test"),
+    c_cmd("uds", uds_main, "Run the UDS server test"),
     c_cmd("uid", uid_main, "Run the User ID Allocator test"),
     c_cmd("vec", vec_main, "Run the vec routine test"),
     c_cmd("xdpdev", xskdev_main, "Run the xdpdev API test (deprecated)"),
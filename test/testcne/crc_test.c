@@ -0,0 +1,368 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint32_t, uint64_t, uint16_t, uint8_t
+#include <stdlib.h>              // for rand, srand
+#include <string.h>              // for memcpy
+#include <tst_info.h>            // for tst_end, tst_start, tst_info, TST_PASSED
+#include <cne_common.h>          // for cne_countof, CNE_SET_USED
+#include <cne_cycles.h>          // for cne_rdtsc_precise
+#include <cne_crc.h>             // for cne_crc32c, cne_crc32c_bulk, cne_crc32_eth
+#include <cne_hash.h>            // for cne_hash_create, cne_hash_lookup_bulk
+#include <cne_hash_crc.h>        // for cne_hash_crc
+#include <cne_jhash.h>           // for cne_jhash
+
+#include "crc_test.h"
+#include "cne_log.h"        // for CNE_ERR_RET
+
+#define TST_FUNC(lb, name, f)              \
+    do {                                   \
+        tst_info_t *tst = tst_start(name); \
+        int t;                             \
+        if (tst == NULL)                   \
+            return -1;                     \
+        t = f;                             \
+        tst_end(tst, t);                   \
+        if (t == TST_FAILED)               \
+            goto lb;                       \
+    } while ((0))
+
+#define BUF_SIZE      (64 * 1024 + 64)
+#define MAX_KEY_LEN   64
+#define NB_KEYS       CNE_HASH_LOOKUP_BULK_MAX
+#define BENCH_LOOP    20000
+#define HASH_ENTRIES  (1 << 16)
+#define HASH_KEY_LEN  16
+#define HASH_BURST    32
+#define HASH_ROUNDS   (HASH_ENTRIES / HASH_BURST)
+
+static uint8_t buf[BUF_SIZE];
+
+/* Bitwise reflected CRC register, the reference of the table and instruction based CRCs */
+static uint32_t
+ref_crc(const uint8_t *p, size_t len, uint32_t crc, uint32_t poly)
+{
+    while (len--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++)
+            crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+    }
+
+    return crc;
+}
+
+static uint32_t
+ref_crc32c(const uint8_t *p, size_t len, uint32_t init)
+{
+    return ref_crc(p, len, init, 0x82f63b78);
+}
+
+static uint32_t
+ref_crc32_eth(const uint8_t *p, size_t len)
+{
+    return ~ref_crc(p, len, 0xffffffff, 0xedb88320);
+}
+
+static uint16_t
+ref_crc16_ccitt(const uint8_t *p, size_t len)
+{
+    return (uint16_t)~ref_crc(p, len, 0xffff, 0x8408);
+}
+
+static int
+check_eth(enum cne_crc_alg alg)
+{
+    const size_t big[] = {8191, 9000, 9018, 16384 + 13, 64 * 1024};
+
+    if (cne_crc_set_alg(alg) < 0) {
+        tst_info("CRC algorithm %d is not supported by the CPU, skipped\n", alg);
+        return 0;
+    }
+
+    for (size_t len = 0; len <= 1024; len++) {
+        for (int off = 0; off < 4; off++) {
+            if (cne_crc32_eth(buf + off, len) != ref_crc32_eth(buf + off, len))
+                CNE_ERR_RET("cne_crc32_eth() alg %d length %zu offset %d is wrong\n", alg, len,
+                            off);
+            if (cne_crc16_ccitt(buf + off, len) != ref_crc16_ccitt(buf + off, len))
+                CNE_ERR_RET("cne_crc16_ccitt() alg %d length %zu offset %d is wrong\n", alg,
+                            len, off);
+        }
+    }
+
+    for (size_t i = 0; i < cne_countof(big); i++) {
+        if (cne_crc32_eth(buf + 1, big[i]) != ref_crc32_eth(buf + 1, big[i]))
+            CNE_ERR_RET("cne_crc32_eth() alg %d length %zu is wrong\n", alg, big[i]);
+        if (cne_crc16_ccitt(buf + 1, big[i]) != ref_crc16_ccitt(buf + 1, big[i]))
+            CNE_ERR_RET("cne_crc16_ccitt() alg %d length %zu is wrong\n", alg, big[i]);
+    }
+
+    return 0;
+}
+
+static int
+test1(void)
+{
+    const size_t big[] = {767, 768, 769, 3 * 8192 - 1, 3 * 8192, 3 * 8192 + 768 + 7, 64 * 1024};
+    const char *check = "123456789";
+    int ret = 0;
+
+    /* The check values of the CRC catalogue */
+    if (~cne_crc32c(check, 9, 0xffffffff) != 0xe3069283)
+        CNE_ERR_RET("cne_crc32c() check value is wrong\n");
+    if (cne_crc32_eth(check, 9) != 0xcbf43926)
+        CNE_ERR_RET("cne_crc32_eth() check value is wrong\n");
+    if (cne_crc16_ccitt(check, 9) != 0x906e)
+        CNE_ERR_RET("cne_crc16_ccitt() check value is wrong\n");
+
+    for (size_t len = 0; len <= 2048; len++) {
+        for (int off = 0; off < 4; off++) {
+            uint32_t init = rand();
+            uint32_t ref  = ref_crc32c(buf + off, len, init);
+
+            if (cne_crc32c(buf + off, len, init) != ref)
+                CNE_ERR_RET("cne_crc32c() length %zu offset %d is wrong\n", len, off);
+            if (cne_hash_crc(buf + off, len, init) != ref)
+                CNE_ERR_RET("cne_hash_crc() length %zu offset %d is different\n", len, off);
+        }
+    }
+
+    /* The long and short interleaved blocks and their combination */
+    for (size_t i = 0; i < cne_countof(big); i++) {
+        uint32_t ref   = ref_crc32c(buf + 3, big[i], 0);
+        uint32_t split = big[i] / 3 + 1;
+
+        if (cne_crc32c(buf + 3, big[i], 0) != ref)
+            CNE_ERR_RET("cne_crc32c() length %zu is wrong\n", big[i]);
+        if (cne_crc32c(buf + 3 + split, big[i] - split, cne_crc32c(buf + 3, split, 0)) != ref)
+            CNE_ERR_RET("cne_crc32c() in two parts of length %zu is wrong\n", big[i]);
+    }
+
+    if (check_eth(CNE_CRC_SCALAR) < 0 || check_eth(CNE_CRC_PCLMULQDQ) < 0)
+        ret = -1;
+
+    /* Back to the best algorithm */
+    if (cne_crc_set_alg(CNE_CRC_PCLMULQDQ) < 0)
+        cne_crc_set_alg(CNE_CRC_SCALAR);
+
+    return ret;
+}
+
+static int
+test2(void)
+{
+    const void *keys[NB_KEYS];
+    uint32_t crcs[NB_KEYS];
+
+    for (int i = 0; i < NB_KEYS; i++)
+        keys[i] = buf + i * (MAX_KEY_LEN + 3);
+
+    for (uint32_t len = 0; len <= MAX_KEY_LEN; len++) {
+        for (uint32_t n = 0; n <= NB_KEYS; n += (n < 9) ? 1 : 11) {
+            uint32_t init = rand();
+
+            memset(crcs, 0, sizeof(crcs));
+            cne_crc32c_bulk(keys, len, init, crcs, n);
+
+            for (uint32_t i = 0; i < NB_KEYS; i++) {
+                uint32_t expect = (i < n) ? cne_crc32c(keys[i], len, init) : 0;
+
+                if (crcs[i] != expect)
+                    CNE_ERR_RET("cne_crc32c_bulk() key %u of %u length %u is wrong\n", i, n, len);
+            }
+        }
+    }
+
+    return 0;
+}
+
+static struct cne_hash *
+hash_create(const char *name, cne_hash_function func)
+{
+    struct cne_hash_parameters params = {
+        .name               = name,
+        .entries            = HASH_ENTRIES,
+        .key_len            = HASH_KEY_LEN,
+        .hash_func          = func,
+        .hash_func_init_val = 0,
+    };
+    struct cne_hash *h;
+
+    h = cne_hash_create(&params);
+    if (!h)
+        CNE_NULL_RET("cne_hash_create(%s) failed\n", name);
+
+    /* Fill the table at 75%, the keys are the first bytes of buf */
+    for (int i = 0; i < (HASH_ENTRIES * 3) / 4; i++) {
+        if (cne_hash_add_key(h, buf + i) < 0) {
+            cne_hash_free(h);
+            CNE_NULL_RET("cne_hash_add_key(%s) key %d failed\n", name, i);
+        }
+    }
+
+    return h;
+}
+
+static int
+test3(void)
+{
+    struct cne_hash *h;
+    const void *keys[NB_KEYS];
+    int32_t positions[NB_KEYS];
+    int ret = -1;
+
+    /* The default hash function is cne_crc32c(), hashing the keys of bulk lookups together */
+    h = hash_create("crc_default", NULL);
+    if (!h)
+        return -1;
+
+    for (int i = 0; i < HASH_ENTRIES; i += NB_KEYS) {
+        uint32_t n = (i / NB_KEYS) % NB_KEYS + 1;
+
+        for (uint32_t j = 0; j < n; j++)
+            keys[j] = buf + i + j;
+
+        if (cne_hash_lookup_bulk(h, keys, n, positions) < 0)
+            CNE_ERR_GOTO(leave, "cne_hash_lookup_bulk() failed\n");
+
+        for (uint32_t j = 0; j < n; j++) {
+            int32_t pos = cne_hash_lookup(h, keys[j]);
+
+            if (positions[j] != pos)
+                CNE_ERR_GOTO(leave, "Bulk lookup of key %u is %d instead of %d\n", i + j,
+                             positions[j], pos);
+            if ((i + j < (HASH_ENTRIES * 3) / 4) != (pos >= 0))
+                CNE_ERR_GOTO(leave, "Lookup of key %u is %d\n", i + j, pos);
+        }
+    }
+    ret = 0;
+
+leave:
+    cne_hash_free(h);
+    return ret;
+}
+
+static uint64_t
+bench_lookup_bulk(struct cne_hash *h)
+{
+    const void *keys[HASH_BURST];
+    int32_t positions[HASH_BURST];
+    uint64_t start;
+
+    start = cne_rdtsc_precise();
+    for (int r = 0; r < HASH_ROUNDS; r++) {
+        for (int j = 0; j < HASH_BURST; j++)
+            keys[j] = buf + ((r * 7919 + j * 104729) % ((HASH_ENTRIES * 3) / 4));
+        cne_hash_lookup_bulk(h, keys, HASH_BURST, positions);
+    }
+
+    return (cne_rdtsc_precise() - start) / (HASH_ROUNDS * HASH_BURST);
+}
+
+static int
+test4(void)
+{
+    const size_t sizes[] = {64, 256, 1024, 1500, 9000};
+    const uint32_t key_lens[] = {4, 13, 16, 37, 40, 64};
+    const void *keys[NB_KEYS];
+    uint32_t crcs[NB_KEYS];
+    volatile uint64_t sink = 0;
+    uint64_t start, ref, vec;
+    struct {
+        const char *name;
+        cne_hash_function func;
+    } funcs[] = {{"cne_jhash", cne_jhash}, {"cne_hash_crc", cne_hash_crc}, {"default", NULL}};
+
+    tst_info("%6s %18s %18s\n", "bytes", "cne_hash_crc cyc", "cne_crc32c cyc");
+    for (size_t i = 0; i < cne_countof(sizes); i++) {
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP; n++)
+            sink += cne_hash_crc(buf + (n & 63), sizes[i], 0);
+        ref = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP; n++)
+            sink += cne_crc32c(buf + (n & 63), sizes[i], 0);
+        vec = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+
+        tst_info("%6zu %18lu %18lu\n", sizes[i], ref, vec);
+    }
+
+    for (int i = 0; i < NB_KEYS; i++)
+        keys[i] = buf + i * 97;
+
+    tst_info("%6s %18s %18s\n", "key", "one by one cyc/key", "bulk cyc/key");
+    for (size_t i = 0; i < cne_countof(key_lens); i++) {
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP; n++)
+            for (int k = 0; k < NB_KEYS; k++)
+                crcs[k] = cne_crc32c(keys[k], key_lens[i], n);
+        ref = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+        sink += crcs[0];
+
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP; n++)
+            cne_crc32c_bulk(keys, key_lens[i], n, crcs, NB_KEYS);
+        vec = (cne_rdtsc_precise() - start) / BENCH_LOOP;
+        sink += crcs[0];
+
+        tst_info("%6u %15lu.%02lu %15lu.%02lu\n", key_lens[i], ref / NB_KEYS,
+                 ((ref % NB_KEYS) * 100) / NB_KEYS, vec / NB_KEYS,
+                 ((vec % NB_KEYS) * 100) / NB_KEYS);
+    }
+
+    tst_info("%6s %18s %18s\n", "bytes", "crc32 table cyc", "crc32 pclmul cyc");
+    for (size_t i = 0; i < cne_countof(sizes); i++) {
+        cne_crc_set_alg(CNE_CRC_SCALAR);
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP / 10; n++)
+            sink += cne_crc32_eth(buf + (n & 63), sizes[i]);
+        ref = (cne_rdtsc_precise() - start) / (BENCH_LOOP / 10);
+
+        if (cne_crc_set_alg(CNE_CRC_PCLMULQDQ) < 0) {
+            tst_info("%6zu %18lu %18s\n", sizes[i], ref, "n/a");
+            continue;
+        }
+        start = cne_rdtsc_precise();
+        for (int n = 0; n < BENCH_LOOP / 10; n++)
+            sink += cne_crc32_eth(buf + (n & 63), sizes[i]);
+        vec = (cne_rdtsc_precise() - start) / (BENCH_LOOP / 10);
+
+        tst_info("%6zu %18lu %18lu\n", sizes[i], ref, vec);
+    }
+
+    tst_info("Bulk lookups of %d keys of %d bytes in a table of %d entries\n", HASH_BURST,
+             HASH_KEY_LEN, HASH_ENTRIES);
+    for (size_t i = 0; i < cne_countof(funcs); i++) {
+        struct cne_hash *h = hash_create(funcs[i].name, funcs[i].func);
+
+        if (!h)
+            return -1;
+        tst_info("  %-14s %4lu cycles per key\n", funcs[i].name, bench_lookup_bulk(h));
+        cne_hash_free(h);
+    }
+
+    return (sink == 0) ? -1 : 0;
+}
+
+int
+crc_main(int argc, char **argv)
+{
+    CNE_SET_USED(argc);
+    CNE_SET_USED(argv);
+
+    srand(0x1edc6f41);
+    for (size_t i = 0; i < BUF_SIZE; i++)
+        buf[i] = rand();
+
+    TST_FUNC(err, "1 - CRC of buffers", test1() < 0 ? TST_FAILED : TST_PASSED);
+    TST_FUNC(err, "2 - CRC32C of bursts of keys", test2() < 0 ? TST_FAILED : TST_PASSED);
+    TST_FUNC(err, "3 - Hash bulk lookups with the default hash",
+             test3() < 0 ? TST_FAILED : TST_PASSED);
+    TST_FUNC(err, "4 - CRC performance", test4() < 0 ? TST_FAILED : TST_PASSED);
+
+    return 0;
+err:
+    return -1;
+}
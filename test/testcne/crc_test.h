@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CRC_TEST_H_
+#define _CRC_TEST_H_
+
+/**
+ * @file
+ * CRC testing functions
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int crc_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CRC_TEST_H_ */
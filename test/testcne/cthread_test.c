@@ -15,9 +15,13 @@
 #include <pthread.h>             // for pthread_create, pthread_join, pthread_...
 #include <stdbool.h>             // for true
 #include <stdint.h>              // for uint64_t
+#include <inttypes.h>            // for PRIu64
 #include <stdlib.h>              // for atoi, calloc
 #include <string.h>              // for memset
 #include <cthread_sema.h>        // for cthread_sema_init, cthread_sema_reset, ..
+#include <sys/epoll.h>           // for EPOLLIN
+#include <sys/eventfd.h>         // for eventfd, EFD_NONBLOCK
+#include <unistd.h>              // for write, close
 
 #include "cthread_test.h"
 #include "cne_cycles.h"        // for cne_rdtsc
@@ -29,6 +33,17 @@
 #define CTHREAD_TYPE         0
 #define PTHREAD_TYPE         1
 
+#define STACK_BENCH_RESERVE (256 * 1024) /**< Virtual bytes per mmap stack */
+#define STACK_BENCH_TOUCH   2048         /**< Bytes of stack each benchmark cthread touches */
+#define STACK_BENCH_MAX     448          /**< Largest cthread count, below the per scheduler limit */
+
+#define STEAL_SCHEDS     4    /**< Number of schedulers in the stealing benchmark */
+#define STEAL_TASKS      64   /**< Number of cthreads all created on scheduler 0 */
+#define STEAL_HEAVY_MOD  8    /**< Every Nth cthread is a heavy one */
+#define STEAL_HEAVY_WORK 2000 /**< Work units for a heavy cthread */
+#define STEAL_LIGHT_WORK 100  /**< Work units for a light cthread */
+#define STEAL_UNIT_US    10   /**< Microseconds of spinning per work unit */
+
 typedef struct {
     uint64_t begin, end;
     uint64_t cnt;
@@ -41,6 +56,17 @@ static int thread_cnt  = DEFAULT_THREAD_COUNT;
 static int thread_time = THREAD_WAIT_TIME;
 static atomic_bool failed;
 
+typedef struct {
+    int idx;
+    pthread_t pthd;
+    struct cthread_sched_stats stats;
+} steal_sched_t;
+
+static steal_sched_t steal_scheds[STEAL_SCHEDS];
+static int stack_bench_counts[] = {64, 128, 256, STACK_BENCH_MAX};
+static volatile int stack_bench_release;
+static atomic_uint steal_done;
+
 static void
 cthread_Tester(void *arg)
 {
@@ -159,6 +185,158 @@ err:
     return -1;
 }
 
+static void
+cthread_fd_writer(void *arg)
+{
+    int efd    = (int)(uintptr_t)arg;
+    uint64_t v = 1;
+
+    cthread_detach();
+
+    cthread_sleep_msec(10);
+    if (write(efd, &v, sizeof(v)) < 0)
+        tst_error("Failed to write eventfd, %s\n", strerror(errno));
+}
+
+static int
+cthread_wait_fd_tests(void)
+{
+    int efd, ret;
+
+    efd = eventfd(0, EFD_NONBLOCK);
+    if (efd < 0) {
+        tst_error("Failed to create eventfd, %s\n", strerror(errno));
+        return -1;
+    }
+
+    ret = cthread_wait_fd(efd, EPOLLIN, 5 * 1000000UL);
+    if (ret != 0) {
+        tst_error("Wait on idle eventfd returned %d, expected timeout\n", ret);
+        goto err;
+    }
+
+    tst_ok("PASS --- TEST: Wait on fd with timeout\n");
+
+    if (cthread_create("fd-writer", cthread_fd_writer, (void *)(uintptr_t)efd) == NULL) {
+        tst_error("Failed to create fd writer cthread\n");
+        goto err;
+    }
+
+    ret = cthread_wait_fd(efd, EPOLLIN, 0);
+    if (ret < 0 || !(ret & EPOLLIN)) {
+        tst_error("Wait on eventfd returned %d, %s\n", ret, strerror(errno));
+        goto err;
+    }
+
+    tst_ok("PASS --- TEST: Wait on fd woken by writer\n");
+
+    close(efd);
+    return 0;
+
+err:
+    close(efd);
+    return -1;
+}
+
+static void
+stack_bench_task(void *arg __cne_unused)
+{
+    volatile char buf[STACK_BENCH_TOUCH];
+
+    for (int i = 0; i < STACK_BENCH_TOUCH; i++)
+        buf[i] = (char)i;
+    CNE_SET_USED(buf);
+
+    while (!stack_bench_release)
+        cthread_sleep_msec(1);
+}
+
+static long
+stack_bench_rss_kb(void)
+{
+    long pages = 0;
+    FILE *f;
+
+    f = fopen("/proc/self/statm", "r");
+    if (!f)
+        return 0;
+    if (fscanf(f, "%*d %ld", &pages) != 1)
+        pages = 0;
+    fclose(f);
+
+    return pages * (getpagesize() / 1024);
+}
+
+/*
+ * Resident memory against cthread count for stack cache and mmap stacks,
+ * all cthreads are alive and have touched a bit of stack when measured.
+ */
+static int
+cthread_stack_bench(void)
+{
+    struct cthread *cts[STACK_BENCH_MAX];
+    struct cthread_sched_stats st;
+    double cache_kb[CNE_DIM(stack_bench_counts)];
+    int ret = 0;
+
+    cthread_stack_hwm_set(1);
+    for (int mode = 0; mode < 2; mode++) {
+        cthread_sched_stack_mmap_set(mode ? STACK_BENCH_RESERVE : 0, 0);
+
+        for (int c = 0; c < (int)CNE_DIM(stack_bench_counts); c++) {
+            int cnt = stack_bench_counts[c], n;
+            long rss;
+
+            stack_bench_release = 0;
+            rss                 = stack_bench_rss_kb();
+
+            for (n = 0; n < cnt; n++) {
+                cts[n] = cthread_create("stack-bench", stack_bench_task, NULL);
+                if (cts[n] == NULL) {
+                    tst_error("cthread_create() failed at %d cthreads\n", n);
+                    ret = -1;
+                    break;
+                }
+            }
+
+            /* let every cthread run and touch its stack */
+            cthread_sleep_msec(5);
+            rss = stack_bench_rss_kb() - rss;
+
+            stack_bench_release = 1;
+            for (int i = 0; i < n; i++)
+                cthread_join(cts[i], NULL);
+
+            cne_printf("  [green]%-12s [magenta]%4d [green]cthreads RSS [red]%8ld[] [green]KB, "
+                       "[red]%6.1f[] [green]KB per cthread[]\n",
+                       mode ? "mmap stack" : "stack cache", n, rss, n ? (double)rss / n : 0.0);
+            if (ret < 0)
+                goto leave;
+
+            /* only the touched pages of a mmap stack are resident */
+            if (mode == 0)
+                cache_kb[c] = (double)rss / n;
+            else if ((double)rss / n >= cache_kb[c]) {
+                tst_error("mmap stack RSS %.1f KB per cthread is not below stack cache %.1f KB\n",
+                          (double)rss / n, cache_kb[c]);
+                ret = -1;
+                goto leave;
+            }
+        }
+    }
+
+leave:
+    cthread_sched_stack_mmap_set(0, 0);
+    cthread_stack_hwm_set(0);
+
+    if (cthread_sched_stats(NULL, &st) == 0)
+        cne_printf("  [green]Stack high water mark [red]%" PRIu64
+                   "[] [green]bytes, mapped [red]%" PRIu64 "[], [green]released [red]%" PRIu64
+                   "[]\n",
+                   st.stack_hwm, st.stacks_mapped, st.stacks_released);
+    return ret;
+}
+
 static int
 cthread_start_threads(void)
 {
@@ -196,6 +374,23 @@ cthread_start_threads(void)
     else
         tst_end(tst, TST_PASSED);
 
+    if (err < 0)
+        return -1;
+
+    cne_printf("\n");
+    tst = tst_start("Cthread wait fd");
+
+    err = cthread_wait_fd_tests();
+    tst_end(tst, (err < 0) ? TST_FAILED : TST_PASSED);
+    if (err < 0)
+        return -1;
+
+    cne_printf("\n");
+    tst = tst_start("Cthread stack memory");
+
+    err = cthread_stack_bench();
+    tst_end(tst, (err < 0) ? TST_FAILED : TST_PASSED);
+
     return err < 0 ? -1 : 0;
 }
 
@@ -263,6 +458,136 @@ pthread_main_spawner(void)
     }
 }
 
+static void
+steal_task(void *arg)
+{
+    uint64_t units = (uintptr_t)arg;
+    uint64_t unit  = (cne_get_timer_hz() / 1000000) * STEAL_UNIT_US;
+
+    for (uint64_t i = 0; i < units; i++) {
+        uint64_t stop = cne_rdtsc() + unit;
+
+        while (cne_rdtsc() < stop)
+            ;
+        cthread_yield();
+    }
+    atomic_fetch_add(&steal_done, 1);
+}
+
+static void *
+steal_sched_thread(void *arg)
+{
+    steal_sched_t *ss = arg;
+    char name[32];
+
+    snprintf(name, sizeof(name), "steal-%d", ss->idx);
+    if (cne_register(name) < 0) {
+        tst_error("cne_register(%s) failed\n", name);
+        atomic_store(&failed, true);
+        return NULL;
+    }
+
+    if (cthread_sched_create(0) < 0) {
+        tst_error("%s cthread_sched_create() failed\n", name);
+        atomic_store(&failed, true);
+        goto leave;
+    }
+
+    /* skew the load by creating every cthread on the first scheduler */
+    if (ss->idx == 0) {
+        for (int i = 0; i < STEAL_TASKS; i++) {
+            uintptr_t units = (i % STEAL_HEAVY_MOD) ? STEAL_LIGHT_WORK : STEAL_HEAVY_WORK;
+
+            snprintf(name, sizeof(name), "steal-task-%d", i);
+            if (cthread_create(name, steal_task, (void *)units) == NULL) {
+                tst_error("%s cthread_create() failed\n", name);
+                atomic_store(&failed, true);
+                break;
+            }
+        }
+    }
+
+    cthread_run();
+
+    cthread_sched_stats(NULL, &ss->stats);
+leave:
+    cne_unregister(-1);
+    return NULL;
+}
+
+static int
+cthread_steal_run(int steal, uint64_t *cycles)
+{
+    uint64_t begin;
+
+    memset(steal_scheds, 0, sizeof(steal_scheds));
+    atomic_store(&steal_done, 0);
+
+    cthread_work_steal_set(steal);
+    cthread_num_schedulers_set(STEAL_SCHEDS);
+
+    begin = cne_rdtsc();
+    for (int i = 0; i < STEAL_SCHEDS; i++) {
+        steal_sched_t *ss = &steal_scheds[i];
+
+        ss->idx = i;
+        if (pthread_create(&ss->pthd, NULL, steal_sched_thread, ss)) {
+            tst_error("pthread_create() failed\n");
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < STEAL_SCHEDS; i++)
+        pthread_join(steal_scheds[i].pthd, NULL);
+    *cycles = cne_rdtsc() - begin;
+
+    cthread_work_steal_set(0);
+
+    cne_printf("  [green]Work stealing [yellow]%-8s[] [green]elapsed [red]%8.2f[] [green]ms[]\n",
+               steal ? "enabled" : "disabled", (double)*cycles * 1000.0 / cne_get_timer_hz());
+    for (int i = 0; i < STEAL_SCHEDS; i++) {
+        struct cthread_sched_stats *st = &steal_scheds[i].stats;
+
+        cne_printf("    [green]Scheduler [magenta]%d [green]steals [red]%6" PRIu64
+                   "[], [green]stolen [red]%6" PRIu64 "[], [green]misses [red]%10" PRIu64
+                   "[]\n",
+                   i, st->steals, st->stolen, st->steal_misses);
+    }
+
+    if (atomic_load(&steal_done) != STEAL_TASKS) {
+        tst_error("Only %u of %d cthreads finished\n", atomic_load(&steal_done), STEAL_TASKS);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Skewed load benchmark, all cthreads are created on one scheduler and a few
+ * of them are much heavier than the rest. With stealing enabled the idle
+ * schedulers take work from the busy one.
+ */
+static int
+cthread_steal_bench(void)
+{
+    uint64_t off, on;
+    tst_info_t *tst;
+
+    if (cne_max_threads() < STEAL_SCHEDS + 1)
+        return 0;
+
+    tst = tst_start("Cthread work stealing");
+
+    if (cthread_steal_run(0, &off) < 0 || cthread_steal_run(1, &on) < 0) {
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    cne_printf("  [green]Speedup [red]%.2fx[]\n", (double)off / (double)on);
+    tst_end(tst, TST_PASSED);
+
+    return 0;
+}
+
 int
 cthread_main(int argc, char **argv)
 {
@@ -307,6 +632,10 @@ cthread_main(int argc, char **argv)
     cne_printf("\n");
     pthread_main_spawner();
 
+    cne_printf("\n");
+    if (cthread_steal_bench() < 0)
+        atomic_store(&failed, true);
+
 leave:
     if (atomic_load(&failed))
         tst_end(tst, TST_FAILED);
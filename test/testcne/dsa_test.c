@@ -6,8 +6,11 @@
 #include <stdlib.h>
 
 #include <cne_common.h>
+#include <cne_cycles.h>
 #include <cne_dsa.h>
+#include <dsa_copy.h>
 #include <cne_mmap.h>
+#include <cne_system.h>
 #include <pktmbuf.h>
 #include <tst_info.h>
 
@@ -15,6 +18,16 @@
 
 #define COPY_LEN 1024
 
+#define SG_MBUFS         4
+#define TPUT_COPIES      (64 * 1024)
+#define TPUT_LEN         256
+#define TPUT_MAX_BATCH   128
+
+#define ENGINE_COPIES    16
+#define ENGINE_THRESHOLD 512
+#define BENCH_BUF_LEN    (64 * 1024)
+#define BENCH_BYTES      (256ULL * 1024 * 1024)
+
 /* all tests use the same pktmbuf pool */
 static pktmbuf_info_t *pi;
 static mmap_t *mm;
@@ -760,6 +773,424 @@ test_open_multiple(void)
     return err;
 }
 
+static int
+test_copy_burst(uint16_t dev)
+{
+#define CB_BURST 32
+    struct dsa_burst_op ops[CB_BURST];
+    uintptr_t srcs[CB_BURST], dsts[CB_BURST];
+    char *src = NULL, *dst = NULL;
+    int i, n, ret = -1;
+
+    src = malloc(CB_BURST * COPY_LEN);
+    dst = calloc(CB_BURST, COPY_LEN);
+    if (!src || !dst) {
+        tst_error("Unable to allocate buffers\n");
+        goto leave;
+    }
+
+    for (i = 0; i < CB_BURST * COPY_LEN; i++)
+        src[i] = rand() & 0xFF;
+
+    for (i = 0; i < CB_BURST; i++) {
+        ops[i].src     = (uintptr_t)(src + i * COPY_LEN);
+        ops[i].dst     = (uintptr_t)(dst + i * COPY_LEN);
+        ops[i].length  = COPY_LEN;
+        ops[i].src_hdl = i;
+        ops[i].dst_hdl = CB_BURST - i;
+    }
+
+    if (dsa_enqueue_copy_burst(dev, ops, CB_BURST) != CB_BURST) {
+        tst_error("dsa_enqueue_copy_burst() failed\n");
+        goto leave;
+    }
+    if (dsa_perform_ops(dev)) {
+        tst_error("dsa_perform_ops() failed\n");
+        goto leave;
+    }
+
+    /* an odd first poll size mixes the scalar and the vector scans of the handles */
+    n = dsa_completed_ops(dev, 5, NULL, NULL, srcs, dsts);
+    if (n != 5) {
+        tst_error("dsa_completed_ops() returned %d\n", n);
+        goto leave;
+    }
+    n += dsa_completed_ops(dev, CB_BURST - 5, NULL, NULL, &srcs[5], &dsts[5]);
+    if (n != CB_BURST) {
+        tst_error("dsa_completed_ops() returned %d\n", n);
+        goto leave;
+    }
+
+    for (i = 0; i < CB_BURST; i++) {
+        if (srcs[i] != (uintptr_t)i || dsts[i] != (uintptr_t)(CB_BURST - i)) {
+            tst_error("Handles of op %d are wrong\n", i);
+            goto leave;
+        }
+    }
+    if (memcmp(dst, src, CB_BURST * COPY_LEN)) {
+        tst_error("Data mismatch\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    free(src);
+    free(dst);
+    return ret;
+}
+
+static int
+test_gather_scatter(uint16_t dev)
+{
+    const uint16_t lens[SG_MBUFS] = {60, 1024, 1500, 333};
+    pktmbuf_t *m[SG_MBUFS]        = {0}, *mc[SG_MBUFS] = {0};
+    uintptr_t src_hdl, dst_hdl;
+    uint32_t status = 0, total = 0;
+    uint8_t not_ok  = 0;
+    char *buf       = NULL;
+    void *addr;
+    int i, ret = -1;
+
+    for (i = 0; i < SG_MBUFS; i++) {
+        char *data;
+
+        m[i]  = pktmbuf_alloc(pi);
+        mc[i] = pktmbuf_alloc(pi);
+        if (!m[i] || !mc[i]) {
+            tst_error("pktmbuf_alloc() failed\n");
+            goto leave;
+        }
+
+        data = pktmbuf_append(m[i], lens[i]);
+        if (!data || !pktmbuf_append(mc[i], lens[i])) {
+            tst_error("pktmbuf_append() failed\n");
+            goto leave;
+        }
+        for (int j = 0; j < lens[i]; j++)
+            data[j] = rand() & 0xFF;
+        total += lens[i];
+    }
+
+    buf = calloc(1, total);
+    if (!buf) {
+        tst_error("Unable to allocate buffer\n");
+        goto leave;
+    }
+
+    /* gather the mbufs into buf, reported as one op */
+    if (dsa_enqueue_gather(dev, m, SG_MBUFS, (uintptr_t)buf, 1, 2) != 1 || dsa_perform_ops(dev)) {
+        tst_error("dsa_enqueue_gather() failed\n");
+        goto leave;
+    }
+    if (dsa_completed_ops(dev, 1, NULL, NULL, &src_hdl, &dst_hdl) != 1 || src_hdl != 1 ||
+        dst_hdl != 2) {
+        tst_error("Gather completion is wrong\n");
+        goto leave;
+    }
+
+    /* scatter buf back into the copies */
+    if (dsa_enqueue_scatter(dev, (uintptr_t)buf, mc, SG_MBUFS, 3, 4) != 1 || dsa_perform_ops(dev)) {
+        tst_error("dsa_enqueue_scatter() failed\n");
+        goto leave;
+    }
+    if (dsa_completed_ops(dev, 1, NULL, NULL, &src_hdl, &dst_hdl) != 1 || src_hdl != 3 ||
+        dst_hdl != 4) {
+        tst_error("Scatter completion is wrong\n");
+        goto leave;
+    }
+
+    for (i = 0; i < SG_MBUFS; i++) {
+        if (memcmp(pktmbuf_mtod(mc[i], char *), pktmbuf_mtod(m[i], char *), lens[i])) {
+            tst_error("Data of mbuf %d does not match\n", i);
+            goto leave;
+        }
+    }
+
+    /* a copy from a NULL address fails the whole gather */
+    addr                   = m[1]->buf_addr;
+    m[1]->buf_addr         = NULL;
+    pktmbuf_data_off(m[1]) = 0;
+    if (dsa_enqueue_gather(dev, m, SG_MBUFS, (uintptr_t)buf, 5, 6) != 1 || dsa_perform_ops(dev)) {
+        m[1]->buf_addr = addr;
+        tst_error("dsa_enqueue_gather() failed\n");
+        goto leave;
+    }
+    m[1]->buf_addr = addr;
+    if (dsa_completed_ops(dev, 1, &status, &not_ok, &src_hdl, &dst_hdl) != 1 || not_ok != 1 ||
+        status == DSA_OP_SUCCESS || src_hdl != 5) {
+        tst_error("Failed gather was not reported\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    free(buf);
+    pktmbuf_free_bulk(m, SG_MBUFS);
+    pktmbuf_free_bulk(mc, SG_MBUFS);
+    return ret;
+}
+
+/* Throughput of small copies against the number of copies submitted per batch */
+static int
+test_batch_throughput(uint16_t dev)
+{
+    struct dsa_burst_op ops[TPUT_MAX_BATCH];
+    uintptr_t hdls[TPUT_MAX_BATCH];
+    char *src, *dst;
+    int ret = -1;
+
+    src = malloc(TPUT_MAX_BATCH * TPUT_LEN);
+    dst = malloc(TPUT_MAX_BATCH * TPUT_LEN);
+    if (!src || !dst) {
+        tst_error("Unable to allocate buffers\n");
+        goto leave;
+    }
+    memset(src, 0xA5, TPUT_MAX_BATCH * TPUT_LEN);
+
+    for (int i = 0; i < TPUT_MAX_BATCH; i++) {
+        ops[i].src     = (uintptr_t)(src + i * TPUT_LEN);
+        ops[i].dst     = (uintptr_t)(dst + i * TPUT_LEN);
+        ops[i].length  = TPUT_LEN;
+        ops[i].src_hdl = i;
+        ops[i].dst_hdl = i;
+    }
+
+    for (uint16_t batch = 1; batch <= TPUT_MAX_BATCH; batch *= 2) {
+        uint64_t start, cycles;
+
+        start = cne_rdtsc();
+        for (int done = 0; done < TPUT_COPIES;) {
+            int n = 0;
+
+            if (dsa_enqueue_copy_burst(dev, ops, batch) != batch || dsa_perform_ops(dev)) {
+                tst_error("Failed to submit a batch of %u copies\n", batch);
+                goto leave;
+            }
+            while (n < batch) {
+                int c = dsa_completed_ops(dev, batch - n, NULL, NULL, hdls, NULL);
+
+                if (c < 0) {
+                    tst_error("dsa_completed_ops() failed\n");
+                    goto leave;
+                }
+                n += c;
+            }
+            done += batch;
+        }
+        cycles = cne_rdtsc() - start;
+
+        tst_info("batch %3u: %5lu cycles/copy, %6.2f Mcopies/s\n", batch, cycles / TPUT_COPIES,
+                 ((double)TPUT_COPIES * cne_get_timer_hz()) / ((double)cycles * 1e6));
+    }
+
+    ret = 0;
+leave:
+    free(src);
+    free(dst);
+    return ret;
+}
+
+struct copy_done {
+    int next;   /* index of the next expected completion */
+    int errors; /* completions out of order or failed */
+};
+
+struct copy_arg {
+    struct copy_done *done;
+    int idx;
+};
+
+static void
+copy_cb(void *arg, uint32_t status)
+{
+    struct copy_arg *ca = arg;
+
+    if (status != DSA_OP_SUCCESS || ca->idx != ca->done->next)
+        ca->done->errors++;
+    ca->done->next++;
+}
+
+static int
+test_copy_engine(void)
+{
+    struct copy_arg args[ENGINE_COPIES];
+    struct copy_done done = {0};
+    struct dsa_copy_stats stats;
+    char *src = NULL, *dst = NULL;
+    dsa_copy_t *dc;
+    int i, ret = -1;
+
+    dc = dsa_copy_create("wq0.0", ENGINE_THRESHOLD, 4);
+    if (!dc) {
+        tst_error("dsa_copy_create() failed\n");
+        return -1;
+    }
+
+    src = malloc(ENGINE_COPIES * COPY_LEN);
+    dst = calloc(ENGINE_COPIES, COPY_LEN);
+    if (!src || !dst) {
+        tst_error("Unable to allocate buffers\n");
+        goto leave;
+    }
+    for (i = 0; i < ENGINE_COPIES * COPY_LEN; i++)
+        src[i] = rand() & 0xFF;
+
+    /* Copies below the threshold are done at once */
+    if (dsa_copy(dc, dst, src, ENGINE_THRESHOLD - 1, copy_cb, NULL) != 0 ||
+        memcmp(dst, src, ENGINE_THRESHOLD - 1)) {
+        tst_error("Small copy was not done by the CPU\n");
+        goto leave;
+    }
+
+    /* Large copies are queued and completed in order, the fence splits them in two */
+    for (i = 0; i < ENGINE_COPIES; i++) {
+        args[i].done = &done;
+        args[i].idx  = i;
+        if (i == ENGINE_COPIES / 2 && dsa_copy_fence(dc) < 0) {
+            tst_error("dsa_copy_fence() failed\n");
+            goto leave;
+        }
+        if (dsa_copy(dc, dst + i * COPY_LEN, src + i * COPY_LEN, COPY_LEN, copy_cb, &args[i]) !=
+            1) {
+            tst_error("Copy %d was not queued\n", i);
+            goto leave;
+        }
+    }
+
+    if (dsa_copy_wait(dc) != 0 || dsa_copy_pending(dc) != 0) {
+        tst_error("dsa_copy_wait() failed\n");
+        goto leave;
+    }
+    if (done.next != ENGINE_COPIES || done.errors) {
+        tst_error("%d callbacks, %d out of order or failed\n", done.next, done.errors);
+        goto leave;
+    }
+    if (memcmp(dst, src, ENGINE_COPIES * COPY_LEN)) {
+        tst_error("Data mismatch\n");
+        goto leave;
+    }
+
+    if (dsa_copy_stats_get(dc, &stats) < 0 || stats.cpu_copies != 1 ||
+        stats.dev_copies != ENGINE_COPIES || stats.fences != 1 || stats.failed) {
+        tst_error("Unexpected engine stats\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    free(src);
+    free(dst);
+    dsa_copy_destroy(dc);
+    return ret;
+}
+
+static int
+test_copy_pktmbuf(void)
+{
+    pktmbuf_t *m = NULL, *mc = NULL;
+    dsa_copy_t *dc;
+    char *data;
+    int i, ret = -1;
+
+    dc = dsa_copy_create("wq0.0", ENGINE_THRESHOLD, 0);
+    if (!dc) {
+        tst_error("dsa_copy_create() failed\n");
+        return -1;
+    }
+
+    m = pktmbuf_alloc(pi);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        goto leave;
+    }
+
+    data = pktmbuf_append(m, COPY_LEN);
+    if (!data) {
+        tst_error("pktmbuf_append() failed\n");
+        goto leave;
+    }
+    for (i = 0; i < COPY_LEN; i++)
+        data[i] = rand() & 0xFF;
+
+    if (dsa_copy_pktmbuf(dc, m, pi, 16, UINT32_MAX, &mc, NULL, NULL) != 1) {
+        tst_error("dsa_copy_pktmbuf() did not queue the copy\n");
+        goto leave;
+    }
+    if (dsa_copy_wait(dc) != 0) {
+        tst_error("dsa_copy_wait() failed\n");
+        goto leave;
+    }
+
+    if (pktmbuf_data_len(mc) != COPY_LEN - 16 ||
+        memcmp(pktmbuf_mtod(mc, char *), data + 16, COPY_LEN - 16)) {
+        tst_error("Copied mbuf does not match\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    pktmbuf_free(m);
+    pktmbuf_free(mc);
+    dsa_copy_destroy(dc);
+    return ret;
+}
+
+/* Compare the CPU cycles spent per GB moved by memcpy() and by the copy engine */
+static int
+test_copy_bench(void)
+{
+    uint64_t start, cpu, issue = 0, total, gb = 1024ULL * 1024 * 1024;
+    char *src, *dst;
+    dsa_copy_t *dc;
+    int ret = -1;
+
+    src = malloc(BENCH_BUF_LEN);
+    dst = malloc(BENCH_BUF_LEN);
+    dc  = dsa_copy_create("wq0.0", 0, 0);
+    if (!src || !dst || !dc) {
+        tst_error("Unable to allocate the benchmark buffers or engine\n");
+        goto leave;
+    }
+    memset(src, 0x5A, BENCH_BUF_LEN);
+    memset(dst, 0, BENCH_BUF_LEN);
+
+    start = cne_rdtsc();
+    for (uint64_t n = 0; n < BENCH_BYTES; n += BENCH_BUF_LEN)
+        memcpy(dst, src, BENCH_BUF_LEN);
+    cpu = cne_rdtsc() - start;
+
+    /* issue counts the cycles the thread spends queuing, the rest it could do other work */
+    total = cne_rdtsc();
+    for (uint64_t n = 0; n < BENCH_BYTES; n += BENCH_BUF_LEN) {
+        start = cne_rdtsc();
+        if (dsa_copy(dc, dst, src, BENCH_BUF_LEN, NULL, NULL) < 0) {
+            tst_error("dsa_copy() failed\n");
+            goto leave;
+        }
+        issue += cne_rdtsc() - start;
+        dsa_copy_poll(dc, DSA_COPY_POLL_MAX);
+    }
+    if (dsa_copy_wait(dc) != 0) {
+        tst_error("dsa_copy_wait() failed\n");
+        goto leave;
+    }
+    total = cne_rdtsc() - total;
+
+    cpu   = (cpu * gb) / BENCH_BYTES;
+    issue = (issue * gb) / BENCH_BYTES;
+    total = (total * gb) / BENCH_BYTES;
+    tst_info("memcpy:    %lu cycles/GB\n", cpu);
+    tst_info("engine:    %lu cycles/GB to queue, %lu cycles/GB to completion\n", issue, total);
+    tst_info("CPU saved: %ld cycles/GB\n", (int64_t)cpu - (int64_t)issue);
+
+    ret = 0;
+leave:
+    dsa_copy_destroy(dc);
+    free(src);
+    free(dst);
+    return ret;
+}
+
 int
 dsa_main(int argc __cne_unused, char **argv __cne_unused)
 {
@@ -831,6 +1262,25 @@ dsa_main(int argc __cne_unused, char **argv __cne_unused)
         goto err;
     tst_end(tst, TST_PASSED);
 
+    /* burst of copies */
+    tst = tst_start("DSA: copy burst");
+    for (i = 0; i < 100; i++)
+        if (test_copy_burst(dev))
+            goto err;
+    tst_end(tst, TST_PASSED);
+
+    /* gather and scatter mbufs */
+    tst = tst_start("DSA: gather and scatter");
+    if (test_gather_scatter(dev))
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    /* throughput against the batch size */
+    tst = tst_start("DSA: batch throughput");
+    if (test_batch_throughput(dev))
+        goto err;
+    tst_end(tst, TST_PASSED);
+
     /* Close Device */
     tst = tst_start("DSA: close");
     if (dsa_close(dev)) {
@@ -843,6 +1293,21 @@ dsa_main(int argc __cne_unused, char **argv __cne_unused)
     if (test_open_multiple())
         goto err;
     tst_end(tst, TST_PASSED);
+
+    tst = tst_start("DSA: copy engine");
+    if (test_copy_engine())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    tst = tst_start("DSA: copy engine pktmbuf");
+    if (test_copy_pktmbuf())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    tst = tst_start("DSA: copy engine benchmark");
+    if (test_copy_bench())
+        goto err;
+    tst_end(tst, TST_PASSED);
     free_pool();
     return 0;
 
@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+// IWYU pragma: no_include <bits/getopt_core.h>
+
+#include <stdio.h>          // for EOF
+#include <stdint.h>         // for uint64_t, uint32_t
+#include <inttypes.h>       // for PRIu64
+#include <getopt.h>         // for getopt_long, option
+#include <pthread.h>        // for pthread_create, pthread_join
+#include <tst_info.h>          // for tst_end, tst_start, TST_FAILED, TST_PASSED
+#include <cne_common.h>        // for CNE_SET_USED
+#include <cne_hist.h>
+
+#include "hist_test.h"
+#include "cne_log.h"        // for CNE_ERR_GOTO
+
+#define TST_FUNC(lb, name, f)              \
+    do {                                   \
+        tst_info_t *tst = tst_start(name); \
+        int t;                             \
+        if (tst == NULL)                   \
+            return -1;                     \
+        t = f;                             \
+        tst_end(tst, t);                   \
+        if (t == TST_FAILED)               \
+            goto lb;                       \
+    } while ((0))
+
+#define NB_VALUES  10000
+#define NB_THREADS 4
+#define NB_RECORDS (1024 * 1024)
+
+static int verbose;
+
+/* The reported value must be within the precision of the histogram */
+static int
+check_value(uint64_t got, uint64_t expect, uint32_t sub_bits)
+{
+    uint64_t err = expect >> (sub_bits - 1);
+
+    if (got < expect || got > expect + err) {
+        tst_error("Value %" PRIu64 " expected %" PRIu64 " to %" PRIu64 "\n", got, expect,
+                  expect + err);
+        return -1;
+    }
+    return 0;
+}
+
+static int
+test1(void)
+{
+    cne_hist_t *h;
+    cne_hist_rec_t *r, *s = NULL;
+    uint32_t prev = 0;
+
+    h = cne_hist_create("hist-test1", 7, 32, 1);
+    if (!h)
+        CNE_ERR_GOTO(leave, "cne_hist_create() failed\n");
+
+    /* Every value maps to a bucket holding it and the buckets are in order */
+    for (uint64_t v = 1; v < (1ULL << 32); v += (v >> 6) + 1) {
+        uint32_t idx = cne_hist_index(7, v);
+
+        if (idx < prev || v < cne_hist_bucket_low(7, idx) || v > cne_hist_bucket_high(7, idx))
+            CNE_ERR_GOTO(leave, "Value %" PRIu64 " is not in bucket %u\n", v, idx);
+        prev = idx;
+    }
+
+    r = cne_hist_recorder(h);
+    if (!r)
+        CNE_ERR_GOTO(leave, "cne_hist_recorder() failed\n");
+    if (cne_hist_recorder(h))
+        CNE_ERR_GOTO(leave, "Claimed more recorders than created\n");
+
+    for (uint64_t v = 1; v <= NB_VALUES; v++)
+        cne_hist_record(r, v * 100);
+
+    s = cne_hist_snapshot_alloc(h);
+    if (!s || cne_hist_snapshot(h, s) < 0)
+        CNE_ERR_GOTO(leave, "cne_hist_snapshot() failed\n");
+
+    if (s->count != NB_VALUES || s->min != 100 || s->max != NB_VALUES * 100)
+        CNE_ERR_GOTO(leave, "count %" PRIu64 " min %" PRIu64 " max %" PRIu64 "\n", s->count,
+                     s->min, s->max);
+    if (cne_hist_mean(s) != (double)(NB_VALUES + 1) * 50)
+        CNE_ERR_GOTO(leave, "Mean %f is wrong\n", cne_hist_mean(s));
+    if (check_value(cne_hist_percentile(s, 50.0), NB_VALUES * 50, 7) ||
+        check_value(cne_hist_percentile(s, 99.0), NB_VALUES * 99, 7) ||
+        cne_hist_percentile(s, 100.0) != NB_VALUES * 100 || cne_hist_percentile(s, 0.0) != 100)
+        CNE_ERR_GOTO(leave, "Percentiles are wrong\n");
+
+    cne_hist_reset(h);
+    if (cne_hist_snapshot(h, s) < 0 || s->count != 0 || cne_hist_percentile(s, 50.0) != 0)
+        CNE_ERR_GOTO(leave, "Histogram is not empty after reset\n");
+
+    cne_hist_snapshot_free(s);
+    cne_hist_destroy(h);
+
+    return TST_PASSED;
+leave:
+    cne_hist_snapshot_free(s);
+    cne_hist_destroy(h);
+    return TST_FAILED;
+}
+
+static void *
+writer(void *arg)
+{
+    cne_hist_t *h     = arg;
+    cne_hist_rec_t *r = cne_hist_recorder(h);
+
+    if (!r)
+        return NULL;
+
+    for (uint64_t i = 0; i < NB_RECORDS; i++)
+        cne_hist_record(r, i & 0xFFFF);
+
+    return NULL;
+}
+
+static int
+test2(void)
+{
+    pthread_t tid[NB_THREADS];
+    cne_hist_rec_t *s = NULL, *prev = NULL;
+    cne_hist_t *h;
+    uint64_t before;
+    int started = 0;
+
+    h = cne_hist_create("hist-test2", 0, 0, NB_THREADS);
+    if (!h)
+        return TST_FAILED;
+
+    s    = cne_hist_snapshot_alloc(h);
+    prev = cne_hist_snapshot_alloc(h);
+    if (!s || !prev)
+        CNE_ERR_GOTO(leave, "cne_hist_snapshot_alloc() failed\n");
+
+    for (; started < NB_THREADS; started++)
+        if (pthread_create(&tid[started], NULL, writer, h))
+            CNE_ERR_GOTO(leave, "pthread_create() failed\n");
+
+    /* Snapshots taken while recording only grow */
+    for (int i = 0; i < 100; i++) {
+        if (cne_hist_snapshot(h, s) < 0)
+            CNE_ERR_GOTO(leave, "cne_hist_snapshot() failed\n");
+        if (s->count < prev->count)
+            CNE_ERR_GOTO(leave, "Snapshot count went back from %" PRIu64 " to %" PRIu64 "\n",
+                         prev->count, s->count);
+        cne_hist_snapshot(h, prev);
+    }
+
+    for (int i = 0; i < NB_THREADS; i++)
+        pthread_join(tid[i], NULL);
+    started = 0;
+
+    if (cne_hist_snapshot(h, s) < 0 || s->count != (uint64_t)NB_THREADS * NB_RECORDS)
+        CNE_ERR_GOTO(leave, "Snapshot count %" PRIu64 " expected %" PRIu64 "\n", s->count,
+                     (uint64_t)NB_THREADS * NB_RECORDS);
+    if (s->min != 0 || s->max != 0xFFFF)
+        CNE_ERR_GOTO(leave, "min %" PRIu64 " max %" PRIu64 "\n", s->min, s->max);
+    if (check_value(cne_hist_percentile(s, 50.0), 0x7FFF, CNE_HIST_DEFAULT_SUB))
+        CNE_ERR_GOTO(leave, "Median is wrong\n");
+
+    /* The interval since prev plus prev is the whole histogram */
+    before = prev->count;
+    if (cne_hist_sub(prev, s, prev) < 0 || prev->count != s->count - before)
+        CNE_ERR_GOTO(leave, "cne_hist_sub() failed\n");
+    if (verbose)
+        tst_info("Last interval %" PRIu64 " values, p99 %" PRIu64 "\n", prev->count,
+                 cne_hist_percentile(prev, 99.0));
+
+    cne_hist_snapshot_free(s);
+    cne_hist_snapshot_free(prev);
+    cne_hist_destroy(h);
+
+    return TST_PASSED;
+leave:
+    for (int i = 0; i < started; i++)
+        pthread_join(tid[i], NULL);
+    cne_hist_snapshot_free(s);
+    cne_hist_snapshot_free(prev);
+    cne_hist_destroy(h);
+    return TST_FAILED;
+}
+
+int
+hist_main(int argc, char **argv)
+{
+    int opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argvopt, "V", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'V':
+            verbose = 1;
+            break;
+        default:
+            break;
+        }
+    }
+
+    TST_FUNC(err, "1 - Histogram record and percentiles", test1());
+    TST_FUNC(err, "2 - Histogram per-thread recorders", test2());
+
+    return 0;
+err:
+    return -1;
+}
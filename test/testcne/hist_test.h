@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _HIST_TEST_H_
+#define _HIST_TEST_H_
+
+/**
+ * @file
+ * Histogram testing functions
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int hist_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HIST_TEST_H_ */
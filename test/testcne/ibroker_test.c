@@ -9,9 +9,12 @@
 #include <cne_mmap.h>          // for MMAP_HUGEPAGE_4KB, MMAP_HUGEPAGE_2MB
 #include <tst_info.h>          // for tst_cleanup, tst_error, tst_end, tst_s...
 #include <unistd.h>            // for getpagesize
+#include <pthread.h>           // for pthread_create, pthread_join
+#include <stdatomic.h>         // for atomic_load, atomic_store
 #include <cne_common.h>        // for CNE_SET_USED, cne_countof
 #include <cne.h>
 #include <cne_log.h>
+#include <cne_cycles.h>        // for cne_rdtsc, cne_get_timer_hz
 #include <ibroker.h>        // for ibroker_create, ibroker_destroy, ...
 
 #include "ibroker_test.h"
@@ -25,6 +28,125 @@ walk_routine(broker_id_t bid, void *arg)
     return 0;
 }
 
+#define SIGNAL_COUNT   1000 /**< Number of signals sent for each latency test */
+#define SIGNAL_SID     1    /**< Service ID used by the latency tests */
+#define SIGNAL_WAIT_MS 1000 /**< Time to wait for a signal to arrive */
+
+static atomic_int rx_running;
+static atomic_int rx_bid;
+static atomic_uint_least64_t rx_cnt;
+static volatile uint64_t send_stamp;
+static uint64_t rx_cycles;
+static ibroker_info_t rx_info;
+
+static int
+latency_service(int vector, void *arg)
+{
+    uint64_t *cycles = arg;
+
+    CNE_SET_USED(vector);
+
+    *cycles += cne_rdtsc() - send_stamp;
+    atomic_fetch_add(&rx_cnt, 1);
+
+    return 0;
+}
+
+static void *
+receiver(void *arg)
+{
+    broker_id_t bid;
+
+    CNE_SET_USED(arg);
+
+    bid = ibroker_create("Latency Broker");
+    if (bid < 0)
+        goto leave;
+
+    if (ibroker_add_service(bid, "Latency", SIGNAL_SID, latency_service, &rx_cycles) < 0) {
+        ibroker_destroy(bid);
+        goto leave;
+    }
+    atomic_store(&rx_bid, bid);
+
+    while (atomic_load(&rx_running))
+        if (ibroker_wait(bid, 10) < 0)
+            break;
+
+    ibroker_info(bid, &rx_info);
+    ibroker_del_service(bid, SIGNAL_SID);
+    ibroker_destroy(bid);
+    return NULL;
+leave:
+    atomic_store(&rx_bid, -2);
+    return NULL;
+}
+
+/*
+ * Send signals to a receiver thread with a delay between them, a short delay finds the
+ * receiver polling the doorbell and a long delay finds it sleeping on the eventfd.
+ */
+static int
+signal_latency(int delay_us)
+{
+    uint64_t hz = cne_get_timer_hz(), limit;
+    pthread_t tid;
+    broker_id_t bid;
+    int ret = -1;
+
+    rx_cycles = 0;
+    atomic_store(&rx_cnt, 0);
+    atomic_store(&rx_bid, -1);
+    atomic_store(&rx_running, 1);
+
+    if (pthread_create(&tid, NULL, receiver, NULL)) {
+        tst_error("pthread_create() failed\n");
+        return -1;
+    }
+
+    while ((bid = atomic_load(&rx_bid)) == -1)
+        usleep(10);
+    if (bid < 0) {
+        tst_error("Receiver broker create failed\n");
+        goto leave;
+    }
+
+    if (ibroker_register_sender(bid, SIGNAL_SID) < 0) {
+        tst_error("ibroker_register_sender(%d, %d) failed\n", bid, SIGNAL_SID);
+        goto leave;
+    }
+
+    for (uint64_t i = 1; i <= SIGNAL_COUNT; i++) {
+        send_stamp = cne_rdtsc();
+        if (ibroker_send(bid, SIGNAL_SID) < 0) {
+            tst_error("ibroker_send(%d, %d) failed\n", bid, SIGNAL_SID);
+            goto leave;
+        }
+
+        limit = cne_rdtsc() + (hz * SIGNAL_WAIT_MS) / MS_PER_S;
+        while (atomic_load(&rx_cnt) < i) {
+            if (cne_rdtsc() > limit) {
+                tst_error("Signal %lu was not received\n", i);
+                goto leave;
+            }
+        }
+
+        if (delay_us)
+            usleep(delay_us);
+    }
+    ret = 0;
+
+leave:
+    atomic_store(&rx_running, 0);
+    pthread_join(tid, NULL);
+
+    if (ret == 0)
+        tst_ok("%s backend, %5d us between signals: avg latency %6lu ns, %lu sleeps\n",
+               (rx_info.backend == IBROKER_BACKEND_UINTR) ? "UINTR" : "Software", delay_us,
+               ((rx_cycles / SIGNAL_COUNT) * NS_PER_S) / hz, rx_info.wakeups);
+    return ret;
+}
+
 static int
 ibroker_start(void)
 {
@@ -52,8 +174,14 @@ ibroker_start(void)
     } else
         tst_ok("Found ibroker_find('[green]%s[]')\n", buff);
 
+    cne_printf("   [magenta]Backend[]: [green]%s[]\n",
+               (ibroker_backend(bid) == IBROKER_BACKEND_UINTR) ? "UINTR" : "Software doorbell");
+
     ibroker_destroy(bid);
 
+    if (signal_latency(0) < 0 || signal_latency(1000) < 0)
+        return -1;
+
     return 0;
 }
 
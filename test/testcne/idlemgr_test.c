@@ -7,12 +7,17 @@
 #include <stdio.h>         // for NULL, EOF
 #include <stdlib.h>        // for rand
 #include <stdint.h>        // for uint16_t, uint32_t
+#include <inttypes.h>      // for PRIu64
 #include <getopt.h>        // for getopt_long, option
 #include <pthread.h>
+#include <unistd.h>              // for usleep, read
+#include <sys/eventfd.h>         // for eventfd, eventfd_write
 #include <uid.h>               // for uid_dump, uid_unregister, uid_alloc
 #include <tst_info.h>          // for tst_error, tst_end, tst_start, TST_FAILED
 #include <cne_common.h>        // for cne_countof, CNE_SET_USED
 #include <idlemgr.h>
+#include <cne_cycles.h>          // for cne_rdtsc
+#include <cne_cpuflags.h>        // for cne_cpu_waitpkg_is_supported
 
 #include "idlemgr_test.h"
 #include "cne_log.h"        // for CNE_ERR, CNE_LOG_ERR
@@ -208,6 +213,111 @@ leave:
     return TST_FAILED;
 }
 
+#define WAKE_COUNT    64   /**< Number of wake-ups to measure */
+#define WAKE_DELAY_US 3000 /**< Delay between wake-ups, longer than the idle timeout */
+
+static volatile uint64_t wake_stamp; /**< TSC of the last wake-up, monitored by UMWAIT */
+static int wake_efd = -1;
+
+/* write the TSC to the monitored address and kick the eventfd for epoll_wait() */
+static void *
+waker(void *arg __cne_unused)
+{
+    for (int i = 0; i < WAKE_COUNT; i++) {
+        usleep(WAKE_DELAY_US);
+        wake_stamp = cne_rdtsc();
+        if (eventfd_write(wake_efd, 1) < 0)
+            break;
+    }
+    return NULL;
+}
+
+/* measure the wake-up latency of an idle thread with or without the UMWAIT state */
+static int
+wake_latency(int umwait, uint64_t *avg_ns)
+{
+    idlemgr_t *imgr = NULL;
+    idlemgr_stats_t stats;
+    pthread_t tid;
+    uint64_t seen, total = 0, cnt = 0, limit, val;
+
+    imgr = idlemgr_create(umwait ? "umwait" : "epoll", 1, 1, 100);
+    if (imgr == NULL)
+        CNE_ERR_GOTO(leave, "idlemgr_create() failed\n");
+
+    wake_efd = eventfd(0, EFD_NONBLOCK);
+    if (wake_efd < 0 || idlemgr_add(imgr, wake_efd, 0) < 0)
+        CNE_ERR_GOTO(leave, "failed to add eventfd\n");
+
+    if (umwait && idlemgr_set_umwait(imgr, &wake_stamp, 10 * 1000) < 0)
+        CNE_ERR_GOTO(leave, "idlemgr_set_umwait() failed\n");
+
+    seen = wake_stamp;
+    if (pthread_create(&tid, NULL, waker, NULL))
+        CNE_ERR_GOTO(leave, "failed to create waker thread\n");
+
+    limit = cne_rdtsc() + (cne_get_timer_hz() * 2 * WAKE_COUNT * WAKE_DELAY_US) / US_PER_S;
+    while (cnt < WAKE_COUNT && cne_rdtsc() < limit) {
+        uint64_t stamp = wake_stamp;
+
+        if (stamp != seen) {
+            total += cne_rdtsc() - stamp;
+            seen = stamp;
+            cnt++;
+            if (read(wake_efd, &val, sizeof(val)) < 0)
+                val = 0;
+            idlemgr_process(imgr, 1);
+            continue;
+        }
+        if (idlemgr_process(imgr, 0) < 0)
+            break;
+    }
+    pthread_join(tid, NULL);
+
+    if (cnt != WAKE_COUNT)
+        CNE_ERR_GOTO(leave, "only saw %" PRIu64 " of %d wake-ups\n", cnt, WAKE_COUNT);
+
+    idlemgr_dump(imgr);
+    if (idlemgr_stats(imgr, &stats) < 0)
+        CNE_ERR_GOTO(leave, "idlemgr_stats failed\n");
+    if (umwait && stats.called_umwait == 0)
+        CNE_ERR_GOTO(leave, "idlemgr never entered the UMWAIT state\n");
+
+    *avg_ns = ((total / cnt) * NS_PER_S) / cne_get_timer_hz();
+
+    idlemgr_destroy(imgr);
+    close(wake_efd);
+    wake_efd = -1;
+    return 0;
+leave:
+    idlemgr_destroy(imgr);
+    if (wake_efd >= 0)
+        close(wake_efd);
+    wake_efd = -1;
+    return -1;
+}
+
+static int
+test4(void)
+{
+    uint64_t epoll_ns = 0, umwait_ns = 0;
+
+    if (wake_latency(0, &epoll_ns) < 0)
+        return TST_FAILED;
+    cne_printf("  [magenta]epoll_wait wake-up latency[]: [cyan]%" PRIu64 "[] ns\n", epoll_ns);
+
+    if (!cne_cpu_waitpkg_is_supported()) {
+        cne_printf("  [yellow]WAITPKG not supported, skipping UMWAIT latency[]\n");
+        return TST_PASSED;
+    }
+
+    if (wake_latency(1, &umwait_ns) < 0)
+        return TST_FAILED;
+    cne_printf("  [magenta]UMWAIT wake-up latency    []: [cyan]%" PRIu64 "[] ns\n", umwait_ns);
+
+    return TST_PASSED;
+}
+
 int
 idlemgr_main(int argc, char **argv)
 {
@@ -233,6 +343,7 @@ idlemgr_main(int argc, char **argv)
     TST_FUNC(err, "1 - Idle Manager Create/Destroy", test1());
     TST_FUNC(err, "2 - Idle Manager misc APIs", test2());
     TST_FUNC(err, "3 - Idle Manager multiple instances", test3());
+    TST_FUNC(err, "4 - Idle Manager wake-up latency", test4());
 
     return 0;
 err:
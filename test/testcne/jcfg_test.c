@@ -18,6 +18,8 @@
 #include <json-c/json_visit.h>         // for JSON_C_VISIT_RETURN_ERROR, json_c_visit
 #include <stdlib.h>                    // for calloc, free
 #include <sys/queue.h>                 // for STAILQ_INSERT_TAIL
+#include <stdatomic.h>                 // for atomic_int, atomic_fetch_add, atomic_load
+#include <sched.h>                     // for CPU_ISSET
 
 #include "jcfg_test.h"
 #include "cne_common.h"        // for __cne_unused, CNE_SET_USED
@@ -30,6 +32,7 @@ struct json_object;
 #endif
 
 #define USER1_DATA_TAG "user1-data"
+#define PLACEMENT_TEST_FILE "placement.jsonc"
 
 static int
 _user_print(jcfg_info_t *j __cne_unused, void *obj, void *arg __cne_unused, int idx __cne_unused)
@@ -109,13 +112,49 @@ _user1_decode(struct json_object *obj, int flags, struct json_object *parent __c
     return ret ? ret : JSON_C_VISIT_RETURN_SKIP;
 }
 
+/* Called from the bring-up workers with JCFG_PARALLEL_FLAG, so the counters are atomic */
+struct process_counts {
+    atomic_int objs[JCFG_MAX_TYPES]; /**< Number of callbacks for each object type */
+    atomic_int early_lports;         /**< lports processed before their UMEM */
+};
+
 static int
 process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
 {
-    CNE_SET_USED(_obj);
-    CNE_SET_USED(arg);
+    struct process_counts *cnts = arg;
+    jcfg_hdr_t *hdr             = _obj;
+
     CNE_SET_USED(idx);
 
+    if (hdr->cbtype == JCFG_UMEM_TYPE)
+        hdr->priv_ = cnts;
+    else if (hdr->cbtype == JCFG_LPORT_TYPE) {
+        jcfg_lport_t *lport = _obj;
+
+        if (!lport->umem || lport->umem->priv_ != cnts)
+            atomic_fetch_add(&cnts->early_lports, 1);
+    }
+    atomic_fetch_add(&cnts->objs[hdr->cbtype], 1);
+
+    return 0;
+}
+
+static int
+check_process_counts(jcfg_info_t *jinfo, struct process_counts *cnts)
+{
+    jcfg_cb_type_t types[] = {JCFG_UMEM_TYPE, JCFG_LPORT_TYPE};
+
+    for (int i = 0; i < cne_countof(types); i++) {
+        int cnt = atomic_load(&cnts->objs[types[i]]);
+
+        if (cnt != jcfg_num_objects(jinfo, types[i]))
+            CNE_ERR_RET("Object type %d processed %d times, expected %d\n", types[i], cnt,
+                        jcfg_num_objects(jinfo, types[i]));
+    }
+    if (atomic_load(&cnts->early_lports))
+        CNE_ERR_RET("%d lport(s) processed before their UMEM\n",
+                    atomic_load(&cnts->early_lports));
+
     return 0;
 }
 
@@ -132,6 +171,8 @@ test_json_files(const char *path, int flags)
         return -1;
 
     while ((pent = readdir(pdir))) {
+        struct process_counts cnts = {0};
+
         if (pent->d_type == DT_DIR)
             continue;
 
@@ -146,11 +187,14 @@ test_json_files(const char *path, int flags)
         if (!jinfo)
             continue;
 
-        if (jcfg_process(jinfo, flags, process_callback, NULL)) {
+        if (jcfg_process(jinfo, flags, process_callback, &cnts)) {
             closedir(pdir);
             CNE_ERR_RET("*** Invalid configuration ***\n");
         }
 
+        TST_ASSERT_GOTO(check_process_counts(jinfo, &cnts) == 0,
+                        "Processing %s did not visit every object in order\n", err, pent->d_name);
+
         if (!strcmp(pent->d_name, "test-strings.jsonc"))
             TST_ASSERT_GOTO(jcfg_del_decoder(USER1_DATA_TAG) == 0, "jcfg_del_decoder(%s) failed\n",
                             err, USER1_DATA_TAG);
@@ -173,6 +217,154 @@ err:
     return -1;
 }
 
+/* lcores, physical cores and NUMA nodes the auto placement must pick for placement.jsonc */
+static int
+check_placement_lcores(struct jcfg_placement *pl)
+{
+    const struct {
+        const char *name;
+        int nic_node;
+    } expect[] = {{"main", -1}, {"fwd:0", 0}, {"fwd:1", 1}, {"fwd:2", 0}};
+    int lcores = 0, cores = 0, hot = 0;
+
+    TST_ASSERT(pl->place_cnt == cne_countof(expect), "Placed %d threads, expected %d",
+               pl->place_cnt, (int)cne_countof(expect));
+
+    /* the pool is the process affinity, count its lcores and physical cores */
+    for (int i = 0; i < pl->cpu_cnt; i++) {
+        int first = 1;
+
+        if (!pl->cpus[i].in_pool)
+            continue;
+        lcores++;
+        for (int j = 0; j < i; j++)
+            if (pl->cpus[j].in_pool && pl->cpus[j].core == pl->cpus[i].core)
+                first = 0;
+        cores += first;
+    }
+
+    for (int i = 0; i < pl->place_cnt; i++) {
+        struct jcfg_place *p = &pl->places[i];
+        jcfg_thd_t *thd      = p->thd;
+        struct jcfg_cpu *c   = NULL;
+        char name[JCFG_MAX_STRING_SIZE];
+
+        TST_ASSERT(!strcmp(thd->name, expect[i].name), "Thread %d is %s, expected %s", i,
+                   thd->name, expect[i].name);
+        TST_ASSERT(p->nic_node == expect[i].nic_node, "Thread %s NIC node %d, expected %d",
+                   thd->name, p->nic_node, expect[i].nic_node);
+        TST_ASSERT(p->flags & JCFG_PLACE_AUTO, "Thread %s was not placed", thd->name);
+
+        /* each thread gets an lcore group of its own holding the picked lcore */
+        snprintf(name, sizeof(name), "%s:%s", JCFG_AUTO_GROUP_NAME, thd->name);
+        TST_ASSERT(thd->group && !strcmp(thd->group_name, name) && thd->group->lcore_cnt == 1 &&
+                       CPU_ISSET(p->cpu, &thd->group->lcore_bitmap),
+                   "Thread %s group %s does not hold only lcore %d", thd->name, thd->group_name,
+                   p->cpu);
+
+        for (int j = 0; j < pl->cpu_cnt; j++)
+            if (pl->cpus[j].cpu == p->cpu)
+                c = &pl->cpus[j];
+        TST_ASSERT(c && c->in_pool && p->node == c->node,
+                   "Thread %s lcore %d is not in the lcore pool", thd->name, p->cpu);
+        if (thd->lport_cnt)
+            hot++;
+    }
+
+    /* sharing is only allowed when the pool is too small */
+    for (int i = 0; i < pl->place_cnt; i++) {
+        struct jcfg_place *p = &pl->places[i];
+
+        TST_ASSERT(lcores < pl->place_cnt || !(p->flags & JCFG_PLACE_CPU_SHARED),
+                   "Thread %s shares lcore %d, the pool has %d lcores", p->thd->name, p->cpu,
+                   lcores);
+        TST_ASSERT(cores < hot || !(p->flags & JCFG_PLACE_SMT_SHARED),
+                   "Thread %s shares a physical core, the pool has %d cores", p->thd->name, cores);
+        TST_ASSERT(!(p->flags & JCFG_PLACE_MIXED_NODES), "Thread %s has lports on mixed nodes",
+                   p->thd->name);
+    }
+
+    return 0;
+}
+
+/* The common UMEM of placement.jsonc is split by the NUMA node of its lports, umem1 is not */
+static int
+check_placement_umems(jcfg_info_t *jinfo)
+{
+    const struct {
+        const char *lport;
+        const char *umem;
+        uint16_t region;
+        uint32_t bufcnt;
+    } expect[] = {
+        {"eth0:0", LPORT_GROUP_UMEM_NAME ":0", 0, 16 * 1024},
+        {"eth1:0", LPORT_GROUP_UMEM_NAME, 0, 32 * 1024},
+        {"eth1:1", LPORT_GROUP_UMEM_NAME, 0, 32 * 1024},
+        {"eth2:0", "umem1", 0, 16 * 1024},
+        {"eth2:1", "umem1", 1, 16 * 1024},
+    };
+    jcfg_umem_t *umem;
+
+    /* node 1 has two of the three lports on the common UMEM and keeps it */
+    TST_ASSERT(jcfg_num_objects(jinfo, JCFG_UMEM_TYPE) == 3, "Found %d UMEMs, expected 3",
+               jcfg_num_objects(jinfo, JCFG_UMEM_TYPE));
+
+    umem = jcfg_lookup_umem(jinfo, LPORT_GROUP_UMEM_NAME);
+    TST_ASSERT(umem && umem->bufcnt == 32 * 1024 && umem->region_cnt == 1,
+               "UMEM %s was not split", LPORT_GROUP_UMEM_NAME);
+    umem = jcfg_lookup_umem(jinfo, LPORT_GROUP_UMEM_NAME ":0");
+    TST_ASSERT(umem && umem->bufcnt == 16 * 1024 && umem->region_cnt == 1,
+               "UMEM %s:0 missing or wrong size", LPORT_GROUP_UMEM_NAME);
+    umem = jcfg_lookup_umem(jinfo, "umem1");
+    TST_ASSERT(umem && umem->bufcnt == 32 * 1024 && umem->region_cnt == 2, "UMEM umem1 changed");
+
+    for (int i = 0; i < cne_countof(expect); i++) {
+        jcfg_lport_t *lport = jcfg_lookup_lport(jinfo, expect[i].lport);
+
+        TST_ASSERT(lport && lport->umem && !strcmp(lport->umem->name, expect[i].umem),
+                   "lport %s is not on UMEM %s", expect[i].lport, expect[i].umem);
+        TST_ASSERT(lport->region_idx == expect[i].region &&
+                       lport->umem->rinfo[lport->region_idx].bufcnt == expect[i].bufcnt,
+                   "lport %s region %u has %u buffers, expected region %u with %u",
+                   expect[i].lport, lport->region_idx,
+                   lport->umem->rinfo[lport->region_idx].bufcnt, expect[i].region,
+                   expect[i].bufcnt);
+    }
+
+    return 0;
+}
+
+/* Process placement.jsonc and check the plan, the netdev nodes are given in the file */
+static int
+test_placement(int flags)
+{
+    struct process_counts cnts = {0};
+    jcfg_info_t *jinfo;
+    struct jcfg_placement *pl;
+    int ret = -1;
+
+    cne_printf("\n** Check placement of %s\n\n", PLACEMENT_TEST_FILE);
+
+    jinfo = jcfg_parser(flags, JSON_TEST_DIR "/" PLACEMENT_TEST_FILE);
+    if (!jinfo)
+        CNE_ERR_RET("Unable to parse %s\n", PLACEMENT_TEST_FILE);
+
+    TST_ASSERT_GOTO(jcfg_process(jinfo, flags, process_callback, &cnts) == 0,
+                    "Processing %s failed", err, PLACEMENT_TEST_FILE);
+
+    pl = ((struct jcfg *)jinfo->cfg)->placement;
+    TST_ASSERT_GOTO(pl && pl->places, "No placement plan for %s", err, PLACEMENT_TEST_FILE);
+
+    if (check_placement_lcores(pl) < 0 || check_placement_umems(jinfo) < 0)
+        goto err;
+
+    cne_printf("** Done\n");
+    ret = 0;
+err:
+    jcfg_destroy(jinfo);
+    return ret;
+}
+
 int
 jcfg_main(int argc, char **argv)
 {
@@ -208,6 +400,13 @@ jcfg_main(int argc, char **argv)
     if (test_json_files(JSON_TEST_DIR, flags))
         goto leave;
 
+    cne_printf("\n** Process files again with parallel bring-up\n");
+    if (test_json_files(JSON_TEST_DIR, flags | JCFG_PARALLEL_FLAG))
+        goto leave;
+
+    if (test_placement(flags))
+        goto leave;
+
     tst_end(tst, TST_PASSED);
 
     return 0;
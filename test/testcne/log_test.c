@@ -1,17 +1,26 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2019-2023 Intel Corp, Inc.
  */
-#include <stdio.h>             // for EOF, NULL
-#include <stdint.h>            // for uint32_t
+#include <stdio.h>             // for EOF, NULL, tmpfile, fopen
+#include <stdint.h>            // for uint32_t, uint64_t
+#include <string.h>            // for strstr
+#include <inttypes.h>          // for PRIu64
+#include <pthread.h>           // for pthread_create, pthread_join
 #include <tst_info.h>          // for tst_error, tst_ok, tst_end, tst_start, TST_F...
 #include <cne_common.h>        // for CNE_SET_USED
 #include <getopt.h>            // for getopt_long, option
 #include <cne_log.h>           // for cne_log, cne_log_set_level, CNE_LOG_INFO
+#include <cne_flog.h>          // for CNE_FLOG, cne_flog_flush, cne_flog_stats_get
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_system.h>        // for cne_get_timer_hz
 
 #include "log_test.h"
 #include "cne_stdio.h"        // for cne_printf
 
-#define LEV_NUM 8
+#define LEV_NUM     8
+#define BENCH_BURST 512 /* Less than CNE_FLOG_RING_SIZE so no record is dropped */
+#define BENCH_LOOPS 200
+#define RING_THREADS (CNE_FLOG_MAX_RINGS + 16) /* More threads than rings, run one at a time */
 
 static int
 log_test(void)
@@ -62,6 +71,159 @@ leave:
     return -1;
 }
 
+static int
+flog_test(void)
+{
+    cne_flog_stats_t before, after;
+    char buf[1024] = {0};
+    FILE *f;
+    size_t n;
+
+    cne_printf("\n[blue]>>>[white]TEST: CNE_FLOG test started \n");
+
+    f = tmpfile();
+    if (!f) {
+        tst_error("Fail --- TEST: tmpfile() failed\n");
+        return -1;
+    }
+    cne_log_set_file(f);
+    cne_log_set_level(CNE_LOG_INFO);
+    cne_flog_stats_get(&before);
+
+    CNE_FLOG(INFO, "int %d uint %u hex %#06x str %s dbl %.2f short %hd\n", -5, 7u, 255,
+             "abc", 1.5, 65537);
+    CNE_FLOG(INFO, "width [%*d] [%-5s]\n", 4, 42, "ab");
+    CNE_FLOG(DEBUG, "not logged at level INFO\n");
+    for (int i = 0; i < 1000; i++)
+        CNE_FLOG_RL(INFO, 1000, "rate limited %d\n", i);
+
+    if (cne_flog_flush() != 3) {
+        tst_error("Fail --- TEST: CNE_FLOG flush count\n");
+        goto leave;
+    }
+    cne_flog_stats_get(&after);
+    if (after.records - before.records != 3 || after.dropped != before.dropped) {
+        tst_error("Fail --- TEST: CNE_FLOG stats records %" PRIu64 " dropped %" PRIu64 "\n",
+                  after.records - before.records, after.dropped - before.dropped);
+        goto leave;
+    }
+
+    rewind(f);
+    n      = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[n] = '\0';
+    if (!strstr(buf, "INFO: int -5 uint 7 hex 0x00ff str abc dbl 1.50 short 1\n") ||
+        !strstr(buf, "INFO: width [  42] [ab   ]\n") || !strstr(buf, "rate limited 0\n") ||
+        strstr(buf, "not logged") || strstr(buf, "rate limited 1\n")) {
+        tst_error("Fail --- TEST: CNE_FLOG output\n%s", buf);
+        goto leave;
+    }
+
+    cne_log_set_file(NULL);
+    fclose(f);
+    tst_ok("PASS --- TEST: CNE_FLOG output Pass\n");
+    return 0;
+leave:
+    cne_log_set_file(NULL);
+    fclose(f);
+    return -1;
+}
+
+static void *
+flog_ring_thread(void *arg)
+{
+    CNE_FLOG(INFO, "ring thread %d\n", (int)(uintptr_t)arg);
+
+    return NULL;
+}
+
+/* Threads logging one after the other must reuse the rings of the threads which exited */
+static int
+flog_ring_test(void)
+{
+    cne_flog_stats_t before, after;
+    FILE *f;
+
+    cne_printf("\n[blue]>>>[white]TEST: CNE_FLOG ring reuse test started \n");
+
+    f = fopen("/dev/null", "w");
+    if (!f) {
+        tst_error("Fail --- TEST: fopen(/dev/null) failed\n");
+        return -1;
+    }
+    cne_log_set_file(f);
+    cne_log_set_level(CNE_LOG_INFO);
+    cne_flog_stats_get(&before);
+
+    for (int i = 0; i < RING_THREADS; i++) {
+        pthread_t tid;
+
+        if (pthread_create(&tid, NULL, flog_ring_thread, (void *)(uintptr_t)i)) {
+            tst_error("Fail --- TEST: pthread_create() failed\n");
+            goto leave;
+        }
+        pthread_join(tid, NULL);
+    }
+    cne_flog_flush();
+    cne_flog_stats_get(&after);
+
+    if (after.records - before.records != RING_THREADS || after.dropped != before.dropped ||
+        after.rings > before.rings + 1) {
+        tst_error("Fail --- TEST: CNE_FLOG records %" PRIu64 " dropped %" PRIu64
+                  " rings %u -> %u\n",
+                  after.records - before.records, after.dropped - before.dropped, before.rings,
+                  after.rings);
+        goto leave;
+    }
+
+    cne_log_set_file(NULL);
+    fclose(f);
+    tst_ok("PASS --- TEST: CNE_FLOG ring reuse Pass\n");
+    return 0;
+leave:
+    cne_log_set_file(NULL);
+    fclose(f);
+    return -1;
+}
+
+/* Compare the cost of a call on the logging thread, formatting is done outside the timing */
+static int
+flog_bench(void)
+{
+    uint64_t flog_cycles = 0, log_cycles = 0, start, hz = cne_get_timer_hz();
+    uint64_t calls = (uint64_t)BENCH_BURST * BENCH_LOOPS;
+    FILE *f;
+
+    f = fopen("/dev/null", "w");
+    if (!f) {
+        tst_error("Fail --- TEST: fopen(/dev/null) failed\n");
+        return -1;
+    }
+    cne_log_set_file(f);
+    cne_log_set_level(CNE_LOG_INFO);
+
+    for (int i = 0; i < BENCH_LOOPS; i++) {
+        start = cne_rdtsc();
+        for (int j = 0; j < BENCH_BURST; j++)
+            CNE_FLOG(INFO, "lport %d rx %lu bytes %lu\n", j, calls, calls * 64);
+        flog_cycles += cne_rdtsc() - start;
+        cne_flog_flush();
+
+        start = cne_rdtsc();
+        for (int j = 0; j < BENCH_BURST; j++)
+            CNE_INFO("lport %d rx %lu bytes %lu\n", j, calls, calls * 64);
+        log_cycles += cne_rdtsc() - start;
+    }
+
+    cne_log_set_file(NULL);
+    fclose(f);
+
+    tst_info("CNE_FLOG %.1f ns/call, CNE_LOG %.1f ns/call\n",
+             (double)flog_cycles * NS_PER_S / hz / calls,
+             (double)log_cycles * NS_PER_S / hz / calls);
+
+    return 0;
+}
+
 int
 log_main(int argc, char **argv)
 {
@@ -85,7 +247,7 @@ log_main(int argc, char **argv)
 
     tst = tst_start("LOG");
 
-    if (log_test() < 0)
+    if (log_test() < 0 || flog_test() < 0 || flog_ring_test() < 0 || flog_bench() < 0)
         goto err;
 
     tst_end(tst, TST_PASSED);
@@ -4,16 +4,22 @@
 
 // IWYU pragma: no_include <bits/getopt_core.h>
 
-#include <stdio.h>             // for EOF, NULL, size_t
-#include <stdint.h>            // for uint64_t
-#include <getopt.h>            // for getopt_long, option
-#include <tst_info.h>          // for tst_ok, tst_end, tst_start, tst_info_t
-#include <cne_common.h>        // for CNE_SET_USED
-#include <cne_pktcpy.h>        // for cne_pktcpy
-#include <cne_mmap.h>          // for mmap_addr, mmap_alloc, mmap_free, MMAP...
-#include <cne_cycles.h>        // for cne_rdtsc_precise
-#include <cne_system.h>        // for cne_get_timer_hz
-#include <string.h>            // for memcpy
+#include <stdio.h>                   // for EOF, NULL, size_t
+#include <stdint.h>                  // for uint64_t
+#include <inttypes.h>                // for PRIu64
+#include <stdlib.h>                  // for rand
+#include <getopt.h>                  // for getopt_long, option
+#include <unistd.h>                  // for syscall, read, close
+#include <sys/syscall.h>             // for __NR_perf_event_open
+#include <sys/ioctl.h>               // for ioctl
+#include <linux/perf_event.h>        // for perf_event_attr, PERF_COUNT_HW_CACHE_MISSES
+#include <tst_info.h>                // for tst_ok, tst_end, tst_start, tst_info_t
+#include <cne_common.h>              // for CNE_SET_USED
+#include <cne_pktcpy.h>              // for cne_pktcpy
+#include <cne_mmap.h>                // for mmap_addr, mmap_alloc, mmap_free, MMAP...
+#include <cne_cycles.h>              // for cne_rdtsc_precise
+#include <cne_system.h>              // for cne_get_timer_hz
+#include <string.h>                  // for memcpy
 
 #include "pktcpy_test.h"
 
@@ -66,6 +72,160 @@ runcpy(struct pktcpy_tests *tst, void *(*fn)(void *d, const void *s, size_t len)
     return cycles;
 }
 
+#define BW_MS 100 /* Time spent on each bandwidth measurement */
+
+typedef void *(*copy_fn_t)(void *d, const void *s, size_t len);
+
+/* Compare the copy routines with memcpy() for unaligned buffers and odd sizes */
+static int
+check_copies(void)
+{
+    const size_t sizes[] = {1, 63, 256, 257, 1000, 4095, 16 * _1K + 3, 100 * _1K + 17, 5 * _1M + 9};
+    const copy_fn_t fns[] = {cne_pktcpy, cne_pktcpy_nt, cne_pktcpy_large};
+    size_t len = 6 * _1M;
+    mmap_t *mm;
+    char *s, *d;
+    int ret = -1;
+
+    mm = mmap_alloc(3, len, MMAP_HUGEPAGE_2MB);
+    if (!mm)
+        return -1;
+    s = mmap_addr(mm);
+    d = s + len;
+
+    for (size_t i = 0; i < len; i++)
+        s[i] = rand();
+
+    for (size_t i = 0; i < cne_countof(sizes); i++) {
+        for (size_t f = 0; f < cne_countof(fns); f++) {
+            for (int off = 0; off < 3; off++) {
+                memset(d, 0, sizes[i] + 2 * off + 1);
+                fns[f](d + 2 * off, s + off, sizes[i]);
+                if (memcmp(d + 2 * off, s + off, sizes[i]) || d[2 * off + sizes[i]] != 0) {
+                    tst_error("Copy routine %zu failed for %zu bytes at offset %d\n", f,
+                              sizes[i], off);
+                    goto leave;
+                }
+            }
+        }
+    }
+    ret = 0;
+leave:
+    mmap_free(mm);
+    return ret;
+}
+
+static int
+perf_open(void)
+{
+    struct perf_event_attr attr = {0};
+
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*
+ * Measure the bandwidth of a copy routine, the LLC misses per KB copied and the
+ * cycles to read back a working set of 1/4 of the LLC after the copies, which
+ * grows when the copies evicted it.
+ */
+static void
+bwcpy(char *d, char *s, size_t len, char *ws, size_t ws_len, copy_fn_t fn, int fd, double *gbps,
+      uint64_t *misses, uint64_t *reread)
+{
+    uint64_t begin, stop, iter = 0, now;
+    volatile uint64_t sum = 0;
+
+    for (size_t i = 0; i < ws_len; i += 64)
+        sum += ws[i];
+
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    begin = cne_rdtsc_precise();
+    stop  = begin + (cne_get_timer_hz() * BW_MS) / 1000;
+    do {
+        fn(d, s, len);
+        iter++;
+        now = cne_rdtsc_precise();
+    } while (now < stop);
+    *misses = 0;
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, misses, sizeof(*misses)) != sizeof(*misses))
+            *misses = 0;
+        *misses = (*misses * _1K) / (iter * len);
+    }
+    *gbps = ((double)iter * len * cne_get_timer_hz()) / ((double)(now - begin) * 1e9);
+
+    begin = cne_rdtsc_precise();
+    for (size_t i = 0; i < ws_len; i += 64)
+        sum += ws[i];
+    *reread = cne_rdtsc_precise() - begin;
+}
+
+static int
+bandwidth(void)
+{
+    const copy_fn_t fns[]     = {memcpy, cne_pktcpy, cne_pktcpy_large, cne_pktcpy_nt};
+    const char *names[]       = {"memcpy", "pktcpy", "large", "nt"};
+    size_t llc                = cne_pktcpy_llc_size() ? cne_pktcpy_llc_size() : 32 * _1M;
+    size_t max                = 64 * _1M;
+    mmap_t *mm, *wm;
+    int fd;
+
+    mm = mmap_alloc(2, max, MMAP_HUGEPAGE_2MB);
+    wm = mmap_alloc(1, llc / 4, MMAP_HUGEPAGE_2MB);
+    if (!mm || !wm) {
+        mmap_free(mm);
+        mmap_free(wm);
+        return -1;
+    }
+    memset(mmap_addr(mm), 0x5a, 2 * max);
+    memset(mmap_addr(wm), 0xa5, llc / 4);
+
+    fd = perf_open();
+    tst_ok("LLC %zu KB, non-temporal threshold %zu KB, cache misses %s\n", llc / _1K,
+           cne_pktcpy_nt_threshold() / _1K, (fd < 0) ? "not available" : "per KB copied");
+    tst_ok("%10s|%-27s|%-27s|%-27s|%-27s|\n", " ", names[0], names[1], names[2], names[3]);
+    tst_ok("%10s|%8s %8s %9s|%8s %8s %9s|%8s %8s %9s|%8s %8s %9s|\n", "bytes", "GB/s", "miss/KB",
+           "ws cycles", "GB/s", "miss/KB", "ws cycles", "GB/s", "miss/KB", "ws cycles", "GB/s",
+           "miss/KB", "ws cycles");
+
+    for (size_t len = 256; len <= max; len *= 4) {
+        char line[256];
+        int n = snprintf(line, sizeof(line), "%10zu|", len);
+
+        for (size_t f = 0; f < cne_countof(fns); f++) {
+            uint64_t misses, reread;
+            double gbps;
+
+            bwcpy((char *)mmap_addr(mm) + max, mmap_addr(mm), len, mmap_addr(wm), llc / 4, fns[f],
+                  fd, &gbps, &misses, &reread);
+            if (fd < 0)
+                n += snprintf(line + n, sizeof(line) - n, "%8.2f %8s %9" PRIu64 "|", gbps, "-",
+                              reread);
+            else
+                n += snprintf(line + n, sizeof(line) - n, "%8.2f %8" PRIu64 " %9" PRIu64 "|", gbps,
+                              misses, reread);
+        }
+        tst_ok("%s\n", line);
+    }
+
+    if (fd >= 0)
+        close(fd);
+    mmap_free(mm);
+    mmap_free(wm);
+    return 0;
+}
+
 int
 pktcpy_main(int argc, char **argv)
 {
@@ -109,5 +269,17 @@ pktcpy_main(int argc, char **argv)
 
     tst_end(tst, TST_PASSED);
 
+    tst = tst_start("pktcpy large and non-temporal copies");
+    if (check_copies() < 0) {
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+    if (bandwidth() < 0) {
+        tst_error("Unable to allocate the bandwidth buffers\n");
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+    tst_end(tst, TST_PASSED);
+
     return 0;
 }
@@ -0,0 +1,225 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+// IWYU pragma: no_include <bits/getopt_core.h>
+
+#include <stdio.h>          // for snprintf, EOF
+#include <stdint.h>         // for uint64_t, uint32_t
+#include <inttypes.h>       // for PRIu64
+#include <string.h>         // for strcmp
+#include <getopt.h>         // for getopt_long, option
+#include <pthread.h>        // for pthread_create, pthread_join
+#include <unistd.h>         // for getpid
+#include <tst_info.h>          // for tst_end, tst_start, TST_FAILED, TST_PASSED
+#include <cne_common.h>        // for cne_countof, CNE_SET_USED
+#include <shmstats.h>
+
+#include "shmstats_test.h"
+#include "cne_log.h"        // for CNE_ERR_GOTO
+
+#define TST_FUNC(lb, name, f)              \
+    do {                                   \
+        tst_info_t *tst = tst_start(name); \
+        int t;                             \
+        if (tst == NULL)                   \
+            return -1;                     \
+        t = f;                             \
+        tst_end(tst, t);                   \
+        if (t == TST_FAILED)               \
+            goto lb;                       \
+    } while ((0))
+
+#define SEQ_READS 100000
+
+static const char *const names[] = {"packets", "bytes", "errors", "drops"};
+
+static char seg_name[SHMSTATS_NAME_LEN];
+static volatile int writer_done;
+
+static int
+test1(void)
+{
+    shmstats_blk_t *blk = NULL, *blk2;
+    shmstats_t *s       = NULL;
+    shmstats_info_t info;
+    uint64_t vals[cne_countof(names)];
+
+    if (shmstats_block_alloc("none", SHMSTATS_TYPE_NONE, names, cne_countof(names)))
+        CNE_ERR_GOTO(leave, "shmstats_block_alloc() succeeded without a segment\n");
+
+    if (shmstats_create(seg_name, 0) < 0)
+        CNE_ERR_GOTO(leave, "shmstats_create(%s) failed\n", seg_name);
+    if (shmstats_create(seg_name, 0) == 0)
+        CNE_ERR_GOTO(leave, "shmstats_create() succeeded a second time\n");
+
+    blk = shmstats_block_alloc("lport0", SHMSTATS_TYPE_LPORT, names, cne_countof(names));
+    if (!blk)
+        CNE_ERR_GOTO(leave, "shmstats_block_alloc() failed\n");
+
+    shmstats_write_begin(blk);
+    for (uint32_t i = 0; i < cne_countof(names); i++)
+        blk->counters[i] = (i + 1) * 100;
+    shmstats_write_end(blk);
+
+    s = shmstats_open(seg_name);
+    if (!s)
+        CNE_ERR_GOTO(leave, "shmstats_open(%s) failed\n", seg_name);
+
+    if (shmstats_block_count(s) != 1 || shmstats_block_info(s, 0, &info) < 0)
+        CNE_ERR_GOTO(leave, "Reader did not find the block\n");
+    if (strcmp(info.name, "lport0") || info.type != SHMSTATS_TYPE_LPORT ||
+        info.nb_counters != cne_countof(names))
+        CNE_ERR_GOTO(leave, "Block info does not match\n");
+    if (strcmp(shmstats_counter_name(s, 0, 1), "bytes"))
+        CNE_ERR_GOTO(leave, "Counter name does not match\n");
+
+    if (shmstats_block_read(s, 0, vals, cne_countof(vals)) != (int)cne_countof(vals))
+        CNE_ERR_GOTO(leave, "shmstats_block_read() failed\n");
+    for (uint32_t i = 0; i < cne_countof(names); i++)
+        if (vals[i] != (i + 1) * 100)
+            CNE_ERR_GOTO(leave, "Counter %u is %" PRIu64 ", expected %u\n", i, vals[i],
+                         (i + 1) * 100);
+
+    /* A freed entry is hidden from readers and reused for a block of the same size */
+    shmstats_block_free(blk);
+    if (shmstats_block_info(s, 0, &info) == 0)
+        CNE_ERR_GOTO(leave, "Freed block is still visible\n");
+
+    blk2 = shmstats_block_alloc("lport1", SHMSTATS_TYPE_LPORT, names, cne_countof(names));
+    if (blk2 != blk || shmstats_block_count(s) != 1)
+        CNE_ERR_GOTO(leave, "Freed block was not reused\n");
+    if (shmstats_block_read(s, 0, vals, cne_countof(vals)) < 0 || vals[0] != 0)
+        CNE_ERR_GOTO(leave, "Reused block was not cleared\n");
+
+    shmstats_dump(NULL, s);
+
+    shmstats_close(s);
+    shmstats_destroy();
+
+    if (shmstats_open(seg_name))
+        CNE_ERR_GOTO(leave, "shmstats_open() succeeded after shmstats_destroy()\n");
+
+    return TST_PASSED;
+leave:
+    shmstats_close(s);
+    shmstats_destroy();
+    return TST_FAILED;
+}
+
+static void *
+writer(void *arg)
+{
+    shmstats_blk_t *blk = arg;
+
+    while (!writer_done) {
+        shmstats_write_begin(blk);
+        blk->counters[0]++;
+        blk->counters[1] = blk->counters[0] * 64;
+        blk->counters[2] = blk->counters[0] + 1;
+        blk->counters[3] = blk->counters[0] + 2;
+        shmstats_write_end(blk);
+    }
+    return NULL;
+}
+
+static int
+test2(void)
+{
+    shmstats_blk_t *blk;
+    shmstats_t *s = NULL;
+    uint64_t vals[cne_countof(names)];
+    uint64_t last = 0, busy = 0;
+    pthread_t tid;
+    int started = 0;
+
+    writer_done = 0;
+
+    if (shmstats_create(seg_name, 0) < 0)
+        CNE_ERR_GOTO(leave, "shmstats_create(%s) failed\n", seg_name);
+
+    blk = shmstats_block_alloc("seqlock", SHMSTATS_TYPE_NONE, names, cne_countof(names));
+    if (!blk)
+        CNE_ERR_GOTO(leave, "shmstats_block_alloc() failed\n");
+
+    s = shmstats_open(seg_name);
+    if (!s)
+        CNE_ERR_GOTO(leave, "shmstats_open(%s) failed\n", seg_name);
+
+    /* Start from a state matching the writer updates */
+    blk->counters[2] = 1;
+    blk->counters[3] = 2;
+
+    if (pthread_create(&tid, NULL, writer, blk))
+        CNE_ERR_GOTO(leave, "pthread_create() failed\n");
+    started = 1;
+
+    /* Every snapshot must be from a single update of the writer */
+    for (int i = 0; i < SEQ_READS; i++) {
+        if (shmstats_block_read(s, 0, vals, cne_countof(vals)) < 0) {
+            busy++;
+            continue;
+        }
+        if (vals[1] != vals[0] * 64 || vals[2] != vals[0] + 1 || vals[3] != vals[0] + 2)
+            CNE_ERR_GOTO(leave,
+                         "Inconsistent snapshot %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 "\n",
+                         vals[0], vals[1], vals[2], vals[3]);
+        if (vals[0] < last)
+            CNE_ERR_GOTO(leave, "Counter went backwards %" PRIu64 " < %" PRIu64 "\n", vals[0],
+                         last);
+        last = vals[0];
+    }
+
+    writer_done = 1;
+    pthread_join(tid, NULL);
+    started = 0;
+
+    if (busy == SEQ_READS)
+        CNE_ERR_GOTO(leave, "No consistent snapshot in %d reads\n", SEQ_READS);
+
+    tst_info("Last update %" PRIu64 ", %" PRIu64 " of %d reads gave up\n", last, busy, SEQ_READS);
+
+    shmstats_close(s);
+    shmstats_destroy();
+    return TST_PASSED;
+leave:
+    if (started) {
+        writer_done = 1;
+        pthread_join(tid, NULL);
+    }
+    shmstats_close(s);
+    shmstats_destroy();
+    return TST_FAILED;
+}
+
+int
+shmstats_main(int argc, char **argv)
+{
+    int verbose = 0, opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argvopt, "V", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'V':
+            verbose = 1;
+            break;
+        default:
+            break;
+        }
+    }
+    CNE_SET_USED(verbose);
+
+    snprintf(seg_name, sizeof(seg_name), "/%s_test.%d", SHMSTATS_PREFIX, getpid());
+
+    TST_FUNC(err, "1 - Shared memory stats create/alloc/read", test1());
+    TST_FUNC(err, "2 - Shared memory stats seqlock snapshots", test2());
+
+    return 0;
+err:
+    return -1;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _SHMSTATS_TEST_H_
+#define _SHMSTATS_TEST_H_
+
+/**
+ * @file
+ * Shared memory statistics segment testing functions
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int shmstats_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SHMSTATS_TEST_H_ */
@@ -361,6 +361,219 @@ cleanup:
         workers_finish();
 }
 
+#define NB_STRESS3_TIMERS 256    /* timers changed by each worker */
+#define NB_STRESS3_LOOPS  200000 /* random resets and stops done by each worker */
+
+static struct cne_timer *stress3_timers;
+static atomic_int *stress3_fired;
+
+/* callback for the random resets of the third stress test */
+static void
+timer_stress3_cb(struct cne_timer *tim __cne_unused, void *arg __cne_unused)
+{
+}
+
+/* callback for the last reset of the third stress test, counts the expiries */
+static void
+timer_stress3_final_cb(struct cne_timer *tim __cne_unused, void *arg)
+{
+    atomic_fetch_add((atomic_int *)arg, 1);
+}
+
+/*
+ * The main thread owns every timer and only applies the requests the workers
+ * queue to it, racing the reset and stop requests against the drain. Each
+ * worker changes its own set of timers, then arms each of them a last time
+ * and every timer must expire exactly once.
+ */
+static void
+timer_stress3_initial_loop(__cne_unused void *arg)
+{
+    uint64_t delay = cne_get_timer_hz() / 100000;
+    unsigned tid   = cne_id();
+    unsigned main  = cne_initial_uid();
+    int total      = num_workers * NB_STRESS3_TIMERS;
+    struct cne_timer *timers;
+    uint64_t end;
+    int w, bad = 0;
+
+    if (tid == main) {
+        test_failed = 0;
+        initial_init_workers();
+        stress3_timers = calloc(total, sizeof(*stress3_timers));
+        stress3_fired  = calloc(total, sizeof(*stress3_fired));
+        if (stress3_timers == NULL || stress3_fired == NULL) {
+            tst_error("Failed to allocate memory for timers\n");
+            test_failed = 1;
+            initial_start_workers();
+            goto cleanup;
+        }
+        for (int i = 0; i < total; i++)
+            cne_timer_init(&stress3_timers[i]);
+        initial_start_workers();
+
+        /* apply the queued requests until all workers are done */
+        foreach_worker(i)
+        {
+            while (atomic_load(&worker_state[i]) != WORKER_FINISHED)
+                cne_timer_manage();
+        }
+
+        end = cne_rdtsc() + (cne_get_timer_hz() / 10);
+        while (cne_rdtsc() < end)
+            cne_timer_manage();
+
+        for (int i = 0; i < total; i++) {
+            if (atomic_load(&stress3_fired[i]) != 1 || cne_timer_pending(&stress3_timers[i]))
+                bad++;
+        }
+        if (bad) {
+            tst_error("- Stress test 3 failed, %d of %d timers did not expire once\n", bad, total);
+            test_failed = 1;
+        } else if (!test_failed)
+            tst_ok("Timer stress test 3 done\n");
+        goto cleanup;
+    }
+
+    workers_wait_to_start();
+    if (test_failed)
+        goto cleanup;
+
+    for (w = 0; w < num_workers && worker_uid[w] != (int)tid; w++)
+        ;
+    timers = &stress3_timers[w * NB_STRESS3_TIMERS];
+
+    for (int i = 0; i < NB_STRESS3_LOOPS; i++) {
+        struct cne_timer *tim = &timers[rand() % NB_STRESS3_TIMERS];
+
+        if (rand() & 1)
+            cne_timer_reset(tim, delay, SINGLE, main, timer_stress3_cb, NULL);
+        else if (cne_timer_stop(tim) == 0 && tim->status.state != CNE_TIMER_STOP) {
+            tst_error("- Stress test 3, stopped timer is in state %d\n", tim->status.state);
+            test_failed = 1;
+        }
+    }
+
+    for (int i = 0; i < NB_STRESS3_TIMERS; i++) {
+        atomic_int *fired = &stress3_fired[(w * NB_STRESS3_TIMERS) + i];
+
+        while (cne_timer_reset(&timers[i], delay, SINGLE, main, timer_stress3_final_cb, fired))
+            cne_pause();
+    }
+
+cleanup:
+    if (tid == main) {
+        initial_wait_for_workers();
+        free(stress3_timers);
+        free(stress3_fired);
+        stress3_timers = NULL;
+        stress3_fired  = NULL;
+    } else
+        workers_finish();
+}
+
+static struct cne_timer wakeup_tim;
+static atomic_int wakeup_cnt;
+
+/* wakeup function of the main thread, called by the thread arming a timer on it */
+static void
+timer_wakeup_cb(void *arg)
+{
+    atomic_fetch_add((atomic_int *)arg, 1);
+}
+
+/* arm a timer on the main thread, which must be woken up for it */
+static void
+timer_wakeup_loop(__cne_unused void *arg)
+{
+    cne_timer_reset(&wakeup_tim, cne_get_timer_hz(), SINGLE, cne_initial_uid(), timer_stress3_cb,
+                    NULL);
+}
+
+/*
+ * A thread sleeping until its next timer must be woken up when another thread
+ * arms an earlier timer on it, and must not sleep while the arm is queued.
+ */
+static int
+timer_wakeup_test(void)
+{
+    int ret = 0;
+
+    cne_timer_init(&wakeup_tim);
+    atomic_store(&wakeup_cnt, 0);
+    if (cne_timer_wakeup_set(timer_wakeup_cb, &wakeup_cnt) < 0) {
+        tst_error("- Wakeup test, failed to set the wakeup function\n");
+        return -1;
+    }
+
+    thread_create("Timer-5", timer_wakeup_loop, NULL);
+    thread_wait_all(0, 100, 1);
+
+    if (atomic_load(&wakeup_cnt) != 1) {
+        tst_error("- Wakeup test, woken up %d times\n", atomic_load(&wakeup_cnt));
+        ret = -1;
+    }
+    if (cne_timer_next_ticks() != 0) {
+        tst_error("- Wakeup test, queued arm does not stop the thread from sleeping\n");
+        ret = -1;
+    }
+
+    cne_timer_manage();
+    if (!cne_timer_pending(&wakeup_tim) || cne_timer_next_ticks() <= 0) {
+        tst_error("- Wakeup test, timer is not pending after the arm was applied\n");
+        ret = -1;
+    }
+
+    cne_timer_stop_sync(&wakeup_tim);
+    cne_timer_wakeup_set(NULL, NULL);
+    if (!ret)
+        tst_ok("Timer wakeup test done\n");
+
+    return ret;
+}
+
+/*
+ * Requests queued to a thread that never calls cne_timer_manage() must not leave
+ * the timer in the CONFIG state, apply them with cne_timer_drain() and the sync calls.
+ */
+static int
+timer_drain_test(void)
+{
+    unsigned idle = cne_max_threads() - 1;
+    struct cne_timer tim;
+    int ret = 0;
+
+    cne_timer_init(&tim);
+
+    /* a stop queued to the idle thread is only done once its queue is drained */
+    cne_timer_reset_sync(&tim, cne_get_timer_hz(), SINGLE, idle, timer_stress3_cb, NULL);
+    if (cne_timer_stop(&tim) == 0 || tim.status.state != CNE_TIMER_CONFIG) {
+        tst_error("- Drain test, stop of a remote timer was not queued\n");
+        ret = -1;
+    }
+    if (cne_timer_drain(idle) < 0 || tim.status.state != CNE_TIMER_STOP) {
+        tst_error("- Drain test, queued stop not applied, state %d\n", tim.status.state);
+        ret = -1;
+    }
+
+    /* a queued arm does not keep cne_timer_stop_sync() waiting */
+    if (cne_timer_reset(&tim, cne_get_timer_hz(), SINGLE, idle, timer_stress3_cb, NULL) < 0 ||
+        tim.status.state != CNE_TIMER_CONFIG) {
+        tst_error("- Drain test, arm of a remote timer was not queued\n");
+        ret = -1;
+    }
+    cne_timer_stop_sync(&tim);
+    if (tim.status.state != CNE_TIMER_STOP) {
+        tst_error("- Drain test, timer not stopped, state %d\n", tim.status.state);
+        ret = -1;
+    }
+
+    if (!ret)
+        tst_ok("Timer drain test done\n");
+
+    return ret;
+}
+
 /* timer callback for basic tests */
 static void
 timer_basic_cb(struct cne_timer *tim, void *arg)
@@ -471,13 +684,14 @@ test_timer(int nb_timers)
     /* run a second, slightly different set of stress tests */
     cne_printf("\nStart timer stress tests 2\n");
     num_workers  = nb_timers;
-    worker_state = calloc(num_workers, sizeof(*worker_state));
+    /* indexed by thread uid, foreach_worker() reads one uid past the last worker */
+    worker_state = calloc(cne_max_threads(), sizeof(*worker_state));
     if (!worker_state) {
         tst_error("Failed to allocate worker state memory\n");
         free(mytiminfo);
         return TEST_FAILED;
     }
-    worker_uid = calloc(num_workers, sizeof(*worker_uid));
+    worker_uid = calloc(num_workers + 1, sizeof(*worker_uid));
     if (!worker_uid) {
         free(mytiminfo);
         free(worker_state);
@@ -503,6 +717,25 @@ test_timer(int nb_timers)
         timer_stress2_initial_loop(NULL);
         thread_wait_all(0, 100, 1);
     }
+
+    /* race cross thread resets and stops against the drain of the owner */
+    if (!test_failed && !status) {
+        cne_printf("\nStart timer stress tests 3\n");
+        for (int i = 0; i < num_workers; i++) {
+            int uid = thread_create("Timer-4", timer_stress3_initial_loop, NULL);
+
+            if (uid < 0) {
+                status      = 1;
+                num_workers = i;
+                break;
+            }
+            worker_uid[i] = uid;
+        }
+        if (num_workers) {
+            timer_stress3_initial_loop(NULL);
+            thread_wait_all(0, 100, 1);
+        }
+    }
     free(worker_state);
     free(worker_uid);
     if (test_failed || status) {
@@ -510,6 +743,12 @@ test_timer(int nb_timers)
         return TEST_FAILED;
     }
 
+    cne_printf("\nStart timer wakeup and drain tests\n");
+    if (timer_wakeup_test() < 0 || timer_drain_test() < 0) {
+        free(mytiminfo);
+        return TEST_FAILED;
+    }
+
     /* start other cores */
     cne_printf("\nStart timer basic tests\n");
     for (int i = 0; i < nb_timers; i++)
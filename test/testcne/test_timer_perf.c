@@ -12,6 +12,8 @@
 #include <cne_system.h>        // for cne_get_timer_hz
 #include <stdint.h>            // for uint64_t
 #include <stdlib.h>            // for calloc, free, rand
+#include <stdatomic.h>         // for atomic_int, atomic_fetch_add, atomic_load
+#include <cne_thread.h>        // for thread_create, thread_wait_all
 
 #include "timer_test.h"        // for test_timer_perf
 #include "cne_stdio.h"         // for cne_printf
@@ -30,6 +32,147 @@ timer_cb(struct cne_timer *t __cne_unused, void *param __cne_unused)
 
 #define do_delay() usleep(10)
 
+#define CONTENTION_WORKERS 3
+#define CONTENTION_TIMERS  1024
+#define CONTENTION_ROUNDS  64
+
+static unsigned contention_target;
+static int contention_sync;
+static atomic_int contention_running;
+static atomic_uint_least64_t contention_arm_tsc;
+static atomic_uint_least64_t contention_arms;
+
+static void
+contention_cb(struct cne_timer *t __cne_unused, void *param __cne_unused)
+{
+}
+
+/* arm timers on the target thread as fast as possible, while it runs cne_timer_manage() */
+static void
+timer_contention_worker(void *arg __cne_unused)
+{
+    struct cne_timer *tms;
+    uint64_t start_tsc, arm_tsc = 0, arms = 0;
+    unsigned i, r;
+
+    tms = calloc(CONTENTION_TIMERS, sizeof(*tms));
+    if (tms) {
+        for (i = 0; i < CONTENTION_TIMERS; i++)
+            cne_timer_init(&tms[i]);
+
+        for (r = 0; r < CONTENTION_ROUNDS; r++) {
+            for (i = 0; i < CONTENTION_TIMERS; i++) {
+                start_tsc = cne_rdtsc();
+                if (contention_sync)
+                    cne_timer_reset_sync(&tms[i], 1, SINGLE, contention_target, contention_cb,
+                                         NULL);
+                else if (cne_timer_reset(&tms[i], 1, SINGLE, contention_target, contention_cb,
+                                         NULL) < 0)
+                    continue; /* callback is running on the target thread */
+                arm_tsc += cne_rdtsc() - start_tsc;
+                arms++;
+            }
+        }
+
+        for (i = 0; i < CONTENTION_TIMERS; i++)
+            cne_timer_stop_sync(&tms[i]);
+        free(tms);
+    }
+
+    atomic_fetch_add(&contention_arm_tsc, arm_tsc);
+    atomic_fetch_add(&contention_arms, arms);
+    atomic_fetch_sub(&contention_running, 1);
+}
+
+/* measure remote timer arming against the target thread's cne_timer_manage() */
+static int
+timer_contention_perf(int sync, const char *name)
+{
+    uint64_t start_tsc, manage_tsc = 0, nb_manage = 0, arms;
+
+    contention_target = cne_id();
+    contention_sync   = sync;
+    atomic_store(&contention_running, CONTENTION_WORKERS);
+    atomic_store(&contention_arm_tsc, 0);
+    atomic_store(&contention_arms, 0);
+
+    for (int i = 0; i < CONTENTION_WORKERS; i++) {
+        if (thread_create("Timer-contention", timer_contention_worker, NULL) < 0) {
+            cne_printf("Error: unable to create contention thread\n");
+            atomic_fetch_sub(&contention_running, CONTENTION_WORKERS - i);
+            break;
+        }
+    }
+
+    while (atomic_load(&contention_running) > 0) {
+        start_tsc = cne_rdtsc();
+        cne_timer_manage();
+        manage_tsc += cne_rdtsc() - start_tsc;
+        nb_manage++;
+    }
+    thread_wait_all(0, 100, 1);
+
+    arms = atomic_load(&contention_arms);
+    if (arms == 0 || nb_manage == 0)
+        return -1;
+
+    cne_printf("%-8s: %d threads arm %" PRIu64 " cycles/timer, manage %" PRIu64
+               " cycles/call (%" PRIu64 " calls)\n",
+               name, CONTENTION_WORKERS, atomic_load(&contention_arm_tsc) / arms,
+               manage_tsc / nb_manage, nb_manage);
+
+    return 0;
+}
+
+/* compare arm, cancel and expiry cost of a timer list backend at MAX_ITERATIONS timers */
+static int
+timer_backend_perf(enum cne_timer_backend backend, const char *name, struct cne_timer *tms)
+{
+    const uint64_t hz = cne_get_timer_hz();
+    uint64_t arm_tsc, stop_tsc, manage_tsc, start_tsc;
+    unsigned lcore_id = cne_id();
+    unsigned i, nb_manage = 0;
+
+    cne_timer_subsystem_fini();
+    if (cne_timer_subsystem_init_backend(backend) < 0) {
+        cne_printf("Error: unable to init %s timer backend\n", name);
+        return -1;
+    }
+
+    for (i = 0; i < MAX_ITERATIONS; i++)
+        cne_timer_init(&tms[i]);
+
+    /* arm all timers to expire at random times, at most DELAY_SECONDS out */
+    start_tsc = cne_rdtsc();
+    for (i = 0; i < MAX_ITERATIONS; i++)
+        cne_timer_reset(&tms[i], (rand() % (hz * DELAY_SECONDS)) + 1, SINGLE, lcore_id, timer_cb,
+                        NULL);
+    arm_tsc = cne_rdtsc() - start_tsc;
+
+    /* cancel every other timer */
+    start_tsc = cne_rdtsc();
+    for (i = 0; i < MAX_ITERATIONS; i += 2)
+        cne_timer_stop(&tms[i]);
+    stop_tsc = cne_rdtsc() - start_tsc;
+
+    /* expire the rest, timing only the calls to cne_timer_manage() */
+    outstanding_count = MAX_ITERATIONS / 2;
+    manage_tsc        = 0;
+    while (outstanding_count > 0) {
+        start_tsc = cne_rdtsc();
+        cne_timer_manage();
+        manage_tsc += cne_rdtsc() - start_tsc;
+        nb_manage++;
+    }
+
+    cne_printf("%-8s: arm %" PRIu64 " cycles/timer, cancel %" PRIu64 " cycles/timer, ", name,
+               arm_tsc / MAX_ITERATIONS, stop_tsc / (MAX_ITERATIONS / 2));
+    cne_printf("expire %" PRIu64 " cycles/timer (%u manage calls)\n",
+               manage_tsc / (MAX_ITERATIONS / 2), nb_manage);
+
+    return 0;
+}
+
 int
 test_timer_perf(void)
 {
@@ -122,6 +265,25 @@ test_timer_perf(void)
     end_tsc = cne_rdtsc();
     cne_printf("Time per cne_timer_manage with zero callbacks: %" PRIu64 " cycles\n",
                (end_tsc - start_tsc + iterations / 2) / iterations);
+    cne_timer_stop(&tms[0]);
+
+    cne_printf("\nComparing timer backends with %u timers\n", MAX_ITERATIONS);
+    if (timer_backend_perf(CNE_TIMER_BACKEND_SKIPLIST, "skiplist", tms) < 0 ||
+        timer_backend_perf(CNE_TIMER_BACKEND_WHEEL, "wheel", tms) < 0) {
+        free(tms);
+        return -1;
+    }
+
+    /* restore the default backend for the tests that follow */
+    cne_timer_subsystem_fini();
+    cne_timer_subsystem_init();
+
+    cne_printf("\nArming timers on this thread from %d other threads\n", CONTENTION_WORKERS);
+    if (timer_contention_perf(1, "locked") < 0 || timer_contention_perf(0, "queued") < 0) {
+        cne_printf("Error: timer contention test failed\n");
+        free(tms);
+        return -1;
+    }
 
     free(tms);
     return 0;
@@ -7,10 +7,14 @@
 #include <stdio.h>             // for NULL, EOF
 #include <getopt.h>            // for getopt_long, option
 #include <cne_thread.h>        // for thread_create, thread_wait
+#include <cne_runloop.h>       // for runloop_create, runloop_task_add, runloop_run_once
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_system.h>        // for cne_get_timer_hz
 #include <tst_info.h>          // for tst_error, tst_end, tst_start, TST_FAILED
 #include <cne_common.h>        // for CNE_USED
 #include <stdatomic.h>         // for atomic_exchange, atomic_int_least32_t
 #include <stdbool.h>           // for bool
+#include <string.h>            // for memset
 
 #include "thread_test.h"
 #include "cne_stdio.h"        // for cne_printf
@@ -29,6 +33,124 @@ Tester(void *arg)
     cne_printf("Tester Finished\n");
 }
 
+#define RUNLOOP_SLICES 20000
+
+struct rl_arg {
+    uint64_t spin;  /**< TSC cycles to spin per call */
+    uint64_t calls; /**< Number of calls */
+    int work;       /**< Value to return */
+};
+
+static int
+rl_spin(void *arg)
+{
+    struct rl_arg *a = arg;
+    uint64_t stop    = cne_rdtsc() + a->spin;
+
+    while (cne_rdtsc() < stop)
+        ;
+    a->calls++;
+
+    return a->work;
+}
+
+static int
+rl_idle(void *arg)
+{
+    struct rl_arg *a = arg;
+
+    a->calls++;
+    return 0;
+}
+
+static int
+runloop_test(int verbose)
+{
+    runloop_t *rl;
+    runloop_stats_t light, heavy, periodic;
+    struct rl_arg a = {0}, b = {0}, p = {0}, idle = {0};
+    runloop_task_cfg_t cfg = {0};
+    uint64_t us = cne_get_timer_hz() / 1000000;
+    int ta, tb, tp, ti;
+    double ratio;
+
+    rl = runloop_create("test");
+    if (!rl)
+        return -1;
+
+    /* Two busy tasks with a 1:3 weight ratio, each call takes about a microsecond */
+    a.spin = b.spin = us;
+    a.work = b.work = 1;
+    cfg.weight      = 8;
+    ta              = runloop_task_add(rl, "light", rl_spin, &a, &cfg);
+    cfg.weight      = 24;
+    tb              = runloop_task_add(rl, "heavy", rl_spin, &b, &cfg);
+
+    /* A periodic task every 500us and an idle task that must never run */
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.period_us = 500;
+    tp            = runloop_task_add(rl, "periodic", rl_idle, &p, &cfg);
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.flags = RUNLOOP_TASK_IDLE;
+    ti        = runloop_task_add(rl, "idle", rl_idle, &idle, &cfg);
+
+    if (ta < 0 || tb < 0 || tp < 0 || ti < 0) {
+        runloop_destroy(rl);
+        return -1;
+    }
+
+    for (int i = 0; i < RUNLOOP_SLICES; i++)
+        runloop_run_once(rl);
+
+    if (verbose)
+        runloop_dump(NULL, rl);
+
+    runloop_stats_get(rl, ta, &light);
+    runloop_stats_get(rl, tb, &heavy);
+    runloop_stats_get(rl, tp, &periodic);
+
+    ratio = (double)heavy.cycles / (double)light.cycles;
+    tst_info("Heavy/light cycles ratio %.2f, periodic calls %lu, idle calls %lu\n", ratio,
+             periodic.calls, idle.calls);
+
+    if (ratio < 2.0 || ratio > 4.0) {
+        tst_error("Weighted tasks ratio %.2f not near 3.0\n", ratio);
+        goto err;
+    }
+    if (periodic.calls == 0) {
+        tst_error("Periodic task did not run\n");
+        goto err;
+    }
+    if (idle.calls) {
+        tst_error("Idle task ran while other tasks had work\n");
+        goto err;
+    }
+
+    /* Once the busy tasks are idle the idle task must run */
+    a.work = b.work = 0;
+    for (int i = 0; i < 10; i++)
+        runloop_run_once(rl);
+    if (idle.calls == 0) {
+        tst_error("Idle task did not run when all tasks were idle\n");
+        goto err;
+    }
+
+    /* A task returning -1 is removed */
+    a.work = -1;
+    for (int i = 0; i < 100 && runloop_stats_get(rl, ta, &light) == 0; i++)
+        runloop_run_once(rl);
+    if (runloop_stats_get(rl, ta, &light) == 0) {
+        tst_error("Task returning -1 was not removed\n");
+        goto err;
+    }
+
+    runloop_destroy(rl);
+    return 0;
+err:
+    runloop_destroy(rl);
+    return -1;
+}
+
 int
 thread_main(int argc, char **argv)
 {
@@ -51,8 +173,6 @@ thread_main(int argc, char **argv)
             break;
         }
     }
-    CNE_SET_USED(verbose);
-
     tst = tst_start("Thread");
 
     atomic_exchange(&tester_running, 1);
@@ -63,6 +183,13 @@ thread_main(int argc, char **argv)
         goto leave;
     }
 
+    if (runloop_test(verbose)) {
+        tst_error("Run-loop test failed\n");
+        result = TST_FAILED;
+        goto leave;
+    }
+    tst_ok("Run-loop test passed\n");
+
 leave:
     atomic_exchange(&tester_running, 0);
     if (tid >= 0) {
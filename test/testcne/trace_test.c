@@ -0,0 +1,207 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+// IWYU pragma: no_include <bits/getopt_core.h>
+
+#include <stdio.h>          // for tmpfile, fread, EOF
+#include <stdint.h>         // for uint64_t, uint32_t
+#include <stdlib.h>         // for malloc, free
+#include <string.h>         // for strstr
+#include <getopt.h>         // for getopt_long, option
+#include <pthread.h>        // for pthread_create, pthread_join
+#include <tst_info.h>          // for tst_end, tst_start, TST_FAILED, TST_PASSED
+#include <cne_common.h>        // for CNE_SET_USED
+#include <cne_trace.h>
+
+#include "trace_test.h"
+#include "cne_log.h"        // for CNE_ERR_GOTO
+
+#define TST_FUNC(lb, name, f)              \
+    do {                                   \
+        tst_info_t *tst = tst_start(name); \
+        int t;                             \
+        if (tst == NULL)                   \
+            return -1;                     \
+        t = f;                             \
+        tst_end(tst, t);                   \
+        if (t == TST_FAILED)               \
+            goto lb;                       \
+    } while ((0))
+
+#define DUMP_SIZE  (4 * 1024 * 1024)
+#define NB_THREADS 2
+
+CNE_TRACE_POINT_DEFINE(tst_trace_a, "tsttrace.a", "x,y");
+CNE_TRACE_POINT_DEFINE(tst_trace_b, "tsttrace.b", "x");
+CNE_TRACE_POINT_DEFINE(tst_trace_c, "tstother.c", "");
+
+/* Write the trace to a temporary file and read it back */
+static char *
+trace_read(int *nb_events)
+{
+    char *buf;
+    size_t n;
+    FILE *f;
+
+    f = tmpfile();
+    if (!f)
+        return NULL;
+
+    buf = malloc(DUMP_SIZE);
+    if (!buf) {
+        fclose(f);
+        return NULL;
+    }
+
+    *nb_events = cne_trace_dump(f);
+    rewind(f);
+    n      = fread(buf, 1, DUMP_SIZE - 1, f);
+    buf[n] = '\0';
+    fclose(f);
+
+    return buf;
+}
+
+static int
+test1(void)
+{
+    char *buf = NULL;
+    int n;
+
+    if (cne_trace_is_enabled("tsttrace.a") != 0 || cne_trace_is_enabled("nothere") != -1)
+        CNE_ERR_GOTO(leave, "Trace point state is wrong\n");
+
+    /* Disabled trace points record nothing */
+    cne_trace_clear();
+    CNE_TRACE(tst_trace_a, 1, 2);
+
+    if (cne_trace_enable("tsttrace.*") != 2)
+        CNE_ERR_GOTO(leave, "Pattern did not match two trace points\n");
+    if (cne_trace_is_enabled("tsttrace.b") != 1 || cne_trace_is_enabled("tstother.c") != 0)
+        CNE_ERR_GOTO(leave, "Trace point state is wrong after enable\n");
+
+    CNE_TRACE(tst_trace_a, 10, 20);
+    CNE_TRACE(tst_trace_b, 30);
+    CNE_TRACE(tst_trace_c, 40);
+
+    buf = trace_read(&n);
+    if (!buf)
+        CNE_ERR_GOTO(leave, "Unable to dump the trace\n");
+    if (n != 2)
+        CNE_ERR_GOTO(leave, "Dumped %d events, expected 2\n%s", n, buf);
+    if (!strstr(buf, "\"traceEvents\"") ||
+        !strstr(buf, "\"name\":\"tsttrace.a\",\"cat\":\"tsttrace\"") ||
+        !strstr(buf, "\"args\":{\"x\":10,\"y\":20}") || !strstr(buf, "\"args\":{\"x\":30}") ||
+        strstr(buf, "tstother.c"))
+        CNE_ERR_GOTO(leave, "Unexpected trace output\n%s", buf);
+    free(buf);
+    buf = NULL;
+
+    cne_trace_clear();
+    if (cne_trace_disable("*") < 3)
+        CNE_ERR_GOTO(leave, "Unable to disable all trace points\n");
+    CNE_TRACE(tst_trace_b, 50);
+
+    buf = trace_read(&n);
+    if (!buf || n != 0)
+        CNE_ERR_GOTO(leave, "Dumped %d events after clear, expected 0\n", n);
+    free(buf);
+
+    return TST_PASSED;
+leave:
+    free(buf);
+    cne_trace_disable("*");
+    return TST_FAILED;
+}
+
+static void *
+writer(void *arg)
+{
+    uint64_t id = (uintptr_t)arg;
+
+    /* Wrap the ring a few times, only the last CNE_TRACE_RING_SIZE records are kept */
+    for (uint64_t i = 0; i < 3 * CNE_TRACE_RING_SIZE + 10; i++)
+        CNE_TRACE(tst_trace_a, id, i);
+
+    return NULL;
+}
+
+static int
+test2(void)
+{
+    pthread_t tid[NB_THREADS];
+    char *buf = NULL;
+    char last[64];
+    int n, started = 0;
+
+    cne_trace_clear();
+    cne_trace_enable("tsttrace.a");
+
+    for (; started < NB_THREADS; started++)
+        if (pthread_create(&tid[started], NULL, writer, (void *)(uintptr_t)(started + 100)))
+            CNE_ERR_GOTO(leave, "pthread_create() failed\n");
+    for (int i = 0; i < NB_THREADS; i++)
+        pthread_join(tid[i], NULL);
+    started = 0;
+
+    buf = trace_read(&n);
+    if (!buf)
+        CNE_ERR_GOTO(leave, "Unable to dump the trace\n");
+    /* The oldest record of a full ring is skipped, the writer could be overwriting it */
+    if (n != NB_THREADS * (CNE_TRACE_RING_SIZE - 1))
+        CNE_ERR_GOTO(leave, "Dumped %d events, expected %d\n", n,
+                     NB_THREADS * (CNE_TRACE_RING_SIZE - 1));
+
+    snprintf(last, sizeof(last), "{\"x\":100,\"y\":%d}", 3 * CNE_TRACE_RING_SIZE + 9);
+    if (!strstr(buf, last))
+        CNE_ERR_GOTO(leave, "Last event of the thread is missing\n");
+    snprintf(last, sizeof(last), "{\"x\":101,\"y\":%d}", 2 * CNE_TRACE_RING_SIZE + 9);
+    if (strstr(buf, last))
+        CNE_ERR_GOTO(leave, "Overwritten event is still present\n");
+
+    free(buf);
+    cne_trace_disable("*");
+    cne_trace_clear();
+
+    return TST_PASSED;
+leave:
+    for (int i = 0; i < started; i++)
+        pthread_join(tid[i], NULL);
+    free(buf);
+    cne_trace_disable("*");
+    return TST_FAILED;
+}
+
+int
+trace_main(int argc, char **argv)
+{
+    int verbose = 0, opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argvopt, "V", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'V':
+            verbose = 1;
+            break;
+        default:
+            break;
+        }
+    }
+    CNE_SET_USED(verbose);
+
+    if (verbose)
+        cne_trace_list(NULL);
+
+    TST_FUNC(err, "1 - Trace point enable/record/dump", test1());
+    TST_FUNC(err, "2 - Trace per-thread rings wrap", test2());
+
+    return 0;
+err:
+    return -1;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _TRACE_TEST_H_
+#define _TRACE_TEST_H_
+
+/**
+ * @file
+ * Trace point testing functions
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int trace_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TRACE_TEST_H_ */
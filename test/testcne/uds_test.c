@@ -0,0 +1,373 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+// IWYU pragma: no_include <bits/getopt_core.h>
+
+#include <stdio.h>             // for EOF, snprintf
+#include <stdint.h>            // for uint64_t, uint32_t
+#include <inttypes.h>          // for PRIu64
+#include <stdlib.h>            // for malloc, free
+#include <string.h>            // for strcmp, memcmp
+#include <unistd.h>            // for close
+#include <time.h>              // for clock_gettime, timespec
+#include <getopt.h>            // for getopt_long, option
+#include <pthread.h>           // for pthread_create, pthread_join
+#include <sys/socket.h>        // for socket, connect, send, recv
+#include <sys/resource.h>      // for getrusage, rusage
+#include <tst_info.h>          // for tst_end, tst_start, TST_FAILED, TST_PASSED
+#include <cne_common.h>        // for CNE_SET_USED
+#include <cne_hist.h>          // for cne_hist_create, cne_hist_record
+#include <uds.h>               // for uds_create, uds_register, uds_append
+
+#include "uds_test.h"
+#include "cne_log.h"        // for CNE_ERR_GOTO
+
+#define TST_FUNC(lb, name, f)              \
+    do {                                   \
+        tst_info_t *tst = tst_start(name); \
+        int t;                             \
+        if (tst == NULL)                   \
+            return -1;                     \
+        t = f;                             \
+        tst_end(tst, t);                   \
+        if (t == TST_FAILED)               \
+            goto lb;                       \
+    } while ((0))
+
+#define UDS_TEST_DIR "/tmp/cndp-uds-test"
+#define NB_PIPELINED 32
+#define NB_CLIENTS   100
+#define NB_REQUESTS  500
+#define BIN_LEN      4096
+#define BIG_BIN_LEN  (64 * 1024) /* Grows the client buffer past the text response cap */
+#define MAX_TEXT_LEN (16 * 1024) /* UDS_MAX_BUF_LEN */
+
+static int verbose;
+
+static int
+echo_cb(uds_client_t *c, const char *cmd, const char *params)
+{
+    CNE_SET_USED(cmd);
+
+    uds_append(c, "\"echo\":\"%s\"", params ? params : "");
+    return 0;
+}
+
+static int
+bin_cb(uds_client_t *c, const char *cmd, const char *params)
+{
+    uint32_t data[BIN_LEN / sizeof(uint32_t)];
+
+    CNE_SET_USED(cmd);
+    CNE_SET_USED(params);
+
+    for (uint32_t i = 0; i < CNE_DIM(data); i++)
+        data[i] = i;
+
+    /* Built in two parts to check the data is appended */
+    if (uds_append_binary(c, data, sizeof(data) / 2) < 0 ||
+        uds_append_binary(c, &data[CNE_DIM(data) / 2], sizeof(data) / 2) < 0)
+        return -1;
+    return 0;
+}
+
+static int
+bigbin_cb(uds_client_t *c, const char *cmd, const char *params)
+{
+    static uint8_t data[BIG_BIN_LEN];
+
+    CNE_SET_USED(cmd);
+    CNE_SET_USED(params);
+
+    return uds_append_binary(c, data, sizeof(data));
+}
+
+/* Append text until the response is full */
+static int
+fill_cb(uds_client_t *c, const char *cmd, const char *params)
+{
+    CNE_SET_USED(cmd);
+    CNE_SET_USED(params);
+
+    for (int i = 0; i < BIG_BIN_LEN; i++)
+        if (uds_append(c, "%s\"key%d\":%d", i ? "," : "", i, i) < 0)
+            break;
+    return 0;
+}
+
+static uint64_t
+now_ns(int clk)
+{
+    struct timespec ts;
+
+    clock_gettime(clk, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int
+client_open(uds_info_t *info)
+{
+    int s = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+
+    if (s < 0)
+        return -1;
+    if (connect(s, (struct sockaddr *)&info->sun, sizeof(info->sun)) < 0) {
+        close(s);
+        return -1;
+    }
+    return s;
+}
+
+static int
+test1(uds_info_t *info)
+{
+    char req[64], rsp[BIN_LEN + 1], expect[64];
+    int s, n;
+
+    s = client_open(info);
+    if (s < 0)
+        CNE_ERR_GOTO(leave, "Unable to connect to %s\n", info->sun.sun_path);
+
+    /* Send all the requests before reading the responses, they come back in order */
+    for (int i = 0; i < NB_PIPELINED; i++) {
+        n = snprintf(req, sizeof(req), "/test/echo,%d", i);
+        if (send(s, req, n, 0) != n)
+            CNE_ERR_GOTO(leave, "send() failed\n");
+    }
+    for (int i = 0; i < NB_PIPELINED; i++) {
+        n = recv(s, rsp, sizeof(rsp) - 1, 0);
+        if (n <= 0)
+            CNE_ERR_GOTO(leave, "recv() failed\n");
+        rsp[n] = '\0';
+        snprintf(expect, sizeof(expect), "{\"echo\":\"%d\"}", i);
+        if (strcmp(rsp, expect))
+            CNE_ERR_GOTO(leave, "Response %s expected %s\n", rsp, expect);
+    }
+
+    /* A binary response is the raw data in one message */
+    if (send(s, "/test/bin", 9, 0) != 9)
+        CNE_ERR_GOTO(leave, "send() failed\n");
+    n = recv(s, rsp, sizeof(rsp), 0);
+    if (n != BIN_LEN)
+        CNE_ERR_GOTO(leave, "Binary response is %d bytes expected %d\n", n, BIN_LEN);
+    for (uint32_t i = 0; i < BIN_LEN / sizeof(uint32_t); i++) {
+        uint32_t v;
+
+        memcpy(&v, &rsp[i * sizeof(uint32_t)], sizeof(v));
+        if (v != i)
+            CNE_ERR_GOTO(leave, "Binary response word %u is %u\n", i, v);
+    }
+
+    /* The next text response is a JSON object again */
+    if (send(s, "/test/echo,text", 15, 0) != 15)
+        CNE_ERR_GOTO(leave, "send() failed\n");
+    n = recv(s, rsp, sizeof(rsp) - 1, 0);
+    if (n <= 0)
+        CNE_ERR_GOTO(leave, "recv() failed\n");
+    rsp[n] = '\0';
+    if (strcmp(rsp, "{\"echo\":\"text\"}"))
+        CNE_ERR_GOTO(leave, "Response %s is not JSON\n", rsp);
+
+    close(s);
+    return TST_PASSED;
+leave:
+    if (s >= 0)
+        close(s);
+    return TST_FAILED;
+}
+
+/* A text response after a large binary response is still capped to the text length */
+static int
+test3(uds_info_t *info)
+{
+    char *rsp = malloc(BIG_BIN_LEN + 1);
+    int s     = -1, n;
+
+    if (!rsp)
+        return TST_FAILED;
+
+    s = client_open(info);
+    if (s < 0)
+        CNE_ERR_GOTO(leave, "Unable to connect to %s\n", info->sun.sun_path);
+
+    if (send(s, "/test/bigbin", 12, 0) != 12)
+        CNE_ERR_GOTO(leave, "send() failed\n");
+    n = recv(s, rsp, BIG_BIN_LEN + 1, 0);
+    if (n != BIG_BIN_LEN)
+        CNE_ERR_GOTO(leave, "Binary response is %d bytes expected %d\n", n, BIG_BIN_LEN);
+
+    if (send(s, "/test/fill", 10, 0) != 10)
+        CNE_ERR_GOTO(leave, "send() failed\n");
+    n = recv(s, rsp, BIG_BIN_LEN + 1, 0);
+    if (n <= 0 || n > MAX_TEXT_LEN)
+        CNE_ERR_GOTO(leave, "Text response is %d bytes, max %d\n", n, MAX_TEXT_LEN);
+
+    close(s);
+    free(rsp);
+    return TST_PASSED;
+leave:
+    if (s >= 0)
+        close(s);
+    free(rsp);
+    return TST_FAILED;
+}
+
+struct client_arg {
+    uds_info_t *info;
+    cne_hist_t *hist;
+    uint64_t cpu_ns; /**< CPU time used by the client thread */
+    int err;
+};
+
+static void *
+client_thread(void *_arg)
+{
+    struct client_arg *arg = _arg;
+    cne_hist_rec_t *r      = cne_hist_recorder(arg->hist);
+    uint64_t start         = now_ns(CLOCK_THREAD_CPUTIME_ID);
+    char rsp[256];
+    int s;
+
+    arg->err = 1;
+    s        = client_open(arg->info);
+    if (s < 0 || !r)
+        goto leave;
+
+    for (int i = 0; i < NB_REQUESTS; i++) {
+        uint64_t t = now_ns(CLOCK_MONOTONIC);
+
+        if (send(s, "/test/echo,x", 12, 0) != 12 || recv(s, rsp, sizeof(rsp), 0) <= 0)
+            goto leave;
+        cne_hist_record(r, now_ns(CLOCK_MONOTONIC) - t);
+    }
+    arg->err = 0;
+
+leave:
+    if (s >= 0)
+        close(s);
+    arg->cpu_ns = now_ns(CLOCK_THREAD_CPUTIME_ID) - start;
+    return NULL;
+}
+
+static uint64_t
+process_cpu_ns(void)
+{
+    struct rusage ru;
+
+    getrusage(RUSAGE_SELF, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000000ULL +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000ULL;
+}
+
+/*
+ * Command latency and server CPU cost with many concurrent clients. The CPU time of the
+ * server is the CPU time of the process less the CPU time of the client threads.
+ */
+static int
+test2(uds_info_t *info)
+{
+    struct client_arg args[NB_CLIENTS] = {0};
+    pthread_t tid[NB_CLIENTS];
+    cne_hist_rec_t *s = NULL;
+    uint64_t cpu, wall, clients_cpu = 0;
+    cne_hist_t *h;
+    int started = 0;
+
+    h = cne_hist_create("uds-latency", 0, 32, NB_CLIENTS);
+    if (!h)
+        return TST_FAILED;
+
+    cpu  = process_cpu_ns();
+    wall = now_ns(CLOCK_MONOTONIC);
+
+    for (; started < NB_CLIENTS; started++) {
+        args[started].info = info;
+        args[started].hist = h;
+        if (pthread_create(&tid[started], NULL, client_thread, &args[started]))
+            CNE_ERR_GOTO(leave, "pthread_create() failed\n");
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(tid[i], NULL);
+        clients_cpu += args[i].cpu_ns;
+        if (args[i].err)
+            tst_error("Client %d failed\n", i);
+    }
+    started = 0;
+
+    wall = now_ns(CLOCK_MONOTONIC) - wall;
+    cpu  = process_cpu_ns() - cpu;
+    cpu  = (cpu > clients_cpu) ? cpu - clients_cpu : 0;
+
+    s = cne_hist_snapshot_alloc(h);
+    if (!s || cne_hist_snapshot(h, s) < 0)
+        CNE_ERR_GOTO(leave, "cne_hist_snapshot() failed\n");
+    if (s->count != (uint64_t)NB_CLIENTS * NB_REQUESTS)
+        CNE_ERR_GOTO(leave, "%" PRIu64 " commands done expected %" PRIu64 "\n", s->count,
+                     (uint64_t)NB_CLIENTS * NB_REQUESTS);
+
+    tst_info("%d clients, %" PRIu64 " commands in %" PRIu64 " ms, %.0f commands/s\n", NB_CLIENTS,
+             s->count, wall / 1000000, (double)s->count * 1e9 / (double)wall);
+    tst_info("Latency us: mean %.1f p50 %.1f p99 %.1f max %.1f\n", cne_hist_mean(s) / 1000.0,
+             cne_hist_percentile(s, 50.0) / 1000.0, cne_hist_percentile(s, 99.0) / 1000.0,
+             s->max / 1000.0);
+    tst_info("Server CPU %" PRIu64 " ms, %.2f us per command\n", cpu / 1000000,
+             (double)cpu / 1000.0 / (double)s->count);
+
+    cne_hist_snapshot_free(s);
+    cne_hist_destroy(h);
+    return TST_PASSED;
+leave:
+    for (int i = 0; i < started; i++)
+        pthread_join(tid[i], NULL);
+    cne_hist_snapshot_free(s);
+    cne_hist_destroy(h);
+    return TST_FAILED;
+}
+
+int
+uds_main(int argc, char **argv)
+{
+    const uds_group_t *grp;
+    const char *err_str = NULL;
+    uds_info_t *info;
+    int opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argvopt, "V", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'V':
+            verbose = 1;
+            break;
+        default:
+            break;
+        }
+    }
+
+    info = uds_create(UDS_TEST_DIR, "uds_test", &err_str, NULL);
+    if (!info) {
+        tst_error("uds_create() failed: %s\n", err_str ? err_str : "unknown");
+        return -1;
+    }
+    grp = uds_create_group(info, "test", NULL);
+    if (!grp || uds_register(grp, "/echo", echo_cb) < 0 || uds_register(grp, "/bin", bin_cb) < 0 ||
+        uds_register(grp, "/bigbin", bigbin_cb) < 0 || uds_register(grp, "/fill", fill_cb) < 0) {
+        tst_error("Unable to register the test commands\n");
+        goto err;
+    }
+
+    TST_FUNC(err, "1 - UDS pipelined and binary responses", test1(info));
+    TST_FUNC(err, "2 - UDS latency with 100 concurrent clients", test2(info));
+    TST_FUNC(err, "3 - UDS text response cap after a binary response", test3(info));
+
+    uds_destroy(info);
+    return 0;
+err:
+    uds_destroy(info);
+    return -1;
+}
@@ -25,6 +25,7 @@
 #include <bsd/string.h>        // for strlcat
 #include <errno.h>             // for errno, EINTR, EPERM
 #include <csock.h>             // for csock_get_fd, csock_write, csock_cfg_t
+#include <shmstats.h>          // for shmstats_open, shmstats_dump, shmstats_close
 
 /**
  * Simple macros to simplify code and return values with messages.
@@ -81,6 +82,7 @@ usage(int err)
     printf("cnectl: connect to CNDP and/or execute commands\n");
     printf("  Options:\n");
     printf("    -s,--socket host  - The local domain path or host:port to use\n");
+    printf("    -m,--stats name   - Dump the shared memory stats segment, e.g. /cndp_stats.1234\n");
     printf("    -h,--help         - This help message\n");
     exit(err);
 }
@@ -91,6 +93,7 @@ main(int argc, char **argv)
     // clang-format off
     struct option lgopts[] = {
         { "socket",     1, NULL, 's' },
+        { "stats",      1, NULL, 'm' },
         { "help",       no_argument, NULL, 'h' },
         { NULL, 0, 0, 0 }
     };
@@ -103,12 +106,21 @@ main(int argc, char **argv)
     csock_cfg_t cfg = {0};
     int efd         = -1;
     csock_t *c      = NULL;
+    shmstats_t *s;
 
-    while ((opt = getopt_long(argc, argv, "hs:", lgopts, &option_index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hm:s:", lgopts, &option_index)) != -1) {
         switch (opt) {
         case 'h':
             usage(EXIT_SUCCESS);
             break;
+        case 'm': /* Dump the stats segment without connecting to the application */
+            s = shmstats_open(optarg);
+            if (!s)
+                exit(EXIT_FAILURE);
+            shmstats_dump(stdout, s);
+            shmstats_close(s);
+            exit(EXIT_SUCCESS);
+            break;
         case 's': /* Setup up UDS or TCP socket to remote host:port */
             if (c) {
                 printf("-s option used more then once!\n");
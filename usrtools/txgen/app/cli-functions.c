@@ -27,6 +27,7 @@
 #include "pktdev_api.h"        // for pktdev_port_count
 #include "port-cfg.h"          // for port_info_t
 #include "portlist.h"          // for portlist_parse, portlist_t
+#include "range.h"             // for range_set_value, range_set_mode, range_set_list
 
 static inline uint16_t
 valid_pkt_size(char *val)
@@ -57,7 +58,7 @@ static const char *title_help[] = {
 static const char *status_help[] = {
     "",
     "       Flags: P-             - Promiscuous mode enabled",
-    "                ------       - Modes Single",
+    "                ------       - Modes Single or Range",
     "Notes: <state>       - Use enable|disable or on|off to set the state.",
     "       <portlist>    - a list of lports (no spaces) as 2,4,6-9,12 or 3-5,8 or 5 or the "
     "word 'all'",
@@ -314,6 +315,84 @@ set_cmd(int argc, char **argv)
     return 0;
 }
 
+// clang-format off
+#define range_fields \
+    "dmac|"         /* 0 */ \
+    "smac|"         /* 1 */ \
+    "dip|"          /* 2 */ \
+    "sip|"          /* 3 */ \
+    "sport|"        /* 4 */ \
+    "dport|"        /* 5 */ \
+    "vlan|"         /* 6 */ \
+    "size"          /* 7 */
+
+static struct cli_map range_map[] = {
+    {10, "range %P %|" range_fields " %|start|min|max|inc %s"},
+    {20, "range %P %|" range_fields " mode %|off|inc|random|list"},
+    {30, "range %P %|" range_fields " list %s"},
+    {40, "range %P show"},
+    {-1, NULL}
+    };
+
+static const char *range_help[] = {
+    "",
+    "range <portlist> <field> start|min|max|inc <value> - Set the range values of a field",
+    "range <portlist> <field> mode <mode> - Set the generator of a field",
+    "                 mode - off        - Use the value of the single packet",
+    "                        inc        - Increment from start by inc, wrap from max to min",
+    "                        random     - Random value between min and max",
+    "                        list       - Sequence of the values of the list",
+    "range <portlist> <field> list <v1,v2,...> - Set the list of at most 16 values",
+    "range <portlist> show              - Show the range fields",
+    "       field - dmac|smac           - MAC address e.g. 00:11:22:33:44:55",
+    "               dip|sip             - IPv4 address e.g. 10.1.2.3, inc e.g. 0.0.0.1",
+    "               sport|dport         - TCP/UDP port number",
+    "               vlan                - VLAN ID, a VLAN tag is added to the packets",
+    "               size                - Packet size including the FCS",
+    "enable|disable <portlist> range    - Send the packets with the range fields",
+    CLI_HELP_PAUSE,
+    NULL};
+// clang-format on
+
+static int
+range_cmd(int argc, char **argv)
+{
+    struct cli_map *m;
+    portlist_t portlist;
+    uint64_t value;
+    int fld;
+
+    m = cli_mapping(range_map, argc, argv);
+    if (!m)
+        return cli_cmd_error("Range command is invalid", "Range", argc, argv);
+
+    portlist_parse(argv[1], &portlist);
+
+    switch (m->index) {
+    case 10:
+        fld = cli_map_list_search(m->fmt, argv[2], 2);
+        if (range_parse_value(fld, argv[4], &value) < 0)
+            return cli_cmd_error("Range value is invalid", "Range", argc, argv);
+        foreach_port(portlist, range_set_value(info, fld, argv[3], value));
+        break;
+    case 20:
+        fld = cli_map_list_search(m->fmt, argv[2], 2);
+        foreach_port(portlist, range_set_mode(info, fld, argv[4]));
+        break;
+    case 30:
+        fld = cli_map_list_search(m->fmt, argv[2], 2);
+        foreach_port(portlist, range_set_list(info, fld, argv[4]));
+        break;
+    case 40:
+        foreach_port(portlist, range_show(info));
+        break;
+    default:
+        return cli_cmd_error("Range command is invalid", "Range", argc, argv);
+    }
+    txgen_update_display();
+    return 0;
+}
+
 // clang-format off
 static struct cli_map pcap_map[] = {
     {10, "pcap %D"},
@@ -476,7 +555,8 @@ theme_cmd(int argc, char **argv)
 // clang-format off
 #define ed_type "pcap|" /* 0 */    \
         "capture|"      /* 1 */    \
-        "chksum"        /* 2 */
+        "chksum|"       /* 2 */    \
+        "range"         /* 3 */
 
 static struct cli_map enable_map[] = {
     { 10, "enable %P %|" ed_type },
@@ -492,6 +572,7 @@ static const char *enable_help[] = {
     "enable|disable <portlist> capture  - Enable/Disable packet capturing on a portlist, disable to save capture",
     "                                     Disable capture on a port to save the data into the current working directory",
     "enable|disable <portlist> chksum   - Enable/Disable packet checksum calc on a portlist",
+    "enable|disable <portlist> range    - Enable/Disable sending range packets on a portlist",
     "enable|disable screen              - Enable/disable "
     "updating the screen and unlock/lock window",
     "    off                            - screen off shortcut",
@@ -530,6 +611,9 @@ en_dis_cmd(int argc, char **argv)
         case 2:
             foreach_port(portlist, enable_chksum(info, state));
             break;
+        case 3:
+            foreach_port(portlist, enable_range(info, state));
+            break;
         default:
             return cli_cmd_error("Enable/Disable invalid command or command not supported yet",
                                  "Enable", argc, argv);
@@ -683,6 +767,7 @@ static struct cli_tree default_tree[] = {
     c_cmd("pcap", pcap_cmd, "pcap commands"),
     c_cmd("page", page_cmd, "change page displays"),
     c_cmd("set", set_cmd, "set a number of options"),
+    c_cmd("range", range_cmd, "set the range fields of the packets"),
 
     c_alias("on", "enable screen", "Enable screen updates"),
     c_alias("off", "disable screen", "Disable screen updates"),
@@ -704,6 +789,7 @@ init_tree(void)
     cli_help_add("Page", page_map, page_help);
     cli_help_add("Enable", enable_map, enable_help);
     cli_help_add("Set", set_map, set_help);
+    cli_help_add("Range", range_map, range_help);
     cli_help_add("PCAP", pcap_map, pcap_help);
     cli_help_add("Start", start_map, start_help);
     cli_help_add("Misc", misc_map, misc_help);
@@ -23,6 +23,7 @@
 #include "cne_inet.h"             // for inet_ntop4
 #include "_pcap.h"                // for pcap_info_t
 #include "capture.h"              // for txgen_set_capture
+#include "range.h"                // for range_init, range_script_save
 #include "cli.h"                  // for cli_quit
 #include "cne.h"                  // for copyright_msg, powered_by
 #include "cne_common.h"           // for __cne_unused
@@ -119,6 +120,7 @@ _dump_lport(jcfg_info_t *j __cne_unused, void *obj, void *arg, int idx __cne_unu
         snprintf(buff, sizeof(buff), "%s", info->user_pattern);
         fprintf(fd, "set %d user pattern %s\n", lport->lpid, buff);
     }
+    range_script_save(fd, info);
     fprintf(fd, "\n");
 
     fprintf(fd, "%sable %d capture\n", (flags & CAPTURE_PKTS) ? "en" : "dis", lport->lpid);
@@ -312,7 +314,8 @@ txgen_flags_string(port_info_t *info)
     static char buff[32];
 
     snprintf(buff, sizeof(buff), "%c:%s:%6s:%s", (txgen.flags & PROMISCUOUS_ON_FLAG) ? 'P' : '-',
-             (txgen_tst_port_flags(info, SEND_PCAP_PKTS)) ? "PCAP" : "-", "Single",
+             (txgen_tst_port_flags(info, SEND_PCAP_PKTS)) ? "PCAP" : "-",
+             (txgen_tst_port_flags(info, SEND_RANGE_PKTS)) ? "Range" : "Single",
              (txgen_tst_port_flags(info, CALC_CHKSUM)) ? "CHKSUM" : "-");
 
     return buff;
@@ -583,6 +586,7 @@ txgen_port_defaults(uint32_t pid)
     memset(&pkt->eth_dst_addr, 0, sizeof(pkt->eth_dst_addr));
 
     txgen_packet_ctor(info);
+    range_init(info);
 
     txgen.flags |= PRINT_LABELS_FLAG;
 }
@@ -985,6 +989,29 @@ enable_pcap(port_info_t *info, uint32_t state)
     }
 }
 
+/**
+ *
+ * enable_range - Enable or disable range sending of packets.
+ *
+ * DESCRIPTION
+ * Enable or disable sending packets with the range fields.
+ *
+ * RETURNS: N/A
+ *
+ * SEE ALSO:
+ */
+
+void
+enable_range(port_info_t *info, uint32_t state)
+{
+    if (state == ENABLE_STATE) {
+        txgen_clr_port_flags(info, EXCLUSIVE_MODES);
+        txgen_set_port_flags(info, SEND_RANGE_PKTS);
+    } else
+        txgen_clr_port_flags(info, SEND_RANGE_PKTS);
+    info->tx_cycles = 0;
+}
+
 /**
  *
  * pcap_filter - Compile a PCAP filter for a portlist
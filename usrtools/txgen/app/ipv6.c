@@ -28,8 +28,8 @@ txgen_ipv6_ctor(pkt_seq_t *pkt, void *hdr)
     struct cne_ipv6_hdr *ip = hdr;
     uint16_t tlen;
 
-    /* IPv6 Header constructor */
-    tlen = pkt->pktSize - pkt->ether_hdr_size;
+    /* IPv6 Header constructor, the payload length does not include the IPv6 header */
+    tlen = pkt->pktSize - (pkt->ether_hdr_size + sizeof(struct cne_ipv6_hdr));
 
     /* Zero out the header space */
     memset((char *)ip, 0, sizeof(struct cne_ipv6_hdr));
@@ -22,6 +22,7 @@
 #include "ether.h"
 #include "netdev_funcs.h"
 #include "pcap.h"
+#include "range.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,7 +70,8 @@ enum { /* Per lport flag bits */
        SEND_FOREVER    = (1 << 1), /**< Send packets forever */
 
        /* Exclusive Packet sending modes */
-       SEND_PCAP_PKTS = (1 << 12), /**< Send a pcap file of packets */
+       SEND_PCAP_PKTS  = (1 << 12), /**< Send a pcap file of packets */
+       SEND_RANGE_PKTS = (1 << 13), /**< Send packets with range fields */
 
        SAMPLING_LATENCIES = (1 << 14), /**< Sampling latency measurements> */
        CALC_CHKSUM        = (1 << 15), /**< Calculate packet checksum> */
@@ -77,7 +79,7 @@ enum { /* Per lport flag bits */
        RUNNING_FLAG = (1 << 8),
 };
 
-#define EXCLUSIVE_MODES SEND_PCAP_PKTS
+#define EXCLUSIVE_MODES (SEND_PCAP_PKTS | SEND_RANGE_PKTS)
 
 typedef enum {
     ZERO_FILL_PATTERN = 1,
@@ -134,6 +136,8 @@ typedef struct port_info_s {
     pcap_info_t *pcap;    /**< PCAP information header */
     uint64_t pcap_cycles; /**< number of cycles for pcap sending */
 
+    range_info_t range; /**< Range fields of the packets */
+
     int32_t pcap_result;             /**< PCAP result of filter compile */
     struct bpf_program pcap_program; /**< PCAP filter program structure */
 
@@ -0,0 +1,596 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation.
+ */
+
+#include <stdio.h>                // for snprintf, fprintf, FILE
+#include <stdlib.h>               // for strtoull
+#include <string.h>               // for memcpy, memset, strcmp
+#include <errno.h>                // for errno
+#include <endian.h>               // for htobe64
+#include <netinet/in.h>           // for htonl, htons, ntohl, ntohs, IPPROTO_UDP
+#include <arpa/inet.h>            // for inet_aton
+#include <net/ethernet.h>         // for ETHER_CRC_LEN, ether_addr
+#include <bsd/string.h>           // for strlcpy
+#include <inttypes.h>             // for PRIu64
+#include <cne_common.h>           // for CNE_MIN, CNE_MAX, cne_countof
+#include <cne_cycles.h>           // for cne_rdtsc
+#include <cne_pktcpy.h>           // for cne_pktcpy
+#include <net/cne_ether.h>        // for cne_ether_hdr, cne_vlan_hdr, cne_ether_aton
+#include <net/cne_ip.h>           // for cne_ipv4_hdr, cne_ipv6_hdr
+#include <net/cne_udp.h>          // for cne_udp_hdr
+#include <net/cne_tcp.h>          // for cne_tcp_hdr
+#include <net/cne_cksum.h>        // for cne_cksum_add, cne_cksum_fold
+
+#include "range.h"
+#include "txgen.h"            // for txgen_tst_port_flags
+#include "port-cfg.h"         // for port_info_t, SEND_RANGE_PKTS
+#include "seq.h"              // for pkt_seq_t
+#include "cne_stdio.h"        // for cne_printf
+#include "cne_log.h"          // for CNE_ERR_RET
+
+static const char *range_names[RANGE_MAX_FIELDS] = {
+    [RANGE_DST_MAC] = "dmac", [RANGE_SRC_MAC] = "smac",  [RANGE_DST_IP] = "dip",
+    [RANGE_SRC_IP] = "sip",   [RANGE_SPORT] = "sport",   [RANGE_DPORT] = "dport",
+    [RANGE_VLAN] = "vlan",    [RANGE_PKT_SIZE] = "size",
+};
+
+static const char *mode_names[] = {
+    [RANGE_OFF] = "off", [RANGE_INC] = "inc", [RANGE_RANDOM] = "random", [RANGE_LIST] = "list"};
+
+static const uint64_t range_max[RANGE_MAX_FIELDS] = {
+    [RANGE_DST_MAC] = 0xffffffffffffULL, [RANGE_SRC_MAC] = 0xffffffffffffULL,
+    [RANGE_DST_IP] = 0xffffffff,         [RANGE_SRC_IP] = 0xffffffff,
+    [RANGE_SPORT] = 0xffff,              [RANGE_DPORT] = 0xffff,
+    [RANGE_VLAN] = CNE_ETHER_MAX_VLAN_ID, [RANGE_PKT_SIZE] = CNE_ETHER_MAX_LEN,
+};
+
+#define RANGE_BIT(f) (1U << (f))
+
+/* Sum of the one's complement of a word and its new value, see RFC 1624 */
+#define CKSUM_DELTA16(from, to) ((uint64_t)(uint16_t) ~(from) + (uint16_t)(to))
+#define CKSUM_DELTA32(from, to) ((uint64_t)(uint32_t) ~(from) + (uint32_t)(to))
+
+static inline uint64_t
+mac_to_u64(const struct ether_addr *mac)
+{
+    uint64_t v = 0;
+
+    for (int i = 0; i < ETH_ALEN; i++)
+        v = (v << 8) | mac->ether_addr_octet[i];
+
+    return v;
+}
+
+static void
+range_format(int fld, uint64_t v, char *buf, size_t len)
+{
+    switch (fld) {
+    case RANGE_DST_MAC:
+    case RANGE_SRC_MAC:
+        snprintf(buf, len, "%02x:%02x:%02x:%02x:%02x:%02x", (uint8_t)(v >> 40),
+                 (uint8_t)(v >> 32), (uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8),
+                 (uint8_t)v);
+        break;
+    case RANGE_DST_IP:
+    case RANGE_SRC_IP:
+        snprintf(buf, len, "%u.%u.%u.%u", (uint8_t)(v >> 24), (uint8_t)(v >> 16),
+                 (uint8_t)(v >> 8), (uint8_t)v);
+        break;
+    default:
+        snprintf(buf, len, "%" PRIu64, v);
+        break;
+    }
+}
+
+static void
+range_active_update(range_info_t *r)
+{
+    uint32_t active = 0;
+
+    for (int i = 0; i < RANGE_MAX_FIELDS; i++) {
+        range_field_t *f = &r->fld[i];
+
+        if (f->mode == RANGE_OFF || (f->mode == RANGE_LIST && f->list_cnt == 0))
+            continue;
+        active |= RANGE_BIT(i);
+    }
+    r->active = active;
+}
+
+void
+range_init(port_info_t *info)
+{
+    range_info_t *r = &info->range;
+    pkt_seq_t *pkt  = &info->pkt;
+    uint64_t val[RANGE_MAX_FIELDS];
+
+    val[RANGE_DST_MAC]  = mac_to_u64(&pkt->eth_dst_addr);
+    val[RANGE_SRC_MAC]  = mac_to_u64(&pkt->eth_src_addr);
+    val[RANGE_DST_IP]   = pkt->ip_dst_addr.s_addr;
+    val[RANGE_SRC_IP]   = pkt->ip_src_addr.s_addr;
+    val[RANGE_SPORT]    = pkt->sport;
+    val[RANGE_DPORT]    = pkt->dport;
+    val[RANGE_VLAN]     = 1;
+    val[RANGE_PKT_SIZE] = pkt->pktSize + ETHER_CRC_LEN;
+
+    memset(r->fld, 0, sizeof(r->fld));
+    for (int i = 0; i < RANGE_MAX_FIELDS; i++) {
+        range_field_t *f = &r->fld[i];
+
+        f->mode  = RANGE_OFF;
+        f->start = f->min = f->max = f->cur = val[i];
+        f->inc                              = 1;
+    }
+    r->seed = cne_rdtsc() | 1;
+
+    range_active_update(r);
+}
+
+void
+txgen_range_update(port_info_t *info)
+{
+    range_info_t *r = &info->range;
+    pkt_seq_t *pkt  = &info->pkt;
+    uint8_t *l4;
+    uint64_t sum = 0;
+
+    if (pkt->ethType == CNE_ETHER_TYPE_IPV4)
+        r->l4_off = pkt->ether_hdr_size + sizeof(struct cne_ipv4_hdr);
+    else if (pkt->ethType == CNE_ETHER_TYPE_IPV6)
+        r->l4_off = pkt->ether_hdr_size + sizeof(struct cne_ipv6_hdr);
+    else {
+        r->l4_off = 0;
+        return;
+    }
+
+    /* The fill pattern of the template covers all lengths of the size range */
+    l4 = (uint8_t *)&pkt->hdr + r->l4_off;
+
+    r->l4_sum[0] = 0;
+    for (int n = 1; n < (int)cne_countof(r->l4_sum); n++) {
+        if (n & 1)
+            r->l4_sum[n] = cne_cksum_fold(cne_cksum_add(&l4[n - 1], 1, sum));
+        else {
+            sum          = cne_cksum_add(&l4[n - 2], 2, sum);
+            r->l4_sum[n] = cne_cksum_fold(sum);
+        }
+    }
+}
+
+static inline uint64_t
+range_random(range_info_t *r)
+{
+    uint64_t x = r->seed;
+
+    /* xorshift64* */
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    r->seed = x;
+
+    return x * 0x2545f4914f6cdd1dULL;
+}
+
+/* Generate the values of a field for a burst, in host order */
+static inline void
+range_gen(range_info_t *r, range_field_t *f, uint64_t *v, uint16_t nb)
+{
+    uint64_t cur = f->cur, span;
+    uint16_t idx;
+
+    switch (f->mode) {
+    case RANGE_INC:
+        if (cur < f->min || cur > f->max)
+            cur = f->min;
+        if (cur + (nb - 1) * f->inc <= f->max) {
+            /* No wrap in the burst, a loop the compiler vectorises */
+            for (uint16_t i = 0; i < nb; i++)
+                v[i] = cur + i * f->inc;
+            cur += nb * f->inc;
+        } else {
+            for (uint16_t i = 0; i < nb; i++) {
+                v[i] = cur;
+                cur += f->inc;
+                if (cur > f->max)
+                    cur = f->min;
+            }
+        }
+        f->cur = cur;
+        break;
+
+    case RANGE_RANDOM:
+        span = (f->max > f->min) ? f->max - f->min + 1 : 1;
+        for (uint16_t i = 0; i < nb; i++)
+            v[i] = f->min + (uint64_t)(((unsigned __int128)range_random(r) * span) >> 64);
+        break;
+
+    case RANGE_LIST:
+        idx = f->list_idx;
+        for (uint16_t i = 0; i < nb; i++) {
+            if (idx >= f->list_cnt)
+                idx = 0;
+            v[i] = f->list[idx++];
+        }
+        f->list_idx = idx;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void
+txgen_range_ctor(port_info_t *info, pktmbuf_t **pkts, uint16_t nb)
+{
+    range_info_t *r = &info->range;
+    pkt_seq_t *pkt  = &info->pkt;
+    uint8_t *tmpl   = (uint8_t *)&pkt->hdr;
+    uint64_t vals[RANGE_MAX_FIELDS][DEFAULT_BURST_SIZE];
+    struct cne_ipv4_hdr *tip = NULL;
+    struct cne_udp_hdr *tudp = NULL;
+    uint32_t active = r->active, ip_fix, l4_fix;
+    uint16_t l3_off = pkt->ether_hdr_size;
+    uint16_t l3_len = 0, cov_len = 0, udp_len = 0, min_len = 0;
+    uint64_t ip_base = 0, l4_base = 0;
+    bool ipv4, ipv6, udp, l4;
+
+    ipv4 = (pkt->ethType == CNE_ETHER_TYPE_IPV4);
+    ipv6 = (pkt->ethType == CNE_ETHER_TYPE_IPV6);
+    udp  = (pkt->ipProto == IPPROTO_UDP);
+    l4   = (ipv4 || ipv6) && (udp || pkt->ipProto == IPPROTO_TCP);
+    if (!ipv4 || !l4)
+        active &= ~(RANGE_BIT(RANGE_DST_IP) | RANGE_BIT(RANGE_SRC_IP));
+    if (!l4)
+        active &= ~(RANGE_BIT(RANGE_SPORT) | RANGE_BIT(RANGE_DPORT) | RANGE_BIT(RANGE_PKT_SIZE));
+
+    ip_fix = active & (RANGE_BIT(RANGE_DST_IP) | RANGE_BIT(RANGE_SRC_IP));
+    l4_fix = active & (RANGE_BIT(RANGE_DST_IP) | RANGE_BIT(RANGE_SRC_IP) | RANGE_BIT(RANGE_SPORT) |
+                       RANGE_BIT(RANGE_DPORT) | RANGE_BIT(RANGE_PKT_SIZE));
+
+    /*
+     * The checksum updates use the fields of the template, reading them back from the packet
+     * just copied would stall on the store forwarding of the copy.
+     */
+    if (l4) {
+        /* The ports are at the same offsets in the UDP and TCP headers */
+        tudp    = (struct cne_udp_hdr *)(tmpl + r->l4_off);
+        l4_base = (uint16_t)~(udp ? tudp->dgram_cksum : ((struct cne_tcp_hdr *)tudp)->cksum);
+    }
+    if (ipv4) {
+        tip     = (struct cne_ipv4_hdr *)(tmpl + l3_off);
+        ip_base = (uint16_t)~tip->hdr_checksum;
+    }
+
+    /* Lengths of the template, the size field moves all of them by the same delta */
+    if (active & RANGE_BIT(RANGE_PKT_SIZE)) {
+        if (ipv4) {
+            l3_len  = ntohs(tip->total_length);
+            cov_len = l3_len - sizeof(struct cne_ipv4_hdr);
+            ip_fix |= RANGE_BIT(RANGE_PKT_SIZE);
+        } else {
+            l3_len  = ntohs(((struct cne_ipv6_hdr *)(tmpl + l3_off))->payload_len);
+            cov_len = l3_len;
+        }
+        udp_len = ntohs(tudp->dgram_len);
+
+        /* Keep the L4 header in the packet, e.g. an IPv6 TCP packet is larger than 60 bytes */
+        min_len = r->l4_off + (udp ? sizeof(struct cne_udp_hdr) : sizeof(struct cne_tcp_hdr));
+    }
+
+    if (nb > DEFAULT_BURST_SIZE)
+        nb = DEFAULT_BURST_SIZE;
+
+    /* Generate all the values of the burst, converted to the packet format */
+    for (int f = 0; f < RANGE_MAX_FIELDS; f++) {
+        uint64_t *v = vals[f];
+
+        if ((active & RANGE_BIT(f)) == 0)
+            continue;
+
+        range_gen(r, &r->fld[f], v, nb);
+
+        switch (f) {
+        case RANGE_DST_MAC:
+        case RANGE_SRC_MAC:
+            for (uint16_t i = 0; i < nb; i++)
+                v[i] = htobe64(v[i] << 16);
+            break;
+        case RANGE_DST_IP:
+        case RANGE_SRC_IP:
+            for (uint16_t i = 0; i < nb; i++)
+                v[i] = htonl((uint32_t)v[i]);
+            break;
+        case RANGE_SPORT:
+        case RANGE_DPORT:
+            for (uint16_t i = 0; i < nb; i++)
+                v[i] = htons((uint16_t)v[i]);
+            break;
+        case RANGE_VLAN:
+            for (uint16_t i = 0; i < nb; i++)
+                v[i] = htons((uint16_t)(v[i] & CNE_ETHER_MAX_VLAN_ID));
+            break;
+        case RANGE_PKT_SIZE:
+            for (uint16_t i = 0; i < nb; i++)
+                v[i] = CNE_MAX(v[i] - ETHER_CRC_LEN, (uint64_t)min_len);
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (uint16_t i = 0; i < nb; i++) {
+        pktmbuf_t *m    = pkts[i];
+        uint8_t *p      = pktmbuf_mtod(m, uint8_t *);
+        uint16_t len    = pkt->pktSize;
+        uint64_t ip_sum = ip_base, l4_sum = l4_base;
+        struct cne_ipv4_hdr *ip;
+        struct cne_udp_hdr *uh;
+        uint8_t *l3;
+
+        if (active & RANGE_BIT(RANGE_PKT_SIZE))
+            len = vals[RANGE_PKT_SIZE][i];
+
+        if (active & RANGE_BIT(RANGE_VLAN)) {
+            struct cne_ether_hdr *eth = (struct cne_ether_hdr *)p;
+            struct cne_vlan_hdr *vh   = (struct cne_vlan_hdr *)&eth[1];
+
+            /* Insert the tag after the addresses, the L3 packet is not changed */
+            memcpy(p, tmpl, 2 * ETH_ALEN);
+            cne_pktcpy(&vh->eth_proto, tmpl + 2 * ETH_ALEN, len - 2 * ETH_ALEN);
+            eth->ether_type = htons(CNE_ETHER_TYPE_VLAN);
+            vh->vlan_tci    = vals[RANGE_VLAN][i];
+            l3              = p + l3_off + sizeof(struct cne_vlan_hdr);
+            m->data_len     = len + sizeof(struct cne_vlan_hdr);
+        } else {
+            cne_pktcpy(p, tmpl, len);
+            l3          = p + l3_off;
+            m->data_len = len;
+        }
+
+        if (active & RANGE_BIT(RANGE_DST_MAC))
+            memcpy(p, &vals[RANGE_DST_MAC][i], ETH_ALEN);
+        if (active & RANGE_BIT(RANGE_SRC_MAC))
+            memcpy(p + ETH_ALEN, &vals[RANGE_SRC_MAC][i], ETH_ALEN);
+
+        if (!l4_fix)
+            continue;
+
+        ip = (struct cne_ipv4_hdr *)l3;
+        uh = (struct cne_udp_hdr *)(l3 + r->l4_off - l3_off);
+
+        /* The addresses are in the IPv4 header and the L4 pseudo header */
+        if (active & RANGE_BIT(RANGE_DST_IP)) {
+            uint64_t d = CKSUM_DELTA32(tip->dst_addr, vals[RANGE_DST_IP][i]);
+
+            ip->dst_addr = vals[RANGE_DST_IP][i];
+            ip_sum += d;
+            l4_sum += d;
+        }
+        if (active & RANGE_BIT(RANGE_SRC_IP)) {
+            uint64_t d = CKSUM_DELTA32(tip->src_addr, vals[RANGE_SRC_IP][i]);
+
+            ip->src_addr = vals[RANGE_SRC_IP][i];
+            ip_sum += d;
+            l4_sum += d;
+        }
+
+        if (active & RANGE_BIT(RANGE_SPORT)) {
+            l4_sum += CKSUM_DELTA16(tudp->src_port, vals[RANGE_SPORT][i]);
+            uh->src_port = vals[RANGE_SPORT][i];
+        }
+        if (active & RANGE_BIT(RANGE_DPORT)) {
+            l4_sum += CKSUM_DELTA16(tudp->dst_port, vals[RANGE_DPORT][i]);
+            uh->dst_port = vals[RANGE_DPORT][i];
+        }
+
+        if (active & RANGE_BIT(RANGE_PKT_SIZE)) {
+            uint16_t l3len = htons(l3_len + len - pkt->pktSize);
+            uint16_t cov   = cov_len + len - pkt->pktSize;
+
+            if (ipv4) {
+                ip_sum += CKSUM_DELTA16(tip->total_length, l3len);
+                ip->total_length = l3len;
+            } else
+                ((struct cne_ipv6_hdr *)l3)->payload_len = l3len;
+
+            /* Pseudo header length and the data added or removed at the end */
+            l4_sum += CKSUM_DELTA16(htons(cov_len), htons(cov));
+            l4_sum += CKSUM_DELTA16(r->l4_sum[cov_len], r->l4_sum[cov]);
+
+            if (udp) {
+                uint16_t dlen = htons(udp_len + len - pkt->pktSize);
+
+                l4_sum += CKSUM_DELTA16(tudp->dgram_len, dlen);
+                uh->dgram_len = dlen;
+            }
+        }
+
+        if (ip_fix)
+            ip->hdr_checksum = ~cne_cksum_fold(ip_sum);
+        if (udp) {
+            uint16_t ck = ~cne_cksum_fold(l4_sum);
+
+            uh->dgram_cksum = (ck == 0) ? 0xffff : ck;
+        } else
+            ((struct cne_tcp_hdr *)uh)->cksum = ~cne_cksum_fold(l4_sum);
+    }
+}
+
+int
+range_parse_value(int fld, const char *str, uint64_t *val)
+{
+    struct ether_addr eaddr;
+    struct in_addr ip;
+    char *end;
+
+    if (fld < 0 || fld >= RANGE_MAX_FIELDS || !str || !val)
+        return -1;
+
+    switch (fld) {
+    case RANGE_DST_MAC:
+    case RANGE_SRC_MAC:
+        if (cne_ether_aton(str, &eaddr) == NULL)
+            return -1;
+        *val = mac_to_u64(&eaddr);
+        break;
+    case RANGE_DST_IP:
+    case RANGE_SRC_IP:
+        if (!inet_aton(str, &ip))
+            return -1;
+        *val = ntohl(ip.s_addr);
+        break;
+    default:
+        errno = 0;
+        *val  = strtoull(str, &end, 0);
+        if (errno || end == str || *end != '\0' || *val > range_max[fld])
+            return -1;
+        break;
+    }
+
+    return 0;
+}
+
+static inline uint64_t
+range_clamp(int fld, uint64_t val)
+{
+    if (fld == RANGE_PKT_SIZE && val < CNE_ETHER_MIN_LEN)
+        return CNE_ETHER_MIN_LEN;
+
+    return CNE_MIN(val, range_max[fld]);
+}
+
+void
+range_set_value(port_info_t *info, int fld, const char *what, uint64_t val)
+{
+    range_field_t *f;
+
+    if (fld < 0 || fld >= RANGE_MAX_FIELDS)
+        return;
+    f = &info->range.fld[fld];
+
+    if (!strcmp(what, "inc"))
+        f->inc = CNE_MIN(val, range_max[fld]);
+    else if (!strcmp(what, "start"))
+        f->start = f->cur = range_clamp(fld, val);
+    else if (!strcmp(what, "min"))
+        f->min = range_clamp(fld, val);
+    else if (!strcmp(what, "max"))
+        f->max = range_clamp(fld, val);
+}
+
+void
+range_set_mode(port_info_t *info, int fld, const char *mode)
+{
+    range_field_t *f;
+
+    if (fld < 0 || fld >= RANGE_MAX_FIELDS)
+        return;
+    f = &info->range.fld[fld];
+
+    for (int i = 0; i < (int)cne_countof(mode_names); i++) {
+        if (!strcmp(mode, mode_names[i])) {
+            f->mode     = i;
+            f->cur      = f->start;
+            f->list_idx = 0;
+            break;
+        }
+    }
+
+    range_active_update(&info->range);
+}
+
+int
+range_set_list(port_info_t *info, int fld, const char *list)
+{
+    uint64_t vals[RANGE_LIST_SIZE];
+    char buf[512], *tok, *save = NULL;
+    range_field_t *f;
+    int n = 0;
+
+    if (fld < 0 || fld >= RANGE_MAX_FIELDS || !list)
+        return -1;
+    f = &info->range.fld[fld];
+
+    strlcpy(buf, list, sizeof(buf));
+    for (tok = strtok_r(buf, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+        if (n == RANGE_LIST_SIZE)
+            CNE_ERR_RET("Range list has more than %d values\n", RANGE_LIST_SIZE);
+        if (range_parse_value(fld, tok, &vals[n]) < 0)
+            CNE_ERR_RET("Invalid %s value %s\n", range_names[fld], tok);
+        vals[n] = range_clamp(fld, vals[n]);
+        n++;
+    }
+
+    memcpy(f->list, vals, n * sizeof(vals[0]));
+    f->list_idx = 0;
+    f->list_cnt = n;
+
+    range_active_update(&info->range);
+
+    return 0;
+}
+
+void
+range_show(port_info_t *info)
+{
+    range_info_t *r = &info->range;
+    char start[32], min[32], max[32], inc[32];
+
+    cne_printf("Port %d range mode is %s\n", info->lport->lpid,
+               txgen_tst_port_flags(info, SEND_RANGE_PKTS) ? "enabled" : "disabled");
+    cne_printf("  %-6s %-7s %-18s %-18s %-18s %-18s\n", "Field", "Mode", "Start", "Min", "Max",
+               "Inc");
+    for (int i = 0; i < RANGE_MAX_FIELDS; i++) {
+        range_field_t *f = &r->fld[i];
+
+        range_format(i, f->start, start, sizeof(start));
+        range_format(i, f->min, min, sizeof(min));
+        range_format(i, f->max, max, sizeof(max));
+        range_format(i, f->inc, inc, sizeof(inc));
+        cne_printf("  %-6s %-7s %-18s %-18s %-18s %-18s\n", range_names[i], mode_names[f->mode],
+                   start, min, max, inc);
+
+        if (f->list_cnt) {
+            cne_printf("         list:");
+            for (int j = 0; j < f->list_cnt; j++) {
+                range_format(i, f->list[j], start, sizeof(start));
+                cne_printf(" %s", start);
+            }
+            cne_printf("\n");
+        }
+    }
+}
+
+void
+range_script_save(FILE *fd, port_info_t *info)
+{
+    range_info_t *r = &info->range;
+    int pid         = info->lport->lpid;
+    char buff[32];
+
+    fprintf(fd, "#\n# Range fields:\n");
+    for (int i = 0; i < RANGE_MAX_FIELDS; i++) {
+        range_field_t *f = &r->fld[i];
+
+        range_format(i, f->start, buff, sizeof(buff));
+        fprintf(fd, "range %d %s start %s\n", pid, range_names[i], buff);
+        range_format(i, f->min, buff, sizeof(buff));
+        fprintf(fd, "range %d %s min %s\n", pid, range_names[i], buff);
+        range_format(i, f->max, buff, sizeof(buff));
+        fprintf(fd, "range %d %s max %s\n", pid, range_names[i], buff);
+        range_format(i, f->inc, buff, sizeof(buff));
+        fprintf(fd, "range %d %s inc %s\n", pid, range_names[i], buff);
+
+        if (f->list_cnt) {
+            fprintf(fd, "range %d %s list ", pid, range_names[i]);
+            for (int j = 0; j < f->list_cnt; j++) {
+                range_format(i, f->list[j], buff, sizeof(buff));
+                fprintf(fd, "%s%s", (j) ? "," : "", buff);
+            }
+            fprintf(fd, "\n");
+        }
+        fprintf(fd, "range %d %s mode %s\n", pid, range_names[i], mode_names[f->mode]);
+    }
+    fprintf(fd, "%sable %d range\n", txgen_tst_port_flags(info, SEND_RANGE_PKTS) ? "en" : "dis",
+            pid);
+}
@@ -0,0 +1,174 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation.
+ */
+
+#ifndef _TXGEN_RANGE_H_
+#define _TXGEN_RANGE_H_
+
+/**
+ * @file
+ *
+ * Range mode varies the header fields of the packets sent on a port, e.g. to spread flows
+ * over a flow table, RSS queues or FIB entries. Each field has its own generator which
+ * increments the value from min to max, picks a random value between min and max or cycles
+ * through a list of values (sequence). The values of a burst are generated together, then
+ * written into the copies of the port template with incremental checksum updates.
+ */
+
+#include <stdio.h>                // for FILE
+#include <stdint.h>               // for uint64_t, uint32_t, uint16_t, uint8_t
+#include <net/ethernet.h>         // for ETHER_MAX_LEN
+#include <pktmbuf.h>              // for pktmbuf_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct port_info_s;
+
+enum { /* Range fields, in the order of the CLI field names */
+       RANGE_DST_MAC = 0,
+       RANGE_SRC_MAC,
+       RANGE_DST_IP,
+       RANGE_SRC_IP,
+       RANGE_SPORT,
+       RANGE_DPORT,
+       RANGE_VLAN,
+       RANGE_PKT_SIZE,
+       RANGE_MAX_FIELDS
+};
+
+typedef enum {
+    RANGE_OFF = 0, /**< The field is the value of the template */
+    RANGE_INC,     /**< Increment from start by inc and wrap from max to min */
+    RANGE_RANDOM,  /**< Random value between min and max */
+    RANGE_LIST,    /**< Cycle through the list of values */
+} range_mode_t;
+
+#define RANGE_LIST_SIZE 16 /**< Max number of values in a field list */
+
+typedef struct range_field_s {
+    range_mode_t mode;               /**< Generator of the field */
+    uint64_t start;                  /**< First value of the increment generator */
+    uint64_t min;                    /**< Min value of the increment or random generator */
+    uint64_t max;                    /**< Max value of the increment or random generator */
+    uint64_t inc;                    /**< Increment value */
+    uint64_t cur;                    /**< Next value of the increment generator */
+    uint16_t list_cnt;               /**< Number of values in the list */
+    uint16_t list_idx;               /**< Next value of the list */
+    uint64_t list[RANGE_LIST_SIZE];  /**< List of values */
+} range_field_t;
+
+typedef struct range_info_s {
+    uint32_t active;                    /**< Bit mask of the fields with a generator */
+    uint64_t seed;                      /**< State of the random generator */
+    uint16_t l4_off;                    /**< Offset of the L4 header in the template */
+    uint16_t l4_sum[ETHER_MAX_LEN];     /**< Folded sums of the template L4 segment by length */
+    range_field_t fld[RANGE_MAX_FIELDS]; /**< Generator of each field */
+} range_info_t;
+
+/**
+ * Set the default range of all fields of a port from its template, all generators are off.
+ *
+ * @param info
+ *   The port information.
+ */
+void range_init(struct port_info_s *info);
+
+/**
+ * Update the range data derived from the template, called when the template is rebuilt.
+ *
+ * @param info
+ *   The port information.
+ */
+void txgen_range_update(struct port_info_s *info);
+
+/**
+ * Build a burst of packets from the template with the range fields of each packet.
+ *
+ * @param info
+ *   The port information.
+ * @param pkts
+ *   The packets to build, the data_len is set to the length of each packet.
+ * @param nb
+ *   Number of packets, at most DEFAULT_BURST_SIZE.
+ */
+void txgen_range_ctor(struct port_info_s *info, pktmbuf_t **pkts, uint16_t nb);
+
+/**
+ * Parse a value of a range field, a MAC address, an IPv4 address or a number.
+ *
+ * @param fld
+ *   The range field, RANGE_DST_MAC to RANGE_PKT_SIZE.
+ * @param str
+ *   The string to parse.
+ * @param val
+ *   The parsed value in host order.
+ * @return
+ *   0 on success or -1 if the string is not a valid value of the field.
+ */
+int range_parse_value(int fld, const char *str, uint64_t *val);
+
+/**
+ * Set the start, min, max or inc value of a range field.
+ *
+ * @param info
+ *   The port information.
+ * @param fld
+ *   The range field.
+ * @param what
+ *   The value to set: "start", "min", "max" or "inc".
+ * @param val
+ *   The value in host order.
+ */
+void range_set_value(struct port_info_s *info, int fld, const char *what, uint64_t val);
+
+/**
+ * Set the generator of a range field.
+ *
+ * @param info
+ *   The port information.
+ * @param fld
+ *   The range field.
+ * @param mode
+ *   The generator: "off", "inc", "random" or "list".
+ */
+void range_set_mode(struct port_info_s *info, int fld, const char *mode);
+
+/**
+ * Set the list of values of a range field.
+ *
+ * @param info
+ *   The port information.
+ * @param fld
+ *   The range field.
+ * @param list
+ *   A comma separated list of at most RANGE_LIST_SIZE values.
+ * @return
+ *   0 on success or -1 if a value is invalid.
+ */
+int range_set_list(struct port_info_s *info, int fld, const char *list);
+
+/**
+ * Display the range fields of a port.
+ *
+ * @param info
+ *   The port information.
+ */
+void range_show(struct port_info_s *info);
+
+/**
+ * Write the range commands of a port to a configuration script.
+ *
+ * @param fd
+ *   The script file.
+ * @param info
+ *   The port information.
+ */
+void range_script_save(FILE *fd, struct port_info_s *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TXGEN_RANGE_H_ */
@@ -8,6 +8,7 @@
 #include <cne_system.h>        // for cne_get_timer_hz
 #include <cne_cycles.h>        // for cne_rdtsc
 #include <cne_pause.h>         // for cne_pause
+#include <cne_crc.h>           // for cne_crc32_eth
 #include <netinet/in.h>        // for in_addr, IPPROTO_UDP, ntohs
 #include <pthread.h>           // for pthread_mutex_lock, pthread_mutex...
 #include <string.h>            // for memset, memcpy
@@ -21,6 +22,7 @@
 #include "display.h"         // for display_set_color
 #include "port-cfg.h"        // for port_info_t, port_sizes_t, mbuf_t...
 #include "pcap.h"            // for txgen_page_pcap, txgen_pcap_mbuf_...
+#include "range.h"           // for txgen_range_ctor, txgen_range_update
 #include "cmds.h"            // for txgen_force_update
 #include "cne_inet.h"
 #include "_pcap.h"                        // for pcap_info_t
@@ -37,7 +39,6 @@
 #include "seq.h"                 // for pkt_seq_t
 #include "stats.h"               // for pkt_stats_t, txgen_page_stats
 #include "latency.h"
-#include "cne_net_crc.h"
 /* Allocated the txgen structure for global use */
 txgen_t txgen;
 
@@ -281,18 +282,19 @@ txgen_packet_ctor(port_info_t *info)
     l3_hdr = txgen_ether_hdr_ctor(info, pkt, eth);
 
     if (likely(pkt->ethType == CNE_ETHER_TYPE_IPV4)) {
+        /* The IPv4 header length is needed by the L4 checksum, construct it first */
         if (likely(pkt->ipProto == IPPROTO_TCP)) {
+            /* IPv4 Header constructor */
+            txgen_ipv4_ctor(pkt, l3_hdr);
+
             /* Construct the TCP header */
             txgen_tcp_hdr_ctor(pkt, l3_hdr, CNE_ETHER_TYPE_IPV4);
-
+        } else if (pkt->ipProto == IPPROTO_UDP) {
             /* IPv4 Header constructor */
             txgen_ipv4_ctor(pkt, l3_hdr);
-        } else if (pkt->ipProto == IPPROTO_UDP) {
+
             /* Construct the UDP header */
             txgen_udp_hdr_ctor(pkt, l3_hdr, CNE_ETHER_TYPE_IPV4);
-
-            /* IPv4 Header constructor */
-            txgen_ipv4_ctor(pkt, l3_hdr);
         }
     } else if (pkt->ethType == CNE_ETHER_TYPE_IPV6) {
         if (likely(pkt->ipProto == IPPROTO_TCP)) {
@@ -311,6 +313,8 @@ txgen_packet_ctor(port_info_t *info)
 
     } else
         cne_printf("Unknown EtherType 0x%04x", pkt->ethType);
+
+    txgen_range_update(info);
 }
 
 /**
@@ -568,26 +572,33 @@ txgen_send_pkts(port_info_t *info)
         cnt = info->tx_burst;
 
     int nb = pktdev_buf_alloc(info->lport->lpid, pkts, cnt);
+    if (nb < 0)
+        nb = 0;
 
-    for (int i = 0; i < nb; i++) {
-        pktmbuf_t *xb = info->tx_mbufs.m_table[i];
+    if (txgen_tst_port_flags(info, SEND_PCAP_PKTS)) {
+        for (int i = 0; i < nb; i++)
+            txgen_pcap_mbuf_ctor(info, pkts[i]);
+    } else {
+        if (txgen_tst_port_flags(info, SEND_RANGE_PKTS))
+            txgen_range_ctor(info, pkts, nb);
+        else {
+            for (int i = 0; i < nb; i++) {
+                pkts[i]->data_len = info->pkt.pktSize;
+                memcpy(pktmbuf_mtod(pkts[i], uint8_t *), (uint8_t *)&info->pkt.hdr,
+                       pkts[i]->data_len);
+            }
+        }
 
-        if (txgen_tst_port_flags(info, SEND_PCAP_PKTS)) {
-            txgen_pcap_mbuf_ctor(info, xb);
-        } else {
-            xb->data_len = info->pkt.pktSize;
-            memcpy(pktmbuf_mtod(xb, uint8_t *), (uint8_t *)&info->pkt.hdr, xb->data_len);
+        if (txgen_tst_port_flags(info, CALC_CHKSUM)) {
+            for (int i = 0; i < nb; i++) {
+                pktmbuf_t *xb = pkts[i];
+                uint32_t crc  = cne_crc32_eth(pktmbuf_mtod(xb, uint8_t *), xb->data_len);
 
-            if (txgen_tst_port_flags(info, CALC_CHKSUM)) {
-                uint32_t crc =
-                    cne_net_crc_calc(pktmbuf_mtod(xb, uint8_t *), xb->data_len, CNE_NET_CRC32_ETH);
                 memcpy(pktmbuf_mtod(xb, uint8_t *) + xb->data_len, (uint8_t *)&crc,
                        sizeof(uint32_t));
                 xb->data_len += sizeof(uint32_t);
             }
         }
-
-        cksum(pktmbuf_mtod(xb, uint8_t *), xb->data_len, 0);
     }
     info->tx_mbufs.len += nb;
 
@@ -782,6 +793,8 @@ init_port_info(port_info_t *info, jcfg_lport_t *lport)
     info->fill_pattern_type      = ABC_FILL_PATTERN;
     strlcpy(info->user_pattern, "0123456789abcdef", sizeof(info->user_pattern));
 
+    range_init(info);
+
     txgen_set_port_flags(info, RUNNING_FLAG);
 
     return 0;
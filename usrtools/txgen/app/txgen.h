@@ -57,7 +57,6 @@
 #include <metrics.h>        // for metrics_info_t
 #include <cne_inet.h>
 #include <_pcap.h>
-#include <cksum.h>
 #include <jcfg.h>        // for jcfg_info_t
 #include <cli.h>
 
@@ -67,7 +67,7 @@ txgen_udp_hdr_ctor(pkt_seq_t *pkt, void *hdr, int type __cne_unused)
         inet6_addr_ntoh((struct in6_addr *)&ipv6->src_addr, &pkt->ip6_src_addr);
         inet6_addr_ntoh((struct in6_addr *)&ipv6->dst_addr, &pkt->ip6_dst_addr);
 
-        ipv6->payload_len = htons(tlen);
+        ipv6->payload_len = htons(tlen - sizeof(struct cne_ipv6_hdr));
         ipv6->proto       = pkt->ipProto;
 
         udp              = txgen_init_udp_hdr(udp, pkt, sizeof(struct cne_ipv6_hdr));